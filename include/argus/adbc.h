@@ -109,11 +109,19 @@ AdbcStatusCode AdbcConnectionInit(struct AdbcConnection* connection,
                                   struct AdbcDatabase* database, struct AdbcError* error);
 AdbcStatusCode AdbcConnectionRelease(struct AdbcConnection* connection, struct AdbcError* error);
 
+/* Bulk ingestion: with a target table set, AdbcStatementExecuteQuery inserts
+ * the bound batch or stream into it (append only: the table must exist). */
+#define ADBC_INGEST_OPTION_TARGET_TABLE "adbc.ingest.target_table"
+#define ADBC_INGEST_OPTION_MODE         "adbc.ingest.mode"
+#define ADBC_INGEST_OPTION_MODE_APPEND  "adbc.ingest.mode.append"
+
 /* Statement */
 AdbcStatusCode AdbcStatementNew(struct AdbcConnection* connection,
                                 struct AdbcStatement* statement, struct AdbcError* error);
 AdbcStatusCode AdbcStatementSetSqlQuery(struct AdbcStatement* statement,
                                         const char* query, struct AdbcError* error);
+AdbcStatusCode AdbcStatementSetOption(struct AdbcStatement* statement, const char* key,
+                                      const char* value, struct AdbcError* error);
 AdbcStatusCode AdbcStatementExecuteQuery(struct AdbcStatement* statement,
                                          struct ArrowArrayStream* out,
                                          int64_t* rows_affected, struct AdbcError* error);
@@ -121,6 +129,8 @@ AdbcStatusCode AdbcStatementRelease(struct AdbcStatement* statement, struct Adbc
 
 AdbcStatusCode AdbcStatementBind(struct AdbcStatement* statement, struct ArrowArray* values,
                                  struct ArrowSchema* schema, struct AdbcError* error);
+AdbcStatusCode AdbcStatementBindStream(struct AdbcStatement* statement,
+                                       struct ArrowArrayStream* stream, struct AdbcError* error);
 AdbcStatusCode AdbcStatementPrepare(struct AdbcStatement* statement, struct AdbcError* error);
 
 /* Connection metadata */
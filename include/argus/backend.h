@@ -19,6 +19,28 @@ typedef void *argus_backend_conn_t;
 /* Opaque backend operation handle (for async operations) */
 typedef void *argus_backend_op_t;
 
+/* Progress of a running operation, as far as the backend can tell */
+typedef struct argus_progress {
+    double      percent;            /* 0-100, or -1 when unknown */
+    int64_t     rows_processed;     /* server-side rows read so far */
+    int64_t     bytes_processed;    /* server-side bytes read so far */
+    int64_t     bytes_received;     /* response bytes the driver received */
+    int64_t     elapsed_ms;         /* server-reported elapsed time */
+    int64_t     wait_us;            /* time the driver spent blocked on
+                                       responses; -1 when not tracked */
+    char        state[24];          /* server state, e.g. "RUNNING" */
+} argus_progress_t;
+
+/* The rows of a bulk insert, converted one at a time as the backend asks
+ * for them instead of all up front. get() returns row i's cells, valid until
+ * the next call, or NULL when the row cannot be converted and is left out.
+ * Each row is asked for at most once, from one thread at a time. */
+typedef struct argus_bulk_rows {
+    size_t              nrows;
+    const argus_cell_t *(*get)(void *ctx, size_t row);
+    void               *ctx;
+} argus_bulk_rows_t;
+
 /*
  * Backend vtable - each backend (Hive, Impala, Trino, etc.)
  * implements this interface.
@@ -124,6 +146,51 @@ typedef struct argus_backend {
      * the ODBC layer report "unknown". Cache it at connect time rather than
      * paying a round trip per call. */
     bool (*get_server_version)(argus_backend_conn_t conn, char *buf, size_t buflen);
+
+    /* Progress of `op` (optional, may be NULL). May be called from another
+     * thread while a fetch on the operation is in flight, so the backend
+     * must copy a consistent snapshot. Returns false when nothing is known. */
+    bool (*get_progress)(argus_backend_conn_t conn, argus_backend_op_t op,
+                         argus_progress_t *out);
+
+    /* Non-blocking execution (optional, both or neither). submit() returns
+     * as soon as the server has accepted the query, with *out_op set; poll()
+     * then advances it by one status check without waiting, and sets
+     * *finished once it is where execute() would have returned, or else
+     * *next_ms to how long to wait before the next check. Both return -1
+     * with last_error set on failure; the caller closes the operation.
+     * Asynchronous statements use these so that no thread is held while
+     * the server runs the query. */
+    int (*submit)(argus_backend_conn_t conn,
+                  const char *query,
+                  argus_backend_op_t *out_op);
+
+    int (*poll)(argus_backend_conn_t conn,
+                argus_backend_op_t op,
+                bool *finished,
+                int *next_ms);
+
+    /* Native bulk insert (optional, may be NULL), which
+     * SQLBulkOperations(SQL_ADD) and INSERT parameter arrays use instead of
+     * INSERT ... VALUES statements. Appends rows->nrows rows of ncols cells
+     * to `table`, named as the application's SQL names it, asking `rows` for
+     * each one as it goes. Cells are text (raw bytes for binary columns) and
+     * line up with `columns`, whose names are empty when the application
+     * gave none (the table's own column order). Sets row_ok[i] to whether
+     * row i was sent and not rejected, and false for a row `rows` could
+     * not convert, and *added to the number of rows the server says it
+     * added: fewer than those marked when it skipped some without saying
+     * which. Returns -1 with last_error set if any row was not added, or 1
+     * having done nothing when the connection cannot take this path, and
+     * the caller falls back to INSERT statements. With rows NULL it only
+     * answers that: 0 if it would take the rows, 1 if not. */
+    int (*bulk_insert)(argus_backend_conn_t conn,
+                       const char *table,
+                       const argus_column_desc_t *columns,
+                       int ncols,
+                       const argus_bulk_rows_t *rows,
+                       bool *row_ok,
+                       size_t *added);
 } argus_backend_t;
 
 /* Backend registry */
@@ -133,4 +200,9 @@ void argus_backend_register(const argus_backend_t *backend);
 const argus_backend_t *argus_backend_find(const char *name);
 void argus_backends_init(void);
 
+/* CAPTUREFILE: a vtable that forwards to `inner` and records every operation
+ * and fetched batch for BACKEND=replay (src/backend/replay). It keeps the
+ * inner backend's name. NULL if no more wrappers can be made. */
+const argus_backend_t *argus_capture_backend(const argus_backend_t *inner);
+
 #endif /* ARGUS_BACKEND_H */
@@ -0,0 +1,99 @@
+#ifndef ARGUS_CANCEL_H
+#define ARGUS_CANCEL_H
+
+#include <glib.h>
+#include <stdbool.h>
+
+/*
+ * Cooperative cancellation of a statement's backend calls.
+ *
+ * Each statement owns an argus_cancel_t. The ODBC layer arms it for the
+ * length of an execute or a fetch (argus_cancel_begin/end), with the
+ * statement's SQL_ATTR_QUERY_TIMEOUT as a deadline, and binds it to the
+ * thread making the backend calls (argus_cancel_enter/leave) so a backend
+ * reaches it through argus_cancel_current() instead of a parameter on every
+ * vtable entry. SQLCancel calls argus_cancel_request() from any thread, and
+ * so does the shared executor's timer (executor.c) when the deadline passes,
+ * so a call blocked where it cannot check is interrupted on timeout too.
+ *
+ * A backend notices a cancel in one of two ways:
+ *  - it checks argus_cancel_requested() wherever it waits anyway: between
+ *    status polls, and in the curl progress callback argus_http_prepare
+ *    installs on every HTTP transfer;
+ *  - around a call that cannot check — a socket read, a gRPC stream — it
+ *    registers an abort action (argus_cancel_push/pop), which
+ *    argus_cancel_request runs on the cancelling thread: CancelOperation
+ *    over the connection's RPC lock, KILL QUERY on a second connection, a
+ *    gRPC stop token.
+ * Either way the call fails, and the backend cancels the query on the
+ * server as it unwinds. The ODBC layer then reports HY008, or HYT00 when
+ * the deadline passed.
+ */
+
+typedef void (*argus_cancel_fn)(void *data);
+
+/* The executor timer task that fires a deadline (cancel.c) */
+typedef struct argus_cancel_watch argus_cancel_watch_t;
+
+typedef struct argus_cancel {
+    GMutex           lock;
+    bool             armed;         /* an execute or fetch is in progress */
+    gint             requested;     /* atomic; set by argus_cancel_request */
+    gint64           deadline;      /* monotonic us; 0 = none */
+    argus_cancel_fn  abort_fn;      /* registered by the backend, or NULL */
+    void            *abort_data;
+    bool             aborting;      /* abort action running, outside lock */
+    GCond            abort_done;    /* signalled when it returns */
+    argus_cancel_watch_t *watch;    /* deadline timer, while armed */
+} argus_cancel_t;
+
+void argus_cancel_init(argus_cancel_t *c);
+void argus_cancel_clear(argus_cancel_t *c);
+
+/* Arm `c` for one execute or fetch; timeout_sec <= 0 sets no deadline.
+ * With one, a timer on the shared executor runs argus_cancel_request when
+ * it passes; argus_cancel_end disarms it. */
+void argus_cancel_begin(argus_cancel_t *c, long timeout_sec);
+void argus_cancel_end(argus_cancel_t *c);
+
+/* True between argus_cancel_begin and argus_cancel_end. A fetch made while
+ * the token is already armed (an extract draining the result inside its
+ * execute) runs under that arming rather than its own. */
+bool argus_cancel_armed(argus_cancel_t *c);
+
+/*
+ * Ask the call in progress to stop, running the backend's abort action if
+ * one is registered. Safe from any thread. Returns false, and does nothing,
+ * when no execute or fetch is armed.
+ */
+bool argus_cancel_request(argus_cancel_t *c);
+
+/*
+ * Bind `c` to the calling thread and return the previous binding, to be
+ * passed to argus_cancel_leave. Entering NULL shields a call from
+ * cancellation — the server-side cancel a backend sends while unwinding.
+ */
+argus_cancel_t *argus_cancel_enter(argus_cancel_t *c);
+void argus_cancel_leave(argus_cancel_t *prev);
+argus_cancel_t *argus_cancel_current(void);
+
+/* True once cancellation was requested or the deadline passed. NULL-safe. */
+bool argus_cancel_requested(argus_cancel_t *c);
+
+/* True when it was the deadline that passed (HYT00 rather than HY008) */
+bool argus_cancel_timed_out(argus_cancel_t *c);
+
+/* Milliseconds left before the deadline; -1 without one. NULL-safe. */
+long argus_cancel_remaining_ms(argus_cancel_t *c);
+
+/*
+ * Register an abort action for the call about to block. Returns false, and
+ * registers nothing, when cancellation was already requested: the call
+ * should not be started. argus_cancel_pop returns only once an abort action
+ * already running has finished, so `data` may be freed after it. A NULL `c`
+ * is accepted (push returns true).
+ */
+bool argus_cancel_push(argus_cancel_t *c, argus_cancel_fn fn, void *data);
+void argus_cancel_pop(argus_cancel_t *c);
+
+#endif /* ARGUS_CANCEL_H */
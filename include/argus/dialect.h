@@ -71,6 +71,11 @@ typedef struct argus_dialect {
     argus_literal_style_t   literals;
     bool                    supports_oj; /* {oj ...} / SQL_OJ_CAPABILITIES */
     const argus_fn_entry_t *fn_map;      /* terminated by odbc_name == NULL */
+    /* SQLBulkOperations(SQL_ADD): the statement that appends rows (NULL =
+     * "INSERT INTO"), and the most rows one VALUES list may carry (0 = no
+     * limit of the engine's own, -1 = no INSERT ... VALUES at all) */
+    const char             *insert_verb;
+    int                     insert_rows;
 } argus_dialect_t;
 
 /* Look up a dialect by backend name. Never returns NULL: an unknown or absent
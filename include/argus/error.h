@@ -31,6 +31,9 @@ typedef struct argus_diag {
 /* Clear all diagnostic records */
 void argus_diag_clear(argus_diag_t *diag);
 
+/* SQLSTATE of the first record, or "HY000" when there is none */
+const char *argus_diag_sqlstate(const argus_diag_t *diag);
+
 /* Push a new diagnostic record */
 void argus_diag_push(argus_diag_t *diag,
                      const char *sqlstate,
@@ -0,0 +1,89 @@
+/*
+ * Direct-to-file extract: stream a query's result into an Arrow IPC, Parquet
+ * or CSV file instead of through SQLFetch/SQLGetData.
+ *
+ * The statement attributes below select it. With ARGUS_ATTR_EXTRACT_PATH set,
+ * SQLExecute / SQLExecDirect run the query and write the whole result to that
+ * file before returning; SQLRowCount then reports the rows written and
+ * SQLFetch returns SQL_NO_DATA. The ADBC driver exposes the same through
+ * AdbcStatementSetOption ("argus.extract.*").
+ *
+ * No GLib here, so the header can be used from the ADBC driver and the writer
+ * can be unit tested on its own.
+ */
+#ifndef ARGUS_EXTRACT_H
+#define ARGUS_EXTRACT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Statement attributes (the ARGUS_ATTR_* range in argus/handle.h) */
+#define ARGUS_ATTR_EXTRACT_PATH         65562   /* string; NULL = off */
+#define ARGUS_ATTR_EXTRACT_FORMAT       65563   /* ARGUS_EXTRACT_FORMAT_* */
+#define ARGUS_ATTR_EXTRACT_ROW_GROUP    65564   /* rows; 0 = default */
+#define ARGUS_ATTR_EXTRACT_COMPRESSION  65565   /* ARGUS_EXTRACT_COMPRESS_* */
+#define ARGUS_ATTR_EXTRACT_ROWS         65566   /* read-only, last extract */
+#define ARGUS_ATTR_EXTRACT_BYTES        65567   /* read-only, file size */
+#define ARGUS_ATTR_EXTRACT_TIME_MS      65568   /* read-only, double */
+#define ARGUS_ATTR_EXTRACT_ROWS_PER_SEC 65569   /* read-only, double */
+
+/* ARGUS_ATTR_EXTRACT_FORMAT: AUTO picks by the file extension (.arrow,
+ * .feather, .ipc, .parquet, .csv, .csv.gz), Arrow IPC otherwise */
+#define ARGUS_EXTRACT_FORMAT_AUTO       0
+#define ARGUS_EXTRACT_FORMAT_ARROW      1
+#define ARGUS_EXTRACT_FORMAT_PARQUET    2
+#define ARGUS_EXTRACT_FORMAT_CSV        3
+
+/* ARGUS_ATTR_EXTRACT_COMPRESSION: GZIP compresses Parquet pages (the GZIP
+ * codec) or the whole CSV file. The Arrow IPC format only defines LZ4 and
+ * ZSTD body compression, so Arrow files can only be written uncompressed. */
+#define ARGUS_EXTRACT_COMPRESS_NONE     0
+#define ARGUS_EXTRACT_COMPRESS_GZIP     1
+
+/* ── File writer (see extract_writer.c) ──────────────────────── */
+
+/* Column types: integers, floating point, and everything else as text */
+typedef enum argus_extract_type {
+    ARGUS_EXTRACT_INT64 = 0,
+    ARGUS_EXTRACT_DOUBLE,
+    ARGUS_EXTRACT_UTF8
+} argus_extract_type_t;
+
+typedef struct argus_extract_writer argus_extract_writer_t;
+
+/* Create `path` (replacing it) and write the format's header. Rows are
+ * buffered column by column and written a row group (Parquet), record batch
+ * (Arrow) or block (CSV) of `row_group_rows` at a time. Returns NULL with a
+ * message in `err` on failure. */
+argus_extract_writer_t *argus_extract_writer_open(
+    const char *path, int format, int compression, size_t row_group_rows,
+    int num_cols, const char *const *names, const argus_extract_type_t *types,
+    char *err, size_t err_len);
+
+/* One cell of the current row, columns in order */
+void argus_extract_writer_null(argus_extract_writer_t *w, int col);
+void argus_extract_writer_i64(argus_extract_writer_t *w, int col, int64_t v);
+void argus_extract_writer_f64(argus_extract_writer_t *w, int col, double v);
+void argus_extract_writer_text(argus_extract_writer_t *w, int col,
+                               const char *s, size_t len);
+
+/* End the current row, writing out the row group once it is full.
+ * Returns 0, or -1 on a write error. */
+int argus_extract_writer_end_row(argus_extract_writer_t *w);
+
+/* Write the last row group and the footer, and close the file.
+ * Returns 0, or -1 on a write error. */
+int argus_extract_writer_finish(argus_extract_writer_t *w);
+
+/* Close without finishing and delete the partial file */
+void argus_extract_writer_discard(argus_extract_writer_t *w);
+
+uint64_t argus_extract_writer_rows(const argus_extract_writer_t *w);
+uint64_t argus_extract_writer_bytes(const argus_extract_writer_t *w);
+const char *argus_extract_writer_error(const argus_extract_writer_t *w);
+void argus_extract_writer_free(argus_extract_writer_t *w);
+
+/* The format AUTO resolves to for `path` */
+int argus_extract_format_for(const char *path);
+
+#endif /* ARGUS_EXTRACT_H */
@@ -11,12 +11,60 @@
 #include "argus/error.h"
 #include "argus/types.h"
 #include "argus/backend.h"
+#include "argus/cancel.h"
+#include "argus/extract.h"
+#include "argus/trace.h"
 
 /* Driver-specific attribute IDs for metrics (base > 65536 to avoid ODBC range) */
 #define ARGUS_ATTR_CONNECT_TIME_MS  65537
 #define ARGUS_ATTR_EXECUTE_TIME_MS  65538
 #define ARGUS_ATTR_ROWS_FETCHED     65539
 #define ARGUS_ATTR_ERRORS_TOTAL     65540
+#define ARGUS_ATTR_RESULT_CACHE_HITS   65541
+#define ARGUS_ATTR_RESULT_CACHE_MISSES 65542
+#define ARGUS_ATTR_RESULT_CACHE_BYTES  65543
+#define ARGUS_ATTR_PROGRESS_PERCENT    65544   /* double, -1 = unknown */
+#define ARGUS_ATTR_PROGRESS_ROWS       65545   /* rows read by the server */
+#define ARGUS_ATTR_PROGRESS_BYTES      65546   /* result bytes received */
+#define ARGUS_ATTR_POOL_HITS           65547   /* process-wide pool counters */
+#define ARGUS_ATTR_POOL_MISSES         65548
+#define ARGUS_ATTR_POOL_BUSY           65549
+#define ARGUS_ATTR_POOL_CREATE_MS      65550   /* double, mean pre-warm connect */
+#define ARGUS_ATTR_METRICS_JSON        65551   /* string, phase histograms */
+#define ARGUS_ATTR_METRICS_DUMP        65552   /* set: path to write them to */
+#define ARGUS_ATTR_SUBMIT_TIME_MS      65553   /* doubles, -1 = unknown */
+#define ARGUS_ATTR_QUEUE_TIME_MS       65554
+#define ARGUS_ATTR_FIRST_ROW_MS        65555
+#define ARGUS_ATTR_FETCH_TIME_MS       65556
+#define ARGUS_ATTR_NETWORK_TIME_MS     65557
+#define ARGUS_ATTR_DECODE_TIME_MS      65558
+#define ARGUS_ATTR_CONVERT_TIME_MS     65559
+#define ARGUS_ATTR_BYTES_RECEIVED      65560   /* result bytes on the wire */
+#define ARGUS_ATTR_CELLS_DECODED       65561
+/* 65562-65569: direct-to-file extract, see argus/extract.h */
+#define ARGUS_ATTR_SQL_CACHE_HITS      65570   /* preprocessed SQL reused */
+#define ARGUS_ATTR_SQL_CACHE_MISSES    65571
+#define ARGUS_ATTR_SQL_CACHE_BYTES     65572   /* process-wide */
+
+/*
+ * Completion of an asynchronous ODBC call running on the shared executor
+ * (executor.c). The calling thread polls or waits on it; the worker completes
+ * it as its very last touch of the handle. With ODBC 3.8 notification the
+ * application (normally the Driver Manager) is also told: its callback is
+ * called, or on Windows its event is signalled.
+ */
+typedef struct argus_async {
+    GMutex          lock;
+    GCond           cond;
+    bool            running;    /* begun and not yet completed */
+    SQLRETURN       result;     /* valid once !running */
+    SQLPOINTER      callback;   /* SQL_ATTR_ASYNC_*_PCALLBACK, or NULL */
+    SQLPOINTER      context;    /* SQL_ATTR_ASYNC_*_PCONTEXT */
+    SQLPOINTER      event;      /* SQL_ATTR_ASYNC_*_EVENT (Windows HANDLE) */
+} argus_async_t;
+
+/* Rows a static cursor has read, packed into pages (scroll_store.c) */
+typedef struct argus_scroll_store argus_scroll_store_t;
 
 /* Handle type signatures for runtime type checking */
 #define ARGUS_ENV_SIGNATURE  0x41524745U  /* 'ARGE' */
@@ -49,6 +97,12 @@ struct argus_dbc {
     SQLUINTEGER  autocommit;    /* SQL_AUTOCOMMIT_ON / SQL_AUTOCOMMIT_OFF */
     char        *current_catalog;
 
+    /* Connection-level async (SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE): connect
+     * and disconnect run on the executor and return SQL_STILL_EXECUTING */
+    bool         async_dbc_enabled;
+    bool         async_dbc_busy;    /* a call is in flight or unreported */
+    argus_async_t async_dbc;
+
     /* Connection parameters (parsed from conn string) */
     char        *host;
     int          port;
@@ -76,17 +130,58 @@ struct argus_dbc {
     /* Additional connection parameters */
     char        *app_name;
     int          fetch_buffer_size;
-    long         max_scroll_rows;  /* cap for static-cursor materialization
-                                    * (0 = ARGUS_DEFAULT_MAX_SCROLL_ROWS) */
+    bool         adaptive_fetch;   /* resize batches, see fetch.c */
+    size_t       fetch_target_bytes;
+    int          fetch_target_ms;
+    int          fetch_min_rows;
+    int          fetch_max_rows;
+    int          bulk_insert_rows;  /* SQL_ADD: rows per INSERT statement */
+    size_t       bulk_insert_bytes; /* SQL_ADD: SQL text per statement */
+    bool         bulk_load;         /* native bulk inserts: LOAD DATA LOCAL
+                                     * INFILE, BigQuery insertAll */
+    long         max_scroll_rows;  /* optional row cap for static cursors
+                                    * (0 = none) */
+    uint64_t     max_scroll_bytes; /* static-cursor storage cap, memory + disk */
+    size_t       scroll_memory_bytes; /* static-cursor pages kept in memory */
+    bool         scroll_compress;  /* deflate static-cursor pages */
     int          retry_count;
     int          retry_delay_sec;
+    int          connect_race_delay_ms;  /* HOST list: stagger; 0 = in turn */
+    int          host_cooldown_sec;      /* circuit-breaker open time */
+    int          pool_min_idle;          /* idle connections kept warm */
     int          socket_timeout_sec;
     int          connect_timeout_sec;
     int          query_timeout_sec;
     char        *http_path;
+    bool         http_compression; /* Hive HTTP: accept compressed responses */
+    bool         http2;            /* Hive HTTP: prefer HTTP/2 over TLS */
+    bool         arrow_results;  /* Hive: ask Spark/Databricks for Arrow batches */
+    bool         cloud_fetch;    /* Hive: allow presigned result-link downloads */
+    bool         prefetch;       /* Hive/Impala: fetch the next batch ahead */
+    bool         result_cache;   /* replay repeated SELECTs from memory */
+    int          result_cache_ttl_sec;
+    size_t       result_cache_max_bytes;  /* process-wide budget */
+    char        *result_cache_pattern;    /* optional allow regex */
+    size_t       sql_cache_max_bytes;     /* process-wide; 0 = off */
+    void        *result_cache_regex;      /* compiled pattern (GRegex*) */
+    int          metadata_cache_ttl_sec;  /* 0 disables the metadata cache */
+    int          tables_cache_ttl_sec;    /* -1 = metadata_cache_ttl_sec */
+    int          columns_cache_ttl_sec;   /* -1 = metadata_cache_ttl_sec */
+    int          metadata_cache_stale_sec; /* serve while refreshing */
+    char        *metadata_cache_file;     /* persist across restarts */
+    bool         catalog_snapshot;        /* answer catalog calls from bulk loads */
+    char        *capture_file;            /* record backend traffic here */
+    char        *replay_file;             /* BACKEND=replay: capture to serve */
+    int          replay_latency_ms;       /* replay: added per round trip */
+    long         replay_bandwidth_kib;    /* replay: KiB/s, 0 = unlimited */
+    char        *synthetic_spec;          /* BACKEND=synthetic: default spec */
     int          trino_protocol_version;  /* 1 = v1 (default), 2 = v2 spooling */
     int          log_level;
     char        *log_file;
+    int          log_format;   /* argus_log_format_t, -1 = not set */
+    char        *trace_file;   /* OTLP/JSON span output (see trace.h) */
+    double       trace_sample; /* fraction of operations traced */
+    argus_tracer_t *tracer;    /* NULL = not traced */
 
     /* OAuth2 client-credentials (M2M) — used by Trino when AuthMech=OAUTH2 */
     char        *oauth_token_url;     /* IdP token endpoint */
@@ -111,12 +206,13 @@ struct argus_dbc {
     /* SQLBrowseConnect accumulated keywords */
     char        *browse_buf;
 
-    /* Metadata cache (GHashTable*, lazily initialized) */
-    void        *metadata_cache;
-
     /* Metrics */
     double       connect_time_ms;       /* last connect duration */
     unsigned long errors_total;         /* total error count */
+    unsigned long result_cache_hits;
+    unsigned long result_cache_misses;
+    unsigned long sql_cache_hits;
+    unsigned long sql_cache_misses;
 
     /* Observability taps (argus/obs_hooks.h): redacted copy of the connection
      * string (secret-bearing values masked), captured at SQLDriverConnect. */
@@ -184,6 +280,69 @@ static inline bool argus_valid_desc(SQLHANDLE h) {
     return h && ((argus_desc_t *)h)->signature == ARGUS_DESC_SIGNATURE;
 }
 
+/* Phases of a statement's execution (see metrics.c) */
+typedef enum {
+    ARGUS_PHASE_SUBMIT,     /* backend execute() call */
+    ARGUS_PHASE_QUEUE,      /* execute() return to result metadata */
+    ARGUS_PHASE_FIRST_ROW,  /* execute start to the first row */
+    ARGUS_PHASE_FETCH,      /* backend fetch_results() calls */
+    ARGUS_PHASE_NETWORK,    /* part of FETCH waiting on the server */
+    ARGUS_PHASE_DECODE,     /* rest of FETCH: parsing responses into cells */
+    ARGUS_PHASE_CONVERT,    /* cells into bound buffers (sampled) */
+    ARGUS_PHASE_COUNT
+} argus_phase_t;
+
+/* SQLFetch calls per conversion-time sample */
+#define ARGUS_METRICS_CONVERT_SAMPLE 64
+
+/* Phase timing of a statement's current execution */
+typedef struct argus_stmt_timing {
+    gint64          start_us;       /* monotonic; 0 = not executed */
+    double          submit_ms;
+    double          queue_ms;
+    double          first_row_ms;   /* -1 until a row arrives */
+    double          fetch_ms;
+    double          network_ms;     /* -1 when the backend does not say */
+    int64_t         wait_base_us;   /* backend wait before the first batch */
+    double          convert_sampled_ms;
+    unsigned long   convert_samples;
+    unsigned long   fetch_calls;    /* SQLFetch/SQLFetchScroll calls */
+    unsigned long   batches;
+    unsigned long   bytes;          /* response bytes received */
+    unsigned long   cells;          /* cells decoded */
+    bool            pending;        /* not yet in the histograms */
+} argus_stmt_timing_t;
+
+/* Row count of a statement's next backend fetch, adapted batch by batch */
+typedef struct argus_fetch_sizer {
+    int             rows;           /* next request */
+    int             min_rows;
+    int             max_rows;
+    double          row_bytes;      /* smoothed decoded bytes per row, 0 = unknown */
+    double          row_us;         /* smoothed arrival time per row, 0 = unknown */
+} argus_fetch_sizer_t;
+
+/*
+ * A statement's SQL after preprocessing (see sql_cache.c): ODBC escapes
+ * translated, and the ? markers outside quoted text located, so parameters
+ * are substituted by splicing literals in at known offsets. Shared through
+ * the cache and immutable once built.
+ */
+typedef struct argus_sql_text {
+    char           *sql;            /* native SQL */
+    size_t          len;
+    int             num_markers;
+    size_t         *markers;        /* byte offset of each ? in sql */
+
+    /* Cache bookkeeping */
+    const void     *dialect;        /* key: translating dialect, or NULL */
+    char           *raw;            /* key: SQL as the application sent it */
+    guint           hash;
+    size_t          bytes;
+    GList          *lru_link;
+    gint            refcount;
+} argus_sql_text_t;
+
 /* Statement handle */
 struct argus_stmt {
     unsigned int            signature;
@@ -193,6 +352,7 @@ struct argus_stmt {
 
     /* Query state */
     char                   *query;
+    argus_sql_text_t       *query_text;   /* preprocessed form of query */
     bool                    prepared;
     bool                    executed;
 
@@ -256,10 +416,18 @@ struct argus_stmt {
     /* Async execution state */
     bool                    async_enabled;
     argus_async_state_t     async_state;
-    char                   *async_query;    /* query the worker thread runs */
-    GThread                *async_thread;   /* worker running a background execute */
-    gint                    async_done;     /* atomic flag: worker has finished */
-    SQLRETURN               async_result;   /* worker's return code, valid once done */
+    char                   *async_query;    /* query the executor runs */
+    argus_async_t           async;          /* completion of that run */
+    gint64                  submitted_us;   /* backend accepted the query */
+
+    /* Cancellation of the execute or fetch in progress (SQLCancel,
+     * SQL_ATTR_QUERY_TIMEOUT); see argus/cancel.h */
+    argus_cancel_t          cancel;
+
+    /* Tracing (see argus/trace.h): the execute span while it runs, and
+     * its context, which the result's fetch spans are parented to */
+    argus_span_t           *trace_span;
+    argus_trace_ctx_t       trace_ctx;
 
     /* Data-at-execution state */
     argus_dae_state_t       dae_state;
@@ -273,9 +441,10 @@ struct argus_stmt {
     SQLULEN                 cursor_type;        /* SQL_CURSOR_FORWARD_ONLY or SQL_CURSOR_STATIC */
     size_t                  scroll_position;    /* absolute position in full cache */
     size_t                  scroll_rowset_start; /* abs. start of current rowset (for SQLSetPos) */
-    argus_row_t            *scroll_rows;        /* full result set cache */
-    size_t                  scroll_row_count;   /* number of rows in scroll cache */
-    bool                    scroll_cached;      /* true if full cache built */
+    size_t                  scroll_row;         /* 1-based row SQLGetData reads; 0 = none */
+    argus_scroll_store_t   *scroll_store;       /* rows read so far (see scroll_store.c) */
+    bool                    scroll_cached;      /* static cursor has started scrolling */
+    bool                    scroll_complete;    /* the whole result is in scroll_store */
 
     /* Batch parameter attributes */
     SQLULEN                 paramset_size;       /* SQL_ATTR_PARAMSET_SIZE (default 1) */
@@ -287,6 +456,23 @@ struct argus_stmt {
     double                  execute_time_ms;    /* last execute duration */
     unsigned long           rows_fetched_total; /* cumulative rows fetched */
     unsigned long           errors_total;       /* total errors on this stmt */
+    argus_stmt_timing_t     timing;
+    argus_fetch_sizer_t     fetch_sizer;
+
+    /* Direct-to-file extract (see extract.c); extract_path NULL = off */
+    char                   *extract_path;
+    SQLULEN                 extract_format;      /* ARGUS_EXTRACT_FORMAT_* */
+    SQLULEN                 extract_row_group;   /* rows; 0 = default */
+    SQLULEN                 extract_compression; /* ARGUS_EXTRACT_COMPRESS_* */
+    unsigned long           extract_rows;        /* last extract */
+    uint64_t                extract_bytes;
+    double                  extract_ms;
+
+    /* Result being captured for the result cache (lazily allocated) */
+    void                   *result_capture;
+
+    /* Metadata cache entry whose rows row_cache borrows */
+    void                   *metadata_ref;
 };
 
 /* Handle locking macros for thread safety */
@@ -311,12 +497,49 @@ SQLRETURN argus_alloc_env(argus_env_t **out);
 SQLRETURN argus_alloc_dbc(argus_env_t *env, argus_dbc_t **out);
 SQLRETURN argus_alloc_stmt(argus_dbc_t *dbc, argus_stmt_t **out);
 
+/* Convert one cell into an application buffer of C type target_type
+ * (fetch.c); the kernel behind SQLFetch binding and SQLGetData */
+SQLRETURN argus_convert_cell(const argus_cell_t *cell, SQLSMALLINT target_type,
+                             SQLPOINTER target_value, SQLLEN buffer_length,
+                             SQLLEN *str_len_or_ind, argus_diag_t *diag);
+
+/* Where row rowset_idx of the rowset lives in a bound column's buffers,
+ * for column- or row-wise binding (fetch.c) */
+void argus_bind_target(const argus_stmt_t *stmt,
+                       const argus_col_binding_t *bind,
+                       SQLULEN rowset_idx,
+                       SQLPOINTER *out_target,
+                       SQLLEN **out_ind);
+
+/* A bound parameter as a SQL literal (execute.c); malloc'd, or NULL when
+ * the value cannot be sent, e.g. a string with an embedded NUL */
+char *argus_render_param(const argus_param_binding_t *param);
+
+/* The bindings of row row_idx of a parameter array, for column-wise or
+ * row-wise (bind_type = struct size) binding (execute.c) */
+void argus_param_row(const argus_param_binding_t *base_params, int num_params,
+                     SQLULEN row_idx, SQLULEN bind_type,
+                     argus_param_binding_t *row_params);
+
+/* Close the statement's previous result, if any, and forget its state
+ * (execute.c) */
+void argus_stmt_reset_result(argus_stmt_t *stmt);
+
+/* Run an INSERT ... VALUES (?, ...) over a parameter array of nrows rows
+ * through the backend's native bulk path (bulk.c). Returns false, having
+ * done nothing, when the statement or the backend does not qualify, and
+ * the caller executes the rows one at a time. */
+bool argus_bulk_insert_params(argus_stmt_t *stmt, SQLULEN nrows,
+                              SQLRETURN *out_ret);
+
 /* Ensure stmt has room for at least ncols columns/bindings */
 int argus_stmt_ensure_columns(argus_stmt_t *stmt, int ncols);
 int argus_stmt_ensure_bindings(argus_stmt_t *stmt, int ncols);
 
 SQLRETURN argus_free_env(argus_env_t *env);
 SQLRETURN argus_free_dbc(argus_dbc_t *dbc);
+argus_dbc_t *argus_dbc_clone_config(const argus_dbc_t *dbc);
+void argus_dbc_free_config(argus_dbc_t *copy);
 SQLRETURN argus_free_stmt(argus_stmt_t *stmt);
 void argus_stmt_reset(argus_stmt_t *stmt);
 
@@ -350,11 +573,94 @@ void argus_pool_configure(int max_per_key, int max_total,
                            int idle_timeout_sec, int ttl_sec);
 void argus_pool_get_config(int *max_per_key, int *max_total,
                             int *idle_timeout_sec, int *ttl_sec);
-
-/* Metadata cache */
-void argus_metadata_cache_init(argus_dbc_t *dbc);
-void argus_metadata_cache_free(argus_dbc_t *dbc);
-void argus_metadata_cache_clear(argus_dbc_t *dbc);
+void argus_pool_warm(const argus_dbc_t *dbc, const char *host, int port,
+                     const char *backend_name, const char *username,
+                     const argus_backend_t *backend, int min_idle);
+void argus_pool_maintain(void);
+
+/* Pool statistics, process-wide since the pool was first used */
+typedef struct argus_pool_stats {
+    unsigned long hits;             /* checkouts served from the pool */
+    unsigned long misses;           /* checkouts that found nothing idle */
+    unsigned long busy;             /* misses while the key's connections
+                                       were all checked out */
+    unsigned long creates;          /* connections opened by pre-warming */
+    unsigned long create_failures;
+    double        create_ms_total;  /* time spent opening them */
+    double        create_ms_max;
+    unsigned long replaced;         /* closed shortly before the TTL */
+    unsigned long validation_failures;  /* idle ones is_alive() rejected */
+    unsigned long evicted;          /* closed for idle timeout or TTL */
+    int           idle;
+    int           in_use;
+    int           warm_keys;
+} argus_pool_stats_t;
+
+void argus_pool_get_stats(argus_pool_stats_t *out);
+
+/* Shared executor for asynchronous calls (process-wide, see executor.c) */
+typedef void (*argus_task_fn)(void *data);
+
+void argus_executor_configure(int max_threads);
+bool argus_executor_submit(argus_task_fn fn, void *data);
+bool argus_executor_schedule(argus_task_fn fn, void *data, int delay_ms);
+void argus_executor_shutdown(void);
+
+void argus_async_init(argus_async_t *a);
+void argus_async_clear(argus_async_t *a);
+void argus_async_begin(argus_async_t *a);
+void argus_async_abandon(argus_async_t *a);
+void argus_async_complete(argus_async_t *a, SQLRETURN result);
+bool argus_async_poll(argus_async_t *a, SQLRETURN *result);
+SQLRETURN argus_async_wait(argus_async_t *a);
+
+/* After a backend call failed: when the statement's cancel token stopped it,
+ * set HY008 (SQLCancel) or HYT00 (SQL_ATTR_QUERY_TIMEOUT) and return true */
+bool argus_stmt_cancelled(argus_stmt_t *stmt);
+
+/* Per-host connect health (process-wide, see host_health.c) */
+void argus_host_health_record(const char *host, int port, bool ok,
+                              double connect_ms, int cooldown_sec);
+bool argus_host_health_is_open(const char *host, int port);
+void argus_host_health_order(const char *const *hosts, const int *ports,
+                             int n, int *order);
+void argus_host_health_clear(void);
+
+/* Statement phase histograms (process-wide, see metrics.c) */
+typedef struct argus_phase_summary {
+    unsigned long count;
+    double        min_ms;
+    double        max_ms;
+    double        mean_ms;
+    double        p50_ms;
+    double        p90_ms;
+    double        p99_ms;
+} argus_phase_summary_t;
+
+const char *argus_metrics_phase_name(argus_phase_t phase);
+void argus_metrics_record(argus_phase_t phase, double ms);
+void argus_metrics_summary(argus_phase_t phase, argus_phase_summary_t *out);
+char *argus_metrics_json(void);
+int argus_metrics_dump(const char *path);
+void argus_metrics_reset(void);
+double argus_stmt_phase_ms(const argus_stmt_t *stmt, argus_phase_t phase);
+void argus_stmt_timing_begin(argus_stmt_t *stmt);
+void argus_stmt_timing_progress(argus_stmt_t *stmt);
+void argus_stmt_timing_finish(argus_stmt_t *stmt);
+
+/* Adaptive fetch sizing (see fetch.c). elapsed_us < 0: the batch's time
+ * says nothing about the next one. */
+void argus_fetch_sizer_init(argus_fetch_sizer_t *fs, const argus_dbc_t *dbc);
+void argus_fetch_sizer_observe(argus_fetch_sizer_t *fs, const argus_dbc_t *dbc,
+                               size_t rows, size_t bytes, int64_t elapsed_us);
+
+/* Metadata cache (process-wide, see metadata_cache.c) */
+void argus_metadata_cache_set_file(const char *path);
+void argus_metadata_cache_clear(void);
+void argus_metadata_cache_cleanup(void);
+void argus_metadata_cache_release(argus_stmt_t *stmt);
+void argus_metadata_cache_invalidate(argus_dbc_t *dbc);
+bool argus_metadata_cache_is_ddl(const char *query);
 bool argus_metadata_cache_lookup(argus_dbc_t *dbc, argus_stmt_t *stmt,
                                   const char *func,
                                   const char *a1, const char *a2,
@@ -363,5 +669,48 @@ void argus_metadata_cache_store(argus_dbc_t *dbc, argus_stmt_t *stmt,
                                  const char *func,
                                  const char *a1, const char *a2,
                                  const char *a3, const char *a4);
+bool argus_metadata_cache_snapshot(argus_dbc_t *dbc, argus_stmt_t *stmt,
+                                    const char *func, const char *catalog,
+                                    const char *schema, const char *name,
+                                    const char *last, bool identifiers);
+
+/* Static-cursor row store (see scroll_store.c) */
+argus_scroll_store_t *argus_scroll_store_new(int num_cols,
+                                             size_t memory_budget,
+                                             bool compress);
+void argus_scroll_store_free(argus_scroll_store_t *s);
+int argus_scroll_store_append(argus_scroll_store_t *s, const argus_row_t *row);
+const argus_row_t *argus_scroll_store_get(argus_scroll_store_t *s, size_t idx);
+size_t argus_scroll_store_rows(const argus_scroll_store_t *s);
+uint64_t argus_scroll_store_bytes(const argus_scroll_store_t *s);
+uint64_t argus_scroll_store_spilled(const argus_scroll_store_t *s);
+const char *argus_scroll_store_error(const argus_scroll_store_t *s);
+
+/* Pull the next batch of the result into stmt->row_cache (see fetch.c) */
+SQLRETURN argus_fetch_batch(argus_stmt_t *stmt);
+
+/* Write the executed statement's whole result to its extract file
+ * (see extract.c) */
+SQLRETURN argus_extract_run(argus_stmt_t *stmt);
+
+/* SQL preprocessing cache (process-wide, see sql_cache.c). _get returns
+ * a reference, or NULL with stmt->diag set. */
+argus_sql_text_t *argus_sql_text_get(argus_stmt_t *stmt, const char *raw);
+void argus_sql_text_unref(argus_sql_text_t *text);
+void argus_sql_cache_configure(size_t max_bytes);
+size_t argus_sql_cache_bytes(void);
+void argus_sql_cache_clear(void);
+
+/* Result cache (process-wide, see result_cache.c) */
+void argus_result_cache_configure(size_t max_bytes);
+size_t argus_result_cache_bytes(void);
+void argus_result_cache_clear(void);
+bool argus_result_cache_lookup(argus_stmt_t *stmt, const char *query);
+void argus_result_cache_begin(argus_stmt_t *stmt, const char *query);
+void argus_result_cache_capture(argus_stmt_t *stmt);
+void argus_result_cache_release(argus_stmt_t *stmt);
+void argus_result_cache_invalidate(argus_dbc_t *dbc);
+char *argus_result_cache_normalize(const char *query);
+bool argus_result_cache_is_cacheable(const char *query);
 
 #endif /* ARGUS_HANDLE_H */
@@ -3,13 +3,16 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /*
  * Argus ODBC Driver Logging System
  *
  * Thread-safe logging with configurable levels and output.
- * Initialized from connection string (LogLevel, LogFile) or
- * environment variables (ARGUS_LOG_LEVEL, ARGUS_LOG_FILE).
+ * Initialized from connection string (LogLevel, LogFile, LogFormat) or
+ * environment variables (ARGUS_LOG_LEVEL, ARGUS_LOG_FILE, ARGUS_LOG_FORMAT).
+ * Lines are queued per thread and written by a background thread unless
+ * ARGUS_LOG_ASYNC=0.
  */
 
 /* Log levels (0 = OFF, 6 = TRACE) */
@@ -23,6 +26,28 @@ typedef enum {
     ARGUS_LOG_TRACE = 6
 } argus_log_level_t;
 
+/* Output formats */
+typedef enum {
+    ARGUS_LOG_FORMAT_TEXT   = 0,   /* "[time] [LEVEL] [tN] [file:line func] msg" */
+    ARGUS_LOG_FORMAT_JSON   = 1,   /* one JSON object per line */
+    ARGUS_LOG_FORMAT_BINARY = 2    /* argus_log_record_t records */
+} argus_log_format_t;
+
+/*
+ * BINARY record, host byte order: this header, then the file name, the
+ * function name and the message, each NUL-terminated. size covers the
+ * whole record, so a reader can skip from one record to the next.
+ */
+typedef struct {
+    uint32_t size;
+    uint32_t thread;     /* per-process thread number, as tN in TEXT */
+    int64_t  time_us;    /* microseconds since the Unix epoch */
+    uint8_t  level;
+    uint8_t  reserved;
+    uint16_t line;
+    uint32_t reserved2;
+} argus_log_record_t;
+
 /* Initialize logging system (called on library load) */
 void argus_log_init(void);
 
@@ -38,6 +63,19 @@ int argus_log_get_level(void);
 /* Set log file path (NULL for stderr) */
 void argus_log_set_file(const char *path);
 
+/* Set the output format (argus_log_format_t) */
+void argus_log_set_format(int format);
+int argus_log_get_format(void);
+
+/* "text", "json" or "binary" to argus_log_format_t; -1 if unknown */
+int argus_log_format_from_string(const char *name);
+
+/* Write out every queued line now */
+void argus_log_flush(void);
+
+/* Lines dropped because the writer fell behind (reported so far) */
+unsigned long argus_log_dropped(void);
+
 /* Core logging function */
 void argus_log_write(argus_log_level_t level, const char *file, int line,
                      const char *func, const char *fmt, ...);
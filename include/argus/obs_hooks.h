@@ -17,7 +17,8 @@
  *    providers are compiled into the same module, so allocators match.
  *  - Observability taps fire PER STATEMENT / PER CONNECTION, never per row
  *    (hot-path invariant). The statement tap fires once per statement handle,
- *    at release, with cumulative counters; `bytes` is 0 when untracked.
+ *    at release, with cumulative counters; `bytes` is the last execution's
+ *    response bytes, 0 when the backend does not track them.
  */
 #ifndef ARGUS_OBS_HOOKS_H
 #define ARGUS_OBS_HOOKS_H
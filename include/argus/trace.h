@@ -0,0 +1,119 @@
+#ifndef ARGUS_TRACE_H
+#define ARGUS_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Span tracing of driver operations.
+ *
+ * A connection with TRACEFILE set, or any connection once an application has
+ * installed a sink (argus_trace_set_sink), records spans for:
+ *  - connect, with one backend.connect child per host attempt (the backend's
+ *    connect includes authentication);
+ *  - execute, with backend.execute, backend.poll and backend.describe
+ *    children for the round trips it makes;
+ *  - fetch, one per backend batch, with the rows and the decode time (the
+ *    batch's time less the part spent waiting on the server, where the
+ *    backend tracks it);
+ *  - the catalog functions that reach the backend;
+ *  - bulk_add, for SQLBulkOperations(SQL_ADD), with the rows added and the
+ *    INSERT statements it took.
+ *
+ * TRACESAMPLE (0-1, default 1) is the fraction of root spans — connects,
+ * executes, catalog calls, bulk adds — that are recorded; a statement's fetch spans
+ * follow its execute. An unsampled operation costs one branch per call, so
+ * a sampled-out extract runs at full speed.
+ *
+ * While a span covers a backend call it is bound to the calling thread
+ * (argus_trace_enter/leave), and the HTTP transports and Trino propagate it
+ * to the server as a W3C traceparent header.
+ *
+ * Spans go to the installed sink, or else to TRACEFILE as OTLP/JSON: one
+ * ExportTraceServiceRequest per line, as read by the OpenTelemetry
+ * Collector's otlpjsonfile receiver.
+ */
+
+#define ARGUS_TRACE_MAX_ATTRS   8
+#define ARGUS_TRACEPARENT_LEN   56      /* "00-<32>-<16>-01" and the NUL */
+
+typedef struct argus_trace_ctx {
+    uint8_t  trace_id[16];
+    uint8_t  span_id[8];
+    bool     sampled;
+} argus_trace_ctx_t;
+
+typedef struct argus_span_attr {
+    const char *key;                /* static string */
+    char       *str;                /* string value, or NULL for num */
+    int64_t     num;
+} argus_span_attr_t;
+
+typedef struct argus_span {
+    argus_trace_ctx_t   ctx;
+    uint8_t             parent_id[8];   /* all zero for a root span */
+    const char         *name;           /* static string */
+    int64_t             start_unix_us;
+    int64_t             end_unix_us;
+    char                status[6];      /* SQLSTATE on failure, else "" */
+    int                 num_attrs;
+    argus_span_attr_t   attrs[ARGUS_TRACE_MAX_ATTRS];
+
+    /* Internal */
+    struct argus_tracer *tracer;
+    int64_t             mono_start_us;
+} argus_span_t;
+
+/* Per-connection tracing state: sampling ratio and destination */
+typedef struct argus_tracer argus_tracer_t;
+
+/* ── Export ──────────────────────────────────────────────────── */
+
+typedef struct argus_trace_sink {
+    /* Called on the thread that ended the span; must be thread-safe */
+    void  (*export_span)(void *user_data, const argus_span_t *span);
+    void  (*flush)(void *user_data);    /* optional */
+    void   *user_data;
+} argus_trace_sink_t;
+
+/* Send every span to `sink` instead of the TRACEFILE exporter; NULL
+ * restores the default. Connections opened afterwards are traced even
+ * without TRACEFILE. */
+void argus_trace_set_sink(const argus_trace_sink_t *sink);
+
+/* ── Tracers ─────────────────────────────────────────────────── */
+
+/* NULL when tracing is off: no file and no sink, or sample <= 0 */
+argus_tracer_t *argus_tracer_open(const char *file, double sample);
+void argus_tracer_flush(argus_tracer_t *t);
+void argus_tracer_close(argus_tracer_t *t);
+
+/* ── Spans ───────────────────────────────────────────────────── */
+
+/* Start a new trace, subject to sampling. NULL when not recorded; every
+ * other function here accepts a NULL span. */
+argus_span_t *argus_trace_root(argus_tracer_t *t, const char *name);
+
+/* Start a span under `parent`; NULL when the parent was not sampled */
+argus_span_t *argus_trace_child(argus_tracer_t *t,
+                                const argus_trace_ctx_t *parent,
+                                const char *name);
+
+void argus_trace_attr_str(argus_span_t *span, const char *key,
+                          const char *value);
+void argus_trace_attr_int(argus_span_t *span, const char *key,
+                          int64_t value);
+
+/* End and export the span; `sqlstate` NULL or "" for success */
+void argus_trace_end(argus_span_t *span, const char *sqlstate);
+
+/* Bind `span` to the calling thread and return the previous binding, to be
+ * passed to argus_trace_leave */
+argus_span_t *argus_trace_enter(argus_span_t *span);
+void argus_trace_leave(argus_span_t *prev);
+
+/* The W3C traceparent of the span bound to the calling thread; false when
+ * there is none */
+bool argus_trace_traceparent(char out[ARGUS_TRACEPARENT_LEN]);
+
+#endif /* ARGUS_TRACE_H */
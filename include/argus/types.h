@@ -19,11 +19,61 @@
 /* Default fetch batch size */
 #define ARGUS_DEFAULT_BATCH_SIZE 1000
 
-/* Default cap on how many rows a static (scrollable) cursor will materialise in
- * memory. A scrollable cursor buffers the whole result set, so an unbounded
- * SELECT would OOM the process; past this cap the driver fails cleanly and tells
- * the application to use a forward-only cursor. Override with MaxScrollRows. */
-#define ARGUS_DEFAULT_MAX_SCROLL_ROWS 5000000L
+/* Adaptive fetch sizing: from the starting batch size (FETCHBUFFERSIZE or
+ * the application's preset), each statement resizes its next request so a
+ * batch holds about this many decoded bytes and takes about this long to
+ * arrive, within the row bounds. Override with FetchTargetBytes,
+ * FetchTargetMs, FetchMinRows and FetchMaxRows; AdaptiveFetch=0 keeps the
+ * batch size fixed. */
+#define ARGUS_DEFAULT_FETCH_TARGET_BYTES (8UL * 1024 * 1024)
+#define ARGUS_DEFAULT_FETCH_TARGET_MS    250
+#define ARGUS_DEFAULT_FETCH_MIN_ROWS     100
+#define ARGUS_DEFAULT_FETCH_MAX_ROWS     100000
+
+/* SQLBulkOperations(SQL_ADD) sends the rowset as multi-row INSERT ... VALUES
+ * statements of at most this many rows and bytes of SQL each, or fewer where
+ * the backend's dialect says so. The byte bound keeps a statement under
+ * Trino's query.max-length and BigQuery's 1MB query limit. Override with
+ * BulkInsertRows / BulkInsertBytes. */
+#define ARGUS_DEFAULT_BULK_INSERT_ROWS  1000
+#define ARGUS_DEFAULT_BULK_INSERT_BYTES (900UL * 1024)
+
+/* Static (scrollable) cursors keep the rows they have read in a paged store:
+ * this much of it stays in memory and the rest spills to a temporary file, up
+ * to a total beyond which the driver fails cleanly and tells the application
+ * to use a forward-only cursor. Override with ScrollMemory / MaxScrollBytes. */
+#define ARGUS_DEFAULT_SCROLL_MEMORY_BYTES (64UL * 1024 * 1024)
+#define ARGUS_DEFAULT_MAX_SCROLL_BYTES    (8ULL * 1024 * 1024 * 1024)
+
+/* Rows per Parquet row group / Arrow record batch / CSV block written by a
+ * direct-to-file extract, unless ARGUS_ATTR_EXTRACT_ROW_GROUP says otherwise */
+#define ARGUS_DEFAULT_EXTRACT_ROW_GROUP 131072
+
+/* Defaults for the opt-in client-side result cache (RESULTCACHE=1): entry
+ * lifetime, and the process-wide memory budget shared by all connections.
+ * Override with ResultCacheTTL / ResultCacheMaxBytes. */
+#define ARGUS_DEFAULT_RESULT_CACHE_TTL_SEC 300
+#define ARGUS_DEFAULT_RESULT_CACHE_BYTES   (64UL * 1024 * 1024)
+
+/* Budget of the process-wide cache of preprocessed statement text (escape
+ * translation and parameter-marker offsets). Override with SQLCacheMaxBytes
+ * (0 disables it). */
+#define ARGUS_DEFAULT_SQL_CACHE_BYTES      (8UL * 1024 * 1024)
+
+/* Lifetime of cached SQLTables/SQLColumns results. Override with
+ * MetadataCacheTTL (0 disables the metadata cache). */
+#define ARGUS_DEFAULT_METADATA_CACHE_TTL_SEC 60
+
+/* Hosts a HOST=h1,h2,h3 failover list may carry (bare IPv6 addresses are not
+ * supported in the list form — use a single HOST for IPv6). */
+#define ARGUS_MAX_HOSTS 16
+
+/* Failover connects: delay before racing the next host of the list while an
+ * attempt is still pending (RFC 8305's "Connection Attempt Delay"), and how
+ * long a host that keeps failing is tried last. Override with
+ * ConnectRaceDelay (0 tries the hosts one at a time) / HostCooldown. */
+#define ARGUS_DEFAULT_CONNECT_RACE_DELAY_MS 250
+#define ARGUS_DEFAULT_HOST_COOLDOWN_SEC     30
 
 /* Column descriptor - describes a result column */
 typedef struct argus_column_desc {
@@ -86,6 +136,8 @@ typedef struct argus_row_cache {
     size_t       current_row;   /* current position (0-based) */
     int          num_cols;      /* number of columns */
     bool         exhausted;     /* backend has no more rows */
+    bool         borrowed;      /* rows belong to a shared, immutable cache
+                                 * entry: free/clear detach, never free */
 } argus_row_cache_t;
 
 /* Initialize a row cache */
@@ -97,9 +149,19 @@ void argus_row_cache_free(argus_row_cache_t *cache);
 /* Clear cache contents but keep allocated memory */
 void argus_row_cache_clear(argus_row_cache_t *cache);
 
+/* Copy one row's cells (text and native values) into dst. Returns 0 on
+ * success, -1 on allocation failure (dst->cells is then NULL). */
+int argus_row_copy(argus_row_t *dst, const argus_row_t *src, int num_cols);
+
 /* Maximum number of bound parameters */
 #define ARGUS_MAX_PARAMS 256
 
+/* Driver-specific C type for SQLBindParameter: each element of the
+ * parameter array is a `const char *` to the value and its indicator holds
+ * the length (or SQL_NULL_DATA, the pointer then unused), so strings of an
+ * array need not be copied into fixed-width slots. Sent as SQL_C_CHAR. */
+#define ARGUS_C_CHAR_PTR 0x4001
+
 /* Parameter binding for SQLBindParameter */
 typedef struct argus_param_binding {
     SQLSMALLINT  io_type;
@@ -132,4 +194,9 @@ void argus_conn_params_free(argus_conn_params_t *params);
 int  argus_conn_params_parse(argus_conn_params_t *params, const char *conn_str);
 const char *argus_conn_params_get(const argus_conn_params_t *params, const char *key);
 
+/* SQL text helpers: skip leading whitespace, comments and opening
+ * parentheses; test for a case-insensitive keyword at p. */
+const char *argus_sql_skip_leading(const char *sql);
+bool argus_sql_keyword_at(const char *p, const char *kw);
+
 #endif /* ARGUS_TYPES_H */
@@ -12,11 +12,24 @@
  * 4096 rows each) with int64 / double / bool / date32 / timestamp[us] / utf8
  * columns (other SQL types are surfaced as utf8), bound parameters via
  * AdbcStatementBind, catalog metadata (GetObjects at catalog depth,
- * GetTableSchema, GetTableTypes) and the AdbcDriverInit driver-manager vtable
- * (ADBC 1.0.0). Deeper GetObjects levels, GetInfo and transactions are
- * follow-ups.
+ * GetTableSchema, GetTableTypes), direct-to-file extract through the
+ * "argus.extract.*" statement options (see argus/extract.h), bulk ingestion
+ * into an existing table ("adbc.ingest.target_table", append mode) from
+ * AdbcStatementBind or AdbcStatementBindStream, and the AdbcDriverInit
+ * driver-manager vtable (ADBC 1.0.0). Deeper GetObjects levels, GetInfo and
+ * transactions are follow-ups.
+ *
+ * Ingestion prepares "INSERT INTO t (cols) VALUES (?, ...)" and executes it
+ * once per record batch with the batch's columns bound as ODBC parameter
+ * arrays (fixed-width columns straight from the Arrow buffers, strings as
+ * pointers into them with ARGUS_C_CHAR_PTR). The driver
+ * hands such arrays to the backend's native bulk path with BulkLoad=1 (LOAD
+ * DATA LOCAL INFILE on MySQL-wire, BigQuery's streaming insert), and runs
+ * one INSERT per row otherwise.
  */
 #include "argus/adbc.h"
+#include "argus/extract.h"
+#include "argus/types.h"
 
 #include <sql.h>
 #include <sqlext.h>
@@ -47,6 +60,18 @@ typedef struct {
      * params), materialized to text and applied per-row on execute. */
     char**  params;
     int     nparams;
+    /* "argus.extract.*": write the result to a file instead of the stream */
+    char*   extract_path;
+    int     extract_format;
+    long    extract_row_group;
+    int     extract_compression;
+    /* "adbc.ingest.target_table": execute inserts the bound data into it */
+    char*   ingest_table;
+    /* Last AdbcStatementBind batch, or AdbcStatementBindStream stream
+     * (release == NULL: none) */
+    struct ArrowArray       bound;
+    struct ArrowSchema      bound_schema;
+    struct ArrowArrayStream bound_stream;
 } adbc_stmt_t;
 
 /* One result column collected into final Arrow buffers. */
@@ -502,6 +527,57 @@ AdbcStatusCode AdbcStatementSetSqlQuery(struct AdbcStatement* statement,
     return ADBC_STATUS_OK;
 }
 
+/* "argus.extract.path" turns the extract on (an empty value turns it off);
+ * format is arrow / parquet / csv / auto, compression none / gzip. */
+AdbcStatusCode AdbcStatementSetOption(struct AdbcStatement* statement, const char* key,
+                                      const char* value, struct AdbcError* error)
+{
+    if (!statement || !statement->private_data) { set_error(error, "invalid statement"); return ADBC_STATUS_INVALID_STATE; }
+    if (!key) { set_error(error, "missing option key"); return ADBC_STATUS_INVALID_ARGUMENT; }
+    adbc_stmt_t* st = statement->private_data;
+    const char* v = value ? value : "";
+
+    if (strcmp(key, "argus.extract.path") == 0) {
+        free(st->extract_path);
+        st->extract_path = *v ? strdup(v) : NULL;
+        return ADBC_STATUS_OK;
+    }
+    if (strcmp(key, "argus.extract.format") == 0) {
+        if (strcmp(v, "auto") == 0)         st->extract_format = ARGUS_EXTRACT_FORMAT_AUTO;
+        else if (strcmp(v, "arrow") == 0)   st->extract_format = ARGUS_EXTRACT_FORMAT_ARROW;
+        else if (strcmp(v, "parquet") == 0) st->extract_format = ARGUS_EXTRACT_FORMAT_PARQUET;
+        else if (strcmp(v, "csv") == 0)     st->extract_format = ARGUS_EXTRACT_FORMAT_CSV;
+        else { set_error(error, "argus.extract.format must be auto, arrow, parquet or csv"); return ADBC_STATUS_INVALID_ARGUMENT; }
+        return ADBC_STATUS_OK;
+    }
+    if (strcmp(key, "argus.extract.row_group") == 0) {
+        char* end = NULL;
+        errno = 0;
+        long rows = strtol(v, &end, 10);
+        if (end == v || *end || errno || rows < 0) { set_error(error, "argus.extract.row_group must be a row count"); return ADBC_STATUS_INVALID_ARGUMENT; }
+        st->extract_row_group = rows;
+        return ADBC_STATUS_OK;
+    }
+    if (strcmp(key, "argus.extract.compression") == 0) {
+        if (strcmp(v, "none") == 0)      st->extract_compression = ARGUS_EXTRACT_COMPRESS_NONE;
+        else if (strcmp(v, "gzip") == 0) st->extract_compression = ARGUS_EXTRACT_COMPRESS_GZIP;
+        else { set_error(error, "argus.extract.compression must be none or gzip"); return ADBC_STATUS_INVALID_ARGUMENT; }
+        return ADBC_STATUS_OK;
+    }
+    if (strcmp(key, ADBC_INGEST_OPTION_TARGET_TABLE) == 0) {
+        free(st->ingest_table);
+        st->ingest_table = *v ? strdup(v) : NULL;
+        return ADBC_STATUS_OK;
+    }
+    if (strcmp(key, ADBC_INGEST_OPTION_MODE) == 0) {
+        if (strcmp(v, ADBC_INGEST_OPTION_MODE_APPEND) == 0) return ADBC_STATUS_OK;
+        set_error(error, "only adbc.ingest.mode.append is supported: create the table first");
+        return ADBC_STATUS_NOT_IMPLEMENTED;
+    }
+    set_error(error, "unknown option");
+    return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
 /* Replace each top-level '?' marker with its bound literal. */
 static char* substitute_params(const char* q, char** params, int n)
 {
@@ -522,16 +598,355 @@ static char* substitute_params(const char* q, char** params, int n)
     return out;
 }
 
+/* ── Bulk ingestion ──────────────────────────────────────────── */
+
+static void clear_bound(adbc_stmt_t* st)
+{
+    if (st->bound.release) st->bound.release(&st->bound);
+    if (st->bound_schema.release) st->bound_schema.release(&st->bound_schema);
+    if (st->bound_stream.release) st->bound_stream.release(&st->bound_stream);
+    memset(&st->bound, 0, sizeof(st->bound));
+    memset(&st->bound_schema, 0, sizeof(st->bound_schema));
+    memset(&st->bound_stream, 0, sizeof(st->bound_stream));
+}
+
+/* Inverse of days_from_civil. */
+static void civil_from_days(int64_t z, int* y, unsigned* m, unsigned* d)
+{
+    z += 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned doe = (unsigned)(z - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    *d = doy - (153 * mp + 2) / 5 + 1;
+    *m = mp < 10 ? mp + 3 : mp - 9;
+    *y = (int)(yoe + era * 400) + (*m <= 2);
+}
+
+/* One Arrow column of a batch as an ODBC parameter array. */
+typedef struct {
+    SQLSMALLINT c_type, sql_type;
+    SQLULEN     column_size;
+    SQLSMALLINT digits;
+    SQLLEN      width;          /* buffer length of one element */
+    void*       data;           /* into the Arrow buffer, or owned */
+    void*       owned;
+    SQLLEN*     ind;
+} ingest_col_t;
+
+static int arrow_valid(const uint8_t* validity, int64_t i)
+{
+    return !validity || ((validity[i / 8] >> (i % 8)) & 1);
+}
+
+/* Bind rows [0, n) of `a` starting at element `off`; -1 for a type with no
+ * parameter mapping. */
+static int ingest_column(const char* fmt, const struct ArrowArray* a, int64_t off, int64_t n,
+                         ingest_col_t* col)
+{
+    const uint8_t* validity = (a->null_count != 0 && a->n_buffers > 0) ? a->buffers[0] : NULL;
+    memset(col, 0, sizeof(*col));
+    col->ind = calloc((size_t)(n > 0 ? n : 1), sizeof(SQLLEN));
+    if (!col->ind) return -1;
+
+    SQLLEN fixed = 0;
+    switch (fmt[0]) {
+    case 'l': col->c_type = SQL_C_SBIGINT;  col->sql_type = SQL_BIGINT;   fixed = 8; break;
+    case 'i': col->c_type = SQL_C_SLONG;    col->sql_type = SQL_INTEGER;  fixed = 4; break;
+    case 's': col->c_type = SQL_C_SSHORT;   col->sql_type = SQL_SMALLINT; fixed = 2; break;
+    case 'c': col->c_type = SQL_C_STINYINT; col->sql_type = SQL_TINYINT;  fixed = 1; break;
+    case 'g': col->c_type = SQL_C_DOUBLE;   col->sql_type = SQL_DOUBLE;   fixed = 8; break;
+    case 'f': col->c_type = SQL_C_FLOAT;    col->sql_type = SQL_REAL;     fixed = 4; break;
+    default: break;
+    }
+    if (fixed > 0) {
+        /* Same layout as the ODBC C type: bind the Arrow buffer itself */
+        col->width = fixed;
+        col->data = (char*)a->buffers[1] + off * fixed;
+        for (int64_t i = 0; i < n; i++)
+            col->ind[i] = arrow_valid(validity, off + i) ? 0 : SQL_NULL_DATA;
+        return 0;
+    }
+
+    if (fmt[0] == 'b') {
+        const uint8_t* bits = a->buffers[1];
+        unsigned char* v = malloc((size_t)(n > 0 ? n : 1));
+        if (!v) return -1;
+        for (int64_t i = 0; i < n; i++) {
+            v[i] = (bits[(off + i) / 8] >> ((off + i) % 8)) & 1;
+            col->ind[i] = arrow_valid(validity, off + i) ? 0 : SQL_NULL_DATA;
+        }
+        col->c_type = SQL_C_BIT; col->sql_type = SQL_BIT; col->width = 1;
+        col->data = col->owned = v;
+        return 0;
+    }
+
+    if (fmt[0] == 'u' || fmt[0] == 'U') {
+        /* utf8 / large_utf8: a pointer into the Arrow data per value, the
+         * length in its indicator (ARGUS_C_CHAR_PTR), nothing copied */
+        const int32_t* off32 = a->buffers[1];
+        const int64_t* off64 = a->buffers[1];
+        const char* chars = a->buffers[2] ? a->buffers[2] : "";
+        const char** v = malloc((size_t)(n > 0 ? n : 1) * sizeof(*v));
+        if (!v) return -1;
+        int64_t max = 1;
+        for (int64_t i = 0; i < n; i++) {
+            int64_t start = fmt[0] == 'u' ? off32[off + i] : off64[off + i];
+            int64_t len = fmt[0] == 'u' ? off32[off + i + 1] - start : off64[off + i + 1] - start;
+            v[i] = chars + start;
+            col->ind[i] = arrow_valid(validity, off + i) ? (SQLLEN)len : SQL_NULL_DATA;
+            if (len > max) max = len;
+        }
+        col->c_type = ARGUS_C_CHAR_PTR; col->sql_type = SQL_VARCHAR;
+        col->column_size = (SQLULEN)max; col->width = sizeof(*v);
+        col->data = col->owned = (void*)v;
+        return 0;
+    }
+
+    if (strcmp(fmt, "tdD") == 0) {
+        const int32_t* days = a->buffers[1];
+        SQL_DATE_STRUCT* v = calloc((size_t)(n > 0 ? n : 1), sizeof(*v));
+        if (!v) return -1;
+        for (int64_t i = 0; i < n; i++) {
+            int y; unsigned m, d;
+            civil_from_days(days[off + i], &y, &m, &d);
+            v[i].year = (SQLSMALLINT)y; v[i].month = (SQLUSMALLINT)m; v[i].day = (SQLUSMALLINT)d;
+            col->ind[i] = arrow_valid(validity, off + i) ? 0 : SQL_NULL_DATA;
+        }
+        col->c_type = SQL_C_TYPE_DATE; col->sql_type = SQL_TYPE_DATE;
+        col->column_size = 10; col->width = sizeof(*v);
+        col->data = col->owned = v;
+        return 0;
+    }
+
+    if (fmt[0] == 't' && fmt[1] == 's' && fmt[2] && fmt[3] == ':') {
+        /* timestamp[s|ms|us|ns], written as the UTC wall time */
+        int64_t per_sec = fmt[2] == 's' ? 1 : fmt[2] == 'm' ? 1000
+                        : fmt[2] == 'u' ? 1000000 : fmt[2] == 'n' ? 1000000000 : 0;
+        if (!per_sec) return -1;
+        const int64_t* ticks = a->buffers[1];
+        SQL_TIMESTAMP_STRUCT* v = calloc((size_t)(n > 0 ? n : 1), sizeof(*v));
+        if (!v) return -1;
+        for (int64_t i = 0; i < n; i++) {
+            int64_t t = ticks[off + i];
+            int64_t secs = t / per_sec, frac = t % per_sec;
+            if (frac < 0) { frac += per_sec; secs--; }
+            int64_t days = secs / 86400, tod = secs % 86400;
+            if (tod < 0) { tod += 86400; days--; }
+            int y; unsigned m, d;
+            civil_from_days(days, &y, &m, &d);
+            v[i].year = (SQLSMALLINT)y; v[i].month = (SQLUSMALLINT)m; v[i].day = (SQLUSMALLINT)d;
+            v[i].hour = (SQLUSMALLINT)(tod / 3600);
+            v[i].minute = (SQLUSMALLINT)(tod / 60 % 60);
+            v[i].second = (SQLUSMALLINT)(tod % 60);
+            v[i].fraction = (SQLUINTEGER)(frac * (1000000000 / per_sec));
+            col->ind[i] = arrow_valid(validity, off + i) ? 0 : SQL_NULL_DATA;
+        }
+        col->c_type = SQL_C_TYPE_TIMESTAMP; col->sql_type = SQL_TYPE_TIMESTAMP;
+        col->column_size = 26; col->digits = 6; col->width = sizeof(*v);
+        col->data = col->owned = v;
+        return 0;
+    }
+    return -1;
+}
+
+static void stmt_error(SQLHSTMT stmt, const char* what, struct AdbcError* error)
+{
+    SQLCHAR sst[6], msg[300]; SQLINTEGER nat; SQLSMALLINT len; char buf[360];
+    snprintf(buf, sizeof(buf), "%s", what);
+    if (SQLGetDiagRec(SQL_HANDLE_STMT, stmt, 1, sst, &nat, msg, sizeof(msg), &len) == SQL_SUCCESS)
+        snprintf(buf, sizeof(buf), "%s: %s", what, (char*)msg);
+    set_error(error, buf);
+}
+
+/* Execute the prepared INSERT over one record batch. */
+static AdbcStatusCode ingest_batch(SQLHSTMT stmt, const struct ArrowSchema* schema,
+                                   const struct ArrowArray* batch, int64_t* inserted,
+                                   struct AdbcError* error)
+{
+    int64_t n = batch->length;
+    if (n <= 0) return ADBC_STATUS_OK;
+    int ncols = (int)schema->n_children;
+    ingest_col_t* cols = calloc((size_t)ncols, sizeof(ingest_col_t));
+    SQLUSMALLINT* status = calloc((size_t)n, sizeof(SQLUSMALLINT));
+    if (!cols || !status) { free(cols); free(status); set_error(error, "out of memory"); return ADBC_STATUS_IO; }
+
+    AdbcStatusCode rc = ADBC_STATUS_OK;
+    SQLFreeStmt(stmt, SQL_RESET_PARAMS);
+    for (int c = 0; c < ncols && rc == ADBC_STATUS_OK; c++) {
+        const struct ArrowArray* child = batch->children[c];
+        if (ingest_column(schema->children[c]->format, child, batch->offset + child->offset, n,
+                          &cols[c]) != 0) {
+            char buf[300];
+            snprintf(buf, sizeof(buf), "cannot ingest column '%s' of Arrow type '%s'",
+                     schema->children[c]->name ? schema->children[c]->name : "",
+                     schema->children[c]->format);
+            set_error(error, buf);
+            rc = ADBC_STATUS_NOT_IMPLEMENTED;
+            break;
+        }
+        SQLBindParameter(stmt, (SQLUSMALLINT)(c + 1), SQL_PARAM_INPUT, cols[c].c_type,
+                         cols[c].sql_type, cols[c].column_size, cols[c].digits,
+                         cols[c].data, cols[c].width, cols[c].ind);
+    }
+
+    if (rc == ADBC_STATUS_OK) {
+        SQLSetStmtAttr(stmt, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER)SQL_PARAM_BIND_BY_COLUMN, 0);
+        SQLSetStmtAttr(stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)(intptr_t)n, 0);
+        SQLSetStmtAttr(stmt, SQL_ATTR_PARAM_STATUS_PTR, status, 0);
+        SQLRETURN er = SQLExecute(stmt);
+        int64_t ok = 0, unknown = 0;
+        for (int64_t i = 0; i < n; i++) {
+            ok += (status[i] == SQL_PARAM_SUCCESS);
+            unknown += (status[i] == SQL_PARAM_DIAG_UNAVAILABLE);
+        }
+        /* The server skipped rows without saying which (LOAD DATA): only
+         * its count of the rows added is known */
+        SQLLEN count = 0;
+        if (unknown > 0 && SQL_SUCCEEDED(SQLRowCount(stmt, &count)) && count >= 0)
+            ok = (int64_t)count;
+        *inserted += ok;
+        if (!SQL_SUCCEEDED(er) || ok < n) {
+            char what[96];
+            snprintf(what, sizeof(what), unknown > 0
+                         ? "%lld of %lld rows not inserted, not known which"
+                         : "%lld of %lld rows not inserted",
+                     (long long)(n - ok), (long long)n);
+            stmt_error(stmt, what, error);
+            rc = ADBC_STATUS_IO;
+        }
+        SQLSetStmtAttr(stmt, SQL_ATTR_PARAM_STATUS_PTR, NULL, 0);
+    }
+
+    for (int c = 0; c < ncols; c++) { free(cols[c].owned); free(cols[c].ind); }
+    free(cols);
+    free(status);
+    return rc;
+}
+
+/* "INSERT INTO "t" ("a", "b") VALUES (?, ?)" in the server's identifier
+ * quotes. */
+static char* ingest_sql(SQLHDBC dbc, const char* table, const struct ArrowSchema* schema)
+{
+    char q[8] = "\"";
+    SQLSMALLINT ql = 0;
+    if (!SQL_SUCCEEDED(SQLGetInfo(dbc, SQL_IDENTIFIER_QUOTE_CHAR, q, sizeof(q), &ql)) || q[0] == ' ')
+        q[0] = '\0';
+    q[1] = '\0';
+
+    size_t cap = strlen(table) * 2 + 64;
+    for (int64_t c = 0; c < schema->n_children; c++)
+        cap += strlen(schema->children[c]->name ? schema->children[c]->name : "") * 2 + 8;
+    char* sql = malloc(cap);
+    if (!sql) return NULL;
+    char* p = sql;
+    p += sprintf(p, "INSERT INTO ");
+    for (int64_t c = -1; c < schema->n_children; c++) {
+        const char* name = c < 0 ? table : schema->children[c]->name ? schema->children[c]->name : "";
+        if (c >= 0) p += sprintf(p, c == 0 ? " (" : ", ");
+        p += sprintf(p, "%s", q);
+        for (const char* s = name; *s; s++) { if (q[0] && *s == q[0]) *p++ = *s; *p++ = *s; }
+        p += sprintf(p, "%s", q);
+    }
+    p += sprintf(p, ") VALUES (");
+    for (int64_t c = 0; c < schema->n_children; c++) p += sprintf(p, c ? ", ?" : "?");
+    sprintf(p, ")");
+    return sql;
+}
+
+/* ExecuteQuery with a target table: insert the bound batch or stream. */
+static AdbcStatusCode ingest(adbc_stmt_t* st, int64_t* rows_affected, struct AdbcError* error)
+{
+    if (rows_affected) *rows_affected = -1;
+    if (!st->bound.release && !st->bound_stream.release) {
+        set_error(error, "ingestion needs data bound with AdbcStatementBind or AdbcStatementBindStream");
+        return ADBC_STATUS_INVALID_STATE;
+    }
+
+    struct ArrowSchema schema;
+    memset(&schema, 0, sizeof(schema));
+    if (st->bound_stream.release) {
+        if (st->bound_stream.get_schema(&st->bound_stream, &schema) != 0) {
+            const char* e = st->bound_stream.get_last_error(&st->bound_stream);
+            set_error(error, e ? e : "cannot read the bound stream's schema");
+            clear_bound(st);
+            return ADBC_STATUS_IO;
+        }
+    }
+    const struct ArrowSchema* sch = st->bound_stream.release ? &schema : &st->bound_schema;
+    if (sch->n_children <= 0 || sch->n_children > 32767) {
+        set_error(error, "the bound data must be a struct of at least one column");
+        if (schema.release) schema.release(&schema);
+        clear_bound(st);
+        return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+
+    SQLHSTMT stmt;
+    char* sql = ingest_sql(st->dbc, st->ingest_table, sch);
+    if (!sql || SQLAllocHandle(SQL_HANDLE_STMT, st->dbc, &stmt) != SQL_SUCCESS) {
+        free(sql);
+        if (schema.release) schema.release(&schema);
+        clear_bound(st);
+        set_error(error, "alloc stmt failed");
+        return ADBC_STATUS_IO;
+    }
+
+    AdbcStatusCode rc = ADBC_STATUS_OK;
+    int64_t inserted = 0;
+    if (!SQL_SUCCEEDED(SQLPrepare(stmt, (SQLCHAR*)sql, SQL_NTS))) {
+        stmt_error(stmt, "prepare failed", error);
+        rc = ADBC_STATUS_IO;
+    } else if (st->bound.release) {
+        rc = ingest_batch(stmt, sch, &st->bound, &inserted, error);
+    } else {
+        /* One batch at a time: the producer stays at most a batch ahead */
+        for (;;) {
+            struct ArrowArray batch;
+            memset(&batch, 0, sizeof(batch));
+            if (st->bound_stream.get_next(&st->bound_stream, &batch) != 0) {
+                const char* e = st->bound_stream.get_last_error(&st->bound_stream);
+                set_error(error, e ? e : "reading the bound stream failed");
+                rc = ADBC_STATUS_IO;
+                break;
+            }
+            if (!batch.release) break;   /* end of stream */
+            rc = ingest_batch(stmt, sch, &batch, &inserted, error);
+            batch.release(&batch);
+            if (rc != ADBC_STATUS_OK) break;
+        }
+    }
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free(sql);
+    if (schema.release) schema.release(&schema);
+    clear_bound(st);   /* execute consumes the bound data */
+    if (rows_affected) *rows_affected = inserted;
+    return rc;
+}
+
 AdbcStatusCode AdbcStatementExecuteQuery(struct AdbcStatement* statement,
                                          struct ArrowArrayStream* out,
                                          int64_t* rows_affected, struct AdbcError* error)
 {
-    if (!statement || !statement->private_data || !out) { set_error(error, "invalid args"); return ADBC_STATUS_INVALID_ARGUMENT; }
+    if (!statement || !statement->private_data) { set_error(error, "invalid args"); return ADBC_STATUS_INVALID_ARGUMENT; }
     adbc_stmt_t* st = statement->private_data;
+    if (st->ingest_table) {
+        /* Ingestion returns no result set */
+        if (out) memset(out, 0, sizeof(*out));
+        return ingest(st, rows_affected, error);
+    }
+    if (!out) { set_error(error, "invalid args"); return ADBC_STATUS_INVALID_ARGUMENT; }
     if (!st->query) { set_error(error, "no query set"); return ADBC_STATUS_INVALID_STATE; }
 
     SQLHSTMT stmt;
     if (SQLAllocHandle(SQL_HANDLE_STMT, st->dbc, &stmt) != SQL_SUCCESS) { set_error(error, "alloc stmt failed"); return ADBC_STATUS_IO; }
+    if (st->extract_path) {
+        SQLSetStmtAttr(stmt, ARGUS_ATTR_EXTRACT_PATH, st->extract_path, SQL_NTS);
+        SQLSetStmtAttr(stmt, ARGUS_ATTR_EXTRACT_FORMAT, (SQLPOINTER)(intptr_t)st->extract_format, 0);
+        SQLSetStmtAttr(stmt, ARGUS_ATTR_EXTRACT_ROW_GROUP, (SQLPOINTER)(intptr_t)st->extract_row_group, 0);
+        SQLSetStmtAttr(stmt, ARGUS_ATTR_EXTRACT_COMPRESSION, (SQLPOINTER)(intptr_t)st->extract_compression, 0);
+    }
     char* subst = (st->nparams > 0) ? substitute_params(st->query, st->params, st->nparams) : NULL;
     const char* exec_q = subst ? subst : st->query;
     SQLRETURN er = SQLExecDirect(stmt, (SQLCHAR*)exec_q, SQL_NTS);
@@ -563,6 +978,11 @@ AdbcStatusCode AdbcStatementExecuteQuery(struct AdbcStatement* statement,
     s->stmt = stmt;
     s->batch_size = ADBC_BATCH_ROWS;
     if (rows_affected) *rows_affected = -1;   /* unknown for SELECT */
+    if (st->extract_path && rows_affected) {
+        /* The rows went to the file; the stream only carries the schema */
+        SQLLEN written = 0;
+        if (SQLRowCount(stmt, &written) == SQL_SUCCESS) *rows_affected = written;
+    }
 
     memset(out, 0, sizeof(*out));
     out->get_schema = stream_get_schema;
@@ -581,6 +1001,9 @@ AdbcStatusCode AdbcStatementRelease(struct AdbcStatement* statement, struct Adbc
         free(st->query);
         for (int i = 0; i < st->nparams; i++) free(st->params[i]);
         free(st->params);
+        free(st->extract_path);
+        free(st->ingest_table);
+        clear_bound(st);
         free(st);
         statement->private_data = NULL;
     }
@@ -636,17 +1059,37 @@ AdbcStatusCode AdbcStatementBind(struct AdbcStatement* statement, struct ArrowAr
         set_error(error, "invalid bind args"); return ADBC_STATUS_INVALID_ARGUMENT;
     }
     adbc_stmt_t* st = statement->private_data;
-    /* The bind set is a struct array: one child per parameter, row 0 used. */
+    /* The bind set is a struct array: one child per parameter, row 0 used
+     * for a query, every row for ingestion. */
     int n = (int)schema->n_children;
     for (int i = 0; i < st->nparams; i++) free(st->params[i]);
     free(st->params);
     st->params = (n > 0) ? calloc((size_t)n, sizeof(char*)) : NULL;
     st->nparams = n;
-    for (int i = 0; i < n; i++)
-        st->params[i] = param_to_literal(schema->children[i]->format, values->children[i]);
+    if (values->length > 0)
+        for (int i = 0; i < n; i++)
+            st->params[i] = param_to_literal(schema->children[i]->format, values->children[i]);
+
+    /* ADBC: bind takes ownership; the batch is kept for ingestion */
+    clear_bound(st);
+    st->bound = *values;
+    st->bound_schema = *schema;
+    values->release = NULL;
+    schema->release = NULL;
+    return ADBC_STATUS_OK;
+}
 
-    if (values->release) values->release(values);   /* ADBC: bind takes ownership */
-    if (schema->release) schema->release(schema);
+/* A stream of batches to ingest (the statement takes ownership). */
+AdbcStatusCode AdbcStatementBindStream(struct AdbcStatement* statement,
+                                       struct ArrowArrayStream* stream, struct AdbcError* error)
+{
+    if (!statement || !statement->private_data || !stream || !stream->release) {
+        set_error(error, "invalid bind args"); return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    adbc_stmt_t* st = statement->private_data;
+    clear_bound(st);
+    st->bound_stream = *stream;
+    stream->release = NULL;
     return ADBC_STATUS_OK;
 }
 
@@ -1000,8 +1443,10 @@ AdbcStatusCode AdbcDriverInit(int version, void* raw_driver, struct AdbcError* e
 
     d->StatementNew             = AdbcStatementNew;
     d->StatementSetSqlQuery     = AdbcStatementSetSqlQuery;
+    d->StatementSetOption       = AdbcStatementSetOption;
     d->StatementPrepare         = AdbcStatementPrepare;
     d->StatementBind            = AdbcStatementBind;
+    d->StatementBindStream      = AdbcStatementBindStream;
     d->StatementExecuteQuery    = AdbcStatementExecuteQuery;
     d->StatementRelease         = AdbcStatementRelease;
     return ADBC_STATUS_OK;
@@ -35,10 +35,19 @@ extern const argus_backend_t *argus_druid_backend_get(void);
 #ifdef ARGUS_HAS_BIGQUERY
 extern const argus_backend_t *argus_bigquery_backend_get(void);
 #endif
+/* Always built: needs nothing beyond GLib */
+extern const argus_backend_t *argus_replay_backend_get(void);
+extern const argus_backend_t *argus_synthetic_backend_get(void);
 
 void argus_backend_register(const argus_backend_t *backend)
 {
-    if (registry_count < ARGUS_MAX_BACKENDS && backend) {
+    if (!backend) return;
+    /* Registering twice (a test calling argus_backends_init again) is a
+     * no-op rather than a second slot */
+    for (int i = 0; i < registry_count; i++) {
+        if (registry[i] == backend) return;
+    }
+    if (registry_count < ARGUS_MAX_BACKENDS) {
         registry[registry_count++] = backend;
     }
 }
@@ -86,4 +95,6 @@ void argus_backends_init(void)
 #ifdef ARGUS_HAS_BIGQUERY
     argus_backend_register(argus_bigquery_backend_get());
 #endif
+    argus_backend_register(argus_replay_backend_get());
+    argus_backend_register(argus_synthetic_backend_get());
 }
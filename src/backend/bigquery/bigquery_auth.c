@@ -1,6 +1,7 @@
 #include "bigquery_internal.h"
 #include "argus/log.h"
 #include "argus/compat.h"
+#include "../http_client.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -120,7 +121,7 @@ static int bq_fetch_token(bq_conn_t *conn)
     g_free(signing_input);
     free(sig);
 
-    CURL *c = curl_easy_init();
+    CURL *c = argus_http_easy_init();
     if (!c) { g_free(assertion); return -1; }
     char *e_assert = curl_easy_escape(c, assertion, 0);
     g_free(assertion);
@@ -1,7 +1,9 @@
 #include "bigquery_internal.h"
+#include "argus/cancel.h"
 #include "argus/handle.h"
 #include "argus/log.h"
 #include "argus/compat.h"
+#include "../http_client.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -45,26 +47,17 @@ int bq_http(bq_conn_t *conn, const char *url, const char *post_body,
 {
     if (bq_auth_ensure(conn) != 0) return -1;
 
+    /* conn->headers is rebuilt when the access token is refreshed */
     CURL *curl = conn->curl;
-    curl_easy_reset(curl);
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, conn->headers);
-    bq_apply_tls(conn, curl);
-    if (conn->connect_timeout_sec > 0)
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT,
-                         (long)conn->connect_timeout_sec);
-    if (post_body) {
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_body);
-    } else {
-        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-    }
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, argus_bq_write_cb);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, resp);
+    struct curl_slist *traced = argus_http_trace_headers(conn->headers);
+    argus_http_prepare(curl, post_body ? "POST" : "GET", url, post_body,
+                       traced ? traced : conn->headers, argus_bq_write_cb,
+                       resp);
     resp->data = NULL;
     resp->size = 0;
 
     CURLcode cc = curl_easy_perform(curl);
+    curl_slist_free_all(traced);
     long code = 0;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
     if (http_code) *http_code = code;
@@ -368,16 +361,20 @@ static int bq_ingest_result(bq_conn_t *conn, bq_op_t *op, JsonObject *root,
     return 0;
 }
 
-/* GET getQueryResults for job polling and pagination. */
+/* GET getQueryResults for job polling and pagination. The server holds the
+ * request up to timeout_ms while the job runs; 0 answers at once. A page
+ * holds up to max_results rows (FETCHBUFFERSIZE when <= 0). */
 static int bq_get_query_results(bq_conn_t *conn, bq_op_t *op,
-                                const char *page_token, bool *complete)
+                                const char *page_token, int timeout_ms,
+                                int max_results, bool *complete)
 {
     char *e_job = g_uri_escape_string(op->job_id, NULL, FALSE);
     GString *url = g_string_new(NULL);
     g_string_printf(url, "%s/bigquery/v2/projects/%s/queries/%s"
-                         "?timeoutMs=10000&maxResults=%d",
+                         "?timeoutMs=%d&maxResults=%d",
                     conn->base_url, conn->project, e_job,
-                    conn->fetch_buffer_size);
+                    timeout_ms, max_results > 0 ? max_results
+                                                : conn->fetch_buffer_size);
     g_free(e_job);
     if (op->location && *op->location) {
         char *e_loc = g_uri_escape_string(op->location, NULL, FALSE);
@@ -482,9 +479,6 @@ static int bq_connect(argus_dbc_t *dbc,
 
     bq_conn_t *conn = calloc(1, sizeof(*conn));
     if (!conn) return -1;
-    conn->curl = curl_easy_init();
-    if (!conn->curl) { free(conn); return -1; }
-
     conn->project = strdup(dbc->bq_project);
     if (database && *database) conn->dataset = strdup(database);
     if (dbc->bq_location) conn->location = strdup(dbc->bq_location);
@@ -512,6 +506,27 @@ static int bq_connect(argus_dbc_t *dbc,
     conn->query_timeout_sec = dbc->query_timeout_sec;
     conn->fetch_buffer_size = dbc->fetch_buffer_size > 0
         ? dbc->fetch_buffer_size : 1000;
+    conn->bulk_load = dbc->bulk_load;
+
+    /* TLS material and timeouts are fixed per connection: applied once */
+    argus_http_opts_t opts = {
+        .tls                 = true,
+        .tls_verify          = conn->ssl_verify,
+        .ca_file             = (conn->ssl_ca_file && *conn->ssl_ca_file)
+                               ? conn->ssl_ca_file : NULL,
+        .cert_file           = (conn->ssl_cert_file && *conn->ssl_cert_file)
+                               ? conn->ssl_cert_file : NULL,
+        .key_file            = (conn->ssl_key_file && *conn->ssl_key_file)
+                               ? conn->ssl_key_file : NULL,
+        .connect_timeout_sec = conn->connect_timeout_sec,
+    };
+    conn->curl = argus_http_handle_new(&opts);
+    if (!conn->curl) {
+        argus_set_error(&dbc->diag, "08001",
+                        "[Argus][BigQuery] Failed to initialize HTTP client", 0);
+        bq_conn_free(conn);
+        return -1;
+    }
 
     if (dbc->bq_access_token && *dbc->bq_access_token) {
         conn->access_token = strdup(dbc->bq_access_token);
@@ -559,11 +574,15 @@ static bool bq_is_alive(argus_backend_conn_t raw)
 
 /* ── Execute ─────────────────────────────────────────────────── */
 
-static int bq_execute(argus_backend_conn_t raw, const char *query,
-                      argus_backend_op_t *out_op)
+#define BQ_WAIT_MS      10000   /* server-side wait per blocking request */
+#define BQ_POLL_MIN_MS  50      /* first wait between non-blocking checks */
+#define BQ_POLL_MAX_MS  2000
+
+/* POST jobs.query, waiting up to timeout_ms for the job to finish; a job
+ * still running is left to bq_check_job. */
+static int bq_start_query(bq_conn_t *conn, const char *query, int timeout_ms,
+                          bq_op_t **out_op)
 {
-    bq_conn_t *conn = (bq_conn_t *)raw;
-    if (!conn || !query || !out_op) return -1;
     conn->last_error[0] = '\0';
 
     JsonBuilder *b = json_builder_new();
@@ -573,7 +592,7 @@ static int bq_execute(argus_backend_conn_t raw, const char *query,
     json_builder_set_member_name(b, "useLegacySql");
     json_builder_add_boolean_value(b, FALSE);
     json_builder_set_member_name(b, "timeoutMs");
-    json_builder_add_int_value(b, 10000);
+    json_builder_add_int_value(b, timeout_ms);
     json_builder_set_member_name(b, "maxResults");
     json_builder_add_int_value(b, conn->fetch_buffer_size);
     if (conn->dataset && *conn->dataset) {
@@ -612,31 +631,70 @@ static int bq_execute(argus_backend_conn_t raw, const char *query,
     JsonParser *p = bq_parse(resp.data);
     free(resp.data);
     if (!p) { bq_op_free(op); return -1; }
-    bool complete = false;
+    op->started = time(NULL);
     rc = bq_ingest_result(conn, op,
                           json_node_get_object(json_parser_get_root(p)),
-                          &complete);
+                          &op->complete);
     g_object_unref(p);
     if (rc != 0) { bq_op_free(op); return -1; }
 
+    *out_op = op;
+    return 0;
+}
+
+/* One getQueryResults call on a running job, enforcing QUERYTIMEOUT.
+ * Returns 0 (op->complete updated) or -1 with last_error set. */
+static int bq_cancel(argus_backend_conn_t raw, argus_backend_op_t rop);
+
+/* jobs.cancel for a job the driver gave up on, which would otherwise run
+ * (and bill) to the end. Made outside the statement's cancel token, which
+ * would abort this request too. */
+static void bq_stop_job(bq_conn_t *conn, bq_op_t *op)
+{
+    argus_cancel_t *prev = argus_cancel_enter(NULL);
+    bq_cancel(conn, op);
+    argus_cancel_leave(prev);
+}
+
+static int bq_check_job(bq_conn_t *conn, bq_op_t *op, int timeout_ms)
+{
+    if (!op->job_id) {
+        snprintf(conn->last_error, sizeof(conn->last_error),
+                 "[Argus][BigQuery] Incomplete job without jobReference");
+        return -1;
+    }
+    if (conn->query_timeout_sec > 0 &&
+        time(NULL) - op->started > (time_t)conn->query_timeout_sec) {
+        bq_stop_job(conn, op);
+        snprintf(conn->last_error, sizeof(conn->last_error),
+                 "[Argus][BigQuery] Query timed out after %d s",
+                 conn->query_timeout_sec);
+        return -1;
+    }
+    /* The long poll below is aborted by SQLCancel and the statement's
+     * query timeout (http_client.h) */
+    int rc = bq_get_query_results(conn, op, NULL, timeout_ms, 0,
+                                  &op->complete);
+    if (rc != 0 && argus_cancel_requested(argus_cancel_current())) {
+        bq_stop_job(conn, op);
+        snprintf(conn->last_error, sizeof(conn->last_error),
+                 "[Argus][BigQuery] Query was cancelled");
+    }
+    return rc;
+}
+
+static int bq_execute(argus_backend_conn_t raw, const char *query,
+                      argus_backend_op_t *out_op)
+{
+    bq_conn_t *conn = (bq_conn_t *)raw;
+    if (!conn || !query || !out_op) return -1;
+
+    bq_op_t *op = NULL;
+    if (bq_start_query(conn, query, BQ_WAIT_MS, &op) != 0) return -1;
+
     /* Long-poll until the job completes (each call blocks <= 10 s). */
-    time_t start = time(NULL);
-    while (!complete) {
-        if (!op->job_id) {
-            snprintf(conn->last_error, sizeof(conn->last_error),
-                     "[Argus][BigQuery] Incomplete job without jobReference");
-            bq_op_free(op);
-            return -1;
-        }
-        if (conn->query_timeout_sec > 0 &&
-            time(NULL) - start > (time_t)conn->query_timeout_sec) {
-            snprintf(conn->last_error, sizeof(conn->last_error),
-                     "[Argus][BigQuery] Query timed out after %d s",
-                     conn->query_timeout_sec);
-            bq_op_free(op);
-            return -1;
-        }
-        if (bq_get_query_results(conn, op, NULL, &complete) != 0) {
+    while (!op->complete) {
+        if (bq_check_job(conn, op, BQ_WAIT_MS) != 0) {
             bq_op_free(op);
             return -1;
         }
@@ -646,6 +704,39 @@ static int bq_execute(argus_backend_conn_t raw, const char *query,
     return 0;
 }
 
+/* backend.h submit/poll: the same requests with timeoutMs=0, so nothing
+ * waits on the server; the caller spaces the checks out as bq_poll asks. */
+static int bq_submit(argus_backend_conn_t raw, const char *query,
+                     argus_backend_op_t *out_op)
+{
+    bq_conn_t *conn = (bq_conn_t *)raw;
+    if (!conn || !query || !out_op) return -1;
+
+    bq_op_t *op = NULL;
+    if (bq_start_query(conn, query, 0, &op) != 0) return -1;
+    *out_op = op;
+    return 0;
+}
+
+static int bq_poll(argus_backend_conn_t raw, argus_backend_op_t rop,
+                   bool *finished, int *next_ms)
+{
+    bq_conn_t *conn = (bq_conn_t *)raw;
+    bq_op_t *op = (bq_op_t *)rop;
+    if (!conn || !op) return -1;
+
+    if (!op->complete && bq_check_job(conn, op, 0) != 0) return -1;
+    *finished = op->complete;
+    if (!op->complete) {
+        /* Jobs take seconds: start at BQ_POLL_MIN_MS, back off by half */
+        op->poll_ms = op->poll_ms < BQ_POLL_MIN_MS ? BQ_POLL_MIN_MS
+                                                   : op->poll_ms * 3 / 2;
+        if (op->poll_ms > BQ_POLL_MAX_MS) op->poll_ms = BQ_POLL_MAX_MS;
+        *next_ms = op->poll_ms;
+    }
+    return 0;
+}
+
 static int bq_get_operation_status(argus_backend_conn_t conn,
                                    argus_backend_op_t op, bool *finished)
 {
@@ -704,7 +795,6 @@ static int bq_fetch_results(argus_backend_conn_t rconn, argus_backend_op_t raw,
                             int max_rows, argus_row_cache_t *cache,
                             argus_column_desc_t *columns, int *num_cols)
 {
-    (void)max_rows;
     bq_conn_t *conn = (bq_conn_t *)rconn;
     bq_op_t *op = (bq_op_t *)raw;
     if (!op || !cache) return -1;
@@ -715,12 +805,14 @@ static int bq_fetch_results(argus_backend_conn_t rconn, argus_backend_op_t raw,
         *num_cols = op->num_cols;
     }
 
-    /* Pull the next page when the current one was already delivered. */
+    /* Pull the next page when the current one was already delivered,
+     * sized as the driver asks. */
     if (!op->page_ready && op->page_token && conn) {
         char *token = op->page_token;
         op->page_token = NULL;
         bool complete = true;
-        int rc = bq_get_query_results(conn, op, token, &complete);
+        int rc = bq_get_query_results(conn, op, token, BQ_WAIT_MS, max_rows,
+                                      &complete);
         free(token);
         if (rc != 0) return -1;
     }
@@ -1018,6 +1110,231 @@ static int bq_get_columns(argus_backend_conn_t raw, const char *catalog,
     return 0;
 }
 
+/* ── Streaming insert (SQLBulkOperations SQL_ADD) ────────────── */
+
+#define BQ_INSERT_ROWS  500     /* rows per tabledata.insertAll request */
+
+/* project, dataset and table of a name as a query writes it: `p.d.t`,
+ * d.t (the connection's project) or t (its default dataset) */
+static bool bq_split_table(bq_conn_t *conn, const char *name, char **project,
+                           char **dataset, char **table)
+{
+    char *bare = g_strdup(name);
+    char *w = bare;
+    for (const char *r = name; *r; r++)
+        if (*r != '`' && *r != '"') *w++ = *r;
+    *w = '\0';
+
+    gchar **parts = g_strsplit(bare, ".", 0);
+    guint n = g_strv_length(parts);
+    bool ok = true;
+    if (n == 3) {
+        *project = g_strdup(parts[0]);
+        *dataset = g_strdup(parts[1]);
+        *table = g_strdup(parts[2]);
+    } else if (n == 2) {
+        *project = g_strdup(conn->project);
+        *dataset = g_strdup(parts[0]);
+        *table = g_strdup(parts[1]);
+    } else if (n == 1 && conn->dataset && *conn->dataset) {
+        *project = g_strdup(conn->project);
+        *dataset = g_strdup(conn->dataset);
+        *table = g_strdup(parts[0]);
+    } else {
+        ok = false;
+    }
+    g_strfreev(parts);
+    g_free(bare);
+    return ok;
+}
+
+/* One cell as the JSON value insertAll expects for its column */
+static void bq_add_cell(JsonBuilder *b, const argus_column_desc_t *col,
+                        const argus_cell_t *cell)
+{
+    if (cell->is_null || !cell->data) {
+        json_builder_add_null_value(b);
+        return;
+    }
+    switch (col->sql_type) {
+    case SQL_BIT:
+        json_builder_add_boolean_value(b,
+            strcmp(cell->data, "1") == 0 ||
+            g_ascii_strcasecmp(cell->data, "true") == 0);
+        break;
+    case SQL_BINARY:
+    case SQL_VARBINARY:
+    case SQL_LONGVARBINARY: {
+        gchar *b64 = g_base64_encode((const guchar *)cell->data,
+                                     cell->data_len);
+        json_builder_add_string_value(b, b64);
+        g_free(b64);
+        break;
+    }
+    default:
+        /* Numbers and temporal values too: BigQuery coerces strings */
+        json_builder_add_string_value(b, cell->data);
+        break;
+    }
+}
+
+/* POST one insertAll request for rows [start, start + n); sets row_ok[i]
+ * (relative to start) for the rows sent that the response reports no error
+ * for */
+static int bq_insert_chunk(bq_conn_t *conn, const char *url,
+                           const argus_column_desc_t *columns, int ncols,
+                           const argus_bulk_rows_t *rows, size_t start,
+                           size_t n, bool *row_ok)
+{
+    /* The request's row indexes, which insertErrors refer to, skip the rows
+     * that could not be converted */
+    size_t *sent = g_new(size_t, n);
+    size_t nsent = 0;
+
+    JsonBuilder *b = json_builder_new();
+    json_builder_begin_object(b);
+    json_builder_set_member_name(b, "skipInvalidRows");
+    json_builder_add_boolean_value(b, TRUE);
+    json_builder_set_member_name(b, "rows");
+    json_builder_begin_array(b);
+    for (size_t r = 0; r < n; r++) {
+        row_ok[r] = false;
+        const argus_cell_t *cells = rows->get(rows->ctx, start + r);
+        if (!cells) continue;
+        sent[nsent++] = r;
+        json_builder_begin_object(b);
+        json_builder_set_member_name(b, "json");
+        json_builder_begin_object(b);
+        for (int c = 0; c < ncols; c++) {
+            json_builder_set_member_name(b, (const char *)columns[c].name);
+            bq_add_cell(b, &columns[c], &cells[c]);
+        }
+        json_builder_end_object(b);
+        json_builder_end_object(b);
+    }
+    json_builder_end_array(b);
+    json_builder_end_object(b);
+    if (nsent == 0) {
+        g_object_unref(b);
+        g_free(sent);
+        return 0;
+    }
+
+    JsonGenerator *gen = json_generator_new();
+    json_generator_set_root(gen, json_builder_get_root(b));
+    char *body = json_generator_to_data(gen, NULL);
+    g_object_unref(gen);
+    g_object_unref(b);
+
+    bq_response_t resp = {0};
+    int rc = bq_http(conn, url, body, &resp, NULL);
+    g_free(body);
+    if (rc != 0) {
+        free(resp.data);
+        g_free(sent);
+        return -1;
+    }
+
+    for (size_t i = 0; i < nsent; i++) row_ok[sent[i]] = true;
+    JsonParser *p = bq_parse(resp.data);
+    free(resp.data);
+    if (!p) {
+        snprintf(conn->last_error, sizeof(conn->last_error),
+                 "[Argus][BigQuery] Unreadable insertAll response");
+        g_free(sent);
+        return -1;
+    }
+    JsonObject *o = json_node_get_object(json_parser_get_root(p));
+    JsonArray *errs = (o && json_object_has_member(o, "insertErrors"))
+        ? json_object_get_array_member(o, "insertErrors") : NULL;
+    guint nerr = errs ? json_array_get_length(errs) : 0;
+    for (guint i = 0; i < nerr; i++) {
+        JsonObject *e = json_array_get_object_element(errs, i);
+        if (!e || !json_object_has_member(e, "index")) continue;
+        gint64 idx = json_object_get_int_member(e, "index");
+        if (idx >= 0 && (size_t)idx < nsent) row_ok[sent[idx]] = false;
+
+        /* The first reason given, for the diagnostic */
+        JsonArray *why = json_object_has_member(e, "errors")
+            ? json_object_get_array_member(e, "errors") : NULL;
+        JsonObject *w = (why && json_array_get_length(why) > 0)
+            ? json_array_get_object_element(why, 0) : NULL;
+        if (!conn->last_error[0] && w &&
+            json_object_has_member(w, "message"))
+            snprintf(conn->last_error, sizeof(conn->last_error),
+                     "[Argus][BigQuery] %s",
+                     json_object_get_string_member(w, "message"));
+    }
+    g_object_unref(p);
+    g_free(sent);
+    if (nerr > 0 && !conn->last_error[0])
+        snprintf(conn->last_error, sizeof(conn->last_error),
+                 "[Argus][BigQuery] insertAll rejected %u row(s)", nerr);
+    return nerr > 0 ? -1 : 0;
+}
+
+/* tabledata.insertAll, BQ_INSERT_ROWS rows per request, with BulkLoad=1
+ * only. Streamed rows land in the table's streaming buffer: queries see them
+ * at once, but UPDATE, DELETE and MERGE cannot touch them for up to about 30
+ * minutes, so bulk inserts stay DML unless the application asks. */
+static int bq_bulk_insert(argus_backend_conn_t raw, const char *table,
+                          const argus_column_desc_t *columns, int ncols,
+                          const argus_bulk_rows_t *rows, bool *row_ok,
+                          size_t *added)
+{
+    bq_conn_t *conn = (bq_conn_t *)raw;
+    if (!conn || !table) return -1;
+    if (!conn->bulk_load) return 1;
+
+    /* insertAll takes rows by column name */
+    for (int c = 0; c < ncols; c++)
+        if (!columns[c].name[0]) return 1;
+    if (!rows || rows->nrows == 0) return 0;
+    size_t nrows = rows->nrows;
+    conn->last_error[0] = '\0';
+
+    char *project = NULL, *dataset = NULL, *name = NULL;
+    if (!bq_split_table(conn, table, &project, &dataset, &name)) {
+        snprintf(conn->last_error, sizeof(conn->last_error),
+                 "[Argus][BigQuery] Cannot tell the dataset of %s: qualify "
+                 "the table or set Database", table);
+        return -1;
+    }
+    char *ep = g_uri_escape_string(project, NULL, FALSE);
+    char *ed = g_uri_escape_string(dataset, NULL, FALSE);
+    char *et = g_uri_escape_string(name, NULL, FALSE);
+    char *url = g_strdup_printf("%s/bigquery/v2/projects/%s/datasets/%s/"
+                                "tables/%s/insertAll",
+                                conn->base_url, ep, ed, et);
+    g_free(ep); g_free(ed); g_free(et);
+    g_free(project); g_free(dataset); g_free(name);
+
+    int rc = 0;
+    for (size_t r = 0; r < nrows; r++) row_ok[r] = false;
+    for (size_t start = 0; start < nrows; start += BQ_INSERT_ROWS) {
+        size_t n = nrows - start;
+        if (n > BQ_INSERT_ROWS) n = BQ_INSERT_ROWS;
+        bool *ok = row_ok + start;
+        if (bq_insert_chunk(conn, url, columns, ncols, rows, start, n,
+                            ok) != 0) {
+            rc = -1;
+            /* A failed request inserted nothing; stop there */
+            bool any = false;
+            for (size_t i = 0; i < n; i++) any |= ok[i];
+            if (!any) break;
+        }
+        if (argus_cancel_requested(argus_cancel_current())) {
+            rc = -1;
+            break;
+        }
+    }
+    g_free(url);
+    /* insertErrors names every row it rejects */
+    *added = 0;
+    for (size_t r = 0; r < nrows; r++) *added += row_ok[r];
+    return rc;
+}
+
 /* ── Backend vtable ──────────────────────────────────────────── */
 
 static const argus_backend_t bigquery_backend = {
@@ -1039,6 +1356,9 @@ static const argus_backend_t bigquery_backend = {
     .get_primary_keys      = NULL,   /* BigQuery has no primary keys */
     .get_statistics        = NULL,
     .get_last_error        = bq_get_last_error,
+    .submit                = bq_submit,
+    .poll                  = bq_poll,
+    .bulk_insert           = bq_bulk_insert,
 };
 
 const argus_backend_t *argus_bigquery_backend_get(void)
@@ -60,6 +60,8 @@ typedef struct bq_conn {
     int                connect_timeout_sec;
     int                query_timeout_sec;
     int                fetch_buffer_size;
+    bool               bulk_load;      /* BulkLoad=1: bulk inserts stream
+                                        * through tabledata.insertAll */
 
     char               last_error[1024];
 } bq_conn_t;
@@ -73,6 +75,10 @@ typedef struct bq_op {
     char                *job_id;      /* for getQueryResults pagination */
     char                *location;
     char                *page_token;  /* next page, NULL when done */
+
+    bool                 complete;    /* the job has finished */
+    time_t               started;     /* when the query was posted */
+    int                  poll_ms;     /* wait before the next bq_poll */
 } bq_op_t;
 
 typedef struct bq_response {
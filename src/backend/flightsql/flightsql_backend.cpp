@@ -2,17 +2,20 @@
 #include "flightsql_convert.h"
 
 #include <arrow/ipc/dictionary.h>
+#include <arrow/util/cancel.h>
 
 /* The argus C headers have no extern "C" guards; wrap them so the C functions
  * they declare (e.g. argus_log_write) keep C linkage, as the Kudu backend does. */
 extern "C" {
 #include "argus/backend.h"
+#include "argus/cancel.h"
 #include "argus/handle.h"
 #include "argus/log.h"
 }
 
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -116,6 +119,56 @@ static bool flightsql_is_alive(argus_backend_conn_t raw_conn)
     return conn && conn->client != nullptr;
 }
 
+/* ── Cancellation ────────────────────────────────────────────── */
+
+/*
+ * The blocking Flight calls of one backend entry point, made interruptible.
+ * SQLCancel (argus/cancel.h) trips the stop token the calls carry and
+ * cancels the stream being read, which gRPC turns into a CANCELLED status
+ * and, server-side, a cancelled call. With `deadline`, the statement's query
+ * timeout is also the gRPC deadline; a DoGet stream outlives one fetch, so
+ * it must not get one.
+ */
+struct flightsql_call {
+    flight::FlightCallOptions   options;
+    arrow::StopSource           stop;
+    std::mutex                  lock;
+    flight::FlightStreamReader* reader = nullptr;   /* stream being read */
+    argus_cancel_t*             cancel;
+    bool                        registered;
+
+    flightsql_call(const flight::FlightCallOptions& base, bool deadline)
+        : options(base), cancel(argus_cancel_current())
+    {
+        options.stop_token = stop.token();
+        long left = argus_cancel_remaining_ms(cancel);
+        if (deadline && left >= 0)
+            options.timeout = flight::TimeoutDuration(
+                static_cast<double>(left > 0 ? left : 1) / 1000.0);
+        registered = argus_cancel_push(cancel, &flightsql_call::abort, this);
+        if (!registered) stop.RequestStop();   /* cancelled already */
+    }
+
+    ~flightsql_call()
+    {
+        if (registered) argus_cancel_pop(cancel);
+    }
+
+    void read_from(flight::FlightStreamReader* r)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        reader = r;
+    }
+
+    static void abort(void* data)
+    {
+        auto* call = static_cast<flightsql_call*>(data);
+        call->stop.RequestStop(arrow::Status::Cancelled("Query cancelled"));
+        std::lock_guard<std::mutex> guard(call->lock);
+        if (call->reader) call->reader->Cancel();
+    }
+};
+
 /* ── Execution ───────────────────────────────────────────────── */
 
 static int run_to_op(flightsql_conn* conn,
@@ -142,7 +195,8 @@ static int flightsql_execute(argus_backend_conn_t raw_conn,
 {
     auto* conn = static_cast<flightsql_conn*>(raw_conn);
     if (!conn || !conn->client || !query || !out_op) return -1;
-    return run_to_op(conn, conn->client->Execute(conn->call_options, query),
+    flightsql_call call(conn->call_options, true);
+    return run_to_op(conn, conn->client->Execute(call.options, query),
                      out_op);
 }
 
@@ -166,10 +220,13 @@ static void flightsql_close_operation(argus_backend_conn_t conn,
     delete op;
 }
 
-static int flightsql_cancel(argus_backend_conn_t conn, argus_backend_op_t op)
+/* A statement still running is stopped through flightsql_call; this stops
+ * the result stream of one that has finished executing */
+static int flightsql_cancel(argus_backend_conn_t conn, argus_backend_op_t raw_op)
 {
     (void)conn;
-    (void)op;
+    auto* op = static_cast<flightsql_op*>(raw_op);
+    if (op && op->reader) op->reader->Cancel();
     return 0;
 }
 
@@ -208,6 +265,9 @@ static int flightsql_fetch_results(argus_backend_conn_t raw_conn,
      * size is given, return after the first non-empty batch. */
     const size_t target = (max_rows > 0) ? static_cast<size_t>(max_rows) : 1;
 
+    flightsql_call call(conn->call_options, false);
+    call.read_from(op->reader.get());
+
     while (true) {
         /* Open the next endpoint's stream on demand. */
         if (!op->reader) {
@@ -218,13 +278,14 @@ static int flightsql_fetch_results(argus_backend_conn_t raw_conn,
                 return 0;
             }
             auto reader_res = conn->client->DoGet(
-                conn->call_options, endpoints[op->endpoint_idx].ticket);
+                call.options, endpoints[op->endpoint_idx].ticket);
             if (!reader_res.ok()) {
                 ARGUS_LOG_ERROR("Flight SQL: DoGet failed: %s",
                                 reader_res.status().ToString().c_str());
                 return -1;
             }
             op->reader = std::move(reader_res).ValueOrDie();
+            call.read_from(op->reader.get());
 
             /* Capture column metadata from the first stream's schema. */
             if (!op->metadata_fetched) {
@@ -259,6 +320,7 @@ static int flightsql_fetch_results(argus_backend_conn_t raw_conn,
         flight::FlightStreamChunk chunk = std::move(chunk_res).ValueOrDie();
         if (!chunk.data) {
             /* End of this endpoint's stream; advance to the next one. */
+            call.read_from(nullptr);
             op->reader.reset();
             op->endpoint_idx++;
             continue;
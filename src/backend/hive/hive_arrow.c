@@ -0,0 +1,918 @@
+/*
+ * hive_arrow.c - Minimal Arrow IPC reader for Spark / Databricks result sets.
+ *
+ * See hive_arrow.h. Covers the encapsulated IPC message framing (optional
+ * 0xFFFFFFFF continuation marker, int32 metadata length, flatbuffer Message,
+ * body) and the flat Arrow types a SQL result set uses. Nested columns are
+ * walked only to keep the node/buffer cursors aligned; a Spark server sends
+ * them as JSON strings unless the client asks for native complex types.
+ *
+ * All reads are bounds-checked against the message: a truncated or hostile
+ * payload fails the fetch with a diagnostic instead of reading past the end.
+ */
+
+#include "hive_arrow.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Message header union tags (Message.fbs) */
+#define ARROW_MSG_SCHEMA        1
+#define ARROW_MSG_DICTIONARY    2
+#define ARROW_MSG_RECORD_BATCH  3
+
+/* TimeUnit / DateUnit / Precision enums (Schema.fbs) */
+#define ARROW_DATE_DAY          0
+#define ARROW_UNIT_SECOND       0
+#define ARROW_UNIT_MILLI        1
+#define ARROW_UNIT_MICRO        2
+#define ARROW_UNIT_NANO         3
+#define ARROW_PRECISION_HALF    0
+#define ARROW_PRECISION_SINGLE  1
+
+/* Nesting bound for the schema walk: result columns are flat or shallow. */
+#define ARROW_MAX_DEPTH         32
+
+static void set_err(char *err, size_t errlen, const char *msg)
+{
+    if (err && errlen > 0) {
+        strncpy(err, msg, errlen - 1);
+        err[errlen - 1] = '\0';
+    }
+}
+
+/* ── Little-endian loads (unaligned-safe) ─────────────────────── */
+
+static uint16_t rd_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t rd_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t rd_u64(const uint8_t *p)
+{
+    return (uint64_t)rd_u32(p) | ((uint64_t)rd_u32(p + 4) << 32);
+}
+
+/* ── Flatbuffer access ─────────────────────────────────────────
+ * Positions are byte offsets into one metadata buffer; 0 means "absent"
+ * (no table or field can live at offset 0, the root offset is there). */
+
+typedef struct fb_buf {
+    const uint8_t *p;
+    size_t         n;
+} fb_buf_t;
+
+/* Follow the uoffset stored at `pos`. */
+static size_t fb_deref(const fb_buf_t *b, size_t pos)
+{
+    if (pos + 4 > b->n) return 0;
+    size_t target = pos + rd_u32(b->p + pos);
+    return (target < b->n) ? target : 0;
+}
+
+/* Absolute position of field `slot` in the table at `tab`, or 0. */
+static size_t fb_field(const fb_buf_t *b, size_t tab, int slot)
+{
+    if (tab == 0 || tab + 4 > b->n) return 0;
+    int32_t soff = (int32_t)rd_u32(b->p + tab);
+    long long vt = (long long)tab - soff;
+    if (vt < 0 || (size_t)vt + 4 > b->n) return 0;
+    size_t vsize = rd_u16(b->p + vt);
+    size_t entry = 4 + (size_t)slot * 2;
+    if (entry + 2 > vsize || (size_t)vt + entry + 2 > b->n) return 0;
+    size_t off = rd_u16(b->p + vt + entry);
+    return off ? tab + off : 0;
+}
+
+static int64_t fb_i64(const fb_buf_t *b, size_t tab, int slot, int64_t def)
+{
+    size_t pos = fb_field(b, tab, slot);
+    return (pos && pos + 8 <= b->n) ? (int64_t)rd_u64(b->p + pos) : def;
+}
+
+static int32_t fb_i32(const fb_buf_t *b, size_t tab, int slot, int32_t def)
+{
+    size_t pos = fb_field(b, tab, slot);
+    return (pos && pos + 4 <= b->n) ? (int32_t)rd_u32(b->p + pos) : def;
+}
+
+static int fb_i16(const fb_buf_t *b, size_t tab, int slot, int def)
+{
+    size_t pos = fb_field(b, tab, slot);
+    return (pos && pos + 2 <= b->n) ? (int16_t)rd_u16(b->p + pos) : def;
+}
+
+static int fb_u8(const fb_buf_t *b, size_t tab, int slot, int def)
+{
+    size_t pos = fb_field(b, tab, slot);
+    return (pos && pos < b->n) ? b->p[pos] : def;
+}
+
+/* Table or vector referenced by field `slot`, or 0. */
+static size_t fb_ref(const fb_buf_t *b, size_t tab, int slot)
+{
+    size_t pos = fb_field(b, tab, slot);
+    return pos ? fb_deref(b, pos) : 0;
+}
+
+/* Length of the vector at `vec`, checked against `elem_size`-byte elements. */
+static bool fb_vec(const fb_buf_t *b, size_t vec, size_t elem_size,
+                   uint32_t *count)
+{
+    if (vec == 0 || vec + 4 > b->n) return false;
+    uint32_t len = rd_u32(b->p + vec);
+    if ((uint64_t)len * elem_size > b->n - vec - 4) return false;
+    *count = len;
+    return true;
+}
+
+/* ── IPC message framing ──────────────────────────────────────── */
+
+typedef struct arrow_msg {
+    fb_buf_t       meta;
+    size_t         header;      /* header table position in meta */
+    int            header_type;
+    const uint8_t *body;
+    size_t         body_len;
+} arrow_msg_t;
+
+/* Read the message at *pos. Returns 1 with `msg` filled, 0 at end of stream,
+ * -1 on malformed framing. */
+static int next_message(const uint8_t *data, size_t len, size_t *pos,
+                        arrow_msg_t *msg, char *err, size_t errlen)
+{
+    size_t p = *pos;
+    if (p + 4 > len) return 0;
+
+    uint32_t meta_len = rd_u32(data + p);
+    p += 4;
+    if (meta_len == 0xFFFFFFFFu) {          /* continuation marker */
+        if (p + 4 > len) return 0;
+        meta_len = rd_u32(data + p);
+        p += 4;
+    }
+    if (meta_len == 0) return 0;            /* end-of-stream marker */
+    if (meta_len > len - p) {
+        set_err(err, errlen, "truncated Arrow IPC message metadata");
+        return -1;
+    }
+
+    msg->meta.p = data + p;
+    msg->meta.n = meta_len;
+    p += meta_len;
+
+    size_t root = fb_deref(&msg->meta, 0);
+    if (!root) {
+        set_err(err, errlen, "malformed Arrow IPC message");
+        return -1;
+    }
+    msg->header_type = fb_u8(&msg->meta, root, 1, 0);
+    msg->header = fb_ref(&msg->meta, root, 2);
+    int64_t body_len = fb_i64(&msg->meta, root, 3, 0);
+    if (body_len < 0 || (uint64_t)body_len > len - p) {
+        set_err(err, errlen, "truncated Arrow IPC message body");
+        return -1;
+    }
+    msg->body = data + p;
+    msg->body_len = (size_t)body_len;
+    p += (size_t)body_len;
+
+    *pos = p;
+    return 1;
+}
+
+/* ── Schema ───────────────────────────────────────────────────── */
+
+/* Count the FieldNodes and buffers a field occupies in a RecordBatch,
+ * recursing through children. Returns -1 for layouts the reader cannot
+ * step over. */
+static int field_layout(const fb_buf_t *b, size_t field, int depth,
+                        int *nodes, int *buffers)
+{
+    if (depth > ARROW_MAX_DEPTH) return -1;
+
+    int type = fb_u8(b, field, 2, 0);
+    size_t type_tab = fb_ref(b, field, 3);
+
+    *nodes += 1;
+    switch (type) {
+    case HIVE_ARROW_NULL:
+        break;
+    case HIVE_ARROW_INT:
+    case HIVE_ARROW_FLOATING_POINT:
+    case HIVE_ARROW_BOOL:
+    case HIVE_ARROW_DECIMAL:
+    case HIVE_ARROW_DATE:
+    case HIVE_ARROW_TIME:
+    case HIVE_ARROW_TIMESTAMP:
+    case HIVE_ARROW_INTERVAL:
+    case HIVE_ARROW_FIXED_SIZE_BINARY:
+    case HIVE_ARROW_DURATION:
+        *buffers += 2;                  /* validity, values */
+        break;
+    case HIVE_ARROW_BINARY:
+    case HIVE_ARROW_UTF8:
+    case HIVE_ARROW_LARGE_BINARY:
+    case HIVE_ARROW_LARGE_UTF8:
+        *buffers += 3;                  /* validity, offsets, data */
+        break;
+    case HIVE_ARROW_LIST:
+    case HIVE_ARROW_LARGE_LIST:
+    case HIVE_ARROW_MAP:
+        *buffers += 2;                  /* validity, offsets */
+        break;
+    case HIVE_ARROW_STRUCT:
+    case HIVE_ARROW_FIXED_SIZE_LIST:
+        *buffers += 1;                  /* validity */
+        break;
+    case HIVE_ARROW_UNION:
+        /* type ids, plus offsets for a dense union; no validity bitmap */
+        *buffers += (fb_i16(b, type_tab, 0, 0) == 1) ? 2 : 1;
+        break;
+    default:
+        return -1;                      /* views, run-end encoded, ... */
+    }
+
+    size_t children = fb_ref(b, field, 5);
+    uint32_t nchild = 0;
+    if (children && fb_vec(b, children, 4, &nchild)) {
+        for (uint32_t i = 0; i < nchild; i++) {
+            size_t child = fb_deref(b, children + 4 + (size_t)i * 4);
+            if (!child) return -1;
+            if (field_layout(b, child, depth + 1, nodes, buffers) != 0)
+                return -1;
+        }
+    }
+    return 0;
+}
+
+static int parse_schema_table(const fb_buf_t *b, size_t schema,
+                              hive_arrow_schema_t *out,
+                              char *err, size_t errlen)
+{
+    if (fb_i16(b, schema, 0, 0) != 0) {
+        set_err(err, errlen, "big-endian Arrow data is not supported");
+        return -1;
+    }
+
+    size_t fields = fb_ref(b, schema, 1);
+    uint32_t nfields = 0;
+    if (!fields || !fb_vec(b, fields, 4, &nfields) || nfields == 0) {
+        set_err(err, errlen, "Arrow schema has no fields");
+        return -1;
+    }
+    if (nfields > ARGUS_MAX_COLUMNS) nfields = ARGUS_MAX_COLUMNS;
+
+    hive_arrow_field_t *out_fields = calloc(nfields, sizeof(*out_fields));
+    if (!out_fields) {
+        set_err(err, errlen, "out of memory");
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < nfields; i++) {
+        hive_arrow_field_t *f = &out_fields[i];
+        size_t field = fb_deref(b, fields + 4 + (size_t)i * 4);
+        if (!field || field_layout(b, field, 0, &f->num_nodes,
+                                   &f->num_buffers) != 0) {
+            free(out_fields);
+            set_err(err, errlen, "unsupported Arrow column layout");
+            return -1;
+        }
+
+        size_t type = fb_ref(b, field, 3);
+        f->type = fb_u8(b, field, 2, 0);
+        f->dictionary = fb_ref(b, field, 4) != 0;
+
+        switch (f->type) {
+        case HIVE_ARROW_INT:
+            f->bit_width = fb_i32(b, type, 0, 0);
+            f->is_signed = fb_u8(b, type, 1, 0) != 0;
+            break;
+        case HIVE_ARROW_FLOATING_POINT:
+            f->unit = fb_i16(b, type, 0, ARROW_PRECISION_HALF);
+            break;
+        case HIVE_ARROW_DECIMAL:
+            f->scale = fb_i32(b, type, 1, 0);
+            f->bit_width = fb_i32(b, type, 2, 128);
+            break;
+        case HIVE_ARROW_DATE:
+            f->unit = fb_i16(b, type, 0, ARROW_UNIT_MILLI);
+            break;
+        case HIVE_ARROW_TIME:
+            f->unit = fb_i16(b, type, 0, ARROW_UNIT_MILLI);
+            f->bit_width = fb_i32(b, type, 1, 32);
+            break;
+        case HIVE_ARROW_TIMESTAMP:
+            f->unit = fb_i16(b, type, 0, ARROW_UNIT_SECOND);
+            break;
+        case HIVE_ARROW_FIXED_SIZE_BINARY:
+            f->byte_width = fb_i32(b, type, 0, 0);
+            break;
+        default:
+            break;
+        }
+    }
+
+    out->fields = out_fields;
+    out->num_fields = (int)nfields;
+    return 0;
+}
+
+int hive_arrow_parse_schema(const uint8_t *data, size_t len,
+                            hive_arrow_schema_t *out,
+                            char *err, size_t errlen)
+{
+    if (!data || !out) return -1;
+    memset(out, 0, sizeof(*out));
+
+    size_t pos = 0;
+    arrow_msg_t msg;
+    int rc;
+    while ((rc = next_message(data, len, &pos, &msg, err, errlen)) == 1) {
+        if (msg.header_type == ARROW_MSG_SCHEMA && msg.header)
+            return parse_schema_table(&msg.meta, msg.header, out, err, errlen);
+    }
+    if (rc == 0)
+        set_err(err, errlen, "no Arrow schema message found");
+    return -1;
+}
+
+void hive_arrow_schema_free(hive_arrow_schema_t *schema)
+{
+    if (!schema) return;
+    free(schema->fields);
+    schema->fields = NULL;
+    schema->num_fields = 0;
+}
+
+/* ── Value formatting ─────────────────────────────────────────── */
+
+static int set_text(argus_cell_t *cell, const char *s, size_t n)
+{
+    cell->data = malloc(n + 1);
+    if (!cell->data) return -1;
+    if (n) memcpy(cell->data, s, n);
+    cell->data[n] = '\0';
+    cell->data_len = n;
+    return 0;
+}
+
+/* Lowercase hex, the same encoding the TColumn binaryVal path produces. */
+static int set_hex(argus_cell_t *cell, const uint8_t *p, size_t n)
+{
+    static const char digits[] = "0123456789abcdef";
+    cell->data = malloc(n * 2 + 1);
+    if (!cell->data) return -1;
+    for (size_t i = 0; i < n; i++) {
+        cell->data[i * 2]     = digits[p[i] >> 4];
+        cell->data[i * 2 + 1] = digits[p[i] & 0x0F];
+    }
+    cell->data[n * 2] = '\0';
+    cell->data_len = n * 2;
+    return 0;
+}
+
+static int64_t floor_div(int64_t a, int64_t b)
+{
+    int64_t q = a / b;
+    return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+/* Days since 1970-01-01 → proleptic Gregorian date (H. Hinnant's algorithm). */
+static void civil_from_days(int64_t z, long long *y, unsigned *m, unsigned *d)
+{
+    z += 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned doe = (unsigned)(z - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    *d = doy - (153 * mp + 2) / 5 + 1;
+    *m = mp < 10 ? mp + 3 : mp - 9;
+    *y = (long long)yoe + era * 400 + (*m <= 2);
+}
+
+static int64_t unit_per_second(int unit)
+{
+    switch (unit) {
+    case ARROW_UNIT_MILLI: return 1000;
+    case ARROW_UNIT_MICRO: return 1000000;
+    case ARROW_UNIT_NANO:  return 1000000000;
+    default:               return 1;
+    }
+}
+
+/* Append ".fff" for a non-zero sub-second part, trailing zeros trimmed. */
+static int format_fraction(char *buf, size_t cap, int64_t frac, int unit)
+{
+    if (frac == 0 || unit == ARROW_UNIT_SECOND) return 0;
+    int width = unit == ARROW_UNIT_MILLI ? 3 : unit == ARROW_UNIT_MICRO ? 6 : 9;
+    char tmp[16];
+    snprintf(tmp, sizeof(tmp), "%0*lld", width, (long long)frac);
+    int n = width;
+    while (n > 1 && tmp[n - 1] == '0') n--;
+    tmp[n] = '\0';
+    return snprintf(buf, cap, ".%s", tmp);
+}
+
+static int format_date(char *buf, size_t cap, int64_t days)
+{
+    long long y;
+    unsigned m, d;
+    civil_from_days(days, &y, &m, &d);
+    return snprintf(buf, cap, "%04lld-%02u-%02u", y, m, d);
+}
+
+static int format_time_of_day(char *buf, size_t cap, int64_t v, int unit)
+{
+    int64_t per_sec = unit_per_second(unit);
+    int64_t secs = floor_div(v, per_sec);
+    int64_t frac = v - secs * per_sec;
+    int64_t sod = secs % 86400;
+    if (sod < 0) sod += 86400;
+    int n = snprintf(buf, cap, "%02d:%02d:%02d", (int)(sod / 3600),
+                     (int)(sod / 60 % 60), (int)(sod % 60));
+    if (n > 0 && (size_t)n < cap)
+        n += format_fraction(buf + n, cap - (size_t)n, frac, unit);
+    return n;
+}
+
+static int format_timestamp(char *buf, size_t cap, int64_t v, int unit)
+{
+    int64_t per_sec = unit_per_second(unit);
+    int64_t secs = floor_div(v, per_sec);
+    int64_t days = floor_div(secs, 86400);
+    int n = format_date(buf, cap, days);
+    if (n > 0 && (size_t)n + 1 < cap) {
+        buf[n++] = ' ';
+        /* Re-scale to the original unit so the fraction survives. */
+        int64_t in_day = v - days * 86400 * per_sec;
+        n += format_time_of_day(buf + n, cap - (size_t)n, in_day, unit);
+    }
+    return n;
+}
+
+/* Two's-complement little-endian decimal of `nbytes` bytes → text with
+ * `scale` fractional digits. Long division by 10 over 32-bit limbs keeps it
+ * portable (no __int128). */
+static int format_decimal(char *buf, size_t cap, const uint8_t *p,
+                          int nbytes, int scale)
+{
+    uint32_t limbs[8];
+    int nlimbs = nbytes / 4;
+    for (int i = 0; i < nlimbs; i++) limbs[i] = rd_u32(p + i * 4);
+
+    bool neg = (p[nbytes - 1] & 0x80) != 0;
+    if (neg) {
+        uint64_t carry = 1;
+        for (int i = 0; i < nlimbs; i++) {
+            uint64_t v = (uint64_t)(uint32_t)~limbs[i] + carry;
+            limbs[i] = (uint32_t)v;
+            carry = v >> 32;
+        }
+    }
+
+    char digits[96];
+    int nd = 0;
+    for (;;) {
+        bool zero = true;
+        uint64_t rem = 0;
+        for (int i = nlimbs - 1; i >= 0; i--) {
+            uint64_t cur = (rem << 32) | limbs[i];
+            limbs[i] = (uint32_t)(cur / 10);
+            rem = cur % 10;
+            if (limbs[i]) zero = false;
+        }
+        digits[nd++] = (char)('0' + rem);
+        if (zero || nd >= (int)sizeof(digits)) break;
+    }
+    while (nd <= scale && nd < (int)sizeof(digits)) digits[nd++] = '0';
+
+    size_t n = 0;
+    if (neg && n < cap) buf[n++] = '-';
+    for (int i = nd - 1; i >= 0 && n + 1 < cap; i--) {
+        buf[n++] = digits[i];
+        if (i == scale && scale > 0 && n + 1 < cap) buf[n++] = '.';
+    }
+    buf[n] = '\0';
+    return (int)n;
+}
+
+/* IEEE 754 binary16 → double. */
+static double half_to_double(uint16_t h)
+{
+    int exp = (h >> 10) & 0x1F;
+    double mant = h & 0x3FF;
+    double v;
+    if (exp == 0)       v = ldexp(mant, -24);
+    else if (exp == 31) v = mant ? NAN : INFINITY;
+    else                v = ldexp(mant + 1024.0, exp - 25);
+    return (h & 0x8000) ? -v : v;
+}
+
+/* ── RecordBatch decoding ─────────────────────────────────────── */
+
+typedef struct arrow_buffer {
+    const uint8_t *p;
+    size_t         len;
+} arrow_buffer_t;
+
+static bool is_valid(const arrow_buffer_t *validity, int64_t null_count,
+                     int64_t row)
+{
+    if (null_count == 0 || validity->len == 0) return true;
+    size_t byte = (size_t)(row >> 3);
+    if (byte >= validity->len) return true;
+    return (validity->p[byte] >> (row & 7)) & 1;
+}
+
+/* Bytes per value for fixed-width types, 0 for variable-width ones. */
+static size_t value_width(const hive_arrow_field_t *f)
+{
+    switch (f->type) {
+    case HIVE_ARROW_INT:
+    case HIVE_ARROW_TIME:
+    case HIVE_ARROW_DECIMAL:
+        return (size_t)(f->bit_width > 0 ? f->bit_width / 8 : 0);
+    case HIVE_ARROW_FLOATING_POINT:
+        return f->unit == ARROW_PRECISION_HALF ? 2
+             : f->unit == ARROW_PRECISION_SINGLE ? 4 : 8;
+    case HIVE_ARROW_DATE:
+        return f->unit == ARROW_DATE_DAY ? 4 : 8;
+    case HIVE_ARROW_TIMESTAMP:
+        return 8;
+    case HIVE_ARROW_FIXED_SIZE_BINARY:
+        return (size_t)(f->byte_width > 0 ? f->byte_width : 0);
+    default:
+        return 0;
+    }
+}
+
+/* Validate one column's type and buffer sizes against the batch length
+ * before any row is allocated. */
+static int check_column(const hive_arrow_field_t *f, int col, int64_t length,
+                        const arrow_buffer_t *bufs, char *err, size_t errlen)
+{
+    char tmp[128];
+    size_t elem = value_width(f);
+
+    if (f->dictionary) {
+        set_err(err, errlen, "dictionary-encoded Arrow columns are not supported");
+        return -1;
+    }
+
+    bool width_ok;
+    switch (f->type) {
+    case HIVE_ARROW_INT:
+        width_ok = elem == 1 || elem == 2 || elem == 4 || elem == 8;
+        break;
+    case HIVE_ARROW_TIME:
+        width_ok = elem == 4 || elem == 8;
+        break;
+    case HIVE_ARROW_DECIMAL:
+        width_ok = elem == 4 || elem == 8 || elem == 16 || elem == 32;
+        break;
+    case HIVE_ARROW_FIXED_SIZE_BINARY:
+        width_ok = elem > 0;
+        break;
+    case HIVE_ARROW_NULL:
+    case HIVE_ARROW_BOOL:
+    case HIVE_ARROW_FLOATING_POINT:
+    case HIVE_ARROW_DATE:
+    case HIVE_ARROW_TIMESTAMP:
+    case HIVE_ARROW_BINARY:
+    case HIVE_ARROW_UTF8:
+    case HIVE_ARROW_LARGE_BINARY:
+    case HIVE_ARROW_LARGE_UTF8:
+        width_ok = true;
+        break;
+    default:
+        snprintf(tmp, sizeof(tmp),
+                 "Arrow column %d has an unsupported type (%d)", col + 1, f->type);
+        set_err(err, errlen, tmp);
+        return -1;
+    }
+    if (!width_ok) {
+        snprintf(tmp, sizeof(tmp),
+                 "Arrow column %d has an unsupported bit width", col + 1);
+        set_err(err, errlen, tmp);
+        return -1;
+    }
+
+    /* Value buffers must hold `length` elements. */
+    if (elem && bufs[1].len / elem < (uint64_t)length) {
+        set_err(err, errlen, "Arrow value buffer shorter than the batch");
+        return -1;
+    }
+    if (f->type == HIVE_ARROW_BOOL && bufs[1].len * 8 < (uint64_t)length) {
+        set_err(err, errlen, "Arrow value buffer shorter than the batch");
+        return -1;
+    }
+    if (f->type == HIVE_ARROW_BINARY || f->type == HIVE_ARROW_UTF8 ||
+        f->type == HIVE_ARROW_LARGE_BINARY || f->type == HIVE_ARROW_LARGE_UTF8) {
+        size_t osize = (f->type == HIVE_ARROW_LARGE_BINARY ||
+                        f->type == HIVE_ARROW_LARGE_UTF8) ? 8 : 4;
+        if (bufs[1].len / osize < (uint64_t)length + 1) {
+            set_err(err, errlen, "Arrow offsets buffer shorter than the batch");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Decode one top-level column into rows [base, base + length) of `cache`.
+ * check_column() has already validated the buffers. */
+static int decode_column(const hive_arrow_field_t *f, int col,
+                         int64_t length, int64_t null_count,
+                         const arrow_buffer_t *bufs,
+                         argus_row_cache_t *cache, size_t base,
+                         char *err, size_t errlen)
+{
+    const arrow_buffer_t *validity = &bufs[0];
+    size_t elem = value_width(f);
+    bool large = f->type == HIVE_ARROW_LARGE_BINARY ||
+                 f->type == HIVE_ARROW_LARGE_UTF8;
+    char tmp[128];
+
+    for (int64_t r = 0; r < length; r++) {
+        argus_cell_t *cell = &cache->rows[base + (size_t)r].cells[col];
+
+        if (f->type == HIVE_ARROW_NULL || !is_valid(validity, null_count, r)) {
+            cell->is_null = true;
+            continue;
+        }
+        cell->is_null = false;
+
+        const uint8_t *v = elem ? bufs[1].p + (size_t)r * elem : NULL;
+        int n = 0;
+
+        switch (f->type) {
+        case HIVE_ARROW_INT: {
+            int64_t iv;
+            switch (f->bit_width) {
+            case 8:  iv = f->is_signed ? (int8_t)v[0] : v[0]; break;
+            case 16: iv = f->is_signed ? (int16_t)rd_u16(v) : rd_u16(v); break;
+            case 32: iv = f->is_signed ? (int32_t)rd_u32(v)
+                                       : (int64_t)rd_u32(v); break;
+            default: {
+                uint64_t u = rd_u64(v);
+                if (!f->is_signed && u > (uint64_t)INT64_MAX) {
+                    n = snprintf(tmp, sizeof(tmp), "%llu", (unsigned long long)u);
+                    if (set_text(cell, tmp, (size_t)n) != 0) goto oom;
+                    continue;
+                }
+                iv = (int64_t)u;
+                break;
+            }
+            }
+            /* Native typed value: no text round-trip on SQLGetData. */
+            cell->native_kind = ARGUS_NATIVE_I64;
+            cell->native.i64 = iv;
+            continue;
+        }
+        case HIVE_ARROW_FLOATING_POINT: {
+            if (f->unit == ARROW_PRECISION_HALF || f->unit == ARROW_PRECISION_SINGLE) {
+                double dv;
+                if (f->unit == ARROW_PRECISION_HALF) {
+                    dv = half_to_double(rd_u16(v));
+                } else {
+                    uint32_t bits = rd_u32(v);
+                    float fv;
+                    memcpy(&fv, &bits, sizeof(fv));
+                    dv = fv;
+                }
+                /* Keep the short text form too: formatting a widened float at
+                 * double precision would print 0.1f as 0.10000000149011612. */
+                n = snprintf(tmp, sizeof(tmp), "%.7g", dv);
+                if (set_text(cell, tmp, (size_t)n) != 0) goto oom;
+                cell->native_kind = ARGUS_NATIVE_F64;
+                cell->native.f64 = dv;
+                continue;
+            }
+            uint64_t bits = rd_u64(v);
+            double dv;
+            memcpy(&dv, &bits, sizeof(dv));
+            cell->native_kind = ARGUS_NATIVE_F64;
+            cell->native.f64 = dv;
+            continue;
+        }
+        case HIVE_ARROW_BOOL: {
+            bool bv = (bufs[1].p[r >> 3] >> (r & 7)) & 1;
+            if (set_text(cell, bv ? "true" : "false", bv ? 4 : 5) != 0) goto oom;
+            continue;
+        }
+        case HIVE_ARROW_DECIMAL:
+            n = format_decimal(tmp, sizeof(tmp), v, (int)elem, f->scale);
+            break;
+        case HIVE_ARROW_DATE: {
+            int64_t days = f->unit == ARROW_DATE_DAY
+                ? (int32_t)rd_u32(v) : floor_div((int64_t)rd_u64(v), 86400000);
+            n = format_date(tmp, sizeof(tmp), days);
+            break;
+        }
+        case HIVE_ARROW_TIME: {
+            int64_t tv = elem == 4 ? (int32_t)rd_u32(v) : (int64_t)rd_u64(v);
+            n = format_time_of_day(tmp, sizeof(tmp), tv, f->unit);
+            break;
+        }
+        case HIVE_ARROW_TIMESTAMP:
+            n = format_timestamp(tmp, sizeof(tmp), (int64_t)rd_u64(v), f->unit);
+            break;
+        case HIVE_ARROW_FIXED_SIZE_BINARY:
+            if (set_hex(cell, v, elem) != 0) goto oom;
+            continue;
+        default: {
+            /* Utf8 / Binary and their 64-bit-offset variants */
+            uint64_t start, end;
+            if (large) {
+                start = rd_u64(bufs[1].p + (size_t)r * 8);
+                end   = rd_u64(bufs[1].p + (size_t)(r + 1) * 8);
+            } else {
+                start = rd_u32(bufs[1].p + (size_t)r * 4);
+                end   = rd_u32(bufs[1].p + (size_t)(r + 1) * 4);
+            }
+            if (end < start || end > bufs[2].len) {
+                set_err(err, errlen, "Arrow string offsets out of range");
+                return -1;
+            }
+            const uint8_t *s = bufs[2].p + start;
+            size_t slen = (size_t)(end - start);
+            int rc = (f->type == HIVE_ARROW_UTF8 || f->type == HIVE_ARROW_LARGE_UTF8)
+                     ? set_text(cell, (const char *)s, slen)
+                     : set_hex(cell, s, slen);
+            if (rc != 0) goto oom;
+            continue;
+        }
+        }
+
+        if (n < 0) n = 0;
+        if ((size_t)n >= sizeof(tmp)) n = (int)sizeof(tmp) - 1;
+        if (set_text(cell, tmp, (size_t)n) != 0) goto oom;
+    }
+    return 0;
+
+oom:
+    set_err(err, errlen, "out of memory");
+    return -1;
+}
+
+/* Grow `cache` by `nrows` rows of `ncols` zeroed cells. */
+static int append_rows(argus_row_cache_t *cache, size_t nrows, int ncols)
+{
+    if (nrows > SIZE_MAX / sizeof(argus_row_t) - cache->num_rows) return -1;
+    size_t needed = cache->num_rows + nrows;
+    if (needed > cache->capacity) {
+        size_t cap = cache->capacity ? cache->capacity : 16;
+        while (cap < needed) cap = (cap > SIZE_MAX / 2) ? needed : cap * 2;
+        argus_row_t *grown = realloc(cache->rows, cap * sizeof(argus_row_t));
+        if (!grown) return -1;
+        cache->rows = grown;
+        cache->capacity = cap;
+    }
+    cache->num_cols = ncols;
+    for (size_t i = 0; i < nrows; i++) {
+        argus_row_t *row = &cache->rows[cache->num_rows];
+        row->cells = calloc((size_t)ncols, sizeof(argus_cell_t));
+        if (!row->cells) return -1;
+        cache->num_rows++;
+    }
+    return 0;
+}
+
+static int decode_record_batch(const hive_arrow_schema_t *schema,
+                               const arrow_msg_t *msg,
+                               argus_row_cache_t *cache,
+                               char *err, size_t errlen)
+{
+    const fb_buf_t *b = &msg->meta;
+    size_t batch = msg->header;
+
+    if (fb_ref(b, batch, 3)) {
+        set_err(err, errlen, "compressed Arrow record batches are not supported");
+        return -1;
+    }
+
+    int64_t length = fb_i64(b, batch, 0, 0);
+    if (length <= 0) return 0;
+
+    size_t nodes = fb_ref(b, batch, 1);
+    size_t buffers = fb_ref(b, batch, 2);
+    uint32_t nnodes = 0, nbuffers = 0;
+    if (!fb_vec(b, nodes, 16, &nnodes) || !fb_vec(b, buffers, 16, &nbuffers)) {
+        set_err(err, errlen, "malformed Arrow record batch");
+        return -1;
+    }
+
+    /* Pass 1: resolve and validate every column's buffers, so a malformed
+     * batch is rejected before any row is allocated. */
+    arrow_buffer_t *bufs = calloc((size_t)schema->num_fields * 3,
+                                  sizeof(arrow_buffer_t));
+    int64_t *null_counts = calloc((size_t)schema->num_fields, sizeof(int64_t));
+    if (!bufs || !null_counts) {
+        free(bufs);
+        free(null_counts);
+        set_err(err, errlen, "out of memory");
+        return -1;
+    }
+
+    int rc = -1;
+    uint32_t node_idx = 0, buf_idx = 0;
+    for (int c = 0; c < schema->num_fields; c++) {
+        const hive_arrow_field_t *f = &schema->fields[c];
+        if (node_idx + (uint32_t)f->num_nodes > nnodes ||
+            buf_idx + (uint32_t)f->num_buffers > nbuffers) {
+            set_err(err, errlen, "Arrow record batch does not match the schema");
+            goto done;
+        }
+
+        const uint8_t *node = b->p + nodes + 4 + (size_t)node_idx * 16;
+        int64_t col_len = (int64_t)rd_u64(node);
+        null_counts[c] = (int64_t)rd_u64(node + 8);
+        if (col_len < length) {
+            set_err(err, errlen, "Arrow column shorter than its record batch");
+            goto done;
+        }
+
+        /* Only the column's own buffers are read (children are skipped). */
+        arrow_buffer_t *cb = &bufs[c * 3];
+        for (int k = 0; k < f->num_buffers && k < 3; k++) {
+            const uint8_t *bd = b->p + buffers + 4 + (size_t)(buf_idx + k) * 16;
+            uint64_t off = rd_u64(bd);
+            uint64_t blen = rd_u64(bd + 8);
+            if (off > msg->body_len || blen > msg->body_len - off) {
+                set_err(err, errlen, "Arrow buffer outside the message body");
+                goto done;
+            }
+            cb[k].p = msg->body + off;
+            cb[k].len = (size_t)blen;
+        }
+        if (check_column(f, c, length, cb, err, errlen) != 0)
+            goto done;
+
+        node_idx += (uint32_t)f->num_nodes;
+        buf_idx += (uint32_t)f->num_buffers;
+    }
+
+    /* Pass 2: materialize the rows. */
+    size_t base = cache->num_rows;
+    if (append_rows(cache, (size_t)length, schema->num_fields) != 0) {
+        set_err(err, errlen, "out of memory");
+        goto done;
+    }
+    for (int c = 0; c < schema->num_fields; c++) {
+        if (decode_column(&schema->fields[c], c, length, null_counts[c],
+                          &bufs[c * 3], cache, base, err, errlen) != 0)
+            goto done;
+    }
+    rc = 0;
+
+done:
+    free(bufs);
+    free(null_counts);
+    return rc;
+}
+
+int hive_arrow_append_stream(hive_arrow_schema_t *schema,
+                             const uint8_t *data, size_t len,
+                             argus_row_cache_t *cache,
+                             char *err, size_t errlen)
+{
+    if (!schema || !data || !cache) return -1;
+
+    size_t pos = 0;
+    arrow_msg_t msg;
+    int rc;
+    while ((rc = next_message(data, len, &pos, &msg, err, errlen)) == 1) {
+        if (!msg.header) continue;
+        switch (msg.header_type) {
+        case ARROW_MSG_SCHEMA:
+            if (schema->num_fields == 0 &&
+                parse_schema_table(&msg.meta, msg.header, schema,
+                                   err, errlen) != 0)
+                return -1;
+            break;
+        case ARROW_MSG_RECORD_BATCH:
+            if (schema->num_fields == 0) {
+                set_err(err, errlen, "Arrow record batch without a schema");
+                return -1;
+            }
+            if (decode_record_batch(schema, &msg, cache, err, errlen) != 0)
+                return -1;
+            break;
+        case ARROW_MSG_DICTIONARY:
+            set_err(err, errlen, "Arrow dictionary batches are not supported");
+            return -1;
+        default:
+            break;
+        }
+    }
+    return rc < 0 ? -1 : 0;
+}
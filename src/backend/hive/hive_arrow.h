@@ -0,0 +1,87 @@
+#ifndef ARGUS_HIVE_ARROW_H
+#define ARGUS_HIVE_ARROW_H
+
+/*
+ * hive_arrow.h - Minimal Arrow IPC reader for Spark / Databricks result sets.
+ *
+ * A Spark Thrift server that accepts canReadArrowResult ships each result
+ * chunk as Arrow IPC record batches (TRowSet.arrowBatches, or presigned
+ * "cloud fetch" links to Arrow IPC streams) instead of TColumn lists. The
+ * driver only needs flat columns, so rather than pull in libarrow this reads
+ * the flatbuffer metadata directly and decodes the value buffers straight into
+ * argus_cell_t — typed natives for integers and doubles, text for the rest,
+ * matching what the TColumn path produces.
+ *
+ * No GLib or Thrift dependency, so it can be unit tested on its own.
+ */
+
+#include "argus/types.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Arrow `Type` union tags (Schema.fbs) the reader knows about. */
+enum {
+    HIVE_ARROW_NULL            = 1,
+    HIVE_ARROW_INT             = 2,
+    HIVE_ARROW_FLOATING_POINT  = 3,
+    HIVE_ARROW_BINARY          = 4,
+    HIVE_ARROW_UTF8            = 5,
+    HIVE_ARROW_BOOL            = 6,
+    HIVE_ARROW_DECIMAL         = 7,
+    HIVE_ARROW_DATE            = 8,
+    HIVE_ARROW_TIME            = 9,
+    HIVE_ARROW_TIMESTAMP       = 10,
+    HIVE_ARROW_INTERVAL        = 11,
+    HIVE_ARROW_LIST            = 12,
+    HIVE_ARROW_STRUCT          = 13,
+    HIVE_ARROW_UNION           = 14,
+    HIVE_ARROW_FIXED_SIZE_BINARY = 15,
+    HIVE_ARROW_FIXED_SIZE_LIST = 16,
+    HIVE_ARROW_MAP             = 17,
+    HIVE_ARROW_DURATION        = 18,
+    HIVE_ARROW_LARGE_BINARY    = 19,
+    HIVE_ARROW_LARGE_UTF8      = 20,
+    HIVE_ARROW_LARGE_LIST      = 21
+};
+
+/* One top-level column of the Arrow schema. */
+typedef struct hive_arrow_field {
+    int     type;           /* HIVE_ARROW_* */
+    int     bit_width;      /* Int / Time / Decimal */
+    bool    is_signed;      /* Int */
+    int     unit;           /* FloatingPoint precision, Date/Time/Timestamp unit */
+    int     scale;          /* Decimal */
+    int     byte_width;     /* FixedSizeBinary */
+    bool    dictionary;     /* dictionary-encoded (not supported) */
+    int     num_nodes;      /* FieldNodes this column spans, children included */
+    int     num_buffers;    /* body buffers this column spans, children included */
+} hive_arrow_field_t;
+
+typedef struct hive_arrow_schema {
+    hive_arrow_field_t *fields;
+    int                 num_fields;
+} hive_arrow_schema_t;
+
+/*
+ * Parse an IPC-encapsulated Schema message (TGetResultSetMetadataResp
+ * .arrowSchema). Returns 0 on success, -1 with a message in `err`.
+ */
+int hive_arrow_parse_schema(const uint8_t *data, size_t len,
+                            hive_arrow_schema_t *out,
+                            char *err, size_t errlen);
+
+void hive_arrow_schema_free(hive_arrow_schema_t *schema);
+
+/*
+ * Decode every RecordBatch message in an IPC byte range and append the rows
+ * to `cache` (growing it; existing rows are kept). A Schema message in the
+ * stream fills `schema` if it is still empty — cloud-fetch files carry their
+ * own. Returns 0 on success, -1 with a message in `err`; rows appended before
+ * the failure stay owned by `cache`.
+ */
+int hive_arrow_append_stream(hive_arrow_schema_t *schema,
+                             const uint8_t *data, size_t len,
+                             argus_row_cache_t *cache,
+                             char *err, size_t errlen);
+
+#endif /* ARGUS_HIVE_ARROW_H */
@@ -16,6 +16,14 @@ int hive_execute(argus_backend_conn_t conn,
                  const char *query,
                  argus_backend_op_t *out_op);
 
+int hive_submit(argus_backend_conn_t conn,
+                const char *query,
+                argus_backend_op_t *out_op);
+
+int hive_poll(argus_backend_conn_t conn,
+              argus_backend_op_t op,
+              bool *finished, int *next_ms);
+
 int hive_get_operation_status(argus_backend_conn_t conn,
                                argus_backend_op_t op,
                                bool *finished);
@@ -66,6 +74,9 @@ int hive_get_primary_keys(argus_backend_conn_t conn,
 
 bool hive_get_last_error(argus_backend_conn_t conn, char *buf, size_t buflen);
 
+bool hive_get_progress(argus_backend_conn_t conn, argus_backend_op_t op,
+                       argus_progress_t *out);
+
 /* Hive backend vtable */
 static const argus_backend_t hive_backend = {
     .name                  = "hive",
@@ -85,6 +96,9 @@ static const argus_backend_t hive_backend = {
     .get_catalogs          = hive_get_catalogs,
     .get_primary_keys      = hive_get_primary_keys,
     .get_last_error        = hive_get_last_error,
+    .get_progress          = hive_get_progress,
+    .submit                = hive_submit,
+    .poll                  = hive_poll,
 };
 
 const argus_backend_t *argus_hive_backend_get(void)
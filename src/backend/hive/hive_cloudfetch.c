@@ -0,0 +1,224 @@
+/*
+ * hive_cloudfetch.c - Parallel download of Spark / Databricks result links.
+ *
+ * With canDownloadResult set, a Databricks SQL warehouse answers large
+ * FetchResults with TSparkArrowResultLink entries instead of inline batches:
+ * presigned HTTPS URLs to Arrow IPC streams in cloud storage. The links of
+ * one TRowSet are independent, so they are fetched concurrently on a curl
+ * multi handle and decoded in link order once all have arrived, keeping the
+ * row order the server intended.
+ *
+ * The links are presigned: only the headers the server attached to each
+ * link are sent, never the warehouse credentials. TLS verification is always
+ * on and uses the system trust store (the storage endpoints are public).
+ */
+
+#include "hive_internal.h"
+#include "argus/log.h"
+#include "../http_client.h"
+
+#include <curl/curl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Concurrent downloads per FetchResults round */
+#define HIVE_CLOUDFETCH_PARALLEL 4
+
+/* Refuse to pre-size a buffer beyond this from the advertised bytesNum */
+#define HIVE_CLOUDFETCH_MAX_RESERVE (256L * 1024 * 1024)
+
+typedef struct cloudfetch_download {
+    CURL              *curl;
+    struct curl_slist *headers;
+    char              *data;
+    size_t             len;
+    size_t             cap;
+    bool               oom;
+    bool               done;
+    CURLcode           result;
+} cloudfetch_download_t;
+
+static size_t cloudfetch_write_cb(void *contents, size_t size, size_t nmemb,
+                                  void *userp)
+{
+    cloudfetch_download_t *dl = (cloudfetch_download_t *)userp;
+    size_t n = size * nmemb;
+
+    if (dl->len + n > dl->cap) {
+        size_t cap = dl->cap ? dl->cap : 64 * 1024;
+        while (cap < dl->len + n) cap *= 2;
+        char *grown = realloc(dl->data, cap);
+        if (!grown) {
+            dl->oom = true;
+            return 0; /* aborts the transfer */
+        }
+        dl->data = grown;
+        dl->cap = cap;
+    }
+    memcpy(dl->data + dl->len, contents, n);
+    dl->len += n;
+    return n;
+}
+
+static void cloudfetch_download_free(CURLM *multi, cloudfetch_download_t *dl)
+{
+    if (dl->curl) {
+        curl_multi_remove_handle(multi, dl->curl);
+        curl_easy_cleanup(dl->curl);
+    }
+    curl_slist_free_all(dl->headers);
+    free(dl->data);
+}
+
+static int cloudfetch_prepare(hive_conn_t *conn, TSparkArrowResultLink *link,
+                              cloudfetch_download_t *dl)
+{
+    dl->curl = argus_http_easy_init();
+    if (!dl->curl) return -1;
+
+    if (link->__isset_httpHeaders && link->httpHeaders) {
+        GHashTableIter iter;
+        gpointer key, value;
+        g_hash_table_iter_init(&iter, link->httpHeaders);
+        while (g_hash_table_iter_next(&iter, &key, &value)) {
+            char line[1024];
+            snprintf(line, sizeof(line), "%s: %s",
+                     (const char *)key, value ? (const char *)value : "");
+            dl->headers = curl_slist_append(dl->headers, line);
+        }
+    }
+
+    if (link->bytesNum > 0 && link->bytesNum <= HIVE_CLOUDFETCH_MAX_RESERVE) {
+        dl->data = malloc((size_t)link->bytesNum);
+        if (dl->data) dl->cap = (size_t)link->bytesNum;
+    }
+
+    curl_easy_setopt(dl->curl, CURLOPT_URL, link->fileLink);
+    curl_easy_setopt(dl->curl, CURLOPT_HTTPGET, 1L);
+    if (dl->headers)
+        curl_easy_setopt(dl->curl, CURLOPT_HTTPHEADER, dl->headers);
+    curl_easy_setopt(dl->curl, CURLOPT_WRITEFUNCTION, cloudfetch_write_cb);
+    curl_easy_setopt(dl->curl, CURLOPT_WRITEDATA, dl);
+    curl_easy_setopt(dl->curl, CURLOPT_SSL_VERIFYPEER, 1L);
+    curl_easy_setopt(dl->curl, CURLOPT_SSL_VERIFYHOST, 2L);
+    curl_easy_setopt(dl->curl, CURLOPT_TIMEOUT, (long)conn->fetch_timeout_sec);
+    curl_easy_setopt(dl->curl, CURLOPT_CONNECTTIMEOUT, 30L);
+    curl_easy_setopt(dl->curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(dl->curl, CURLOPT_ACCEPT_ENCODING, "");
+    return 0;
+}
+
+int hive_cloudfetch_links(hive_conn_t *conn, GPtrArray *links,
+                          hive_arrow_schema_t *schema,
+                          argus_row_cache_t *cache)
+{
+    guint n = links->len;
+    gint64 now_ms = g_get_real_time() / 1000;
+
+    for (guint i = 0; i < n; i++) {
+        TSparkArrowResultLink *link =
+            (TSparkArrowResultLink *)g_ptr_array_index(links, i);
+        if (!link->fileLink || !*link->fileLink) {
+            snprintf(conn->last_error, sizeof(conn->last_error),
+                     "Cloud fetch: result link %u has no URL", i);
+            return -1;
+        }
+        if (link->expiryTime > 0 && link->expiryTime <= now_ms) {
+            snprintf(conn->last_error, sizeof(conn->last_error),
+                     "Cloud fetch: result link for rows %lld.. expired; "
+                     "re-execute the query",
+                     (long long)link->startRowOffset);
+            return -1;
+        }
+    }
+
+    CURLM *multi = curl_multi_init();
+    cloudfetch_download_t *dls = calloc(n, sizeof(*dls));
+    if (!multi || !dls) {
+        if (multi) curl_multi_cleanup(multi);
+        free(dls);
+        snprintf(conn->last_error, sizeof(conn->last_error),
+                 "Cloud fetch: out of memory");
+        return -1;
+    }
+    curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                      (long)HIVE_CLOUDFETCH_PARALLEL);
+
+    int rc = -1;
+    for (guint i = 0; i < n; i++) {
+        TSparkArrowResultLink *link =
+            (TSparkArrowResultLink *)g_ptr_array_index(links, i);
+        if (cloudfetch_prepare(conn, link, &dls[i]) != 0 ||
+            curl_multi_add_handle(multi, dls[i].curl) != CURLM_OK) {
+            snprintf(conn->last_error, sizeof(conn->last_error),
+                     "Cloud fetch: could not set up download");
+            goto done;
+        }
+    }
+
+    ARGUS_LOG_DEBUG("Hive: cloud fetch of %u result link(s)", n);
+
+    /* Drive all transfers; curl queues beyond the connection limit. */
+    int running = 0;
+    do {
+        CURLMcode mc = curl_multi_perform(multi, &running);
+        if (mc == CURLM_OK && running)
+            mc = curl_multi_wait(multi, NULL, 0, 1000, NULL);
+        if (mc != CURLM_OK) {
+            snprintf(conn->last_error, sizeof(conn->last_error),
+                     "Cloud fetch: %s", curl_multi_strerror(mc));
+            goto done;
+        }
+
+        CURLMsg *msg;
+        int left;
+        while ((msg = curl_multi_info_read(multi, &left)) != NULL) {
+            if (msg->msg != CURLMSG_DONE) continue;
+            for (guint i = 0; i < n; i++) {
+                if (dls[i].curl == msg->easy_handle) {
+                    dls[i].done = true;
+                    dls[i].result = msg->data.result;
+                    break;
+                }
+            }
+        }
+    } while (running);
+
+    for (guint i = 0; i < n; i++) {
+        cloudfetch_download_t *dl = &dls[i];
+        long http_code = 0;
+        curl_easy_getinfo(dl->curl, CURLINFO_RESPONSE_CODE, &http_code);
+        if (!dl->done || dl->result != CURLE_OK || dl->oom ||
+            http_code < 200 || http_code >= 300) {
+            snprintf(conn->last_error, sizeof(conn->last_error),
+                     "Cloud fetch: download of result link %u failed: %s",
+                     i, dl->oom ? "out of memory"
+                        : dl->result != CURLE_OK ? curl_easy_strerror(dl->result)
+                        : "unexpected HTTP status");
+            goto done;
+        }
+
+        char err[256];
+        if (hive_arrow_append_stream(schema, (const uint8_t *)dl->data,
+                                     dl->len, cache, err, sizeof(err)) != 0) {
+            snprintf(conn->last_error, sizeof(conn->last_error),
+                     "Cloud fetch: result link %u: %s", i, err);
+            goto done;
+        }
+
+        /* Release each buffer as soon as its rows are materialized */
+        free(dl->data);
+        dl->data = NULL;
+    }
+    rc = 0;
+
+done:
+    if (rc != 0)
+        ARGUS_LOG_ERROR("Hive: %s", conn->last_error);
+    for (guint i = 0; i < n; i++)
+        cloudfetch_download_free(multi, &dls[i]);
+    free(dls);
+    curl_multi_cleanup(multi);
+    return rc;
+}
@@ -1,4 +1,6 @@
 #include "hive_internal.h"
+#include "argus/cancel.h"
+#include "argus/log.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -332,27 +334,145 @@ static int get_column_row_count(GObject *column_obj)
     return 0;
 }
 
+/* ── Columnar TRowSet into the row cache ─────────────────────── */
+
+/* Fill cache with the rows of a TColumn-based TRowSet. 0 on success
+ * (num_rows 0 when the set carries no columns), -1 on allocation failure. */
+int hive_parse_row_set(TRowSet *row_set, argus_row_cache_t *cache)
+{
+    GPtrArray *tcolumns = row_set->columns;
+    if (!tcolumns || tcolumns->len == 0) {
+        cache->num_rows = 0;
+        return 0;
+    }
+
+    int ncols = (int)tcolumns->len;
+    cache->num_cols = ncols;
+
+    /* Determine the row count as the max populated length across all columns.
+     * Using only the first column is wrong when it is entirely NULL (empty
+     * values array), e.g. GetTables returns a NULL TABLE_CAT first column. */
+    int nrows = 0;
+    for (int c = 0; c < ncols; c++) {
+        int n = get_column_row_count((GObject *)g_ptr_array_index(tcolumns, c));
+        if (n > nrows) nrows = n;
+    }
+
+    if (nrows == 0) {
+        cache->num_rows = 0;
+        return 0;
+    }
+
+    /* Allocate rows, reusing the cache's row array when it is large enough
+     * (the prefetcher hands the same two arrays back and forth). */
+    if (cache->capacity < (size_t)nrows) {
+        argus_row_t *grown = realloc(cache->rows,
+                                     (size_t)nrows * sizeof(argus_row_t));
+        if (!grown) return -1;
+        cache->rows = grown;
+        cache->capacity = (size_t)nrows;
+    }
+    memset(cache->rows, 0, (size_t)nrows * sizeof(argus_row_t));
+
+    for (int r = 0; r < nrows; r++) {
+        cache->rows[r].cells = calloc((size_t)ncols, sizeof(argus_cell_t));
+        if (!cache->rows[r].cells) {
+            cache->num_rows = (size_t)r;
+            return -1;
+        }
+    }
+    cache->num_rows = (size_t)nrows;
+
+    /* Parse each column */
+    for (int c = 0; c < ncols; c++) {
+        GObject *col_obj = (GObject *)g_ptr_array_index(tcolumns, c);
+        parse_column_values(col_obj, c, cache, nrows);
+    }
+    return 0;
+}
+
+/* ── Arrow result sets (Spark / Databricks) ──────────────────── */
+
+/*
+ * Append the rows of a TRowSet that carries Arrow data instead of TColumns:
+ * inline IPC batches (arrowBatches) and/or presigned links to IPC streams
+ * (resultLinks). On failure the reason goes to conn->last_error.
+ */
+static int fetch_arrow_rows(hive_conn_t *conn, hive_operation_t *op,
+                            GPtrArray *batches, GPtrArray *links,
+                            argus_row_cache_t *cache)
+{
+    char err[256];
+
+    if (batches) {
+        for (guint i = 0; i < batches->len; i++) {
+            TSparkArrowBatch *batch =
+                (TSparkArrowBatch *)g_ptr_array_index(batches, i);
+            if (!batch->batch || batch->batch->len == 0) continue;
+            if (hive_arrow_append_stream(&op->arrow_schema,
+                                         batch->batch->data,
+                                         batch->batch->len,
+                                         cache, err, sizeof(err)) != 0) {
+                snprintf(conn->last_error, sizeof(conn->last_error),
+                         "Arrow batch decode failed: %s", err);
+                ARGUS_LOG_ERROR("Hive: %s", conn->last_error);
+                return -1;
+            }
+        }
+    }
+
+    if (links && links->len > 0) {
+#ifdef ARGUS_HAS_CURL
+        if (hive_cloudfetch_links(conn, links, &op->arrow_schema, cache) != 0)
+            return -1;
+#else
+        snprintf(conn->last_error, sizeof(conn->last_error),
+                 "Server returned cloud-fetch result links but the driver "
+                 "was built without libcurl; reconnect with CloudFetch=0");
+        return -1;
+#endif
+    }
+
+    if (cache->num_rows == 0)
+        cache->num_cols = op->arrow_schema.num_fields;
+    return 0;
+}
+
 /* ── FetchResults via TCLIService ────────────────────────────── */
 
-int hive_fetch_results(argus_backend_conn_t raw_conn,
-                       argus_backend_op_t raw_op,
-                       int max_rows,
-                       argus_row_cache_t *cache,
-                       argus_column_desc_t *columns,
-                       int *num_cols)
+/*
+ * Abort action for a FetchResults blocked on the server. CancelOperation
+ * would queue behind it for the RPC lock, so the socket is cut instead: the
+ * call fails at once and the connection is lost. Over HTTP the transfer's
+ * progress callback sees the cancel by itself and the connection survives.
+ */
+static void hive_abort_fetch(void *data)
+{
+    hive_conn_t *conn = (hive_conn_t *)data;
+    argus_gio_transport_abort(conn->socket);
+}
+
+/*
+ * One FetchResults round trip, decoded into `cache` (already cleared). Runs on
+ * the application thread or on the prefetch worker, hence the RPC lock.
+ */
+int hive_fetch_batch(void *raw_conn, void *raw_op, int max_rows,
+                     argus_row_cache_t *cache)
 {
     hive_conn_t *conn = (hive_conn_t *)raw_conn;
     hive_operation_t *op = (hive_operation_t *)raw_op;
-    if (!conn || !op || !op->op_handle) return -1;
 
     GError *error = NULL;
 
-    /* Fetch metadata if not yet done */
-    if (!op->metadata_fetched && columns && num_cols) {
-        hive_get_result_metadata(raw_conn, raw_op, columns, num_cols);
+    argus_cancel_t *cancel = argus_cancel_current();
+    if (conn->socket && !argus_cancel_push(cancel, hive_abort_fetch, conn)) {
+        g_strlcpy(conn->last_error, "Fetch cancelled",
+                  sizeof(conn->last_error));
+        return -1;
     }
 
-    /* Fetch results */
+    g_rec_mutex_lock(&conn->rpc_lock);
+
     TFetchResultsReq *req = g_object_new(TYPE_T_FETCH_RESULTS_REQ, NULL);
     g_object_set(req,
                  "operationHandle", op->op_handle,
@@ -365,11 +485,18 @@ int hive_fetch_results(argus_backend_conn_t raw_conn,
     gboolean ok = t_c_l_i_service_client_fetch_results(
         conn->client, &resp, req, &error);
 
+    int rc = -1;
+    TRowSet *row_set = NULL;
+
     if (!ok || !resp) {
+        if (argus_cancel_requested(cancel))
+            g_strlcpy(conn->last_error, conn->socket
+                      ? "Fetch interrupted; the connection was closed to "
+                        "stop it"
+                      : "Fetch interrupted",
+                      sizeof(conn->last_error));
         if (error) g_error_free(error);
-        g_object_unref(req);
-        if (resp) g_object_unref(resp);
-        return -1;
+        goto done;
     }
 
     /* Check status */
@@ -379,87 +506,75 @@ int hive_fetch_results(argus_backend_conn_t raw_conn,
         TStatusCode status_code;
         g_object_get(status, "statusCode", &status_code, NULL);
         g_object_unref(status);
-        if (status_code == T_STATUS_CODE_ERROR_STATUS) {
-            g_object_unref(req);
-            g_object_unref(resp);
-            return -1;
-        }
+        if (status_code == T_STATUS_CODE_ERROR_STATUS)
+            goto done;
     }
 
     /* Get the TRowSet */
-    TRowSet *row_set = NULL;
     g_object_get(resp, "results", &row_set, NULL);
-
     if (!row_set) {
-        g_object_unref(req);
-        g_object_unref(resp);
         cache->num_rows = 0;
-        return 0;
+        rc = 0;
+        goto done;
     }
 
-    /* Get columns from TRowSet */
-    GPtrArray *tcolumns = NULL;
-    tcolumns = row_set->columns;
-
-    if (!tcolumns || tcolumns->len == 0) {
-        if (row_set) g_object_unref(row_set);
-        g_object_unref(req);
-        g_object_unref(resp);
-        cache->num_rows = 0;
-        return 0;
+    /* Spark / Databricks Arrow results take precedence over TColumns */
+    GPtrArray *batches = row_set->__isset_arrowBatches
+                         ? row_set->arrowBatches : NULL;
+    GPtrArray *links = row_set->__isset_resultLinks
+                       ? row_set->resultLinks : NULL;
+    if ((batches && batches->len > 0) || (links && links->len > 0)) {
+        /* The Arrow schema comes with the result set metadata */
+        if (!op->metadata_fetched)
+            hive_get_result_metadata(conn, op, NULL, NULL);
+        rc = fetch_arrow_rows(conn, op, batches, links, cache);
+        goto done;
     }
 
-    int ncols = (int)tcolumns->len;
-    if (num_cols) *num_cols = ncols;
-    cache->num_cols = ncols;
+    rc = hive_parse_row_set(row_set, cache);
 
-    /* Determine the row count as the max populated length across all columns.
-     * Using only the first column is wrong when it is entirely NULL (empty
-     * values array), e.g. GetTables returns a NULL TABLE_CAT first column. */
-    int nrows = 0;
-    for (int c = 0; c < ncols; c++) {
-        int rc = get_column_row_count((GObject *)g_ptr_array_index(tcolumns, c));
-        if (rc > nrows) nrows = rc;
-    }
+done:
+    g_rec_mutex_unlock(&conn->rpc_lock);
+    if (conn->socket) argus_cancel_pop(cancel);
+    if (row_set) g_object_unref(row_set);
+    g_object_unref(req);
+    if (resp) g_object_unref(resp);
+    return rc;
+}
 
-    if (nrows == 0) {
-        g_object_unref(row_set);
-        g_object_unref(req);
-        g_object_unref(resp);
-        cache->num_rows = 0;
-        return 0;
-    }
+int hive_fetch_results(argus_backend_conn_t raw_conn,
+                       argus_backend_op_t raw_op,
+                       int max_rows,
+                       argus_row_cache_t *cache,
+                       argus_column_desc_t *columns,
+                       int *num_cols)
+{
+    hive_conn_t *conn = (hive_conn_t *)raw_conn;
+    hive_operation_t *op = (hive_operation_t *)raw_op;
+    if (!conn || !op || !op->op_handle) return -1;
 
-    /* Allocate rows */
-    cache->rows = calloc((size_t)nrows, sizeof(argus_row_t));
-    if (!cache->rows) {
-        g_object_unref(row_set);
-        g_object_unref(req);
-        g_object_unref(resp);
-        return -1;
+    /* Fetch metadata if not yet done */
+    if (!op->metadata_fetched && columns && num_cols) {
+        hive_get_result_metadata(raw_conn, raw_op, columns, num_cols);
     }
-    cache->num_rows = (size_t)nrows;
-    cache->capacity = (size_t)nrows;
 
-    for (int r = 0; r < nrows; r++) {
-        cache->rows[r].cells = calloc((size_t)ncols, sizeof(argus_cell_t));
-        if (!cache->rows[r].cells) {
-            g_object_unref(row_set);
-            g_object_unref(req);
-            g_object_unref(resp);
-            return -1;
-        }
-    }
+    /* Take the batch fetched ahead while the previous one was consumed, or
+     * fetch synchronously on the first call. */
+    int rc;
+    if (argus_prefetch_pending(&op->prefetch))
+        rc = argus_prefetch_take(&op->prefetch, cache);
+    else
+        rc = hive_fetch_batch(conn, op, max_rows, cache);
+    if (rc != 0) return -1;
 
-    /* Parse each column */
-    for (int c = 0; c < ncols; c++) {
-        GObject *col_obj = (GObject *)g_ptr_array_index(tcolumns, c);
-        parse_column_values(col_obj, c, cache, nrows);
-    }
+    if (cache->num_cols > 0 && num_cols) *num_cols = cache->num_cols;
 
-    g_object_unref(row_set);
-    g_object_unref(req);
-    g_object_unref(resp);
+    /* Keep one FetchResults in flight; an empty batch ends the result set.
+     * Arrow decoding needs the schema from the metadata call first. */
+    if (conn->prefetch && cache->num_rows > 0 && op->metadata_fetched)
+        argus_prefetch_start(&op->prefetch, &conn->prefetches,
+                             hive_fetch_batch, conn, op,
+                             max_rows);
 
     return 0;
 }
@@ -494,8 +609,10 @@ int hive_get_result_metadata(argus_backend_conn_t raw_conn,
     TGetResultSetMetadataResp *resp = g_object_new(
         TYPE_T_GET_RESULT_SET_METADATA_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_result_set_metadata(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -529,6 +646,37 @@ int hive_get_result_metadata(argus_backend_conn_t raw_conn,
     int ncols = (int)col_descs->len;
     if (ncols > ARGUS_MAX_COLUMNS) ncols = ARGUS_MAX_COLUMNS;
 
+    /* Spark / Databricks: an Arrow result set ships its Arrow schema here,
+     * and the following FetchResults carry arrowBatches / resultLinks. */
+    if (resp->__isset_resultFormat &&
+        (resp->resultFormat == T_SPARK_ROW_SET_TYPE_ARROW_BASED_SET ||
+         resp->resultFormat == T_SPARK_ROW_SET_TYPE_URL_BASED_SET) &&
+        resp->__isset_arrowSchema && resp->arrowSchema &&
+        resp->arrowSchema->len > 0) {
+        char err[256];
+        hive_arrow_schema_free(&op->arrow_schema);
+        if (hive_arrow_parse_schema(resp->arrowSchema->data,
+                                    resp->arrowSchema->len,
+                                    &op->arrow_schema,
+                                    err, sizeof(err)) == 0) {
+            op->arrow_result = true;
+            if (op->arrow_schema.num_fields != ncols)
+                ARGUS_LOG_WARN("Hive: Arrow schema has %d fields, "
+                               "table schema %d columns",
+                               op->arrow_schema.num_fields, ncols);
+        } else {
+            ARGUS_LOG_WARN("Hive: ignoring unreadable Arrow schema: %s", err);
+        }
+        if (resp->__isset_lz4Compressed && resp->lz4Compressed)
+            ARGUS_LOG_WARN("Hive: server compressed Arrow batches with LZ4 "
+                           "although the driver did not offer it");
+    }
+
+    /* Kept in the operation even when the caller passes no buffer: execute
+     * reads the metadata ahead of the first fetch. */
+    argus_column_desc_t *descs = calloc(ncols > 0 ? (size_t)ncols : 1,
+                                        sizeof(argus_column_desc_t));
+
     for (int i = 0; i < ncols; i++) {
         TColumnDesc *cd = (TColumnDesc *)g_ptr_array_index(col_descs, i);
 
@@ -575,9 +723,8 @@ int hive_get_result_metadata(argus_backend_conn_t raw_conn,
             g_object_unref(type_desc);
         }
 
-        if (columns) {
-            argus_column_desc_t *col = &columns[i];
-            memset(col, 0, sizeof(*col));
+        if (descs) {
+            argus_column_desc_t *col = &descs[i];
 
             if (col_name) {
                 strncpy((char *)col->name, col_name,
@@ -594,17 +741,15 @@ int hive_get_result_metadata(argus_backend_conn_t raw_conn,
         g_free(col_name);
     }
 
+    if (columns && descs)
+        memcpy(columns, descs, (size_t)ncols * sizeof(argus_column_desc_t));
     if (num_cols) *num_cols = ncols;
 
     /* Cache metadata in the operation */
     op->metadata_fetched = true;
     op->num_cols = ncols;
-    if (columns) {
-        op->columns = malloc((size_t)ncols * sizeof(argus_column_desc_t));
-        if (op->columns)
-            memcpy(op->columns, columns,
-                   (size_t)ncols * sizeof(argus_column_desc_t));
-    }
+    free(op->columns);
+    op->columns = descs;
 
     g_object_unref(schema);
     g_object_unref(req);
@@ -4,6 +4,8 @@
 #include <glib-object.h>
 #include <thrift/c_glib/thrift.h>
 #include "../thrift_gio_transport.h"
+#include "../thrift_prefetch.h"
+#include "../thrift_poll.h"
 #include <thrift/c_glib/transport/thrift_buffered_transport.h>
 #include <thrift/c_glib/transport/thrift_framed_transport.h>
 #include <thrift/c_glib/protocol/thrift_binary_protocol.h>
@@ -11,6 +13,7 @@
 
 #include "argus/types.h"
 #include "argus/backend.h"
+#include "hive_arrow.h"
 
 /* Forward declare the generated Thrift types */
 #include "gen-c_glib/t_c_l_i_service.h"
@@ -26,6 +29,15 @@ typedef struct hive_conn {
     TSessionHandle         *session_handle;
     char                   *database;
     bool                    http_mode;      /* true when using HTTP transport */
+    bool                    arrow_results;  /* send canReadArrowResult */
+    bool                    cloud_fetch;    /* send canDownloadResult */
+    int                     fetch_timeout_sec; /* per result-link download */
+    bool                    prefetch;       /* keep one FetchResults in flight */
+    int                     first_batch_rows; /* fetched as soon as a query
+                                               * finishes (FETCHBUFFERSIZE) */
+    int                     query_timeout_sec; /* 0 = wait for ever */
+    GRecMutex               rpc_lock;       /* serializes use of `client` */
+    argus_prefetch_group_t  prefetches;     /* started, for disconnect */
     char                    last_error[512]; /* most recent server error message */
 } hive_conn_t;
 
@@ -36,6 +48,11 @@ typedef struct hive_operation {
     bool                    metadata_fetched;
     argus_column_desc_t    *columns;
     int                     num_cols;
+    bool                    arrow_result;   /* server answered with Arrow */
+    hive_arrow_schema_t     arrow_schema;   /* from GetResultSetMetadata */
+    argus_prefetch_t        prefetch;       /* next batch, fetched ahead */
+    argus_poll_t            poll;           /* runAsync completion polling */
+    bool                    rows_expected;  /* server says it has a result */
 } hive_operation_t;
 
 /* Type mapping helper */
@@ -49,5 +66,26 @@ void hive_operation_free(hive_operation_t *op);
 
 /* Query operations */
 int hive_cancel(argus_backend_conn_t conn, argus_backend_op_t op);
+int hive_get_result_metadata(argus_backend_conn_t conn, argus_backend_op_t op,
+                             argus_column_desc_t *columns, int *num_cols);
+
+/* One FetchResults round trip into `cache` (hive_fetch.c); an
+ * argus_prefetch_fn */
+int hive_fetch_batch(void *conn, void *op, int max_rows,
+                     argus_row_cache_t *cache);
+
+/* Decode a TColumn-based TRowSet into the row cache (hive_fetch.c) */
+int hive_parse_row_set(TRowSet *row_set, argus_row_cache_t *cache);
+
+#ifdef ARGUS_HAS_CURL
+/*
+ * Download the Arrow IPC streams behind a TRowSet's cloud-fetch result links
+ * (GPtrArray of TSparkArrowResultLink) in parallel and append their rows to
+ * `cache` in link order. Returns 0 on success, -1 with conn->last_error set.
+ */
+int hive_cloudfetch_links(hive_conn_t *conn, GPtrArray *links,
+                          hive_arrow_schema_t *schema,
+                          argus_row_cache_t *cache);
+#endif
 
 #endif /* ARGUS_HIVE_INTERNAL_H */
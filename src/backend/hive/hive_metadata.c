@@ -57,8 +57,10 @@ int hive_get_tables(argus_backend_conn_t raw_conn,
 
     TGetTablesResp *resp = g_object_new(TYPE_T_GET_TABLES_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_tables(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -126,8 +128,10 @@ int hive_get_columns(argus_backend_conn_t raw_conn,
 
     TGetColumnsResp *resp = g_object_new(TYPE_T_GET_COLUMNS_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_columns(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -184,8 +188,10 @@ int hive_get_type_info(argus_backend_conn_t raw_conn,
 
     TGetTypeInfoResp *resp = g_object_new(TYPE_T_GET_TYPE_INFO_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_type_info(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -246,8 +252,10 @@ int hive_get_schemas(argus_backend_conn_t raw_conn,
 
     TGetSchemasResp *resp = g_object_new(TYPE_T_GET_SCHEMAS_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_schemas(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -310,8 +318,10 @@ int hive_get_primary_keys(argus_backend_conn_t raw_conn,
 
     TGetPrimaryKeysResp *resp = g_object_new(TYPE_T_GET_PRIMARY_KEYS_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_primary_keys(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -365,8 +375,10 @@ int hive_get_catalogs(argus_backend_conn_t raw_conn,
 
     TGetCatalogsResp *resp = g_object_new(TYPE_T_GET_CATALOGS_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_catalogs(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
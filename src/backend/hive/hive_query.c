@@ -1,31 +1,46 @@
 #include "hive_internal.h"
+#include "argus/cancel.h"
+#include "argus/log.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
+/* Defined below; hive_execute waits for the runAsync operation. */
+static int hive_wait_for_completion(hive_conn_t *conn, hive_operation_t *op);
+static int hive_poll_status(void *raw_conn, void *raw_op,
+                            argus_poll_state_t *state,
+                            argus_progress_t *progress);
+static int hive_completed(hive_conn_t *conn, hive_operation_t *op,
+                          int rc, argus_poll_state_t state);
+void hive_close_operation(argus_backend_conn_t raw_conn,
+                          argus_backend_op_t raw_op);
+
 /* ── Create/free operation handles ────────────────────────────── */
 
 hive_operation_t *hive_operation_new(void)
 {
     hive_operation_t *op = calloc(1, sizeof(hive_operation_t));
+    if (op) argus_poll_init(&op->poll);
     return op;
 }
 
 void hive_operation_free(hive_operation_t *op)
 {
     if (!op) return;
+    argus_prefetch_discard(&op->prefetch);
     if (op->op_handle) g_object_unref(op->op_handle);
     free(op->columns);
+    hive_arrow_schema_free(&op->arrow_schema);
+    argus_poll_clear(&op->poll);
     free(op);
 }
 
 /* ── Execute a statement via TCLIService ─────────────────────── */
 
-int hive_execute(argus_backend_conn_t raw_conn,
-                 const char *query,
-                 argus_backend_op_t *out_op)
+/* ExecuteStatement with runAsync: returns once the server has the query */
+static int hive_submit_statement(hive_conn_t *conn, const char *query,
+                                 hive_operation_t **out_op)
 {
-    hive_conn_t *conn = (hive_conn_t *)raw_conn;
     if (!conn || !conn->client || !query) return -1;
 
     conn->last_error[0] = '\0';
@@ -37,14 +52,27 @@ int hive_execute(argus_backend_conn_t raw_conn,
     g_object_set(req,
                  "sessionHandle", conn->session_handle,
                  "statement", query,
-                 "runAsync", FALSE,
+                 "runAsync", TRUE,
                  NULL);
 
+    /* Spark / Databricks: offer Arrow results (and presigned result links
+     * when we can download them). Other servers skip the unknown fields and
+     * keep answering with columnar TRowSets. */
+    if (conn->arrow_results) {
+        g_object_set(req, "canReadArrowResult", TRUE, NULL);
+#ifdef ARGUS_HAS_CURL
+        if (conn->cloud_fetch)
+            g_object_set(req, "canDownloadResult", TRUE, NULL);
+#endif
+    }
+
     TExecuteStatementResp *resp = g_object_new(
         TYPE_T_EXECUTE_STATEMENT_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_execute_statement(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -89,31 +117,114 @@ int hive_execute(argus_backend_conn_t raw_conn,
     g_object_unref(req);
     g_object_unref(resp);
 
+    if (op->op_handle) {
+        gboolean has_rows = FALSE;
+        g_object_get(op->op_handle, "hasResultSet", &has_rows, NULL);
+        op->rows_expected = has_rows;
+    }
+
     *out_op = op;
     return 0;
 }
 
+int hive_execute(argus_backend_conn_t raw_conn,
+                 const char *query,
+                 argus_backend_op_t *out_op)
+{
+    hive_conn_t *conn = (hive_conn_t *)raw_conn;
+    hive_operation_t *op = NULL;
+    if (hive_submit_statement(conn, query, &op) != 0) return -1;
+
+    if (op->op_handle && hive_wait_for_completion(conn, op) != 0) {
+        hive_close_operation(conn, op);
+        return -1;
+    }
+
+    *out_op = op;
+    return 0;
+}
+
+/* backend.h submit/poll: the same as hive_execute, with the caller
+ * scheduling the waits between status checks */
+int hive_submit(argus_backend_conn_t raw_conn,
+                const char *query,
+                argus_backend_op_t *out_op)
+{
+    hive_conn_t *conn = (hive_conn_t *)raw_conn;
+    hive_operation_t *op = NULL;
+    if (hive_submit_statement(conn, query, &op) != 0) return -1;
+
+    argus_poll_start(&op->poll);
+    *out_op = op;
+    return 0;
+}
+
+int hive_poll(argus_backend_conn_t raw_conn,
+              argus_backend_op_t raw_op,
+              bool *finished, int *next_ms)
+{
+    hive_conn_t *conn = (hive_conn_t *)raw_conn;
+    hive_operation_t *op = (hive_operation_t *)raw_op;
+    if (!conn || !op) return -1;
+
+    *finished = true;
+    if (!op->op_handle) return 0;
+
+    argus_poll_state_t state = ARGUS_POLL_RUNNING;
+    int rc = argus_poll_step(&op->poll, hive_poll_status, conn, op,
+                             conn->query_timeout_sec, &state, next_ms);
+    if (rc == 0 && state == ARGUS_POLL_RUNNING) {
+        *finished = false;
+        return 0;
+    }
+    return hive_completed(conn, op, rc, state);
+}
+
 /* ── Get operation status ─────────────────────────────────────── */
 
-int hive_get_operation_status(argus_backend_conn_t raw_conn,
-                               argus_backend_op_t raw_op,
-                               bool *finished)
+static const char *state_name(TOperationState state)
+{
+    switch (state) {
+    case T_OPERATION_STATE_INITIALIZED_STATE: return "INITIALIZED";
+    case T_OPERATION_STATE_RUNNING_STATE:     return "RUNNING";
+    case T_OPERATION_STATE_FINISHED_STATE:    return "FINISHED";
+    case T_OPERATION_STATE_CANCELED_STATE:    return "CANCELED";
+    case T_OPERATION_STATE_CLOSED_STATE:      return "CLOSED";
+    case T_OPERATION_STATE_ERROR_STATE:       return "ERROR";
+    case T_OPERATION_STATE_PENDING_STATE:     return "PENDING";
+    case T_OPERATION_STATE_TIMEDOUT_STATE:    return "TIMEDOUT";
+    default:                                  return "UNKNOWN";
+    }
+}
+
+/*
+ * One GetOperationStatus round trip (an argus_poll_fn). Asks for the
+ * progressUpdateResponse that Hive 2.2+ attaches (Tez/LLAP vertex progress);
+ * other servers leave it unset.
+ */
+static int hive_poll_status(void *raw_conn, void *raw_op,
+                            argus_poll_state_t *state,
+                            argus_progress_t *progress)
 {
     hive_conn_t *conn = (hive_conn_t *)raw_conn;
     hive_operation_t *op = (hive_operation_t *)raw_op;
-    if (!conn || !op || !op->op_handle) return -1;
 
     GError *error = NULL;
 
     TGetOperationStatusReq *req = g_object_new(
         TYPE_T_GET_OPERATION_STATUS_REQ, NULL);
-    g_object_set(req, "operationHandle", op->op_handle, NULL);
+    g_object_set(req,
+                 "operationHandle", op->op_handle,
+                 "getProgressUpdate", TRUE,
+                 NULL);
 
     TGetOperationStatusResp *resp = g_object_new(
         TYPE_T_GET_OPERATION_STATUS_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_operation_status(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -125,10 +236,34 @@ int hive_get_operation_status(argus_backend_conn_t raw_conn,
     TOperationState op_state;
     g_object_get(resp, "operationState", &op_state, NULL);
 
-    *finished = (op_state == T_OPERATION_STATE_FINISHED_STATE ||
-                 op_state == T_OPERATION_STATE_ERROR_STATE ||
-                 op_state == T_OPERATION_STATE_CANCELED_STATE ||
-                 op_state == T_OPERATION_STATE_CLOSED_STATE);
+    switch (op_state) {
+    case T_OPERATION_STATE_FINISHED_STATE:
+        *state = ARGUS_POLL_FINISHED;
+        break;
+    case T_OPERATION_STATE_ERROR_STATE:
+        *state = ARGUS_POLL_FAILED;
+        break;
+    case T_OPERATION_STATE_CANCELED_STATE:
+    case T_OPERATION_STATE_CLOSED_STATE:
+    case T_OPERATION_STATE_TIMEDOUT_STATE:
+        *state = ARGUS_POLL_CANCELLED;
+        break;
+    default:
+        *state = ARGUS_POLL_RUNNING;
+        break;
+    }
+    g_strlcpy(progress->state, state_name(op_state), sizeof(progress->state));
+
+    if (resp->__isset_progressUpdateResponse && resp->progressUpdateResponse) {
+        TProgressUpdateResp *pu = resp->progressUpdateResponse;
+        progress->percent = pu->progressedPercentage * 100.0;
+        if (pu->footerSummary && pu->footerSummary[0])
+            ARGUS_LOG_TRACE("Hive: %s", pu->footerSummary);
+    }
+    if (resp->__isset_numModifiedRows)
+        progress->rows_processed = resp->numModifiedRows;
+    if (resp->__isset_hasResultSet)
+        op->rows_expected = resp->hasResultSet;
 
     /* A query that failed asynchronously reaches ERROR_STATE; capture the
      * server message so the ODBC layer can surface it instead of silently
@@ -148,6 +283,94 @@ int hive_get_operation_status(argus_backend_conn_t raw_conn,
     return 0;
 }
 
+int hive_get_operation_status(argus_backend_conn_t raw_conn,
+                               argus_backend_op_t raw_op,
+                               bool *finished)
+{
+    hive_conn_t *conn = (hive_conn_t *)raw_conn;
+    hive_operation_t *op = (hive_operation_t *)raw_op;
+    if (!conn || !op || !op->op_handle) return -1;
+
+    argus_poll_state_t state = ARGUS_POLL_RUNNING;
+    argus_progress_t progress;
+    memset(&progress, 0, sizeof(progress));
+    if (hive_poll_status(conn, op, &state, &progress) != 0) return -1;
+    *finished = (state != ARGUS_POLL_RUNNING);
+    return 0;
+}
+
+/*
+ * Map how polling ended to a result. Once the query finishes, the metadata
+ * and the first batch are requested right away (the batch on the prefetch
+ * worker) so they are on the wire while the application describes the
+ * result. Returns 0, or -1 with last_error set.
+ */
+static int hive_completed(hive_conn_t *conn, hive_operation_t *op,
+                          int rc, argus_poll_state_t state)
+{
+    if (rc < 0) {
+        if (!conn->last_error[0])
+            g_strlcpy(conn->last_error,
+                      "Lost track of the query: GetOperationStatus failed",
+                      sizeof(conn->last_error));
+        return -1;
+    }
+    if (rc > 0) {
+        hive_cancel(conn, op);
+        snprintf(conn->last_error, sizeof(conn->last_error),
+                 "Query timed out after %d s", conn->query_timeout_sec);
+        return -1;
+    }
+    switch (state) {
+    case ARGUS_POLL_FINISHED:
+        break;
+    case ARGUS_POLL_FAILED:
+        if (!conn->last_error[0])
+            g_strlcpy(conn->last_error, "Query failed",
+                      sizeof(conn->last_error));
+        return -1;
+    default:
+        /* Stopped by the statement's own cancel rather than the server:
+         * the operation is still running there */
+        if (argus_cancel_requested(argus_cancel_current()))
+            hive_cancel(conn, op);
+        g_strlcpy(conn->last_error, "Query was cancelled",
+                  sizeof(conn->last_error));
+        return -1;
+    }
+
+    if (conn->prefetch && op->rows_expected &&
+        hive_get_result_metadata(conn, op, NULL, NULL) == 0 &&
+        op->num_cols > 0)
+        argus_prefetch_start(&op->prefetch, &conn->prefetches,
+                             hive_fetch_batch, conn, op,
+                             conn->first_batch_rows);
+    return 0;
+}
+
+/*
+ * Drive a runAsync operation to completion. The RPC lock is only held for
+ * each status call, so hive_cancel can reach the server meanwhile.
+ */
+static int hive_wait_for_completion(hive_conn_t *conn, hive_operation_t *op)
+{
+    argus_poll_state_t state = ARGUS_POLL_RUNNING;
+    int rc = argus_poll_run(&op->poll, hive_poll_status, conn, op,
+                            conn->query_timeout_sec, &state);
+    return hive_completed(conn, op, rc, state);
+}
+
+/* ── Progress ─────────────────────────────────────────────────── */
+
+bool hive_get_progress(argus_backend_conn_t raw_conn,
+                       argus_backend_op_t raw_op, argus_progress_t *out)
+{
+    (void)raw_conn;
+    hive_operation_t *op = (hive_operation_t *)raw_op;
+    if (!op || !out) return false;
+    return argus_poll_progress(&op->poll, out);
+}
+
 /* ── Last error message ──────────────────────────────────────── */
 
 bool hive_get_last_error(argus_backend_conn_t raw_conn, char *buf, size_t buflen)
@@ -170,6 +393,10 @@ int hive_cancel(argus_backend_conn_t raw_conn,
 
     GError *error = NULL;
 
+    /* A prefetch on the wire holds the RPC lock until it returns; over HTTP
+     * it can be dropped without losing the connection */
+    if (!conn->socket) argus_prefetch_cancel(&op->prefetch);
+
     TCancelOperationReq *req = g_object_new(
         TYPE_T_CANCEL_OPERATION_REQ, NULL);
     g_object_set(req, "operationHandle", op->op_handle, NULL);
@@ -177,8 +404,10 @@ int hive_cancel(argus_backend_conn_t raw_conn,
     TCancelOperationResp *resp = g_object_new(
         TYPE_T_CANCEL_OPERATION_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_cancel_operation(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -189,17 +418,19 @@ int hive_cancel(argus_backend_conn_t raw_conn,
 
     g_object_unref(req);
     g_object_unref(resp);
+
+    /* Let a waiting execute see the CANCELED state now */
+    argus_poll_wake(&op->poll);
     return 0;
 }
 
 /* ── Close an operation ───────────────────────────────────────── */
 
-void hive_close_operation(argus_backend_conn_t raw_conn,
-                           argus_backend_op_t raw_op)
+/* The close itself, once no prefetch uses the handle */
+static void hive_close_now(void *raw_conn, void *raw_op)
 {
     hive_conn_t *conn = (hive_conn_t *)raw_conn;
     hive_operation_t *op = (hive_operation_t *)raw_op;
-    if (!conn || !op) return;
 
     if (op->op_handle) {
         GError *error = NULL;
@@ -211,8 +442,10 @@ void hive_close_operation(argus_backend_conn_t raw_conn,
         TCloseOperationResp *resp = g_object_new(
             TYPE_T_CLOSE_OPERATION_RESP, NULL);
 
+        g_rec_mutex_lock(&conn->rpc_lock);
         t_c_l_i_service_client_close_operation(
             conn->client, &resp, req, &error);
+        g_rec_mutex_unlock(&conn->rpc_lock);
 
         if (error) g_error_free(error);
         g_object_unref(req);
@@ -221,3 +454,17 @@ void hive_close_operation(argus_backend_conn_t raw_conn,
 
     hive_operation_free(op);
 }
+
+void hive_close_operation(argus_backend_conn_t raw_conn,
+                           argus_backend_op_t raw_op)
+{
+    hive_conn_t *conn = (hive_conn_t *)raw_conn;
+    hive_operation_t *op = (hive_operation_t *)raw_op;
+    if (!conn || !op) return;
+
+    /* A prefetch still on the wire uses the handle: rather than wait for it
+     * here, the close follows it on its worker. Over HTTP the request is
+     * dropped first; cutting a binary socket would lose the connection. */
+    argus_prefetch_close(&op->prefetch, conn->socket == NULL,
+                         hive_close_now, conn, op);
+}
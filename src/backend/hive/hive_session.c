@@ -66,6 +66,19 @@ int hive_connect(argus_dbc_t *dbc,
         return -1;
     }
 
+    /* Result formats offered to Spark / Databricks servers (hive_execute) */
+    conn->arrow_results = dbc->arrow_results;
+    conn->cloud_fetch = dbc->cloud_fetch;
+    conn->fetch_timeout_sec = dbc->socket_timeout_sec > 0
+                              ? dbc->socket_timeout_sec : 300;
+    conn->prefetch = dbc->prefetch;
+    conn->first_batch_rows = dbc->fetch_buffer_size > 0
+                             ? dbc->fetch_buffer_size
+                             : ARGUS_DEFAULT_BATCH_SIZE;
+    conn->query_timeout_sec = dbc->query_timeout_sec;
+    g_rec_mutex_init(&conn->rpc_lock);
+    argus_prefetch_group_init(&conn->prefetches);
+
     /* ── HTTP transport mode ────────────────────────────────────── */
 #ifdef ARGUS_HAS_CURL
     if (use_http_transport(dbc)) {
@@ -90,6 +103,8 @@ int hive_connect(argus_dbc_t *dbc,
             "username",        bearer ? "" : (username ? username : ""),
             "password",        bearer ? "" : (password ? password : ""),
             "bearer-token",    bearer ? (password ? password : "") : NULL,
+            "compression",     dbc->http_compression,
+            "http2",           dbc->http2,
             NULL);
 
         if (!thrift_transport_open(conn->transport, &error)) {
@@ -309,6 +324,8 @@ fail:
     if (conn->protocol)  g_object_unref(conn->protocol);
     if (conn->transport) g_object_unref(conn->transport);
     if (conn->socket)    g_object_unref(conn->socket);
+    g_rec_mutex_clear(&conn->rpc_lock);
+    argus_prefetch_group_clear(&conn->prefetches);
     free(conn);
     return -1;
 }
@@ -330,6 +347,11 @@ void hive_disconnect(argus_backend_conn_t raw_conn)
     hive_conn_t *conn = (hive_conn_t *)raw_conn;
     if (!conn) return;
 
+    /* Operations closed while a prefetch was on the wire are closed by it;
+     * let them finish before the session goes. Over HTTP the fetches are
+     * dropped first. */
+    argus_prefetch_group_drain(&conn->prefetches, conn->socket == NULL);
+
     GError *error = NULL;
 
     /* Close session */
@@ -342,8 +364,10 @@ void hive_disconnect(argus_backend_conn_t raw_conn)
 
         TCloseSessionResp *close_resp = g_object_new(
             TYPE_T_CLOSE_SESSION_RESP, NULL);
+        g_rec_mutex_lock(&conn->rpc_lock);
         t_c_l_i_service_client_close_session(
             conn->client, &close_resp, close_req, &error);
+        g_rec_mutex_unlock(&conn->rpc_lock);
 
         if (error) g_error_free(error);
         g_object_unref(close_req);
@@ -359,5 +383,7 @@ void hive_disconnect(argus_backend_conn_t raw_conn)
     g_object_unref(conn->transport);
     if (conn->socket) g_object_unref(conn->socket);
     free(conn->database);
+    g_rec_mutex_clear(&conn->rpc_lock);
+    argus_prefetch_group_clear(&conn->prefetches);
     free(conn);
 }
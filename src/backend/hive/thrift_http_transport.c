@@ -1,4 +1,6 @@
 #include "thrift_http_transport.h"
+#include "../http_client.h"
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -10,6 +12,13 @@
  * buffers write() calls into a request buffer, then on flush() performs an
  * HTTP POST via libcurl and stores the response body for subsequent read()
  * calls.
+ *
+ * All requests of a session go through one easy handle, so curl keeps the
+ * TCP/TLS connection alive between RPCs. Responses are requested compressed
+ * (Accept-Encoding lists whatever the linked libcurl can decode — gzip,
+ * deflate, and br/zstd when built in) and inflated by curl as they stream
+ * into read_buf. Request bodies stay uncompressed: HiveServer2 and Knox do
+ * not accept a Content-Encoding on requests.
  */
 
 G_DEFINE_TYPE(ThriftHttpTransport, thrift_http_transport, THRIFT_TYPE_TRANSPORT)
@@ -29,6 +38,8 @@ enum {
     PROP_USERNAME,
     PROP_PASSWORD,
     PROP_BEARER_TOKEN,
+    PROP_COMPRESSION,
+    PROP_HTTP2,
 };
 
 /* ── curl write callback ─────────────────────────────────────── */
@@ -57,7 +68,8 @@ thrift_http_transport_open_impl(ThriftTransport *transport, GError **error)
 
     if (self->is_connected) return TRUE;
 
-    self->curl = curl_easy_init();
+    /* Shares DNS, TLS sessions and connections with every other handle */
+    self->curl = argus_http_easy_init();
     if (!self->curl) {
         g_set_error(error, THRIFT_TRANSPORT_ERROR,
                     THRIFT_TRANSPORT_ERROR_CONNECT,
@@ -74,6 +86,9 @@ thrift_http_transport_open_impl(ThriftTransport *transport, GError **error)
                                        "Content-Type: application/x-thrift");
     self->headers = curl_slist_append(self->headers,
                                        "Accept: application/x-thrift");
+    /* Thrift bodies often exceed curl's Expect: 100-continue threshold;
+     * waiting for the interim response costs a round trip per RPC. */
+    self->headers = curl_slist_append(self->headers, "Expect:");
 
     /* Configure persistent curl settings */
     curl_easy_setopt(self->curl, CURLOPT_URL, self->url);
@@ -117,9 +132,33 @@ thrift_http_transport_open_impl(ThriftTransport *transport, GError **error)
     if (self->connect_timeout > 0)
         curl_easy_setopt(self->curl, CURLOPT_CONNECTTIMEOUT,
                          (long)self->connect_timeout);
+    if (self->request_timeout > 0)
+        curl_easy_setopt(self->curl, CURLOPT_TIMEOUT,
+                         (long)self->request_timeout);
+
+    /* Response compression, decoded by curl while streaming into read_buf */
+    if (self->compression)
+        curl_easy_setopt(self->curl, CURLOPT_ACCEPT_ENCODING, "");
+
+    /* Keep the connection warm between RPCs: idle gaps while the application
+     * consumes rows must not let a load balancer or NAT drop it. */
+    curl_easy_setopt(self->curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(self->curl, CURLOPT_TCP_KEEPIDLE, 60L);
+    curl_easy_setopt(self->curl, CURLOPT_TCP_KEEPINTVL, 30L);
+    curl_easy_setopt(self->curl, CURLOPT_TCP_NODELAY, 1L);
+#if LIBCURL_VERSION_NUM >= 0x074100 /* 7.65.0 */
+    /* Reuse the pooled connection for up to 10 minutes of idleness
+     * (curl's default of 118 s is shorter than typical think time). */
+    curl_easy_setopt(self->curl, CURLOPT_MAXAGE_CONN, 600L);
+#endif
+
+    if (self->http2)
+        curl_easy_setopt(self->curl, CURLOPT_HTTP_VERSION,
+                         (long)CURL_HTTP_VERSION_2TLS);
 
     /* Debug: enable verbose output to stderr */
-    if (getenv("ARGUS_CURL_VERBOSE"))
+    self->verbose = getenv("ARGUS_CURL_VERBOSE") != NULL;
+    if (self->verbose)
         curl_easy_setopt(self->curl, CURLOPT_VERBOSE, 1L);
 
     self->is_connected = TRUE;
@@ -192,7 +231,7 @@ thrift_http_transport_write_impl(ThriftTransport *transport,
         self->write_buf = g_byte_array_new();
 
     g_byte_array_append(self->write_buf, buf, len);
-    if (getenv("ARGUS_CURL_VERBOSE") && len > 0)
+    if (self->verbose && len > 0)
         fprintf(stderr, "[HTTP] write: %u bytes (total=%u)\n",
                 len, self->write_buf->len);
     return TRUE;
@@ -203,7 +242,7 @@ thrift_http_transport_flush_impl(ThriftTransport *transport, GError **error)
 {
     ThriftHttpTransport *self = THRIFT_HTTP_TRANSPORT(transport);
 
-    if (getenv("ARGUS_CURL_VERBOSE"))
+    if (self->verbose)
         fprintf(stderr, "[HTTP] flush called (write_buf=%u bytes)\n",
                 self->write_buf ? self->write_buf->len : 0);
 
@@ -215,10 +254,6 @@ thrift_http_transport_flush_impl(ThriftTransport *transport, GError **error)
     curl_easy_setopt(self->curl, CURLOPT_POSTFIELDSIZE,
                      (long)self->write_buf->len);
 
-    if (self->request_timeout > 0)
-        curl_easy_setopt(self->curl, CURLOPT_TIMEOUT,
-                         (long)self->request_timeout);
-
     /* Response buffer */
     if (self->read_buf)
         g_byte_array_set_size(self->read_buf, 0);
@@ -229,10 +264,23 @@ thrift_http_transport_flush_impl(ThriftTransport *transport, GError **error)
     curl_easy_setopt(self->curl, CURLOPT_WRITEFUNCTION, curl_write_cb);
     curl_easy_setopt(self->curl, CURLOPT_WRITEDATA, self->read_buf);
 
+    /* SQLCancel and the query timeout of the statement this thread runs end
+     * the request; each RPC is its own request, so the connection survives */
+    argus_http_bind_cancel(self->curl);
+
+    /* The RPC of a traced statement carries its traceparent */
+    struct curl_slist *traced = argus_http_trace_headers(self->headers);
+    if (traced)
+        curl_easy_setopt(self->curl, CURLOPT_HTTPHEADER, traced);
+
     /* Perform the request */
     CURLcode rc = curl_easy_perform(self->curl);
+    if (traced) {
+        curl_easy_setopt(self->curl, CURLOPT_HTTPHEADER, self->headers);
+        curl_slist_free_all(traced);
+    }
 
-    if (getenv("ARGUS_CURL_VERBOSE")) {
+    if (self->verbose) {
         long http_code_dbg = 0;
         curl_easy_getinfo(self->curl, CURLINFO_RESPONSE_CODE, &http_code_dbg);
         fprintf(stderr, "[HTTP] flush: sent %u bytes, got %u bytes back (HTTP %ld, curl=%d)\n",
@@ -342,6 +390,12 @@ thrift_http_transport_set_property(GObject *object, guint prop_id,
         g_free(self->bearer_token);
         self->bearer_token = g_value_dup_string(value);
         break;
+    case PROP_COMPRESSION:
+        self->compression = g_value_get_boolean(value);
+        break;
+    case PROP_HTTP2:
+        self->http2 = g_value_get_boolean(value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
     }
@@ -386,6 +440,12 @@ thrift_http_transport_get_property(GObject *object, guint prop_id,
     case PROP_BEARER_TOKEN:
         g_value_set_string(value, self->bearer_token);
         break;
+    case PROP_COMPRESSION:
+        g_value_set_boolean(value, self->compression);
+        break;
+    case PROP_HTTP2:
+        g_value_set_boolean(value, self->http2);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
     }
@@ -403,6 +463,9 @@ thrift_http_transport_init(ThriftHttpTransport *self)
     self->ssl_verify = FALSE;
     self->connect_timeout = 30;
     self->request_timeout = 300;
+    self->compression = TRUE;
+    self->http2 = FALSE;
+    self->verbose = FALSE;
 }
 
 static void
@@ -454,4 +517,10 @@ thrift_http_transport_class_init(ThriftHttpTransportClass *klass)
         g_param_spec_string("password", NULL, NULL, NULL, G_PARAM_READWRITE));
     g_object_class_install_property(gobject_class, PROP_BEARER_TOKEN,
         g_param_spec_string("bearer-token", NULL, NULL, NULL, G_PARAM_READWRITE));
+    g_object_class_install_property(gobject_class, PROP_COMPRESSION,
+        g_param_spec_boolean("compression", NULL, NULL, TRUE,
+                             G_PARAM_READWRITE));
+    g_object_class_install_property(gobject_class, PROP_HTTP2,
+        g_param_spec_boolean("http2", NULL, NULL, FALSE,
+                             G_PARAM_READWRITE));
 }
@@ -37,6 +37,8 @@ struct _ThriftHttpTransport
     char       *username;         /* for basic auth */
     char       *password;         /* for basic auth */
     char       *bearer_token;     /* Authorization: Bearer <token> (JWT/PAT) */
+    gboolean    compression;      /* negotiate gzip/zstd/... response bodies */
+    gboolean    http2;            /* prefer HTTP/2 over TLS (ALPN) */
 
     /* Runtime state */
     CURL       *curl;
@@ -44,6 +46,7 @@ struct _ThriftHttpTransport
     GByteArray *read_buf;
     gsize       read_pos;
     gboolean    is_connected;
+    gboolean    verbose;          /* ARGUS_CURL_VERBOSE, read once at open */
     struct curl_slist *headers;
 };
 
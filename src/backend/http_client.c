@@ -1,14 +1,70 @@
 /*
- * http_client.c - Minimal shared HTTPS JSON POST helper.
+ * http_client.c - Shared HTTP client layer (see http_client.h).
  *
- * See http_client.h. Modelled on trino_http_post()/trino_apply_curl_settings()
- * but self-contained: its own easy handle, no auth, no response capture.
+ * Modelled on trino_http_post()/trino_apply_curl_settings(), which it now
+ * backs, along with the Phoenix, Pinot, Druid, BigQuery and Hive HTTP
+ * transports and the telemetry sender.
  */
 
 #include "http_client.h"
+#include "argus/cancel.h"
+#include "argus/trace.h"
 
 #include <curl/curl.h>
+#include <glib.h>
 #include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/* ── Process-wide share ──────────────────────────────────────── */
+
+static CURLSH *g_http_share;
+static GMutex  g_http_share_locks[CURL_LOCK_DATA_LAST];
+
+static void http_share_lock(CURL *handle, curl_lock_data data,
+                            curl_lock_access access, void *userp)
+{
+    (void)handle;
+    (void)access;
+    (void)userp;
+    g_mutex_lock(&g_http_share_locks[data]);
+}
+
+static void http_share_unlock(CURL *handle, curl_lock_data data, void *userp)
+{
+    (void)handle;
+    (void)userp;
+    g_mutex_unlock(&g_http_share_locks[data]);
+}
+
+void argus_http_global_init(void)
+{
+    if (g_http_share) return;
+
+    CURLSH *share = curl_share_init();
+    if (!share) return;
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, http_share_lock);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, http_share_unlock);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+    /* Keep-alive connections outlive the easy handle (and the ODBC
+     * connection) that opened them. libcurl only reuses one whose host,
+     * TLS settings and credentials match the new request. */
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+    g_http_share = share;
+}
+
+void argus_http_global_cleanup(void)
+{
+    if (!g_http_share) return;
+    /* Fails with CURLSHE_IN_USE if a handle leaked; keep it alive then. */
+    if (curl_share_cleanup(g_http_share) == CURLSHE_OK)
+        g_http_share = NULL;
+}
+
+/* ── Handles ─────────────────────────────────────────────────── */
 
 /* Discard any response body without buffering it. */
 static size_t http_discard_cb(void *contents, size_t size, size_t nmemb,
@@ -19,12 +75,160 @@ static size_t http_discard_cb(void *contents, size_t size, size_t nmemb,
     return size * nmemb;
 }
 
+CURL *argus_http_easy_init(void)
+{
+    CURL *curl = curl_easy_init();
+    if (!curl) return NULL;
+
+    if (g_http_share)
+        curl_easy_setopt(curl, CURLOPT_SHARE, g_http_share);
+    /* Never let a DNS timeout raise SIGALRM in the host application. */
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+    return curl;
+}
+
+CURL *argus_http_handle_new(const argus_http_opts_t *opts)
+{
+    CURL *curl = argus_http_easy_init();
+    if (!curl || !opts) return curl;
+
+    if (opts->tls) {
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER,
+                         opts->tls_verify ? 1L : 0L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST,
+                         opts->tls_verify ? 2L : 0L);
+        if (opts->cert_file)
+            curl_easy_setopt(curl, CURLOPT_SSLCERT, opts->cert_file);
+        if (opts->key_file)
+            curl_easy_setopt(curl, CURLOPT_SSLKEY, opts->key_file);
+        if (opts->ca_file)
+            curl_easy_setopt(curl, CURLOPT_CAINFO, opts->ca_file);
+    }
+
+    if (opts->connect_timeout_sec > 0)
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT,
+                         opts->connect_timeout_sec);
+    if (opts->timeout_sec > 0)
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, opts->timeout_sec);
+
+    if (opts->http2) {
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION,
+                         (long)CURL_HTTP_VERSION_2TLS);
+#if LIBCURL_VERSION_NUM >= 0x072b00 /* 7.43.0 */
+        /* In a multi handle, wait for a connection that may multiplex
+         * rather than opening a second one alongside it. */
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+#endif
+    }
+
+    if (opts->auth == (long)CURLAUTH_BASIC) {
+        curl_easy_setopt(curl, CURLOPT_HTTPAUTH, (long)CURLAUTH_BASIC);
+        curl_easy_setopt(curl, CURLOPT_USERNAME, opts->user ? opts->user : "");
+        curl_easy_setopt(curl, CURLOPT_PASSWORD,
+                         opts->password ? opts->password : "");
+    } else if (opts->auth == (long)CURLAUTH_NEGOTIATE) {
+        /* Kerberos/SPNEGO via the ambient credential cache (kinit). */
+        curl_easy_setopt(curl, CURLOPT_HTTPAUTH, (long)CURLAUTH_NEGOTIATE);
+        curl_easy_setopt(curl, CURLOPT_USERPWD, ":");
+    }
+    return curl;
+}
+
+/* Abort the transfer once the statement it serves is cancelled or past its
+ * query timeout. libcurl calls this at least once a second, even while it
+ * waits for a response that has not started. */
+static int http_cancel_cb(void *clientp, curl_off_t dltotal, curl_off_t dlnow,
+                          curl_off_t ultotal, curl_off_t ulnow)
+{
+    (void)dltotal;
+    (void)dlnow;
+    (void)ultotal;
+    (void)ulnow;
+    return argus_cancel_requested((argus_cancel_t *)clientp) ? 1 : 0;
+}
+
+void argus_http_prepare(CURL *curl, const char *method, const char *url,
+                        const char *body, struct curl_slist *headers,
+                        argus_http_write_fn write_cb, void *write_data)
+{
+    /* Undo whatever the previous request on this handle switched on */
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 0L);
+    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, NULL);
+
+    if (strcmp(method, "POST") == 0) {
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, -1L);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body ? body : "");
+    } else {
+        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+        if (strcmp(method, "HEAD") == 0)
+            curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+        else if (strcmp(method, "GET") != 0)
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, method);
+    }
+
+    curl_easy_setopt(curl, CURLOPT_URL, url);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION,
+                     write_cb ? write_cb : http_discard_cb);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, write_data);
+
+    argus_http_bind_cancel(curl);
+}
+
+void argus_http_bind_cancel(CURL *curl)
+{
+    /* Bound to the token of the statement the calling thread is running,
+     * if any; the transfer then fails with CURLE_ABORTED_BY_CALLBACK */
+    argus_cancel_t *cancel = argus_cancel_current();
+    if (cancel) {
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, http_cancel_cb);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, cancel);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+    } else {
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 1L);
+    }
+}
+
+/* ── Trace-context propagation ───────────────────────────────── */
+
+struct curl_slist *argus_http_trace_headers(const struct curl_slist *base)
+{
+    char tp[ARGUS_TRACEPARENT_LEN];
+    if (!argus_trace_traceparent(tp)) return NULL;
+
+    struct curl_slist *out = NULL;
+    for (const struct curl_slist *h = base; h; h = h->next) {
+        struct curl_slist *n = curl_slist_append(out, h->data);
+        if (!n) {
+            curl_slist_free_all(out);
+            return NULL;
+        }
+        out = n;
+    }
+    char line[16 + ARGUS_TRACEPARENT_LEN];
+    snprintf(line, sizeof(line), "traceparent: %s", tp);
+    struct curl_slist *n = curl_slist_append(out, line);
+    if (!n) curl_slist_free_all(out);
+    return n;
+}
+
+/* ── Fire-and-forget JSON POST ───────────────────────────────── */
+
 int argus_http_post_json(const char *url, const char *body, long timeout_sec)
 {
     if (!url || !*url || !body)
         return -1;
 
-    CURL *curl = curl_easy_init();
+    argus_http_opts_t opts = {
+        .tls = true,
+        .tls_verify = true,   /* always on; system trust store */
+        .connect_timeout_sec = timeout_sec,
+        .timeout_sec = timeout_sec,
+    };
+    CURL *curl = argus_http_handle_new(&opts);
     if (!curl)
         return -1;
 
@@ -32,22 +236,7 @@ int argus_http_post_json(const char *url, const char *body, long timeout_sec)
     headers = curl_slist_append(headers, "Content-Type: application/json");
     headers = curl_slist_append(headers, "Accept: application/json");
 
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, http_discard_cb);
-
-    /* TLS verification is always on; use the system trust store. */
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
-
-    if (timeout_sec > 0) {
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout_sec);
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, timeout_sec);
-    }
-    /* Never let a stuck sender hang process teardown. */
-    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    argus_http_prepare(curl, "POST", url, body, headers, NULL, NULL);
 
     CURLcode res = curl_easy_perform(curl);
     int rc = -1;
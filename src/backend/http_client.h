@@ -2,22 +2,87 @@
 #define ARGUS_HTTP_CLIENT_H
 
 /*
- * http_client.h - Minimal shared HTTPS client.
+ * http_client.h - Shared HTTP client layer for the REST/HTTP backends.
  *
- * Factored out of the per-backend curl helpers (cf. trino_session.c) for
- * fire-and-forget JSON POSTs that do not need a persistent session, custom
- * auth, or response bodies — currently the telemetry sender. TLS peer/host
- * verification is always on and the system trust store is used; there is no
- * option to disable verification here.
+ * Every easy handle the driver creates is attached to one process-wide
+ * CURLSH share holding the DNS cache, TLS session tickets and (libcurl
+ * >= 7.57) the connection cache. A new ODBC connection to a host the
+ * process has already talked to thus skips the DNS lookup and usually the
+ * TCP and TLS handshakes too — BI tools open many short connections.
+ *
+ * Backends configure a per-connection handle once from an option template
+ * (argus_http_handle_new) and then only switch the per-request options
+ * (argus_http_prepare), instead of curl_easy_reset() and re-applying TLS
+ * and auth settings before every request.
  */
 
+#include <curl/curl.h>
+#include <stdbool.h>
 #include <stddef.h>
 
+/* Per-connection settings applied once when the handle is created. */
+typedef struct argus_http_opts {
+    bool        tls;                  /* https endpoint: apply TLS options */
+    bool        tls_verify;           /* verify peer certificate and host */
+    const char *ca_file;              /* optional CA bundle */
+    const char *cert_file;            /* optional client certificate */
+    const char *key_file;             /* optional client key */
+    long        connect_timeout_sec;  /* 0 = libcurl default */
+    long        timeout_sec;          /* whole transfer; 0 = no limit */
+    long        auth;                 /* CURLAUTH_BASIC, CURLAUTH_NEGOTIATE or 0 */
+    const char *user;                 /* Basic credentials */
+    const char *password;
+    bool        http2;                /* negotiate HTTP/2 over TLS (ALPN) */
+} argus_http_opts_t;
+
+/* Response body sink, shaped like the backends' write callbacks. */
+typedef size_t (*argus_http_write_fn)(void *data, size_t size, size_t nmemb,
+                                      void *userp);
+
+/* Create / destroy the process-wide share (library load / unload). */
+void argus_http_global_init(void);
+void argus_http_global_cleanup(void);
+
+/*
+ * A new easy handle attached to the shared DNS/TLS/connection caches, with
+ * signals off and TCP keepalive on. Works (unshared) before global init.
+ */
+CURL *argus_http_easy_init(void);
+
+/* argus_http_easy_init() plus `opts`. Returns NULL on failure. */
+CURL *argus_http_handle_new(const argus_http_opts_t *opts);
+
+/*
+ * Set up a handle made by argus_http_handle_new() for one request, leaving
+ * its template options in place. `method` is "GET", "POST", "DELETE" or
+ * "HEAD"; `body` is the POST body (NUL-terminated). A NULL `write_cb`
+ * discards the response body. When the calling thread runs a statement
+ * (argus_cancel_current()), SQLCancel and the query timeout abort the
+ * transfer.
+ */
+void argus_http_prepare(CURL *curl, const char *method, const char *url,
+                        const char *body, struct curl_slist *headers,
+                        argus_http_write_fn write_cb, void *write_data);
+
+/* Just the cancel binding of argus_http_prepare, for transports that set up
+ * their own requests (the Hive Thrift HTTP transport) */
+void argus_http_bind_cancel(CURL *curl);
+
+/*
+ * `base` plus a W3C traceparent header for the span bound to the calling
+ * thread (argus/trace.h), or NULL when no span is bound or out of memory.
+ * The caller sends the returned list in place of `base` and frees it with
+ * curl_slist_free_all() once the transfer is over.
+ */
+struct curl_slist *argus_http_trace_headers(const struct curl_slist *base);
+
 /*
  * POST `body` as application/json to `url` over HTTPS.
  * `timeout_sec` bounds the whole transfer (connect + transfer).
  * Returns 0 on a 2xx response, -1 otherwise. The response body is discarded.
- * Thread-safe provided curl_global_init() has run (done at library load).
+ * TLS peer/host verification is always on and the system trust store is
+ * used. Thread-safe provided curl_global_init() has run (done at library
+ * load).
  */
 int argus_http_post_json(const char *url, const char *body, long timeout_sec);
 
@@ -16,6 +16,14 @@ int impala_execute(argus_backend_conn_t conn,
                    const char *query,
                    argus_backend_op_t *out_op);
 
+int impala_submit(argus_backend_conn_t conn,
+                  const char *query,
+                  argus_backend_op_t *out_op);
+
+int impala_poll(argus_backend_conn_t conn,
+                argus_backend_op_t op,
+                bool *finished, int *next_ms);
+
 int impala_get_operation_status(argus_backend_conn_t conn,
                                  argus_backend_op_t op,
                                  bool *finished);
@@ -66,6 +74,9 @@ int impala_get_primary_keys(argus_backend_conn_t conn,
 
 bool impala_get_last_error(argus_backend_conn_t conn, char *buf, size_t buflen);
 
+bool impala_get_progress(argus_backend_conn_t conn, argus_backend_op_t op,
+                         argus_progress_t *out);
+
 /* Impala backend vtable */
 static const argus_backend_t impala_backend = {
     .name                  = "impala",
@@ -85,6 +96,9 @@ static const argus_backend_t impala_backend = {
     .get_catalogs          = impala_get_catalogs,
     .get_primary_keys      = impala_get_primary_keys,
     .get_last_error        = impala_get_last_error,
+    .get_progress          = impala_get_progress,
+    .submit                = impala_submit,
+    .poll                  = impala_poll,
 };
 
 const argus_backend_t *argus_impala_backend_get(void)
@@ -1,14 +1,9 @@
 #include "impala_internal.h"
+#include "argus/cancel.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
-/* Forward declaration */
-int impala_get_result_metadata(argus_backend_conn_t raw_conn,
-                                argus_backend_op_t raw_op,
-                                argus_column_desc_t *columns,
-                                int *num_cols);
-
 /* ── Parse columnar TRowSet into argus_row_cache ─────────────── */
 
 static int parse_column_values(GObject *column_obj,
@@ -326,25 +321,38 @@ static int get_column_row_count(GObject *column_obj)
 
 /* ── FetchResults via TCLIService ────────────────────────────── */
 
-int impala_fetch_results(argus_backend_conn_t raw_conn,
-                         argus_backend_op_t raw_op,
-                         int max_rows,
-                         argus_row_cache_t *cache,
-                         argus_column_desc_t *columns,
-                         int *num_cols)
+/*
+ * Abort action for a FetchResults blocked on the server: CancelOperation
+ * would queue behind it for the RPC lock, so the socket is cut instead, and
+ * the connection is lost.
+ */
+static void impala_abort_fetch(void *data)
+{
+    impala_conn_t *conn = (impala_conn_t *)data;
+    argus_gio_transport_abort(conn->socket);
+}
+
+/*
+ * One FetchResults round trip, decoded into `cache` (already cleared). Runs on
+ * the application thread or on the prefetch worker, hence the RPC lock.
+ */
+int impala_fetch_batch(void *raw_conn, void *raw_op, int max_rows,
+                       argus_row_cache_t *cache)
 {
     impala_conn_t *conn = (impala_conn_t *)raw_conn;
     impala_operation_t *op = (impala_operation_t *)raw_op;
-    if (!conn || !op || !op->op_handle) return -1;
 
     GError *error = NULL;
 
-    /* Fetch metadata if not yet done */
-    if (!op->metadata_fetched && columns && num_cols) {
-        impala_get_result_metadata(raw_conn, raw_op, columns, num_cols);
+    argus_cancel_t *cancel = argus_cancel_current();
+    if (!argus_cancel_push(cancel, impala_abort_fetch, conn)) {
+        g_strlcpy(conn->last_error, "Fetch cancelled",
+                  sizeof(conn->last_error));
+        return -1;
     }
 
-    /* Fetch results */
+    g_rec_mutex_lock(&conn->rpc_lock);
+
     TFetchResultsReq *req = g_object_new(TYPE_T_FETCH_RESULTS_REQ, NULL);
     g_object_set(req,
                  "operationHandle", op->op_handle,
@@ -357,11 +365,16 @@ int impala_fetch_results(argus_backend_conn_t raw_conn,
     gboolean ok = t_c_l_i_service_client_fetch_results(
         conn->client, &resp, req, &error);
 
+    int rc = -1;
+    TRowSet *row_set = NULL;
+
     if (!ok || !resp) {
+        if (argus_cancel_requested(cancel))
+            g_strlcpy(conn->last_error,
+                      "Fetch interrupted; the connection was closed to stop "
+                      "it", sizeof(conn->last_error));
         if (error) g_error_free(error);
-        g_object_unref(req);
-        if (resp) g_object_unref(resp);
-        return -1;
+        goto done;
     }
 
     /* Check status */
@@ -371,22 +384,16 @@ int impala_fetch_results(argus_backend_conn_t raw_conn,
         TStatusCode status_code;
         g_object_get(status, "statusCode", &status_code, NULL);
         g_object_unref(status);
-        if (status_code == T_STATUS_CODE_ERROR_STATUS) {
-            g_object_unref(req);
-            g_object_unref(resp);
-            return -1;
-        }
+        if (status_code == T_STATUS_CODE_ERROR_STATUS)
+            goto done;
     }
 
     /* Get the TRowSet */
-    TRowSet *row_set = NULL;
     g_object_get(resp, "results", &row_set, NULL);
-
     if (!row_set) {
-        g_object_unref(req);
-        g_object_unref(resp);
         cache->num_rows = 0;
-        return 0;
+        rc = 0;
+        goto done;
     }
 
     /* Get columns from TRowSet */
@@ -394,63 +401,96 @@ int impala_fetch_results(argus_backend_conn_t raw_conn,
     g_object_get(row_set, "columns", &tcolumns, NULL);
 
     if (!tcolumns || tcolumns->len == 0) {
-        if (row_set) g_object_unref(row_set);
-        g_object_unref(req);
-        g_object_unref(resp);
         cache->num_rows = 0;
-        return 0;
+        rc = 0;
+        goto done;
     }
 
     int ncols = (int)tcolumns->len;
-    if (num_cols) *num_cols = ncols;
     cache->num_cols = ncols;
 
     /* Determine the row count as the max populated length across all columns
      * (the first column may be entirely NULL, e.g. a NULL TABLE_CAT). */
     int nrows = 0;
     for (int c = 0; c < ncols; c++) {
-        int rc = get_column_row_count((GObject *)g_ptr_array_index(tcolumns, c));
-        if (rc > nrows) nrows = rc;
+        int n = get_column_row_count((GObject *)g_ptr_array_index(tcolumns, c));
+        if (n > nrows) nrows = n;
     }
 
     if (nrows == 0) {
-        g_object_unref(row_set);
-        g_object_unref(req);
-        g_object_unref(resp);
         cache->num_rows = 0;
-        return 0;
+        rc = 0;
+        goto done;
     }
 
-    /* Allocate rows */
-    cache->rows = calloc((size_t)nrows, sizeof(argus_row_t));
-    if (!cache->rows) {
-        g_object_unref(row_set);
-        g_object_unref(req);
-        g_object_unref(resp);
-        return -1;
+    /* Allocate rows, reusing the cache's row array when it is large enough
+     * (the prefetcher hands the same two arrays back and forth). */
+    if (cache->capacity < (size_t)nrows) {
+        argus_row_t *grown = realloc(cache->rows,
+                                     (size_t)nrows * sizeof(argus_row_t));
+        if (!grown) goto done;
+        cache->rows = grown;
+        cache->capacity = (size_t)nrows;
     }
-    cache->num_rows = (size_t)nrows;
-    cache->capacity = (size_t)nrows;
+    memset(cache->rows, 0, (size_t)nrows * sizeof(argus_row_t));
 
     for (int r = 0; r < nrows; r++) {
         cache->rows[r].cells = calloc((size_t)ncols, sizeof(argus_cell_t));
         if (!cache->rows[r].cells) {
-            g_object_unref(row_set);
-            g_object_unref(req);
-            g_object_unref(resp);
-            return -1;
+            cache->num_rows = (size_t)r;
+            goto done;
         }
     }
+    cache->num_rows = (size_t)nrows;
 
     /* Parse each column */
     for (int c = 0; c < ncols; c++) {
         GObject *col_obj = (GObject *)g_ptr_array_index(tcolumns, c);
         parse_column_values(col_obj, c, cache, nrows);
     }
+    rc = 0;
 
-    g_object_unref(row_set);
+done:
+    g_rec_mutex_unlock(&conn->rpc_lock);
+    argus_cancel_pop(cancel);
+    if (row_set) g_object_unref(row_set);
     g_object_unref(req);
-    g_object_unref(resp);
+    if (resp) g_object_unref(resp);
+    return rc;
+}
+
+int impala_fetch_results(argus_backend_conn_t raw_conn,
+                         argus_backend_op_t raw_op,
+                         int max_rows,
+                         argus_row_cache_t *cache,
+                         argus_column_desc_t *columns,
+                         int *num_cols)
+{
+    impala_conn_t *conn = (impala_conn_t *)raw_conn;
+    impala_operation_t *op = (impala_operation_t *)raw_op;
+    if (!conn || !op || !op->op_handle) return -1;
+
+    /* Fetch metadata if not yet done */
+    if (!op->metadata_fetched && columns && num_cols) {
+        impala_get_result_metadata(raw_conn, raw_op, columns, num_cols);
+    }
+
+    /* Take the batch fetched ahead while the previous one was consumed, or
+     * fetch synchronously on the first call. */
+    int rc;
+    if (argus_prefetch_pending(&op->prefetch))
+        rc = argus_prefetch_take(&op->prefetch, cache);
+    else
+        rc = impala_fetch_batch(conn, op, max_rows, cache);
+    if (rc != 0) return -1;
+
+    if (cache->num_cols > 0 && num_cols) *num_cols = cache->num_cols;
+
+    /* Keep one FetchResults in flight; an empty batch ends the result set. */
+    if (conn->prefetch && cache->num_rows > 0)
+        argus_prefetch_start(&op->prefetch, &conn->prefetches,
+                             impala_fetch_batch, conn, op,
+                             max_rows);
 
     return 0;
 }
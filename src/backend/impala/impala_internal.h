@@ -4,6 +4,8 @@
 #include <glib-object.h>
 #include <thrift/c_glib/thrift.h>
 #include "../thrift_gio_transport.h"
+#include "../thrift_prefetch.h"
+#include "../thrift_poll.h"
 #include <thrift/c_glib/transport/thrift_buffered_transport.h>
 #include <thrift/c_glib/transport/thrift_framed_transport.h>
 #include <thrift/c_glib/protocol/thrift_binary_protocol.h>
@@ -26,6 +28,12 @@ typedef struct impala_conn {
     TSessionHandle         *session_handle;
     char                   *database;
     char                    last_error[512]; /* most recent server error message */
+    bool                    prefetch;       /* keep one FetchResults in flight */
+    int                     first_batch_rows; /* fetched as soon as a query
+                                               * finishes (FETCHBUFFERSIZE) */
+    int                     query_timeout_sec; /* 0 = wait for ever */
+    GRecMutex               rpc_lock;       /* serializes use of `client` */
+    argus_prefetch_group_t  prefetches;     /* started, for disconnect */
 } impala_conn_t;
 
 /* Impala operation state */
@@ -35,6 +43,9 @@ typedef struct impala_operation {
     bool                    metadata_fetched;
     argus_column_desc_t    *columns;
     int                     num_cols;
+    argus_prefetch_t        prefetch;       /* next batch, fetched ahead */
+    argus_poll_t            poll;           /* runAsync completion polling */
+    bool                    rows_expected;  /* server says it has a result */
 } impala_operation_t;
 
 /* Type mapping helpers */
@@ -48,5 +59,13 @@ void impala_operation_free(impala_operation_t *op);
 
 /* Query operations */
 int impala_cancel(argus_backend_conn_t conn, argus_backend_op_t op);
+int impala_get_result_metadata(argus_backend_conn_t conn,
+                               argus_backend_op_t op,
+                               argus_column_desc_t *columns, int *num_cols);
+
+/* One FetchResults round trip into `cache` (impala_fetch.c); an
+ * argus_prefetch_fn */
+int impala_fetch_batch(void *conn, void *op, int max_rows,
+                       argus_row_cache_t *cache);
 
 #endif /* ARGUS_IMPALA_INTERNAL_H */
@@ -33,8 +33,10 @@ int impala_get_result_metadata(argus_backend_conn_t raw_conn,
     TGetResultSetMetadataResp *resp = g_object_new(
         TYPE_T_GET_RESULT_SET_METADATA_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_result_set_metadata(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -68,6 +70,11 @@ int impala_get_result_metadata(argus_backend_conn_t raw_conn,
     int ncols = (int)col_descs->len;
     if (ncols > ARGUS_MAX_COLUMNS) ncols = ARGUS_MAX_COLUMNS;
 
+    /* Kept in the operation even when the caller passes no buffer: execute
+     * reads the metadata ahead of the first fetch. */
+    argus_column_desc_t *descs = calloc(ncols > 0 ? (size_t)ncols : 1,
+                                        sizeof(argus_column_desc_t));
+
     for (int i = 0; i < ncols; i++) {
         TColumnDesc *cd = (TColumnDesc *)g_ptr_array_index(col_descs, i);
 
@@ -113,9 +120,8 @@ int impala_get_result_metadata(argus_backend_conn_t raw_conn,
             g_object_unref(type_desc);
         }
 
-        if (columns) {
-            argus_column_desc_t *col = &columns[i];
-            memset(col, 0, sizeof(*col));
+        if (descs) {
+            argus_column_desc_t *col = &descs[i];
 
             if (col_name) {
                 strncpy((char *)col->name, col_name,
@@ -132,17 +138,15 @@ int impala_get_result_metadata(argus_backend_conn_t raw_conn,
         g_free(col_name);
     }
 
+    if (columns && descs)
+        memcpy(columns, descs, (size_t)ncols * sizeof(argus_column_desc_t));
     if (num_cols) *num_cols = ncols;
 
     /* Cache metadata in the operation */
     op->metadata_fetched = true;
     op->num_cols = ncols;
-    if (columns) {
-        op->columns = malloc((size_t)ncols * sizeof(argus_column_desc_t));
-        if (op->columns)
-            memcpy(op->columns, columns,
-                   (size_t)ncols * sizeof(argus_column_desc_t));
-    }
+    free(op->columns);
+    op->columns = descs;
 
     g_object_unref(schema);
     g_object_unref(req);
@@ -201,8 +205,10 @@ int impala_get_tables(argus_backend_conn_t raw_conn,
 
     TGetTablesResp *resp = g_object_new(TYPE_T_GET_TABLES_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_tables(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -269,8 +275,10 @@ int impala_get_columns(argus_backend_conn_t raw_conn,
 
     TGetColumnsResp *resp = g_object_new(TYPE_T_GET_COLUMNS_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_columns(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -327,8 +335,10 @@ int impala_get_type_info(argus_backend_conn_t raw_conn,
 
     TGetTypeInfoResp *resp = g_object_new(TYPE_T_GET_TYPE_INFO_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_type_info(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -389,8 +399,10 @@ int impala_get_schemas(argus_backend_conn_t raw_conn,
 
     TGetSchemasResp *resp = g_object_new(TYPE_T_GET_SCHEMAS_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_schemas(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -453,8 +465,10 @@ int impala_get_primary_keys(argus_backend_conn_t raw_conn,
 
     TGetPrimaryKeysResp *resp = g_object_new(TYPE_T_GET_PRIMARY_KEYS_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_primary_keys(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -508,8 +522,10 @@ int impala_get_catalogs(argus_backend_conn_t raw_conn,
 
     TGetCatalogsResp *resp = g_object_new(TYPE_T_GET_CATALOGS_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_catalogs(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -1,35 +1,45 @@
 #include "impala_internal.h"
+#include "argus/cancel.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
-/* Defined below; used by impala_execute to drain DML operations. */
-int impala_get_operation_status(argus_backend_conn_t raw_conn,
-                                argus_backend_op_t raw_op, bool *finished);
+/* Defined below; impala_execute waits for the runAsync operation. */
+static int impala_wait_for_completion(impala_conn_t *conn,
+                                      impala_operation_t *op);
+static int impala_poll_status(void *raw_conn, void *raw_op,
+                              argus_poll_state_t *state,
+                              argus_progress_t *progress);
+static int impala_completed(impala_conn_t *conn, impala_operation_t *op,
+                            int rc, argus_poll_state_t state);
+void impala_close_operation(argus_backend_conn_t raw_conn,
+                            argus_backend_op_t raw_op);
 
 /* ── Create/free operation handles ────────────────────────────── */
 
 impala_operation_t *impala_operation_new(void)
 {
     impala_operation_t *op = calloc(1, sizeof(impala_operation_t));
+    if (op) argus_poll_init(&op->poll);
     return op;
 }
 
 void impala_operation_free(impala_operation_t *op)
 {
     if (!op) return;
+    argus_prefetch_discard(&op->prefetch);
     if (op->op_handle) g_object_unref(op->op_handle);
     free(op->columns);
+    argus_poll_clear(&op->poll);
     free(op);
 }
 
 /* ── Execute a statement via TCLIService ─────────────────────── */
 
-int impala_execute(argus_backend_conn_t raw_conn,
-                   const char *query,
-                   argus_backend_op_t *out_op)
+/* ExecuteStatement with runAsync: returns once the server has the query */
+static int impala_submit_statement(impala_conn_t *conn, const char *query,
+                                   impala_operation_t **out_op)
 {
-    impala_conn_t *conn = (impala_conn_t *)raw_conn;
     if (!conn || !conn->client || !query) return -1;
 
     conn->last_error[0] = '\0';
@@ -41,14 +51,16 @@ int impala_execute(argus_backend_conn_t raw_conn,
     g_object_set(req,
                  "sessionHandle", conn->session_handle,
                  "statement", query,
-                 "runAsync", FALSE,
+                 "runAsync", TRUE,
                  NULL);
 
     TExecuteStatementResp *resp = g_object_new(
         TYPE_T_EXECUTE_STATEMENT_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_execute_statement(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -93,56 +105,113 @@ int impala_execute(argus_backend_conn_t raw_conn,
     g_object_unref(req);
     g_object_unref(resp);
 
-    /* Impala's ExecuteStatement returns as soon as the query is submitted,
-     * even with runAsync=false. For a SELECT the fetch loop later drives the
-     * operation to completion, but a DML/DDL statement is never fetched, so
-     * without waiting here the INSERT/UPDATE/DELETE is abandoned when the
-     * statement is closed and no rows are written — a silent data loss.
-     * Drive the operation to a terminal state now. (Hive's ExecuteStatement
-     * already blocks until completion, which is why only Impala lost DML.) */
     if (op->op_handle) {
-        conn->last_error[0] = '\0';
-        bool finished = false;
-        /* Safety cap: ~10 min at 20 ms/poll, so a stuck operation cannot
-         * hang the caller forever. */
-        for (int i = 0; !finished && i < 30000; i++) {
-            if (impala_get_operation_status(conn, op, &finished) != 0)
-                break;   /* status RPC failed; let the caller proceed */
-            if (!finished)
-                g_usleep(20000);   /* 20 ms */
-        }
-        if (conn->last_error[0]) {
-            /* The operation reached ERROR_STATE (message already captured). */
-            impala_operation_free(op);
-            return -1;
-        }
+        gboolean has_rows = FALSE;
+        g_object_get(op->op_handle, "hasResultSet", &has_rows, NULL);
+        op->rows_expected = has_rows;
+    }
+
+    *out_op = op;
+    return 0;
+}
+
+int impala_execute(argus_backend_conn_t raw_conn,
+                   const char *query,
+                   argus_backend_op_t *out_op)
+{
+    impala_conn_t *conn = (impala_conn_t *)raw_conn;
+    impala_operation_t *op = NULL;
+    if (impala_submit_statement(conn, query, &op) != 0) return -1;
+
+    /* Every statement, DML and DDL included, is driven to a terminal state
+     * here: one that is never fetched would otherwise be abandoned when the
+     * statement is closed, and an INSERT would silently write nothing. */
+    if (op->op_handle && impala_wait_for_completion(conn, op) != 0) {
+        impala_close_operation(conn, op);
+        return -1;
     }
 
     *out_op = op;
     return 0;
 }
 
+/* backend.h submit/poll (see hive_submit): impala_poll drives the statement
+ * to the same terminal state impala_execute waits for */
+int impala_submit(argus_backend_conn_t raw_conn,
+                  const char *query,
+                  argus_backend_op_t *out_op)
+{
+    impala_conn_t *conn = (impala_conn_t *)raw_conn;
+    impala_operation_t *op = NULL;
+    if (impala_submit_statement(conn, query, &op) != 0) return -1;
+
+    argus_poll_start(&op->poll);
+    *out_op = op;
+    return 0;
+}
+
+int impala_poll(argus_backend_conn_t raw_conn,
+                argus_backend_op_t raw_op,
+                bool *finished, int *next_ms)
+{
+    impala_conn_t *conn = (impala_conn_t *)raw_conn;
+    impala_operation_t *op = (impala_operation_t *)raw_op;
+    if (!conn || !op) return -1;
+
+    *finished = true;
+    if (!op->op_handle) return 0;
+
+    argus_poll_state_t state = ARGUS_POLL_RUNNING;
+    int rc = argus_poll_step(&op->poll, impala_poll_status, conn, op,
+                             conn->query_timeout_sec, &state, next_ms);
+    if (rc == 0 && state == ARGUS_POLL_RUNNING) {
+        *finished = false;
+        return 0;
+    }
+    return impala_completed(conn, op, rc, state);
+}
+
 /* ── Get operation status ─────────────────────────────────────── */
 
-int impala_get_operation_status(argus_backend_conn_t raw_conn,
-                                 argus_backend_op_t raw_op,
-                                 bool *finished)
+static const char *state_name(TOperationState state)
+{
+    switch (state) {
+    case T_OPERATION_STATE_INITIALIZED_STATE: return "INITIALIZED";
+    case T_OPERATION_STATE_RUNNING_STATE:     return "RUNNING";
+    case T_OPERATION_STATE_FINISHED_STATE:    return "FINISHED";
+    case T_OPERATION_STATE_CANCELED_STATE:    return "CANCELED";
+    case T_OPERATION_STATE_CLOSED_STATE:      return "CLOSED";
+    case T_OPERATION_STATE_ERROR_STATE:       return "ERROR";
+    case T_OPERATION_STATE_PENDING_STATE:     return "PENDING";
+    case T_OPERATION_STATE_TIMEDOUT_STATE:    return "TIMEDOUT";
+    default:                                  return "UNKNOWN";
+    }
+}
+
+/* One GetOperationStatus round trip (an argus_poll_fn) */
+static int impala_poll_status(void *raw_conn, void *raw_op,
+                              argus_poll_state_t *state,
+                              argus_progress_t *progress)
 {
     impala_conn_t *conn = (impala_conn_t *)raw_conn;
     impala_operation_t *op = (impala_operation_t *)raw_op;
-    if (!conn || !op || !op->op_handle) return -1;
 
     GError *error = NULL;
 
     TGetOperationStatusReq *req = g_object_new(
         TYPE_T_GET_OPERATION_STATUS_REQ, NULL);
-    g_object_set(req, "operationHandle", op->op_handle, NULL);
+    g_object_set(req,
+                 "operationHandle", op->op_handle,
+                 "getProgressUpdate", TRUE,
+                 NULL);
 
     TGetOperationStatusResp *resp = g_object_new(
         TYPE_T_GET_OPERATION_STATUS_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_get_operation_status(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -154,10 +223,31 @@ int impala_get_operation_status(argus_backend_conn_t raw_conn,
     TOperationState op_state;
     g_object_get(resp, "operationState", &op_state, NULL);
 
-    *finished = (op_state == T_OPERATION_STATE_FINISHED_STATE ||
-                 op_state == T_OPERATION_STATE_ERROR_STATE ||
-                 op_state == T_OPERATION_STATE_CANCELED_STATE ||
-                 op_state == T_OPERATION_STATE_CLOSED_STATE);
+    switch (op_state) {
+    case T_OPERATION_STATE_FINISHED_STATE:
+        *state = ARGUS_POLL_FINISHED;
+        break;
+    case T_OPERATION_STATE_ERROR_STATE:
+        *state = ARGUS_POLL_FAILED;
+        break;
+    case T_OPERATION_STATE_CANCELED_STATE:
+    case T_OPERATION_STATE_CLOSED_STATE:
+    case T_OPERATION_STATE_TIMEDOUT_STATE:
+        *state = ARGUS_POLL_CANCELLED;
+        break;
+    default:
+        *state = ARGUS_POLL_RUNNING;
+        break;
+    }
+    g_strlcpy(progress->state, state_name(op_state), sizeof(progress->state));
+
+    if (resp->__isset_progressUpdateResponse && resp->progressUpdateResponse)
+        progress->percent =
+            resp->progressUpdateResponse->progressedPercentage * 100.0;
+    if (resp->__isset_numModifiedRows)
+        progress->rows_processed = resp->numModifiedRows;
+    if (resp->__isset_hasResultSet)
+        op->rows_expected = resp->hasResultSet;
 
     if (op_state == T_OPERATION_STATE_ERROR_STATE) {
         char *emsg = NULL;
@@ -174,6 +264,93 @@ int impala_get_operation_status(argus_backend_conn_t raw_conn,
     return 0;
 }
 
+int impala_get_operation_status(argus_backend_conn_t raw_conn,
+                                 argus_backend_op_t raw_op,
+                                 bool *finished)
+{
+    impala_conn_t *conn = (impala_conn_t *)raw_conn;
+    impala_operation_t *op = (impala_operation_t *)raw_op;
+    if (!conn || !op || !op->op_handle) return -1;
+
+    argus_poll_state_t state = ARGUS_POLL_RUNNING;
+    argus_progress_t progress;
+    memset(&progress, 0, sizeof(progress));
+    if (impala_poll_status(conn, op, &state, &progress) != 0) return -1;
+    *finished = (state != ARGUS_POLL_RUNNING);
+    return 0;
+}
+
+/*
+ * Map how polling ended to a result (see hive_completed): a finished
+ * query's metadata and first batch are requested at once.
+ */
+static int impala_completed(impala_conn_t *conn, impala_operation_t *op,
+                            int rc, argus_poll_state_t state)
+{
+    if (rc < 0) {
+        if (!conn->last_error[0])
+            g_strlcpy(conn->last_error,
+                      "Lost track of the query: GetOperationStatus failed",
+                      sizeof(conn->last_error));
+        return -1;
+    }
+    if (rc > 0) {
+        impala_cancel(conn, op);
+        snprintf(conn->last_error, sizeof(conn->last_error),
+                 "Query timed out after %d s", conn->query_timeout_sec);
+        return -1;
+    }
+    switch (state) {
+    case ARGUS_POLL_FINISHED:
+        break;
+    case ARGUS_POLL_FAILED:
+        if (!conn->last_error[0])
+            g_strlcpy(conn->last_error, "Query failed",
+                      sizeof(conn->last_error));
+        return -1;
+    default:
+        /* Stopped by the statement's own cancel rather than the server:
+         * the operation is still running there */
+        if (argus_cancel_requested(argus_cancel_current()))
+            impala_cancel(conn, op);
+        g_strlcpy(conn->last_error, "Query was cancelled",
+                  sizeof(conn->last_error));
+        return -1;
+    }
+
+    if (conn->prefetch && op->rows_expected &&
+        impala_get_result_metadata(conn, op, NULL, NULL) == 0 &&
+        op->num_cols > 0)
+        argus_prefetch_start(&op->prefetch, &conn->prefetches,
+                             impala_fetch_batch, conn, op,
+                             conn->first_batch_rows);
+    return 0;
+}
+
+/*
+ * Drive a runAsync operation to completion (see hive_wait_for_completion):
+ * the RPC lock is free between polls so impala_cancel reaches the server.
+ */
+static int impala_wait_for_completion(impala_conn_t *conn,
+                                      impala_operation_t *op)
+{
+    argus_poll_state_t state = ARGUS_POLL_RUNNING;
+    int rc = argus_poll_run(&op->poll, impala_poll_status, conn, op,
+                            conn->query_timeout_sec, &state);
+    return impala_completed(conn, op, rc, state);
+}
+
+/* ── Progress ─────────────────────────────────────────────────── */
+
+bool impala_get_progress(argus_backend_conn_t raw_conn,
+                         argus_backend_op_t raw_op, argus_progress_t *out)
+{
+    (void)raw_conn;
+    impala_operation_t *op = (impala_operation_t *)raw_op;
+    if (!op || !out) return false;
+    return argus_poll_progress(&op->poll, out);
+}
+
 /* ── Last error message ──────────────────────────────────────── */
 
 bool impala_get_last_error(argus_backend_conn_t raw_conn, char *buf, size_t buflen)
@@ -203,8 +380,10 @@ int impala_cancel(argus_backend_conn_t raw_conn,
     TCancelOperationResp *resp = g_object_new(
         TYPE_T_CANCEL_OPERATION_RESP, NULL);
 
+    g_rec_mutex_lock(&conn->rpc_lock);
     gboolean ok = t_c_l_i_service_client_cancel_operation(
         conn->client, &resp, req, &error);
+    g_rec_mutex_unlock(&conn->rpc_lock);
 
     if (!ok || !resp) {
         if (error) g_error_free(error);
@@ -215,17 +394,19 @@ int impala_cancel(argus_backend_conn_t raw_conn,
 
     g_object_unref(req);
     g_object_unref(resp);
+
+    /* Let a waiting execute see the CANCELED state now */
+    argus_poll_wake(&op->poll);
     return 0;
 }
 
 /* ── Close an operation ───────────────────────────────────────── */
 
-void impala_close_operation(argus_backend_conn_t raw_conn,
-                             argus_backend_op_t raw_op)
+/* The close itself, once no prefetch uses the handle */
+static void impala_close_now(void *raw_conn, void *raw_op)
 {
     impala_conn_t *conn = (impala_conn_t *)raw_conn;
     impala_operation_t *op = (impala_operation_t *)raw_op;
-    if (!conn || !op) return;
 
     if (op->op_handle) {
         GError *error = NULL;
@@ -237,8 +418,10 @@ void impala_close_operation(argus_backend_conn_t raw_conn,
         TCloseOperationResp *resp = g_object_new(
             TYPE_T_CLOSE_OPERATION_RESP, NULL);
 
+        g_rec_mutex_lock(&conn->rpc_lock);
         t_c_l_i_service_client_close_operation(
             conn->client, &resp, req, &error);
+        g_rec_mutex_unlock(&conn->rpc_lock);
 
         if (error) g_error_free(error);
         g_object_unref(req);
@@ -247,3 +430,16 @@ void impala_close_operation(argus_backend_conn_t raw_conn,
 
     impala_operation_free(op);
 }
+
+void impala_close_operation(argus_backend_conn_t raw_conn,
+                             argus_backend_op_t raw_op)
+{
+    impala_conn_t *conn = (impala_conn_t *)raw_conn;
+    impala_operation_t *op = (impala_operation_t *)raw_op;
+    if (!conn || !op) return;
+
+    /* A prefetch still on the wire uses the handle: rather than wait for it
+     * here, the close follows it on its worker (interrupting it would cut
+     * the socket and lose the connection). */
+    argus_prefetch_close(&op->prefetch, false, impala_close_now, conn, op);
+}
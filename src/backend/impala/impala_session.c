@@ -44,6 +44,13 @@ int impala_connect(argus_dbc_t *dbc,
                         "[Argus][Impala] Memory allocation failed", 0);
         return -1;
     }
+    conn->prefetch = dbc->prefetch;
+    conn->first_batch_rows = dbc->fetch_buffer_size > 0
+                             ? dbc->fetch_buffer_size
+                             : ARGUS_DEFAULT_BATCH_SIZE;
+    conn->query_timeout_sec = dbc->query_timeout_sec;
+    g_rec_mutex_init(&conn->rpc_lock);
+    argus_prefetch_group_init(&conn->prefetches);
 
     /* GIO transport: portable TCP/TLS with construction-time timeout */
     if (dbc->ssl_enabled)
@@ -290,6 +297,8 @@ fail:
     if (conn->protocol)  g_object_unref(conn->protocol);
     if (conn->transport) g_object_unref(conn->transport);
     if (conn->socket)    g_object_unref(conn->socket);
+    g_rec_mutex_clear(&conn->rpc_lock);
+    argus_prefetch_group_clear(&conn->prefetches);
     free(conn);
     return -1;
 }
@@ -311,6 +320,10 @@ void impala_disconnect(argus_backend_conn_t raw_conn)
     impala_conn_t *conn = (impala_conn_t *)raw_conn;
     if (!conn) return;
 
+    /* Operations closed while a prefetch was on the wire are closed by it;
+     * let them finish before the session goes */
+    argus_prefetch_group_drain(&conn->prefetches, false);
+
     GError *error = NULL;
 
     /* Close session */
@@ -323,8 +336,10 @@ void impala_disconnect(argus_backend_conn_t raw_conn)
 
         TCloseSessionResp *close_resp = g_object_new(
             TYPE_T_CLOSE_SESSION_RESP, NULL);
+        g_rec_mutex_lock(&conn->rpc_lock);
         t_c_l_i_service_client_close_session(
             conn->client, &close_resp, close_req, &error);
+        g_rec_mutex_unlock(&conn->rpc_lock);
 
         if (error) g_error_free(error);
         g_object_unref(close_req);
@@ -340,5 +355,7 @@ void impala_disconnect(argus_backend_conn_t raw_conn)
     g_object_unref(conn->transport);
     g_object_unref(conn->socket);
     free(conn->database);
+    g_rec_mutex_clear(&conn->rpc_lock);
+    argus_prefetch_group_clear(&conn->prefetches);
     free(conn);
 }
@@ -1,45 +1,56 @@
 #include "mywire_internal.h"
+#include "argus/cancel.h"
 #include "argus/compat.h"
 #include "argus/error.h"
+#include "argus/log.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
 /* ── Connection lifecycle ────────────────────────────────────── */
 
-static int mywire_connect(argus_dbc_t *dbc,
-                          const char *host, int port,
-                          const char *username, const char *password,
-                          const char *database,
-                          const char *auth_mechanism,
-                          argus_backend_conn_t *out_conn)
+static char *dup_or_null(const char *s)
 {
-    (void)auth_mechanism;
-    if (!out_conn) return -1;
+    return s ? strdup(s) : NULL;
+}
 
-    mywire_conn_t *conn = calloc(1, sizeof(*conn));
-    if (!conn) return -1;
+static void mywire_conn_free(mywire_conn_t *conn)
+{
+    if (conn->mysql) mysql_close(conn->mysql);
+    free(conn->database);
+    free(conn->host);
+    free(conn->username);
+    free(conn->password);
+    free(conn->ssl_key_file);
+    free(conn->ssl_cert_file);
+    free(conn->ssl_ca_file);
+    free(conn);
+}
 
-    conn->mysql = mysql_init(NULL);
-    if (!conn->mysql) {
-        free(conn);
-        return -1;
-    }
+/* Open a connection to conn's server; with `bulk`, one that may run
+ * conn's bulk loads. On failure the handle is returned unconnected, for the
+ * caller to read mysql_error() from and close. */
+static MYSQL *mywire_open(mywire_conn_t *conn, const char *database,
+                          bool bulk, bool *connected)
+{
+    *connected = false;
+    MYSQL *mysql = mysql_init(NULL);
+    if (!mysql) return NULL;
 
     /* Full Unicode over the wire. */
-    mysql_options(conn->mysql, MYSQL_SET_CHARSET_NAME, "utf8mb4");
+    mysql_options(mysql, MYSQL_SET_CHARSET_NAME, "utf8mb4");
 
     /* Always use TCP: an ODBC HOST means a network host, even when it is
      * "localhost" (libmariadb would otherwise default to a local unix socket,
      * which does not exist when the server is remote or in a container). */
     {
         unsigned int proto = MYSQL_PROTOCOL_TCP;
-        mysql_options(conn->mysql, MYSQL_OPT_PROTOCOL, &proto);
+        mysql_options(mysql, MYSQL_OPT_PROTOCOL, &proto);
     }
 
-    if (dbc && dbc->connect_timeout_sec > 0) {
-        unsigned int t = (unsigned int)dbc->connect_timeout_sec;
-        mysql_options(conn->mysql, MYSQL_OPT_CONNECT_TIMEOUT, &t);
+    if (conn->connect_timeout_sec > 0) {
+        unsigned int t = conn->connect_timeout_sec;
+        mysql_options(mysql, MYSQL_OPT_CONNECT_TIMEOUT, &t);
     }
 
     /* SSL/TLS, driven by the same DBC attributes as the other backends.
@@ -51,36 +62,73 @@ static int mywire_connect(argus_dbc_t *dbc,
      * verification is also turned off, so a plaintext handshake still fails
      * with "SSL is required, but the server does not support it". Clear both. */
     {
-        my_bool enforce = (dbc && dbc->ssl_enabled) ? 1 : 0;
+        my_bool enforce = conn->ssl_enabled ? 1 : 0;
         my_bool verify = 0;
-        if (dbc && dbc->ssl_enabled) {
-            mysql_ssl_set(conn->mysql,
-                          dbc->ssl_key_file, dbc->ssl_cert_file,
-                          dbc->ssl_ca_file, NULL, NULL);
-            verify = dbc->ssl_verify ? 1 : 0;
+        if (conn->ssl_enabled) {
+            mysql_ssl_set(mysql,
+                          conn->ssl_key_file, conn->ssl_cert_file,
+                          conn->ssl_ca_file, NULL, NULL);
+            verify = conn->ssl_verify ? 1 : 0;
         }
-        mysql_options(conn->mysql, MYSQL_OPT_SSL_VERIFY_SERVER_CERT, &verify);
-        mysql_options(conn->mysql, MYSQL_OPT_SSL_ENFORCE, &enforce);
+        mysql_options(mysql, MYSQL_OPT_SSL_VERIFY_SERVER_CERT, &verify);
+        mysql_options(mysql, MYSQL_OPT_SSL_ENFORCE, &enforce);
+    }
+
+    if (bulk && conn->bulk_load)
+        mywire_bulk_enable(mysql, conn);
+
+    *connected = mysql_real_connect(mysql, conn->host, conn->username,
+                                    conn->password,
+                                    (database && *database) ? database : NULL,
+                                    conn->port, NULL, 0) != NULL;
+    return mysql;
+}
+
+static int mywire_connect(argus_dbc_t *dbc,
+                          const char *host, int port,
+                          const char *username, const char *password,
+                          const char *database,
+                          const char *auth_mechanism,
+                          argus_backend_conn_t *out_conn)
+{
+    (void)auth_mechanism;
+    if (!out_conn) return -1;
+
+    mywire_conn_t *conn = calloc(1, sizeof(*conn));
+    if (!conn) return -1;
+
+    conn->host = dup_or_null(host);
+    conn->port = (port > 0) ? (unsigned int)port : 3306;
+    conn->username = dup_or_null(username);
+    conn->password = dup_or_null(password);
+    if (dbc && dbc->connect_timeout_sec > 0)
+        conn->connect_timeout_sec = (unsigned int)dbc->connect_timeout_sec;
+    if (dbc && dbc->ssl_enabled) {
+        conn->ssl_enabled = true;
+        conn->ssl_verify = dbc->ssl_verify;
+        conn->ssl_key_file = dup_or_null(dbc->ssl_key_file);
+        conn->ssl_cert_file = dup_or_null(dbc->ssl_cert_file);
+        conn->ssl_ca_file = dup_or_null(dbc->ssl_ca_file);
     }
+    conn->bulk_load = dbc && dbc->bulk_load;
 
-    unsigned int p = (port > 0) ? (unsigned int)port : 3306;
-    if (!mysql_real_connect(conn->mysql, host, username, password,
-                            (database && *database) ? database : NULL,
-                            p, NULL, 0)) {
+    bool connected = false;
+    conn->mysql = mywire_open(conn, database, true, &connected);
+    if (!connected) {
         /* Surface the real driver error (auth failed, TLS required, unknown
          * database, ...) before the handle is closed. */
-        if (dbc) {
+        if (dbc && conn->mysql) {
             const char *e = mysql_error(conn->mysql);
             char msg[512];
             snprintf(msg, sizeof(msg), "[Argus][MySQL-wire] %s",
                      (e && *e) ? e : "connection failed");
             argus_set_error(&dbc->diag, "08001", msg, 0);
         }
-        mysql_close(conn->mysql);
-        free(conn);
+        mywire_conn_free(conn);
         return -1;
     }
 
+    conn->thread_id = mysql_thread_id(conn->mysql);
     if (database && *database) conn->database = strdup(database);
     *out_conn = conn;
     return 0;
@@ -90,9 +138,7 @@ static void mywire_disconnect(argus_backend_conn_t raw_conn)
 {
     mywire_conn_t *conn = (mywire_conn_t *)raw_conn;
     if (!conn) return;
-    if (conn->mysql) mysql_close(conn->mysql);
-    free(conn->database);
-    free(conn);
+    mywire_conn_free(conn);
 }
 
 static bool mywire_is_alive(argus_backend_conn_t raw_conn)
@@ -104,6 +150,28 @@ static bool mywire_is_alive(argus_backend_conn_t raw_conn)
 
 /* ── Query execution ─────────────────────────────────────────── */
 
+/* Abort action for a statement blocked in mywire_execute, run on the
+ * cancelling thread: KILL QUERY on a short-lived second connection, since
+ * the statement's own connection is busy until the server answers. The
+ * blocked call then fails with ER_QUERY_INTERRUPTED. */
+void mywire_kill_query(void *data)
+{
+    mywire_conn_t *conn = (mywire_conn_t *)data;
+    bool connected = false;
+    MYSQL *side = mywire_open(conn, NULL, false, &connected);
+    if (!side) return;
+    if (connected) {
+        char sql[48];
+        snprintf(sql, sizeof(sql), "KILL QUERY %lu", conn->thread_id);
+        if (mysql_real_query(side, sql, (unsigned long)strlen(sql)) != 0)
+            ARGUS_LOG_WARN("MySQL-wire: %s failed: %s", sql, mysql_error(side));
+    } else {
+        ARGUS_LOG_WARN("MySQL-wire: cannot connect to cancel the query: %s",
+                       mysql_error(side));
+    }
+    mysql_close(side);
+}
+
 int mywire_execute(argus_backend_conn_t raw_conn,
                    const char *query,
                    argus_backend_op_t *out_op)
@@ -111,21 +179,32 @@ int mywire_execute(argus_backend_conn_t raw_conn,
     mywire_conn_t *conn = (mywire_conn_t *)raw_conn;
     if (!conn || !conn->mysql || !query || !out_op) return -1;
 
-    if (mysql_real_query(conn->mysql, query, (unsigned long)strlen(query)) != 0)
-        return -1;
-
     mywire_op_t *op = calloc(1, sizeof(*op));
     if (!op) return -1;
+    conn->last_error[0] = '\0';
 
-    /* Buffer the whole result set when the statement produced one. */
-    if (mysql_field_count(conn->mysql) > 0) {
+    /* Both calls block on the socket: SQLCancel reaches the server through
+     * a second connection instead */
+    argus_cancel_t *cancel = argus_cancel_current();
+    if (!argus_cancel_push(cancel, mywire_kill_query, conn)) {
+        free(op);
+        return -1;
+    }
+
+    int rc = 0;
+    if (mysql_real_query(conn->mysql, query, (unsigned long)strlen(query)) != 0) {
+        rc = -1;
+    } else if (mysql_field_count(conn->mysql) > 0) {
+        /* Buffer the whole result set when the statement produced one. */
         op->result = mysql_store_result(conn->mysql);
-        if (!op->result) {
-            free(op);
-            return -1;
-        }
+        if (!op->result) rc = -1;
     }
+    argus_cancel_pop(cancel);
 
+    if (rc != 0) {
+        free(op);
+        return -1;
+    }
     *out_op = op;
     return 0;
 }
@@ -155,7 +234,8 @@ static int mywire_cancel(argus_backend_conn_t conn, argus_backend_op_t op)
 {
     (void)conn;
     (void)op;
-    /* Results are fetched synchronously; there is nothing to cancel. */
+    /* Results are buffered by the time an operation exists; a statement
+     * still running is cancelled by mywire_kill_query. */
     return 0;
 }
 
@@ -318,7 +398,8 @@ static bool mywire_get_last_error(argus_backend_conn_t raw_conn,
 {
     mywire_conn_t *conn = (mywire_conn_t *)raw_conn;
     if (!conn || !conn->mysql || buflen == 0) return false;
-    const char *e = mysql_error(conn->mysql);
+    const char *e = conn->last_error[0] ? conn->last_error
+                                        : mysql_error(conn->mysql);
     if (!e || !*e) return false;
     strncpy(buf, e, buflen - 1);
     buf[buflen - 1] = '\0';
@@ -362,6 +443,7 @@ static const argus_backend_t mywire_backend = {
     .get_primary_keys      = mywire_get_primary_keys,
     .get_last_error        = mywire_get_last_error,
     .get_server_version    = mywire_get_server_version,
+    .bulk_insert           = mywire_bulk_insert,
 };
 
 const argus_backend_t *argus_mysql_backend_get(void)
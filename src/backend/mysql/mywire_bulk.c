@@ -0,0 +1,332 @@
+/*
+ * MySQL-wire bulk insert: LOAD DATA LOCAL INFILE fed from memory.
+ *
+ * With BulkLoad=1, SQLBulkOperations(SQL_ADD) and INSERT parameter arrays
+ * (src/odbc/bulk.c) reach mywire_bulk_insert, which sends all the rows in one
+ * LOAD DATA LOCAL INFILE statement instead of INSERT ... VALUES text. The
+ * "file" is a stream: once the server asks for it, a producer thread writes
+ * the rows as tab-separated text into a short bounded queue of chunks, and
+ * the client library's read callback hands them to the server. Formatting
+ * overlaps the network, and a slow server holds the producer back after
+ * MYWIRE_LOAD_QUEUE_DEPTH chunks rather than the whole load piling up.
+ *
+ * LOCAL INFILE lets the server name a client file to read, so the
+ * connection installs its own handler for every LOAD DATA LOCAL request: it
+ * serves the in-memory stream while mywire_bulk_insert runs and refuses any
+ * other request, and libmariadb's default handler, which opens files, is
+ * never used.
+ *
+ * The server must allow it (local_infile=ON on MySQL; on by default on
+ * MariaDB; Doris 2.0+ "MySQL Load"). The text is UTF-8 and says so with
+ * CHARACTER SET utf8mb4; servers whose grammar has no such clause (Doris)
+ * reject it as a syntax error and get the statement again without it.
+ */
+
+#include "mywire_internal.h"
+#include "argus/cancel.h"
+#include "argus/log.h"
+#include <errmsg.h>
+#include <mysqld_error.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+/* ── Producer ────────────────────────────────────────────────── */
+
+/* Queue a chunk, waiting while MYWIRE_LOAD_QUEUE_DEPTH are unread. False
+ * (the chunk freed) once the reader is gone. */
+static bool load_push(mywire_load_t *load, GByteArray *chunk)
+{
+    g_mutex_lock(&load->lock);
+    while (!load->abandoned &&
+           g_queue_get_length(&load->chunks) >= MYWIRE_LOAD_QUEUE_DEPTH)
+        g_cond_wait(&load->cond, &load->lock);
+    bool ok = !load->abandoned;
+    if (ok) {
+        g_queue_push_tail(&load->chunks, chunk);
+        g_cond_broadcast(&load->cond);
+    }
+    g_mutex_unlock(&load->lock);
+    if (!ok && chunk) g_byte_array_free(chunk, TRUE);
+    return ok;
+}
+
+/* One field in LOAD DATA's default format: backslash escapes for the
+ * separators, the escape itself and NUL; \N for NULL */
+void mywire_load_field(GByteArray *out, const argus_cell_t *cell)
+{
+    if (cell->is_null) {
+        g_byte_array_append(out, (const guint8 *)"\\N", 2);
+        return;
+    }
+    if (!cell->data && cell->native_kind != ARGUS_NATIVE_NONE) {
+        char buf[G_ASCII_DTOSTR_BUF_SIZE];
+        if (cell->native_kind == ARGUS_NATIVE_I64)
+            snprintf(buf, sizeof(buf), "%" G_GINT64_FORMAT, cell->native.i64);
+        else
+            g_ascii_dtostr(buf, sizeof(buf), cell->native.f64);
+        g_byte_array_append(out, (const guint8 *)buf, (guint)strlen(buf));
+        return;
+    }
+
+    const char *s = cell->data ? cell->data : "";
+    size_t start = 0;
+    for (size_t i = 0; i < cell->data_len; i++) {
+        const char *esc;
+        switch (s[i]) {
+        case '\\': esc = "\\\\"; break;
+        case '\t': esc = "\\t"; break;
+        case '\n': esc = "\\n"; break;
+        case '\r': esc = "\\r"; break;
+        case '\0': esc = "\\0"; break;
+        default: continue;
+        }
+        g_byte_array_append(out, (const guint8 *)s + start,
+                            (guint)(i - start));
+        g_byte_array_append(out, (const guint8 *)esc, 2);
+        start = i + 1;
+    }
+    g_byte_array_append(out, (const guint8 *)s + start,
+                        (guint)(cell->data_len - start));
+}
+
+static gpointer load_produce(gpointer data)
+{
+    mywire_load_t *load = (mywire_load_t *)data;
+    GByteArray *chunk = g_byte_array_sized_new(MYWIRE_LOAD_CHUNK + 1024);
+
+    for (size_t r = 0; r < load->rows->nrows; r++) {
+        const argus_cell_t *cells = load->rows->get(load->rows->ctx, r);
+        if (!cells) {
+            load->row_ok[r] = false;
+            continue;
+        }
+        for (int c = 0; c < load->ncols; c++) {
+            if (c > 0) g_byte_array_append(chunk, (const guint8 *)"\t", 1);
+            mywire_load_field(chunk, &cells[c]);
+        }
+        g_byte_array_append(chunk, (const guint8 *)"\n", 1);
+        if (chunk->len >= MYWIRE_LOAD_CHUNK) {
+            if (!load_push(load, chunk)) return NULL;
+            chunk = g_byte_array_sized_new(MYWIRE_LOAD_CHUNK + 1024);
+        }
+    }
+    if (chunk->len == 0)
+        g_byte_array_free(chunk, TRUE);
+    else if (!load_push(load, chunk))
+        return NULL;
+    load_push(load, NULL);
+    return NULL;
+}
+
+/* ── LOCAL INFILE handler ────────────────────────────────────── */
+
+int mywire_load_init(void **ptr, const char *filename, void *userdata)
+{
+    mywire_conn_t *conn = (mywire_conn_t *)userdata;
+    mywire_load_t *load = conn ? conn->load : NULL;
+    *ptr = load;
+
+    /* Only the stream of a load in progress, and only once */
+    if (!load || load->producer || strcmp(filename, MYWIRE_LOAD_FILE) != 0) {
+        ARGUS_LOG_WARN("MySQL-wire: refused the server's request for local "
+                       "file '%s'", filename);
+        *ptr = NULL;
+        return 1;
+    }
+
+    GError *err = NULL;
+    load->producer = g_thread_try_new("argus-bulk-load", load_produce, load,
+                                      &err);
+    if (!load->producer) {
+        ARGUS_LOG_ERROR("MySQL-wire: cannot start the bulk load thread: %s",
+                        err ? err->message : "unknown error");
+        g_clear_error(&err);
+        *ptr = NULL;
+        return 1;
+    }
+    return 0;
+}
+
+int mywire_load_read(void *ptr, char *buf, unsigned int buf_len)
+{
+    mywire_load_t *load = (mywire_load_t *)ptr;
+    if (!load) return -1;
+
+    while (!load->reading && !load->finished) {
+        g_mutex_lock(&load->lock);
+        while (g_queue_is_empty(&load->chunks))
+            g_cond_wait(&load->cond, &load->lock);
+        load->reading = g_queue_pop_head(&load->chunks);
+        g_cond_broadcast(&load->cond);
+        g_mutex_unlock(&load->lock);
+        load->offset = 0;
+        if (!load->reading) load->finished = true;
+    }
+    if (load->finished) return 0;
+
+    size_t n = load->reading->len - load->offset;
+    if (n > buf_len) n = buf_len;
+    memcpy(buf, load->reading->data + load->offset, n);
+    load->offset += n;
+    if (load->offset == load->reading->len) {
+        g_byte_array_free(load->reading, TRUE);
+        load->reading = NULL;
+    }
+    return (int)n;
+}
+
+/* The server stopped reading, done or not: release the producer */
+void mywire_load_end(void *ptr)
+{
+    mywire_load_t *load = (mywire_load_t *)ptr;
+    if (!load) return;
+    g_mutex_lock(&load->lock);
+    load->abandoned = true;
+    g_cond_broadcast(&load->cond);
+    g_mutex_unlock(&load->lock);
+}
+
+int mywire_load_error(void *ptr, char *buf, unsigned int buf_len)
+{
+    snprintf(buf, buf_len, "%s",
+             ptr ? "Bulk load stream failed"
+                 : "LOCAL INFILE request refused by the client");
+    return CR_UNKNOWN_ERROR;
+}
+
+void mywire_bulk_enable(MYSQL *mysql, mywire_conn_t *conn)
+{
+    unsigned int on = 1;
+    mysql_options(mysql, MYSQL_OPT_LOCAL_INFILE, &on);
+    mysql_set_local_infile_handler(mysql, mywire_load_init, mywire_load_read,
+                                   mywire_load_end, mywire_load_error, conn);
+}
+
+/* ── Bulk insert ─────────────────────────────────────────────── */
+
+char *mywire_load_statement(const char *table,
+                            const argus_column_desc_t *columns, int ncols,
+                            bool charset)
+{
+    GString *sql = g_string_new(NULL);
+    g_string_printf(sql, "LOAD DATA LOCAL INFILE '" MYWIRE_LOAD_FILE "' "
+                    "INTO TABLE %s%s COLUMNS TERMINATED BY '\\t' "
+                    "LINES TERMINATED BY '\\n'",
+                    table, charset ? " CHARACTER SET utf8mb4" : "");
+    if (ncols > 0 && columns[0].name[0]) {
+        for (int c = 0; c < ncols; c++) {
+            g_string_append(sql, c > 0 ? ", `" : " (`");
+            for (const char *p = (const char *)columns[c].name; *p; p++) {
+                if (*p == '`') g_string_append_c(sql, '`');
+                g_string_append_c(sql, *p);
+            }
+            g_string_append_c(sql, '`');
+        }
+        g_string_append_c(sql, ')');
+    }
+    return g_string_free(sql, FALSE);
+}
+
+void mywire_load_begin(mywire_load_t *load)
+{
+    g_mutex_init(&load->lock);
+    g_cond_init(&load->cond);
+    g_queue_init(&load->chunks);
+    load->producer = NULL;
+    load->abandoned = false;
+    load->reading = NULL;
+    load->offset = 0;
+    load->finished = false;
+}
+
+bool mywire_load_finish(mywire_load_t *load)
+{
+    bool started = load->producer != NULL;
+    if (load->producer) {
+        mywire_load_end(load);
+        g_thread_join(load->producer);
+        load->producer = NULL;
+    }
+    if (load->reading) g_byte_array_free(load->reading, TRUE);
+    load->reading = NULL;
+    GByteArray *chunk;
+    while (!g_queue_is_empty(&load->chunks))
+        if ((chunk = g_queue_pop_head(&load->chunks)) != NULL)
+            g_byte_array_free(chunk, TRUE);
+    g_cond_clear(&load->cond);
+    g_mutex_clear(&load->lock);
+    return started;
+}
+
+/* Run one LOAD DATA statement over load's rows. Returns 0, or -1 with the
+ * error on conn->mysql; *asked tells whether the server read the stream. */
+static int load_run(mywire_conn_t *conn, mywire_load_t *load,
+                    const char *sql, bool *asked)
+{
+    mywire_load_begin(load);
+    conn->load = load;
+    int rc = mysql_real_query(conn->mysql, sql,
+                              (unsigned long)strlen(sql)) == 0 ? 0 : -1;
+    conn->load = NULL;
+    *asked = mywire_load_finish(load);
+    return rc;
+}
+
+int mywire_bulk_insert(argus_backend_conn_t raw_conn, const char *table,
+                       const argus_column_desc_t *columns, int ncols,
+                       const argus_bulk_rows_t *rows, bool *row_ok,
+                       size_t *added)
+{
+    mywire_conn_t *conn = (mywire_conn_t *)raw_conn;
+    if (!conn || !conn->mysql || !table) return -1;
+    if (!conn->bulk_load) return 1;
+    if (!rows) return 0;
+    size_t nrows = rows->nrows;
+    if (nrows == 0) return 0;
+    conn->last_error[0] = '\0';
+
+    for (size_t r = 0; r < nrows; r++) row_ok[r] = true;
+    mywire_load_t load = { .rows = rows, .ncols = ncols, .row_ok = row_ok };
+    argus_cancel_t *cancel = argus_cancel_current();
+    if (!argus_cancel_push(cancel, mywire_kill_query, conn)) return -1;
+
+    char *sql = mywire_load_statement(table, columns, ncols, true);
+    bool asked = false;
+    int rc = load_run(conn, &load, sql, &asked);
+    if (rc != 0 && !asked && !argus_cancel_requested(cancel) &&
+        mysql_errno(conn->mysql) == ER_PARSE_ERROR) {
+        /* The grammar has no CHARACTER SET clause: try it without. Any
+         * other failure (no LOCAL INFILE, no such table, no privilege)
+         * would only fail again, so it is reported as it is. */
+        g_free(sql);
+        sql = mywire_load_statement(table, columns, ncols, false);
+        rc = load_run(conn, &load, sql, &asked);
+    }
+    argus_cancel_pop(cancel);
+    g_free(sql);
+
+    *added = 0;
+    if (rc != 0) {
+        for (size_t r = 0; r < nrows; r++) row_ok[r] = false;
+        return -1;
+    }
+
+    /* LOCAL loads skip the rows the server rejects (duplicate keys, bad
+     * values) with a warning each, not an error, and do not say which:
+     * the caller can only tell how many went in */
+    my_ulonglong loaded = mysql_affected_rows(conn->mysql);
+    size_t sent = 0;
+    for (size_t r = 0; r < nrows; r++) sent += row_ok[r];
+    if (loaded == (my_ulonglong)-1 || loaded >= sent) {
+        *added = sent;
+        return 0;
+    }
+    *added = (size_t)loaded;
+    snprintf(conn->last_error, sizeof(conn->last_error),
+             "[Argus][MySQL-wire] LOAD DATA loaded %llu of %lu rows; the "
+             "server skipped the rest (SHOW WARNINGS has the reasons)",
+             (unsigned long long)loaded, (unsigned long)sent);
+    return -1;
+}
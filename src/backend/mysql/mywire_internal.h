@@ -1,6 +1,7 @@
 #ifndef ARGUS_MYWIRE_INTERNAL_H
 #define ARGUS_MYWIRE_INTERNAL_H
 
+#include <glib.h>
 #include <mysql.h>
 #include "argus/backend.h"
 #include "argus/handle.h"
@@ -16,14 +17,65 @@
  *
  * The protocol is synchronous and the text result set is buffered with
  * mysql_store_result(), so the operation model is trivial: every
- * statement is "finished" as soon as execute() returns.
+ * statement is "finished" as soon as execute() returns. A statement is
+ * cancelled while execute() blocks by KILL QUERY on a second connection.
  */
 
+/* A LOAD DATA LOCAL INFILE stream in progress (mywire_bulk.c) */
+typedef struct mywire_load mywire_load_t;
+
+/* Name the statement gives the stream; the only one the handler serves */
+#define MYWIRE_LOAD_FILE "argus-bulk"
+
+/* Bytes of text per chunk, and chunks formatted ahead of the server */
+#define MYWIRE_LOAD_CHUNK       (64 * 1024)
+#define MYWIRE_LOAD_QUEUE_DEPTH 4
+
 typedef struct mywire_conn {
     MYSQL *mysql;
     char  *database;
+
+    /* What mywire_open needs to open a second connection to the same
+     * server, for KILL QUERY (see mywire_kill_query) */
+    char          *host;
+    unsigned int   port;
+    char          *username;
+    char          *password;
+    unsigned int   connect_timeout_sec;
+    bool           ssl_enabled;
+    bool           ssl_verify;
+    char          *ssl_key_file;
+    char          *ssl_cert_file;
+    char          *ssl_ca_file;
+    unsigned long  thread_id;       /* server connection id of `mysql` */
+
+    bool           bulk_load;       /* BulkLoad=1: bulk inserts use LOAD DATA
+                                     * LOCAL INFILE */
+    mywire_load_t *load;            /* the stream the infile handler serves,
+                                     * while mywire_bulk_insert runs */
+    char           last_error[512]; /* driver-side error, ahead of
+                                     * mysql_error() */
 } mywire_conn_t;
 
+struct mywire_load {
+    const argus_bulk_rows_t *rows;      /* asked for by the producer only */
+    int                      ncols;
+    bool                    *row_ok;    /* the producer clears the rows
+                                         * `rows` cannot give */
+
+    GThread                 *producer;
+    GMutex                   lock;
+    GCond                    cond;
+    GQueue                   chunks;    /* GByteArray; NULL ends the
+                                         * stream */
+    bool                     abandoned; /* the reader is gone: stop
+                                         * producing */
+
+    GByteArray              *reading;   /* chunk being read, and how far */
+    size_t                   offset;
+    bool                     finished;  /* end of stream reached */
+};
+
 /* One executed statement plus its (optional) buffered result set. */
 typedef struct mywire_op {
     MYSQL_RES           *result;          /* mysql_store_result(), NULL for DML/DDL */
@@ -39,9 +91,34 @@ SQLULEN     mywire_column_size(SQLSMALLINT sql_type,
                                unsigned long field_length);
 SQLSMALLINT mywire_decimal_digits(SQLSMALLINT sql_type, unsigned int decimals);
 
-/* ── mywire_backend.c (shared by the metadata helpers) ───────── */
+/* ── mywire_backend.c (shared by the metadata and bulk helpers) */
 int mywire_execute(argus_backend_conn_t conn, const char *query,
                    argus_backend_op_t *out_op);
+void mywire_kill_query(void *conn);
+
+/* ── mywire_bulk.c ───────────────────────────────────────────── */
+/* Allow LOAD DATA LOCAL INFILE on `mysql` (before it connects), served only
+ * from conn's bulk load stream */
+void mywire_bulk_enable(MYSQL *mysql, mywire_conn_t *conn);
+int  mywire_bulk_insert(argus_backend_conn_t conn, const char *table,
+                        const argus_column_desc_t *columns, int ncols,
+                        const argus_bulk_rows_t *rows, bool *row_ok,
+                        size_t *added);
+
+/* The pieces of the LOAD DATA stream, exposed for the unit tests: one field
+ * of the text format, the statement, the LOCAL INFILE handler, and setting
+ * up / tearing down a stream around the statement (finish returns whether
+ * the server asked for it) */
+void  mywire_load_field(GByteArray *out, const argus_cell_t *cell);
+char *mywire_load_statement(const char *table,
+                            const argus_column_desc_t *columns, int ncols,
+                            bool charset);
+int   mywire_load_init(void **ptr, const char *filename, void *userdata);
+int   mywire_load_read(void *ptr, char *buf, unsigned int buf_len);
+void  mywire_load_end(void *ptr);
+int   mywire_load_error(void *ptr, char *buf, unsigned int buf_len);
+void  mywire_load_begin(mywire_load_t *load);
+bool  mywire_load_finish(mywire_load_t *load);
 
 /* ── mywire_metadata.c ───────────────────────────────────────── */
 int mywire_get_tables(argus_backend_conn_t conn, const char *catalog,
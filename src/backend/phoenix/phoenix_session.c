@@ -2,44 +2,26 @@
 #include "argus/handle.h"
 #include "argus/error.h"
 #include "argus/log.h"
+#include "../http_client.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
-/* ── Helper: Apply SSL and timeout settings to curl ─────────────── */
+/* ── Helper: per-connection HTTP handle ─────────────────────────── */
 
-static void phoenix_apply_curl_settings(phoenix_conn_t *conn, CURL *curl)
+/* TLS and timeouts are fixed for the life of the connection: apply once. */
+static CURL *phoenix_http_handle_new(phoenix_conn_t *conn)
 {
-    /* SSL/TLS settings */
-    if (conn->ssl_enabled) {
-        if (conn->ssl_verify) {
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
-        } else {
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
-        }
-
-        if (conn->ssl_cert_file) {
-            curl_easy_setopt(curl, CURLOPT_SSLCERT, conn->ssl_cert_file);
-        }
-        if (conn->ssl_key_file) {
-            curl_easy_setopt(curl, CURLOPT_SSLKEY, conn->ssl_key_file);
-        }
-        if (conn->ssl_ca_file) {
-            curl_easy_setopt(curl, CURLOPT_CAINFO, conn->ssl_ca_file);
-        }
-    }
-
-    /* Timeout settings */
-    if (conn->connect_timeout_sec > 0) {
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT,
-                         (long)conn->connect_timeout_sec);
-    }
-    if (conn->query_timeout_sec > 0) {
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT,
-                         (long)conn->query_timeout_sec);
-    }
+    argus_http_opts_t opts = {
+        .tls                 = conn->ssl_enabled,
+        .tls_verify          = conn->ssl_verify,
+        .ca_file             = conn->ssl_ca_file,
+        .cert_file           = conn->ssl_cert_file,
+        .key_file            = conn->ssl_key_file,
+        .connect_timeout_sec = conn->connect_timeout_sec,
+        .timeout_sec         = conn->query_timeout_sec,
+    };
+    return argus_http_handle_new(&opts);
 }
 
 /* ── CURL write callback ─────────────────────────────────────── */
@@ -67,20 +49,18 @@ int phoenix_http_post(phoenix_conn_t *conn, const char *url,
                       const char *body, phoenix_response_t *resp)
 {
     CURL *curl = conn->curl;
+    struct curl_slist *traced =
+        argus_http_trace_headers(conn->default_headers);
 
-    curl_easy_reset(curl);
-    phoenix_apply_curl_settings(conn, curl);
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, conn->default_headers);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, phoenix_curl_write_cb);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, resp);
+    argus_http_prepare(curl, "POST", url, body,
+                       traced ? traced : conn->default_headers,
+                       phoenix_curl_write_cb, resp);
 
     resp->data = NULL;
     resp->size = 0;
 
     CURLcode res = curl_easy_perform(curl);
+    curl_slist_free_all(traced);
     if (res != CURLE_OK)
         return -1;
 
@@ -220,8 +200,8 @@ int phoenix_connect(argus_dbc_t *dbc,
     conn->database = strdup(database && *database ? database : "");
     conn->next_statement_id = 1;
 
-    /* Initialize CURL */
-    conn->curl = curl_easy_init();
+    /* Per-connection HTTP handle on the shared DNS/TLS/connection caches */
+    conn->curl = phoenix_http_handle_new(conn);
     if (!conn->curl) {
         argus_set_error(&dbc->diag, "08001",
                         "[Argus][Phoenix] Failed to initialize HTTP client", 0);
@@ -323,14 +303,15 @@ bool phoenix_is_alive(argus_backend_conn_t raw_conn)
 
     /* Send a lightweight Avatica databaseProperties request */
     CURL *curl = conn->curl;
-    curl_easy_reset(curl);
-    phoenix_apply_curl_settings(conn, curl);
-    curl_easy_setopt(curl, CURLOPT_URL, conn->base_url);
-    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    argus_http_prepare(curl, "HEAD", conn->base_url, NULL,
+                       conn->default_headers, NULL, NULL);
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 5L);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, conn->default_headers);
 
     CURLcode res = curl_easy_perform(curl);
+    /* Back to the connection's own limit (0 = none) */
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT,
+                     conn->query_timeout_sec > 0
+                         ? (long)conn->query_timeout_sec : 0L);
     if (res != CURLE_OK) return false;
 
     long http_code = 0;
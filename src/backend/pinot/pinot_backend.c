@@ -2,6 +2,7 @@
 #include "argus/handle.h"
 #include "argus/log.h"
 #include "argus/compat.h"
+#include "../http_client.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -22,44 +23,39 @@ static size_t write_cb(void *contents, size_t size, size_t nmemb, void *userp)
     return total;
 }
 
-static void apply_curl(pinot_conn_t *conn, CURL *curl)
+/* TLS, timeout and Basic auth are fixed per connection: applied once. */
+static CURL *http_handle_new(pinot_conn_t *conn)
 {
-    if (conn->ssl_enabled) {
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, conn->ssl_verify ? 1L : 0L);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, conn->ssl_verify ? 2L : 0L);
-    }
-    if (conn->connect_timeout_sec > 0)
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT,
-                         (long)conn->connect_timeout_sec);
+    argus_http_opts_t opts = {
+        .tls                 = conn->ssl_enabled,
+        .tls_verify          = conn->ssl_verify,
+        .connect_timeout_sec = conn->connect_timeout_sec,
+    };
     if (conn->user && *conn->user) {
-        char up[512];
-        snprintf(up, sizeof(up), "%s:%s", conn->user,
-                 conn->password ? conn->password : "");
-        curl_easy_setopt(curl, CURLOPT_HTTPAUTH, (long)CURLAUTH_BASIC);
-        curl_easy_setopt(curl, CURLOPT_USERPWD, up);
+        opts.auth     = (long)CURLAUTH_BASIC;
+        opts.user     = conn->user;
+        opts.password = conn->password;
     }
+    return argus_http_handle_new(&opts);
 }
 
 static int http(pinot_conn_t *conn, const char *url, const char *post_body,
                 pinot_response_t *resp)
 {
     CURL *curl = conn->curl;
-    curl_easy_reset(curl);
-    apply_curl(conn, curl);
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    if (post_body) {
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_body);
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, conn->headers);
-    } else {
-        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-    }
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_cb);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, resp);
+    struct curl_slist *base = post_body ? conn->headers : NULL;
+    struct curl_slist *traced = argus_http_trace_headers(base);
+    if (post_body)
+        argus_http_prepare(curl, "POST", url, post_body,
+                           traced ? traced : base, write_cb, resp);
+    else
+        argus_http_prepare(curl, "GET", url, NULL, traced, write_cb, resp);
     resp->data = NULL;
     resp->size = 0;
 
-    if (curl_easy_perform(curl) != CURLE_OK) return -1;
+    CURLcode cc = curl_easy_perform(curl);
+    curl_slist_free_all(traced);
+    if (cc != CURLE_OK) return -1;
     long code = 0;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
     if (code >= 400) return -1;
@@ -81,14 +77,18 @@ static int pinot_connect(argus_dbc_t *dbc,
     pinot_conn_t *conn = calloc(1, sizeof(*conn));
     if (!conn) return -1;
 
-    conn->curl = curl_easy_init();
-    if (!conn->curl) { free(conn); return -1; }
-
     if (dbc) {
         conn->ssl_enabled = dbc->ssl_enabled;
         conn->ssl_verify = dbc->ssl_verify;
         conn->connect_timeout_sec = dbc->connect_timeout_sec;
     }
+    if (username && *username) conn->user = strdup(username);
+    if (password && *password) conn->password = strdup(password);
+    conn->curl = http_handle_new(conn);
+    if (!conn->curl) {
+        free(conn->user); free(conn->password); free(conn);
+        return -1;
+    }
     const char *scheme = conn->ssl_enabled ? "https" : "http";
     int broker_port = port > 0 ? port : 8000;
 
@@ -99,9 +99,6 @@ static int pinot_connect(argus_dbc_t *dbc,
     snprintf(url, sizeof(url), "%s://%s:9000", scheme, host);
     conn->controller_url = strdup(url);
 
-    if (username && *username) conn->user = strdup(username);
-    if (password && *password) conn->password = strdup(password);
-
     conn->headers = curl_slist_append(NULL, "Content-Type: application/json");
     conn->headers = curl_slist_append(conn->headers, "Accept: application/json");
 
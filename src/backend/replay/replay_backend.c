@@ -0,0 +1,484 @@
+/*
+ * BACKEND=replay: answers the backend vtable from a capture file, with no
+ * server. Each connection walks the recorded operations of a key in order
+ * and wraps around, so a workload captured once can be replayed any number
+ * of times. REPLAYLATENCY and REPLAYBANDWIDTH turn the instant answers into
+ * something closer to a network.
+ */
+#include "replay_internal.h"
+#include "argus/handle.h"
+#include "argus/log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct replay_conn {
+    replay_file_t *file;
+    int            latency_ms;          /* per round trip */
+    long           bandwidth_kib;       /* KiB/s, 0 = unlimited */
+    GMutex         lock;                /* cursors and last_error */
+    GHashTable    *cursors;             /* key -> next occurrence to serve */
+    char           last_error[1024];
+} replay_conn_t;
+
+typedef struct replay_stmt_op {
+    const replay_op_t *rec;
+    size_t             next;            /* next row to serve */
+    bool               cancelled;
+    gint64             started;         /* monotonic us */
+    GMutex             lock;            /* progress snapshot */
+    int64_t            bytes;
+    int64_t            wait_us;
+} replay_stmt_op_t;
+
+static void set_error(replay_conn_t *rc, const char *msg)
+{
+    g_mutex_lock(&rc->lock);
+    g_strlcpy(rc->last_error, msg ? msg : "", sizeof(rc->last_error));
+    g_mutex_unlock(&rc->lock);
+}
+
+/* Sleep for one round trip plus the transfer time of `bytes`; returns the
+ * time slept in microseconds. */
+static int64_t simulate_wire(const replay_conn_t *rc, size_t bytes)
+{
+    int64_t us = (int64_t)rc->latency_ms * 1000;
+    if (rc->bandwidth_kib > 0)
+        us += (int64_t)((double)bytes * 1e6 /
+                        ((double)rc->bandwidth_kib * 1024.0));
+    if (us > 0) g_usleep((gulong)us);
+    return us;
+}
+
+static size_t row_bytes(const argus_row_t *row, int num_cols)
+{
+    size_t n = 0;
+    if (!row->cells) return 0;
+    for (int c = 0; c < num_cols; c++) {
+        const argus_cell_t *cell = &row->cells[c];
+        if (cell->data) n += cell->data_len;
+        else if (cell->native_kind != ARGUS_NATIVE_NONE) n += 8;
+    }
+    return n;
+}
+
+/* Serve the next recorded occurrence of (kind, args) */
+static int open_op(replay_conn_t *rc, replay_kind_t kind, int nargs,
+                   const char *const *args, argus_backend_op_t *out_op)
+{
+    char *key = replay_key(kind, nargs, args);
+    GPtrArray *list = g_hash_table_lookup(rc->file->by_key, key);
+    if (!list || list->len == 0) {
+        char msg[512];
+        snprintf(msg, sizeof(msg), "%s%s%s is not in capture file %s",
+                 kind == REPLAY_OP_EXECUTE ? "Query '" : "Catalog call",
+                 kind == REPLAY_OP_EXECUTE && args[0] ? args[0] : "",
+                 kind == REPLAY_OP_EXECUTE ? "'" : "",
+                 rc->file->path);
+        set_error(rc, msg);
+        ARGUS_LOG_WARN("Replay: %s", msg);
+        g_free(key);
+        simulate_wire(rc, 0);
+        return -1;
+    }
+
+    g_mutex_lock(&rc->lock);
+    guint seen = GPOINTER_TO_UINT(g_hash_table_lookup(rc->cursors, key));
+    g_hash_table_replace(rc->cursors, key, GUINT_TO_POINTER(seen + 1));
+    g_mutex_unlock(&rc->lock);
+    const replay_op_t *rec = g_ptr_array_index(list, seen % list->len);
+
+    simulate_wire(rc, 0);
+    if (rec->rc != 0) {
+        set_error(rc, rec->error);
+        return rec->rc;
+    }
+
+    /* The ODBC layer reads get_last_error after a successful execute too
+     * (Trino reports errors late), so a served operation clears it */
+    set_error(rc, NULL);
+    replay_stmt_op_t *op = calloc(1, sizeof(*op));
+    if (!op) return -1;
+    op->rec = rec;
+    op->started = g_get_monotonic_time();
+    g_mutex_init(&op->lock);
+    *out_op = op;
+    return 0;
+}
+
+/* ── Connection lifecycle ────────────────────────────────────── */
+
+static int replay_connect(argus_dbc_t *dbc, const char *host, int port,
+                          const char *username, const char *password,
+                          const char *database, const char *auth_mechanism,
+                          argus_backend_conn_t *out_conn)
+{
+    (void)host; (void)port; (void)username; (void)password;
+    (void)database; (void)auth_mechanism;
+
+    if (!dbc->replay_file || !*dbc->replay_file) {
+        argus_set_error(&dbc->diag, "HY000",
+                        "[Argus] BACKEND=replay needs REPLAYFILE", 0);
+        return -1;
+    }
+
+    char err[512] = "";
+    replay_file_t *file = replay_file_get(dbc->replay_file, err, sizeof(err));
+    if (!file) {
+        char msg[640];
+        snprintf(msg, sizeof(msg), "[Argus] Replay: %s", err);
+        argus_set_error(&dbc->diag, "08001", msg, 0);
+        return -1;
+    }
+    const argus_backend_t *vt = replay_backend_for(file->backend, file->mask);
+    if (!vt) {
+        replay_file_unref(file);
+        return -1;
+    }
+
+    replay_conn_t *rc = calloc(1, sizeof(*rc));
+    if (!rc) {
+        replay_file_unref(file);
+        return -1;
+    }
+    rc->file = file;
+    rc->latency_ms = dbc->replay_latency_ms;
+    rc->bandwidth_kib = dbc->replay_bandwidth_kib;
+    g_mutex_init(&rc->lock);
+    rc->cursors = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+    /* Present the recorded backend, so dialect and SQLGetInfo answers match
+     * the capture rather than a generic "replay". */
+    dbc->backend = vt;
+    simulate_wire(rc, 0);
+    *out_conn = rc;
+    return 0;
+}
+
+static void replay_disconnect(argus_backend_conn_t conn)
+{
+    replay_conn_t *rc = conn;
+    if (!rc) return;
+    g_hash_table_destroy(rc->cursors);
+    g_mutex_clear(&rc->lock);
+    replay_file_unref(rc->file);
+    free(rc);
+}
+
+static bool replay_is_alive(argus_backend_conn_t conn)
+{
+    return conn != NULL;
+}
+
+/* ── Query execution ─────────────────────────────────────────── */
+
+static int replay_execute(argus_backend_conn_t conn, const char *query,
+                          argus_backend_op_t *out_op)
+{
+    const char *args[] = { query };
+    return open_op(conn, REPLAY_OP_EXECUTE, 1, args, out_op);
+}
+
+static int replay_get_operation_status(argus_backend_conn_t conn,
+                                       argus_backend_op_t op, bool *finished)
+{
+    (void)conn; (void)op;
+    *finished = true;
+    return 0;
+}
+
+static void replay_close_operation(argus_backend_conn_t conn,
+                                   argus_backend_op_t op)
+{
+    (void)conn;
+    replay_stmt_op_t *so = op;
+    if (!so) return;
+    g_mutex_clear(&so->lock);
+    free(so);
+}
+
+static int replay_cancel(argus_backend_conn_t conn, argus_backend_op_t op)
+{
+    (void)conn;
+    replay_stmt_op_t *so = op;
+    if (so) so->cancelled = true;
+    return 0;
+}
+
+static void describe(const replay_op_t *rec, argus_column_desc_t *columns,
+                     int *num_cols)
+{
+    if (!num_cols) return;
+    *num_cols = 0;
+    if (!columns || !rec->columns) return;
+    memcpy(columns, rec->columns,
+           (size_t)rec->num_cols * sizeof(argus_column_desc_t));
+    *num_cols = rec->num_cols;
+}
+
+static int replay_fetch_results(argus_backend_conn_t conn,
+                                argus_backend_op_t op, int max_rows,
+                                argus_row_cache_t *cache,
+                                argus_column_desc_t *columns, int *num_cols)
+{
+    replay_conn_t *rc = conn;
+    replay_stmt_op_t *so = op;
+    if (!so) return -1;
+    const replay_op_t *rec = so->rec;
+
+    if (so->cancelled) {
+        set_error(rc, "Operation cancelled");
+        return -1;
+    }
+    describe(rec, columns, num_cols);
+
+    int width = rec->width ? rec->width : rec->num_cols;
+    cache->num_cols = width;
+    if (so->next >= rec->num_rows) {
+        simulate_wire(rc, 0);
+        if (rec->fetch_rc != 0) {
+            set_error(rc, rec->fetch_error);
+            return rec->fetch_rc;
+        }
+        cache->exhausted = true;
+        return 0;
+    }
+
+    size_t n = rec->num_rows - so->next;
+    if (max_rows <= 0) max_rows = ARGUS_DEFAULT_BATCH_SIZE;
+    if (n > (size_t)max_rows) n = (size_t)max_rows;
+
+    size_t need = cache->num_rows + n;
+    if (need > cache->capacity) {
+        argus_row_t *rows = realloc(cache->rows, need * sizeof(argus_row_t));
+        if (!rows) return -1;
+        cache->rows = rows;
+        cache->capacity = need;
+    }
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < n; i++) {
+        const argus_row_t *src = &rec->rows[so->next + i];
+        if (argus_row_copy(&cache->rows[cache->num_rows], src, width) != 0)
+            return -1;
+        cache->num_rows++;
+        bytes += row_bytes(src, width);
+    }
+    so->next += n;
+    if (so->next >= rec->num_rows && rec->fetch_rc == 0)
+        cache->exhausted = true;
+
+    int64_t slept = simulate_wire(rc, bytes);
+    g_mutex_lock(&so->lock);
+    so->bytes += (int64_t)bytes;
+    so->wait_us += slept;
+    g_mutex_unlock(&so->lock);
+    return 0;
+}
+
+static int replay_get_result_metadata(argus_backend_conn_t conn,
+                                      argus_backend_op_t op,
+                                      argus_column_desc_t *columns,
+                                      int *num_cols)
+{
+    (void)conn;
+    replay_stmt_op_t *so = op;
+    if (!so) return -1;
+    describe(so->rec, columns, num_cols);
+    return 0;
+}
+
+/* ── Catalog operations ──────────────────────────────────────── */
+
+static int replay_get_tables(argus_backend_conn_t conn, const char *catalog,
+                             const char *schema, const char *table_name,
+                             const char *table_types,
+                             argus_backend_op_t *out_op)
+{
+    const char *args[] = { catalog, schema, table_name, table_types };
+    return open_op(conn, REPLAY_OP_TABLES, 4, args, out_op);
+}
+
+static int replay_get_columns(argus_backend_conn_t conn, const char *catalog,
+                              const char *schema, const char *table_name,
+                              const char *column_name,
+                              argus_backend_op_t *out_op)
+{
+    const char *args[] = { catalog, schema, table_name, column_name };
+    return open_op(conn, REPLAY_OP_COLUMNS, 4, args, out_op);
+}
+
+static int replay_get_type_info(argus_backend_conn_t conn,
+                                SQLSMALLINT sql_type,
+                                argus_backend_op_t *out_op)
+{
+    char type[16];
+    snprintf(type, sizeof(type), "%d", (int)sql_type);
+    const char *args[] = { type };
+    return open_op(conn, REPLAY_OP_TYPE_INFO, 1, args, out_op);
+}
+
+static int replay_get_schemas(argus_backend_conn_t conn, const char *catalog,
+                              const char *schema, argus_backend_op_t *out_op)
+{
+    const char *args[] = { catalog, schema };
+    return open_op(conn, REPLAY_OP_SCHEMAS, 2, args, out_op);
+}
+
+static int replay_get_catalogs(argus_backend_conn_t conn,
+                               argus_backend_op_t *out_op)
+{
+    return open_op(conn, REPLAY_OP_CATALOGS, 0, NULL, out_op);
+}
+
+static int replay_get_primary_keys(argus_backend_conn_t conn,
+                                   const char *catalog, const char *schema,
+                                   const char *table_name,
+                                   argus_backend_op_t *out_op)
+{
+    const char *args[] = { catalog, schema, table_name };
+    return open_op(conn, REPLAY_OP_PRIMARY_KEYS, 3, args, out_op);
+}
+
+static int replay_get_statistics(argus_backend_conn_t conn,
+                                 const char *catalog, const char *schema,
+                                 const char *table_name,
+                                 unsigned short unique,
+                                 unsigned short reserved,
+                                 argus_backend_op_t *out_op)
+{
+    char flags[32];
+    snprintf(flags, sizeof(flags), "%u/%u", unique, reserved);
+    const char *args[] = { catalog, schema, table_name, flags };
+    return open_op(conn, REPLAY_OP_STATISTICS, 4, args, out_op);
+}
+
+/* ── Extras ──────────────────────────────────────────────────── */
+
+static bool replay_get_last_error(argus_backend_conn_t conn, char *buf,
+                                  size_t buflen)
+{
+    replay_conn_t *rc = conn;
+    if (!rc || !buf || buflen == 0) return false;
+    g_mutex_lock(&rc->lock);
+    bool have = rc->last_error[0] != '\0';
+    if (have) g_strlcpy(buf, rc->last_error, buflen);
+    g_mutex_unlock(&rc->lock);
+    return have;
+}
+
+static bool replay_get_server_version(argus_backend_conn_t conn, char *buf,
+                                      size_t buflen)
+{
+    replay_conn_t *rc = conn;
+    if (!rc || !rc->file->server_version || !buf || buflen == 0) return false;
+    g_strlcpy(buf, rc->file->server_version, buflen);
+    return true;
+}
+
+static bool replay_get_progress(argus_backend_conn_t conn,
+                                argus_backend_op_t op, argus_progress_t *out)
+{
+    (void)conn;
+    replay_stmt_op_t *so = op;
+    if (!so || !out) return false;
+
+    const replay_op_t *rec = so->rec;
+    size_t served = so->next;
+    memset(out, 0, sizeof(*out));
+    out->percent = rec->num_rows
+        ? 100.0 * (double)served / (double)rec->num_rows : 100.0;
+    out->rows_processed = (int64_t)served;
+    g_mutex_lock(&so->lock);
+    out->bytes_received = so->bytes;
+    out->wait_us = so->wait_us;
+    g_mutex_unlock(&so->lock);
+    out->bytes_processed = out->bytes_received;
+    out->elapsed_ms = (g_get_monotonic_time() - so->started) / 1000;
+    g_strlcpy(out->state, served >= rec->num_rows ? "FINISHED" : "RUNNING",
+              sizeof(out->state));
+    return true;
+}
+
+/* ── Vtables ─────────────────────────────────────────────────── */
+
+static const argus_backend_t replay_backend = {
+    .name                  = "replay",
+    .connect               = replay_connect,
+    .disconnect            = replay_disconnect,
+    .is_alive              = replay_is_alive,
+    .execute               = replay_execute,
+    .get_operation_status  = replay_get_operation_status,
+    .close_operation       = replay_close_operation,
+    .cancel                = replay_cancel,
+    .fetch_results         = replay_fetch_results,
+    .get_result_metadata   = replay_get_result_metadata,
+    .get_tables            = replay_get_tables,
+    .get_columns           = replay_get_columns,
+    .get_type_info         = replay_get_type_info,
+    .get_schemas           = replay_get_schemas,
+    .get_catalogs          = replay_get_catalogs,
+    .get_primary_keys      = replay_get_primary_keys,
+    .get_statistics        = replay_get_statistics,
+    .get_last_error        = replay_get_last_error,
+    .get_server_version    = replay_get_server_version,
+    .get_progress          = replay_get_progress,
+};
+
+const argus_backend_t *argus_replay_backend_get(void)
+{
+    return &replay_backend;
+}
+
+/* One vtable per recorded (name, capabilities), made on first use and kept
+ * for the life of the process like the static ones. */
+typedef struct replay_persona {
+    argus_backend_t vt;
+    char           *name;
+    uint32_t        mask;
+} replay_persona_t;
+
+static GMutex     personas_lock;
+static GPtrArray *personas;
+
+const argus_backend_t *replay_backend_for(const char *recorded_name,
+                                          uint32_t mask)
+{
+    if (!recorded_name) return &replay_backend;
+
+    g_mutex_lock(&personas_lock);
+    if (!personas) personas = g_ptr_array_new();
+    for (guint i = 0; i < personas->len; i++) {
+        replay_persona_t *p = g_ptr_array_index(personas, i);
+        if (p->mask == mask && strcmp(p->name, recorded_name) == 0) {
+            g_mutex_unlock(&personas_lock);
+            return &p->vt;
+        }
+    }
+
+    replay_persona_t *p = calloc(1, sizeof(*p));
+    if (!p || !(p->name = strdup(recorded_name))) {
+        free(p);
+        g_mutex_unlock(&personas_lock);
+        return NULL;
+    }
+    p->mask = mask;
+    p->vt = replay_backend;
+    p->vt.name = p->name;
+#define REPLAY_KEEP(bit, slot) if (!(mask & (bit))) p->vt.slot = NULL
+    REPLAY_KEEP(REPLAY_HAS_IS_ALIVE, is_alive);
+    REPLAY_KEEP(REPLAY_HAS_TABLES, get_tables);
+    REPLAY_KEEP(REPLAY_HAS_COLUMNS, get_columns);
+    REPLAY_KEEP(REPLAY_HAS_TYPE_INFO, get_type_info);
+    REPLAY_KEEP(REPLAY_HAS_SCHEMAS, get_schemas);
+    REPLAY_KEEP(REPLAY_HAS_CATALOGS, get_catalogs);
+    REPLAY_KEEP(REPLAY_HAS_PRIMARY_KEYS, get_primary_keys);
+    REPLAY_KEEP(REPLAY_HAS_STATISTICS, get_statistics);
+    REPLAY_KEEP(REPLAY_HAS_SERVER_VERSION, get_server_version);
+#undef REPLAY_KEEP
+    /* get_last_error stays: "not in capture file" must reach the app */
+    g_ptr_array_add(personas, p);
+    g_mutex_unlock(&personas_lock);
+    return &p->vt;
+}
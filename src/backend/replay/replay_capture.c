@@ -0,0 +1,410 @@
+/*
+ * Capture mode: a pass-through wrapper around a real backend that appends
+ * every operation and fetched batch to a capture file (CAPTUREFILE=path).
+ *
+ * The wrapper keeps the inner backend's name, so the ODBC layer picks the
+ * same dialect and SQLGetInfo answers as without capture, and leaves the
+ * optional entries the inner backend lacks NULL so the same fallbacks run.
+ */
+#include "replay_internal.h"
+#include "argus/handle.h"
+#include "argus/log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct capture_backend {
+    argus_backend_t        vt;          /* first: handed out as the backend */
+    const argus_backend_t *inner;
+} capture_backend_t;
+
+typedef struct capture_conn {
+    const argus_backend_t *inner;
+    argus_backend_conn_t   conn;
+    replay_writer_t       *writer;
+} capture_conn_t;
+
+typedef struct capture_op {
+    argus_backend_op_t op;
+    uint64_t           id;
+    bool               described;   /* an 'M' record was written */
+} capture_op_t;
+
+static GMutex             wrappers_lock;
+static capture_backend_t *wrappers[ARGUS_MAX_BACKENDS];
+static int                wrapper_count;
+
+static const argus_backend_t *inner_of(const argus_backend_t *wrapper)
+{
+    const argus_backend_t *inner = NULL;
+    g_mutex_lock(&wrappers_lock);
+    for (int i = 0; i < wrapper_count; i++) {
+        if (&wrappers[i]->vt == wrapper) {
+            inner = wrappers[i]->inner;
+            break;
+        }
+    }
+    g_mutex_unlock(&wrappers_lock);
+    return inner;
+}
+
+static void last_error(capture_conn_t *cc, char *buf, size_t len)
+{
+    buf[0] = '\0';
+    if (cc->inner->get_last_error)
+        cc->inner->get_last_error(cc->conn, buf, len);
+}
+
+/* Record the outcome of an execute or catalog call and wrap its handle */
+static int record_op(capture_conn_t *cc, replay_kind_t kind, int nargs,
+                     const char *const *args, int rc,
+                     argus_backend_op_t inner_op, argus_backend_op_t *out_op)
+{
+    char err[1024] = "";
+    if (rc != 0) last_error(cc, err, sizeof(err));
+
+    capture_op_t *op = NULL;
+    if (rc == 0) {
+        op = calloc(1, sizeof(*op));
+        if (!op) {
+            if (inner_op) cc->inner->close_operation(cc->conn, inner_op);
+            return -1;
+        }
+        op->op = inner_op;
+    }
+    uint64_t id = replay_writer_next_id();
+    if (op) op->id = id;
+
+    char *key = replay_key(kind, nargs, args);
+    replay_write_op(cc->writer, id, kind, key, rc, rc != 0 ? err : NULL);
+    g_free(key);
+
+    *out_op = op;
+    return rc;
+}
+
+/* ── Connection lifecycle ────────────────────────────────────── */
+
+static int capture_connect(argus_dbc_t *dbc, const char *host, int port,
+                           const char *username, const char *password,
+                           const char *database, const char *auth_mechanism,
+                           argus_backend_conn_t *out_conn)
+{
+    const argus_backend_t *inner = inner_of(dbc->backend);
+    if (!inner) return -1;
+
+    argus_backend_conn_t conn = NULL;
+    int rc = inner->connect(dbc, host, port, username, password, database,
+                            auth_mechanism, &conn);
+    if (rc != 0) return rc;
+
+    capture_conn_t *cc = calloc(1, sizeof(*cc));
+    if (!cc) {
+        inner->disconnect(conn);
+        return -1;
+    }
+    cc->inner = inner;
+    cc->conn = conn;
+    cc->writer = replay_writer_open(dbc->capture_file);
+    if (!cc->writer) {
+        inner->disconnect(conn);
+        free(cc);
+        return -1;
+    }
+
+    uint32_t mask = 0;
+    if (inner->is_alive)           mask |= REPLAY_HAS_IS_ALIVE;
+    if (inner->get_tables)         mask |= REPLAY_HAS_TABLES;
+    if (inner->get_columns)        mask |= REPLAY_HAS_COLUMNS;
+    if (inner->get_type_info)      mask |= REPLAY_HAS_TYPE_INFO;
+    if (inner->get_schemas)        mask |= REPLAY_HAS_SCHEMAS;
+    if (inner->get_catalogs)       mask |= REPLAY_HAS_CATALOGS;
+    if (inner->get_primary_keys)   mask |= REPLAY_HAS_PRIMARY_KEYS;
+    if (inner->get_statistics)     mask |= REPLAY_HAS_STATISTICS;
+    if (inner->get_last_error)     mask |= REPLAY_HAS_LAST_ERROR;
+    if (inner->get_server_version) mask |= REPLAY_HAS_SERVER_VERSION;
+
+    char version[128] = "";
+    bool have_version = inner->get_server_version &&
+        inner->get_server_version(conn, version, sizeof(version));
+    replay_write_session(cc->writer, inner->name, mask,
+                         have_version ? version : NULL);
+
+    *out_conn = cc;
+    return 0;
+}
+
+static void capture_disconnect(argus_backend_conn_t conn)
+{
+    capture_conn_t *cc = conn;
+    if (!cc) return;
+    cc->inner->disconnect(cc->conn);
+    replay_writer_release(cc->writer);
+    free(cc);
+}
+
+static bool capture_is_alive(argus_backend_conn_t conn)
+{
+    capture_conn_t *cc = conn;
+    return cc->inner->is_alive(cc->conn);
+}
+
+/* ── Query execution ─────────────────────────────────────────── */
+
+static int capture_execute(argus_backend_conn_t conn, const char *query,
+                           argus_backend_op_t *out_op)
+{
+    capture_conn_t *cc = conn;
+    argus_backend_op_t op = NULL;
+    int rc = cc->inner->execute(cc->conn, query, &op);
+    const char *args[] = { query };
+    return record_op(cc, REPLAY_OP_EXECUTE, 1, args, rc, op, out_op);
+}
+
+static int capture_get_operation_status(argus_backend_conn_t conn,
+                                        argus_backend_op_t op, bool *finished)
+{
+    capture_conn_t *cc = conn;
+    capture_op_t *co = op;
+    return cc->inner->get_operation_status(cc->conn, co ? co->op : NULL,
+                                           finished);
+}
+
+static void capture_close_operation(argus_backend_conn_t conn,
+                                    argus_backend_op_t op)
+{
+    capture_conn_t *cc = conn;
+    capture_op_t *co = op;
+    if (!co) return;
+    cc->inner->close_operation(cc->conn, co->op);
+    free(co);
+}
+
+static int capture_cancel(argus_backend_conn_t conn, argus_backend_op_t op)
+{
+    capture_conn_t *cc = conn;
+    capture_op_t *co = op;
+    return cc->inner->cancel(cc->conn, co ? co->op : NULL);
+}
+
+static int capture_fetch_results(argus_backend_conn_t conn,
+                                 argus_backend_op_t op, int max_rows,
+                                 argus_row_cache_t *cache,
+                                 argus_column_desc_t *columns, int *num_cols)
+{
+    capture_conn_t *cc = conn;
+    capture_op_t *co = op;
+    if (!co) return -1;
+
+    size_t before = cache->num_rows;
+    int rc = cc->inner->fetch_results(cc->conn, co->op, max_rows, cache,
+                                      columns, num_cols);
+    if (rc == 0 && !co->described && columns && num_cols && *num_cols > 0) {
+        replay_write_meta(cc->writer, co->id, columns, *num_cols);
+        co->described = true;
+    }
+
+    /* Only the rows this call added: a caller may fetch into a cache that
+     * still holds earlier ones */
+    argus_row_cache_t added = *cache;
+    if (added.num_rows >= before) {
+        added.rows += before;
+        added.num_rows -= before;
+    }
+    char err[1024] = "";
+    if (rc != 0) last_error(cc, err, sizeof(err));
+    replay_write_batch(cc->writer, co->id, rc, rc != 0 ? err : NULL, &added);
+    return rc;
+}
+
+static int capture_get_result_metadata(argus_backend_conn_t conn,
+                                       argus_backend_op_t op,
+                                       argus_column_desc_t *columns,
+                                       int *num_cols)
+{
+    capture_conn_t *cc = conn;
+    capture_op_t *co = op;
+    if (!co) return -1;
+
+    int rc = cc->inner->get_result_metadata(cc->conn, co->op, columns,
+                                            num_cols);
+    if (rc == 0 && *num_cols > 0) {
+        replay_write_meta(cc->writer, co->id, columns, *num_cols);
+        co->described = true;
+    }
+    return rc;
+}
+
+/* ── Catalog operations ──────────────────────────────────────── */
+
+static int capture_get_tables(argus_backend_conn_t conn, const char *catalog,
+                              const char *schema, const char *table_name,
+                              const char *table_types,
+                              argus_backend_op_t *out_op)
+{
+    capture_conn_t *cc = conn;
+    argus_backend_op_t op = NULL;
+    int rc = cc->inner->get_tables(cc->conn, catalog, schema, table_name,
+                                   table_types, &op);
+    const char *args[] = { catalog, schema, table_name, table_types };
+    return record_op(cc, REPLAY_OP_TABLES, 4, args, rc, op, out_op);
+}
+
+static int capture_get_columns(argus_backend_conn_t conn, const char *catalog,
+                               const char *schema, const char *table_name,
+                               const char *column_name,
+                               argus_backend_op_t *out_op)
+{
+    capture_conn_t *cc = conn;
+    argus_backend_op_t op = NULL;
+    int rc = cc->inner->get_columns(cc->conn, catalog, schema, table_name,
+                                    column_name, &op);
+    const char *args[] = { catalog, schema, table_name, column_name };
+    return record_op(cc, REPLAY_OP_COLUMNS, 4, args, rc, op, out_op);
+}
+
+static int capture_get_type_info(argus_backend_conn_t conn,
+                                 SQLSMALLINT sql_type,
+                                 argus_backend_op_t *out_op)
+{
+    capture_conn_t *cc = conn;
+    argus_backend_op_t op = NULL;
+    int rc = cc->inner->get_type_info(cc->conn, sql_type, &op);
+    char type[16];
+    snprintf(type, sizeof(type), "%d", (int)sql_type);
+    const char *args[] = { type };
+    return record_op(cc, REPLAY_OP_TYPE_INFO, 1, args, rc, op, out_op);
+}
+
+static int capture_get_schemas(argus_backend_conn_t conn, const char *catalog,
+                               const char *schema, argus_backend_op_t *out_op)
+{
+    capture_conn_t *cc = conn;
+    argus_backend_op_t op = NULL;
+    int rc = cc->inner->get_schemas(cc->conn, catalog, schema, &op);
+    const char *args[] = { catalog, schema };
+    return record_op(cc, REPLAY_OP_SCHEMAS, 2, args, rc, op, out_op);
+}
+
+static int capture_get_catalogs(argus_backend_conn_t conn,
+                                argus_backend_op_t *out_op)
+{
+    capture_conn_t *cc = conn;
+    argus_backend_op_t op = NULL;
+    int rc = cc->inner->get_catalogs(cc->conn, &op);
+    return record_op(cc, REPLAY_OP_CATALOGS, 0, NULL, rc, op, out_op);
+}
+
+static int capture_get_primary_keys(argus_backend_conn_t conn,
+                                    const char *catalog, const char *schema,
+                                    const char *table_name,
+                                    argus_backend_op_t *out_op)
+{
+    capture_conn_t *cc = conn;
+    argus_backend_op_t op = NULL;
+    int rc = cc->inner->get_primary_keys(cc->conn, catalog, schema,
+                                         table_name, &op);
+    const char *args[] = { catalog, schema, table_name };
+    return record_op(cc, REPLAY_OP_PRIMARY_KEYS, 3, args, rc, op, out_op);
+}
+
+static int capture_get_statistics(argus_backend_conn_t conn,
+                                  const char *catalog, const char *schema,
+                                  const char *table_name,
+                                  unsigned short unique,
+                                  unsigned short reserved,
+                                  argus_backend_op_t *out_op)
+{
+    capture_conn_t *cc = conn;
+    argus_backend_op_t op = NULL;
+    int rc = cc->inner->get_statistics(cc->conn, catalog, schema, table_name,
+                                       unique, reserved, &op);
+    char flags[32];
+    snprintf(flags, sizeof(flags), "%u/%u", unique, reserved);
+    const char *args[] = { catalog, schema, table_name, flags };
+    return record_op(cc, REPLAY_OP_STATISTICS, 4, args, rc, op, out_op);
+}
+
+/* ── Pass-through extras ─────────────────────────────────────── */
+
+static bool capture_get_last_error(argus_backend_conn_t conn, char *buf,
+                                   size_t buflen)
+{
+    capture_conn_t *cc = conn;
+    return cc->inner->get_last_error(cc->conn, buf, buflen);
+}
+
+static bool capture_get_server_version(argus_backend_conn_t conn, char *buf,
+                                       size_t buflen)
+{
+    capture_conn_t *cc = conn;
+    return cc->inner->get_server_version(cc->conn, buf, buflen);
+}
+
+static bool capture_get_progress(argus_backend_conn_t conn,
+                                 argus_backend_op_t op, argus_progress_t *out)
+{
+    capture_conn_t *cc = conn;
+    capture_op_t *co = op;
+    return co && cc->inner->get_progress(cc->conn, co->op, out);
+}
+
+/* ── Wrapper vtables ─────────────────────────────────────────── */
+
+const argus_backend_t *argus_capture_backend(const argus_backend_t *inner)
+{
+    if (!inner) return NULL;
+
+    g_mutex_lock(&wrappers_lock);
+    for (int i = 0; i < wrapper_count; i++) {
+        if (wrappers[i]->inner == inner || &wrappers[i]->vt == inner) {
+            const argus_backend_t *vt = &wrappers[i]->vt;
+            g_mutex_unlock(&wrappers_lock);
+            return vt;
+        }
+    }
+    if (wrapper_count == ARGUS_MAX_BACKENDS) {
+        g_mutex_unlock(&wrappers_lock);
+        return NULL;
+    }
+
+    capture_backend_t *w = calloc(1, sizeof(*w));
+    if (!w) {
+        g_mutex_unlock(&wrappers_lock);
+        return NULL;
+    }
+    w->inner = inner;
+    w->vt = (argus_backend_t){
+        .name                 = inner->name,
+        .connect              = capture_connect,
+        .disconnect           = capture_disconnect,
+        .is_alive             = inner->is_alive ? capture_is_alive : NULL,
+        .execute              = capture_execute,
+        .get_operation_status = capture_get_operation_status,
+        .close_operation      = capture_close_operation,
+        .cancel               = capture_cancel,
+        .fetch_results        = capture_fetch_results,
+        .get_result_metadata  = capture_get_result_metadata,
+        .get_tables           = inner->get_tables ? capture_get_tables : NULL,
+        .get_columns          = inner->get_columns ? capture_get_columns : NULL,
+        .get_type_info        = inner->get_type_info ? capture_get_type_info
+                                                     : NULL,
+        .get_schemas          = inner->get_schemas ? capture_get_schemas : NULL,
+        .get_catalogs         = inner->get_catalogs ? capture_get_catalogs
+                                                    : NULL,
+        .get_primary_keys     = inner->get_primary_keys
+                                    ? capture_get_primary_keys : NULL,
+        .get_statistics       = inner->get_statistics ? capture_get_statistics
+                                                      : NULL,
+        .get_last_error       = inner->get_last_error ? capture_get_last_error
+                                                      : NULL,
+        .get_server_version   = inner->get_server_version
+                                    ? capture_get_server_version : NULL,
+        .get_progress         = inner->get_progress ? capture_get_progress
+                                                    : NULL,
+    };
+    wrappers[wrapper_count++] = w;
+    g_mutex_unlock(&wrappers_lock);
+    return &w->vt;
+}
@@ -0,0 +1,581 @@
+/*
+ * Capture files: the writer shared by capturing connections and the loaded,
+ * read-only form replay serves from. Layout in replay_internal.h.
+ */
+#include "replay_internal.h"
+#include "argus/log.h"
+
+#include <glib/gstdio.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ── Keys ────────────────────────────────────────────────────── */
+
+char *replay_key(replay_kind_t kind, int nargs, const char *const *args)
+{
+    GString *k = g_string_new(NULL);
+    g_string_append_printf(k, "%d", (int)kind);
+    for (int i = 0; i < nargs; i++) {
+        g_string_append_c(k, '\x1f');
+        if (args[i]) {
+            g_string_append_c(k, '=');
+            g_string_append(k, args[i]);
+        }
+    }
+    return g_string_free(k, FALSE);
+}
+
+/* ── Encoding ────────────────────────────────────────────────── */
+
+static void put_u32(GByteArray *b, uint32_t v)
+{
+    g_byte_array_append(b, (const guint8 *)&v, sizeof(v));
+}
+
+static void put_u64(GByteArray *b, uint64_t v)
+{
+    g_byte_array_append(b, (const guint8 *)&v, sizeof(v));
+}
+
+static void put_str(GByteArray *b, const char *s)
+{
+    if (!s) {
+        put_u32(b, UINT32_MAX);
+        return;
+    }
+    uint32_t n = (uint32_t)strlen(s);
+    put_u32(b, n);
+    g_byte_array_append(b, (const guint8 *)s, n);
+}
+
+static void put_row(GByteArray *b, const argus_row_t *row, int num_cols)
+{
+    const argus_cell_t *cells = row->cells;
+    guint8 has = cells ? 1 : 0;
+    g_byte_array_append(b, &has, 1);
+    if (!cells) return;
+    for (int c = 0; c < num_cols; c++) {
+        guint8 flags[2] = { cells[c].is_null ? 1 : 0, cells[c].native_kind };
+        g_byte_array_append(b, flags, 2);
+        g_byte_array_append(b, (const guint8 *)&cells[c].native,
+                            sizeof(cells[c].native));
+        if (cells[c].data) {
+            put_u64(b, (uint64_t)cells[c].data_len);
+            g_byte_array_append(b, (const guint8 *)cells[c].data,
+                                (guint)cells[c].data_len);
+        } else {
+            put_u64(b, UINT64_MAX);
+        }
+    }
+}
+
+typedef struct {
+    const guint8 *p;
+    size_t        left;
+    bool          bad;
+} reader_t;
+
+static bool get_bytes(reader_t *r, void *out, size_t n)
+{
+    if (r->bad || r->left < n) {
+        r->bad = true;
+        return false;
+    }
+    memcpy(out, r->p, n);
+    r->p += n;
+    r->left -= n;
+    return true;
+}
+
+static uint32_t get_u32(reader_t *r)
+{
+    uint32_t v = 0;
+    get_bytes(r, &v, sizeof(v));
+    return v;
+}
+
+static uint64_t get_u64(reader_t *r)
+{
+    uint64_t v = 0;
+    get_bytes(r, &v, sizeof(v));
+    return v;
+}
+
+static char *get_str(reader_t *r)
+{
+    uint32_t n = get_u32(r);
+    if (r->bad || n == UINT32_MAX) return NULL;
+    if (n > r->left) {
+        r->bad = true;
+        return NULL;
+    }
+    char *s = malloc((size_t)n + 1);
+    if (!s) {
+        r->bad = true;
+        return NULL;
+    }
+    get_bytes(r, s, n);
+    s[n] = '\0';
+    return s;
+}
+
+/* Read one row of num_cols cells into row. false on a short record. */
+static bool get_row(reader_t *r, argus_row_t *row, int num_cols)
+{
+    row->cells = NULL;
+    guint8 has = 0;
+    if (!get_bytes(r, &has, 1)) return false;
+    if (!has) return true;
+    argus_cell_t *cells = calloc((size_t)num_cols, sizeof(argus_cell_t));
+    if (!cells) return false;
+    row->cells = cells;
+    for (int c = 0; c < num_cols; c++) {
+        guint8 flags[2];
+        if (!get_bytes(r, flags, 2) ||
+            !get_bytes(r, &cells[c].native, sizeof(cells[c].native)))
+            return false;
+        cells[c].is_null = flags[0] != 0;
+        cells[c].native_kind = flags[1];
+        uint64_t len = get_u64(r);
+        if (r->bad) return false;
+        if (len == UINT64_MAX) continue;
+        if (len > r->left) {
+            r->bad = true;
+            return false;
+        }
+        cells[c].data = malloc((size_t)len + 1);
+        if (!cells[c].data) return false;
+        get_bytes(r, cells[c].data, (size_t)len);
+        cells[c].data[len] = '\0';
+        cells[c].data_len = (size_t)len;
+    }
+    return true;
+}
+
+/* ── Writer ──────────────────────────────────────────────────── */
+
+struct replay_writer {
+    gint     refs;
+    char    *path;
+    FILE    *fp;
+    GMutex   lock;      /* one record at a time */
+};
+
+static GMutex      writers_lock;
+static GHashTable *writers;         /* path -> replay_writer_t* */
+static guint64     next_op_id;
+
+replay_writer_t *replay_writer_open(const char *path)
+{
+    if (!path || !*path) return NULL;
+
+    g_mutex_lock(&writers_lock);
+    if (!writers)
+        writers = g_hash_table_new(g_str_hash, g_str_equal);
+    replay_writer_t *w = g_hash_table_lookup(writers, path);
+    if (w) {
+        w->refs++;
+        g_mutex_unlock(&writers_lock);
+        return w;
+    }
+
+    FILE *fp = g_fopen(path, "ab");
+    if (!fp) {
+        g_mutex_unlock(&writers_lock);
+        ARGUS_LOG_ERROR("Capture: cannot open %s for writing", path);
+        return NULL;
+    }
+    if (ftell(fp) == 0) {
+        /* Captures hold result data: owner-only, like the metadata cache */
+        g_chmod(path, 0600);
+        GByteArray *b = g_byte_array_new();
+        g_byte_array_append(b, (const guint8 *)REPLAY_MAGIC, 8);
+        put_u32(b, REPLAY_VERSION);
+        put_u32(b, (uint32_t)sizeof(argus_column_desc_t));
+        fwrite(b->data, 1, b->len, fp);
+        g_byte_array_free(b, TRUE);
+    }
+
+    w = calloc(1, sizeof(*w));
+    if (!w) {
+        fclose(fp);
+        g_mutex_unlock(&writers_lock);
+        return NULL;
+    }
+    w->refs = 1;
+    w->path = strdup(path);
+    w->fp = fp;
+    g_mutex_init(&w->lock);
+    g_hash_table_insert(writers, w->path, w);
+    g_mutex_unlock(&writers_lock);
+    ARGUS_LOG_INFO("Capture: recording to %s", path);
+    return w;
+}
+
+void replay_writer_release(replay_writer_t *w)
+{
+    if (!w) return;
+    g_mutex_lock(&writers_lock);
+    if (--w->refs > 0) {
+        g_mutex_lock(&w->lock);
+        fflush(w->fp);
+        g_mutex_unlock(&w->lock);
+        g_mutex_unlock(&writers_lock);
+        return;
+    }
+    g_hash_table_remove(writers, w->path);
+    g_mutex_unlock(&writers_lock);
+
+    fclose(w->fp);
+    g_mutex_clear(&w->lock);
+    free(w->path);
+    free(w);
+}
+
+uint64_t replay_writer_next_id(void)
+{
+    g_mutex_lock(&writers_lock);
+    uint64_t id = ++next_op_id;
+    g_mutex_unlock(&writers_lock);
+    return id;
+}
+
+/* Append one framed record; flush when asked (operation boundaries). */
+static void emit(replay_writer_t *w, char type, GByteArray *payload,
+                 bool flush)
+{
+    guint8 head[5];
+    uint32_t len = payload->len;
+    head[0] = (guint8)type;
+    memcpy(head + 1, &len, sizeof(len));
+
+    g_mutex_lock(&w->lock);
+    if (fwrite(head, 1, sizeof(head), w->fp) != sizeof(head) ||
+        fwrite(payload->data, 1, payload->len, w->fp) != payload->len)
+        ARGUS_LOG_WARN("Capture: short write to %s", w->path);
+    if (flush) fflush(w->fp);
+    g_mutex_unlock(&w->lock);
+    g_byte_array_free(payload, TRUE);
+}
+
+void replay_write_session(replay_writer_t *w, const char *backend,
+                          uint32_t mask, const char *server_version)
+{
+    if (!w) return;
+    GByteArray *b = g_byte_array_new();
+    put_str(b, backend);
+    put_u32(b, mask);
+    put_str(b, server_version);
+    emit(w, REPLAY_REC_SESSION, b, true);
+}
+
+void replay_write_op(replay_writer_t *w, uint64_t id, replay_kind_t kind,
+                     const char *key, int rc, const char *error)
+{
+    if (!w) return;
+    GByteArray *b = g_byte_array_new();
+    put_u64(b, id);
+    put_u32(b, (uint32_t)kind);
+    put_str(b, key);
+    put_u32(b, (uint32_t)rc);
+    put_str(b, error);
+    emit(w, REPLAY_REC_OP, b, true);
+}
+
+void replay_write_meta(replay_writer_t *w, uint64_t id,
+                       const argus_column_desc_t *columns, int num_cols)
+{
+    if (!w || !columns || num_cols <= 0) return;
+    GByteArray *b = g_byte_array_new();
+    put_u64(b, id);
+    put_u32(b, (uint32_t)num_cols);
+    g_byte_array_append(b, (const guint8 *)columns,
+                        (guint)((size_t)num_cols * sizeof(*columns)));
+    emit(w, REPLAY_REC_META, b, false);
+}
+
+void replay_write_batch(replay_writer_t *w, uint64_t id, int rc,
+                        const char *error, const argus_row_cache_t *cache)
+{
+    if (!w) return;
+    size_t nrows = (rc == 0 && cache) ? cache->num_rows : 0;
+    int ncols = cache ? cache->num_cols : 0;
+    GByteArray *b = g_byte_array_new();
+    put_u64(b, id);
+    put_u32(b, (uint32_t)rc);
+    put_str(b, error);
+    put_u32(b, (uint32_t)ncols);
+    put_u64(b, (uint64_t)nrows);
+    for (size_t r = 0; r < nrows; r++)
+        put_row(b, &cache->rows[r], ncols);
+    emit(w, REPLAY_REC_BATCH, b, rc != 0 || nrows == 0);
+}
+
+/* ── Loaded files ────────────────────────────────────────────── */
+
+static void op_free(gpointer p)
+{
+    replay_op_t *op = p;
+    for (size_t r = 0; r < op->num_rows; r++) {
+        argus_cell_t *cells = op->rows[r].cells;
+        if (!cells) continue;
+        for (int c = 0; c < op->width; c++) free(cells[c].data);
+        free(cells);
+    }
+    free(op->rows);
+    free(op->columns);
+    free(op->error);
+    free(op->fetch_error);
+    free(op);
+}
+
+static void file_free(replay_file_t *f)
+{
+    if (f->by_key) g_hash_table_destroy(f->by_key);
+    if (f->ops) g_ptr_array_free(f->ops, TRUE);
+    free(f->backend);
+    free(f->server_version);
+    free(f->path);
+    free(f);
+}
+
+void replay_file_unref(replay_file_t *file)
+{
+    if (file && g_atomic_int_dec_and_test(&file->refs))
+        file_free(file);
+}
+
+static bool read_session(reader_t *r, replay_file_t *f)
+{
+    char *backend = get_str(r);
+    uint32_t mask = get_u32(r);
+    char *version = get_str(r);
+    if (r->bad) {
+        free(backend);
+        free(version);
+        return false;
+    }
+    /* The first session names the backend; later ones add capabilities */
+    if (!f->backend) {
+        f->backend = backend;
+        backend = NULL;
+    }
+    if (version && !f->server_version) {
+        f->server_version = version;
+        version = NULL;
+    }
+    f->mask |= mask;
+    free(backend);
+    free(version);
+    return true;
+}
+
+static bool read_op(reader_t *r, replay_file_t *f, GHashTable *by_id)
+{
+    replay_op_t *op = calloc(1, sizeof(*op));
+    if (!op) return false;
+    op->id = get_u64(r);
+    op->kind = (replay_kind_t)get_u32(r);
+    char *key = get_str(r);
+    op->rc = (int)get_u32(r);
+    op->error = get_str(r);
+    if (r->bad || !key) {
+        free(key);
+        op_free(op);
+        return false;
+    }
+    g_ptr_array_add(f->ops, op);
+    g_hash_table_insert(by_id, &op->id, op);
+
+    GPtrArray *list = g_hash_table_lookup(f->by_key, key);
+    if (!list) {
+        list = g_ptr_array_new();
+        g_hash_table_insert(f->by_key, key, list);
+    } else {
+        free(key);
+    }
+    g_ptr_array_add(list, op);
+    return true;
+}
+
+static bool read_meta(reader_t *r, GHashTable *by_id)
+{
+    uint64_t id = get_u64(r);
+    uint32_t ncols = get_u32(r);
+    if (r->bad || ncols > ARGUS_MAX_COLUMNS) return false;
+    argus_column_desc_t *cols = malloc((size_t)ncols * sizeof(*cols) + 1);
+    if (!cols || !get_bytes(r, cols, (size_t)ncols * sizeof(*cols))) {
+        free(cols);
+        return false;
+    }
+    replay_op_t *op = g_hash_table_lookup(by_id, &id);
+    if (!op) {
+        free(cols);
+        return true;
+    }
+    free(op->columns);
+    op->columns = cols;
+    op->num_cols = (int)ncols;
+    return true;
+}
+
+static bool read_batch(reader_t *r, GHashTable *by_id)
+{
+    uint64_t id = get_u64(r);
+    int rc = (int)get_u32(r);
+    char *error = get_str(r);
+    uint32_t ncols = get_u32(r);
+    uint64_t nrows = get_u64(r);
+    replay_op_t *op = g_hash_table_lookup(by_id, &id);
+    if (r->bad || ncols > ARGUS_MAX_COLUMNS || nrows > r->left || !op) {
+        free(error);
+        return !r->bad && op == NULL;   /* an orphan batch is skipped */
+    }
+    if (rc != 0) {
+        if (op->fetch_rc == 0) {
+            op->fetch_rc = rc;
+            op->fetch_error = error;
+            error = NULL;
+        }
+        free(error);
+        return true;
+    }
+    free(error);
+    if (nrows == 0) return true;
+    if (op->num_rows > 0 && op->width != (int)ncols) return false;
+    op->width = (int)ncols;
+
+    if (op->num_rows + nrows > op->capacity) {
+        size_t cap = op->capacity ? op->capacity : 256;
+        while (cap < op->num_rows + nrows) cap *= 2;
+        argus_row_t *grown = realloc(op->rows, cap * sizeof(argus_row_t));
+        if (!grown) return false;
+        op->rows = grown;
+        op->capacity = cap;
+    }
+    for (uint64_t i = 0; i < nrows; i++) {
+        argus_row_t *row = &op->rows[op->num_rows];
+        bool ok = get_row(r, row, op->width);
+        op->num_rows++;             /* a partial row is still freed */
+        if (!ok) return false;
+    }
+    return true;
+}
+
+static replay_file_t *load_file(const char *path, char *err, size_t errlen)
+{
+    gchar *data = NULL;
+    gsize len = 0;
+    GError *error = NULL;
+    if (!g_file_get_contents(path, &data, &len, &error)) {
+        snprintf(err, errlen, "cannot read capture file %s: %s", path,
+                 error ? error->message : "?");
+        if (error) g_error_free(error);
+        return NULL;
+    }
+
+    reader_t r = { (const guint8 *)data, len, false };
+    char magic[8];
+    uint32_t version = 0, col_size = 0;
+    if (get_bytes(&r, magic, sizeof(magic)) &&
+        memcmp(magic, REPLAY_MAGIC, sizeof(magic)) == 0) {
+        version = get_u32(&r);
+        col_size = get_u32(&r);
+    }
+    if (r.bad || version != REPLAY_VERSION ||
+        col_size != (uint32_t)sizeof(argus_column_desc_t)) {
+        snprintf(err, errlen, "%s is not a capture file of this driver",
+                 path);
+        g_free(data);
+        return NULL;
+    }
+
+    replay_file_t *f = calloc(1, sizeof(*f));
+    if (!f) {
+        g_free(data);
+        snprintf(err, errlen, "out of memory");
+        return NULL;
+    }
+    f->refs = 1;
+    f->path = strdup(path);
+    f->ops = g_ptr_array_new_with_free_func(op_free);
+    f->by_key = g_hash_table_new_full(g_str_hash, g_str_equal, free,
+                                      (GDestroyNotify)g_ptr_array_unref);
+    GHashTable *by_id = g_hash_table_new(g_int64_hash, g_int64_equal);
+
+    bool ok = true;
+    while (ok && r.left > 0) {
+        guint8 type = 0;
+        uint32_t plen = 0;
+        if (!get_bytes(&r, &type, 1) || !get_bytes(&r, &plen, sizeof(plen)) ||
+            plen > r.left) {
+            ok = false;
+            break;
+        }
+        reader_t rec = { r.p, plen, false };
+        r.p += plen;
+        r.left -= plen;
+        switch (type) {
+        case REPLAY_REC_SESSION: ok = read_session(&rec, f); break;
+        case REPLAY_REC_OP:      ok = read_op(&rec, f, by_id); break;
+        case REPLAY_REC_META:    ok = read_meta(&rec, by_id); break;
+        case REPLAY_REC_BATCH:   ok = read_batch(&rec, by_id); break;
+        default:                 break;
+        }
+    }
+    g_hash_table_destroy(by_id);
+    g_free(data);
+
+    /* A capture cut short (the recording process died) still replays what
+     * it holds; only a file with no session is useless. */
+    if (!ok)
+        ARGUS_LOG_WARN("Replay: %s is truncated or corrupt; using the %u "
+                       "operation(s) before the damage", path, f->ops->len);
+    if (!f->backend) {
+        snprintf(err, errlen, "capture file %s holds no session", path);
+        file_free(f);
+        return NULL;
+    }
+    ARGUS_LOG_INFO("Replay: loaded %u operation(s) recorded from %s (%s)",
+                   f->ops->len, f->backend, path);
+    return f;
+}
+
+static GMutex      files_lock;
+static GHashTable *files;           /* path -> replay_file_t* (one ref) */
+
+replay_file_t *replay_file_get(const char *path, char *err, size_t errlen)
+{
+    GStatBuf st;
+    if (!path || g_stat(path, &st) != 0) {
+        snprintf(err, errlen, "capture file %s not found",
+                 path ? path : "(none)");
+        return NULL;
+    }
+
+    g_mutex_lock(&files_lock);
+    if (!files)
+        files = g_hash_table_new_full(g_str_hash, g_str_equal, NULL,
+                                      (GDestroyNotify)replay_file_unref);
+    replay_file_t *f = g_hash_table_lookup(files, path);
+    if (f && f->mtime == (gint64)st.st_mtime &&
+        f->size == (gint64)st.st_size) {
+        g_atomic_int_inc(&f->refs);
+        g_mutex_unlock(&files_lock);
+        return f;
+    }
+
+    /* Loaded under the lock: connections to a file being loaded wait for
+     * it instead of each parsing their own copy. */
+    f = load_file(path, err, errlen);
+    if (f) {
+        f->mtime = (gint64)st.st_mtime;
+        f->size = (gint64)st.st_size;
+        g_hash_table_replace(files, f->path, f);
+        g_atomic_int_inc(&f->refs);
+    }
+    g_mutex_unlock(&files_lock);
+    return f;
+}
@@ -0,0 +1,136 @@
+#ifndef ARGUS_REPLAY_INTERNAL_H
+#define ARGUS_REPLAY_INTERNAL_H
+
+#include <glib.h>
+#include <stdint.h>
+
+#include "argus/types.h"
+#include "argus/backend.h"
+
+/*
+ * Record-and-replay backend.
+ *
+ * CAPTUREFILE=path on any connection wraps its backend (replay_capture.c) so
+ * every execute, catalog call, metadata answer and fetched batch is appended
+ * to a capture file. BACKEND=replay;REPLAYFILE=path (replay_backend.c) then
+ * answers the same calls from that file with no server, optionally adding a
+ * per-round-trip latency and a bandwidth limit.
+ *
+ * File layout (host byte order, like the metadata cache file):
+ *
+ *   "ARGUSCAP" u32 version, u32 sizeof(argus_column_desc_t)
+ *   then records:  u8 type, u32 payload length, payload
+ *
+ *   'H' session   str backend, u32 REPLAY_HAS_* mask, str server version
+ *   'O' operation u64 id, u32 kind, str key, u32 rc, str error
+ *   'M' metadata  u64 id, u32 ncols, ncols raw column descriptors
+ *   'B' batch     u64 id, u32 rc, str error, u32 ncols, u64 nrows, rows
+ *
+ * A str is u32 length + bytes (UINT32_MAX for NULL). A row is a u8 "has
+ * cells" flag, then per cell u8 is_null, u8 native_kind, 8 bytes of native
+ * value and u64 text length + text (UINT64_MAX for none). Unknown record
+ * types are skipped, so a newer writer's extra records do not break replay.
+ */
+
+#define REPLAY_MAGIC        "ARGUSCAP"
+#define REPLAY_VERSION      1
+
+#define REPLAY_REC_SESSION  'H'
+#define REPLAY_REC_OP       'O'
+#define REPLAY_REC_META     'M'
+#define REPLAY_REC_BATCH    'B'
+
+/* What an operation was opened by; part of its lookup key */
+typedef enum replay_kind {
+    REPLAY_OP_EXECUTE = 1,
+    REPLAY_OP_TABLES,
+    REPLAY_OP_COLUMNS,
+    REPLAY_OP_TYPE_INFO,
+    REPLAY_OP_SCHEMAS,
+    REPLAY_OP_CATALOGS,
+    REPLAY_OP_PRIMARY_KEYS,
+    REPLAY_OP_STATISTICS
+} replay_kind_t;
+
+/* Optional vtable entries the recorded backend had; replay offers the same
+ * set so the ODBC layer takes the same fallbacks it took while recording. */
+#define REPLAY_HAS_IS_ALIVE        0x0001
+#define REPLAY_HAS_TYPE_INFO       0x0002
+#define REPLAY_HAS_SCHEMAS         0x0004
+#define REPLAY_HAS_CATALOGS        0x0008
+#define REPLAY_HAS_PRIMARY_KEYS    0x0010
+#define REPLAY_HAS_STATISTICS      0x0020
+#define REPLAY_HAS_LAST_ERROR      0x0040
+#define REPLAY_HAS_SERVER_VERSION  0x0080
+#define REPLAY_HAS_TABLES          0x0100
+#define REPLAY_HAS_COLUMNS         0x0200
+
+/* ── Keys ────────────────────────────────────────────────────── */
+
+/* Lookup key of an operation: its kind and arguments (NULL and "" differ).
+ * Returns a g_free'd string. */
+char *replay_key(replay_kind_t kind, int nargs, const char *const *args);
+
+/* ── Writing (capture) ───────────────────────────────────────── */
+
+typedef struct replay_writer replay_writer_t;
+
+/* The process-wide writer for path, opened (appending) on first use and
+ * shared by every connection capturing to it. NULL if it cannot be opened. */
+replay_writer_t *replay_writer_open(const char *path);
+void replay_writer_release(replay_writer_t *w);
+
+/* A process-unique operation id */
+uint64_t replay_writer_next_id(void);
+
+void replay_write_session(replay_writer_t *w, const char *backend,
+                          uint32_t mask, const char *server_version);
+void replay_write_op(replay_writer_t *w, uint64_t id, replay_kind_t kind,
+                     const char *key, int rc, const char *error);
+void replay_write_meta(replay_writer_t *w, uint64_t id,
+                       const argus_column_desc_t *columns, int num_cols);
+void replay_write_batch(replay_writer_t *w, uint64_t id, int rc,
+                        const char *error, const argus_row_cache_t *cache);
+
+/* ── Reading (replay) ────────────────────────────────────────── */
+
+/* One recorded operation, its batches flattened into one row array */
+typedef struct replay_op {
+    uint64_t             id;
+    replay_kind_t        kind;
+    int                  rc;            /* of execute / the catalog call */
+    char                *error;
+    argus_column_desc_t *columns;
+    int                  num_cols;
+    argus_row_t         *rows;
+    int                  width;         /* cells per row */
+    size_t               num_rows;
+    size_t               capacity;
+    int                  fetch_rc;      /* a recorded fetch failure ends it */
+    char                *fetch_error;
+} replay_op_t;
+
+/* A loaded capture file; shared, read-only once loaded */
+typedef struct replay_file {
+    gint        refs;
+    char       *path;
+    gint64      mtime;
+    gint64      size;
+    char       *backend;            /* recorded backend, e.g. "trino" */
+    uint32_t    mask;               /* REPLAY_HAS_* */
+    char       *server_version;
+    GHashTable *by_key;             /* key -> GPtrArray of replay_op_t*,
+                                     * in recording order */
+    GPtrArray  *ops;                /* owns every replay_op_t */
+} replay_file_t;
+
+/* Load path, or reuse the process-wide copy while the file is unchanged.
+ * NULL with err set on failure. Release with replay_file_unref. */
+replay_file_t *replay_file_get(const char *path, char *err, size_t errlen);
+void replay_file_unref(replay_file_t *file);
+
+/* replay_backend.c: the vtable replay presents for a recorded backend */
+const argus_backend_t *replay_backend_for(const char *recorded_name,
+                                          uint32_t mask);
+
+#endif /* ARGUS_REPLAY_INTERNAL_H */
@@ -0,0 +1,347 @@
+/*
+ * BACKEND=synthetic: generated result sets for load testing. No server and
+ * no I/O; the only waits are the ones the spec asks for.
+ */
+#include "synthetic_internal.h"
+#include "argus/cancel.h"
+#include "argus/handle.h"
+#include "argus/log.h"
+#include "argus/compat.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct synthetic_conn {
+    synthetic_spec_t base;          /* SYNTHETICSPEC over the defaults */
+    GMutex           lock;
+    char             last_error[256];
+} synthetic_conn_t;
+
+typedef struct synthetic_op {
+    synthetic_spec_t spec;
+    int64_t          next;          /* next row to generate */
+    gint             cancelled;
+    gint64           started;       /* monotonic us */
+    char             checksum[17];  /* CHECKSUM queries: the answer */
+} synthetic_op_t;
+
+static void set_error(synthetic_conn_t *sc, const char *msg)
+{
+    g_mutex_lock(&sc->lock);
+    g_strlcpy(sc->last_error, msg ? msg : "", sizeof(sc->last_error));
+    g_mutex_unlock(&sc->lock);
+}
+
+#define SYNTHETIC_SLEEP_SLICE_MS 10
+
+/* Wait `ms` as a server would, but give up once the statement is cancelled
+ * or past its query timeout. Returns false when it gave up. */
+static bool synthetic_sleep(synthetic_conn_t *sc, int ms)
+{
+    argus_cancel_t *cancel = argus_cancel_current();
+    gint64 until = g_get_monotonic_time() + (gint64)ms * 1000;
+    for (;;) {
+        if (argus_cancel_requested(cancel)) {
+            set_error(sc, "Query cancelled");
+            return false;
+        }
+        gint64 left = until - g_get_monotonic_time();
+        if (left <= 0) return true;
+        g_usleep((gulong)MIN(left, SYNTHETIC_SLEEP_SLICE_MS * 1000));
+    }
+}
+
+/* Does the query carry its own spec? */
+static bool is_spec_query(const char *query)
+{
+    while (*query == ' ' || *query == '\t' || *query == '\r' ||
+           *query == '\n')
+        query++;
+    return strncasecmp(query, "SYNTHETIC", 9) == 0 &&
+           (query[9] == '\0' || query[9] == ' ' || query[9] == '\t' ||
+            query[9] == '\r' || query[9] == '\n');
+}
+
+/* ── Connection lifecycle ────────────────────────────────────── */
+
+static int synthetic_connect(argus_dbc_t *dbc, const char *host, int port,
+                             const char *username, const char *password,
+                             const char *database, const char *auth_mechanism,
+                             argus_backend_conn_t *out_conn)
+{
+    (void)host; (void)port; (void)username; (void)password;
+    (void)database; (void)auth_mechanism;
+
+    synthetic_conn_t *sc = calloc(1, sizeof(*sc));
+    if (!sc) return -1;
+    synthetic_spec_default(&sc->base);
+
+    char err[160] = "";
+    if (synthetic_spec_parse(&sc->base, dbc->synthetic_spec, err,
+                             sizeof(err)) != 0) {
+        char msg[256];
+        snprintf(msg, sizeof(msg), "[Argus] SYNTHETICSPEC: %s", err);
+        argus_set_error(&dbc->diag, "HY000", msg, 0);
+        free(sc);
+        return -1;
+    }
+    g_mutex_init(&sc->lock);
+    *out_conn = sc;
+    return 0;
+}
+
+static void synthetic_disconnect(argus_backend_conn_t conn)
+{
+    synthetic_conn_t *sc = conn;
+    if (!sc) return;
+    g_mutex_clear(&sc->lock);
+    free(sc);
+}
+
+static bool synthetic_is_alive(argus_backend_conn_t conn)
+{
+    return conn != NULL;
+}
+
+/* ── Query execution ─────────────────────────────────────────── */
+
+/* Any query returns the connection's spec; "SYNTHETIC key=value ..."
+ * overrides it for that query. */
+static int synthetic_execute(argus_backend_conn_t conn, const char *query,
+                             argus_backend_op_t *out_op)
+{
+    synthetic_conn_t *sc = conn;
+    synthetic_op_t *op = calloc(1, sizeof(*op));
+    if (!op) return -1;
+    op->spec = sc->base;
+
+    char err[160] = "";
+    if (query && is_spec_query(query) &&
+        synthetic_spec_parse(&op->spec, query, err, sizeof(err)) != 0) {
+        set_error(sc, err);
+        free(op);
+        return -1;
+    }
+    set_error(sc, NULL);
+
+    if (op->spec.exec_latency_ms > 0 &&
+        !synthetic_sleep(sc, op->spec.exec_latency_ms)) {
+        free(op);
+        return -1;
+    }
+    if (op->spec.checksum) {
+        snprintf(op->checksum, sizeof(op->checksum), "%016llx",
+                 (unsigned long long)synthetic_checksum(&op->spec));
+        ARGUS_LOG_DEBUG("Synthetic checksum of %lld rows: %s",
+                        (long long)op->spec.rows, op->checksum);
+    }
+    op->started = g_get_monotonic_time();
+    *out_op = op;
+    return 0;
+}
+
+static int synthetic_get_operation_status(argus_backend_conn_t conn,
+                                          argus_backend_op_t op,
+                                          bool *finished)
+{
+    (void)conn; (void)op;
+    *finished = true;
+    return 0;
+}
+
+static void synthetic_close_operation(argus_backend_conn_t conn,
+                                      argus_backend_op_t op)
+{
+    (void)conn;
+    free(op);
+}
+
+static int synthetic_cancel(argus_backend_conn_t conn, argus_backend_op_t op)
+{
+    (void)conn;
+    synthetic_op_t *so = op;
+    if (so) g_atomic_int_set(&so->cancelled, 1);
+    return 0;
+}
+
+/* CHECKSUM queries: one row of (rows BIGINT, checksum VARCHAR(16)) */
+static void describe_checksum(argus_column_desc_t *columns)
+{
+    memset(columns, 0, 2 * sizeof(*columns));
+    g_strlcpy((char *)columns[0].name, "rows", sizeof(columns[0].name));
+    columns[0].name_len = 4;
+    columns[0].sql_type = SQL_BIGINT;
+    columns[0].column_size = 19;
+    columns[0].nullable = SQL_NO_NULLS;
+    g_strlcpy((char *)columns[1].name, "checksum", sizeof(columns[1].name));
+    columns[1].name_len = 8;
+    columns[1].sql_type = SQL_VARCHAR;
+    columns[1].column_size = 16;
+    columns[1].nullable = SQL_NO_NULLS;
+}
+
+static int describe(const synthetic_op_t *so, argus_column_desc_t *columns,
+                    int *num_cols)
+{
+    if (so->spec.checksum) {
+        describe_checksum(columns);
+        *num_cols = 2;
+    } else {
+        synthetic_describe(&so->spec, columns);
+        *num_cols = so->spec.num_cols;
+    }
+    return 0;
+}
+
+static int fetch_checksum(synthetic_op_t *so, argus_row_cache_t *cache)
+{
+    cache->num_cols = 2;
+    if (so->next > 0) {
+        cache->exhausted = true;
+        return 0;
+    }
+    if (cache->capacity < cache->num_rows + 1) {
+        argus_row_t *rows = realloc(cache->rows,
+                                    (cache->num_rows + 1) * sizeof(*rows));
+        if (!rows) return -1;
+        cache->rows = rows;
+        cache->capacity = cache->num_rows + 1;
+    }
+    argus_cell_t *cells = calloc(2, sizeof(argus_cell_t));
+    if (!cells) return -1;
+    cells[0].native_kind = ARGUS_NATIVE_I64;
+    cells[0].native.i64 = so->spec.rows;
+    cells[1].data = strdup(so->checksum);
+    if (!cells[1].data) {
+        free(cells);
+        return -1;
+    }
+    cells[1].data_len = strlen(so->checksum);
+    cache->rows[cache->num_rows++].cells = cells;
+    so->next = 1;
+    cache->exhausted = true;
+    return 0;
+}
+
+static int synthetic_fetch_results(argus_backend_conn_t conn,
+                                   argus_backend_op_t op, int max_rows,
+                                   argus_row_cache_t *cache,
+                                   argus_column_desc_t *columns,
+                                   int *num_cols)
+{
+    synthetic_conn_t *sc = conn;
+    synthetic_op_t *so = op;
+    if (!so) return -1;
+
+    if (g_atomic_int_get(&so->cancelled)) {
+        set_error(sc, "Query cancelled");
+        return -1;
+    }
+    if (columns && num_cols) describe(so, columns, num_cols);
+    if (so->spec.checksum) return fetch_checksum(so, cache);
+
+    int ncols = so->spec.num_cols;
+    cache->num_cols = ncols;
+    int64_t left = so->spec.rows - so->next;
+    if (left <= 0) {
+        cache->exhausted = true;
+        return 0;
+    }
+    if (max_rows <= 0) max_rows = ARGUS_DEFAULT_BATCH_SIZE;
+    size_t n = left < (int64_t)max_rows ? (size_t)left : (size_t)max_rows;
+
+    size_t need = cache->num_rows + n;
+    if (need > cache->capacity) {
+        argus_row_t *rows = realloc(cache->rows, need * sizeof(argus_row_t));
+        if (!rows) return -1;
+        cache->rows = rows;
+        cache->capacity = need;
+    }
+    for (size_t i = 0; i < n; i++) {
+        argus_cell_t *cells = calloc((size_t)ncols, sizeof(argus_cell_t));
+        if (!cells) return -1;
+        argus_row_t *row = &cache->rows[cache->num_rows++];
+        row->cells = cells;
+        if (synthetic_fill_row(&so->spec, so->next, cells) != 0) return -1;
+        so->next++;
+    }
+    if (so->next >= so->spec.rows) cache->exhausted = true;
+
+    if (so->spec.latency_ms > 0 && !synthetic_sleep(sc, so->spec.latency_ms))
+        return -1;
+    return 0;
+}
+
+static int synthetic_get_result_metadata(argus_backend_conn_t conn,
+                                         argus_backend_op_t op,
+                                         argus_column_desc_t *columns,
+                                         int *num_cols)
+{
+    (void)conn;
+    if (!op) return -1;
+    return describe(op, columns, num_cols);
+}
+
+/* ── Extras ──────────────────────────────────────────────────── */
+
+static bool synthetic_get_last_error(argus_backend_conn_t conn, char *buf,
+                                     size_t buflen)
+{
+    synthetic_conn_t *sc = conn;
+    if (!sc || !buf || buflen == 0) return false;
+    g_mutex_lock(&sc->lock);
+    bool have = sc->last_error[0] != '\0';
+    if (have) g_strlcpy(buf, sc->last_error, buflen);
+    g_mutex_unlock(&sc->lock);
+    return have;
+}
+
+static bool synthetic_get_progress(argus_backend_conn_t conn,
+                                   argus_backend_op_t op,
+                                   argus_progress_t *out)
+{
+    (void)conn;
+    synthetic_op_t *so = op;
+    if (!so || !out) return false;
+
+    int64_t total = so->spec.checksum ? 1 : so->spec.rows;
+    int64_t done = so->next;
+    memset(out, 0, sizeof(*out));
+    out->percent = total > 0 ? 100.0 * (double)done / (double)total : 100.0;
+    out->rows_processed = done;
+    out->bytes_received = -1;
+    out->bytes_processed = -1;
+    out->wait_us = -1;
+    out->elapsed_ms = (g_get_monotonic_time() - so->started) / 1000;
+    g_strlcpy(out->state, done >= total ? "FINISHED" : "RUNNING",
+              sizeof(out->state));
+    return true;
+}
+
+static const argus_backend_t synthetic_backend = {
+    .name                  = "synthetic",
+    .connect               = synthetic_connect,
+    .disconnect            = synthetic_disconnect,
+    .is_alive              = synthetic_is_alive,
+    .execute               = synthetic_execute,
+    .get_operation_status  = synthetic_get_operation_status,
+    .close_operation       = synthetic_close_operation,
+    .cancel                = synthetic_cancel,
+    .fetch_results         = synthetic_fetch_results,
+    .get_result_metadata   = synthetic_get_result_metadata,
+    .get_tables            = NULL,
+    .get_columns           = NULL,
+    .get_type_info         = NULL,
+    .get_schemas           = NULL,
+    .get_catalogs          = NULL,
+    .get_primary_keys      = NULL,
+    .get_statistics        = NULL,
+    .get_last_error        = synthetic_get_last_error,
+    .get_progress          = synthetic_get_progress,
+};
+
+const argus_backend_t *argus_synthetic_backend_get(void)
+{
+    return &synthetic_backend;
+}
@@ -0,0 +1,94 @@
+#ifndef ARGUS_SYNTHETIC_INTERNAL_H
+#define ARGUS_SYNTHETIC_INTERNAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "argus/types.h"
+
+/*
+ * BACKEND=synthetic: result sets generated on the fly from a spec, for load
+ * testing the driver without a server.
+ *
+ * A spec is whitespace-separated key=value pairs, taken from the query text
+ * ("SYNTHETIC rows=1000000 cols=bigint,varchar") on top of the connection's
+ * SYNTHETICSPEC. Every cell is a pure function of (seed, row, column), so a
+ * result is identical however it is batched, fetched or threaded, and its
+ * checksum can be computed without materializing it.
+ */
+
+#define SYNTHETIC_MAX_COLS       64
+#define SYNTHETIC_DEFAULT_ROWS   1000
+#define SYNTHETIC_MAX_STRLEN     4096
+
+typedef enum synthetic_type {
+    SYN_INT = 0,
+    SYN_BIGINT,
+    SYN_DOUBLE,
+    SYN_DECIMAL,        /* DECIMAL(18,2) */
+    SYN_VARCHAR,
+    SYN_BOOL,
+    SYN_DATE,
+    SYN_TIMESTAMP
+} synthetic_type_t;
+
+typedef enum synthetic_dist {
+    SYN_DIST_UNIFORM = 0,   /* every length in [min, max] equally likely */
+    SYN_DIST_SKEWED         /* most near min, a long tail up to max, like
+                             * real text columns */
+} synthetic_dist_t;
+
+typedef struct synthetic_col {
+    synthetic_type_t type;
+    bool             own_len;   /* VARCHAR(n) / VARCHAR(min-max) given */
+    int              min_len;
+    int              max_len;
+} synthetic_col_t;
+
+typedef struct synthetic_spec {
+    int64_t          rows;
+    int              num_cols;
+    synthetic_col_t  cols[SYNTHETIC_MAX_COLS];
+    int              str_min;       /* strlen= for VARCHAR columns */
+    int              str_max;       /* without their own length */
+    synthetic_dist_t str_dist;
+    double           null_ratio;    /* 0..1, per cell */
+    uint64_t         seed;
+    int              latency_ms;        /* per fetched batch */
+    int              exec_latency_ms;   /* once per execute */
+    bool             checksum;          /* answer with the checksum row */
+} synthetic_spec_t;
+
+/* The spec used when neither the connection nor the query gives one */
+void synthetic_spec_default(synthetic_spec_t *spec);
+
+/* Apply the key=value pairs of text over spec. A leading "SYNTHETIC" (and
+ * "CHECKSUM") keyword is accepted. Returns 0, or -1 with err set on an
+ * unknown key or bad value. */
+int synthetic_spec_parse(synthetic_spec_t *spec, const char *text,
+                         char *err, size_t errlen);
+
+/* Column descriptors (c1..cN) of the spec's result */
+void synthetic_describe(const synthetic_spec_t *spec,
+                        argus_column_desc_t *columns);
+
+/* Fill the cells of one row. Numeric columns get native values and no text;
+ * the rest get malloc'd text. Returns 0, or -1 on allocation failure. */
+int synthetic_fill_row(const synthetic_spec_t *spec, int64_t row,
+                       argus_cell_t *cells);
+
+/* ── Checksum ────────────────────────────────────────────────── */
+
+/* FNV-1a 64 over each cell in row order: its text as SQLGetData(SQL_C_CHAR)
+ * returns it (a NULL is one 0x00 byte), then a 0x1f byte. An application
+ * computes the same while reading to validate what it fetched. */
+#define SYNTHETIC_CHECKSUM_INIT 0xcbf29ce484222325ULL
+
+uint64_t synthetic_checksum_cell(uint64_t h, const char *text, size_t len,
+                                 bool is_null);
+
+/* The checksum of the spec's whole result, computed without keeping it */
+uint64_t synthetic_checksum(const synthetic_spec_t *spec);
+
+#endif /* ARGUS_SYNTHETIC_INTERNAL_H */
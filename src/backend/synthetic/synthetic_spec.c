@@ -0,0 +1,463 @@
+/*
+ * Synthetic result specs: parsing, deterministic cell generation and the
+ * result checksum. See synthetic_internal.h.
+ */
+#include "synthetic_internal.h"
+#include "argus/compat.h"
+
+#include <glib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ── Spec parsing ────────────────────────────────────────────── */
+
+void synthetic_spec_default(synthetic_spec_t *spec)
+{
+    memset(spec, 0, sizeof(*spec));
+    spec->rows = SYNTHETIC_DEFAULT_ROWS;
+    spec->num_cols = 4;
+    spec->cols[0].type = SYN_BIGINT;
+    spec->cols[1].type = SYN_VARCHAR;
+    spec->cols[2].type = SYN_DOUBLE;
+    spec->cols[3].type = SYN_DATE;
+    spec->str_min = 8;
+    spec->str_max = 32;
+    spec->str_dist = SYN_DIST_UNIFORM;
+    spec->seed = 1;
+}
+
+/* "10", "10k", "2m", "1g" */
+static bool parse_count(const char *s, int64_t *out)
+{
+    char *end = NULL;
+    long long v = strtoll(s, &end, 10);
+    if (end == s || v < 0) return false;
+    switch (*end) {
+    case 'k': case 'K': v *= 1000LL; end++; break;
+    case 'm': case 'M': v *= 1000000LL; end++; break;
+    case 'g': case 'G': v *= 1000000000LL; end++; break;
+    default: break;
+    }
+    if (*end) return false;
+    *out = v;
+    return true;
+}
+
+static bool parse_int(const char *s, int lo, int hi, int *out)
+{
+    char *end = NULL;
+    long v = strtol(s, &end, 10);
+    if (end == s || *end || v < lo || v > hi) return false;
+    *out = (int)v;
+    return true;
+}
+
+/* "n" or "min-max" */
+static bool parse_len(const char *s, int *min, int *max)
+{
+    char buf[32];
+    g_strlcpy(buf, s, sizeof(buf));
+    char *dash = strchr(buf, '-');
+    if (dash) *dash = '\0';
+    if (!parse_int(buf, 0, SYNTHETIC_MAX_STRLEN, min)) return false;
+    if (!dash) {
+        *max = *min;
+        return true;
+    }
+    return parse_int(dash + 1, *min, SYNTHETIC_MAX_STRLEN, max);
+}
+
+static const struct {
+    const char      *name;
+    synthetic_type_t type;
+} type_names[] = {
+    { "int",       SYN_INT },
+    { "integer",   SYN_INT },
+    { "bigint",    SYN_BIGINT },
+    { "double",    SYN_DOUBLE },
+    { "float",     SYN_DOUBLE },
+    { "decimal",   SYN_DECIMAL },
+    { "varchar",   SYN_VARCHAR },
+    { "string",    SYN_VARCHAR },
+    { "bool",      SYN_BOOL },
+    { "boolean",   SYN_BOOL },
+    { "date",      SYN_DATE },
+    { "timestamp", SYN_TIMESTAMP },
+};
+
+/* One cols= entry: type[(len)][*count] */
+static bool parse_col(synthetic_spec_t *spec, const char *item)
+{
+    char buf[64];
+    g_strlcpy(buf, item, sizeof(buf));
+
+    int count = 1;
+    char *star = strchr(buf, '*');
+    if (star) {
+        *star = '\0';
+        if (!parse_int(star + 1, 1, SYNTHETIC_MAX_COLS, &count)) return false;
+    }
+
+    synthetic_col_t col = { 0 };
+    char *paren = strchr(buf, '(');
+    if (paren) {
+        char *close = strchr(paren, ')');
+        if (!close || close[1]) return false;
+        *paren = '\0';
+        *close = '\0';
+        if (!parse_len(paren + 1, &col.min_len, &col.max_len)) return false;
+        col.own_len = true;
+    }
+
+    size_t i;
+    for (i = 0; i < G_N_ELEMENTS(type_names); i++) {
+        if (strcasecmp(buf, type_names[i].name) == 0) break;
+    }
+    if (i == G_N_ELEMENTS(type_names)) return false;
+    col.type = type_names[i].type;
+    if (col.own_len && col.type != SYN_VARCHAR) return false;
+
+    if (spec->num_cols + count > SYNTHETIC_MAX_COLS) return false;
+    for (int k = 0; k < count; k++) spec->cols[spec->num_cols++] = col;
+    return true;
+}
+
+static bool parse_cols(synthetic_spec_t *spec, const char *list)
+{
+    spec->num_cols = 0;
+    char **items = g_strsplit(list, ",", -1);
+    bool ok = items[0] != NULL;
+    for (int i = 0; ok && items[i]; i++) ok = parse_col(spec, items[i]);
+    g_strfreev(items);
+    return ok && spec->num_cols > 0;
+}
+
+/* strlen=n | min-max [:uniform|:skewed] */
+static bool parse_strlen(synthetic_spec_t *spec, const char *v)
+{
+    char buf[48];
+    g_strlcpy(buf, v, sizeof(buf));
+    synthetic_dist_t dist = SYN_DIST_UNIFORM;
+    char *colon = strchr(buf, ':');
+    if (colon) {
+        *colon = '\0';
+        if (strcasecmp(colon + 1, "skewed") == 0) dist = SYN_DIST_SKEWED;
+        else if (strcasecmp(colon + 1, "uniform") != 0) return false;
+    }
+    if (!parse_len(buf, &spec->str_min, &spec->str_max)) return false;
+    spec->str_dist = dist;
+    return true;
+}
+
+/* nulls=0.05 or nulls=5% */
+static bool parse_ratio(const char *v, double *out)
+{
+    char *end = NULL;
+    double r = g_ascii_strtod(v, &end);
+    if (end == v) return false;
+    if (*end == '%') {
+        r /= 100.0;
+        end++;
+    }
+    if (*end || r < 0.0 || r > 1.0) return false;
+    *out = r;
+    return true;
+}
+
+int synthetic_spec_parse(synthetic_spec_t *spec, const char *text,
+                         char *err, size_t errlen)
+{
+    if (!text) return 0;
+
+    char **tokens = g_strsplit_set(text, " \t\r\n;", -1);
+    int rc = 0;
+    for (int i = 0; tokens[i] && rc == 0; i++) {
+        char *tok = tokens[i];
+        if (!*tok) continue;
+        if (i == 0 && strcasecmp(tok, "SYNTHETIC") == 0) continue;
+        if (strcasecmp(tok, "CHECKSUM") == 0) {
+            spec->checksum = true;
+            continue;
+        }
+
+        char *eq = strchr(tok, '=');
+        if (!eq) {
+            snprintf(err, errlen, "expected key=value, got '%s'", tok);
+            rc = -1;
+            break;
+        }
+        *eq = '\0';
+        const char *key = tok, *val = eq + 1;
+        bool ok;
+        if (strcasecmp(key, "rows") == 0) {
+            ok = parse_count(val, &spec->rows);
+        } else if (strcasecmp(key, "cols") == 0) {
+            ok = parse_cols(spec, val);
+        } else if (strcasecmp(key, "strlen") == 0) {
+            ok = parse_strlen(spec, val);
+        } else if (strcasecmp(key, "nulls") == 0) {
+            ok = parse_ratio(val, &spec->null_ratio);
+        } else if (strcasecmp(key, "seed") == 0) {
+            char *end = NULL;
+            spec->seed = g_ascii_strtoull(val, &end, 10);
+            ok = end != val && !*end;
+        } else if (strcasecmp(key, "latency") == 0) {
+            ok = parse_int(val, 0, 3600000, &spec->latency_ms);
+        } else if (strcasecmp(key, "execlatency") == 0) {
+            ok = parse_int(val, 0, 3600000, &spec->exec_latency_ms);
+        } else {
+            snprintf(err, errlen, "unknown synthetic spec key '%s'", key);
+            rc = -1;
+            break;
+        }
+        if (!ok) {
+            snprintf(err, errlen, "bad value for %s: '%s'", key, val);
+            rc = -1;
+        }
+    }
+    g_strfreev(tokens);
+    return rc;
+}
+
+/* ── Description ─────────────────────────────────────────────── */
+
+void synthetic_describe(const synthetic_spec_t *spec,
+                        argus_column_desc_t *columns)
+{
+    for (int c = 0; c < spec->num_cols; c++) {
+        const synthetic_col_t *col = &spec->cols[c];
+        argus_column_desc_t *d = &columns[c];
+        memset(d, 0, sizeof(*d));
+        d->name_len = (SQLSMALLINT)snprintf((char *)d->name, sizeof(d->name),
+                                            "c%d", c + 1);
+        d->nullable = spec->null_ratio > 0.0 ? SQL_NULLABLE : SQL_NO_NULLS;
+        g_strlcpy((char *)d->table_name, "synthetic", sizeof(d->table_name));
+        switch (col->type) {
+        case SYN_INT:
+            d->sql_type = SQL_INTEGER;
+            d->column_size = 10;
+            break;
+        case SYN_BIGINT:
+            d->sql_type = SQL_BIGINT;
+            d->column_size = 19;
+            break;
+        case SYN_DOUBLE:
+            d->sql_type = SQL_DOUBLE;
+            d->column_size = 15;
+            break;
+        case SYN_DECIMAL:
+            d->sql_type = SQL_DECIMAL;
+            d->column_size = 18;
+            d->decimal_digits = 2;
+            break;
+        case SYN_VARCHAR:
+            d->sql_type = SQL_VARCHAR;
+            d->column_size = (SQLULEN)(col->own_len ? col->max_len
+                                                    : spec->str_max);
+            if (d->column_size == 0) d->column_size = 1;
+            break;
+        case SYN_BOOL:
+            d->sql_type = SQL_BIT;
+            d->column_size = 1;
+            break;
+        case SYN_DATE:
+            d->sql_type = SQL_TYPE_DATE;
+            d->column_size = 10;
+            break;
+        case SYN_TIMESTAMP:
+            d->sql_type = SQL_TYPE_TIMESTAMP;
+            d->column_size = 23;
+            d->decimal_digits = 3;
+            break;
+        }
+    }
+}
+
+/* ── Generation ──────────────────────────────────────────────── */
+
+static uint64_t splitmix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/* Independent 64-bit draws per (seed, row, column, purpose) */
+static uint64_t draw(uint64_t seed, int64_t row, int col, uint64_t salt)
+{
+    return splitmix64(seed ^ splitmix64((uint64_t)row * 0x100000001b3ULL +
+                                        (uint64_t)col * 0x9e3779b1ULL +
+                                        (salt << 56)));
+}
+
+/* Uniform in [0, 1) */
+static double unit(uint64_t v)
+{
+    return (double)(v >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* Civil date of days since 1970-01-01 (Howard Hinnant's algorithm) */
+static void civil_from_days(int64_t z, int *y, unsigned *m, unsigned *d)
+{
+    z += 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned doe = (unsigned)(z - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t yy = (int64_t)yoe + era * 400;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    *d = doy - (153 * mp + 2) / 5 + 1;
+    *m = mp < 10 ? mp + 3 : mp - 9;
+    *y = (int)(yy + (*m <= 2));
+}
+
+#define SYN_DAYS 36525      /* 1970-01-01 .. 2069-12-31 */
+
+static const char alphabet[] =
+    "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+/*
+ * One cell. Numeric columns set *kind and *native; every column also gets
+ * its text in buf (as SQLGetData would render it) when want_text is set or
+ * the column has no native form. Returns the text length, -1 for NULL.
+ */
+static int gen_cell(const synthetic_spec_t *spec, int64_t row, int c,
+                    bool want_text, char *buf, size_t buflen,
+                    uint8_t *kind, int64_t *i64, double *f64)
+{
+    const synthetic_col_t *col = &spec->cols[c];
+    *kind = ARGUS_NATIVE_NONE;
+    if (spec->null_ratio > 0.0 &&
+        unit(draw(spec->seed, row, c, 1)) < spec->null_ratio)
+        return -1;
+
+    uint64_t v = draw(spec->seed, row, c, 0);
+    switch (col->type) {
+    case SYN_INT:
+        *kind = ARGUS_NATIVE_I64;
+        *i64 = (int32_t)(uint32_t)v;
+        return want_text ? snprintf(buf, buflen, "%lld", (long long)*i64) : 0;
+    case SYN_BIGINT:
+        *kind = ARGUS_NATIVE_I64;
+        *i64 = (int64_t)v;
+        return want_text ? snprintf(buf, buflen, "%lld", (long long)*i64) : 0;
+    case SYN_BOOL:
+        *kind = ARGUS_NATIVE_I64;
+        *i64 = (int64_t)(v & 1);
+        return want_text ? snprintf(buf, buflen, "%lld", (long long)*i64) : 0;
+    case SYN_DOUBLE:
+        /* Multiples of 1/1024: exact in binary, so the text is stable */
+        *kind = ARGUS_NATIVE_F64;
+        *f64 = (double)((int64_t)(v % 2000000001ULL) - 1000000000) / 1024.0;
+        return want_text ? snprintf(buf, buflen, "%.17g", *f64) : 0;
+    case SYN_DECIMAL: {
+        int64_t cents = (int64_t)(v % 200000000000001ULL) - 100000000000000LL;
+        int64_t mag = cents < 0 ? -cents : cents;
+        return snprintf(buf, buflen, "%s%lld.%02lld", cents < 0 ? "-" : "",
+                        (long long)(mag / 100), (long long)(mag % 100));
+    }
+    case SYN_VARCHAR: {
+        int lo = col->own_len ? col->min_len : spec->str_min;
+        int hi = col->own_len ? col->max_len : spec->str_max;
+        double u = unit(draw(spec->seed, row, c, 2));
+        if (spec->str_dist == SYN_DIST_SKEWED) u = u * u * u;
+        int len = lo + (int)(u * (double)(hi - lo + 1));
+        if (len > hi) len = hi;
+        if ((size_t)len >= buflen) len = (int)buflen - 1;
+        uint64_t bits = v;
+        for (int i = 0; i < len; i++) {
+            if (i % 10 == 9) bits = draw(spec->seed, row, c, 3 + (uint64_t)i);
+            buf[i] = alphabet[bits % 62];
+            bits /= 62;
+        }
+        buf[len] = '\0';
+        return len;
+    }
+    case SYN_DATE: {
+        int y;
+        unsigned m, d;
+        civil_from_days((int64_t)(v % SYN_DAYS), &y, &m, &d);
+        return snprintf(buf, buflen, "%04d-%02u-%02u", y, m, d);
+    }
+    case SYN_TIMESTAMP: {
+        int64_t secs = (int64_t)(v % ((uint64_t)SYN_DAYS * 86400));
+        int ms = (int)((v >> 48) % 1000);
+        int y;
+        unsigned m, d;
+        civil_from_days(secs / 86400, &y, &m, &d);
+        int64_t sod = secs % 86400;
+        return snprintf(buf, buflen, "%04d-%02u-%02u %02d:%02d:%02d.%03d",
+                        y, m, d, (int)(sod / 3600), (int)(sod / 60 % 60),
+                        (int)(sod % 60), ms);
+    }
+    }
+    return -1;
+}
+
+int synthetic_fill_row(const synthetic_spec_t *spec, int64_t row,
+                       argus_cell_t *cells)
+{
+    char buf[SYNTHETIC_MAX_STRLEN + 64];
+    for (int c = 0; c < spec->num_cols; c++) {
+        argus_cell_t *cell = &cells[c];
+        memset(cell, 0, sizeof(*cell));
+        uint8_t kind;
+        int64_t i64 = 0;
+        double f64 = 0.0;
+        int n = gen_cell(spec, row, c, false, buf, sizeof(buf), &kind, &i64,
+                         &f64);
+        if (n < 0) {
+            cell->is_null = true;
+            continue;
+        }
+        cell->native_kind = kind;
+        if (kind == ARGUS_NATIVE_I64) {
+            cell->native.i64 = i64;
+            continue;
+        }
+        if (kind == ARGUS_NATIVE_F64) {
+            cell->native.f64 = f64;
+            continue;
+        }
+        cell->data = malloc((size_t)n + 1);
+        if (!cell->data) return -1;
+        memcpy(cell->data, buf, (size_t)n + 1);
+        cell->data_len = (size_t)n;
+    }
+    return 0;
+}
+
+/* ── Checksum ────────────────────────────────────────────────── */
+
+#define FNV_PRIME 0x100000001b3ULL
+
+uint64_t synthetic_checksum_cell(uint64_t h, const char *text, size_t len,
+                                 bool is_null)
+{
+    if (is_null) {
+        h = (h ^ 0x00) * FNV_PRIME;
+    } else {
+        for (size_t i = 0; i < len; i++)
+            h = (h ^ (unsigned char)text[i]) * FNV_PRIME;
+    }
+    return (h ^ 0x1f) * FNV_PRIME;
+}
+
+uint64_t synthetic_checksum(const synthetic_spec_t *spec)
+{
+    char buf[SYNTHETIC_MAX_STRLEN + 64];
+    uint64_t h = SYNTHETIC_CHECKSUM_INIT;
+    for (int64_t r = 0; r < spec->rows; r++) {
+        for (int c = 0; c < spec->num_cols; c++) {
+            uint8_t kind;
+            int64_t i64;
+            double f64;
+            int n = gen_cell(spec, r, c, true, buf, sizeof(buf), &kind, &i64,
+                             &f64);
+            h = synthetic_checksum_cell(h, buf, n < 0 ? 0 : (size_t)n, n < 0);
+        }
+    }
+    return h;
+}
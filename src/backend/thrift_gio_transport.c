@@ -20,7 +20,7 @@ enum {
 static gboolean gio_is_open(ThriftTransport *transport)
 {
     ArgusGioTransport *t = ARGUS_GIO_TRANSPORT(transport);
-    return t->stream != NULL;
+    return t->stream != NULL && !g_cancellable_is_cancelled(t->cancellable);
 }
 
 static gboolean gio_peek(ThriftTransport *transport, GError **error)
@@ -162,7 +162,7 @@ static gint32 gio_read(ThriftTransport *transport, gpointer buf,
                     1, "transport not open");
         return -1;
     }
-    gssize n = g_input_stream_read(t->in, buf, len, NULL, error);
+    gssize n = g_input_stream_read(t->in, buf, len, t->cancellable, error);
     if (n < 0) return -1;
     if (n == 0 && len > 0) {
         /* EOF: the peer closed the connection. Report an error rather
@@ -183,14 +183,15 @@ static gboolean gio_write(ThriftTransport *transport, const gpointer buf,
                     1, "transport not open");
         return FALSE;
     }
-    return g_output_stream_write_all(t->out, buf, len, NULL, NULL, error);
+    return g_output_stream_write_all(t->out, buf, len, NULL, t->cancellable,
+                                     error);
 }
 
 static gboolean gio_flush(ThriftTransport *transport, GError **error)
 {
     ArgusGioTransport *t = ARGUS_GIO_TRANSPORT(transport);
     if (!t->out) return TRUE;
-    return g_output_stream_flush(t->out, NULL, error);
+    return g_output_stream_flush(t->out, t->cancellable, error);
 }
 
 static gboolean gio_read_end(ThriftTransport *transport, GError **error)
@@ -250,6 +251,7 @@ static void argus_gio_transport_finalize(GObject *object)
 {
     ArgusGioTransport *t = ARGUS_GIO_TRANSPORT(object);
     gio_close((ThriftTransport *)t, NULL);
+    g_clear_object(&t->cancellable);
     g_free(t->hostname);
     g_free(t->ca_file);
     G_OBJECT_CLASS(argus_gio_transport_parent_class)->finalize(object);
@@ -258,6 +260,7 @@ static void argus_gio_transport_finalize(GObject *object)
 static void argus_gio_transport_init(ArgusGioTransport *t)
 {
     t->tls_verify = TRUE;
+    t->cancellable = g_cancellable_new();
 }
 
 static void argus_gio_transport_class_init(ArgusGioTransportClass *klass)
@@ -320,3 +323,12 @@ ThriftTransport *argus_gio_transport_new(const char *hostname, int port,
                                            "timeout", timeout_sec,
                                            NULL);
 }
+
+void argus_gio_transport_abort(ThriftTransport *transport)
+{
+    if (!transport) return;
+    ArgusGioTransport *t = ARGUS_GIO_TRANSPORT(transport);
+    ARGUS_LOG_DEBUG("GIO transport: aborting the call in progress on %s:%u",
+                    t->hostname, t->port);
+    g_cancellable_cancel(t->cancellable);
+}
@@ -43,6 +43,7 @@ typedef struct _ArgusGioTransport
     GIOStream         *stream;      /* socket_conn or its TLS wrapper */
     GInputStream      *in;
     GOutputStream     *out;
+    GCancellable      *cancellable; /* every read and write; see _abort */
 } ArgusGioTransport;
 
 typedef struct _ArgusGioTransportClass
@@ -59,6 +60,15 @@ ThriftTransport *argus_gio_transport_new(const char *hostname, int port,
                                          const char *ca_file,
                                          guint timeout_sec);
 
+/*
+ * Fail the read or write in progress, from any thread, and every one after
+ * it: a Thrift call cut off mid-message leaves the stream out of step, so
+ * the transport reports itself closed from then on. This is how a call
+ * blocked on the server (FetchResults) is interrupted when the RPC lock
+ * keeps CancelOperation from being sent on the same connection.
+ */
+void argus_gio_transport_abort(ThriftTransport *transport);
+
 G_END_DECLS
 
 #endif /* ARGUS_THRIFT_GIO_TRANSPORT_H */
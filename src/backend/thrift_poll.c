@@ -0,0 +1,141 @@
+/*
+ * thrift_poll.c - Adaptive GetOperationStatus polling (see thrift_poll.h).
+ */
+
+#include "thrift_poll.h"
+#include "argus/cancel.h"
+
+#include <string.h>
+
+void argus_poll_init(argus_poll_t *p)
+{
+    memset(p, 0, sizeof(*p));
+    g_mutex_init(&p->lock);
+    g_cond_init(&p->cond);
+}
+
+void argus_poll_clear(argus_poll_t *p)
+{
+    if (!p) return;
+    g_cond_clear(&p->cond);
+    g_mutex_clear(&p->lock);
+}
+
+int argus_poll_next_interval(int prev_ms, int64_t elapsed_ms)
+{
+    int64_t next = prev_ms < ARGUS_POLL_MIN_MS
+                   ? ARGUS_POLL_MIN_MS : (int64_t)prev_ms * 3 / 2;
+    if (next < elapsed_ms / 10) next = elapsed_ms / 10;
+    if (next > ARGUS_POLL_MAX_MS) next = ARGUS_POLL_MAX_MS;
+    return (int)next;
+}
+
+/* Sleep up to `ms`, or until argus_poll_wake */
+static void poll_wait(argus_poll_t *p, int ms)
+{
+    gint64 deadline = g_get_monotonic_time() + (gint64)ms * 1000;
+    g_mutex_lock(&p->lock);
+    while (!p->woken) {
+        if (!g_cond_wait_until(&p->cond, &p->lock, deadline)) break;
+    }
+    p->woken = false;
+    g_mutex_unlock(&p->lock);
+}
+
+void argus_poll_start(argus_poll_t *p)
+{
+    g_mutex_lock(&p->lock);
+    p->started = g_get_monotonic_time();
+    p->polls = 0;
+    p->interval = 0;
+    g_mutex_unlock(&p->lock);
+}
+
+int argus_poll_step(argus_poll_t *p, argus_poll_fn fn, void *conn, void *op,
+                    int timeout_sec, argus_poll_state_t *state, int *next_ms)
+{
+    argus_progress_t prog;
+    memset(&prog, 0, sizeof(prog));
+    prog.percent = -1;
+    prog.rows_processed = -1;
+    prog.bytes_processed = -1;
+    prog.bytes_received = -1;
+    prog.wait_us = -1;
+
+    /* SQLCancel or the statement's query timeout: stop without another
+     * round trip; the backend cancels the operation on the server */
+    if (argus_cancel_requested(argus_cancel_current())) {
+        *state = ARGUS_POLL_CANCELLED;
+        return 0;
+    }
+
+    argus_poll_state_t st = ARGUS_POLL_RUNNING;
+    if (fn(conn, op, &st, &prog) != 0) return -1;
+
+    gint64 now = g_get_monotonic_time();
+    int64_t elapsed_ms = (now - p->started) / 1000;
+    prog.elapsed_ms = elapsed_ms;
+    g_mutex_lock(&p->lock);
+    p->progress = prog;
+    p->has_progress = true;
+    p->polls++;
+    g_mutex_unlock(&p->lock);
+
+    *state = st;
+    if (st != ARGUS_POLL_RUNNING) return 0;
+    if (timeout_sec > 0 && elapsed_ms >= (int64_t)timeout_sec * 1000)
+        return 1;
+
+    int interval = argus_poll_next_interval(p->interval, elapsed_ms);
+    if (timeout_sec > 0) {
+        int64_t left = (int64_t)timeout_sec * 1000 - elapsed_ms;
+        if (interval > left) interval = (int)left;
+    }
+    p->interval = interval;
+    if (next_ms) *next_ms = interval;
+    return 0;
+}
+
+static void poll_abort(void *data)
+{
+    argus_poll_wake((argus_poll_t *)data);
+}
+
+int argus_poll_run(argus_poll_t *p, argus_poll_fn fn, void *conn, void *op,
+                   int timeout_sec, argus_poll_state_t *state)
+{
+    /* A cancel ends the wait between polls, and the next step sees it */
+    argus_cancel_t *cancel = argus_cancel_current();
+    argus_cancel_push(cancel, poll_abort, p);
+
+    argus_poll_start(p);
+    int rc;
+    for (;;) {
+        int next_ms = 0;
+        rc = argus_poll_step(p, fn, conn, op, timeout_sec, state, &next_ms);
+        if (rc != 0 || *state != ARGUS_POLL_RUNNING) break;
+        long left = argus_cancel_remaining_ms(cancel);
+        if (left >= 0 && left < next_ms) next_ms = (int)left;
+        poll_wait(p, next_ms);
+    }
+    argus_cancel_pop(cancel);
+    return rc;
+}
+
+void argus_poll_wake(argus_poll_t *p)
+{
+    if (!p) return;
+    g_mutex_lock(&p->lock);
+    p->woken = true;
+    g_cond_signal(&p->cond);
+    g_mutex_unlock(&p->lock);
+}
+
+bool argus_poll_progress(argus_poll_t *p, argus_progress_t *out)
+{
+    g_mutex_lock(&p->lock);
+    bool have = p->has_progress;
+    if (have) *out = p->progress;
+    g_mutex_unlock(&p->lock);
+    return have;
+}
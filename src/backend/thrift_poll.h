@@ -0,0 +1,95 @@
+#ifndef ARGUS_THRIFT_POLL_H
+#define ARGUS_THRIFT_POLL_H
+
+#include <glib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "argus/backend.h"
+
+/*
+ * Completion polling for HiveServer2-protocol operations submitted with
+ * runAsync=true.
+ *
+ * ExecuteStatement returns once the server has accepted the query; the
+ * backend then calls GetOperationStatus until the operation reaches a
+ * terminal state. The first polls are a few ms apart, so a short query is
+ * noticed almost at once; the wait then grows with the time the query has
+ * been running, up to ARGUS_POLL_MAX_MS, so a long ETL job costs a handful
+ * of status RPCs a minute.
+ *
+ * The backend's RPC lock is free between polls: a cancel from another thread
+ * reaches the server, and argus_poll_wake() ends the current wait so the
+ * CANCELED state is seen right away. When the polling thread runs a
+ * statement (argus/cancel.h), SQLCancel and the query timeout end the wait
+ * too, and the next step reports ARGUS_POLL_CANCELLED without a round trip;
+ * the backend then sends CancelOperation. The last status is kept as a progress
+ * snapshot that other threads read through argus_poll_progress().
+ */
+
+#define ARGUS_POLL_MIN_MS   2
+#define ARGUS_POLL_MAX_MS   2000
+
+typedef enum argus_poll_state {
+    ARGUS_POLL_RUNNING = 0,     /* initialized, pending or running */
+    ARGUS_POLL_FINISHED,
+    ARGUS_POLL_FAILED,          /* ERROR_STATE: message in the backend's
+                                 * last_error */
+    ARGUS_POLL_CANCELLED        /* CANCELED, CLOSED or TIMEDOUT */
+} argus_poll_state_t;
+
+/*
+ * One GetOperationStatus round trip: set *state and fill what the server
+ * reported in *progress (preset to "unknown"). Returns 0, or -1 when the
+ * RPC itself failed. Called with no backend lock held.
+ */
+typedef int (*argus_poll_fn)(void *conn, void *op, argus_poll_state_t *state,
+                             argus_progress_t *progress);
+
+typedef struct argus_poll {
+    GMutex            lock;
+    GCond             cond;
+    bool              woken;        /* argus_poll_wake since the last wait */
+    gint64            started;      /* monotonic us when polling began */
+    int               polls;        /* status RPCs made */
+    int               interval;     /* ms before the next poll */
+    argus_progress_t  progress;     /* as of the last poll */
+    bool              has_progress;
+} argus_poll_t;
+
+void argus_poll_init(argus_poll_t *p);
+void argus_poll_clear(argus_poll_t *p);
+
+/*
+ * The wait before the next poll: 1.5x the previous one, starting from
+ * ARGUS_POLL_MIN_MS, but at least a tenth of the time the query has run,
+ * and never more than ARGUS_POLL_MAX_MS.
+ */
+int argus_poll_next_interval(int prev_ms, int64_t elapsed_ms);
+
+/* Start the clock for a new operation; argus_poll_run does this itself */
+void argus_poll_start(argus_poll_t *p);
+
+/*
+ * One status check without waiting, for callers that schedule the waits
+ * themselves (backend.h poll). Returns 0 with *state set, and while it is
+ * still ARGUS_POLL_RUNNING *next_ms to the wait before the next check; 1
+ * when timeout_sec (> 0) has passed; -1 when the status RPC failed.
+ */
+int argus_poll_step(argus_poll_t *p, argus_poll_fn fn, void *conn, void *op,
+                    int timeout_sec, argus_poll_state_t *state, int *next_ms);
+
+/*
+ * Poll `op` until it leaves ARGUS_POLL_RUNNING. Returns 0 with *state set to
+ * the terminal state, 1 when timeout_sec (> 0) passed first, or -1 when a
+ * status RPC failed.
+ */
+int argus_poll_run(argus_poll_t *p, argus_poll_fn fn, void *conn, void *op,
+                   int timeout_sec, argus_poll_state_t *state);
+
+/* End the current wait early (after a cancel). Safe from any thread. */
+void argus_poll_wake(argus_poll_t *p);
+
+/* Copy the latest progress snapshot; false before the first poll. */
+bool argus_poll_progress(argus_poll_t *p, argus_progress_t *out);
+
+#endif /* ARGUS_THRIFT_POLL_H */
@@ -0,0 +1,286 @@
+/*
+ * thrift_prefetch.c - One-ahead FetchResults task (see thrift_prefetch.h).
+ */
+
+#include "thrift_prefetch.h"
+#include "argus/cancel.h"
+#include "argus/handle.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    JOB_QUEUED = 0,
+    JOB_RUNNING,
+    JOB_DONE
+} job_state_t;
+
+/* Shared by the operation that started it and the executor task, so that
+ * either can let go first */
+struct argus_prefetch_job {
+    gint                     refs;      /* the owner's and the task's */
+    GMutex                   lock;
+    GCond                    done;
+    job_state_t              state;
+    bool                     dropped;   /* given up before it ran */
+    argus_prefetch_close_fn  close;     /* deferred close, run after fn */
+    argus_cancel_t           cancel;    /* bound on the worker */
+    argus_row_cache_t        cache;     /* filled by the worker */
+    int                      rc;        /* fetch result */
+    argus_prefetch_fn        fn;
+    void                    *conn;
+    void                    *op;
+    int                      max_rows;
+    argus_prefetch_group_t  *group;
+};
+
+static void job_unref(argus_prefetch_job_t *job)
+{
+    if (!g_atomic_int_dec_and_test(&job->refs)) return;
+    argus_cancel_end(&job->cancel);
+    argus_cancel_clear(&job->cancel);
+    argus_row_cache_free(&job->cache);
+    g_cond_clear(&job->done);
+    g_mutex_clear(&job->lock);
+    free(job);
+}
+
+/* ── Connection group ────────────────────────────────────────── */
+
+void argus_prefetch_group_init(argus_prefetch_group_t *g)
+{
+    g_mutex_init(&g->lock);
+    g_cond_init(&g->idle);
+    g->jobs = NULL;
+}
+
+static void group_add(argus_prefetch_group_t *g, argus_prefetch_job_t *job)
+{
+    if (!g) return;
+    g_mutex_lock(&g->lock);
+    g->jobs = g_list_prepend(g->jobs, job);
+    g_mutex_unlock(&g->lock);
+}
+
+static void group_remove(argus_prefetch_group_t *g, argus_prefetch_job_t *job)
+{
+    if (!g) return;
+    g_mutex_lock(&g->lock);
+    g->jobs = g_list_remove(g->jobs, job);
+    if (!g->jobs) g_cond_broadcast(&g->idle);
+    g_mutex_unlock(&g->lock);
+}
+
+/* A job leaves the list before its task lets go of it, so the task's
+ * reference keeps every listed job alive while the lock is held. */
+void argus_prefetch_group_drain(argus_prefetch_group_t *g, bool interrupt)
+{
+    g_mutex_lock(&g->lock);
+    if (interrupt) {
+        for (GList *l = g->jobs; l; l = l->next)
+            argus_cancel_request(&((argus_prefetch_job_t *)l->data)->cancel);
+    }
+    while (g->jobs)
+        g_cond_wait(&g->idle, &g->lock);
+    g_mutex_unlock(&g->lock);
+}
+
+void argus_prefetch_group_clear(argus_prefetch_group_t *g)
+{
+    g_list_free(g->jobs);
+    g->jobs = NULL;
+    g_cond_clear(&g->idle);
+    g_mutex_clear(&g->lock);
+}
+
+/* ── Task ────────────────────────────────────────────────────── */
+
+static void prefetch_run(void *data)
+{
+    argus_prefetch_job_t *job = (argus_prefetch_job_t *)data;
+
+    /* Not if it was dropped, or taken over by the thread waiting for it */
+    g_mutex_lock(&job->lock);
+    bool run = job->state == JOB_QUEUED && !job->dropped;
+    if (run) job->state = JOB_RUNNING;
+    g_mutex_unlock(&job->lock);
+
+    if (run) {
+        argus_cancel_t *prev = argus_cancel_enter(&job->cancel);
+        int rc = job->fn(job->conn, job->op, job->max_rows, &job->cache);
+        argus_cancel_leave(prev);
+
+        g_mutex_lock(&job->lock);
+        job->rc = rc;
+        job->state = JOB_DONE;
+        argus_prefetch_close_fn close = job->close;
+        g_cond_broadcast(&job->done);
+        g_mutex_unlock(&job->lock);
+
+        /* The operation was closed while the fetch was on the wire */
+        if (close) close(job->conn, job->op);
+    }
+
+    group_remove(job->group, job);
+    job_unref(job);
+}
+
+/* Give up a job its task has not picked up yet. It no longer touches the
+ * connection, so it leaves the group at once. Returns false if it had
+ * already started. */
+static bool job_drop(argus_prefetch_job_t *job)
+{
+    g_mutex_lock(&job->lock);
+    bool queued = job->state == JOB_QUEUED;
+    if (queued) job->dropped = true;
+    g_mutex_unlock(&job->lock);
+    if (queued) group_remove(job->group, job);
+    return queued;
+}
+
+/* Abort action forwarding a cancel of the waiting thread's token */
+static void prefetch_interrupt(void *data)
+{
+    argus_prefetch_job_t *job = (argus_prefetch_job_t *)data;
+    argus_cancel_request(&job->cancel);
+}
+
+/* ── Operation side ──────────────────────────────────────────── */
+
+int argus_prefetch_start(argus_prefetch_t *pf, argus_prefetch_group_t *group,
+                         argus_prefetch_fn fn, void *conn, void *op,
+                         int max_rows)
+{
+    if (!pf || !fn || pf->job) return -1;
+
+    argus_prefetch_job_t *job = calloc(1, sizeof(*job));
+    if (!job) return -1;
+    g_mutex_init(&job->lock);
+    g_cond_init(&job->done);
+    argus_cancel_init(&job->cancel);
+    argus_cancel_begin(&job->cancel, 0);
+    job->refs = 2;
+    job->state = JOB_QUEUED;
+    job->rc = -1;
+    job->fn = fn;
+    job->conn = conn;
+    job->op = op;
+    job->max_rows = max_rows;
+    job->group = group;
+
+    /* The job owns the row array recycled from the previous take until it
+     * is taken; it starts empty. */
+    argus_row_cache_clear(&pf->cache);
+    job->cache = pf->cache;
+    argus_row_cache_init(&pf->cache);
+
+    group_add(group, job);
+    if (!argus_executor_submit(prefetch_run, job)) {
+        group_remove(group, job);
+        pf->cache = job->cache;
+        argus_row_cache_init(&job->cache);
+        job->refs = 1;
+        job_unref(job);
+        return -1;
+    }
+    pf->job = job;
+    return 0;
+}
+
+int argus_prefetch_take(argus_prefetch_t *pf, argus_row_cache_t *out)
+{
+    if (!pf || !pf->job) return -1;
+    argus_prefetch_job_t *job = pf->job;
+    pf->job = NULL;
+
+    g_mutex_lock(&job->lock);
+    bool claimed = job->state == JOB_QUEUED;
+    if (claimed) job->state = JOB_RUNNING;
+    g_mutex_unlock(&job->lock);
+
+    int rc;
+    if (claimed) {
+        /* Still queued behind other tasks, perhaps behind the one running
+         * this very call: fetch here rather than wait for a worker. The
+         * caller's own token covers it. */
+        rc = job->fn(job->conn, job->op, job->max_rows, &job->cache);
+        group_remove(job->group, job);
+    } else {
+        argus_cancel_t *cancel = argus_cancel_current();
+        if (!argus_cancel_push(cancel, prefetch_interrupt, job))
+            argus_cancel_request(&job->cancel);
+
+        /* The lock publishes every write the worker made to job->cache. */
+        g_mutex_lock(&job->lock);
+        while (job->state != JOB_DONE)
+            g_cond_wait(&job->done, &job->lock);
+        rc = job->rc;
+        g_mutex_unlock(&job->lock);
+        argus_cancel_pop(cancel);
+    }
+
+    /* Swap row arrays: `out` receives the fetched rows, the prefetcher keeps
+     * out's (already cleared) storage for the next round. */
+    argus_row_t *spare = out->rows;
+    size_t spare_cap = out->capacity;
+
+    out->rows = job->cache.rows;
+    out->num_rows = job->cache.num_rows;
+    out->capacity = job->cache.capacity;
+    out->current_row = 0;
+    if (job->cache.num_cols > 0)
+        out->num_cols = job->cache.num_cols;
+
+    pf->cache.rows = spare;
+    pf->cache.num_rows = 0;
+    pf->cache.capacity = spare_cap;
+    pf->cache.current_row = 0;
+
+    argus_row_cache_init(&job->cache);
+    job_unref(job);
+    return rc;
+}
+
+void argus_prefetch_cancel(argus_prefetch_t *pf)
+{
+    if (pf && pf->job)
+        argus_cancel_request(&pf->job->cancel);
+}
+
+void argus_prefetch_close(argus_prefetch_t *pf, bool interrupt,
+                          argus_prefetch_close_fn close, void *conn,
+                          void *op)
+{
+    /* `pf` usually lives in `op`: let go of it before closing */
+    argus_prefetch_job_t *job = pf->job;
+    pf->job = NULL;
+    argus_row_cache_free(&pf->cache);
+
+    bool deferred = false;
+    if (job && !job_drop(job)) {
+        if (interrupt) argus_cancel_request(&job->cancel);
+        g_mutex_lock(&job->lock);
+        if (job->state != JOB_DONE) {
+            job->close = close;
+            deferred = true;
+        }
+        g_mutex_unlock(&job->lock);
+    }
+    if (job) job_unref(job);
+    if (!deferred) close(conn, op);
+}
+
+void argus_prefetch_discard(argus_prefetch_t *pf)
+{
+    if (!pf) return;
+    argus_prefetch_job_t *job = pf->job;
+    pf->job = NULL;
+    if (job && !job_drop(job)) {
+        g_mutex_lock(&job->lock);
+        while (job->state != JOB_DONE)
+            g_cond_wait(&job->done, &job->lock);
+        g_mutex_unlock(&job->lock);
+    }
+    if (job) job_unref(job);
+    argus_row_cache_free(&pf->cache);
+}
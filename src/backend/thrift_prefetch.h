@@ -0,0 +1,108 @@
+#ifndef ARGUS_THRIFT_PREFETCH_H
+#define ARGUS_THRIFT_PREFETCH_H
+
+#include <glib.h>
+#include <stdbool.h>
+#include "argus/types.h"
+
+/*
+ * One-ahead FetchResults pipelining for the HiveServer2-protocol backends.
+ *
+ * After a batch is handed to the ODBC layer, the backend starts the next
+ * FetchResults as a task on the shared executor (executor.c) into a private
+ * row cache. The following fetch_results() call waits for that task and
+ * swaps its cache into the statement's, so the server assembles chunk N+1
+ * while the application consumes chunk N. The two caches ping-pong their
+ * row arrays, so steady state allocates no row storage.
+ *
+ * Each prefetch runs under its own cancel token (argus/cancel.h), bound on
+ * the worker, so the abort action the fetch callback registers reaches it:
+ *  - while the application waits for it, SQLCancel and the query timeout
+ *    are forwarded to it, as for a fetch made on the application thread;
+ *  - closing the operation never waits for it: a fetch not started yet is
+ *    dropped, and one on the wire is either interrupted (when the transport
+ *    can drop one request and keep the connection) or left to finish, with
+ *    the close carried out on its worker afterwards.
+ *
+ * The fetch callback runs concurrently with the application thread; the
+ * backend must serialize its own Thrift client use (the Hive and Impala
+ * connections hold an RPC lock around every call).
+ */
+
+typedef int (*argus_prefetch_fn)(void *conn, void *op, int max_rows,
+                                 argus_row_cache_t *cache);
+
+/* Closes `op` once no prefetch uses it (argus_prefetch_close) */
+typedef void (*argus_prefetch_close_fn)(void *conn, void *op);
+
+typedef struct argus_prefetch_job argus_prefetch_job_t;
+
+/*
+ * The prefetches of one connection, so disconnecting can wait for the ones
+ * still carrying a deferred close. Zeroed, then argus_prefetch_group_init.
+ */
+typedef struct argus_prefetch_group {
+    GMutex   lock;
+    GCond    idle;
+    GList   *jobs;        /* may still use the connection */
+} argus_prefetch_group_t;
+
+typedef struct argus_prefetch {
+    argus_prefetch_job_t *job;      /* started and not taken, or NULL */
+    argus_row_cache_t     cache;    /* row storage for the next job */
+} argus_prefetch_t;
+
+/* True while a fetch started by argus_prefetch_start has not been taken. */
+static inline bool argus_prefetch_pending(const argus_prefetch_t *pf)
+{
+    return pf->job != NULL;
+}
+
+void argus_prefetch_group_init(argus_prefetch_group_t *g);
+
+/*
+ * Wait for every prefetch of the connection to finish, deferred closes
+ * included; with `interrupt`, ask those on the wire to stop first. Called
+ * before the connection is torn down.
+ */
+void argus_prefetch_group_drain(argus_prefetch_group_t *g, bool interrupt);
+void argus_prefetch_group_clear(argus_prefetch_group_t *g);
+
+/*
+ * Start fetching the next `max_rows` in the background, tracked in `group`
+ * (may be NULL). Returns 0 when the task was queued, -1 if one is already
+ * pending or the executor refused it (the caller then simply fetches
+ * synchronously next time).
+ */
+int argus_prefetch_start(argus_prefetch_t *pf, argus_prefetch_group_t *group,
+                         argus_prefetch_fn fn, void *conn, void *op,
+                         int max_rows);
+
+/*
+ * Wait for the pending fetch and move its rows into `out` (whose contents
+ * must already be cleared; its row array is recycled for the next
+ * prefetch). A cancel of the token bound to the calling thread interrupts
+ * the fetch; one no worker has picked up yet runs on the calling thread
+ * instead, so a caller on the executor never waits for its own pool.
+ * Returns the fetch result.
+ */
+int argus_prefetch_take(argus_prefetch_t *pf, argus_row_cache_t *out);
+
+/* Ask the pending fetch to stop, without waiting for it. */
+void argus_prefetch_cancel(argus_prefetch_t *pf);
+
+/*
+ * Give up the pending fetch and call close(conn, op): here and now when no
+ * fetch is on the wire, otherwise on the worker once it returns, which this
+ * does not wait for (with `interrupt` it is asked to stop first). Either
+ * way `op` must not be used by the caller afterwards.
+ */
+void argus_prefetch_close(argus_prefetch_t *pf, bool interrupt,
+                          argus_prefetch_close_fn close, void *conn,
+                          void *op);
+
+/* Drop a pending fetch not started yet or wait for one on the wire, then
+ * free everything the prefetcher holds. */
+void argus_prefetch_discard(argus_prefetch_t *pf);
+
+#endif /* ARGUS_THRIFT_PREFETCH_H */
@@ -33,6 +33,10 @@ int trino_fetch_results(argus_backend_conn_t conn,
                         argus_column_desc_t *columns,
                         int *num_cols);
 
+int trino_poll(argus_backend_conn_t conn,
+               argus_backend_op_t op,
+               bool *finished, int *next_ms);
+
 int trino_get_result_metadata(argus_backend_conn_t conn,
                                argus_backend_op_t op,
                                argus_column_desc_t *columns,
@@ -77,6 +81,9 @@ bool trino_get_last_error(argus_backend_conn_t conn, char *buf, size_t buflen);
 
 bool trino_get_server_version(argus_backend_conn_t conn, char *buf, size_t buflen);
 
+bool trino_get_progress(argus_backend_conn_t conn, argus_backend_op_t op,
+                        argus_progress_t *out);
+
 /* Trino backend vtable */
 static const argus_backend_t trino_backend = {
     .name                  = "trino",
@@ -98,6 +105,9 @@ static const argus_backend_t trino_backend = {
     .get_statistics        = trino_get_statistics,
     .get_last_error        = trino_get_last_error,
     .get_server_version    = trino_get_server_version,
+    .get_progress          = trino_get_progress,
+    .submit                = trino_execute,
+    .poll                  = trino_poll,
 };
 
 const argus_backend_t *argus_trino_backend_get(void)
@@ -303,8 +303,8 @@ static const char *sj_value_to_cell(const char *p, const char *e, argus_cell_t *
 
 /* Scan a `data` array [ds,de) (array-of-arrays) straight into the row cache.
  * Returns 0 on success, -1 to signal the caller should fall back to json-glib. */
-static int sj_scan_data(const char *ds, const char *de,
-                        argus_row_cache_t *cache, int num_cols)
+int sj_scan_data(const char *ds, const char *de,
+                 argus_row_cache_t *cache, int num_cols)
 {
     const char *p = sj_ws(ds, de);
     if (p >= de || *p != '[') return -1;
@@ -363,8 +363,8 @@ fail:
 
 /* Locate the value bounds of a named member in the top-level object. Returns 0
  * (found, *vs/*ve set), 1 (absent), or -1 (malformed). */
-static int sj_find_member(const char *text, size_t len, const char *key,
-                          const char **vs, const char **ve)
+int sj_find_member(const char *text, size_t len, const char *key,
+                   const char **vs, const char **ve)
 {
     const char *p = text, *e = text + len;
     p = sj_ws(p, e);
@@ -398,6 +398,27 @@ static int sj_find_member(const char *text, size_t len, const char *key,
 
 /* ── FetchResults via Trino REST API ─────────────────────────── */
 
+/* Trino sizes result pages by bytes, not rows. Once a page has shown how
+ * large a row is, ask for about max_rows of them with targetResultSize
+ * (the server caps it at 128MB). NULL when next_uri is used as is. */
+static char *trino_page_uri(const trino_operation_t *op, int max_rows)
+{
+    if (max_rows <= 0 || op->page_row_bytes <= 0 || op->spooling_active)
+        return NULL;
+    double kb = op->page_row_bytes * (double)max_rows / 1024.0;
+    if (kb < 1.0) kb = 1.0;
+    if (kb > 128.0 * 1024.0) kb = 128.0 * 1024.0;
+    return g_strdup_printf("%s%ctargetResultSize=%.0fkB", op->next_uri,
+                           strchr(op->next_uri, '?') ? '&' : '?', kb);
+}
+
+static void trino_note_page(trino_operation_t *op, size_t resp_len,
+                            const argus_row_cache_t *cache)
+{
+    if (cache->num_rows > 0 && !op->spooling_active)
+        op->page_row_bytes = (double)resp_len / (double)cache->num_rows;
+}
+
 int trino_fetch_results(argus_backend_conn_t raw_conn,
                         argus_backend_op_t raw_op,
                         int max_rows,
@@ -409,8 +430,6 @@ int trino_fetch_results(argus_backend_conn_t raw_conn,
     trino_operation_t *op = (trino_operation_t *)raw_op;
     if (!conn || !op) return -1;
 
-    (void)max_rows;
-
     /* Return metadata if available */
     if (!op->metadata_fetched && columns && num_cols) {
         trino_get_result_metadata(raw_conn, raw_op, columns, num_cols);
@@ -445,7 +464,12 @@ int trino_fetch_results(argus_backend_conn_t raw_conn,
     /* Poll nextUri until we get data or query finishes */
     while (op->next_uri) {
         trino_response_t resp = {0};
-        if (trino_http_get(conn, op->next_uri, &resp) != 0) {
+        char *page_uri = trino_page_uri(op, max_rows);
+        int hrc = trino_http_request(conn, "GET",
+                                     page_uri ? page_uri : op->next_uri,
+                                     NULL, &resp, &op->progress);
+        g_free(page_uri);
+        if (hrc != 0) {
             free(resp.data);
             return -1;
         }
@@ -476,6 +500,7 @@ int trino_fetch_results(argus_backend_conn_t raw_conn,
                     int ok = json_parser_load_from_data(ep, env, -1, NULL);
                     JsonObject *eo = ok ? json_node_get_object(json_parser_get_root(ep)) : NULL;
                     if (eo) {
+                        trino_capture_stats(conn, op, eo);
                         if (!op->metadata_fetched && json_object_has_member(eo, "columns")) {
                             JsonNode *cn = json_object_get_member(eo, "columns");
                             op->columns = calloc(ARGUS_MAX_COLUMNS, sizeof(argus_column_desc_t));
@@ -499,6 +524,7 @@ int trino_fetch_results(argus_backend_conn_t raw_conn,
                         int ncols = op->num_cols > 0 ? op->num_cols : 1;
                         int sr = sj_scan_data(ds, de, cache, ncols);
                         if (sr == 0) {
+                            trino_note_page(op, rlen, cache);
                             if (!op->next_uri) cache->exhausted = true;
                             g_object_unref(ep);
                             free(env);
@@ -530,6 +556,7 @@ int trino_fetch_results(argus_backend_conn_t raw_conn,
             free(resp.data);
             return -1;
         }
+        trino_capture_stats(conn, op, obj);
 
         /* Parse column metadata if not yet fetched */
         if (!op->metadata_fetched && json_object_has_member(obj, "columns")) {
@@ -564,11 +591,13 @@ int trino_fetch_results(argus_backend_conn_t raw_conn,
             if (JSON_NODE_HOLDS_ARRAY(data_node)) {
                 /* v1 format: flat array of arrays */
                 trino_parse_data(data_node, cache, ncols);
+                trino_note_page(op, strlen(resp.data), cache);
             } else if (JSON_NODE_HOLDS_OBJECT(data_node)) {
                 /* v2 format: spooled segments object */
                 JsonObject *data_obj = json_node_get_object(data_node);
                 op->spooling_active = true;
-                trino_parse_spooled_data(conn, data_obj, cache, ncols);
+                trino_parse_spooled_data(conn, data_obj, cache, ncols,
+                                         &op->progress);
             }
 
             if (!op->next_uri)
@@ -595,6 +624,93 @@ int trino_fetch_results(argus_backend_conn_t raw_conn,
     return 0;
 }
 
+/* ── Advance a running query ──────────────────────────────────── */
+
+/*
+ * One GET on nextUri: record the columns, stats and any first rows that
+ * came back, and move nextUri on. Returns 0, or -1 on a transport or query
+ * error (last_error set for the latter).
+ */
+static int trino_advance(trino_conn_t *conn, trino_operation_t *op)
+{
+    trino_response_t resp = {0};
+    if (trino_http_request(conn, "GET", op->next_uri, NULL, &resp,
+                           &op->progress) != 0) {
+        free(resp.data);
+        return -1;
+    }
+
+    if (!resp.data) return -1;
+
+    JsonParser *parser = json_parser_new();
+    if (!json_parser_load_from_data(parser, resp.data, -1, NULL)) {
+        g_object_unref(parser);
+        free(resp.data);
+        return -1;
+    }
+
+    JsonNode *root = json_parser_get_root(parser);
+    JsonObject *obj = json_node_get_object(root);
+
+    /* The query may have failed during planning/execution; the error
+     * surfaces here while polling for the result. */
+    if (json_object_has_member(obj, "error")) {
+        trino_capture_error(conn, obj);
+        g_object_unref(parser);
+        free(resp.data);
+        return -1;
+    }
+    trino_capture_stats(conn, op, obj);
+
+    /* Parse column metadata */
+    if (json_object_has_member(obj, "columns")) {
+        if (!op->columns)
+            op->columns = calloc(ARGUS_MAX_COLUMNS,
+                                 sizeof(argus_column_desc_t));
+        if (op->columns && op->num_cols == 0) {
+            JsonNode *columns_node = json_object_get_member(obj, "columns");
+            trino_parse_columns(columns_node, op->columns, &op->num_cols);
+        }
+        /* A SELECT stops here and fetches data lazily. An update statement
+         * (INSERT/UPDATE/DELETE/...) carries "updateType" and only applies
+         * its write once the client drains the query to FINISHED, so keep
+         * polling rather than abandoning it mid-flight. */
+        if (op->columns && !json_object_has_member(obj, "updateType"))
+            op->metadata_fetched = true;
+    }
+
+    /* Update nextUri */
+    free(op->next_uri);
+    op->next_uri = NULL;
+    if (json_object_has_member(obj, "nextUri")) {
+        op->next_uri = strdup(
+            json_object_get_string_member(obj, "nextUri"));
+    } else {
+        op->finished = true;
+    }
+
+    /* Trino can return columns and the first data rows in the same
+     * response. Since this response is now consumed, stash that data for
+     * the next fetch_results rather than dropping it (small results would
+     * otherwise come back with zero rows). */
+    if (op->metadata_fetched && !op->prefetch &&
+        json_object_has_member(obj, "data")) {
+        JsonNode *data_node = json_object_get_member(obj, "data");
+        if (JSON_NODE_HOLDS_ARRAY(data_node)) {
+            op->prefetch = calloc(1, sizeof(argus_row_cache_t));
+            if (op->prefetch) {
+                argus_row_cache_init(op->prefetch);
+                trino_parse_data(data_node, op->prefetch,
+                                 op->num_cols > 0 ? op->num_cols : 1);
+            }
+        }
+    }
+
+    g_object_unref(parser);
+    free(resp.data);
+    return 0;
+}
+
 /* ── Get result set metadata ──────────────────────────────────── */
 
 int trino_get_result_metadata(argus_backend_conn_t raw_conn,
@@ -618,79 +734,7 @@ int trino_get_result_metadata(argus_backend_conn_t raw_conn,
 
     /* Poll nextUri until we get columns metadata */
     while (op->next_uri && !op->metadata_fetched) {
-        trino_response_t resp = {0};
-        if (trino_http_get(conn, op->next_uri, &resp) != 0) {
-            free(resp.data);
-            return -1;
-        }
-
-        if (!resp.data) return -1;
-
-        JsonParser *parser = json_parser_new();
-        if (!json_parser_load_from_data(parser, resp.data, -1, NULL)) {
-            g_object_unref(parser);
-            free(resp.data);
-            return -1;
-        }
-
-        JsonNode *root = json_parser_get_root(parser);
-        JsonObject *obj = json_node_get_object(root);
-
-        /* The query may have failed during planning/execution; the error
-         * surfaces here while polling for the result. */
-        if (json_object_has_member(obj, "error")) {
-            trino_capture_error(conn, obj);
-            g_object_unref(parser);
-            free(resp.data);
-            return -1;
-        }
-
-        /* Parse column metadata */
-        if (json_object_has_member(obj, "columns")) {
-            if (!op->columns)
-                op->columns = calloc(ARGUS_MAX_COLUMNS,
-                                     sizeof(argus_column_desc_t));
-            if (op->columns && op->num_cols == 0) {
-                JsonNode *columns_node = json_object_get_member(obj, "columns");
-                trino_parse_columns(columns_node, op->columns, &op->num_cols);
-            }
-            /* A SELECT stops here and fetches data lazily. An update statement
-             * (INSERT/UPDATE/DELETE/...) carries "updateType" and only applies
-             * its write once the client drains the query to FINISHED, so keep
-             * polling rather than abandoning it mid-flight. */
-            if (op->columns && !json_object_has_member(obj, "updateType"))
-                op->metadata_fetched = true;
-        }
-
-        /* Update nextUri */
-        free(op->next_uri);
-        op->next_uri = NULL;
-        if (json_object_has_member(obj, "nextUri")) {
-            op->next_uri = strdup(
-                json_object_get_string_member(obj, "nextUri"));
-        } else {
-            op->finished = true;
-        }
-
-        /* Trino can return columns and the first data rows in the same
-         * response. Since this response is now consumed, stash that data for
-         * the next fetch_results rather than dropping it (small results would
-         * otherwise come back with zero rows). */
-        if (op->metadata_fetched && !op->prefetch &&
-            json_object_has_member(obj, "data")) {
-            JsonNode *data_node = json_object_get_member(obj, "data");
-            if (JSON_NODE_HOLDS_ARRAY(data_node)) {
-                op->prefetch = calloc(1, sizeof(argus_row_cache_t));
-                if (op->prefetch) {
-                    argus_row_cache_init(op->prefetch);
-                    trino_parse_data(data_node, op->prefetch,
-                                     op->num_cols > 0 ? op->num_cols : 1);
-                }
-            }
-        }
-
-        g_object_unref(parser);
-        free(resp.data);
+        if (trino_advance(conn, op) != 0) return -1;
     }
 
     if (op->metadata_fetched && columns && num_cols) {
@@ -701,3 +745,27 @@ int trino_get_result_metadata(argus_backend_conn_t raw_conn,
 
     return op->metadata_fetched ? 0 : -1;
 }
+
+/* ── Non-blocking execution (backend.h submit/poll) ───────────── */
+
+/*
+ * trino_execute already returns once the coordinator has the query, so it
+ * is the submit hook. Each poll is one nextUri request; the coordinator
+ * holds that request until the query has moved on (up to its maxWait), so
+ * the next one can be issued at once.
+ */
+int trino_poll(argus_backend_conn_t raw_conn,
+               argus_backend_op_t raw_op,
+               bool *finished, int *next_ms)
+{
+    trino_conn_t *conn = (trino_conn_t *)raw_conn;
+    trino_operation_t *op = (trino_operation_t *)raw_op;
+    if (!conn || !op) return -1;
+
+    if (op->next_uri && !op->metadata_fetched &&
+        trino_advance(conn, op) != 0)
+        return -1;
+    *finished = !op->next_uri || op->metadata_fetched;
+    *next_ms = 0;
+    return 0;
+}
@@ -15,9 +15,12 @@ typedef enum {
     TRINO_AUTH_NEGOTIATE    /* Kerberos / SPNEGO via libcurl Negotiate */
 } trino_auth_mode_t;
 
+/* One HTTP exchange on a connection's event loop (trino_transport.c) */
+typedef struct trino_xfer trino_xfer_t;
+
 /* Trino connection state */
 typedef struct trino_conn {
-    CURL               *curl;
+    CURL               *curl;           /* option template; duplicated per transfer */
     char               *base_url;       /* e.g. "http://host:port" or "https://..." */
     char               *user;
     bool                user_explicit;  /* UID given (vs the "argus" default) */
@@ -27,6 +30,21 @@ typedef struct trino_conn {
     char               *schema;
     char               *app_name;       /* X-Trino-Source (NULL if unset) */
     struct curl_slist   *default_headers;
+    GSList             *retired_headers;    /* replaced on token refresh; may
+                                             * still be in flight, freed at
+                                             * disconnect */
+
+    /* Event loop shared by every statement on the connection: transfers run
+     * concurrently on one curl multi handle, multiplexed over a single
+     * connection with HTTP/2. Whichever waiting thread finds the loop idle
+     * drives it; the others sleep on loop_cond. loop_lock guards everything
+     * below, default_headers and the operations' progress. */
+    CURLM              *multi;
+    GMutex              loop_lock;
+    GCond               loop_cond;
+    bool                loop_driving;   /* a thread is inside the loop */
+    GQueue              loop_pending;   /* trino_xfer_t not yet on `multi` */
+    GQueue              loop_idle;      /* finished easy handles for reuse */
 
     /* OAuth2 client-credentials (M2M) params, retained so the access token can
      * be transparently re-fetched when the server returns 401 (token expiry). */
@@ -44,6 +62,7 @@ typedef struct trino_conn {
     char               *ssl_key_file;
     char               *ssl_ca_file;
     bool                ssl_verify;
+    bool                http2;          /* negotiate HTTP/2 over TLS */
 
     /* Timeout settings */
     int                 connect_timeout_sec;
@@ -82,6 +101,14 @@ typedef struct trino_operation {
      * (Trino can send columns + data in the same response); delivered by the
      * next fetch_results. NULL when there is none. */
     argus_row_cache_t   *prefetch;
+
+    /* JSON bytes per row of the latest inline page, 0 until one arrives;
+     * turns the driver's requested rows into a targetResultSize */
+    double               page_row_bytes;
+
+    /* Server stats from the latest response plus bytes received; guarded
+     * by the connection's loop_lock */
+    argus_progress_t     progress;
 } trino_operation_t;
 
 /* Type mapping helpers */
@@ -97,6 +124,10 @@ void trino_operation_free(trino_operation_t *op);
  * connection so the ODBC layer can surface it; clears it when absent. */
 void trino_capture_error(trino_conn_t *conn, JsonObject *obj);
 
+/* Record a response's "stats" member as the operation's progress. */
+void trino_capture_stats(trino_conn_t *conn, trino_operation_t *op,
+                         JsonObject *obj);
+
 /* CURL response buffer */
 typedef struct trino_response {
     char   *data;
@@ -106,6 +137,28 @@ typedef struct trino_response {
 /* CURL write callback */
 size_t trino_curl_write_cb(void *contents, size_t size, size_t nmemb, void *userp);
 
+/* Connection event loop (trino_transport.c) */
+int  trino_transport_init(trino_conn_t *conn);
+void trino_transport_cleanup(trino_conn_t *conn);
+
+/* Queue a request on the event loop and return at once. `body` must stay
+ * valid until the transfer is waited for; `progress` (may be NULL) counts
+ * the bytes received. Returns NULL on failure. */
+trino_xfer_t *trino_http_start(trino_conn_t *conn, const char *method,
+                               const char *url, const char *body,
+                               trino_response_t *resp,
+                               argus_progress_t *progress);
+
+/* Block until `xfer` completes, driving the loop meanwhile, and free it.
+ * Returns -1 on transport failure; the HTTP status goes to *http_code. */
+int trino_http_wait(trino_conn_t *conn, trino_xfer_t *xfer, long *http_code);
+
+/* Blocking request; refreshes an OAuth2 (M2M) token once on 401.
+ * Returns -1 on transport failure or an HTTP status >= 400. */
+int trino_http_request(trino_conn_t *conn, const char *method,
+                       const char *url, const char *body,
+                       trino_response_t *resp, argus_progress_t *progress);
+
 /* HTTP request helpers */
 int trino_http_post(trino_conn_t *conn, const char *url, const char *body,
                     trino_response_t *resp);
@@ -113,8 +166,13 @@ int trino_http_get(trino_conn_t *conn, const char *url,
                    trino_response_t *resp);
 int trino_http_delete(trino_conn_t *conn, const char *url);
 
+/* Re-fetch the OAuth2 (M2M) access token after a 401 (trino_session.c) */
+int trino_refresh_oauth_token(trino_conn_t *conn);
+
 /* Query operations */
 int trino_cancel(argus_backend_conn_t conn, argus_backend_op_t op);
+bool trino_get_progress(argus_backend_conn_t conn, argus_backend_op_t op,
+                        argus_progress_t *out);
 
 /* Parse column metadata from Trino JSON response */
 int trino_parse_columns(JsonNode *columns_node,
@@ -126,9 +184,18 @@ int trino_parse_data(JsonNode *data_node,
                      argus_row_cache_t *cache,
                      int num_cols);
 
+/* DOM-free scanner (trino_fetch.c): bounds of a top-level member of a
+ * response, and its `data` array [ds,de) straight into the row cache.
+ * sj_scan_data returns -1 when the caller should fall back to json-glib. */
+int sj_find_member(const char *text, size_t len, const char *key,
+                   const char **vs, const char **ve);
+int sj_scan_data(const char *ds, const char *de,
+                 argus_row_cache_t *cache, int num_cols);
+
 /* v2 spooling: parse segments from data object */
 int trino_parse_spooled_data(trino_conn_t *conn, JsonObject *data_obj,
-                             argus_row_cache_t *cache, int num_cols);
+                             argus_row_cache_t *cache, int num_cols,
+                             argus_progress_t *progress);
 
 /* v2 spooling: fetch a spooled segment by URI */
 int trino_fetch_segment(trino_conn_t *conn, const char *uri,
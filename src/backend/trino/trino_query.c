@@ -8,6 +8,8 @@
 trino_operation_t *trino_operation_new(void)
 {
     trino_operation_t *op = calloc(1, sizeof(trino_operation_t));
+    if (op)
+        op->progress.percent = -1.0;
     return op;
 }
 
@@ -24,6 +26,61 @@ void trino_operation_free(trino_operation_t *op)
     free(op);
 }
 
+/* ── Progress ─────────────────────────────────────────────────── */
+
+static int64_t stats_int(JsonObject *stats, const char *member)
+{
+    return json_object_has_member(stats, member)
+        ? (int64_t)json_object_get_int_member(stats, member) : 0;
+}
+
+void trino_capture_stats(trino_conn_t *conn, trino_operation_t *op,
+                         JsonObject *obj)
+{
+    if (!conn || !op || !obj || !json_object_has_member(obj, "stats")) return;
+    JsonObject *stats = json_object_get_object_member(obj, "stats");
+    if (!stats) return;
+
+    /* progressPercentage is only sent once the query is scheduled; fall
+     * back to the split counts before that. */
+    double percent = -1.0;
+    if (json_object_has_member(stats, "progressPercentage")) {
+        percent = json_object_get_double_member(stats, "progressPercentage");
+    } else {
+        int64_t total = stats_int(stats, "totalSplits");
+        if (total > 0)
+            percent = 100.0 * (double)stats_int(stats, "completedSplits")
+                      / (double)total;
+    }
+    const char *state = json_object_has_member(stats, "state")
+        ? json_object_get_string_member(stats, "state") : NULL;
+
+    g_mutex_lock(&conn->loop_lock);
+    argus_progress_t *p = &op->progress;
+    p->percent         = percent;
+    p->rows_processed  = stats_int(stats, "processedRows");
+    p->bytes_processed = stats_int(stats, "processedBytes");
+    p->elapsed_ms      = stats_int(stats, "elapsedTimeMillis");
+    if (state) {
+        strncpy(p->state, state, sizeof(p->state) - 1);
+        p->state[sizeof(p->state) - 1] = '\0';
+    }
+    g_mutex_unlock(&conn->loop_lock);
+}
+
+bool trino_get_progress(argus_backend_conn_t raw_conn, argus_backend_op_t raw_op,
+                        argus_progress_t *out)
+{
+    trino_conn_t *conn = (trino_conn_t *)raw_conn;
+    trino_operation_t *op = (trino_operation_t *)raw_op;
+    if (!conn || !op || !out) return false;
+
+    g_mutex_lock(&conn->loop_lock);
+    *out = op->progress;
+    g_mutex_unlock(&conn->loop_lock);
+    return true;
+}
+
 /* ── Execute a statement via Trino REST API ──────────────────── */
 
 int trino_execute(argus_backend_conn_t raw_conn,
@@ -73,6 +130,9 @@ int trino_execute(argus_backend_conn_t raw_conn,
         return -1;
     }
 
+    op->progress.bytes_received = (int64_t)resp.size;
+    trino_capture_stats(conn, op, obj);
+
     /* Extract query ID */
     if (json_object_has_member(obj, "id")) {
         op->query_id = strdup(json_object_get_string_member(obj, "id"));
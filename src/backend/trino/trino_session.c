@@ -7,6 +7,7 @@
 #include <string.h>
 #include <stdio.h>
 #include "argus/compat.h"
+#include "../http_client.h"
 #ifdef _WIN32
 #include <winsock2.h>
 #include <ws2tcpip.h>
@@ -24,67 +25,35 @@ typedef int argus_sock_t;
 #endif
 
 /* Forward declarations for the OAuth2 token-refresh path. */
-static int trino_refresh_oauth_token(trino_conn_t *conn);
 static int trino_fetch_device_token(trino_conn_t *conn, char **out_token);
 static int trino_fetch_authcode_token(trino_conn_t *conn, char **out_token);
 static void trino_oidc_discover(trino_conn_t *conn, const char *issuer);
 
-/* ── Helper: Apply SSL and timeout settings to curl ─────────────── */
+/* ── Helper: per-connection HTTP handle ─────────────────────────── */
 
-static void trino_apply_curl_settings(trino_conn_t *conn, CURL *curl)
+/* TLS, timeouts and Basic/Negotiate auth are fixed for the life of the
+ * connection, so they are applied once here. Bearer (JWT/OAuth2) goes in
+ * default_headers, which are rebuilt when the token is refreshed. */
+static CURL *trino_http_handle_new(trino_conn_t *conn)
 {
-    /* SSL/TLS settings */
-    if (conn->ssl_enabled) {
-        if (conn->ssl_verify) {
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
-        } else {
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
-        }
-
-        if (conn->ssl_cert_file) {
-            curl_easy_setopt(curl, CURLOPT_SSLCERT, conn->ssl_cert_file);
-        }
-        if (conn->ssl_key_file) {
-            curl_easy_setopt(curl, CURLOPT_SSLKEY, conn->ssl_key_file);
-        }
-        if (conn->ssl_ca_file) {
-            curl_easy_setopt(curl, CURLOPT_CAINFO, conn->ssl_ca_file);
-        }
-    }
-
-    /* Timeout settings */
-    if (conn->connect_timeout_sec > 0) {
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, (long)conn->connect_timeout_sec);
-    }
-    if (conn->query_timeout_sec > 0) {
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, (long)conn->query_timeout_sec);
-    }
-
-    /* Authentication. Bearer (JWT/OAuth2) is applied as a default header at
-     * connect time; Basic and Negotiate are set on the easy handle here because
-     * curl_easy_reset() wiped them at the start of each request. */
-    switch (conn->auth_mode) {
-    case TRINO_AUTH_BASIC: {
-        char userpwd[512];
-        snprintf(userpwd, sizeof(userpwd), "%s:%s",
-                 conn->user ? conn->user : "",
-                 conn->password ? conn->password : "");
-        curl_easy_setopt(curl, CURLOPT_HTTPAUTH, (long)CURLAUTH_BASIC);
-        curl_easy_setopt(curl, CURLOPT_USERPWD, userpwd);
-        break;
-    }
-    case TRINO_AUTH_NEGOTIATE:
-        /* Kerberos/SPNEGO via the ambient credential cache (kinit). */
-        curl_easy_setopt(curl, CURLOPT_HTTPAUTH, (long)CURLAUTH_NEGOTIATE);
-        curl_easy_setopt(curl, CURLOPT_USERPWD, ":");
-        break;
-    case TRINO_AUTH_BEARER:
-    case TRINO_AUTH_NONE:
-    default:
-        break;
-    }
+    argus_http_opts_t opts = {
+        .tls                 = conn->ssl_enabled,
+        .tls_verify          = conn->ssl_verify,
+        .ca_file             = conn->ssl_ca_file,
+        .cert_file           = conn->ssl_cert_file,
+        .key_file            = conn->ssl_key_file,
+        .connect_timeout_sec = conn->connect_timeout_sec,
+        .timeout_sec         = conn->query_timeout_sec,
+        .http2               = conn->http2,
+    };
+    if (conn->auth_mode == TRINO_AUTH_BASIC) {
+        opts.auth     = (long)CURLAUTH_BASIC;
+        opts.user     = conn->user;
+        opts.password = conn->password;
+    } else if (conn->auth_mode == TRINO_AUTH_NEGOTIATE) {
+        opts.auth = (long)CURLAUTH_NEGOTIATE;
+    }
+    return argus_http_handle_new(&opts);
 }
 
 /* ── CURL write callback ─────────────────────────────────────── */
@@ -106,124 +75,6 @@ size_t trino_curl_write_cb(void *contents, size_t size, size_t nmemb,
     return total;
 }
 
-/* ── HTTP helper: POST ───────────────────────────────────────── */
-
-int trino_http_post(trino_conn_t *conn, const char *url, const char *body,
-                    trino_response_t *resp)
-{
-    CURL *curl = conn->curl;
-
-    curl_easy_reset(curl);
-    trino_apply_curl_settings(conn, curl);
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, conn->default_headers);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, trino_curl_write_cb);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, resp);
-
-    resp->data = NULL;
-    resp->size = 0;
-
-    CURLcode res = curl_easy_perform(curl);
-    if (res != CURLE_OK)
-        return -1;
-
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-
-    /* OAuth2 (M2M) access token may have expired; refresh once and retry. */
-    if (http_code == 401 && conn->oauth_m2m &&
-        trino_refresh_oauth_token(conn) == 0) {
-        free(resp->data);
-        resp->data = NULL;
-        resp->size = 0;
-        curl_easy_reset(curl);
-        trino_apply_curl_settings(conn, curl);
-        curl_easy_setopt(curl, CURLOPT_URL, url);
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, conn->default_headers);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, trino_curl_write_cb);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, resp);
-        res = curl_easy_perform(curl);
-        if (res != CURLE_OK)
-            return -1;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    }
-
-    if (http_code >= 400)
-        return -1;
-
-    return 0;
-}
-
-/* ── HTTP helper: GET ────────────────────────────────────────── */
-
-int trino_http_get(trino_conn_t *conn, const char *url,
-                   trino_response_t *resp)
-{
-    CURL *curl = conn->curl;
-
-    curl_easy_reset(curl);
-    trino_apply_curl_settings(conn, curl);
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, conn->default_headers);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, trino_curl_write_cb);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, resp);
-
-    resp->data = NULL;
-    resp->size = 0;
-
-    CURLcode res = curl_easy_perform(curl);
-    if (res != CURLE_OK)
-        return -1;
-
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-
-    /* OAuth2 (M2M) access token may have expired; refresh once and retry. */
-    if (http_code == 401 && conn->oauth_m2m &&
-        trino_refresh_oauth_token(conn) == 0) {
-        free(resp->data);
-        resp->data = NULL;
-        resp->size = 0;
-        curl_easy_reset(curl);
-        trino_apply_curl_settings(conn, curl);
-        curl_easy_setopt(curl, CURLOPT_URL, url);
-        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, conn->default_headers);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, trino_curl_write_cb);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, resp);
-        res = curl_easy_perform(curl);
-        if (res != CURLE_OK)
-            return -1;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    }
-
-    if (http_code >= 400)
-        return -1;
-
-    return 0;
-}
-
-/* ── HTTP helper: DELETE ─────────────────────────────────────── */
-
-int trino_http_delete(trino_conn_t *conn, const char *url)
-{
-    CURL *curl = conn->curl;
-
-    curl_easy_reset(curl);
-    trino_apply_curl_settings(conn, curl);
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, conn->default_headers);
-
-    CURLcode res = curl_easy_perform(curl);
-    return (res == CURLE_OK) ? 0 : -1;
-}
-
 /* ── OAuth2 client-credentials: fetch an access token from the IdP ─── */
 
 static int trino_fetch_oauth_token_uncached(trino_conn_t *conn,
@@ -236,7 +87,7 @@ static int trino_fetch_oauth_token_uncached(trino_conn_t *conn,
         !conn->oauth_client_secret)
         return -1;
 
-    CURL *c = curl_easy_init();
+    CURL *c = argus_http_easy_init();
     if (!c) return -1;
 
     /* Build a client_secret_post body (widely accepted: Keycloak/Okta/Auth0). */
@@ -337,7 +188,7 @@ static int trino_fetch_oauth_token(trino_conn_t *conn, char **out_token)
 static JsonParser *trino_oauth_form_post(trino_conn_t *conn, const char *url,
                                          const char *body, long *http_code)
 {
-    CURL *c = curl_easy_init();
+    CURL *c = argus_http_easy_init();
     if (!c) return NULL;
     struct curl_slist *hdrs = curl_slist_append(
         NULL, "Content-Type: application/x-www-form-urlencoded");
@@ -382,7 +233,7 @@ static int trino_fetch_device_token(trino_conn_t *conn, char **out_token)
     if (!conn->oauth_device_url || !conn->oauth_token_url || !conn->oauth_client_id)
         return -1;
 
-    CURL *e = curl_easy_init();
+    CURL *e = argus_http_easy_init();
     if (!e) return -1;
     char *eid = curl_easy_escape(e, conn->oauth_client_id, 0);
     char *escope = conn->oauth_scope ? curl_easy_escape(e, conn->oauth_scope, 0) : NULL;
@@ -475,7 +326,7 @@ static void trino_oidc_discover(trino_conn_t *conn, const char *issuer)
     snprintf(url, sizeof(url), "%s%s.well-known/openid-configuration",
              issuer, issuer[strlen(issuer) - 1] == '/' ? "" : "/");
 
-    CURL *c = curl_easy_init();
+    CURL *c = argus_http_easy_init();
     if (!c) return;
     trino_response_t resp = {0};
     curl_easy_setopt(c, CURLOPT_URL, url);
@@ -653,7 +504,7 @@ static int trino_fetch_authcode_token(trino_conn_t *conn, char **out_token)
     char state[64] = {0};
     if (trino_rand_bytes(sr, sizeof(sr)) == 0) trino_b64url(sr, sizeof(sr), state, sizeof(state));
 
-    CURL *e = curl_easy_init();
+    CURL *e = argus_http_easy_init();
     char redirect[64];
     snprintf(redirect, sizeof(redirect), "http://127.0.0.1:%d/", port);
     char *ecid = curl_easy_escape(e, conn->oauth_client_id, 0);
@@ -715,7 +566,9 @@ static int trino_fetch_authcode_token(trino_conn_t *conn, char **out_token)
 static void trino_build_default_headers(trino_conn_t *conn)
 {
     if (conn->default_headers) {
-        curl_slist_free_all(conn->default_headers);
+        /* Another statement's transfer may still be sending the old list */
+        conn->retired_headers = g_slist_prepend(conn->retired_headers,
+                                                conn->default_headers);
         conn->default_headers = NULL;
     }
 
@@ -757,7 +610,7 @@ static void trino_build_default_headers(trino_conn_t *conn)
 
 /* ── Re-fetch an OAuth2 (M2M) access token and refresh the header ── */
 
-static int trino_refresh_oauth_token(trino_conn_t *conn)
+int trino_refresh_oauth_token(trino_conn_t *conn)
 {
     if (!conn->oauth_m2m) return -1;
 
@@ -774,9 +627,12 @@ static int trino_refresh_oauth_token(trino_conn_t *conn)
                                  (long long)(g_get_real_time() / 1000) +
                                      (long long)expires_in * 1000);
 
+    /* Other statements on the connection may be starting requests */
+    g_mutex_lock(&conn->loop_lock);
     free(conn->password);
     conn->password = tok;
     trino_build_default_headers(conn);
+    g_mutex_unlock(&conn->loop_lock);
     ARGUS_LOG_INFO("Trino: OAuth2 access token refreshed after 401");
     return 0;
 }
@@ -799,6 +655,7 @@ int trino_connect(argus_dbc_t *dbc,
     /* Copy SSL/TLS settings from DBC */
     conn->ssl_enabled = dbc->ssl_enabled;
     conn->ssl_verify = dbc->ssl_verify;
+    conn->http2 = dbc->http2;
     if (dbc->ssl_cert_file) conn->ssl_cert_file = strdup(dbc->ssl_cert_file);
     if (dbc->ssl_key_file) conn->ssl_key_file = strdup(dbc->ssl_key_file);
     if (dbc->ssl_ca_file) conn->ssl_ca_file = strdup(dbc->ssl_ca_file);
@@ -864,11 +721,15 @@ int trino_connect(argus_dbc_t *dbc,
                        "Trino normally requires TLS for password/token auth");
     }
 
-    /* Initialize CURL */
-    conn->curl = curl_easy_init();
-    if (!conn->curl) {
+    /* Per-connection HTTP handle on the shared DNS/TLS/connection caches */
+    conn->curl = trino_http_handle_new(conn);
+    if (!conn->curl || trino_transport_init(conn) != 0) {
         argus_set_error(&dbc->diag, "08001",
                         "[Argus][Trino] Failed to initialize HTTP client", 0);
+        if (conn->curl) {
+            trino_transport_cleanup(conn);
+            curl_easy_cleanup(conn->curl);
+        }
         free(conn->base_url);
         free(conn->user);
         free(conn->password);
@@ -925,6 +786,7 @@ int trino_connect(argus_dbc_t *dbc,
             snprintf(msg, sizeof(msg),
                      "[Argus][Trino] OAuth2 %s authorization failed", how);
             argus_set_error(&dbc->diag, "08001", msg, 0);
+            trino_transport_cleanup(conn);
             curl_easy_cleanup(conn->curl);
             free(conn->base_url); free(conn->user); free(conn->password);
             free(conn->catalog); free(conn->schema);
@@ -962,6 +824,7 @@ int trino_connect(argus_dbc_t *dbc,
         argus_set_error(&dbc->diag, "08001", msg, 0);
         free(resp.data);
         curl_slist_free_all(conn->default_headers);
+        trino_transport_cleanup(conn);
         curl_easy_cleanup(conn->curl);
         free(conn->base_url);
         free(conn->user);
@@ -1019,8 +882,12 @@ void trino_disconnect(argus_backend_conn_t raw_conn)
 
     if (conn->default_headers)
         curl_slist_free_all(conn->default_headers);
-    if (conn->curl)
+    g_slist_free_full(conn->retired_headers,
+                      (GDestroyNotify)curl_slist_free_all);
+    if (conn->curl) {
+        trino_transport_cleanup(conn);
         curl_easy_cleanup(conn->curl);
+    }
 
     free(conn->base_url);
     free(conn->user);
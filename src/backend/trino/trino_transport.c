@@ -0,0 +1,282 @@
+/*
+ * trino_transport.c - Per-connection HTTP event loop for the Trino backend.
+ *
+ * Every request a connection makes (POST /v1/statement, nextUri polls,
+ * spooled-segment downloads, cancels and acks) is a transfer on the
+ * connection's curl multi handle. Two statements polling side by side — a
+ * BI tool running metadata and data queries together — thus proceed
+ * concurrently instead of taking turns on one easy handle, and with HTTP/2
+ * they share a single multiplexed socket.
+ *
+ * There is no loop thread: a caller waiting for its transfer drives the
+ * loop if nobody else is, and otherwise sleeps until the driver reports a
+ * completion or hands the loop over.
+ */
+
+#include "trino_internal.h"
+#include "argus/log.h"
+#include "argus/trace.h"
+#include "../http_client.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct trino_xfer {
+    CURL             *easy;
+    trino_response_t *resp;         /* NULL: discard the body */
+    argus_progress_t *progress;     /* NULL: not tracked */
+    struct curl_slist *headers;     /* traced copy of default_headers */
+    CURLcode          result;
+    long              http_code;
+    bool              done;
+};
+
+/* ── Lifecycle ───────────────────────────────────────────────── */
+
+int trino_transport_init(trino_conn_t *conn)
+{
+    g_mutex_init(&conn->loop_lock);
+    g_cond_init(&conn->loop_cond);
+    g_queue_init(&conn->loop_pending);
+    g_queue_init(&conn->loop_idle);
+
+    conn->multi = curl_multi_init();
+    if (!conn->multi) return -1;
+#ifdef CURLPIPE_MULTIPLEX
+    /* Default since libcurl 7.62; older versions need it spelled out */
+    curl_multi_setopt(conn->multi, CURLMOPT_PIPELINING,
+                      (long)CURLPIPE_MULTIPLEX);
+#endif
+    return 0;
+}
+
+void trino_transport_cleanup(trino_conn_t *conn)
+{
+    CURL *easy;
+    while ((easy = g_queue_pop_head(&conn->loop_idle)) != NULL)
+        curl_easy_cleanup(easy);
+    /* Every transfer is waited for by its starter, so nothing is pending */
+    if (conn->multi) {
+        curl_multi_cleanup(conn->multi);
+        conn->multi = NULL;
+    }
+    g_cond_clear(&conn->loop_cond);
+    g_mutex_clear(&conn->loop_lock);
+}
+
+/* ── Transfers ───────────────────────────────────────────────── */
+
+/* Runs inside curl_multi_perform(), i.e. under loop_lock. */
+static size_t trino_xfer_write_cb(void *contents, size_t size, size_t nmemb,
+                                  void *userp)
+{
+    trino_xfer_t *xfer = (trino_xfer_t *)userp;
+    size_t total = size * nmemb;
+
+    if (xfer->progress)
+        xfer->progress->bytes_received += (int64_t)total;
+    if (!xfer->resp)
+        return total;
+    return trino_curl_write_cb(contents, size, nmemb, xfer->resp);
+}
+
+/* Propagate the statement's trace: traceparent for Trino's own
+ * OpenTelemetry tracing, and the same value as the client info, which
+ * shows in the query's details. NULL when no span is bound. Called with
+ * loop_lock held. */
+static struct curl_slist *trino_trace_headers(trino_conn_t *conn)
+{
+    char tp[ARGUS_TRACEPARENT_LEN];
+    struct curl_slist *h = argus_http_trace_headers(conn->default_headers);
+    if (!h || !argus_trace_traceparent(tp)) return h;
+
+    char line[48 + ARGUS_TRACEPARENT_LEN];
+    snprintf(line, sizeof(line), "X-Trino-Client-Info: traceparent=%s", tp);
+    struct curl_slist *n = curl_slist_append(h, line);
+    return n ? n : h;
+}
+
+trino_xfer_t *trino_http_start(trino_conn_t *conn, const char *method,
+                               const char *url, const char *body,
+                               trino_response_t *resp,
+                               argus_progress_t *progress)
+{
+    trino_xfer_t *xfer = calloc(1, sizeof(*xfer));
+    if (!xfer) return NULL;
+    xfer->resp = resp;
+    xfer->progress = progress;
+    if (resp) {
+        resp->data = NULL;
+        resp->size = 0;
+    }
+
+    g_mutex_lock(&conn->loop_lock);
+    xfer->easy = g_queue_pop_head(&conn->loop_idle);
+    if (!xfer->easy)
+        xfer->easy = curl_easy_duphandle(conn->curl);
+    if (!xfer->easy) {
+        g_mutex_unlock(&conn->loop_lock);
+        free(xfer);
+        return NULL;
+    }
+    /* default_headers is read under the lock: a token refresh swaps it */
+    xfer->headers = trino_trace_headers(conn);
+    argus_http_prepare(xfer->easy, method, url, body,
+                       xfer->headers ? xfer->headers : conn->default_headers,
+                       trino_xfer_write_cb, xfer);
+    curl_easy_setopt(xfer->easy, CURLOPT_PRIVATE, xfer);
+    g_queue_push_tail(&conn->loop_pending, xfer);
+#if LIBCURL_VERSION_NUM >= 0x074400 /* 7.68.0 */
+    /* Interrupt the driver's poll so the transfer starts right away */
+    if (conn->loop_driving)
+        curl_multi_wakeup(conn->multi);
+#endif
+    g_mutex_unlock(&conn->loop_lock);
+    return xfer;
+}
+
+/* Mark finished transfers done. Called with loop_lock held. */
+static void trino_loop_collect(trino_conn_t *conn)
+{
+    bool any = false;
+    CURLMsg *msg;
+    int left = 0;
+
+    while ((msg = curl_multi_info_read(conn->multi, &left)) != NULL) {
+        if (msg->msg != CURLMSG_DONE) continue;
+
+        /* msg is invalidated by remove_handle: copy what we need first */
+        CURL *easy = msg->easy_handle;
+        CURLcode result = msg->data.result;
+        char *priv = NULL;
+        curl_easy_getinfo(easy, CURLINFO_PRIVATE, &priv);
+        curl_multi_remove_handle(conn->multi, easy);
+
+        trino_xfer_t *xfer = (trino_xfer_t *)priv;
+        if (!xfer) continue;
+        xfer->result = result;
+        curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &xfer->http_code);
+        xfer->done = true;
+        any = true;
+    }
+    if (any)
+        g_cond_broadcast(&conn->loop_cond);
+}
+
+/* One turn of the loop on behalf of `waiting`. Called with loop_lock held;
+ * drops it while blocked in poll so other statements can queue work. */
+static void trino_loop_run_once(trino_conn_t *conn, trino_xfer_t *waiting)
+{
+    trino_xfer_t *xfer;
+    while ((xfer = g_queue_pop_head(&conn->loop_pending)) != NULL) {
+        if (curl_multi_add_handle(conn->multi, xfer->easy) != CURLM_OK) {
+            xfer->result = CURLE_FAILED_INIT;
+            xfer->done = true;
+            g_cond_broadcast(&conn->loop_cond);
+        }
+    }
+
+    int running = 0;
+    curl_multi_perform(conn->multi, &running);
+    trino_loop_collect(conn);
+    if (waiting->done)
+        return;
+
+    g_mutex_unlock(&conn->loop_lock);
+#if LIBCURL_VERSION_NUM >= 0x074400 /* 7.68.0 */
+    curl_multi_poll(conn->multi, NULL, 0, 1000, NULL);
+#else
+    /* No wakeup call: bound how long a newly queued transfer waits */
+    curl_multi_wait(conn->multi, NULL, 0, 50, NULL);
+#endif
+    g_mutex_lock(&conn->loop_lock);
+}
+
+int trino_http_wait(trino_conn_t *conn, trino_xfer_t *xfer, long *http_code)
+{
+    gint64 wait_start = g_get_monotonic_time();
+    g_mutex_lock(&conn->loop_lock);
+    while (!xfer->done) {
+        if (conn->loop_driving) {
+            g_cond_wait(&conn->loop_cond, &conn->loop_lock);
+            continue;
+        }
+        conn->loop_driving = true;
+        trino_loop_run_once(conn, xfer);
+        conn->loop_driving = false;
+        /* Let another waiter take the loop over if ours is done */
+        g_cond_broadcast(&conn->loop_cond);
+    }
+
+    CURLcode result = xfer->result;
+    long code = xfer->http_code;
+    if (xfer->progress)
+        xfer->progress->wait_us += g_get_monotonic_time() - wait_start;
+    g_queue_push_head(&conn->loop_idle, xfer->easy);
+    g_mutex_unlock(&conn->loop_lock);
+    curl_slist_free_all(xfer->headers);
+    free(xfer);
+
+    if (http_code) *http_code = code;
+    if (result != CURLE_OK) {
+        ARGUS_LOG_DEBUG("Trino: HTTP transfer failed: %s",
+                        curl_easy_strerror(result));
+        return -1;
+    }
+    return 0;
+}
+
+/* ── Blocking helpers ────────────────────────────────────────── */
+
+int trino_http_request(trino_conn_t *conn, const char *method,
+                       const char *url, const char *body,
+                       trino_response_t *resp, argus_progress_t *progress)
+{
+    long http_code = 0;
+    trino_xfer_t *xfer = trino_http_start(conn, method, url, body, resp,
+                                          progress);
+    if (!xfer || trino_http_wait(conn, xfer, &http_code) != 0)
+        return -1;
+
+    /* OAuth2 (M2M) access token may have expired; refresh once and retry. */
+    if (http_code == 401 && conn->oauth_m2m &&
+        trino_refresh_oauth_token(conn) == 0) {
+        if (resp) {
+            free(resp->data);
+            resp->data = NULL;
+            resp->size = 0;
+        }
+        /* The refresh rebuilt default_headers */
+        xfer = trino_http_start(conn, method, url, body, resp, progress);
+        if (!xfer || trino_http_wait(conn, xfer, &http_code) != 0)
+            return -1;
+    }
+
+    if (http_code >= 400)
+        return -1;
+
+    return 0;
+}
+
+int trino_http_post(trino_conn_t *conn, const char *url, const char *body,
+                    trino_response_t *resp)
+{
+    return trino_http_request(conn, "POST", url, body, resp, NULL);
+}
+
+int trino_http_get(trino_conn_t *conn, const char *url,
+                   trino_response_t *resp)
+{
+    return trino_http_request(conn, "GET", url, NULL, resp, NULL);
+}
+
+/* Best effort: only a transport failure counts (a query that already
+ * finished answers 410, which is fine for a cancel or an ack). */
+int trino_http_delete(trino_conn_t *conn, const char *url)
+{
+    trino_xfer_t *xfer = trino_http_start(conn, "DELETE", url, NULL, NULL,
+                                          NULL);
+    if (!xfer) return -1;
+    return trino_http_wait(conn, xfer, NULL);
+}
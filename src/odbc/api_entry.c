@@ -10,11 +10,13 @@
 
 #include "argus/odbc_api.h"
 #include "argus/backend.h"
+#include "argus/handle.h"
 #include "argus/log.h"
 #include "argus/telemetry.h"
 
 #ifdef ARGUS_HAS_CURL
 #include <curl/curl.h>
+#include "../backend/http_client.h"
 #endif
 
 /* One-time process-wide startup/teardown shared by the Windows DllMain and the
@@ -25,6 +27,7 @@ static void argus_library_load(void)
 {
 #ifdef ARGUS_HAS_CURL
     curl_global_init(CURL_GLOBAL_DEFAULT);
+    argus_http_global_init();
 #endif
     argus_log_init();
     argus_backends_init();
@@ -33,9 +36,11 @@ static void argus_library_load(void)
 
 static void argus_library_unload(void)
 {
+    argus_executor_shutdown();
     argus_telemetry_shutdown();
     argus_log_cleanup();
 #ifdef ARGUS_HAS_CURL
+    argus_http_global_cleanup();
     curl_global_cleanup();
 #endif
 }
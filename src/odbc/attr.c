@@ -10,6 +10,28 @@ extern SQLSMALLINT argus_copy_string(const char *src,
                                       SQLCHAR *dst, SQLSMALLINT dst_len);
 extern char *argus_str_dup_short(const SQLCHAR *str, SQLSMALLINT len);
 
+/* ODBC 3.8 asynchronous notification and connection-level async; older
+ * sqlext.h headers lack them */
+#ifndef SQL_ATTR_ASYNC_STMT_EVENT
+#define SQL_ATTR_ASYNC_STMT_EVENT           29
+#endif
+#ifndef SQL_ATTR_ASYNC_STMT_PCALLBACK
+#define SQL_ATTR_ASYNC_STMT_PCALLBACK       10012
+#define SQL_ATTR_ASYNC_STMT_PCONTEXT        10013
+#endif
+#ifndef SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE
+#define SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE 117
+#define SQL_ASYNC_DBC_ENABLE_ON             1UL
+#define SQL_ASYNC_DBC_ENABLE_OFF            0UL
+#endif
+#ifndef SQL_ATTR_ASYNC_DBC_EVENT
+#define SQL_ATTR_ASYNC_DBC_EVENT            119
+#endif
+#ifndef SQL_ATTR_ASYNC_DBC_PCALLBACK
+#define SQL_ATTR_ASYNC_DBC_PCALLBACK        120
+#define SQL_ATTR_ASYNC_DBC_PCONTEXT         121
+#endif
+
 /* ── ODBC API: SQLSetEnvAttr ─────────────────────────────────── */
 
 SQLRETURN SQL_API SQLSetEnvAttr(
@@ -133,6 +155,41 @@ SQLRETURN SQL_API SQLSetConnectAttr(
          * every Linux BI tool (they all go through the Driver Manager). */
         return SQL_SUCCESS;
 
+    /* Connection-level async: connect and disconnect return
+     * SQL_STILL_EXECUTING and run on the shared executor (connect.c) */
+    case SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE:
+        if (dbc->async_dbc_busy)
+            return argus_set_error(&dbc->diag, "HY010",
+                                   "[Argus] Function sequence error", 0);
+        dbc->async_dbc_enabled =
+            ((SQLULEN)(uintptr_t)Value == SQL_ASYNC_DBC_ENABLE_ON);
+        return SQL_SUCCESS;
+
+    case SQL_ATTR_ASYNC_DBC_PCALLBACK:
+        dbc->async_dbc.callback = Value;
+        return SQL_SUCCESS;
+
+    case SQL_ATTR_ASYNC_DBC_PCONTEXT:
+        dbc->async_dbc.context = Value;
+        return SQL_SUCCESS;
+
+    case SQL_ATTR_ASYNC_DBC_EVENT:
+        dbc->async_dbc.event = Value;
+        return SQL_SUCCESS;
+
+    case ARGUS_ATTR_METRICS_DUMP: {
+        /* Process-wide histograms, written where the application asks */
+        char *path = (Value && StringLength > 0)
+            ? strndup((const char *)Value, (size_t)StringLength)
+            : (Value ? strdup((const char *)Value) : NULL);
+        int rc = argus_metrics_dump(path);
+        free(path);
+        if (rc != 0)
+            return argus_set_error(&dbc->diag, "HY000",
+                                   "[Argus] Could not write metrics file", 0);
+        return SQL_SUCCESS;
+    }
+
     case SQL_ATTR_ASYNC_ENABLE:
     case SQL_ATTR_METADATA_ID:
     case SQL_ATTR_QUIET_MODE:
@@ -213,11 +270,101 @@ SQLRETURN SQL_API SQLGetConnectAttr(
         if (StringLength) *StringLength = sizeof(SQLULEN);
         return SQL_SUCCESS;
 
+    case ARGUS_ATTR_RESULT_CACHE_HITS:
+        if (Value) *(SQLULEN *)Value = (SQLULEN)dbc->result_cache_hits;
+        if (StringLength) *StringLength = sizeof(SQLULEN);
+        return SQL_SUCCESS;
+
+    case ARGUS_ATTR_RESULT_CACHE_MISSES:
+        if (Value) *(SQLULEN *)Value = (SQLULEN)dbc->result_cache_misses;
+        if (StringLength) *StringLength = sizeof(SQLULEN);
+        return SQL_SUCCESS;
+
+    case ARGUS_ATTR_SQL_CACHE_HITS:
+        if (Value) *(SQLULEN *)Value = (SQLULEN)dbc->sql_cache_hits;
+        if (StringLength) *StringLength = sizeof(SQLULEN);
+        return SQL_SUCCESS;
+
+    case ARGUS_ATTR_SQL_CACHE_MISSES:
+        if (Value) *(SQLULEN *)Value = (SQLULEN)dbc->sql_cache_misses;
+        if (StringLength) *StringLength = sizeof(SQLULEN);
+        return SQL_SUCCESS;
+
+    case ARGUS_ATTR_SQL_CACHE_BYTES:
+        /* Process-wide: the cache is shared by all connections */
+        if (Value) *(SQLULEN *)Value = (SQLULEN)argus_sql_cache_bytes();
+        if (StringLength) *StringLength = sizeof(SQLULEN);
+        return SQL_SUCCESS;
+
+    case ARGUS_ATTR_RESULT_CACHE_BYTES:
+        /* Process-wide: the cache is shared by all connections */
+        if (Value) *(SQLULEN *)Value = (SQLULEN)argus_result_cache_bytes();
+        if (StringLength) *StringLength = sizeof(SQLULEN);
+        return SQL_SUCCESS;
+
+    case ARGUS_ATTR_POOL_HITS:
+    case ARGUS_ATTR_POOL_MISSES:
+    case ARGUS_ATTR_POOL_BUSY:
+    case ARGUS_ATTR_POOL_CREATE_MS: {
+        /* Process-wide: the pool is shared by all connections */
+        argus_pool_stats_t ps;
+        argus_pool_get_stats(&ps);
+        if (Attribute == ARGUS_ATTR_POOL_CREATE_MS) {
+            if (Value) *(double *)Value = ps.creates > 0
+                ? ps.create_ms_total / (double)ps.creates : 0.0;
+            if (StringLength) *StringLength = sizeof(double);
+            return SQL_SUCCESS;
+        }
+        if (Value) *(SQLULEN *)Value = (SQLULEN)(
+            Attribute == ARGUS_ATTR_POOL_HITS ? ps.hits :
+            Attribute == ARGUS_ATTR_POOL_MISSES ? ps.misses : ps.busy);
+        if (StringLength) *StringLength = sizeof(SQLULEN);
+        return SQL_SUCCESS;
+    }
+
+    case ARGUS_ATTR_METRICS_JSON: {
+        /* Process-wide phase histograms as a JSON document */
+        char *json = argus_metrics_json();
+        SQLSMALLINT len = argus_copy_string(
+            json, (SQLCHAR *)Value,
+            (SQLSMALLINT)(BufferLength > 32767 ? 32767 : BufferLength));
+        if (StringLength) *StringLength = len;
+        g_free(json);
+        if (Value && len >= BufferLength) {
+            argus_diag_push(&dbc->diag, "01004",
+                            "[Argus] String data, right truncated", 0);
+            return SQL_SUCCESS_WITH_INFO;
+        }
+        return SQL_SUCCESS;
+    }
+
     case SQL_ATTR_ASYNC_ENABLE:
         if (Value) *(SQLUINTEGER *)Value = SQL_ASYNC_ENABLE_OFF;
         if (StringLength) *StringLength = sizeof(SQLUINTEGER);
         return SQL_SUCCESS;
 
+    case SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE:
+        if (Value) *(SQLUINTEGER *)Value = dbc->async_dbc_enabled
+                                           ? SQL_ASYNC_DBC_ENABLE_ON
+                                           : SQL_ASYNC_DBC_ENABLE_OFF;
+        if (StringLength) *StringLength = sizeof(SQLUINTEGER);
+        return SQL_SUCCESS;
+
+    case SQL_ATTR_ASYNC_DBC_PCALLBACK:
+        if (Value) *(SQLPOINTER *)Value = dbc->async_dbc.callback;
+        if (StringLength) *StringLength = sizeof(SQLPOINTER);
+        return SQL_SUCCESS;
+
+    case SQL_ATTR_ASYNC_DBC_PCONTEXT:
+        if (Value) *(SQLPOINTER *)Value = dbc->async_dbc.context;
+        if (StringLength) *StringLength = sizeof(SQLPOINTER);
+        return SQL_SUCCESS;
+
+    case SQL_ATTR_ASYNC_DBC_EVENT:
+        if (Value) *(SQLPOINTER *)Value = dbc->async_dbc.event;
+        if (StringLength) *StringLength = sizeof(SQLPOINTER);
+        return SQL_SUCCESS;
+
     default:
         /* Return 0 for unknown attributes */
         if (Value && BufferLength >= (SQLINTEGER)sizeof(SQLUINTEGER))
@@ -235,8 +382,6 @@ SQLRETURN SQL_API SQLSetStmtAttr(
     SQLPOINTER Value,
     SQLINTEGER StringLength)
 {
-    (void)StringLength;
-
     argus_stmt_t *stmt = (argus_stmt_t *)StatementHandle;
     if (!argus_valid_stmt(stmt)) return SQL_INVALID_HANDLE;
 
@@ -314,6 +459,20 @@ SQLRETURN SQL_API SQLSetStmtAttr(
         return SQL_SUCCESS;
     }
 
+    /* Notification instead of polling: called, or on Windows signalled,
+     * when an asynchronous execute completes (executor.c) */
+    case SQL_ATTR_ASYNC_STMT_PCALLBACK:
+        stmt->async.callback = Value;
+        return SQL_SUCCESS;
+
+    case SQL_ATTR_ASYNC_STMT_PCONTEXT:
+        stmt->async.context = Value;
+        return SQL_SUCCESS;
+
+    case SQL_ATTR_ASYNC_STMT_EVENT:
+        stmt->async.event = Value;
+        return SQL_SUCCESS;
+
     /* An application sets NOSCAN_ON when it knows its SQL is already native
      * and wants the driver to skip escape translation. Honouring it matters:
      * SQL that legitimately contains a brace would otherwise be reparsed. */
@@ -391,6 +550,45 @@ SQLRETURN SQL_API SQLSetStmtAttr(
         /* Accept but ignore */
         return SQL_SUCCESS;
 
+    /* Direct-to-file extract (see extract.c) */
+    case ARGUS_ATTR_EXTRACT_PATH: {
+        /* NULL or an empty path turns the extract off */
+        char *path = NULL;
+        if (Value && StringLength != 0) {
+            path = StringLength > 0
+                ? strndup((const char *)Value, (size_t)StringLength)
+                : strdup((const char *)Value);
+            if (!path)
+                return argus_set_error(&stmt->diag, "HY001",
+                                       "[Argus] Memory allocation failed", 0);
+        }
+        free(stmt->extract_path);
+        stmt->extract_path = NULL;
+        if (path && *path)
+            stmt->extract_path = path;
+        else
+            free(path);
+        return SQL_SUCCESS;
+    }
+
+    case ARGUS_ATTR_EXTRACT_FORMAT:
+        if ((SQLULEN)(uintptr_t)Value > ARGUS_EXTRACT_FORMAT_CSV)
+            return argus_set_error(&stmt->diag, "HY024",
+                                   "[Argus] Invalid extract format", 0);
+        stmt->extract_format = (SQLULEN)(uintptr_t)Value;
+        return SQL_SUCCESS;
+
+    case ARGUS_ATTR_EXTRACT_ROW_GROUP:
+        stmt->extract_row_group = (SQLULEN)(uintptr_t)Value;
+        return SQL_SUCCESS;
+
+    case ARGUS_ATTR_EXTRACT_COMPRESSION:
+        if ((SQLULEN)(uintptr_t)Value > ARGUS_EXTRACT_COMPRESS_GZIP)
+            return argus_set_error(&stmt->diag, "HY024",
+                                   "[Argus] Invalid extract compression", 0);
+        stmt->extract_compression = (SQLULEN)(uintptr_t)Value;
+        return SQL_SUCCESS;
+
     default:
         return argus_set_error(&stmt->diag, "HY092",
                                "[Argus] Invalid attribute identifier", 0);
@@ -511,6 +709,21 @@ SQLRETURN SQL_API SQLGetStmtAttr(
         if (StringLength) *StringLength = sizeof(SQLULEN);
         return SQL_SUCCESS;
 
+    case SQL_ATTR_ASYNC_STMT_PCALLBACK:
+        if (Value) *(SQLPOINTER *)Value = stmt->async.callback;
+        if (StringLength) *StringLength = sizeof(SQLPOINTER);
+        return SQL_SUCCESS;
+
+    case SQL_ATTR_ASYNC_STMT_PCONTEXT:
+        if (Value) *(SQLPOINTER *)Value = stmt->async.context;
+        if (StringLength) *StringLength = sizeof(SQLPOINTER);
+        return SQL_SUCCESS;
+
+    case SQL_ATTR_ASYNC_STMT_EVENT:
+        if (Value) *(SQLPOINTER *)Value = stmt->async.event;
+        if (StringLength) *StringLength = sizeof(SQLPOINTER);
+        return SQL_SUCCESS;
+
     case SQL_ATTR_PARAMSET_SIZE:
         if (Value) *(SQLULEN *)Value = stmt->paramset_size;
         if (StringLength) *StringLength = sizeof(SQLULEN);
@@ -557,6 +770,87 @@ SQLRETURN SQL_API SQLGetStmtAttr(
         if (StringLength) *StringLength = sizeof(SQLULEN);
         return SQL_SUCCESS;
 
+    /* Phase timing of the last execution */
+    case ARGUS_ATTR_SUBMIT_TIME_MS:
+    case ARGUS_ATTR_QUEUE_TIME_MS:
+    case ARGUS_ATTR_FIRST_ROW_MS:
+    case ARGUS_ATTR_FETCH_TIME_MS:
+    case ARGUS_ATTR_NETWORK_TIME_MS:
+    case ARGUS_ATTR_DECODE_TIME_MS:
+    case ARGUS_ATTR_CONVERT_TIME_MS:
+        if (Value) *(double *)Value = argus_stmt_phase_ms(
+            stmt, (argus_phase_t)(ARGUS_PHASE_SUBMIT +
+                                  (Attribute - ARGUS_ATTR_SUBMIT_TIME_MS)));
+        if (StringLength) *StringLength = sizeof(double);
+        return SQL_SUCCESS;
+
+    case ARGUS_ATTR_BYTES_RECEIVED:
+    case ARGUS_ATTR_CELLS_DECODED:
+        if (Value) *(SQLULEN *)Value = (SQLULEN)(
+            Attribute == ARGUS_ATTR_BYTES_RECEIVED ? stmt->timing.bytes
+                                                   : stmt->timing.cells);
+        if (StringLength) *StringLength = sizeof(SQLULEN);
+        return SQL_SUCCESS;
+
+    /* The last direct-to-file extract */
+    case ARGUS_ATTR_EXTRACT_PATH: {
+        SQLSMALLINT len = argus_copy_string(
+            stmt->extract_path ? stmt->extract_path : "", (SQLCHAR *)Value,
+            (SQLSMALLINT)(BufferLength > 32767 ? 32767 : BufferLength));
+        if (StringLength) *StringLength = len;
+        if (Value && len >= BufferLength) {
+            argus_diag_push(&stmt->diag, "01004",
+                            "[Argus] String data, right truncated", 0);
+            return SQL_SUCCESS_WITH_INFO;
+        }
+        return SQL_SUCCESS;
+    }
+
+    case ARGUS_ATTR_EXTRACT_FORMAT:
+    case ARGUS_ATTR_EXTRACT_ROW_GROUP:
+    case ARGUS_ATTR_EXTRACT_COMPRESSION:
+    case ARGUS_ATTR_EXTRACT_ROWS:
+    case ARGUS_ATTR_EXTRACT_BYTES:
+        if (Value) *(SQLULEN *)Value =
+            Attribute == ARGUS_ATTR_EXTRACT_FORMAT ? stmt->extract_format :
+            Attribute == ARGUS_ATTR_EXTRACT_ROW_GROUP ? stmt->extract_row_group :
+            Attribute == ARGUS_ATTR_EXTRACT_COMPRESSION
+                ? stmt->extract_compression :
+            Attribute == ARGUS_ATTR_EXTRACT_ROWS
+                ? (SQLULEN)stmt->extract_rows : (SQLULEN)stmt->extract_bytes;
+        if (StringLength) *StringLength = sizeof(SQLULEN);
+        return SQL_SUCCESS;
+
+    case ARGUS_ATTR_EXTRACT_TIME_MS:
+    case ARGUS_ATTR_EXTRACT_ROWS_PER_SEC:
+        if (Value) *(double *)Value =
+            Attribute == ARGUS_ATTR_EXTRACT_TIME_MS ? stmt->extract_ms :
+            stmt->extract_ms > 0
+                ? (double)stmt->extract_rows * 1000.0 / stmt->extract_ms : 0.0;
+        if (StringLength) *StringLength = sizeof(double);
+        return SQL_SUCCESS;
+
+    /* Progress of the running statement; readable from another thread
+     * while SQLExecute/SQLFetch is in flight */
+    case ARGUS_ATTR_PROGRESS_PERCENT:
+    case ARGUS_ATTR_PROGRESS_ROWS:
+    case ARGUS_ATTR_PROGRESS_BYTES: {
+        argus_progress_t prog = { .percent = -1.0 };
+        argus_dbc_t *dbc = stmt->dbc;
+        if (stmt->op && dbc && dbc->backend && dbc->backend->get_progress)
+            dbc->backend->get_progress(dbc->backend_conn, stmt->op, &prog);
+        if (Attribute == ARGUS_ATTR_PROGRESS_PERCENT) {
+            if (Value) *(double *)Value = prog.percent;
+            if (StringLength) *StringLength = sizeof(double);
+        } else {
+            SQLULEN n = (SQLULEN)(Attribute == ARGUS_ATTR_PROGRESS_ROWS
+                                  ? prog.rows_processed : prog.bytes_received);
+            if (Value) *(SQLULEN *)Value = n;
+            if (StringLength) *StringLength = sizeof(SQLULEN);
+        }
+        return SQL_SUCCESS;
+    }
+
     default:
         if (Value && BufferLength >= (SQLINTEGER)sizeof(SQLULEN))
             *(SQLULEN *)Value = 0;
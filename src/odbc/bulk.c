@@ -0,0 +1,1084 @@
+/*
+ * SQLBulkOperations.
+ *
+ * SQL_ADD appends the rowset bound with SQLBindCol — SQL_ATTR_ROW_ARRAY_SIZE
+ * rows, column- or row-wise — to the table the statement's result set reads
+ * from. ETL tools use it instead of one parameterized INSERT per row, which
+ * on Trino or Hive costs a whole query for every row.
+ *
+ * The rows go out as multi-row INSERT ... VALUES statements of up to
+ * BulkInsertRows rows and BulkInsertBytes of SQL each, fewer where the
+ * dialect says so (Phoenix UPSERTs one row at a time; Druid, Pinot and Kudu
+ * take no INSERT at all). With BulkLoad=1, a backend with a native bulk path
+ * (bulk_insert in its vtable: MySQL-wire's LOAD DATA, BigQuery's streaming
+ * insert) is handed the rows instead.
+ * Each statement runs as an operation of its own, so the application's
+ * cursor stays open and readable.
+ *
+ * Every row ends up SQL_ROW_ADDED or SQL_ROW_ERROR in SQL_ATTR_ROW_STATUS_PTR
+ * (SQL_ROW_NOROW if a cancel stopped the call first). A failed statement
+ * fails all of its rows; a row whose values cannot be rendered fails alone.
+ * When the server skipped some rows of a bulk call without saying which
+ * (LOAD DATA does), the rows it was sent are SQL_ROW_SUCCESS_WITH_INFO and
+ * the row count is what it says it added.
+ *
+ * The bookmark operations need bookmarks, which the driver does not keep
+ * (SQL_ATTR_USE_BOOKMARKS stays off), so they are HYC00.
+ *
+ * SQLExecute of a plain "INSERT INTO t [(cols)] VALUES (?, ...)" over a
+ * parameter array comes here too when the backend has a native bulk path
+ * that will take the rows (with BulkLoad=1): the array goes to bulk_insert
+ * in one call rather than one statement per row, and each row's outcome
+ * lands in SQL_ATTR_PARAM_STATUS_PTR
+ * (SQL_PARAM_DIAG_UNAVAILABLE for a row the server may have skipped).
+ */
+
+#include "argus/handle.h"
+#include "argus/odbc_api.h"
+#include "argus/dialect.h"
+#include "argus/log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <glib.h>
+
+/* Columns of the result a DML statement may come back with (an update
+ * count, where the backend reports one) */
+#define BULK_RESULT_COLS 64
+
+/* One SQL_ADD rowset, or one INSERT parameter array, being inserted */
+typedef struct bulk {
+    argus_stmt_t          *stmt;
+    const argus_dialect_t *dialect;
+    const argus_param_binding_t *params; /* parameter array; NULL = rowset */
+    int                   *cols;        /* result columns (or parameters)
+                                         * inserted, 0-based */
+    argus_column_desc_t   *columns;     /* and their descriptors */
+    int                    ncols;
+    SQLULEN                nrows;       /* rows in the rowset */
+    SQLUSMALLINT          *status;      /* per row, SQL_ROW_* */
+    SQLULEN                added;
+    int                    statements;
+    bool                   incomplete;  /* a statement reported a failure */
+    bool                   cancelled;
+} bulk_t;
+
+/* ── Target table ────────────────────────────────────────────── */
+
+static bool is_ident_char(char c)
+{
+    return isalnum((unsigned char)c) || c == '_' || c == '$';
+}
+
+/* The closing quote of the literal or quoted name opening at q, or the
+ * terminating NUL */
+static const char *skip_quoted(const char *q)
+{
+    char close = (*q == '[') ? ']' : *q;
+    for (q++; *q && *q != close; q++)
+        ;
+    return q;
+}
+
+/* One name of a dotted table reference at p; the end of it, or NULL */
+static const char *scan_name(const char *p)
+{
+    if (*p == '"' || *p == '`' || *p == '[') {
+        p = skip_quoted(p);
+        return *p ? p + 1 : NULL;
+    }
+    const char *start = p;
+    while (is_ident_char(*p)) p++;
+    return p > start ? p : NULL;
+}
+
+static const char *skip_space(const char *p)
+{
+    while (isspace((unsigned char)*p)) p++;
+    return p;
+}
+
+/* Keywords that may follow the table of a single-table SELECT */
+static bool clause_follows(const char *p)
+{
+    static const char *const clauses[] = {
+        "WHERE", "GROUP", "HAVING", "ORDER", "LIMIT", "OFFSET", "FETCH",
+        "QUALIFY", "WINDOW", NULL
+    };
+    if (*p == '\0' || *p == ';') return true;
+    for (int i = 0; clauses[i]; i++)
+        if (argus_sql_keyword_at(p, clauses[i])) return true;
+    return false;
+}
+
+/*
+ * The table a "SELECT ... FROM t [[AS] alias] [WHERE ...]" reads, exactly as
+ * written; NULL for a join, a subquery, several tables or anything else.
+ * This is the usual SQL_ADD set-up (often with WHERE 1=0), and the name as
+ * the application wrote it is one the server resolves the same way again.
+ */
+static char *table_from_query(const char *sql)
+{
+    const char *p = sql ? argus_sql_skip_leading(sql) : NULL;
+    if (!p || !argus_sql_keyword_at(p, "SELECT")) return NULL;
+
+    /* The FROM at nesting depth 0, outside literals and quoted names */
+    const char *from = NULL;
+    int depth = 0;
+    for (const char *q = p; *q && !from; q++) {
+        if (*q == '\'' || *q == '"' || *q == '`') {
+            q = skip_quoted(q);
+            if (!*q) return NULL;
+        } else if (*q == '(') {
+            depth++;
+        } else if (*q == ')') {
+            depth--;
+        } else if (depth == 0 && (q == p || !is_ident_char(q[-1])) &&
+                   argus_sql_keyword_at(q, "FROM")) {
+            from = q + 4;
+        }
+    }
+    if (!from) return NULL;
+
+    const char *start = skip_space(from);
+    const char *end = start;
+    for (;;) {
+        end = scan_name(end);
+        if (!end) return NULL;
+        if (*end != '.') break;
+        end++;
+    }
+
+    /* An optional alias, then the end or the next clause */
+    const char *rest = skip_space(end);
+    if (!clause_follows(rest)) {
+        if (argus_sql_keyword_at(rest, "AS"))
+            rest = skip_space(rest + 2);
+        const char *alias_end = scan_name(rest);
+        if (!alias_end) return NULL;
+        rest = skip_space(alias_end);
+        if (!clause_follows(rest)) return NULL;
+    }
+    return g_strndup(start, (gsize)(end - start));
+}
+
+/* name quoted with the dialect's identifier quote */
+static void append_ident(GString *out, const char *name, const char *quote)
+{
+    char q = quote[0];
+    g_string_append_c(out, q);
+    for (const char *p = name; *p; p++) {
+        if (*p == q) g_string_append_c(out, q);
+        g_string_append_c(out, *p);
+    }
+    g_string_append_c(out, q);
+}
+
+/* The base table every column of the result reports, qualified and quoted;
+ * NULL if they do not all name the same one */
+static char *table_from_columns(const argus_stmt_t *stmt,
+                                const argus_dialect_t *d)
+{
+    const argus_column_desc_t *first = &stmt->columns[0];
+    if (!first->table_name[0]) return NULL;
+    for (int i = 1; i < stmt->num_cols; i++) {
+        const argus_column_desc_t *c = &stmt->columns[i];
+        if (strcmp((const char *)c->table_name,
+                   (const char *)first->table_name) != 0 ||
+            strcmp((const char *)c->schema_name,
+                   (const char *)first->schema_name) != 0 ||
+            strcmp((const char *)c->catalog_name,
+                   (const char *)first->catalog_name) != 0)
+            return NULL;
+    }
+
+    GString *out = g_string_new(NULL);
+    if (first->catalog_name[0]) {
+        append_ident(out, (const char *)first->catalog_name, d->quote_char);
+        g_string_append_c(out, '.');
+    }
+    if (first->schema_name[0]) {
+        append_ident(out, (const char *)first->schema_name, d->quote_char);
+        g_string_append_c(out, '.');
+    }
+    append_ident(out, (const char *)first->table_name, d->quote_char);
+    return g_string_free(out, FALSE);
+}
+
+/* ── Row values ──────────────────────────────────────────────── */
+
+typedef enum {
+    BULK_VALUE_OK = 0,
+    BULK_VALUE_IGNORE,      /* SQL_COLUMN_IGNORE */
+    BULK_VALUE_DAE          /* data at execution */
+} bulk_value_kind_t;
+
+/* One bound value as a parameter binding, its length made explicit */
+typedef struct bulk_value {
+    argus_param_binding_t param;
+    SQLLEN                len;      /* param.str_len_or_ind points here */
+} bulk_value_t;
+
+/* Classify v->param's value by its indicator `ind` (NULL = none) and make
+ * its length explicit in v->len */
+static bulk_value_kind_t bulk_resolve(bulk_value_t *v, const SQLLEN *ind)
+{
+    const argus_param_binding_t *p = &v->param;
+    SQLLEN n = ind ? *ind : SQL_NTS;
+    if (n == SQL_COLUMN_IGNORE) return BULK_VALUE_IGNORE;
+    if (n == SQL_DATA_AT_EXEC || n <= SQL_LEN_DATA_AT_EXEC_OFFSET)
+        return BULK_VALUE_DAE;
+    if (!p->value) n = SQL_NULL_DATA;
+
+    if (n == SQL_NTS) {
+        switch (p->value_type) {
+        case SQL_C_CHAR:
+        case SQL_C_DEFAULT:
+            n = (SQLLEN)(p->buffer_length > 0
+                         ? strnlen((const char *)p->value,
+                                   (size_t)p->buffer_length)
+                         : strlen((const char *)p->value));
+            break;
+        case SQL_C_WCHAR: {
+            const SQLWCHAR *w = (const SQLWCHAR *)p->value;
+            SQLLEN max = p->buffer_length > 0
+                ? p->buffer_length / (SQLLEN)sizeof(SQLWCHAR)
+                : G_MAXINT32;
+            SQLLEN units = 0;
+            while (units < max && w[units]) units++;
+            n = units * (SQLLEN)sizeof(SQLWCHAR);
+            break;
+        }
+        case SQL_C_BINARY:
+            n = p->buffer_length > 0 ? p->buffer_length : 0;
+            break;
+        default:
+            n = 0;      /* fixed size: the length is not used */
+            break;
+        }
+    }
+    v->len = n;
+    v->param.str_len_or_ind = &v->len;
+    return BULK_VALUE_OK;
+}
+
+/* Row `row` of the rowset's bound column `col` */
+static bulk_value_kind_t bulk_value(const argus_stmt_t *stmt, int col,
+                                    SQLULEN row, bulk_value_t *v)
+{
+    const argus_col_binding_t *bind = &stmt->bindings[col];
+    SQLPOINTER target = NULL;
+    SQLLEN *ind = NULL;
+    argus_bind_target(stmt, bind, row, &target, &ind);
+
+    memset(v, 0, sizeof(*v));
+    v->param.io_type        = SQL_PARAM_INPUT;
+    v->param.value_type     = bind->target_type;
+    v->param.param_type     = stmt->columns[col].sql_type;
+    v->param.column_size    = stmt->columns[col].column_size;
+    v->param.decimal_digits = stmt->columns[col].decimal_digits;
+    v->param.value          = target;
+    v->param.buffer_length  = bind->buffer_length;
+    v->param.bound          = true;
+    return bulk_resolve(v, ind);
+}
+
+/* Row `row` of the i-th inserted column or parameter */
+static bulk_value_kind_t bulk_get(const bulk_t *b, int i, SQLULEN row,
+                                  bulk_value_t *v)
+{
+    if (!b->params) return bulk_value(b->stmt, b->cols[i], row, v);
+
+    memset(v, 0, sizeof(*v));
+    argus_param_row(&b->params[b->cols[i]], 1, row,
+                    b->stmt->param_bind_type, &v->param);
+    return bulk_resolve(v, v->param.str_len_or_ind);
+}
+
+/* ISO text of a date, time or timestamp value; false for other types */
+static bool temporal_text(const bulk_value_t *v, char *buf, size_t size,
+                          const char **sql_type)
+{
+    switch (v->param.value_type) {
+    case SQL_C_TYPE_DATE: {
+        const SQL_DATE_STRUCT *d = (const SQL_DATE_STRUCT *)v->param.value;
+        snprintf(buf, size, "%04d-%02u-%02u", d->year, d->month, d->day);
+        *sql_type = "DATE";
+        return true;
+    }
+    case SQL_C_TYPE_TIME: {
+        const SQL_TIME_STRUCT *t = (const SQL_TIME_STRUCT *)v->param.value;
+        snprintf(buf, size, "%02u:%02u:%02u", t->hour, t->minute, t->second);
+        *sql_type = "TIME";
+        return true;
+    }
+    case SQL_C_TYPE_TIMESTAMP: {
+        const SQL_TIMESTAMP_STRUCT *ts =
+            (const SQL_TIMESTAMP_STRUCT *)v->param.value;
+        int n = snprintf(buf, size, "%04d-%02u-%02u %02u:%02u:%02u",
+                         ts->year, ts->month, ts->day,
+                         ts->hour, ts->minute, ts->second);
+        /* fraction is in nanoseconds; drop the trailing zeros */
+        if (ts->fraction > 0 && n > 0 && (size_t)n + 11 <= size) {
+            n += snprintf(buf + n, size - (size_t)n, ".%09u",
+                          (unsigned)ts->fraction);
+            while (buf[n - 1] == '0') buf[--n] = '\0';
+        }
+        *sql_type = "TIMESTAMP";
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+/* A value as a SQL literal: temporal values in the dialect's literal
+ * style, the rest as argus_render_param renders parameters */
+static char *bulk_literal(const bulk_value_t *v, const argus_dialect_t *d)
+{
+    char text[64];
+    const char *type = NULL;
+    if (v->len != SQL_NULL_DATA &&
+        temporal_text(v, text, sizeof(text), &type)) {
+        switch (d->literals) {
+        case ARGUS_LIT_CAST:
+            return g_strdup_printf("CAST('%s' AS %s)", text, type);
+        case ARGUS_LIT_STRING:
+            return g_strdup_printf("'%s'", text);
+        default:
+            return g_strdup_printf("%s '%s'", type, text);
+        }
+    }
+    char *lit = argus_render_param(&v->param);
+    if (!lit) return NULL;
+    char *out = g_strdup(lit);
+    free(lit);
+    return out;
+}
+
+/* A value as a text cell for a native bulk path: raw characters or bytes,
+ * ISO temporal text, or the literal's digits. False when it cannot be
+ * converted. */
+static bool bulk_cell(const bulk_value_t *v, argus_cell_t *cell)
+{
+    memset(cell, 0, sizeof(*cell));
+    if (v->len == SQL_NULL_DATA) {
+        cell->is_null = true;
+        return true;
+    }
+
+    char text[64];
+    const char *type = NULL;
+    const char *src = NULL;
+    size_t len = 0;
+    gchar *utf8 = NULL;
+
+    switch (v->param.value_type) {
+    case SQL_C_CHAR:
+    case SQL_C_DEFAULT:
+    case SQL_C_BINARY:
+        src = (const char *)v->param.value;
+        len = v->len > 0 ? (size_t)v->len : 0;
+        break;
+    case SQL_C_WCHAR: {
+        glong written = 0;
+        utf8 = g_utf16_to_utf8((const gunichar2 *)v->param.value,
+                               (glong)(v->len / (SQLLEN)sizeof(SQLWCHAR)),
+                               NULL, &written, NULL);
+        if (!utf8) return false;
+        src = utf8;
+        len = (size_t)written;
+        break;
+    }
+    default:
+        if (temporal_text(v, text, sizeof(text), &type)) {
+            src = text;
+            len = strlen(text);
+        } else {
+            cell->data = argus_render_param(&v->param);
+            if (!cell->data) return false;
+            cell->data_len = strlen(cell->data);
+            return true;
+        }
+        break;
+    }
+
+    cell->data = malloc(len + 1);
+    if (cell->data) {
+        memcpy(cell->data, src, len);
+        cell->data[len] = '\0';
+        cell->data_len = len;
+    }
+    g_free(utf8);
+    return cell->data != NULL;
+}
+
+/* ── Status bookkeeping ──────────────────────────────────────── */
+
+static void row_failed(bulk_t *b, SQLULEN row, const char *sqlstate,
+                       const char *why)
+{
+    char msg[ARGUS_MAX_MESSAGE_LEN];
+    snprintf(msg, sizeof(msg), "[Argus] Row %lu not added: %s",
+             (unsigned long)row + 1, why);
+    argus_diag_push(&b->stmt->diag, sqlstate, msg, 0);
+    b->status[row] = SQL_ROW_ERROR;
+}
+
+/* Record the outcome of rows[0..n) sent together (rows NULL: rows 0 to
+ * n - 1) */
+static void rows_done(bulk_t *b, const SQLULEN *rows, size_t n,
+                      const bool *ok, const char *error)
+{
+    for (size_t i = 0; i < n; i++) {
+        b->status[rows ? rows[i] : i] = ok[i] ? SQL_ROW_ADDED : SQL_ROW_ERROR;
+        if (ok[i]) b->added++;
+    }
+    if (!error) return;
+    b->incomplete = true;
+    unsigned long first = (unsigned long)(rows ? rows[0] : 0) + 1;
+    unsigned long last = (unsigned long)(rows ? rows[n - 1] : n - 1) + 1;
+    char msg[ARGUS_MAX_MESSAGE_LEN];
+    if (n > 1)
+        snprintf(msg, sizeof(msg), "[Argus] Rows %lu-%lu not all added: %s",
+                 first, last, error);
+    else
+        snprintf(msg, sizeof(msg), "[Argus] Row %lu not added: %s",
+                 first, error);
+    argus_diag_push(&b->stmt->diag, "HY000", msg, 0);
+}
+
+/* Record rows sent together of which the server added only `added`
+ * without saying which: each is SQL_ROW_SUCCESS_WITH_INFO, neither added
+ * nor failed as far as the driver knows */
+static void rows_unknown(bulk_t *b, const bool *ok, size_t added,
+                         const char *error)
+{
+    size_t sent = 0;
+    for (SQLULEN r = 0; r < b->nrows; r++) {
+        if (!ok[r]) continue;
+        b->status[r] = SQL_ROW_SUCCESS_WITH_INFO;
+        sent++;
+    }
+    b->added += added;
+    b->incomplete = true;
+    char msg[ARGUS_MAX_MESSAGE_LEN];
+    snprintf(msg, sizeof(msg), "[Argus] %lu of %lu rows added; which is "
+             "unknown: %s", (unsigned long)added, (unsigned long)sent, error);
+    argus_diag_push(&b->stmt->diag, "01000", msg, 0);
+}
+
+/* The backend's message for a failed call, or a generic one */
+static void backend_error(const argus_dbc_t *dbc, char *buf, size_t size)
+{
+    if (!dbc->backend->get_last_error ||
+        !dbc->backend->get_last_error(dbc->backend_conn, buf, size) ||
+        !buf[0])
+        snprintf(buf, size, "Backend execution failed");
+}
+
+/* ── INSERT ... VALUES ───────────────────────────────────────── */
+
+/* Run one statement on an operation of its own, leaving the cursor's
+ * alone. Returns 0, or -1 with the reason in err. */
+static int run_insert(bulk_t *b, const char *sql, char *err, size_t errlen)
+{
+    argus_stmt_t *stmt = b->stmt;
+    argus_dbc_t *dbc = stmt->dbc;
+    const argus_backend_t *be = dbc->backend;
+    argus_backend_op_t op = NULL;
+
+    if (strlen(sql) > 100)
+        ARGUS_LOG_DEBUG("Bulk insert: %.100s...", sql);
+    else
+        ARGUS_LOG_DEBUG("Bulk insert: %s", sql);
+
+    argus_cancel_t *prev = argus_cancel_enter(&stmt->cancel);
+    int rc = be->execute(dbc->backend_conn, sql, &op);
+    if (rc == 0 && op && be->get_result_metadata) {
+        /* Asynchronous backends (Trino) finish the statement as its
+         * update count is read, and abandoning it would cancel it */
+        argus_column_desc_t cols[BULK_RESULT_COLS];
+        int ncols = 0;
+        if (be->get_result_metadata(dbc->backend_conn, op, cols,
+                                    &ncols) == 0 &&
+            ncols > 0 && ncols <= BULK_RESULT_COLS) {
+            argus_row_cache_t cache;
+            argus_row_cache_init(&cache);
+            do {
+                argus_row_cache_clear(&cache);
+                rc = be->fetch_results(dbc->backend_conn, op,
+                                       ARGUS_DEFAULT_BATCH_SIZE, &cache,
+                                       cols, &ncols);
+            } while (rc == 0 && cache.num_rows > 0 && !cache.exhausted);
+            argus_row_cache_free(&cache);
+        }
+    }
+    argus_cancel_leave(prev);
+    b->statements++;
+
+    if (argus_cancel_requested(&stmt->cancel)) {
+        if (op && be->cancel) be->cancel(dbc->backend_conn, op);
+        b->cancelled = true;
+        rc = -1;
+    }
+    if (rc == 0 && be->get_last_error &&
+        be->get_last_error(dbc->backend_conn, err, errlen) && err[0])
+        rc = -1;
+    else if (rc != 0)
+        backend_error(dbc, err, errlen);
+    if (op) be->close_operation(dbc->backend_conn, op);
+    return rc;
+}
+
+static void run_chunk(bulk_t *b, const char *sql, const SQLULEN *rows,
+                      size_t n)
+{
+    char err[512] = "";
+    bool ok = run_insert(b, sql, err, sizeof(err)) == 0;
+    if (b->cancelled) return;   /* the rows stay SQL_ROW_NOROW */
+
+    bool *oks = g_new(bool, n);
+    for (size_t i = 0; i < n; i++) oks[i] = ok;
+    rows_done(b, rows, n, oks, ok ? NULL : err);
+    g_free(oks);
+}
+
+/* "(v1, v2, ...)" for one row, or NULL with the row marked failed */
+static char *row_values(bulk_t *b, SQLULEN row)
+{
+    GString *out = g_string_new("(");
+    for (int i = 0; i < b->ncols; i++) {
+        bulk_value_t v;
+        bulk_value_kind_t kind = bulk_get(b, i, row, &v);
+        if (kind == BULK_VALUE_DAE) {
+            row_failed(b, row, "HYC00",
+                       "data-at-execution values are not supported");
+            g_string_free(out, TRUE);
+            return NULL;
+        }
+        /* A column ignored in only some rows cannot be left out of one
+         * VALUES list: it is sent as NULL */
+        char *lit = (kind == BULK_VALUE_IGNORE) ? g_strdup("NULL")
+                                                : bulk_literal(&v, b->dialect);
+        if (!lit) {
+            row_failed(b, row, "22018",
+                       "a value cannot be sent as a SQL literal");
+            g_string_free(out, TRUE);
+            return NULL;
+        }
+        if (i > 0) g_string_append(out, ", ");
+        g_string_append(out, lit);
+        g_free(lit);
+    }
+    g_string_append_c(out, ')');
+    return g_string_free(out, FALSE);
+}
+
+static void bulk_add_sql(bulk_t *b, const char *table)
+{
+    argus_dbc_t *dbc = b->stmt->dbc;
+    const argus_dialect_t *d = b->dialect;
+
+    size_t max_rows = dbc->bulk_insert_rows > 0
+        ? (size_t)dbc->bulk_insert_rows : ARGUS_DEFAULT_BULK_INSERT_ROWS;
+    if (d->insert_rows > 0 && (size_t)d->insert_rows < max_rows)
+        max_rows = (size_t)d->insert_rows;
+    size_t max_bytes = dbc->bulk_insert_bytes > 0
+        ? dbc->bulk_insert_bytes : ARGUS_DEFAULT_BULK_INSERT_BYTES;
+
+    GString *sql = g_string_new(NULL);
+    g_string_printf(sql, "%s %s ", d->insert_verb ? d->insert_verb
+                                                  : "INSERT INTO", table);
+    /* Unnamed columns (an INSERT without a column list) are the table's,
+     * in order */
+    if (b->columns[0].name[0]) {
+        for (int i = 0; i < b->ncols; i++) {
+            g_string_append(sql, i > 0 ? ", " : "(");
+            append_ident(sql, (const char *)b->columns[i].name,
+                         d->quote_char);
+        }
+        g_string_append(sql, ") ");
+    }
+    g_string_append(sql, "VALUES ");
+    size_t head_len = sql->len;
+
+    /* A row longer than the budget still goes, in a statement of its own */
+    SQLULEN *chunk = g_new(SQLULEN, max_rows);
+    size_t in_chunk = 0;
+    for (SQLULEN r = 0; r < b->nrows && !b->cancelled; r++) {
+        char *values = row_values(b, r);
+        if (!values) continue;
+        size_t len = strlen(values);
+        if (in_chunk > 0 &&
+            (in_chunk == max_rows || sql->len + 2 + len > max_bytes)) {
+            run_chunk(b, sql->str, chunk, in_chunk);
+            g_string_truncate(sql, head_len);
+            in_chunk = 0;
+        }
+        if (in_chunk > 0) g_string_append(sql, ", ");
+        g_string_append_len(sql, values, (gssize)len);
+        g_free(values);
+        chunk[in_chunk++] = r;
+    }
+    if (in_chunk > 0 && !b->cancelled)
+        run_chunk(b, sql->str, chunk, in_chunk);
+
+    g_free(chunk);
+    g_string_free(sql, TRUE);
+}
+
+/* ── Native bulk path ────────────────────────────────────────── */
+
+/* A row the native path could not convert, reported once the backend is
+ * done */
+typedef struct bulk_failure {
+    SQLULEN     row;
+    const char *sqlstate;
+    const char *why;
+} bulk_failure_t;
+
+/* b's rows as the backend's bulk_insert reads them: each converted from the
+ * bindings when asked for, so only one row's cells exist at a time */
+typedef struct bulk_source {
+    bulk_t       *b;
+    argus_cell_t *cells;        /* the row last handed out */
+    GArray       *failed;       /* bulk_failure_t */
+} bulk_source_t;
+
+static void clear_cells(argus_cell_t *cells, int ncols)
+{
+    for (int i = 0; i < ncols; i++) free(cells[i].data);
+    memset(cells, 0, (size_t)ncols * sizeof(*cells));
+}
+
+static const argus_cell_t *source_get(void *ctx, size_t row)
+{
+    bulk_source_t *src = (bulk_source_t *)ctx;
+    const bulk_t *b = src->b;
+    clear_cells(src->cells, b->ncols);
+
+    bulk_failure_t f = { .row = (SQLULEN)row };
+    for (int i = 0; i < b->ncols && !f.why; i++) {
+        bulk_value_t v;
+        bulk_value_kind_t kind = bulk_get(b, i, (SQLULEN)row, &v);
+        if (kind == BULK_VALUE_DAE) {
+            f.sqlstate = "HYC00";
+            f.why = "data-at-execution values are not supported";
+        } else if (kind == BULK_VALUE_IGNORE) {
+            src->cells[i].is_null = true;
+        } else if (!bulk_cell(&v, &src->cells[i])) {
+            f.sqlstate = "22018";
+            f.why = "a value cannot be converted";
+        }
+    }
+    if (!f.why) return src->cells;
+    g_array_append_val(src->failed, f);
+    return NULL;
+}
+
+/*
+ * Hand the rows to the backend's bulk_insert. Returns false, having recorded
+ * nothing, when the backend declines (the caller then sends INSERT
+ * statements); rows that cannot be converted are reported only once the
+ * backend has taken the others.
+ */
+static bool bulk_add_native(bulk_t *b, const char *table)
+{
+    argus_stmt_t *stmt = b->stmt;
+    argus_dbc_t *dbc = stmt->dbc;
+
+    bulk_source_t src = {
+        .b      = b,
+        .cells  = g_new0(argus_cell_t, b->ncols),
+        .failed = g_array_new(FALSE, FALSE, sizeof(bulk_failure_t)),
+    };
+    argus_bulk_rows_t rows = {
+        .nrows = b->nrows,
+        .get   = source_get,
+        .ctx   = &src,
+    };
+    bool *ok = g_new0(bool, b->nrows);
+    size_t added = 0;
+
+    argus_cancel_t *prev = argus_cancel_enter(&stmt->cancel);
+    int rc = dbc->backend->bulk_insert(dbc->backend_conn, table, b->columns,
+                                       b->ncols, &rows, ok, &added);
+    argus_cancel_leave(prev);
+
+    if (rc != 1) {
+        b->statements++;
+        for (guint i = 0; i < src.failed->len; i++) {
+            const bulk_failure_t *f =
+                &g_array_index(src.failed, bulk_failure_t, i);
+            ok[f->row] = false;
+            row_failed(b, f->row, f->sqlstate, f->why);
+        }
+        size_t sent = 0;
+        for (SQLULEN r = 0; r < b->nrows; r++) sent += ok[r];
+        if (argus_cancel_requested(&stmt->cancel)) {
+            b->cancelled = true;
+        } else if (added > 0 && added < sent) {
+            char err[512] = "";
+            backend_error(dbc, err, sizeof(err));
+            rows_unknown(b, ok, added, err);
+        } else {
+            /* added == 0 with rows sent: none of them went in */
+            if (added < sent)
+                for (SQLULEN r = 0; r < b->nrows; r++) ok[r] = false;
+            char err[512] = "";
+            if (rc != 0 || added < sent)
+                backend_error(dbc, err, sizeof(err));
+            rows_done(b, NULL, b->nrows, ok, err[0] ? err : NULL);
+        }
+    }
+
+    clear_cells(src.cells, b->ncols);
+    g_free(src.cells);
+    g_array_free(src.failed, TRUE);
+    g_free(ok);
+    return rc != 1;
+}
+
+/* ── Running a bulk insert ───────────────────────────────────── */
+
+/*
+ * Insert b's rows into `table` under a `span_name` span, natively where the
+ * backend can, and leave each row's SQL_ROW_* status in b->status. Returns
+ * SQL_SUCCESS when every row went in, SQL_SUCCESS_WITH_INFO when some did or
+ * the server reported a problem, SQL_ERROR when none did.
+ */
+static SQLRETURN bulk_run(bulk_t *b, const char *table, const char *span_name)
+{
+    argus_stmt_t *stmt = b->stmt;
+    argus_dbc_t *dbc = stmt->dbc;
+
+    b->status = g_new(SQLUSMALLINT, b->nrows);
+    for (SQLULEN r = 0; r < b->nrows; r++) b->status[r] = SQL_ROW_NOROW;
+
+    argus_span_t *span = argus_trace_root(dbc->tracer, span_name);
+    argus_trace_attr_str(span, "db.system", dbc->backend->name);
+    argus_span_t *prev_span = argus_trace_enter(span);
+    bool nested = argus_cancel_armed(&stmt->cancel);
+    if (!nested)
+        argus_cancel_begin(&stmt->cancel, (long)stmt->query_timeout);
+
+    if (!dbc->backend->bulk_insert || !bulk_add_native(b, table)) {
+        if (b->dialect->insert_rows >= 0) {
+            bulk_add_sql(b, table);
+        } else {
+            for (SQLULEN r = 0; r < b->nrows; r++)
+                row_failed(b, r, "HYC00", "the backend takes no INSERT");
+        }
+    }
+
+    SQLRETURN ret;
+    if (b->cancelled && argus_stmt_cancelled(stmt))
+        ret = SQL_ERROR;
+    else if (b->added == b->nrows && !b->incomplete)
+        ret = SQL_SUCCESS;
+    else
+        ret = b->added > 0 ? SQL_SUCCESS_WITH_INFO : SQL_ERROR;
+    if (!nested)
+        argus_cancel_end(&stmt->cancel);
+    argus_trace_leave(prev_span);
+
+    ARGUS_LOG_DEBUG("Bulk insert into %s: %lu of %lu rows in %d statement(s)",
+                    table, (unsigned long)b->added, (unsigned long)b->nrows,
+                    b->statements);
+    argus_trace_attr_int(span, "argus.rows", (int64_t)b->added);
+    argus_trace_attr_int(span, "argus.statements", b->statements);
+    argus_trace_end(span, ret == SQL_ERROR ? argus_diag_sqlstate(&stmt->diag)
+                                           : NULL);
+
+    stmt->row_count = (SQLLEN)b->added;
+    if (b->added > 0 && dbc->result_cache)
+        argus_result_cache_invalidate(dbc);
+    if (ret != SQL_SUCCESS) {
+        stmt->errors_total++;
+        dbc->errors_total++;
+    }
+    stmt->diag.return_code = ret;
+    return ret;
+}
+
+/* ── SQL_ADD ─────────────────────────────────────────────────── */
+
+static SQLRETURN bulk_add(argus_stmt_t *stmt)
+{
+    argus_dbc_t *dbc = stmt->dbc;
+    if (!dbc || !dbc->connected || !dbc->backend)
+        return argus_set_error(&stmt->diag, "08003",
+                               "[Argus] Connection not open", 0);
+    if (!stmt->executed || stmt->num_cols <= 0)
+        return argus_set_error(&stmt->diag, "24000",
+                               "[Argus] SQL_ADD needs an open result set "
+                               "over the target table", 0);
+
+    bulk_t b = {
+        .stmt    = stmt,
+        .dialect = argus_dialect_for(dbc),
+        .nrows   = stmt->row_array_size > 0 ? stmt->row_array_size : 1,
+    };
+    if (!dbc->backend->bulk_insert && b.dialect->insert_rows < 0) {
+        char msg[256];
+        snprintf(msg, sizeof(msg),
+                 "[Argus] SQLBulkOperations(SQL_ADD) not supported: %s "
+                 "takes no INSERT ... VALUES", dbc->backend->name);
+        return argus_set_error(&stmt->diag, "HYC00", msg, 0);
+    }
+
+    /* Bound columns, less those the application ignores in every row */
+    b.cols = g_new(int, stmt->num_cols);
+    bool any_bound = false;
+    for (int c = 0; c < stmt->num_cols && c < stmt->bindings_capacity; c++) {
+        if (!stmt->bindings[c].bound) continue;
+        any_bound = true;
+        for (SQLULEN r = 0; r < b.nrows; r++) {
+            bulk_value_t v;
+            if (bulk_value(stmt, c, r, &v) != BULK_VALUE_IGNORE) {
+                b.cols[b.ncols++] = c;
+                break;
+            }
+        }
+    }
+    if (b.ncols == 0) {
+        g_free(b.cols);
+        return argus_set_error(&stmt->diag, any_bound ? "HY000" : "HY010",
+                               any_bound
+                                   ? "[Argus] SQL_ADD: every bound column is "
+                                     "SQL_COLUMN_IGNORE"
+                                   : "[Argus] SQL_ADD needs columns bound "
+                                     "with SQLBindCol", 0);
+    }
+
+    char *table = table_from_query(stmt->query);
+    if (!table) table = table_from_columns(stmt, b.dialect);
+    if (!table) {
+        g_free(b.cols);
+        return argus_set_error(&stmt->diag, "HY000",
+                               "[Argus] SQL_ADD cannot tell which table to "
+                               "add to: the result set must come from a "
+                               "single-table SELECT", 0);
+    }
+
+    b.columns = g_new(argus_column_desc_t, b.ncols);
+    for (int i = 0; i < b.ncols; i++)
+        b.columns[i] = stmt->columns[b.cols[i]];
+
+    SQLRETURN ret = bulk_run(&b, table, "bulk_add");
+    if (stmt->row_status_ptr)
+        memcpy(stmt->row_status_ptr, b.status,
+               (size_t)b.nrows * sizeof(SQLUSMALLINT));
+
+    g_free(b.status);
+    g_free(b.columns);
+    g_free(b.cols);
+    g_free(table);
+    return ret;
+}
+
+/* ── INSERT parameter arrays ─────────────────────────────────── */
+
+/* A name as the server knows it: without its quotes, doubled quotes
+ * undone */
+static void unquote_name(const char *start, const char *end, SQLCHAR *out,
+                         size_t size)
+{
+    size_t n = 0;
+    if (*start == '"' || *start == '`' || *start == '[') {
+        char close = (*start == '[') ? ']' : *start;
+        for (const char *p = start + 1; p < end - 1 && n + 1 < size; p++) {
+            out[n++] = (SQLCHAR)*p;
+            if (*p == close && p + 1 < end - 1 && p[1] == close) p++;
+        }
+    } else {
+        for (const char *p = start; p < end && n + 1 < size; p++)
+            out[n++] = (SQLCHAR)*p;
+    }
+    out[n] = '\0';
+}
+
+/*
+ * Parse "INSERT INTO t [(c1, ...)] VALUES (?, ...)" with one marker per
+ * bound parameter and nothing else. Returns the table as written, and the
+ * column names into b->columns (empty without a column list); NULL for any
+ * other statement.
+ */
+static char *parse_insert(bulk_t *b, const char *sql, int nparams)
+{
+    const char *p = argus_sql_skip_leading(sql);
+    if (!p || !argus_sql_keyword_at(p, "INSERT")) return NULL;
+    p = skip_space(p + 6);
+    if (!argus_sql_keyword_at(p, "INTO")) return NULL;
+    const char *start = skip_space(p + 4);
+
+    const char *end = start;
+    for (;;) {
+        end = scan_name(end);
+        if (!end) return NULL;
+        if (*end != '.') break;
+        end++;
+    }
+
+    b->columns = g_new0(argus_column_desc_t, nparams);
+    p = skip_space(end);
+    if (*p == '(') {
+        int n = 0;
+        p = skip_space(p + 1);
+        for (;;) {
+            const char *name_end = scan_name(p);
+            if (!name_end || n == nparams) return NULL;
+            unquote_name(p, name_end, b->columns[n].name,
+                         sizeof(b->columns[n].name));
+            n++;
+            p = skip_space(name_end);
+            if (*p == ')') break;
+            if (*p != ',') return NULL;
+            p = skip_space(p + 1);
+        }
+        if (n != nparams) return NULL;
+        p = skip_space(p + 1);
+    }
+
+    if (!argus_sql_keyword_at(p, "VALUES")) return NULL;
+    p = skip_space(p + 6);
+    if (*p != '(') return NULL;
+    for (int i = 0; i < nparams; i++) {
+        p = skip_space(p + 1);
+        if (*p != '?') return NULL;
+        p = skip_space(p + 1);
+        if (*p != (i + 1 < nparams ? ',' : ')')) return NULL;
+    }
+    p = skip_space(p + 1);
+    if (*p == ';') p = skip_space(p + 1);
+    if (*p) return NULL;
+    return g_strndup(start, (gsize)(end - start));
+}
+
+bool argus_bulk_insert_params(argus_stmt_t *stmt, SQLULEN nrows,
+                              SQLRETURN *out_ret)
+{
+    argus_dbc_t *dbc = stmt->dbc;
+    int nparams = stmt->num_param_bindings;
+    if (!dbc || !dbc->connected || !dbc->backend ||
+        !dbc->backend->bulk_insert || nparams <= 0 || nrows < 2)
+        return false;
+
+    /* Input parameters only, and no data at execution in any row */
+    for (int i = 0; i < nparams; i++) {
+        const argus_param_binding_t *p = &stmt->param_bindings[i];
+        if (!p->bound || p->io_type != SQL_PARAM_INPUT) return false;
+    }
+
+    bulk_t b = {
+        .stmt    = stmt,
+        .dialect = argus_dialect_for(dbc),
+        .params  = stmt->param_bindings,
+        .ncols   = nparams,
+        .nrows   = nrows,
+    };
+    b.cols = g_new(int, nparams);
+    for (int i = 0; i < nparams; i++) b.cols[i] = i;
+    for (SQLULEN r = 0; r < nrows; r++) {
+        for (int i = 0; i < nparams; i++) {
+            bulk_value_t v;
+            if (bulk_get(&b, i, r, &v) != BULK_VALUE_OK) {
+                g_free(b.cols);
+                return false;
+            }
+        }
+    }
+
+    char *table = parse_insert(&b, stmt->query, nparams);
+    if (!table) {
+        g_free(b.columns);
+        g_free(b.cols);
+        return false;
+    }
+    for (int i = 0; i < nparams; i++) {
+        b.columns[i].sql_type       = stmt->param_bindings[i].param_type;
+        b.columns[i].column_size    = stmt->param_bindings[i].column_size;
+        b.columns[i].decimal_digits = stmt->param_bindings[i].decimal_digits;
+        b.columns[i].nullable       = SQL_NULLABLE_UNKNOWN;
+    }
+
+    /* Ask before touching the statement: a connection that cannot take the
+     * rows (one without BulkLoad) leaves them to one statement per row, as
+     * without a bulk path */
+    if (dbc->backend->bulk_insert(dbc->backend_conn, table, b.columns,
+                                  nparams, NULL, NULL, NULL) != 0) {
+        g_free(table);
+        g_free(b.columns);
+        g_free(b.cols);
+        return false;
+    }
+
+    argus_stmt_reset_result(stmt);
+    SQLRETURN ret = bulk_run(&b, table, "bulk_insert");
+    stmt->executed = true;
+
+    if (stmt->param_status_ptr) {
+        for (SQLULEN r = 0; r < nrows; r++)
+            stmt->param_status_ptr[r] =
+                b.status[r] == SQL_ROW_ADDED ? SQL_PARAM_SUCCESS
+                : b.status[r] == SQL_ROW_ERROR ? SQL_PARAM_ERROR
+                : b.status[r] == SQL_ROW_SUCCESS_WITH_INFO
+                    ? SQL_PARAM_DIAG_UNAVAILABLE
+                : SQL_PARAM_UNUSED;
+    }
+    if (stmt->params_processed_ptr) {
+        SQLULEN done = 0;
+        for (SQLULEN r = 0; r < nrows; r++)
+            if (b.status[r] != SQL_ROW_NOROW) done++;
+        *stmt->params_processed_ptr = done;
+    }
+
+    g_free(b.status);
+    g_free(b.columns);
+    g_free(b.cols);
+    g_free(table);
+    *out_ret = ret;
+    return true;
+}
+
+/* ── ODBC API: SQLBulkOperations ─────────────────────────────── */
+
+SQLRETURN SQL_API SQLBulkOperations(
+    SQLHSTMT    StatementHandle,
+    SQLSMALLINT Operation)
+{
+    argus_stmt_t *stmt = (argus_stmt_t *)StatementHandle;
+    if (!argus_valid_stmt(stmt)) return SQL_INVALID_HANDLE;
+
+    ARGUS_STMT_LOCK(stmt);
+    argus_diag_clear(&stmt->diag);
+
+    SQLRETURN ret = SQL_ERROR;
+    const char *what = NULL;
+    switch (Operation) {
+    case SQL_ADD:
+        ret = bulk_add(stmt);
+        break;
+    case SQL_UPDATE_BY_BOOKMARK: what = "SQL_UPDATE_BY_BOOKMARK"; break;
+    case SQL_DELETE_BY_BOOKMARK: what = "SQL_DELETE_BY_BOOKMARK"; break;
+    case SQL_FETCH_BY_BOOKMARK:  what = "SQL_FETCH_BY_BOOKMARK"; break;
+    default:
+        ret = argus_set_error(&stmt->diag, "HY092",
+                              "[Argus] Invalid SQLBulkOperations operation",
+                              0);
+        break;
+    }
+    if (what) {
+        char msg[256];
+        snprintf(msg, sizeof(msg),
+                 "[Argus] SQLBulkOperations(%s) not supported: the driver "
+                 "keeps no bookmarks; issue a direct UPDATE/DELETE statement "
+                 "instead", what);
+        ret = argus_set_error(&stmt->diag, "HYC00", msg, 0);
+    }
+
+    ARGUS_STMT_UNLOCK(stmt);
+    return ret;
+}
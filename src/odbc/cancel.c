@@ -0,0 +1,261 @@
+/*
+ * cancel.c - Cooperative cancellation of backend calls (see argus/cancel.h).
+ */
+
+#include "argus/cancel.h"
+#include "argus/handle.h"
+#include "argus/log.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+/* The token bound to this thread by argus_cancel_enter */
+static GPrivate g_cancel_current = G_PRIVATE_INIT(NULL);
+
+/* ── Deadline timer ──────────────────────────────────────────── */
+
+/* The timer task can run after the arming it was scheduled for has ended,
+ * or after the token itself is gone, so it reaches the token only through
+ * this link, which argus_cancel_end cuts. */
+struct argus_cancel_watch {
+    gint            refs;       /* the token's and the timer task's */
+    GMutex          lock;
+    argus_cancel_t *token;      /* NULL once disarmed */
+};
+
+static void watch_unref(argus_cancel_watch_t *w)
+{
+    if (!g_atomic_int_dec_and_test(&w->refs)) return;
+    g_mutex_clear(&w->lock);
+    free(w);
+}
+
+/* The deadline passed: take the path SQLCancel takes, so the abort action
+ * of a call blocked in a read (KILL QUERY, a transport abort) runs too */
+static void watch_fire(void *data)
+{
+    argus_cancel_watch_t *w = (argus_cancel_watch_t *)data;
+    g_mutex_lock(&w->lock);
+    if (w->token) {
+        ARGUS_LOG_DEBUG("Cancel: query timeout expired");
+        argus_cancel_request(w->token);
+    }
+    g_mutex_unlock(&w->lock);
+    watch_unref(w);
+}
+
+static argus_cancel_watch_t *watch_arm(argus_cancel_t *c, long timeout_sec)
+{
+    if (timeout_sec > INT_MAX / 1000) return NULL;  /* polled only */
+
+    argus_cancel_watch_t *w = malloc(sizeof(*w));
+    if (!w) return NULL;
+    g_mutex_init(&w->lock);
+    w->refs = 2;
+    w->token = c;
+    if (!argus_executor_schedule(watch_fire, w, (int)timeout_sec * 1000)) {
+        g_mutex_clear(&w->lock);
+        free(w);
+        return NULL;
+    }
+    return w;
+}
+
+/* Cut the link, waiting for a firing in progress. Called without c->lock:
+ * watch_fire takes the watch's lock before the token's. */
+static void watch_disarm(argus_cancel_watch_t *w)
+{
+    if (!w) return;
+    g_mutex_lock(&w->lock);
+    w->token = NULL;
+    g_mutex_unlock(&w->lock);
+    watch_unref(w);
+}
+
+static argus_cancel_watch_t *watch_take(argus_cancel_t *c)
+{
+    g_mutex_lock(&c->lock);
+    argus_cancel_watch_t *w = c->watch;
+    c->watch = NULL;
+    g_mutex_unlock(&c->lock);
+    return w;
+}
+
+/* ── Token ───────────────────────────────────────────────────── */
+
+void argus_cancel_init(argus_cancel_t *c)
+{
+    g_mutex_init(&c->lock);
+    g_cond_init(&c->abort_done);
+    c->armed = false;
+    c->aborting = false;
+    c->requested = 0;
+    c->deadline = 0;
+    c->abort_fn = NULL;
+    c->abort_data = NULL;
+    c->watch = NULL;
+}
+
+void argus_cancel_clear(argus_cancel_t *c)
+{
+    watch_disarm(watch_take(c));
+    g_cond_clear(&c->abort_done);
+    g_mutex_clear(&c->lock);
+}
+
+void argus_cancel_begin(argus_cancel_t *c, long timeout_sec)
+{
+    watch_disarm(watch_take(c));
+
+    g_mutex_lock(&c->lock);
+    c->armed = true;
+    g_atomic_int_set(&c->requested, 0);
+    c->deadline = timeout_sec > 0
+        ? g_get_monotonic_time() + (gint64)timeout_sec * G_USEC_PER_SEC
+        : 0;
+    g_mutex_unlock(&c->lock);
+
+    /* Scheduled after the deadline is set, so it is due no earlier: when it
+     * fires, argus_cancel_timed_out already holds and the call reports
+     * HYT00. If it cannot be scheduled the deadline is still polled. */
+    argus_cancel_watch_t *w = timeout_sec > 0 ? watch_arm(c, timeout_sec)
+                                              : NULL;
+    if (w) {
+        g_mutex_lock(&c->lock);
+        c->watch = w;
+        g_mutex_unlock(&c->lock);
+    }
+}
+
+void argus_cancel_end(argus_cancel_t *c)
+{
+    g_mutex_lock(&c->lock);
+    c->armed = false;
+    c->deadline = 0;
+    g_atomic_int_set(&c->requested, 0);
+    argus_cancel_watch_t *w = c->watch;
+    c->watch = NULL;
+    g_mutex_unlock(&c->lock);
+    watch_disarm(w);
+}
+
+bool argus_cancel_armed(argus_cancel_t *c)
+{
+    g_mutex_lock(&c->lock);
+    bool armed = c->armed;
+    g_mutex_unlock(&c->lock);
+    return armed;
+}
+
+/* The abort action can take a while (KILL QUERY logs in on a new
+ * connection), so it runs outside the lock: the deadline checks made from
+ * the curl progress callback must not wait on it. `aborting` makes
+ * argus_cancel_pop wait for it instead, so the backend does not free what
+ * it points at while it is still running. */
+bool argus_cancel_request(argus_cancel_t *c)
+{
+    g_mutex_lock(&c->lock);
+    bool armed = c->armed;
+    argus_cancel_fn fn = NULL;
+    void *data = NULL;
+    if (armed) {
+        g_atomic_int_set(&c->requested, 1);
+        fn = c->abort_fn;
+        data = c->abort_data;
+        c->abort_fn = NULL;
+        c->aborting = fn != NULL;
+    }
+    g_mutex_unlock(&c->lock);
+
+    if (fn) {
+        fn(data);
+        g_mutex_lock(&c->lock);
+        c->aborting = false;
+        g_cond_broadcast(&c->abort_done);
+        g_mutex_unlock(&c->lock);
+    }
+    return armed;
+}
+
+argus_cancel_t *argus_cancel_enter(argus_cancel_t *c)
+{
+    argus_cancel_t *prev = g_private_get(&g_cancel_current);
+    g_private_set(&g_cancel_current, c);
+    return prev;
+}
+
+void argus_cancel_leave(argus_cancel_t *prev)
+{
+    g_private_set(&g_cancel_current, prev);
+}
+
+argus_cancel_t *argus_cancel_current(void)
+{
+    return g_private_get(&g_cancel_current);
+}
+
+bool argus_cancel_requested(argus_cancel_t *c)
+{
+    if (!c) return false;
+    if (g_atomic_int_get(&c->requested)) return true;
+    return argus_cancel_timed_out(c);
+}
+
+bool argus_cancel_timed_out(argus_cancel_t *c)
+{
+    if (!c) return false;
+    g_mutex_lock(&c->lock);
+    gint64 deadline = c->deadline;
+    g_mutex_unlock(&c->lock);
+    return deadline > 0 && g_get_monotonic_time() >= deadline;
+}
+
+long argus_cancel_remaining_ms(argus_cancel_t *c)
+{
+    if (!c) return -1;
+    g_mutex_lock(&c->lock);
+    gint64 deadline = c->deadline;
+    g_mutex_unlock(&c->lock);
+    if (deadline <= 0) return -1;
+    gint64 left = (deadline - g_get_monotonic_time()) / 1000;
+    return left > 0 ? (long)left : 0;
+}
+
+bool argus_cancel_push(argus_cancel_t *c, argus_cancel_fn fn, void *data)
+{
+    if (!c) return true;
+    g_mutex_lock(&c->lock);
+    bool ok = !g_atomic_int_get(&c->requested);
+    if (ok) {
+        c->abort_fn = fn;
+        c->abort_data = data;
+    }
+    g_mutex_unlock(&c->lock);
+    return ok;
+}
+
+void argus_cancel_pop(argus_cancel_t *c)
+{
+    if (!c) return;
+    g_mutex_lock(&c->lock);
+    c->abort_fn = NULL;
+    c->abort_data = NULL;
+    while (c->aborting)
+        g_cond_wait(&c->abort_done, &c->lock);
+    g_mutex_unlock(&c->lock);
+}
+
+/* ── Statement diagnostics ───────────────────────────────────── */
+
+bool argus_stmt_cancelled(argus_stmt_t *stmt)
+{
+    if (!argus_cancel_requested(&stmt->cancel)) return false;
+    argus_diag_clear(&stmt->diag);
+    if (argus_cancel_timed_out(&stmt->cancel))
+        argus_set_error(&stmt->diag, "HYT00",
+                        "[Argus] Query timeout expired", 0);
+    else
+        argus_set_error(&stmt->diag, "HY008",
+                        "[Argus] Operation cancelled", 0);
+    return true;
+}
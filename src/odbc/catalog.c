@@ -46,6 +46,29 @@ static char *catalog_arg_dup(const SQLCHAR *str, SQLSMALLINT len,
     return raw;
 }
 
+/* ── Helper: tracing ─────────────────────────────────────────── */
+
+/* A "metadata" span for a catalog function that goes to the backend, bound
+ * to the calling thread (*prev is the binding to restore) */
+static argus_span_t *catalog_trace_begin(argus_stmt_t *stmt, const char *func,
+                                         argus_span_t **prev)
+{
+    argus_span_t *span = argus_trace_root(stmt->dbc->tracer, "metadata");
+    argus_trace_attr_str(span, "argus.function", func);
+    *prev = argus_trace_enter(span);
+    return span;
+}
+
+static void catalog_trace_end(argus_stmt_t *stmt, argus_span_t *span,
+                              argus_span_t *prev, bool ok)
+{
+    argus_trace_leave(prev);
+    if (!span) return;
+    if (ok)
+        argus_trace_attr_int(span, "argus.rows", stmt->row_cache.num_rows);
+    argus_trace_end(span, ok ? NULL : argus_diag_sqlstate(&stmt->diag));
+}
+
 /* ── Helper: dispatch catalog operation and setup result set ─── */
 
 static SQLRETURN catalog_dispatch(argus_stmt_t *stmt)
@@ -113,7 +136,10 @@ SQLRETURN SQL_API SQLTables(
     char *table_type = catalog_arg_dup(TableType,   NameLength4, mid);
 
     /* Check metadata cache first */
-    if (argus_metadata_cache_lookup(dbc, stmt, "SQLTables",
+    if (argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", catalog, schema,
+                                      table_name, table_type,
+                                      mid == SQL_TRUE) ||
+        argus_metadata_cache_lookup(dbc, stmt, "SQLTables",
                                      catalog, schema, table_name, table_type)) {
         free(catalog);
         free(schema);
@@ -122,6 +148,8 @@ SQLRETURN SQL_API SQLTables(
         return SQL_SUCCESS;
     }
 
+    argus_span_t *prev_span;
+    argus_span_t *span = catalog_trace_begin(stmt, "SQLTables", &prev_span);
     int rc = dbc->backend->get_tables(
         dbc->backend_conn,
         catalog, schema, table_name, table_type,
@@ -135,6 +163,7 @@ SQLRETURN SQL_API SQLTables(
         if (stmt->diag.count == 0)
             argus_set_error(&stmt->diag, "HY000",
                             "[Argus] Failed to get tables", 0);
+        catalog_trace_end(stmt, span, prev_span, false);
         return SQL_ERROR;
     }
 
@@ -159,6 +188,7 @@ SQLRETURN SQL_API SQLTables(
         argus_metadata_cache_store(dbc, stmt, "SQLTables",
                                     catalog, schema, table_name, table_type);
     }
+    catalog_trace_end(stmt, span, prev_span, ret == SQL_SUCCESS);
 
     free(catalog);
     free(schema);
@@ -200,7 +230,10 @@ SQLRETURN SQL_API SQLColumns(
     char *column_name = catalog_arg_dup(ColumnName,  NameLength4, mid2);
 
     /* Check metadata cache first */
-    if (argus_metadata_cache_lookup(dbc, stmt, "SQLColumns",
+    if (argus_metadata_cache_snapshot(dbc, stmt, "SQLColumns", catalog, schema,
+                                      table_name, column_name,
+                                      mid2 == SQL_TRUE) ||
+        argus_metadata_cache_lookup(dbc, stmt, "SQLColumns",
                                      catalog, schema, table_name, column_name)) {
         free(catalog);
         free(schema);
@@ -209,6 +242,8 @@ SQLRETURN SQL_API SQLColumns(
         return SQL_SUCCESS;
     }
 
+    argus_span_t *prev_span;
+    argus_span_t *span = catalog_trace_begin(stmt, "SQLColumns", &prev_span);
     int rc = dbc->backend->get_columns(
         dbc->backend_conn,
         catalog, schema, table_name, column_name,
@@ -222,6 +257,7 @@ SQLRETURN SQL_API SQLColumns(
         if (stmt->diag.count == 0)
             argus_set_error(&stmt->diag, "HY000",
                             "[Argus] Failed to get columns", 0);
+        catalog_trace_end(stmt, span, prev_span, false);
         return SQL_ERROR;
     }
 
@@ -246,6 +282,7 @@ SQLRETURN SQL_API SQLColumns(
         argus_metadata_cache_store(dbc, stmt, "SQLColumns",
                                     catalog, schema, table_name, column_name);
     }
+    catalog_trace_end(stmt, span, prev_span, ret == SQL_SUCCESS);
 
     free(catalog);
     free(schema);
@@ -508,11 +545,15 @@ SQLRETURN SQL_API SQLGetTypeInfo(
 
     /* If backend implements get_type_info, delegate */
     if (dbc->backend->get_type_info) {
+        argus_span_t *prev_span;
+        argus_span_t *span = catalog_trace_begin(stmt, "SQLGetTypeInfo",
+                                                 &prev_span);
         int rc = dbc->backend->get_type_info(
             dbc->backend_conn, DataType, &stmt->op);
-
+        SQLRETURN ret = rc == 0 ? catalog_dispatch(stmt) : SQL_ERROR;
+        catalog_trace_end(stmt, span, prev_span, rc == 0);
         if (rc == 0)
-            return catalog_dispatch(stmt);
+            return ret;
 
         /* Backend failed — fall through to built-in */
         argus_diag_clear(&stmt->diag);
@@ -584,6 +625,9 @@ SQLRETURN SQL_API SQLStatistics(
         char *schema     = argus_str_dup_short(SchemaName,  NameLength2);
         char *table_name = argus_str_dup_short(TableName,   NameLength3);
 
+        argus_span_t *prev_span;
+        argus_span_t *span = catalog_trace_begin(stmt, "SQLStatistics",
+                                                 &prev_span);
         int rc = dbc->backend->get_statistics(
             dbc->backend_conn,
             catalog, schema, table_name,
@@ -598,10 +642,13 @@ SQLRETURN SQL_API SQLStatistics(
             if (stmt->diag.count == 0)
                 argus_set_error(&stmt->diag, "HY000",
                                 "[Argus] Failed to get statistics", 0);
+            catalog_trace_end(stmt, span, prev_span, false);
             return SQL_ERROR;
         }
 
-        return catalog_dispatch(stmt);
+        SQLRETURN ret = catalog_dispatch(stmt);
+        catalog_trace_end(stmt, span, prev_span, true);
+        return ret;
     }
 
     /* Return empty result set with proper metadata */
@@ -734,6 +781,9 @@ SQLRETURN SQL_API SQLPrimaryKeys(
         char *schema     = argus_str_dup_short(SchemaName,  NameLength2);
         char *table_name = argus_str_dup_short(TableName,   NameLength3);
 
+        argus_span_t *prev_span;
+        argus_span_t *span = catalog_trace_begin(stmt, "SQLPrimaryKeys",
+                                                 &prev_span);
         int rc = dbc->backend->get_primary_keys(
             dbc->backend_conn,
             catalog, schema, table_name,
@@ -749,8 +799,10 @@ SQLRETURN SQL_API SQLPrimaryKeys(
          * result set rather than erroring: catalog functions must return the
          * correct column shape, and a malformed/erroring SQLPrimaryKeys
          * crashes strict clients enumerating metadata. */
+        SQLRETURN ret = rc == 0 ? catalog_dispatch(stmt) : SQL_ERROR;
+        catalog_trace_end(stmt, span, prev_span, rc == 0);
         if (rc == 0)
-            return catalog_dispatch(stmt);
+            return ret;
         argus_diag_clear(&stmt->diag);
     }
 
@@ -64,10 +64,6 @@ static char *obs_redact_connstr(const char *s)
 
 /* ── Internal: multi-host + secret helpers for do_connect ────── */
 
-/* Hosts a HOST=h1,h2,h3 failover list may carry (bare IPv6 addresses are not
- * supported in the list form — use a single HOST for IPv6). */
-#define ARGUS_MAX_HOSTS 16
-
 /* Split "host[:port]" into host_out; *port_inout only changes when a numeric
  * :port suffix is present. */
 static void split_host_port(const char *entry, char *host_out, size_t out_size,
@@ -97,9 +93,240 @@ static void obs_resolve_secret_field(char **field)
     }
 }
 
+/* ── Internal: failover host order and connection racing ─────── */
+
+/* Next host to try: the tap's pick (argus_obs_hook_pick_host) when it names
+ * an untried host, else the healthiest untried one. -1 when all are tried. */
+static int next_host(argus_dbc_t *dbc, const char *host_csv,
+                     const int *health, int nhosts, gboolean *tried)
+{
+    int idx = argus_obs_hook_pick_host(dbc, host_csv, nhosts);
+    if (idx < 0 || idx >= nhosts || tried[idx]) {
+        idx = -1;
+        for (int k = 0; k < nhosts; k++) {
+            if (!tried[health[k]]) { idx = health[k]; break; }
+        }
+        if (idx < 0) return -1;
+    }
+    tried[idx] = TRUE;
+    return idx;
+}
+
+typedef struct connect_race connect_race_t;
+
+typedef struct {
+    connect_race_t        *race;
+    argus_dbc_t           *cfg;       /* settings copy: losers outlive dbc */
+    char                   host[256];
+    int                    port;
+    int                    idx;       /* position in the HOST list */
+    argus_backend_conn_t   conn;
+    int                    rc;
+} connect_attempt_t;
+
+struct connect_race {
+    GMutex                 lock;
+    GCond                  cond;
+    int                    refs;      /* the caller + running attempts */
+    const argus_backend_t *backend;
+    char                  *host_csv;
+    const void            *owner;     /* dbc, as the taps' opaque identity */
+    int                    cooldown_sec;
+    int                    started;
+    int                    running;
+    int                    failed;
+    int                    winner;    /* attempt index, or -1 */
+    int                    last_failed;
+    connect_attempt_t      attempts[ARGUS_MAX_HOSTS];
+};
+
+static void connect_race_unref(connect_race_t *race)
+{
+    g_mutex_lock(&race->lock);
+    bool last = --race->refs == 0;
+    g_mutex_unlock(&race->lock);
+    if (!last) return;
+
+    for (int i = 0; i < race->started; i++)
+        argus_dbc_free_config(race->attempts[i].cfg);
+    g_free(race->host_csv);
+    g_cond_clear(&race->cond);
+    g_mutex_clear(&race->lock);
+    free(race);
+}
+
+static gpointer connect_attempt_run(gpointer data)
+{
+    connect_attempt_t *a = (connect_attempt_t *)data;
+    connect_race_t *race = a->race;
+    const argus_backend_t *backend = race->backend;
+    const argus_dbc_t *cfg = a->cfg;
+    argus_backend_conn_t conn = NULL;
+
+    gint64 start = g_get_monotonic_time();
+    int rc = backend->connect(a->cfg, a->host, a->port,
+                              cfg->username ? cfg->username : "",
+                              cfg->password ? cfg->password : "",
+                              cfg->database ? cfg->database : "default",
+                              cfg->auth_mechanism ? cfg->auth_mechanism
+                                                  : "NOSASL",
+                              &conn);
+    double ms = (double)(g_get_monotonic_time() - start) / 1000.0;
+    argus_host_health_record(a->host, a->port, rc == 0, ms,
+                             race->cooldown_sec);
+    argus_obs_hook_host_result(race->owner, race->host_csv, a->idx, rc == 0);
+
+    bool surplus = false;
+    g_mutex_lock(&race->lock);
+    a->rc = rc;
+    race->running--;
+    if (rc != 0) {
+        race->failed++;
+        race->last_failed = (int)(a - race->attempts);
+        ARGUS_LOG_WARN("Connection failed: host=%s:%d, rc=%d", a->host,
+                       a->port, rc);
+    } else if (race->winner < 0) {
+        race->winner = (int)(a - race->attempts);
+        a->conn = conn;
+    } else {
+        surplus = true;
+    }
+    g_cond_broadcast(&race->cond);
+    g_mutex_unlock(&race->lock);
+
+    /* Another host won meanwhile */
+    if (surplus) {
+        ARGUS_LOG_DEBUG("Closing surplus connection to %s:%d", a->host,
+                        a->port);
+        backend->disconnect(conn);
+    }
+    connect_race_unref(race);
+    return NULL;
+}
+
+/* Start the next attempt of the race. Called with race->lock held. */
+static void connect_race_start(connect_race_t *race, argus_dbc_t *dbc,
+                               const char *host, int port, int idx)
+{
+    connect_attempt_t *a = &race->attempts[race->started++];
+    a->race = race;
+    a->idx = idx;
+    a->port = port;
+    g_strlcpy(a->host, host, sizeof(a->host));
+    a->cfg = argus_dbc_clone_config(dbc);
+
+    ARGUS_LOG_INFO("Connecting to %s backend at %s:%d [race %d]",
+                   race->backend->name, host, port, race->started);
+    GThread *thread = NULL;
+    if (a->cfg) {
+        race->refs++;
+        race->running++;
+        thread = g_thread_try_new("argus-connect", connect_attempt_run, a,
+                                  NULL);
+        if (!thread) {
+            race->refs--;
+            race->running--;
+        }
+    }
+    if (thread) {
+        g_thread_unref(thread);
+    } else {
+        a->rc = -1;
+        race->failed++;
+        race->last_failed = race->started - 1;
+    }
+}
+
+/*
+ * Happy-eyeballs connect across a HOST list: start the healthiest host,
+ * then the next one whenever an attempt fails or delay_ms pass without a
+ * result, and keep the first connection that succeeds. Attempts still
+ * running when a host wins close their connection when they finish.
+ * Returns 0 and the winner, or -1 with the last failure's diagnostics in
+ * dbc->diag.
+ */
+static int connect_race_run(argus_dbc_t *dbc, const argus_backend_t *backend,
+                            const char *host_csv, char hnames[][256],
+                            const int *hports, const int *health, int nhosts,
+                            int *out_idx, argus_backend_conn_t *out_conn)
+{
+    connect_race_t *race = calloc(1, sizeof(*race));
+    if (!race) return -1;
+    g_mutex_init(&race->lock);
+    g_cond_init(&race->cond);
+    race->refs = 1;
+    race->backend = backend;
+    race->host_csv = g_strdup(host_csv);
+    race->owner = dbc;
+    race->cooldown_sec = dbc->host_cooldown_sec;
+    race->winner = -1;
+    race->last_failed = -1;
+
+    gboolean tried[ARGUS_MAX_HOSTS] = { FALSE };
+    int failed_seen = 0;
+    gint64 next_at = 0;
+
+    g_mutex_lock(&race->lock);
+    while (race->winner < 0) {
+        bool more = race->started < nhosts;
+        if (more && (race->running == 0 || race->failed > failed_seen ||
+                     g_get_monotonic_time() >= next_at)) {
+            int idx = next_host(dbc, host_csv, health, nhosts, tried);
+            if (idx < 0) {
+                nhosts = race->started;     /* nothing left to start */
+                continue;
+            }
+            failed_seen = race->failed;
+            next_at = g_get_monotonic_time() +
+                      (gint64)dbc->connect_race_delay_ms * 1000;
+            connect_race_start(race, dbc, hnames[idx], hports[idx], idx);
+            continue;
+        }
+        if (race->running == 0)
+            break;                          /* every host failed */
+        if (more)
+            g_cond_wait_until(&race->cond, &race->lock, next_at);
+        else
+            g_cond_wait(&race->cond, &race->lock);
+    }
+
+    int rc = -1;
+    if (race->winner >= 0) {
+        connect_attempt_t *a = &race->attempts[race->winner];
+        *out_idx = a->idx;
+        *out_conn = a->conn;
+        rc = 0;
+    } else if (race->last_failed >= 0 &&
+               race->attempts[race->last_failed].cfg) {
+        dbc->diag = race->attempts[race->last_failed].cfg->diag;
+    }
+    g_mutex_unlock(&race->lock);
+    connect_race_unref(race);
+    return rc;
+}
+
 /* ── Internal: perform the actual connection ─────────────────── */
 
-static SQLRETURN do_connect(argus_dbc_t *dbc)
+/* Captured and replayed connections stay out of the pool: the pool key
+ * knows neither the capture file nor the replay file, so a pooled one could
+ * be handed to a connection that asked for something else. */
+static bool pooling_enabled(const argus_dbc_t *dbc)
+{
+    return dbc->env && dbc->env->connection_pooling != SQL_CP_OFF &&
+           !dbc->capture_file && !dbc->replay_file;
+}
+
+/* POOLMINIDLE: have the pool keep connections to host:port open ahead of
+ * demand, made with this connection's settings. */
+static void pool_keep_warm(argus_dbc_t *dbc, const char *host, int port,
+                           const char *backend_name, const char *user)
+{
+    if (dbc->pool_min_idle > 0 && pooling_enabled(dbc))
+        argus_pool_warm(dbc, host, port, backend_name, user, dbc->backend,
+                        dbc->pool_min_idle);
+}
+
+static SQLRETURN connect_backend(argus_dbc_t *dbc, argus_span_t *span)
 {
     /* Default backend depends on what was compiled in */
 #ifdef ARGUS_HAS_THRIFT_BACKENDS
@@ -123,7 +350,17 @@ static SQLRETURN do_connect(argus_dbc_t *dbc)
         return argus_set_error(&dbc->diag, "HY000", msg, 0);
     }
 
+    /* CAPTUREFILE: record this connection's traffic for BACKEND=replay */
+    if (dbc->capture_file) {
+        backend = argus_capture_backend(backend);
+        if (!backend) {
+            return argus_set_error(&dbc->diag, "HY000",
+                                   "[Argus] Cannot capture this backend", 0);
+        }
+    }
+
     dbc->backend = backend;
+    argus_trace_attr_str(span, "db.system", backend_name);
 
     /* ── Enterprise license gate (tap; the open build's weak stub returns 1) ──
      * Placed right after backend resolution so per-backend entitlements apply,
@@ -182,15 +419,30 @@ static SQLRETURN do_connect(argus_dbc_t *dbc)
         nhosts = 1;
     }
 
-    /* Try pool first if connection pooling is enabled (first host's key) */
-    if (dbc->env && dbc->env->connection_pooling != SQL_CP_OFF) {
-        char phost[256];
-        int pport = port;
-        split_host_port(hosts[0], phost, sizeof(phost), &pport);
-        const argus_backend_t *pooled_backend = NULL;
-        argus_backend_conn_t pooled_conn = argus_pool_acquire(
-            phost, pport, backend_name, user, &pooled_backend);
-        if (pooled_conn) {
+    char hnames[ARGUS_MAX_HOSTS][256];
+    const char *hname_ptrs[ARGUS_MAX_HOSTS];
+    int hports[ARGUS_MAX_HOSTS];
+    for (int i = 0; i < nhosts; i++) {
+        hports[i] = port;
+        split_host_port(hosts[i], hnames[i], sizeof(hnames[i]), &hports[i]);
+        hname_ptrs[i] = hnames[i];
+    }
+    g_strfreev(hosts);
+
+    /* Healthiest first: past latency, failures and open circuit breakers */
+    int health[ARGUS_MAX_HOSTS];
+    argus_host_health_order(hname_ptrs, hports, nhosts, health);
+
+    /* Try pool first if connection pooling is enabled (any host's key) */
+    if (pooling_enabled(dbc)) {
+        for (int i = 0; i < nhosts; i++) {
+            const char *phost = hnames[health[i]];
+            int pport = hports[health[i]];
+            const argus_backend_t *pooled_backend = NULL;
+            argus_backend_conn_t pooled_conn = argus_pool_acquire(
+                phost, pport, backend_name, user, &pooled_backend);
+            if (!pooled_conn) continue;
+
             dbc->backend_conn = pooled_conn;
             dbc->backend = pooled_backend;
             dbc->connected = true;
@@ -200,18 +452,22 @@ static SQLRETURN do_connect(argus_dbc_t *dbc)
             dbc->connected_host = strdup(phost);
             dbc->connected_port = pport;
             ARGUS_LOG_INFO("Acquired pooled connection to %s:%d", phost, pport);
+            argus_trace_attr_str(span, "server.address", phost);
+            argus_trace_attr_int(span, "argus.pooled", 1);
             argus_obs_hook_connect(dbc, dbc->obs_connstr, backend_name, phost,
                                    user, 1, dbc->connect_time_ms);
             argus_telemetry_connect(dbc, true, 1);
-            g_strfreev(hosts);
+            pool_keep_warm(dbc, phost, pport, backend_name, user);
             return SQL_SUCCESS;
         }
     }
 
     /* Retry logic: up to (1 + retry_count) rounds; within a round, fail over
      * across every host (a tap may reorder; the driver guarantees each host
-     * is tried at most once per round). */
+     * is tried at most once per round). With several hosts the attempts of
+     * a round race, staggered by CONNECTRACEDELAY. */
     int max_attempts = 1 + (dbc->retry_count > 0 ? dbc->retry_count : 0);
+    bool race = nhosts > 1 && dbc->connect_race_delay_ms > 0;
     int rc = -1;
     gint64 connect_start = g_get_monotonic_time();
     char chosen[256] = "";
@@ -223,40 +479,57 @@ static SQLRETURN do_connect(argus_dbc_t *dbc)
                            attempt, max_attempts, dbc->retry_delay_sec);
             argus_diag_clear(&dbc->diag);
             sleep_seconds(dbc->retry_delay_sec);
+            argus_host_health_order(hname_ptrs, hports, nhosts, health);
         }
 
-        gboolean tried[ARGUS_MAX_HOSTS] = { FALSE };
-        for (int h = 0; h < nhosts && rc != 0; h++) {
-            int idx = argus_obs_hook_pick_host(dbc, host_csv, nhosts);
-            if (idx < 0 || idx >= nhosts || tried[idx]) {
-                idx = -1;
-                for (int k = 0; k < nhosts; k++)
-                    if (!tried[k]) { idx = k; break; }
+        int idx = -1;
+        if (race) {
+            ARGUS_LOG_INFO("Connecting to %s backend, racing %s (user=%s, db=%s, auth=%s) [attempt %d/%d]",
+                           backend_name, host_csv, user, db, auth, attempt, max_attempts);
+            rc = connect_race_run(dbc, backend, host_csv, hnames, hports,
+                                  health, nhosts, &idx, &dbc->backend_conn);
+        } else {
+            gboolean tried[ARGUS_MAX_HOSTS] = { FALSE };
+            for (int h = 0; h < nhosts && rc != 0; h++) {
+                idx = next_host(dbc, host_csv, health, nhosts, tried);
                 if (idx < 0) break;
-            }
-            tried[idx] = TRUE;
-
-            char hbuf[256];
-            int hport = port;
-            split_host_port(hosts[idx], hbuf, sizeof(hbuf), &hport);
-
-            ARGUS_LOG_INFO("Connecting to %s backend at %s:%d (user=%s, db=%s, auth=%s) [attempt %d/%d]",
-                           backend_name, hbuf, hport, user, db, auth, attempt, max_attempts);
-
-            rc = backend->connect(dbc, hbuf, hport, user, pass, db, auth,
-                                  &dbc->backend_conn);
-            argus_obs_hook_host_result(dbc, host_csv, idx, rc == 0);
-            if (rc == 0) {
-                g_strlcpy(chosen, hbuf, sizeof(chosen));
-                chosen_port = hport;
-                argus_telemetry_connect(dbc, true, attempt);
-            } else {
-                ARGUS_LOG_WARN("Connection failed: backend=%s, host=%s:%d, rc=%d (attempt %d/%d)",
-                               backend_name, hbuf, hport, rc, attempt, max_attempts);
+
+                const char *hbuf = hnames[idx];
+                int hport = hports[idx];
+
+                ARGUS_LOG_INFO("Connecting to %s backend at %s:%d (user=%s, db=%s, auth=%s) [attempt %d/%d]",
+                               backend_name, hbuf, hport, user, db, auth, attempt, max_attempts);
+
+                /* The backend's connect includes authentication */
+                argus_span_t *attempt_span = argus_trace_child(
+                    dbc->tracer, span ? &span->ctx : NULL, "backend.connect");
+                argus_trace_attr_str(attempt_span, "server.address", hbuf);
+                argus_trace_attr_int(attempt_span, "server.port", hport);
+                argus_trace_attr_str(attempt_span, "argus.auth", auth);
+                argus_trace_attr_int(attempt_span, "argus.attempt", attempt);
+                argus_span_t *prev_span = argus_trace_enter(attempt_span);
+                gint64 attempt_start = g_get_monotonic_time();
+                rc = backend->connect(dbc, hbuf, hport, user, pass, db, auth,
+                                      &dbc->backend_conn);
+                argus_trace_leave(prev_span);
+                argus_trace_end(attempt_span, rc == 0 ? NULL : "08001");
+                argus_host_health_record(
+                    hbuf, hport, rc == 0,
+                    (double)(g_get_monotonic_time() - attempt_start) / 1000.0,
+                    dbc->host_cooldown_sec);
+                argus_obs_hook_host_result(dbc, host_csv, idx, rc == 0);
+                if (rc != 0) {
+                    ARGUS_LOG_WARN("Connection failed: backend=%s, host=%s:%d, rc=%d (attempt %d/%d)",
+                                   backend_name, hbuf, hport, rc, attempt, max_attempts);
+                }
             }
         }
+        if (rc == 0) {
+            g_strlcpy(chosen, hnames[idx], sizeof(chosen));
+            chosen_port = hports[idx];
+            argus_telemetry_connect(dbc, true, attempt);
+        }
     }
-    g_strfreev(hosts);
 
     if (rc == 0) {
         /* Success */
@@ -264,12 +537,15 @@ static SQLRETURN do_connect(argus_dbc_t *dbc)
         dbc->connect_time_ms = (double)(connect_end - connect_start) / 1000.0;
         ARGUS_LOG_INFO("Connected successfully to %s backend at %s:%d (%.1f ms)",
                        backend_name, chosen, chosen_port, dbc->connect_time_ms);
+        argus_trace_attr_str(span, "server.address", chosen);
+        argus_trace_attr_int(span, "server.port", chosen_port);
         dbc->connected = true;
         free(dbc->connected_host);
         dbc->connected_host = strdup(chosen);
         dbc->connected_port = chosen_port;
         argus_obs_hook_connect(dbc, dbc->obs_connstr, backend_name, chosen,
                                user, 1, dbc->connect_time_ms);
+        pool_keep_warm(dbc, chosen, chosen_port, backend_name, user);
         return SQL_SUCCESS;
     }
 
@@ -287,6 +563,113 @@ static SQLRETURN do_connect(argus_dbc_t *dbc)
     return SQL_ERROR;
 }
 
+/* Connect under a "connect" span. The tracer is (re)opened here, so a
+ * reconnect picks up changed TRACEFILE / TRACESAMPLE settings. */
+static SQLRETURN do_connect(argus_dbc_t *dbc)
+{
+    argus_tracer_close(dbc->tracer);
+    dbc->tracer = argus_tracer_open(dbc->trace_file, dbc->trace_sample);
+
+    argus_span_t *span = argus_trace_root(dbc->tracer, "connect");
+    SQLRETURN ret = connect_backend(dbc, span);
+    argus_trace_end(span, SQL_SUCCEEDED(ret) ? NULL
+                                             : argus_diag_sqlstate(&dbc->diag));
+    return ret;
+}
+
+/* ── Internal: connection-level async ──────────────────────── */
+
+/*
+ * With SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE on, SQLConnect, SQLDriverConnect
+ * and SQLDisconnect run their work on the shared executor: the first call
+ * starts it and returns SQL_STILL_EXECUTING, and so do the application's
+ * re-calls until it has completed; the call after that returns its result.
+ * While it runs, the calling side only reads dbc->async_dbc.
+ */
+typedef SQLRETURN (*dbc_async_fn)(argus_dbc_t *dbc);
+
+typedef struct dbc_async_job {
+    argus_dbc_t  *dbc;
+    dbc_async_fn  fn;
+} dbc_async_job_t;
+
+static void dbc_async_run(void *data)
+{
+    dbc_async_job_t *job = (dbc_async_job_t *)data;
+    argus_dbc_t *dbc = job->dbc;
+    SQLRETURN ret = job->fn(dbc);
+    free(job);
+    argus_async_complete(&dbc->async_dbc, ret);
+}
+
+static SQLRETURN dbc_async_start(argus_dbc_t *dbc, dbc_async_fn fn)
+{
+    dbc_async_job_t *job = malloc(sizeof(*job));
+    if (!job)
+        return argus_set_error(&dbc->diag, "HY001",
+                               "[Argus] Memory allocation failed", 0);
+    job->dbc = dbc;
+    job->fn = fn;
+    argus_async_begin(&dbc->async_dbc);
+    if (!argus_executor_submit(dbc_async_run, job)) {
+        argus_async_abandon(&dbc->async_dbc);
+        free(job);
+        return argus_set_error(&dbc->diag, "HY000",
+                               "[Argus] Cannot start the asynchronous call", 0);
+    }
+    dbc->async_dbc_busy = true;
+    return SQL_STILL_EXECUTING;
+}
+
+/* A re-call while a call is in flight: false while it still runs */
+static bool dbc_async_done(argus_dbc_t *dbc, SQLRETURN *ret)
+{
+    if (!argus_async_poll(&dbc->async_dbc, ret)) return false;
+    dbc->async_dbc_busy = false;
+    return true;
+}
+
+/* ── Internal: output connection string ──────────────────────── */
+
+/* The connection string handed back by SQLDriverConnect, password masked */
+static void write_out_connstr(const char *conn_str,
+                              SQLCHAR *OutConnectionString,
+                              SQLSMALLINT BufferLength,
+                              SQLSMALLINT *StringLength2Ptr)
+{
+    if (OutConnectionString && BufferLength > 0) {
+        /* Mask PWD= value in connection string for security */
+        char *masked = strdup(conn_str);
+        if (masked) {
+            char *p = masked;
+            while (*p) {
+                if ((p == masked || *(p - 1) == ';') &&
+                    (strncasecmp(p, "PWD=", 4) == 0 ||
+                     strncasecmp(p, "PASSWORD=", 9) == 0)) {
+                    char *val = strchr(p, '=');
+                    if (val) {
+                        val++;
+                        char *val_end = strchr(val, ';');
+                        if (!val_end) val_end = val + strlen(val);
+                        for (char *c = val; c < val_end; c++)
+                            *c = '*';
+                        p = val_end;
+                        continue;
+                    }
+                }
+                p++;
+            }
+            SQLSMALLINT out_len = argus_copy_string(masked,
+                                                     OutConnectionString,
+                                                     BufferLength);
+            if (StringLength2Ptr) *StringLength2Ptr = out_len;
+            free(masked);
+        }
+    } else if (StringLength2Ptr) {
+        *StringLength2Ptr = (SQLSMALLINT)strlen(conn_str);
+    }
+}
+
 /* ── ODBC API: SQLDriverConnect ──────────────────────────────── */
 
 SQLRETURN SQL_API SQLDriverConnect(
@@ -304,6 +687,20 @@ SQLRETURN SQL_API SQLDriverConnect(
     argus_dbc_t *dbc = (argus_dbc_t *)ConnectionHandle;
     if (!argus_valid_dbc(dbc)) return SQL_INVALID_HANDLE;
 
+    /* Asynchronous connect in flight: report how it is doing */
+    if (dbc->async_dbc_busy) {
+        SQLRETURN ret;
+        if (!dbc_async_done(dbc, &ret)) return SQL_STILL_EXECUTING;
+        char *conn_str = argus_str_dup_short(InConnectionString,
+                                             StringLength1);
+        if (conn_str) {
+            write_out_connstr(conn_str, OutConnectionString, BufferLength,
+                              StringLength2Ptr);
+            free(conn_str);
+        }
+        return ret;
+    }
+
     argus_diag_clear(&dbc->diag);
 
     if (dbc->connected) {
@@ -415,6 +812,19 @@ SQLRETURN SQL_API SQLDriverConnect(
     v = argus_conn_params_get(&params, "LOGFILE");
     if (v) { free(dbc->log_file); dbc->log_file = strdup(v); }
 
+    v = argus_conn_params_get(&params, "LOGFORMAT");
+    if (v) dbc->log_format = argus_log_format_from_string(v);
+
+    /* Span tracing (see argus/trace.h) */
+    v = argus_conn_params_get(&params, "TRACEFILE");
+    if (v) {
+        free(dbc->trace_file);
+        dbc->trace_file = *v ? strdup(v) : NULL;
+    }
+
+    v = argus_conn_params_get(&params, "TRACESAMPLE");
+    if (v) dbc->trace_sample = g_ascii_strtod(v, NULL);
+
     /* Anonymous usage telemetry — opt-in, off by default (see telemetry.h) */
     v = argus_conn_params_get(&params, "TELEMETRY");
     if (!v) v = argus_conn_params_get(&params, "ENABLETELEMETRY");
@@ -439,9 +849,55 @@ SQLRETURN SQL_API SQLDriverConnect(
     v = argus_conn_params_get(&params, "FETCHBUFFERSIZE");
     if (v) dbc->fetch_buffer_size = atoi(v);
 
+    /* Adaptive batch sizing around FETCHBUFFERSIZE (see fetch.c) */
+    v = argus_conn_params_get(&params, "ADAPTIVEFETCH");
+    if (v) {
+        dbc->adaptive_fetch = (strcmp(v, "1") == 0 ||
+                               strcasecmp(v, "true") == 0 ||
+                               strcasecmp(v, "yes") == 0);
+    }
+
+    v = argus_conn_params_get(&params, "FETCHTARGETBYTES");
+    if (v) dbc->fetch_target_bytes = (size_t)strtoull(v, NULL, 10);
+
+    v = argus_conn_params_get(&params, "FETCHTARGETMS");
+    if (v) dbc->fetch_target_ms = atoi(v);
+
+    v = argus_conn_params_get(&params, "FETCHMINROWS");
+    if (v) dbc->fetch_min_rows = atoi(v);
+
+    v = argus_conn_params_get(&params, "FETCHMAXROWS");
+    if (v) dbc->fetch_max_rows = atoi(v);
+
+    v = argus_conn_params_get(&params, "BULKINSERTROWS");
+    if (v) dbc->bulk_insert_rows = atoi(v);
+
+    v = argus_conn_params_get(&params, "BULKINSERTBYTES");
+    if (v) dbc->bulk_insert_bytes = (size_t)strtoull(v, NULL, 10);
+
+    v = argus_conn_params_get(&params, "BULKLOAD");
+    if (v) {
+        dbc->bulk_load = (strcmp(v, "1") == 0 ||
+                          strcasecmp(v, "true") == 0 ||
+                          strcasecmp(v, "yes") == 0);
+    }
+
     v = argus_conn_params_get(&params, "MAXSCROLLROWS");
     if (v) dbc->max_scroll_rows = atol(v);
 
+    v = argus_conn_params_get(&params, "MAXSCROLLBYTES");
+    if (v) dbc->max_scroll_bytes = (uint64_t)strtoull(v, NULL, 10);
+
+    v = argus_conn_params_get(&params, "SCROLLMEMORY");
+    if (v) dbc->scroll_memory_bytes = (size_t)strtoull(v, NULL, 10);
+
+    v = argus_conn_params_get(&params, "SCROLLCOMPRESS");
+    if (v) {
+        dbc->scroll_compress = (strcmp(v, "1") == 0 ||
+                                strcasecmp(v, "true") == 0 ||
+                                strcasecmp(v, "yes") == 0);
+    }
+
     v = argus_conn_params_get(&params, "SOCKETTIMEOUT");
     if (v) dbc->socket_timeout_sec = atoi(v);
 
@@ -457,9 +913,131 @@ SQLRETURN SQL_API SQLDriverConnect(
     v = argus_conn_params_get(&params, "RETRYDELAY");
     if (v) dbc->retry_delay_sec = atoi(v);
 
+    v = argus_conn_params_get(&params, "CONNECTRACEDELAY");
+    if (v) dbc->connect_race_delay_ms = atoi(v);
+
+    v = argus_conn_params_get(&params, "HOSTCOOLDOWN");
+    if (v) dbc->host_cooldown_sec = atoi(v);
+
     v = argus_conn_params_get(&params, "HTTPPATH");
     if (v) { free(dbc->http_path); dbc->http_path = strdup(v); }
 
+    v = argus_conn_params_get(&params, "HTTPCOMPRESSION");
+    if (v) {
+        dbc->http_compression = (strcmp(v, "1") == 0 ||
+                                 strcasecmp(v, "true") == 0 ||
+                                 strcasecmp(v, "yes") == 0);
+    }
+
+    v = argus_conn_params_get(&params, "HTTP2");
+    if (!v) v = argus_conn_params_get(&params, "USEHTTP2");
+    if (v) {
+        dbc->http2 = (strcmp(v, "1") == 0 ||
+                      strcasecmp(v, "true") == 0 ||
+                      strcasecmp(v, "yes") == 0);
+    }
+
+    /* Spark / Databricks result formats (Hive backend) */
+    v = argus_conn_params_get(&params, "ARROWRESULTS");
+    if (!v) v = argus_conn_params_get(&params, "ENABLEARROW");
+    if (v) {
+        dbc->arrow_results = (strcmp(v, "1") == 0 ||
+                              strcasecmp(v, "true") == 0 ||
+                              strcasecmp(v, "yes") == 0);
+    }
+
+    v = argus_conn_params_get(&params, "CLOUDFETCH");
+    if (!v) v = argus_conn_params_get(&params, "ENABLECLOUDFETCH");
+    if (v) {
+        dbc->cloud_fetch = (strcmp(v, "1") == 0 ||
+                            strcasecmp(v, "true") == 0 ||
+                            strcasecmp(v, "yes") == 0);
+    }
+
+    /* Hive/Impala: keep one FetchResults in flight ahead of the application */
+    v = argus_conn_params_get(&params, "PREFETCH");
+    if (!v) v = argus_conn_params_get(&params, "ASYNCFETCH");
+    if (v) {
+        dbc->prefetch = (strcmp(v, "1") == 0 ||
+                         strcasecmp(v, "true") == 0 ||
+                         strcasecmp(v, "yes") == 0);
+    }
+
+    /* Client-side result cache for repeated SELECTs (off by default) */
+    v = argus_conn_params_get(&params, "RESULTCACHE");
+    if (!v) v = argus_conn_params_get(&params, "ENABLERESULTCACHE");
+    if (v) {
+        dbc->result_cache = (strcmp(v, "1") == 0 ||
+                             strcasecmp(v, "true") == 0 ||
+                             strcasecmp(v, "yes") == 0);
+    }
+
+    v = argus_conn_params_get(&params, "RESULTCACHETTL");
+    if (v) dbc->result_cache_ttl_sec = atoi(v);
+
+    v = argus_conn_params_get(&params, "RESULTCACHEMAXBYTES");
+    if (v) dbc->result_cache_max_bytes = (size_t)strtoull(v, NULL, 10);
+
+    v = argus_conn_params_get(&params, "SQLCACHEMAXBYTES");
+    if (v) dbc->sql_cache_max_bytes = (size_t)strtoull(v, NULL, 10);
+
+    v = argus_conn_params_get(&params, "RESULTCACHEPATTERN");
+    if (v) {
+        free(dbc->result_cache_pattern);
+        dbc->result_cache_pattern = strdup(v);
+    }
+
+    /* Metadata cache (SQLTables/SQLColumns), shared process-wide */
+    v = argus_conn_params_get(&params, "METADATACACHETTL");
+    if (v) dbc->metadata_cache_ttl_sec = atoi(v);
+
+    v = argus_conn_params_get(&params, "TABLESCACHETTL");
+    if (v) dbc->tables_cache_ttl_sec = atoi(v);
+
+    v = argus_conn_params_get(&params, "COLUMNSCACHETTL");
+    if (v) dbc->columns_cache_ttl_sec = atoi(v);
+
+    v = argus_conn_params_get(&params, "METADATACACHESTALE");
+    if (v) dbc->metadata_cache_stale_sec = atoi(v);
+
+    v = argus_conn_params_get(&params, "METADATACACHEFILE");
+    if (v) {
+        free(dbc->metadata_cache_file);
+        dbc->metadata_cache_file = strdup(v);
+    }
+
+    v = argus_conn_params_get(&params, "CATALOGSNAPSHOT");
+    if (v) {
+        dbc->catalog_snapshot = (strcmp(v, "1") == 0 ||
+                                 strcasecmp(v, "true") == 0 ||
+                                 strcasecmp(v, "yes") == 0);
+    }
+
+    /* Record-and-replay (src/backend/replay) */
+    v = argus_conn_params_get(&params, "CAPTUREFILE");
+    if (v) {
+        free(dbc->capture_file);
+        dbc->capture_file = *v ? strdup(v) : NULL;
+    }
+
+    v = argus_conn_params_get(&params, "REPLAYFILE");
+    if (v) {
+        free(dbc->replay_file);
+        dbc->replay_file = strdup(v);
+    }
+
+    v = argus_conn_params_get(&params, "REPLAYLATENCY");
+    if (v) dbc->replay_latency_ms = atoi(v);
+
+    v = argus_conn_params_get(&params, "REPLAYBANDWIDTH");
+    if (v) dbc->replay_bandwidth_kib = atol(v);
+
+    v = argus_conn_params_get(&params, "SYNTHETICSPEC");
+    if (v) {
+        free(dbc->synthetic_spec);
+        dbc->synthetic_spec = strdup(v);
+    }
+
     /* OAuth2 client-credentials (M2M) parameters (Trino) */
     v = argus_conn_params_get(&params, "OAUTH2TOKENENDPOINT");
     if (!v) v = argus_conn_params_get(&params, "TOKENURI");
@@ -547,14 +1125,35 @@ SQLRETURN SQL_API SQLDriverConnect(
         if (v) pool_it = atoi(v);
         v = argus_conn_params_get(&params, "POOLTTL");
         if (v) pool_ttl = atoi(v);
+        v = argus_conn_params_get(&params, "POOLMINIDLE");
+        if (v) dbc->pool_min_idle = atoi(v);
         if (pool_mpk > 0 || pool_mt > 0 || pool_it >= 0 || pool_ttl >= 0)
             argus_pool_configure(pool_mpk, pool_mt, pool_it, pool_ttl);
     }
 
+    /* The asynchronous-execution pool is process-wide too */
+    v = argus_conn_params_get(&params, "ASYNCTHREADS");
+    if (v && atoi(v) > 0)
+        argus_executor_configure(atoi(v));
+
+    /* The result cache budget is process-wide; the last connection that
+     * enables the cache sets it. */
+    if (dbc->result_cache)
+        argus_result_cache_configure(dbc->result_cache_max_bytes);
+    /* So is the SQL preprocessing cache's; a connection that leaves it at
+     * the default does not undo another's setting. */
+    if (dbc->sql_cache_max_bytes != ARGUS_DEFAULT_SQL_CACHE_BYTES)
+        argus_sql_cache_configure(dbc->sql_cache_max_bytes);
+    if (dbc->metadata_cache_file && dbc->metadata_cache_ttl_sec > 0)
+        argus_metadata_cache_set_file(dbc->metadata_cache_file);
+
     /* Apply logging settings if specified */
     if (dbc->log_level >= 0) {
         argus_log_set_level(dbc->log_level);
     }
+    if (dbc->log_format >= 0) {
+        argus_log_set_format(dbc->log_format);
+    }
     if (dbc->log_file) {
         argus_log_set_file(dbc->log_file);
     }
@@ -574,40 +1173,13 @@ SQLRETURN SQL_API SQLDriverConnect(
     }
 
     /* Connect */
-    SQLRETURN ret = do_connect(dbc);
-
-    /* Build output connection string with password masked */
-    if (OutConnectionString && BufferLength > 0) {
-        /* Mask PWD= value in connection string for security */
-        char *masked = strdup(conn_str);
-        if (masked) {
-            char *p = masked;
-            while (*p) {
-                if ((p == masked || *(p - 1) == ';') &&
-                    (strncasecmp(p, "PWD=", 4) == 0 ||
-                     strncasecmp(p, "PASSWORD=", 9) == 0)) {
-                    char *val = strchr(p, '=');
-                    if (val) {
-                        val++;
-                        char *val_end = strchr(val, ';');
-                        if (!val_end) val_end = val + strlen(val);
-                        for (char *c = val; c < val_end; c++)
-                            *c = '*';
-                        p = val_end;
-                        continue;
-                    }
-                }
-                p++;
-            }
-            SQLSMALLINT out_len = argus_copy_string(masked,
-                                                     OutConnectionString,
-                                                     BufferLength);
-            if (StringLength2Ptr) *StringLength2Ptr = out_len;
-            free(masked);
-        }
-    } else if (StringLength2Ptr) {
-        *StringLength2Ptr = (SQLSMALLINT)strlen(conn_str);
+    if (dbc->async_dbc_enabled) {
+        free(conn_str);
+        return dbc_async_start(dbc, do_connect);
     }
+    SQLRETURN ret = do_connect(dbc);
+    write_out_connstr(conn_str, OutConnectionString, BufferLength,
+                      StringLength2Ptr);
 
     free(conn_str);
     return ret;
@@ -624,6 +1196,12 @@ SQLRETURN SQL_API SQLConnect(
     argus_dbc_t *dbc = (argus_dbc_t *)ConnectionHandle;
     if (!argus_valid_dbc(dbc)) return SQL_INVALID_HANDLE;
 
+    /* Asynchronous connect in flight: report how it is doing */
+    if (dbc->async_dbc_busy) {
+        SQLRETURN ret;
+        return dbc_async_done(dbc, &ret) ? ret : SQL_STILL_EXECUTING;
+    }
+
     argus_diag_clear(&dbc->diag);
 
     if (dbc->connected) {
@@ -649,32 +1227,26 @@ SQLRETURN SQL_API SQLConnect(
     char *pass = argus_str_dup_short(Authentication, NameLength3);
     if (pass) { free(dbc->password); dbc->password = pass; }
 
+    if (dbc->async_dbc_enabled)
+        return dbc_async_start(dbc, do_connect);
     return do_connect(dbc);
 }
 
 /* ── ODBC API: SQLDisconnect ─────────────────────────────────── */
 
-SQLRETURN SQL_API SQLDisconnect(SQLHDBC ConnectionHandle)
+/* Close the backend connection, or hand it back to the pool */
+static SQLRETURN do_disconnect(argus_dbc_t *dbc)
 {
-    argus_dbc_t *dbc = (argus_dbc_t *)ConnectionHandle;
-    if (!argus_valid_dbc(dbc)) return SQL_INVALID_HANDLE;
-
-    argus_diag_clear(&dbc->diag);
-
-    if (!dbc->connected) {
-        return argus_set_error(&dbc->diag, "08003",
-                               "[Argus] Not connected", 0);
-    }
-
     ARGUS_LOG_INFO("Disconnecting from %s backend",
                    dbc->backend ? dbc->backend->name : "unknown");
 
     argus_obs_hook_disconnect(dbc);
     argus_telemetry_session_end(dbc);
+    argus_tracer_flush(dbc->tracer);
 
     if (dbc->backend && dbc->backend_conn) {
         /* Return to pool if pooling is enabled */
-        if (dbc->env && dbc->env->connection_pooling != SQL_CP_OFF) {
+        if (pooling_enabled(dbc)) {
             /* Release under the key the connection was acquired with: HOST
              * may be a failover list, so use the concrete connected host. */
             const char *host = dbc->connected_host ? dbc->connected_host
@@ -699,6 +1271,29 @@ SQLRETURN SQL_API SQLDisconnect(SQLHDBC ConnectionHandle)
     return SQL_SUCCESS;
 }
 
+SQLRETURN SQL_API SQLDisconnect(SQLHDBC ConnectionHandle)
+{
+    argus_dbc_t *dbc = (argus_dbc_t *)ConnectionHandle;
+    if (!argus_valid_dbc(dbc)) return SQL_INVALID_HANDLE;
+
+    /* Asynchronous disconnect in flight: report how it is doing */
+    if (dbc->async_dbc_busy) {
+        SQLRETURN ret;
+        return dbc_async_done(dbc, &ret) ? ret : SQL_STILL_EXECUTING;
+    }
+
+    argus_diag_clear(&dbc->diag);
+
+    if (!dbc->connected) {
+        return argus_set_error(&dbc->diag, "08003",
+                               "[Argus] Not connected", 0);
+    }
+
+    if (dbc->async_dbc_enabled)
+        return dbc_async_start(dbc, do_disconnect);
+    return do_disconnect(dbc);
+}
+
 /* ── Internal: merge connection string keywords into dbc->browse_buf ── */
 
 static void browse_merge(argus_dbc_t *dbc, const char *in_str)
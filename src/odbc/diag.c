@@ -14,6 +14,12 @@ void argus_diag_clear(argus_diag_t *diag)
     diag->return_code = SQL_SUCCESS;
 }
 
+const char *argus_diag_sqlstate(const argus_diag_t *diag)
+{
+    return diag->count > 0 ? (const char *)diag->records[0].sqlstate
+                           : "HY000";
+}
+
 void argus_diag_push(argus_diag_t *diag,
                      const char *sqlstate,
                      const char *message,
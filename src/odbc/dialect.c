@@ -461,22 +461,25 @@ static const argus_fn_entry_t ansi_fns[] = {
  * DATE '...' yet rejects CURRENT_DATE, so an engine's SQL-92 coverage is not
  * all-or-nothing and cannot be inferred from its lineage. */
 static const argus_dialect_t argus_dialects[] = {
-    { "trino",    "\"", ARGUS_LIT_ANSI, true,  trino_fns },
-    { "hive",     "`",  ARGUS_LIT_ANSI, true,  hive_fns },
+    { "trino",    "\"", ARGUS_LIT_ANSI, true,  trino_fns,    NULL, 0 },
+    { "hive",     "`",  ARGUS_LIT_ANSI, true,  hive_fns,     NULL, 0 },
     /* Impala rejects the ANSI TIMESTAMP '…' literal (ParseException) but accepts
      * CAST('…' AS TIMESTAMP), and CAST works for DATE too — verified live. */
-    { "impala",   "`",  ARGUS_LIT_CAST, true,  impala_fns },
-    { "mysql",    "`",  ARGUS_LIT_ANSI, true,  mywire_fns },
-    { "bigquery", "`",  ARGUS_LIT_ANSI, true,  bigquery_fns },
-    { "phoenix",  "\"", ARGUS_LIT_ANSI, false, ansi_fns },
-    { "pinot",    "\"", ARGUS_LIT_ANSI, false, pinot_fns },
-    { "druid",    "\"", ARGUS_LIT_ANSI, false, ansi_fns },
-    { "flightsql","\"", ARGUS_LIT_ANSI, false, ansi_fns },
-    { "kudu",     "\"", ARGUS_LIT_ANSI, false, ansi_fns },
+    { "impala",   "`",  ARGUS_LIT_CAST, true,  impala_fns,   NULL, 0 },
+    { "mysql",    "`",  ARGUS_LIT_ANSI, true,  mywire_fns,   NULL, 0 },
+    { "bigquery", "`",  ARGUS_LIT_ANSI, true,  bigquery_fns, NULL, 0 },
+    /* Phoenix writes with UPSERT, and its VALUES takes a single row */
+    { "phoenix",  "\"", ARGUS_LIT_ANSI, false, ansi_fns,     "UPSERT INTO", 1 },
+    /* Pinot and Druid ingest through their own pipelines, and Kudu here is
+     * read-only: none of them takes INSERT ... VALUES */
+    { "pinot",    "\"", ARGUS_LIT_ANSI, false, pinot_fns,    NULL, -1 },
+    { "druid",    "\"", ARGUS_LIT_ANSI, false, ansi_fns,     NULL, -1 },
+    { "flightsql","\"", ARGUS_LIT_ANSI, false, ansi_fns,     NULL, 0 },
+    { "kudu",     "\"", ARGUS_LIT_ANSI, false, ansi_fns,     NULL, -1 },
 };
 
 static const argus_dialect_t argus_ansi_dialect = {
-    "ansi", "\"", ARGUS_LIT_ANSI, false, ansi_fns
+    "ansi", "\"", ARGUS_LIT_ANSI, false, ansi_fns, NULL, 0
 };
 
 #define ARGUS_DIALECT_COUNT (sizeof(argus_dialects) / sizeof(argus_dialects[0]))
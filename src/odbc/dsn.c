@@ -81,24 +81,131 @@ static void apply_dsn_param(argus_dbc_t *dbc, const char *key, const char *val)
         dbc->retry_count = atoi(val);
     } else if (strcasecmp(key, "RETRYDELAY") == 0) {
         dbc->retry_delay_sec = atoi(val);
+    } else if (strcasecmp(key, "CONNECTRACEDELAY") == 0) {
+        dbc->connect_race_delay_ms = atoi(val);
+    } else if (strcasecmp(key, "HOSTCOOLDOWN") == 0) {
+        dbc->host_cooldown_sec = atoi(val);
+    } else if (strcasecmp(key, "POOLMINIDLE") == 0) {
+        dbc->pool_min_idle = atoi(val);
     } else if (strcasecmp(key, "CONNECTTIMEOUT") == 0) {
         dbc->connect_timeout_sec = atoi(val);
     } else if (strcasecmp(key, "QUERYTIMEOUT") == 0) {
         dbc->query_timeout_sec = atoi(val);
     } else if (strcasecmp(key, "FETCHBUFFERSIZE") == 0) {
         dbc->fetch_buffer_size = atoi(val);
+    } else if (strcasecmp(key, "ADAPTIVEFETCH") == 0) {
+        dbc->adaptive_fetch = (strcmp(val, "1") == 0 ||
+                               strcasecmp(val, "true") == 0 ||
+                               strcasecmp(val, "yes") == 0);
+    } else if (strcasecmp(key, "FETCHTARGETBYTES") == 0) {
+        dbc->fetch_target_bytes = (size_t)strtoull(val, NULL, 10);
+    } else if (strcasecmp(key, "FETCHTARGETMS") == 0) {
+        dbc->fetch_target_ms = atoi(val);
+    } else if (strcasecmp(key, "FETCHMINROWS") == 0) {
+        dbc->fetch_min_rows = atoi(val);
+    } else if (strcasecmp(key, "FETCHMAXROWS") == 0) {
+        dbc->fetch_max_rows = atoi(val);
+    } else if (strcasecmp(key, "BULKINSERTROWS") == 0) {
+        dbc->bulk_insert_rows = atoi(val);
+    } else if (strcasecmp(key, "BULKINSERTBYTES") == 0) {
+        dbc->bulk_insert_bytes = (size_t)strtoull(val, NULL, 10);
+    } else if (strcasecmp(key, "BULKLOAD") == 0) {
+        dbc->bulk_load = (strcmp(val, "1") == 0 ||
+                          strcasecmp(val, "true") == 0 ||
+                          strcasecmp(val, "yes") == 0);
     } else if (strcasecmp(key, "MAXSCROLLROWS") == 0) {
         dbc->max_scroll_rows = atol(val);
+    } else if (strcasecmp(key, "MAXSCROLLBYTES") == 0) {
+        dbc->max_scroll_bytes = (uint64_t)strtoull(val, NULL, 10);
+    } else if (strcasecmp(key, "SCROLLMEMORY") == 0) {
+        dbc->scroll_memory_bytes = (size_t)strtoull(val, NULL, 10);
+    } else if (strcasecmp(key, "SCROLLCOMPRESS") == 0) {
+        dbc->scroll_compress = (strcmp(val, "1") == 0 ||
+                                strcasecmp(val, "true") == 0 ||
+                                strcasecmp(val, "yes") == 0);
     } else if (strcasecmp(key, "LOGLEVEL") == 0) {
         dbc->log_level = atoi(val);
     } else if (strcasecmp(key, "LOGFILE") == 0) {
         free(dbc->log_file);
         dbc->log_file = strdup(val);
+    } else if (strcasecmp(key, "LOGFORMAT") == 0) {
+        dbc->log_format = argus_log_format_from_string(val);
+    } else if (strcasecmp(key, "TRACEFILE") == 0) {
+        free(dbc->trace_file);
+        dbc->trace_file = *val ? strdup(val) : NULL;
+    } else if (strcasecmp(key, "TRACESAMPLE") == 0) {
+        dbc->trace_sample = g_ascii_strtod(val, NULL);
     } else if (strcasecmp(key, "TELEMETRY") == 0 ||
                strcasecmp(key, "ENABLETELEMETRY") == 0) {
         dbc->telemetry_enabled = (strcmp(val, "1") == 0 ||
                                   strcasecmp(val, "true") == 0 ||
                                   strcasecmp(val, "yes") == 0);
+    } else if (strcasecmp(key, "ARROWRESULTS") == 0 ||
+               strcasecmp(key, "ENABLEARROW") == 0) {
+        dbc->arrow_results = (strcmp(val, "1") == 0 ||
+                              strcasecmp(val, "true") == 0 ||
+                              strcasecmp(val, "yes") == 0);
+    } else if (strcasecmp(key, "CLOUDFETCH") == 0 ||
+               strcasecmp(key, "ENABLECLOUDFETCH") == 0) {
+        dbc->cloud_fetch = (strcmp(val, "1") == 0 ||
+                            strcasecmp(val, "true") == 0 ||
+                            strcasecmp(val, "yes") == 0);
+    } else if (strcasecmp(key, "HTTPCOMPRESSION") == 0) {
+        dbc->http_compression = (strcmp(val, "1") == 0 ||
+                                 strcasecmp(val, "true") == 0 ||
+                                 strcasecmp(val, "yes") == 0);
+    } else if (strcasecmp(key, "HTTP2") == 0 ||
+               strcasecmp(key, "USEHTTP2") == 0) {
+        dbc->http2 = (strcmp(val, "1") == 0 ||
+                      strcasecmp(val, "true") == 0 ||
+                      strcasecmp(val, "yes") == 0);
+    } else if (strcasecmp(key, "PREFETCH") == 0 ||
+               strcasecmp(key, "ASYNCFETCH") == 0) {
+        dbc->prefetch = (strcmp(val, "1") == 0 ||
+                         strcasecmp(val, "true") == 0 ||
+                         strcasecmp(val, "yes") == 0);
+    } else if (strcasecmp(key, "RESULTCACHE") == 0 ||
+               strcasecmp(key, "ENABLERESULTCACHE") == 0) {
+        dbc->result_cache = (strcmp(val, "1") == 0 ||
+                             strcasecmp(val, "true") == 0 ||
+                             strcasecmp(val, "yes") == 0);
+    } else if (strcasecmp(key, "RESULTCACHETTL") == 0) {
+        dbc->result_cache_ttl_sec = atoi(val);
+    } else if (strcasecmp(key, "RESULTCACHEMAXBYTES") == 0) {
+        dbc->result_cache_max_bytes = (size_t)strtoull(val, NULL, 10);
+    } else if (strcasecmp(key, "SQLCACHEMAXBYTES") == 0) {
+        dbc->sql_cache_max_bytes = (size_t)strtoull(val, NULL, 10);
+    } else if (strcasecmp(key, "RESULTCACHEPATTERN") == 0) {
+        free(dbc->result_cache_pattern);
+        dbc->result_cache_pattern = strdup(val);
+    } else if (strcasecmp(key, "METADATACACHETTL") == 0) {
+        dbc->metadata_cache_ttl_sec = atoi(val);
+    } else if (strcasecmp(key, "TABLESCACHETTL") == 0) {
+        dbc->tables_cache_ttl_sec = atoi(val);
+    } else if (strcasecmp(key, "COLUMNSCACHETTL") == 0) {
+        dbc->columns_cache_ttl_sec = atoi(val);
+    } else if (strcasecmp(key, "METADATACACHESTALE") == 0) {
+        dbc->metadata_cache_stale_sec = atoi(val);
+    } else if (strcasecmp(key, "METADATACACHEFILE") == 0) {
+        free(dbc->metadata_cache_file);
+        dbc->metadata_cache_file = strdup(val);
+    } else if (strcasecmp(key, "CATALOGSNAPSHOT") == 0) {
+        dbc->catalog_snapshot = (strcmp(val, "1") == 0 ||
+                                 strcasecmp(val, "true") == 0 ||
+                                 strcasecmp(val, "yes") == 0);
+    } else if (strcasecmp(key, "CAPTUREFILE") == 0) {
+        free(dbc->capture_file);
+        dbc->capture_file = *val ? strdup(val) : NULL;
+    } else if (strcasecmp(key, "REPLAYFILE") == 0) {
+        free(dbc->replay_file);
+        dbc->replay_file = strdup(val);
+    } else if (strcasecmp(key, "REPLAYLATENCY") == 0) {
+        dbc->replay_latency_ms = atoi(val);
+    } else if (strcasecmp(key, "REPLAYBANDWIDTH") == 0) {
+        dbc->replay_bandwidth_kib = atol(val);
+    } else if (strcasecmp(key, "SYNTHETICSPEC") == 0) {
+        free(dbc->synthetic_spec);
+        dbc->synthetic_spec = strdup(val);
     } else if (strcasecmp(key, "LICENSE") == 0 ||
                strcasecmp(key, "LICENSEKEY") == 0) {
         argus_secure_free(dbc->license);
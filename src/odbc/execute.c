@@ -72,7 +72,7 @@ static char *sql_escape_string(const char *value, size_t len)
 
 /* ── Internal: render a bound parameter as a SQL literal ──────── */
 
-static char *render_param(const argus_param_binding_t *param)
+char *argus_render_param(const argus_param_binding_t *param)
 {
     if (!param->bound) return NULL;
 
@@ -423,13 +423,15 @@ static char *render_param(const argus_param_binding_t *param)
 
 /* ── Internal: substitute ? markers with bound parameter values ── */
 
-static char *substitute_params(const char *sql,
+/* The markers were located when the statement was preprocessed, so this is
+ * one pass copying the text between them with each literal spliced in. */
+static char *substitute_params(const argus_sql_text_t *text,
                                 const argus_param_binding_t *params,
                                 int num_params,
                                 argus_diag_t *diag)
 {
-    int marker_count = count_param_markers(sql);
-    if (marker_count == 0) return strdup(sql);
+    int marker_count = text->num_markers;
+    if (marker_count == 0) return strdup(text->sql);
 
     if (marker_count > num_params) {
         argus_set_error(diag, "07002",
@@ -440,67 +442,57 @@ static char *substitute_params(const char *sql,
 
     /* Render all parameter values */
     char **rendered = calloc((size_t)marker_count, sizeof(char *));
-    if (!rendered) return NULL;
+    size_t *lens = calloc((size_t)marker_count, sizeof(size_t));
+    if (!rendered || !lens) {
+        free(rendered);
+        free(lens);
+        return NULL;
+    }
 
+    size_t out_size = text->len - (size_t)marker_count + 1;
     for (int i = 0; i < marker_count; i++) {
         if (!params[i].bound) {
             argus_set_error(diag, "07002",
                             "[Argus] Parameter not bound", 0);
             for (int j = 0; j < i; j++) free(rendered[j]);
             free(rendered);
+            free(lens);
             return NULL;
         }
-        rendered[i] = render_param(&params[i]);
+        rendered[i] = argus_render_param(&params[i]);
         if (!rendered[i]) {
             argus_set_error(diag, "HYC00",
                             "[Argus] Unsupported parameter type or "
                             "invalid parameter value", 0);
             for (int j = 0; j < i; j++) free(rendered[j]);
             free(rendered);
+            free(lens);
             return NULL;
         }
-    }
-
-    /* Calculate output size */
-    size_t out_size = strlen(sql) + 1;
-    for (int i = 0; i < marker_count; i++) {
-        out_size += strlen(rendered[i]); /* -1 for ? + rendered len */
+        lens[i] = strlen(rendered[i]);
+        out_size += lens[i];
     }
 
     char *out = malloc(out_size);
-    if (!out) {
-        for (int i = 0; i < marker_count; i++) free(rendered[i]);
-        free(rendered);
-        return NULL;
-    }
-
-    /* Build output string */
-    char *dst = out;
-    int param_idx = 0;
-    bool in_single_quote = false;
-    bool in_double_quote = false;
-
-    for (const char *p = sql; *p; p++) {
-        if (*p == '\'' && !in_double_quote) {
-            in_single_quote = !in_single_quote;
-            *dst++ = *p;
-        } else if (*p == '"' && !in_single_quote) {
-            in_double_quote = !in_double_quote;
-            *dst++ = *p;
-        } else if (*p == '?' && !in_single_quote && !in_double_quote
-                   && param_idx < marker_count) {
-            size_t rlen = strlen(rendered[param_idx]);
-            memcpy(dst, rendered[param_idx], rlen);
-            dst += rlen;
-            param_idx++;
-        } else {
-            *dst++ = *p;
+    if (out) {
+        char *dst = out;
+        size_t pos = 0;
+        for (int i = 0; i < marker_count; i++) {
+            size_t at = text->markers[i];
+            memcpy(dst, text->sql + pos, at - pos);
+            dst += at - pos;
+            memcpy(dst, rendered[i], lens[i]);
+            dst += lens[i];
+            pos = at + 1;
         }
+        memcpy(dst, text->sql + pos, text->len - pos);
+        dst += text->len - pos;
+        *dst = '\0';
     }
-    *dst = '\0';
 
     for (int i = 0; i < marker_count; i++) free(rendered[i]);
     free(rendered);
+    free(lens);
     return out;
 }
 
@@ -509,23 +501,18 @@ static char *substitute_params(const char *sql,
 static SQLRETURN async_poll(argus_stmt_t *stmt)
 {
     /*
-     * The execute runs on a background worker thread (async_worker below). A
-     * poll just checks whether it has finished: while the worker runs, only the
-     * async_done atomic is read here — never the execution fields the worker
-     * writes — so there is no data race. On completion, g_thread_join is a
-     * memory barrier that publishes all of the worker's writes to this thread.
+     * The execute runs on the shared executor (async_start below). A poll
+     * just checks whether it has completed: while it runs, only the
+     * completion is read here — never the execution fields the executor
+     * writes — so there is no data race. The completion's lock publishes
+     * all of those writes to this thread.
      */
-    if (!g_atomic_int_get(&stmt->async_done)) {
+    SQLRETURN ret;
+    if (!argus_async_poll(&stmt->async, &ret)) {
         stmt->async_state = ARGUS_ASYNC_RUNNING;
         return SQL_STILL_EXECUTING;
     }
 
-    if (stmt->async_thread) {
-        g_thread_join(stmt->async_thread);
-        stmt->async_thread = NULL;
-    }
-
-    SQLRETURN ret = stmt->async_result;
     stmt->async_state = (ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO)
                         ? ARGUS_ASYNC_DONE : ARGUS_ASYNC_ERROR;
     free(stmt->async_query);
@@ -533,17 +520,83 @@ static SQLRETURN async_poll(argus_stmt_t *stmt)
     return ret;
 }
 
+/* ── Internal: tracing ───────────────────────────────────────── */
+
+/* Open the statement's "execute" span. Its context parents the round trips
+ * below and, after the execute, the result's fetch spans. */
+static void trace_execute_begin(argus_stmt_t *stmt)
+{
+    argus_dbc_t *dbc = stmt->dbc;
+    stmt->trace_span = argus_trace_root(dbc ? dbc->tracer : NULL, "execute");
+    stmt->trace_ctx.sampled = false;
+    if (!stmt->trace_span) return;
+    stmt->trace_ctx = stmt->trace_span->ctx;
+    argus_trace_attr_str(stmt->trace_span, "db.system",
+                         dbc->backend ? dbc->backend->name : NULL);
+}
+
+static SQLRETURN trace_execute_end(argus_stmt_t *stmt, SQLRETURN ret)
+{
+    argus_span_t *span = stmt->trace_span;
+    if (!span) return ret;
+    stmt->trace_span = NULL;
+    argus_trace_attr_int(span, "argus.columns", stmt->num_cols);
+    if (stmt->row_count >= 0)
+        argus_trace_attr_int(span, "argus.row_count", stmt->row_count);
+    if (stmt->extract_path)
+        argus_trace_attr_int(span, "argus.extract_rows",
+                             (int64_t)stmt->extract_rows);
+    argus_trace_end(span, SQL_SUCCEEDED(ret)
+                          ? NULL : argus_diag_sqlstate(&stmt->diag));
+    return ret;
+}
+
+/* A span for one backend call made by the execute; NULL when untraced */
+static argus_span_t *trace_round_trip(argus_stmt_t *stmt, const char *name)
+{
+    return argus_trace_child(stmt->dbc->tracer, &stmt->trace_ctx, name);
+}
+
 /* ── Internal: execute a query on the backend ────────────────── */
 
-static SQLRETURN do_execute(argus_stmt_t *stmt, const char *query)
+/* Fail the statement with the backend's own message, or a generic one */
+static SQLRETURN backend_failed(argus_stmt_t *stmt)
 {
     argus_dbc_t *dbc = stmt->dbc;
-    if (!dbc || !dbc->connected || !dbc->backend) {
-        return argus_set_error(&stmt->diag, "08003",
-                               "[Argus] Connection not open", 0);
+    stmt->errors_total++;
+    if (dbc) dbc->errors_total++;
+    if (argus_stmt_cancelled(stmt)) {
+        /* HY008 / HYT00 is set; the backend's message would only say
+         * how the call was interrupted */
+    } else if (stmt->diag.count == 0) {
+        char errbuf[512];
+        if (dbc->backend->get_last_error &&
+            dbc->backend->get_last_error(dbc->backend_conn,
+                                         errbuf, sizeof(errbuf)) &&
+            errbuf[0]) {
+            char msg[600];
+            snprintf(msg, sizeof(msg), "[Argus] %s", errbuf);
+            argus_set_error(&stmt->diag, "HY000", msg, 0);
+        } else {
+            argus_set_error(&stmt->diag, "HY000",
+                            "[Argus] Backend execution failed", 0);
+        }
     }
+    /* Report only the SQLSTATE + native code, never the message text
+     * (which carries table/column names and query fragments). */
+    argus_telemetry_error(dbc,
+                          stmt->diag.count > 0
+                              ? (const char *)stmt->diag.records[0].sqlstate
+                              : "HY000",
+                          stmt->diag.count > 0
+                              ? (long)stmt->diag.records[0].native_error : 0);
+    return SQL_ERROR;
+}
 
-    /* Reset previous execution state */
+/* Close the statement's previous result, if any, and forget its state */
+void argus_stmt_reset_result(argus_stmt_t *stmt)
+{
+    argus_dbc_t *dbc = stmt->dbc;
     if (stmt->op) {
         dbc->backend->close_operation(dbc->backend_conn, stmt->op);
         stmt->op = NULL;
@@ -555,6 +608,43 @@ static SQLRETURN do_execute(argus_stmt_t *stmt, const char *query)
     stmt->row_count         = -1;
     stmt->rows_fetched_total = 0;
     argus_row_cache_clear(&stmt->row_cache);
+    stmt->row_cache.exhausted = false;
+    argus_result_cache_release(stmt);
+    argus_metadata_cache_release(stmt);
+}
+
+/*
+ * Reset the statement and hand `query` to the backend: its blocking
+ * execute(), or with `nonblocking` its submit(). Returns SQL_STILL_EXECUTING
+ * once the backend has the query (execute_poll and execute_finish carry on
+ * from there), SQL_SUCCESS when a cached result was replayed instead, or
+ * SQL_ERROR.
+ */
+static SQLRETURN execute_start(argus_stmt_t *stmt, const char *query,
+                               bool nonblocking)
+{
+    argus_dbc_t *dbc = stmt->dbc;
+    if (!dbc || !dbc->connected || !dbc->backend) {
+        return argus_set_error(&stmt->diag, "08003",
+                               "[Argus] Connection not open", 0);
+    }
+
+    /* Reset previous execution state, recording its timing first */
+    argus_stmt_timing_begin(stmt);
+    argus_stmt_reset_result(stmt);
+
+    /* Replay a cached result without contacting the backend */
+    if (dbc->result_cache) {
+        gint64 lookup_start = g_get_monotonic_time();
+        if (argus_result_cache_lookup(stmt, query)) {
+            stmt->execute_time_ms =
+                (double)(g_get_monotonic_time() - lookup_start) / 1000.0;
+            stmt->timing.submit_ms = stmt->execute_time_ms;
+            argus_trace_attr_int(stmt->trace_span, "argus.result_cache_hit",
+                                 1);
+            return SQL_SUCCESS;
+        }
+    }
 
     /* Log query (truncate if very long) */
     if (strlen(query) > 100) {
@@ -567,47 +657,99 @@ static SQLRETURN do_execute(argus_stmt_t *stmt, const char *query)
     if (stmt->query_timeout > 0 && dbc->query_timeout_sec == 0)
         dbc->query_timeout_sec = (int)stmt->query_timeout;
 
+    /* Cancelled before it started, e.g. while queued on the executor */
+    if (argus_cancel_requested(&stmt->cancel))
+        return backend_failed(stmt);
+
     /* Execute via backend with timing */
+    argus_span_t *rt = trace_round_trip(
+        stmt, nonblocking ? "backend.submit" : "backend.execute");
     gint64 exec_start = g_get_monotonic_time();
-    int rc = dbc->backend->execute(dbc->backend_conn, query, &stmt->op);
-    gint64 exec_end = g_get_monotonic_time();
-    stmt->execute_time_ms = (double)(exec_end - exec_start) / 1000.0;
+    argus_cancel_t *prev = argus_cancel_enter(&stmt->cancel);
+    argus_span_t *prev_span = argus_trace_enter(rt);
+    int rc = nonblocking
+        ? dbc->backend->submit(dbc->backend_conn, query, &stmt->op)
+        : dbc->backend->execute(dbc->backend_conn, query, &stmt->op);
+    argus_trace_leave(prev_span);
+    argus_cancel_leave(prev);
+    stmt->submitted_us = g_get_monotonic_time();
+    stmt->execute_time_ms = (double)(stmt->submitted_us - exec_start) / 1000.0;
+    stmt->timing.submit_ms = stmt->execute_time_ms;
 
     if (rc != 0) {
         ARGUS_LOG_ERROR("Query execution failed: rc=%d, query=%.100s (%.1f ms)",
                         rc, query, stmt->execute_time_ms);
-        stmt->errors_total++;
-        if (dbc) dbc->errors_total++;
-        if (stmt->diag.count == 0) {
-            char errbuf[512];
-            if (dbc->backend->get_last_error &&
-                dbc->backend->get_last_error(dbc->backend_conn,
-                                             errbuf, sizeof(errbuf)) &&
-                errbuf[0]) {
-                char msg[600];
-                snprintf(msg, sizeof(msg), "[Argus] %s", errbuf);
-                argus_set_error(&stmt->diag, "HY000", msg, 0);
-            } else {
-                argus_set_error(&stmt->diag, "HY000",
-                                "[Argus] Backend execution failed", 0);
-            }
-        }
-        /* Report only the SQLSTATE + native code, never the message text
-         * (which carries table/column names and query fragments). */
-        argus_telemetry_error(dbc,
-                              stmt->diag.count > 0
-                                  ? (const char *)stmt->diag.records[0].sqlstate
-                                  : "HY000",
-                              stmt->diag.count > 0
-                                  ? (long)stmt->diag.records[0].native_error : 0);
-        return SQL_ERROR;
+        SQLRETURN err = backend_failed(stmt);
+        argus_trace_end(rt, argus_diag_sqlstate(&stmt->diag));
+        return err;
     }
+    argus_trace_end(rt, NULL);
 
     stmt->executed = true;
-    ARGUS_LOG_DEBUG("Query executed successfully (%.1f ms)",
+    ARGUS_LOG_DEBUG("Query %s (%.1f ms)",
+                    nonblocking ? "submitted" : "executed successfully",
                     stmt->execute_time_ms);
+    return SQL_STILL_EXECUTING;
+}
+
+/*
+ * One status check of a query the backend accepted with submit(). Returns
+ * SQL_STILL_EXECUTING with *next_ms set while the server is still running
+ * it, SQL_SUCCESS once it is ready for execute_finish, or SQL_ERROR.
+ */
+static SQLRETURN execute_poll(argus_stmt_t *stmt, int *next_ms)
+{
+    argus_dbc_t *dbc = stmt->dbc;
+    bool finished = false;
+    *next_ms = 0;
+
+    /* SQLCancel or the query timeout, between two checks: stop the query
+     * on the server rather than let it run to completion unobserved */
+    if (argus_cancel_requested(&stmt->cancel)) {
+        ARGUS_LOG_INFO("Cancelling query after %.1f ms",
+                       (double)(g_get_monotonic_time() - stmt->submitted_us)
+                           / 1000.0);
+        if (dbc->backend->cancel)
+            dbc->backend->cancel(dbc->backend_conn, stmt->op);
+        dbc->backend->close_operation(dbc->backend_conn, stmt->op);
+        stmt->op = NULL;
+        stmt->executed = false;
+        return backend_failed(stmt);
+    }
+
+    argus_span_t *rt = trace_round_trip(stmt, "backend.poll");
+    argus_cancel_t *prev = argus_cancel_enter(&stmt->cancel);
+    argus_span_t *prev_span = argus_trace_enter(rt);
+    int rc = dbc->backend->poll(dbc->backend_conn, stmt->op,
+                                &finished, next_ms);
+    argus_trace_leave(prev_span);
+    argus_cancel_leave(prev);
+    if (rc != 0) {
+        ARGUS_LOG_ERROR("Query failed after %.1f ms",
+                        (double)(g_get_monotonic_time() - stmt->submitted_us)
+                            / 1000.0);
+        dbc->backend->close_operation(dbc->backend_conn, stmt->op);
+        stmt->op = NULL;
+        stmt->executed = false;
+        SQLRETURN err = backend_failed(stmt);
+        argus_trace_end(rt, argus_diag_sqlstate(&stmt->diag));
+        return err;
+    }
+    argus_trace_end(rt, NULL);
+    return finished ? SQL_SUCCESS : SQL_STILL_EXECUTING;
+}
+
+/* Describe the result of a query the backend has finished accepting */
+static SQLRETURN execute_finish(argus_stmt_t *stmt, const char *query)
+{
+    argus_dbc_t *dbc = stmt->dbc;
+    int rc;
 
     /* Try to get result metadata */
+    argus_span_t *rt = dbc->backend->get_result_metadata
+                       ? trace_round_trip(stmt, "backend.describe") : NULL;
+    argus_cancel_t *prev = argus_cancel_enter(&stmt->cancel);
+    argus_span_t *prev_span = argus_trace_enter(rt);
     if (dbc->backend->get_result_metadata) {
         /* Pre-allocate for metadata query — backend tells us actual count */
         int ncols = 0;
@@ -642,6 +784,26 @@ static SQLRETURN do_execute(argus_stmt_t *stmt, const char *query)
             ARGUS_LOG_TRACE("Retrieved metadata: %d columns", ncols);
         }
     }
+    argus_trace_leave(prev_span);
+    argus_cancel_leave(prev);
+    argus_trace_attr_int(rt, "argus.columns", stmt->num_cols);
+    argus_trace_end(rt, argus_cancel_requested(&stmt->cancel)
+                        ? (argus_cancel_timed_out(&stmt->cancel) ? "HYT00"
+                                                                 : "HY008")
+                        : NULL);
+
+    /* Backends that wait for the query while describing it (e.g. Trino)
+     * are interrupted here; closing the operation cancels it server-side */
+    if (argus_cancel_requested(&stmt->cancel)) {
+        dbc->backend->close_operation(dbc->backend_conn, stmt->op);
+        stmt->op = NULL;
+        stmt->executed = false;
+        return backend_failed(stmt);
+    }
+    /* Asynchronous backends wait here while the query is queued and planned */
+    stmt->timing.queue_ms =
+        (double)(g_get_monotonic_time() - stmt->submitted_us) / 1000.0;
+    argus_stmt_timing_progress(stmt);
 
     /* Asynchronous backends (e.g. Trino) only surface a query error while the
      * result is being polled for metadata, after execute() itself returned ok.
@@ -662,93 +824,188 @@ static SQLRETURN do_execute(argus_stmt_t *stmt, const char *query)
         }
     }
 
+    if (dbc->result_cache)
+        argus_result_cache_begin(stmt, query);
+    if (argus_metadata_cache_is_ddl(query))
+        argus_metadata_cache_invalidate(dbc);
+
     return SQL_SUCCESS;
 }
 
+/* With ARGUS_ATTR_EXTRACT_PATH set, drain the result into the file before
+ * the execute returns. The cancel token stays armed throughout, so
+ * SQLCancel and SQL_ATTR_QUERY_TIMEOUT cover the whole extract. */
+static SQLRETURN execute_extract(argus_stmt_t *stmt, SQLRETURN ret)
+{
+    if (!stmt->extract_path || !SQL_SUCCEEDED(ret)) return ret;
+    SQLRETURN xret = argus_extract_run(stmt);
+    return xret == SQL_SUCCESS ? ret : xret;
+}
+
+static SQLRETURN do_execute(argus_stmt_t *stmt, const char *query)
+{
+    argus_cancel_begin(&stmt->cancel, (long)stmt->query_timeout);
+    trace_execute_begin(stmt);
+    SQLRETURN ret = execute_start(stmt, query, false);
+    if (ret == SQL_STILL_EXECUTING)
+        ret = execute_finish(stmt, query);
+    ret = execute_extract(stmt, ret);
+    ret = trace_execute_end(stmt, ret);
+    argus_cancel_end(&stmt->cancel);
+    return ret;
+}
+
 /* ── Internal: resolve query with param substitution ──────────── */
 
-static char *resolve_query(argus_stmt_t *stmt, const char *query)
+static char *resolve_query(argus_stmt_t *stmt)
 {
     if (stmt->num_param_bindings > 0) {
-        return substitute_params(query, stmt->param_bindings,
-                                 stmt->num_param_bindings, &stmt->diag);
-    }
-    return strdup(query);
+        argus_param_binding_t *row = calloc(
+            (size_t)stmt->num_param_bindings, sizeof(argus_param_binding_t));
+        if (!row) {
+            argus_set_error(&stmt->diag, "HY001",
+                            "[Argus] Memory allocation failed", 0);
+            return NULL;
+        }
+        argus_param_row(stmt->param_bindings, stmt->num_param_bindings, 0,
+                        stmt->param_bind_type, row);
+        char *resolved = substitute_params(stmt->query_text, row,
+                                           stmt->num_param_bindings,
+                                           &stmt->diag);
+        free(row);
+        return resolved;
+    }
+    return strdup(stmt->query);
 }
 
 /* ── Internal: ODBC escape sequence translation ──────────────── */
 
 /*
- * Rewrite {fn ...}, {ts ...}, {oj ...} & co. into the backend's own grammar.
- * SQLGetInfo told the application which of these the driver accepts, so this
- * has to run before the SQL reaches the server — Tableau, Excel and Qlik all
- * generate them (Power Query does not, which is why the Power BI connector
- * never needed it).
+ * Rewrite {fn ...}, {ts ...}, {oj ...} & co. into the backend's own grammar
+ * and locate the parameter markers. SQLGetInfo told the application which of
+ * these escapes the driver accepts, so this has to run before the SQL reaches
+ * the server — Tableau, Excel and Qlik all generate them (Power Query does
+ * not, which is why the Power BI connector never needed it). The result is
+ * cached (sql_cache.c): BI tools resend the same generated SQL constantly.
  *
- * Takes ownership of `query` and returns the string to use (possibly the same
- * pointer), or NULL on error with stmt->diag set. The result is always
- * malloc'd, matching what the rest of the statement path frees.
+ * Makes the preprocessed text the statement's query. Returns false with
+ * stmt->diag set on a bad escape or when out of memory.
  */
-static char *apply_escapes(argus_stmt_t *stmt, char *query)
+static bool set_query(argus_stmt_t *stmt, const SQLCHAR *text,
+                      SQLINTEGER len)
 {
-    char *translated = NULL;
-
-    if (stmt->noscan == SQL_NOSCAN_ON) return query;
-
-    switch (argus_escape_translate(argus_dialect_for(stmt->dbc), query,
-                                   &translated, &stmt->diag)) {
-    case ARGUS_ESCAPE_NONE:
-        return query;
-
-    case ARGUS_ESCAPE_OK: {
-        /* escape.c allocates with GLib; hand back a malloc'd copy so callers
-         * keep using free(). */
-        char *dup = strdup(translated);
-        g_free(translated);
-        free(query);
-        if (!dup)
+    argus_sql_text_t *sql;
+    if (len == SQL_NTS) {
+        sql = argus_sql_text_get(stmt, (const char *)text);
+    } else {
+        char *raw = argus_str_dup(text, len);
+        if (!raw) {
             argus_set_error(&stmt->diag, "HY001",
                             "[Argus] Memory allocation failed", 0);
-        return dup;
+            return false;
+        }
+        sql = argus_sql_text_get(stmt, raw);
+        free(raw);
     }
+    if (!sql) return false;
 
-    case ARGUS_ESCAPE_ERROR:
-    default:
-        free(query);
-        return NULL;
+    /* stmt->query stays the statement's own string, which the rest of the
+     * statement path reads and frees */
+    char *query = malloc(sql->len + 1);
+    if (!query) {
+        argus_sql_text_unref(sql);
+        argus_set_error(&stmt->diag, "HY001",
+                        "[Argus] Memory allocation failed", 0);
+        return false;
     }
+    memcpy(query, sql->sql, sql->len + 1);
+
+    free(stmt->query);
+    stmt->query = query;
+    argus_sql_text_unref(stmt->query_text);
+    stmt->query_text = sql;
+    return true;
 }
 
-/* ── Internal: async worker thread ───────────────────────────── */
+/* ── Internal: asynchronous execution ────────────────────────── */
 
 /*
- * Runs the (blocking) backend execute on a background thread so SQLExecDirect /
- * SQLExecute can return SQL_STILL_EXECUTING immediately and the application can
- * poll for completion. While this runs, the polling side reads only the
- * async_done atomic — never the execution fields written here — so there is no
- * data race; the g_thread_join on the polling side publishes these writes.
+ * An asynchronous execute runs as tasks on the shared executor so that
+ * SQLExecDirect / SQLExecute can return SQL_STILL_EXECUTING immediately and
+ * the application can poll for completion. A backend with submit/poll is
+ * driven as a state machine: async_start submits the query, and each
+ * async_step makes one status check and reschedules itself after the delay
+ * the backend suggests, so no worker is held while the server runs the query.
+ * Other backends run their blocking execute on a worker. While this runs, the
+ * polling side reads only stmt->async — never the execution fields written
+ * here — and completing it is the last touch of the statement.
  */
-static gpointer async_worker(gpointer data)
+static void async_step(void *data);
+
+/* Disarm the cancel token, then publish the result: completing is the last
+ * touch of the statement */
+static void async_done(argus_stmt_t *stmt, SQLRETURN ret)
+{
+    ret = trace_execute_end(stmt, ret);
+    argus_cancel_end(&stmt->cancel);
+    argus_async_complete(&stmt->async, ret);
+}
+
+/* Run `fn` again in delay_ms; fail the statement if that is impossible */
+static void async_reschedule(argus_stmt_t *stmt, argus_task_fn fn,
+                             int delay_ms)
+{
+    if (!argus_executor_schedule(fn, stmt, delay_ms)) {
+        SQLRETURN ret = argus_set_error(
+            &stmt->diag, "HY000",
+            "[Argus] Cannot schedule the asynchronous execution", 0);
+        async_done(stmt, ret);
+    }
+}
+
+static void async_step(void *data)
 {
     argus_stmt_t *stmt = (argus_stmt_t *)data;
-    SQLRETURN ret = do_execute(stmt, stmt->async_query);
-    stmt->async_result = ret;
-    g_atomic_int_set(&stmt->async_done, 1);
-    return NULL;
+    int next_ms = 0;
+    SQLRETURN ret = execute_poll(stmt, &next_ms);
+    if (ret == SQL_STILL_EXECUTING) {
+        async_reschedule(stmt, async_step, next_ms);
+        return;
+    }
+    if (ret == SQL_SUCCESS)
+        ret = execute_extract(stmt, execute_finish(stmt, stmt->async_query));
+    async_done(stmt, ret);
+}
+
+static void async_start(void *data)
+{
+    argus_stmt_t *stmt = (argus_stmt_t *)data;
+    const argus_backend_t *backend = stmt->dbc ? stmt->dbc->backend : NULL;
+    bool stepped = backend && backend->submit && backend->poll;
+
+    SQLRETURN ret = execute_start(stmt, stmt->async_query, stepped);
+    if (ret == SQL_STILL_EXECUTING) {
+        if (stepped) {
+            async_reschedule(stmt, async_step, 0);
+            return;
+        }
+        ret = execute_finish(stmt, stmt->async_query);
+    }
+    async_done(stmt, execute_extract(stmt, ret));
 }
 
 /* ── Internal: execute or poll async ─────────────────────────── */
 
 static SQLRETURN exec_or_async(argus_stmt_t *stmt, const char *query)
 {
-    /* Already in flight: poll the worker. */
+    /* Already in flight: poll the completion. */
     if (stmt->async_enabled &&
         (stmt->async_state == ARGUS_ASYNC_SUBMITTED ||
          stmt->async_state == ARGUS_ASYNC_RUNNING)) {
         return async_poll(stmt);
     }
 
-    /* Async enabled and idle: hand the execute to a worker thread and return
+    /* Async enabled and idle: hand the execute to the executor and return
      * control immediately. The application re-calls the same function to poll. */
     if (stmt->async_enabled) {
         free(stmt->async_query);
@@ -756,10 +1013,22 @@ static SQLRETURN exec_or_async(argus_stmt_t *stmt, const char *query)
         if (!stmt->async_query)
             return argus_set_error(&stmt->diag, "HY001",
                                    "[Argus] Memory allocation failed", 0);
-        stmt->async_result = SQL_ERROR;
-        g_atomic_int_set(&stmt->async_done, 0);
+        argus_async_begin(&stmt->async);
+        argus_cancel_begin(&stmt->cancel, (long)stmt->query_timeout);
+        trace_execute_begin(stmt);
         stmt->async_state = ARGUS_ASYNC_RUNNING;
-        stmt->async_thread = g_thread_new("argus-async", async_worker, stmt);
+        if (!argus_executor_submit(async_start, stmt)) {
+            argus_async_abandon(&stmt->async);
+            stmt->async_state = ARGUS_ASYNC_ERROR;
+            free(stmt->async_query);
+            stmt->async_query = NULL;
+            SQLRETURN ret = argus_set_error(&stmt->diag, "HY000",
+                                            "[Argus] Cannot start the "
+                                            "asynchronous execution", 0);
+            trace_execute_end(stmt, ret);
+            argus_cancel_end(&stmt->cancel);
+            return ret;
+        }
         return SQL_STILL_EXECUTING;
     }
 
@@ -778,9 +1047,9 @@ SQLRETURN SQL_API SQLExecDirect(
     if (!argus_valid_stmt(stmt)) return SQL_INVALID_HANDLE;
 
     ARGUS_STMT_LOCK(stmt);
-    argus_diag_clear(&stmt->diag);
 
-    /* If async polling is in progress, continue it */
+    /* If async polling is in progress, continue it. The diagnostics belong
+     * to the execution in flight, so they are not cleared. */
     if (stmt->async_enabled &&
         (stmt->async_state == ARGUS_ASYNC_SUBMITTED ||
          stmt->async_state == ARGUS_ASYNC_RUNNING)) {
@@ -788,6 +1057,7 @@ SQLRETURN SQL_API SQLExecDirect(
         ARGUS_STMT_UNLOCK(stmt);
         return ret;
     }
+    argus_diag_clear(&stmt->diag);
 
     if (!StatementText) {
         SQLRETURN err = argus_set_error(&stmt->diag, "HY009",
@@ -796,28 +1066,15 @@ SQLRETURN SQL_API SQLExecDirect(
         return err;
     }
 
-    char *query = argus_str_dup(StatementText, TextLength);
-    if (!query) {
-        SQLRETURN err = argus_set_error(&stmt->diag, "HY001",
-                               "[Argus] Memory allocation failed", 0);
-        ARGUS_STMT_UNLOCK(stmt);
-        return err;
-    }
-
     /* Escapes first: parameter substitution injects literals that must not be
      * rescanned, and stmt->query is expected to hold native SQL from here on. */
-    query = apply_escapes(stmt, query);
-    if (!query) {
+    if (!set_query(stmt, StatementText, TextLength)) {
         ARGUS_STMT_UNLOCK(stmt);
         return SQL_ERROR;
     }
 
-    /* Store the query */
-    free(stmt->query);
-    stmt->query = query;
-
     /* Resolve parameters */
-    char *resolved = resolve_query(stmt, query);
+    char *resolved = resolve_query(stmt);
     if (!resolved) {
         ARGUS_STMT_UNLOCK(stmt);
         return SQL_ERROR;
@@ -850,24 +1107,13 @@ SQLRETURN SQL_API SQLPrepare(
         return err;
     }
 
-    char *query = argus_str_dup(StatementText, TextLength);
-    if (!query) {
-        SQLRETURN err = argus_set_error(&stmt->diag, "HY001",
-                               "[Argus] Memory allocation failed", 0);
-        ARGUS_STMT_UNLOCK(stmt);
-        return err;
-    }
-
     /* Translate here rather than at SQLExecute so a bad escape is reported at
      * prepare time, where the application expects to hear about bad SQL. */
-    query = apply_escapes(stmt, query);
-    if (!query) {
+    if (!set_query(stmt, StatementText, TextLength)) {
         ARGUS_STMT_UNLOCK(stmt);
         return SQL_ERROR;
     }
 
-    free(stmt->query);
-    stmt->query    = query;
     stmt->prepared = true;
     stmt->executed = false;
 
@@ -918,19 +1164,19 @@ static size_t c_type_element_size(SQLSMALLINT c_type)
     }
 }
 
-/* ── Internal: build param bindings for a specific row in a paramset ── */
+/* ── Param bindings for a specific row in a paramset ─────────── */
 
-static void build_row_params(const argus_param_binding_t *base_params,
-                              int num_params,
-                              SQLULEN row_idx,
-                              SQLULEN bind_type,
-                              argus_param_binding_t *row_params)
+void argus_param_row(const argus_param_binding_t *base_params,
+                     int num_params,
+                     SQLULEN row_idx,
+                     SQLULEN bind_type,
+                     argus_param_binding_t *row_params)
 {
     for (int i = 0; i < num_params; i++) {
         row_params[i] = base_params[i];
-        if (!base_params[i].bound || row_idx == 0) continue;
+        if (!base_params[i].bound) continue;
 
-        if (bind_type == SQL_PARAM_BIND_BY_COLUMN) {
+        if (row_idx > 0 && bind_type == SQL_PARAM_BIND_BY_COLUMN) {
             /* Column-wise: advance by element size */
             size_t elem_sz = c_type_element_size(base_params[i].value_type);
             if (elem_sz == 0)
@@ -941,7 +1187,7 @@ static void build_row_params(const argus_param_binding_t *base_params,
             if (base_params[i].str_len_or_ind)
                 row_params[i].str_len_or_ind =
                     base_params[i].str_len_or_ind + row_idx;
-        } else {
+        } else if (row_idx > 0) {
             /* Row-wise: advance by bind_type (struct stride) */
             row_params[i].value = (SQLPOINTER)(
                 (unsigned char *)base_params[i].value + row_idx * bind_type);
@@ -950,6 +1196,14 @@ static void build_row_params(const argus_param_binding_t *base_params,
                     (unsigned char *)base_params[i].str_len_or_ind
                     + row_idx * bind_type);
         }
+
+        /* ARGUS_C_CHAR_PTR: the element is a pointer to the string */
+        if (row_params[i].value_type == ARGUS_C_CHAR_PTR) {
+            if (row_params[i].value)
+                row_params[i].value = *(char *const *)row_params[i].value;
+            row_params[i].value_type = SQL_C_CHAR;
+            row_params[i].buffer_length = 0;
+        }
     }
 }
 
@@ -961,9 +1215,9 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT StatementHandle)
     if (!argus_valid_stmt(stmt)) return SQL_INVALID_HANDLE;
 
     ARGUS_STMT_LOCK(stmt);
-    argus_diag_clear(&stmt->diag);
 
-    /* If async polling is in progress, continue it */
+    /* If async polling is in progress, continue it. The diagnostics belong
+     * to the execution in flight, so they are not cleared. */
     if (stmt->async_enabled &&
         (stmt->async_state == ARGUS_ASYNC_SUBMITTED ||
          stmt->async_state == ARGUS_ASYNC_RUNNING)) {
@@ -977,6 +1231,7 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT StatementHandle)
         ARGUS_STMT_UNLOCK(stmt);
         return ret;
     }
+    argus_diag_clear(&stmt->diag);
 
     if (!stmt->query || !stmt->prepared) {
         SQLRETURN err = argus_set_error(&stmt->diag, "HY010",
@@ -1006,7 +1261,7 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT StatementHandle)
 
     /* Single-row execution (common case) */
     if (paramset_size == 1) {
-        char *resolved = resolve_query(stmt, stmt->query);
+        char *resolved = resolve_query(stmt);
         if (!resolved) {
             if (stmt->params_processed_ptr) *stmt->params_processed_ptr = 0;
             ARGUS_STMT_UNLOCK(stmt);
@@ -1024,6 +1279,14 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT StatementHandle)
         return ret;
     }
 
+    /* An INSERT ... VALUES (?, ...) over the array goes to the backend's
+     * native bulk path in one call, where it has one (bulk.c) */
+    SQLRETURN bulk_ret = SQL_SUCCESS;
+    if (argus_bulk_insert_params(stmt, paramset_size, &bulk_ret)) {
+        ARGUS_STMT_UNLOCK(stmt);
+        return bulk_ret;
+    }
+
     /* Batch execution: loop over parameter sets */
     SQLRETURN overall_ret = SQL_SUCCESS;
     SQLULEN rows_processed = 0;
@@ -1039,11 +1302,11 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT StatementHandle)
 
     for (SQLULEN r = 0; r < paramset_size; r++) {
         /* Build param bindings for this row */
-        build_row_params(stmt->param_bindings, stmt->num_param_bindings,
-                          r, stmt->param_bind_type, row_params);
+        argus_param_row(stmt->param_bindings, stmt->num_param_bindings,
+                        r, stmt->param_bind_type, row_params);
 
         char *resolved = substitute_params(
-            stmt->query, row_params,
+            stmt->query_text, row_params,
             stmt->num_param_bindings, &stmt->diag);
         if (!resolved) {
             if (stmt->param_status_ptr)
@@ -1065,6 +1328,16 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT StatementHandle)
         if (ret != SQL_SUCCESS) {
             overall_ret = SQL_SUCCESS_WITH_INFO;
         }
+
+        /* SQLCancel or the query timeout ends the batch, not just this row */
+        if (ret == SQL_ERROR && stmt->diag.count > 0) {
+            const char *st = (const char *)
+                stmt->diag.records[stmt->diag.count - 1].sqlstate;
+            if (strcmp(st, "HY008") == 0 || strcmp(st, "HYT00") == 0) {
+                overall_ret = SQL_ERROR;
+                break;
+            }
+        }
     }
 
     free(row_params);
@@ -1175,7 +1448,31 @@ SQLRETURN SQL_API SQLCancel(SQLHSTMT StatementHandle)
     argus_stmt_t *stmt = (argus_stmt_t *)StatementHandle;
     if (!argus_valid_stmt(stmt)) return SQL_INVALID_HANDLE;
 
+    /* Stop the execute or fetch in progress. A synchronous one is running
+     * on another thread, which holds the statement lock: as ODBC specifies,
+     * return at once and let that call fail with HY008 itself. */
+    if (argus_cancel_request(&stmt->cancel) && !stmt->async_enabled) {
+        ARGUS_LOG_INFO("Cancelling statement running on another thread");
+        return SQL_SUCCESS;
+    }
+
     ARGUS_STMT_LOCK(stmt);
+
+    /* Async in flight: the executor owns async_query and the execution fields
+     * (the diagnostics included), so it must complete before we touch either.
+     * The request above has interrupted its backend call, or stops it at its
+     * next status check, so the wait is short; the query is cancelled on the
+     * server as the execute unwinds. */
+    if (stmt->async_state == ARGUS_ASYNC_SUBMITTED ||
+        stmt->async_state == ARGUS_ASYNC_RUNNING) {
+        argus_async_wait(&stmt->async);
+        argus_diag_clear(&stmt->diag);
+        stmt->async_state = ARGUS_ASYNC_IDLE;
+        free(stmt->async_query);
+        stmt->async_query = NULL;
+        ARGUS_STMT_UNLOCK(stmt);
+        return SQL_SUCCESS;
+    }
     argus_diag_clear(&stmt->diag);
 
     /* Reset DAE state if in progress */
@@ -1187,23 +1484,6 @@ SQLRETURN SQL_API SQLCancel(SQLHSTMT StatementHandle)
         }
     }
 
-    /* Async in flight: the worker owns async_query and the execution fields, so
-     * it must be joined before we touch either. Joining waits for the in-flight
-     * statement to finish (the driver does not offer a mid-flight interrupt of a
-     * running backend call); this is a valid, if blocking, cancel. */
-    if (stmt->async_state == ARGUS_ASYNC_SUBMITTED ||
-        stmt->async_state == ARGUS_ASYNC_RUNNING) {
-        if (stmt->async_thread) {
-            g_thread_join(stmt->async_thread);
-            stmt->async_thread = NULL;
-        }
-        stmt->async_state = ARGUS_ASYNC_IDLE;
-        g_atomic_int_set(&stmt->async_done, 0);
-        free(stmt->async_query);
-        stmt->async_query = NULL;
-        ARGUS_STMT_UNLOCK(stmt);
-        return SQL_SUCCESS;
-    }
     /* Reset any stale (non-running) async bookkeeping. */
     if (stmt->async_state != ARGUS_ASYNC_IDLE) {
         stmt->async_state = ARGUS_ASYNC_IDLE;
@@ -1245,20 +1525,24 @@ SQLRETURN SQL_API SQLCancel(SQLHSTMT StatementHandle)
 /* ── ODBC 3.8 API: SQLCancelHandle ───────────────────────────── */
 
 /*
- * Cancel an operation on any handle. For a statement this is SQLCancel; the
- * connection-level async model (SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE) is not
- * offered — the driver's async is statement-level — so a connection handle has
- * nothing to cancel and succeeds trivially. Advertised because the driver
- * reports SQL_DRIVER_ODBC_VER = "03.80".
+ * Cancel an operation on any handle. For a statement this is SQLCancel. On a
+ * connection, an asynchronous connect or disconnect
+ * (SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE) cannot be interrupted half way, so
+ * the cancel waits for it; the next call of the function reports how it
+ * ended. Advertised because the driver reports SQL_DRIVER_ODBC_VER = "03.80".
  */
 SQLRETURN SQL_API SQLCancelHandle(SQLSMALLINT HandleType, SQLHANDLE Handle)
 {
     switch (HandleType) {
     case SQL_HANDLE_STMT:
         return SQLCancel((SQLHSTMT)Handle);
-    case SQL_HANDLE_DBC:
-        if (!argus_valid_dbc(Handle)) return SQL_INVALID_HANDLE;
+    case SQL_HANDLE_DBC: {
+        argus_dbc_t *dbc = (argus_dbc_t *)Handle;
+        if (!argus_valid_dbc(dbc)) return SQL_INVALID_HANDLE;
+        if (dbc->async_dbc_busy)
+            argus_async_wait(&dbc->async_dbc);
         return SQL_SUCCESS;
+    }
     default:
         return SQL_INVALID_HANDLE;
     }
@@ -1267,16 +1551,23 @@ SQLRETURN SQL_API SQLCancelHandle(SQLSMALLINT HandleType, SQLHANDLE Handle)
 /* ── ODBC 3.8 API: SQLCompleteAsync ──────────────────────────── */
 
 /*
- * Block until a statement's outstanding asynchronous operation finishes and
- * hand back its return code in *AsyncRetCodePtr. Connections have no
- * async operations of their own, so a DBC handle completes trivially.
+ * Block until a handle's outstanding asynchronous operation finishes and
+ * hand back its return code in *AsyncRetCodePtr: a statement's execute, or a
+ * connection's connect or disconnect. This is how an application using
+ * notification (SQL_ATTR_ASYNC_*_PCALLBACK or _EVENT) collects the result.
  */
 SQLRETURN SQL_API SQLCompleteAsync(SQLSMALLINT HandleType, SQLHANDLE Handle,
                                    RETCODE *AsyncRetCodePtr)
 {
     if (HandleType == SQL_HANDLE_DBC) {
-        if (!argus_valid_dbc(Handle)) return SQL_INVALID_HANDLE;
-        if (AsyncRetCodePtr) *AsyncRetCodePtr = SQL_SUCCESS;
+        argus_dbc_t *dbc = (argus_dbc_t *)Handle;
+        if (!argus_valid_dbc(dbc)) return SQL_INVALID_HANDLE;
+        SQLRETURN ret = SQL_SUCCESS;
+        if (dbc->async_dbc_busy) {
+            ret = argus_async_wait(&dbc->async_dbc);
+            dbc->async_dbc_busy = false;
+        }
+        if (AsyncRetCodePtr) *AsyncRetCodePtr = ret;
         return SQL_SUCCESS;
     }
     if (HandleType != SQL_HANDLE_STMT) return SQL_INVALID_HANDLE;
@@ -1294,11 +1585,7 @@ SQLRETURN SQL_API SQLCompleteAsync(SQLSMALLINT HandleType, SQLHANDLE Handle,
         return SQL_SUCCESS;
     }
 
-    if (stmt->async_thread) {
-        g_thread_join(stmt->async_thread);
-        stmt->async_thread = NULL;
-    }
-    SQLRETURN ret = stmt->async_result;
+    SQLRETURN ret = argus_async_wait(&stmt->async);
     stmt->async_state = (ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO)
                         ? ARGUS_ASYNC_DONE : ARGUS_ASYNC_ERROR;
     free(stmt->async_query);
@@ -1397,7 +1684,7 @@ SQLRETURN SQL_API SQLParamData(
     stmt->dae_state = ARGUS_DAE_IDLE;
     stmt->dae_current_param = -1;
 
-    char *resolved = resolve_query(stmt, stmt->query);
+    char *resolved = resolve_query(stmt);
     if (!resolved) {
         ARGUS_STMT_UNLOCK(stmt);
         return SQL_ERROR;
@@ -1487,7 +1774,9 @@ SQLRETURN SQL_API SQLNumParams(
     if (!argus_valid_stmt(stmt)) return SQL_INVALID_HANDLE;
 
     if (ParameterCountPtr) {
-        if (stmt->query)
+        if (stmt->query_text)
+            *ParameterCountPtr = (SQLSMALLINT)stmt->query_text->num_markers;
+        else if (stmt->query)
             *ParameterCountPtr = (SQLSMALLINT)count_param_markers(stmt->query);
         else
             *ParameterCountPtr = 0;
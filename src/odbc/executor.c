@@ -0,0 +1,320 @@
+/*
+ * executor.c - Shared, bounded executor for asynchronous ODBC calls.
+ *
+ * Asynchronous statements (SQL_ATTR_ASYNC_ENABLE) and connections
+ * (SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE) hand their work to one process-wide
+ * GThreadPool instead of a thread each, so a middle tier with thousands of
+ * statements in flight runs a fixed number of threads. A statement whose
+ * backend can poll (backend.h submit/poll) does not hold a worker while the
+ * server runs it: each status check is a short task, and the wait between
+ * checks sits on the timer below, which hands the next check back to the
+ * pool when it is due.
+ *
+ * argus_async_t is the completion a calling thread polls or waits on.
+ */
+
+#include "argus/handle.h"
+#include "argus/log.h"
+
+#include <glib.h>
+#include <stdlib.h>
+
+#define ARGUS_EXECUTOR_MIN_THREADS 8
+
+typedef struct exec_task {
+    argus_task_fn   fn;
+    void           *data;
+    gint64          due;        /* monotonic us; timer tasks only */
+} exec_task_t;
+
+static GMutex        g_exec_lock;
+static GCond         g_timer_cond;
+static GThreadPool  *g_exec_pool;
+static GThread      *g_timer;
+static bool          g_exec_stopping;
+static int           g_exec_max_threads;    /* 0 = default */
+
+/* Timer tasks, a binary min-heap on `due` */
+static exec_task_t **g_heap;
+static size_t        g_heap_len;
+static size_t        g_heap_cap;
+
+static int default_threads(void)
+{
+    int n = 2 * (int)g_get_num_processors();
+    return n < ARGUS_EXECUTOR_MIN_THREADS ? ARGUS_EXECUTOR_MIN_THREADS : n;
+}
+
+static void exec_run(gpointer task, gpointer user_data)
+{
+    (void)user_data;
+    exec_task_t *t = (exec_task_t *)task;
+    t->fn(t->data);
+    free(t);
+}
+
+/* Create the pool on first use. Caller holds g_exec_lock. */
+static bool pool_ready(void)
+{
+    if (g_exec_pool) return true;
+    if (g_exec_stopping) return false;
+
+    GError *err = NULL;
+    int threads = g_exec_max_threads > 0 ? g_exec_max_threads
+                                         : default_threads();
+    g_exec_pool = g_thread_pool_new(exec_run, NULL, threads, FALSE, &err);
+    if (!g_exec_pool) {
+        ARGUS_LOG_ERROR("Executor: cannot create the worker pool: %s",
+                        err ? err->message : "unknown error");
+        if (err) g_error_free(err);
+        return false;
+    }
+    ARGUS_LOG_DEBUG("Executor: up to %d worker thread(s)", threads);
+    return true;
+}
+
+/* Caller holds g_exec_lock and has checked pool_ready() */
+static bool pool_push(exec_task_t *t)
+{
+    GError *err = NULL;
+    if (!g_thread_pool_push(g_exec_pool, t, &err)) {
+        ARGUS_LOG_ERROR("Executor: cannot queue a task: %s",
+                        err ? err->message : "unknown error");
+        if (err) g_error_free(err);
+        return false;
+    }
+    return true;
+}
+
+/* ── Timer heap ──────────────────────────────────────────────── */
+
+static bool heap_push(exec_task_t *t)
+{
+    if (g_heap_len == g_heap_cap) {
+        size_t cap = g_heap_cap ? g_heap_cap * 2 : 64;
+        exec_task_t **grown = realloc(g_heap, cap * sizeof(*grown));
+        if (!grown) return false;
+        g_heap = grown;
+        g_heap_cap = cap;
+    }
+    size_t i = g_heap_len++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (g_heap[parent]->due <= t->due) break;
+        g_heap[i] = g_heap[parent];
+        i = parent;
+    }
+    g_heap[i] = t;
+    return true;
+}
+
+static exec_task_t *heap_pop(void)
+{
+    exec_task_t *top = g_heap[0];
+    exec_task_t *last = g_heap[--g_heap_len];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= g_heap_len) break;
+        if (child + 1 < g_heap_len && g_heap[child + 1]->due < g_heap[child]->due)
+            child++;
+        if (last->due <= g_heap[child]->due) break;
+        g_heap[i] = g_heap[child];
+        i = child;
+    }
+    if (g_heap_len > 0) g_heap[i] = last;
+    return top;
+}
+
+/* Move due tasks to the pool; sleep until the next one is due */
+static gpointer timer_run(gpointer data)
+{
+    (void)data;
+    g_mutex_lock(&g_exec_lock);
+    while (!g_exec_stopping) {
+        if (g_heap_len == 0) {
+            g_cond_wait(&g_timer_cond, &g_exec_lock);
+            continue;
+        }
+        gint64 due = g_heap[0]->due;
+        if (due > g_get_monotonic_time()) {
+            g_cond_wait_until(&g_timer_cond, &g_exec_lock, due);
+            continue;
+        }
+        exec_task_t *t = heap_pop();
+        if (!pool_push(t)) {
+            /* The pool refused it: run it here rather than lose a
+             * completion someone is waiting on */
+            g_mutex_unlock(&g_exec_lock);
+            exec_run(t, NULL);
+            g_mutex_lock(&g_exec_lock);
+        }
+    }
+    g_mutex_unlock(&g_exec_lock);
+    return NULL;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void argus_executor_configure(int max_threads)
+{
+    if (max_threads <= 0) return;
+    g_mutex_lock(&g_exec_lock);
+    g_exec_max_threads = max_threads;
+    if (g_exec_pool)
+        g_thread_pool_set_max_threads(g_exec_pool, max_threads, NULL);
+    g_mutex_unlock(&g_exec_lock);
+}
+
+bool argus_executor_submit(argus_task_fn fn, void *data)
+{
+    exec_task_t *t = malloc(sizeof(*t));
+    if (!t) return false;
+    t->fn = fn;
+    t->data = data;
+    t->due = 0;
+
+    g_mutex_lock(&g_exec_lock);
+    bool ok = pool_ready() && pool_push(t);
+    g_mutex_unlock(&g_exec_lock);
+    if (!ok) free(t);
+    return ok;
+}
+
+bool argus_executor_schedule(argus_task_fn fn, void *data, int delay_ms)
+{
+    if (delay_ms <= 0) return argus_executor_submit(fn, data);
+
+    exec_task_t *t = malloc(sizeof(*t));
+    if (!t) return false;
+    t->fn = fn;
+    t->data = data;
+    t->due = g_get_monotonic_time() + (gint64)delay_ms * 1000;
+
+    g_mutex_lock(&g_exec_lock);
+    bool ok = pool_ready();
+    if (ok && !g_timer) {
+        g_timer = g_thread_try_new("argus-timer", timer_run, NULL, NULL);
+        if (!g_timer) {
+            ARGUS_LOG_ERROR("Executor: cannot start the timer thread");
+            ok = false;
+        }
+    }
+    if (ok) ok = heap_push(t);
+    if (ok && g_heap[0] == t)
+        g_cond_signal(&g_timer_cond);
+    g_mutex_unlock(&g_exec_lock);
+    if (!ok) free(t);
+    return ok;
+}
+
+/* Stop the timer, let queued tasks finish and join the workers. Timer tasks
+ * not yet due are dropped: every handle that could be waiting on them has
+ * been freed by now. */
+void argus_executor_shutdown(void)
+{
+    g_mutex_lock(&g_exec_lock);
+    g_exec_stopping = true;
+    g_cond_signal(&g_timer_cond);
+    GThread *timer = g_timer;
+    g_timer = NULL;
+    g_mutex_unlock(&g_exec_lock);
+
+    if (timer) g_thread_join(timer);
+
+    g_mutex_lock(&g_exec_lock);
+    GThreadPool *pool = g_exec_pool;
+    g_exec_pool = NULL;
+    g_mutex_unlock(&g_exec_lock);
+    if (pool) g_thread_pool_free(pool, FALSE, TRUE);
+
+    g_mutex_lock(&g_exec_lock);
+    while (g_heap_len > 0)
+        free(heap_pop());
+    free(g_heap);
+    g_heap = NULL;
+    g_heap_cap = 0;
+    g_mutex_unlock(&g_exec_lock);
+}
+
+/* ── Completions ─────────────────────────────────────────────── */
+
+/* SQL_ASYNC_NOTIFICATION_CALLBACK, without depending on a 3.8 sqlext.h */
+typedef SQLRETURN (SQL_API *async_notify_fn)(SQLPOINTER context, int last);
+
+void argus_async_init(argus_async_t *a)
+{
+    g_mutex_init(&a->lock);
+    g_cond_init(&a->cond);
+    a->running = false;
+    a->result = SQL_SUCCESS;
+}
+
+void argus_async_clear(argus_async_t *a)
+{
+    g_cond_clear(&a->cond);
+    g_mutex_clear(&a->lock);
+}
+
+void argus_async_begin(argus_async_t *a)
+{
+    g_mutex_lock(&a->lock);
+    a->running = true;
+    a->result = SQL_ERROR;
+    g_mutex_unlock(&a->lock);
+}
+
+/* Undo argus_async_begin when the work could not be started. Nobody is
+ * notified: the caller reports the failure itself. */
+void argus_async_abandon(argus_async_t *a)
+{
+    g_mutex_lock(&a->lock);
+    a->running = false;
+    g_mutex_unlock(&a->lock);
+}
+
+/* The handle may be freed as soon as the lock is released, so the
+ * notification target is copied out first. */
+void argus_async_complete(argus_async_t *a, SQLRETURN result)
+{
+    g_mutex_lock(&a->lock);
+    SQLPOINTER callback = a->callback;
+    SQLPOINTER context = a->context;
+#ifdef _WIN32
+    HANDLE event = (HANDLE)a->event;
+#endif
+    a->result = result;
+    a->running = false;
+    g_cond_broadcast(&a->cond);
+    g_mutex_unlock(&a->lock);
+
+    if (callback) {
+        async_notify_fn notify;
+        *(void **)&notify = callback;
+        notify(context, 1);
+    }
+#ifdef _WIN32
+    else if (event) {
+        SetEvent(event);
+    }
+#endif
+}
+
+bool argus_async_poll(argus_async_t *a, SQLRETURN *result)
+{
+    g_mutex_lock(&a->lock);
+    bool done = !a->running;
+    if (done && result) *result = a->result;
+    g_mutex_unlock(&a->lock);
+    return done;
+}
+
+SQLRETURN argus_async_wait(argus_async_t *a)
+{
+    g_mutex_lock(&a->lock);
+    while (a->running)
+        g_cond_wait(&a->cond, &a->lock);
+    SQLRETURN result = a->result;
+    g_mutex_unlock(&a->lock);
+    return result;
+}
@@ -0,0 +1,388 @@
+/*
+ * extract.c - Direct-to-file extract (see argus/extract.h).
+ *
+ * With ARGUS_ATTR_EXTRACT_PATH set, a successful execute drains the result
+ * here instead of leaving it to SQLFetch. The executing thread keeps pulling
+ * batches from the backend and hands their rows to a writer thread through a
+ * short bounded queue, so decoding and file I/O overlap the next round trip
+ * to the server while memory stays bounded by a few batches plus the open
+ * row group.
+ *
+ * The writer takes each cell's native value when the backend produced one
+ * (ARGUS_NATIVE_I64 / F64, which is also how Flight SQL's Arrow batches
+ * arrive) and parses the text otherwise; no ODBC C-type conversion is
+ * involved. Integer SQL types become int64 columns, floating point ones
+ * double, and everything else text, as the ADBC driver maps them.
+ */
+
+#include "argus/extract.h"
+#include "argus/handle.h"
+#include "argus/log.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Batches fetched ahead of the writer */
+#define EXTRACT_QUEUE_DEPTH 4
+
+typedef struct extract_batch {
+    argus_row_t *rows;
+    size_t       num_rows;
+    int          num_cols;      /* cells per row */
+} extract_batch_t;
+
+typedef struct extract_job {
+    argus_extract_writer_t *writer;
+    int                     num_cols;
+    argus_extract_type_t   *types;
+    const argus_column_desc_t *columns;
+
+    GMutex                  lock;
+    GCond                   cond;
+    GQueue                  pending;    /* extract_batch_t; NULL ends it */
+    bool                    failed;     /* the writer gave up */
+    char                    sqlstate[6];
+    char                    error[512];
+} extract_job_t;
+
+static void free_batch(extract_batch_t *b)
+{
+    if (!b) return;
+    for (size_t r = 0; r < b->num_rows; r++) {
+        if (!b->rows[r].cells) continue;
+        for (int c = 0; c < b->num_cols; c++)
+            free(b->rows[r].cells[c].data);
+        free(b->rows[r].cells);
+    }
+    free(b->rows);
+    free(b);
+}
+
+static argus_extract_type_t extract_type(SQLSMALLINT sql_type)
+{
+    switch (sql_type) {
+    case SQL_TINYINT:
+    case SQL_SMALLINT:
+    case SQL_INTEGER:
+    case SQL_BIGINT:
+        return ARGUS_EXTRACT_INT64;
+    case SQL_REAL:
+    case SQL_FLOAT:
+    case SQL_DOUBLE:
+        return ARGUS_EXTRACT_DOUBLE;
+    default:
+        return ARGUS_EXTRACT_UTF8;
+    }
+}
+
+/* ── Writer thread ───────────────────────────────────────────── */
+
+static void job_fail(extract_job_t *x, const char *sqlstate, const char *msg)
+{
+    g_mutex_lock(&x->lock);
+    if (!x->failed) {
+        x->failed = true;
+        snprintf(x->sqlstate, sizeof(x->sqlstate), "%s", sqlstate);
+        snprintf(x->error, sizeof(x->error), "%s", msg);
+    }
+    g_cond_broadcast(&x->cond);
+    g_mutex_unlock(&x->lock);
+}
+
+static bool job_failed(extract_job_t *x)
+{
+    g_mutex_lock(&x->lock);
+    bool failed = x->failed;
+    g_mutex_unlock(&x->lock);
+    return failed;
+}
+
+/* A text cell of a numeric column; false when it is not a number */
+static bool write_parsed(extract_job_t *x, int c, const char *s)
+{
+    char *end = NULL;
+    errno = 0;
+    if (x->types[c] == ARGUS_EXTRACT_INT64) {
+        gint64 v = g_ascii_strtoll(s, &end, 10);
+        if (end == s || *end || errno) return false;
+        argus_extract_writer_i64(x->writer, c, v);
+    } else {
+        double v = g_ascii_strtod(s, &end);
+        if (end == s || *end) return false;
+        argus_extract_writer_f64(x->writer, c, v);
+    }
+    return true;
+}
+
+static bool write_row(extract_job_t *x, const argus_row_t *row)
+{
+    for (int c = 0; c < x->num_cols; c++) {
+        const argus_cell_t *cell = &row->cells[c];
+        if (cell->is_null) {
+            argus_extract_writer_null(x->writer, c);
+        } else if (cell->native_kind == ARGUS_NATIVE_I64) {
+            argus_extract_writer_i64(x->writer, c, cell->native.i64);
+        } else if (cell->native_kind == ARGUS_NATIVE_F64) {
+            argus_extract_writer_f64(x->writer, c, cell->native.f64);
+        } else if (x->types[c] == ARGUS_EXTRACT_UTF8) {
+            argus_extract_writer_text(x->writer, c,
+                                      cell->data ? cell->data : "",
+                                      cell->data ? cell->data_len : 0);
+        } else if (!write_parsed(x, c, cell->data ? cell->data : "")) {
+            char msg[400];
+            snprintf(msg, sizeof(msg),
+                     "[Argus] Column %s of the extract is numeric but holds "
+                     "'%.60s'",
+                     (const char *)x->columns[c].name,
+                     cell->data ? cell->data : "");
+            job_fail(x, "22018", msg);
+            return false;
+        }
+    }
+    if (argus_extract_writer_end_row(x->writer) != 0) {
+        char msg[400];
+        snprintf(msg, sizeof(msg), "[Argus] Extract failed: %s",
+                 argus_extract_writer_error(x->writer));
+        job_fail(x, "HY000", msg);
+        return false;
+    }
+    return true;
+}
+
+static extract_batch_t *queue_pop(extract_job_t *x)
+{
+    g_mutex_lock(&x->lock);
+    while (g_queue_is_empty(&x->pending))
+        g_cond_wait(&x->cond, &x->lock);
+    extract_batch_t *b = g_queue_pop_head(&x->pending);
+    g_cond_broadcast(&x->cond);
+    g_mutex_unlock(&x->lock);
+    return b;
+}
+
+/* Write batches until the end marker; after a failure, just free them */
+static gpointer writer_main(gpointer data)
+{
+    extract_job_t *x = (extract_job_t *)data;
+    extract_batch_t *b;
+    while ((b = queue_pop(x)) != NULL) {
+        for (size_t r = 0; r < b->num_rows && !job_failed(x); r++)
+            write_row(x, &b->rows[r]);
+        free_batch(b);
+    }
+    return NULL;
+}
+
+/* Hand a batch to the writer, waiting while it is EXTRACT_QUEUE_DEPTH
+ * behind. Returns false (keeping the batch) once the writer has failed. */
+static bool queue_push(extract_job_t *x, extract_batch_t *b)
+{
+    g_mutex_lock(&x->lock);
+    while (b && !x->failed &&
+           g_queue_get_length(&x->pending) >= EXTRACT_QUEUE_DEPTH)
+        g_cond_wait(&x->cond, &x->lock);
+    bool ok = !b || !x->failed;
+    if (ok) {
+        g_queue_push_tail(&x->pending, b);
+        g_cond_broadcast(&x->cond);
+    }
+    g_mutex_unlock(&x->lock);
+    return ok;
+}
+
+/* ── Fetching ────────────────────────────────────────────────── */
+
+/* The rows of row_cache not yet consumed, at most `limit` of them. They
+ * are moved out when the cache owns them and copied when it borrows them. */
+static extract_batch_t *take_rows(argus_stmt_t *stmt, size_t limit)
+{
+    argus_row_cache_t *rc = &stmt->row_cache;
+    if (rc->current_row >= rc->num_rows) return NULL;
+    size_t first = rc->current_row;
+    size_t n = rc->num_rows - first;
+    if (n > limit) n = limit;
+
+    extract_batch_t *b = calloc(1, sizeof(*b));
+    if (!b) return NULL;
+    b->num_rows = n;
+    b->num_cols = stmt->num_cols;
+
+    if (!rc->borrowed && first == 0 && n == rc->num_rows &&
+        rc->num_cols == stmt->num_cols) {
+        b->rows = rc->rows;
+        rc->rows = NULL;
+        rc->capacity = 0;
+        rc->num_rows = 0;
+        rc->current_row = 0;
+        return b;
+    }
+
+    b->rows = calloc(n, sizeof(argus_row_t));
+    if (!b->rows) {
+        free(b);
+        return NULL;
+    }
+    for (size_t r = 0; r < n; r++) {
+        if (argus_row_copy(&b->rows[r], &rc->rows[first + r],
+                           stmt->num_cols) != 0) {
+            b->num_rows = r;
+            free_batch(b);
+            return NULL;
+        }
+    }
+    rc->current_row = first + n;
+    return b;
+}
+
+static SQLRETURN start_job(argus_stmt_t *stmt, extract_job_t *x)
+{
+    int format = (int)stmt->extract_format;
+    if (format == ARGUS_EXTRACT_FORMAT_AUTO)
+        format = argus_extract_format_for(stmt->extract_path);
+    if (format == ARGUS_EXTRACT_FORMAT_ARROW &&
+        stmt->extract_compression != ARGUS_EXTRACT_COMPRESS_NONE)
+        return argus_set_error(&stmt->diag, "HYC00",
+                               "[Argus] Arrow IPC extracts cannot be "
+                               "compressed; use Parquet or CSV for GZIP", 0);
+
+    x->num_cols = stmt->num_cols;
+    x->columns = stmt->columns;
+    x->types = calloc((size_t)x->num_cols, sizeof(*x->types));
+    const char **names = calloc((size_t)x->num_cols, sizeof(*names));
+    if (!x->types || !names) {
+        free(names);
+        return argus_set_error(&stmt->diag, "HY001",
+                               "[Argus] Memory allocation failed", 0);
+    }
+    for (int c = 0; c < x->num_cols; c++) {
+        x->types[c] = extract_type(stmt->columns[c].sql_type);
+        names[c] = (const char *)stmt->columns[c].name;
+    }
+
+    char err[300] = "";
+    size_t group = stmt->extract_row_group > 0
+                   ? (size_t)stmt->extract_row_group
+                   : ARGUS_DEFAULT_EXTRACT_ROW_GROUP;
+    x->writer = argus_extract_writer_open(
+        stmt->extract_path, format, (int)stmt->extract_compression, group,
+        x->num_cols, names, x->types, err, sizeof(err));
+    free(names);
+    if (!x->writer) {
+        char msg[400];
+        snprintf(msg, sizeof(msg), "[Argus] Cannot start the extract: %s",
+                 err);
+        return argus_set_error(&stmt->diag, "HY000", msg, 0);
+    }
+    return SQL_SUCCESS;
+}
+
+SQLRETURN argus_extract_run(argus_stmt_t *stmt)
+{
+    gint64 start = g_get_monotonic_time();
+    stmt->extract_rows = 0;
+    stmt->extract_bytes = 0;
+    stmt->extract_ms = 0;
+
+    /* The first batch describes the result for backends that only know
+     * their columns once rows arrive */
+    if (!stmt->fetch_started) {
+        SQLRETURN rc = argus_fetch_batch(stmt);
+        if (rc != SQL_SUCCESS) return rc;
+        stmt->fetch_started = true;
+    }
+    if (stmt->num_cols <= 0)
+        return SQL_SUCCESS;             /* no result set: nothing to write */
+
+    extract_job_t x;
+    memset(&x, 0, sizeof(x));
+    g_mutex_init(&x.lock);
+    g_cond_init(&x.cond);
+    g_queue_init(&x.pending);
+
+    SQLRETURN ret = start_job(stmt, &x);
+    GThread *thread = NULL;
+    if (SQL_SUCCEEDED(ret)) {
+        GError *err = NULL;
+        thread = g_thread_try_new("argus-extract", writer_main, &x, &err);
+        if (!thread) {
+            char msg[300];
+            snprintf(msg, sizeof(msg),
+                     "[Argus] Cannot start the extract writer: %s",
+                     err->message);
+            g_error_free(err);
+            ret = argus_set_error(&stmt->diag, "HY000", msg, 0);
+        }
+    }
+
+    /* SQL_ATTR_MAX_ROWS bounds the extract as it bounds a fetch */
+    size_t limit = stmt->max_rows > 0 ? (size_t)stmt->max_rows : SIZE_MAX;
+    size_t taken = 0;
+    while (thread && taken < limit) {
+        extract_batch_t *b = take_rows(stmt, limit - taken);
+        if (!b && stmt->row_cache.current_row < stmt->row_cache.num_rows) {
+            ret = argus_set_error(&stmt->diag, "HY001",
+                                  "[Argus] Memory allocation failed", 0);
+            break;
+        }
+        if (b) {
+            taken += b->num_rows;
+            if (!queue_push(&x, b)) {
+                free_batch(b);
+                break;
+            }
+        }
+        if (stmt->row_cache.exhausted) break;
+        if (argus_stmt_cancelled(stmt)) {
+            argus_dbc_t *dbc = stmt->dbc;
+            if (dbc->backend->cancel)
+                dbc->backend->cancel(dbc->backend_conn, stmt->op);
+            ret = SQL_ERROR;
+            break;
+        }
+        ret = argus_fetch_batch(stmt);
+        if (ret != SQL_SUCCESS) break;
+    }
+
+    if (thread) {
+        queue_push(&x, NULL);
+        g_thread_join(thread);
+    }
+    if (x.writer) {
+        if (SQL_SUCCEEDED(ret) && !x.failed &&
+            argus_extract_writer_finish(x.writer) != 0) {
+            char msg[400];
+            snprintf(msg, sizeof(msg), "[Argus] Extract failed: %s",
+                     argus_extract_writer_error(x.writer));
+            job_fail(&x, "HY000", msg);
+        }
+        if (!SQL_SUCCEEDED(ret) || x.failed)
+            argus_extract_writer_discard(x.writer);
+        else {
+            stmt->extract_rows = (unsigned long)
+                argus_extract_writer_rows(x.writer);
+            stmt->extract_bytes = argus_extract_writer_bytes(x.writer);
+        }
+        argus_extract_writer_free(x.writer);
+    }
+    if (SQL_SUCCEEDED(ret) && x.failed)
+        ret = argus_set_error(&stmt->diag, x.sqlstate, x.error, 0);
+
+    free(x.types);
+    g_cond_clear(&x.cond);
+    g_mutex_clear(&x.lock);
+
+    /* The result now lives in the file: SQLRowCount reports what was
+     * written and SQLFetch finds nothing left */
+    argus_row_cache_clear(&stmt->row_cache);
+    stmt->row_cache.exhausted = true;
+    if (!SQL_SUCCEEDED(ret)) return ret;
+
+    stmt->extract_ms = (double)(g_get_monotonic_time() - start) / 1000.0;
+    stmt->row_count = (SQLLEN)stmt->extract_rows;
+    ARGUS_LOG_INFO("Extract: %lu rows, %llu bytes to %s in %.1f ms",
+                   stmt->extract_rows,
+                   (unsigned long long)stmt->extract_bytes,
+                   stmt->extract_path, stmt->extract_ms);
+    return SQL_SUCCESS;
+}
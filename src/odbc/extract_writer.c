@@ -0,0 +1,1101 @@
+/*
+ * extract_writer.c - Arrow IPC, Parquet and CSV file writers for extracts.
+ *
+ * See argus/extract.h. Rows are buffered column by column, in the layout an
+ * Arrow array uses (values, int32 offsets for text, one validity byte per
+ * row), and written out a row group at a time:
+ *
+ *   - Arrow IPC file format: "ARROW1", the schema message, one record batch
+ *     message per row group, the end-of-stream marker and the footer. The
+ *     flatbuffers are laid out front to back by the small builder below:
+ *     children follow their parent, so every offset points forward;
+ *   - Parquet: one row group per group, one PLAIN data page (v1) per column
+ *     chunk with RLE/bit-packed definition levels, optionally GZIP
+ *     compressed, and the thrift compact-encoded FileMetaData footer. Every
+ *     column is OPTIONAL: INT64, DOUBLE or BYTE_ARRAY annotated UTF8;
+ *   - CSV per RFC 4180: a header line, fields quoted when they have to be,
+ *     NULL as an empty field and the empty string as "". GZIP compresses the
+ *     whole file.
+ *
+ * Neither Arrow nor Parquet libraries are needed: the subset written here is
+ * small and fixed, and the tests decode both files back and compare every
+ * cell with the same query fetched through ODBC.
+ */
+
+#include "argus/extract.h"
+#include "argus/log.h"
+#include <gio/gio.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Text columns keep int32 offsets (Arrow) and Parquet page sizes are int32:
+ * a row group ends early once a column holds this much */
+#define EXTRACT_MAX_GROUP_BYTES (256U * 1024 * 1024)
+
+#define EXTRACT_OUT_BUFFER      (1024 * 1024)
+
+/* Arrow (Schema.fbs / Message.fbs) */
+#define ARROW_METADATA_V5       4
+#define ARROW_MSG_SCHEMA        1
+#define ARROW_MSG_RECORD_BATCH  3
+#define ARROW_TYPE_INT          2
+#define ARROW_TYPE_FLOAT        3
+#define ARROW_TYPE_UTF8         5
+#define ARROW_PRECISION_DOUBLE  2
+
+/* Parquet (parquet.thrift) */
+#define PQ_TYPE_INT64           2
+#define PQ_TYPE_DOUBLE          5
+#define PQ_TYPE_BYTE_ARRAY      6
+#define PQ_OPTIONAL             1
+#define PQ_CONVERTED_UTF8       0
+#define PQ_ENC_PLAIN            0
+#define PQ_ENC_RLE              3
+#define PQ_CODEC_NONE           0
+#define PQ_CODEC_GZIP           2
+#define PQ_PAGE_DATA            0
+
+/* Thrift compact protocol field types */
+#define TC_I32                  5
+#define TC_I64                  6
+#define TC_BINARY               8
+#define TC_LIST                 9
+#define TC_STRUCT               12
+
+typedef struct extract_col {
+    argus_extract_type_t type;
+    char        *name;
+    GByteArray  *values;    /* 8 bytes per row, or the UTF-8 text */
+    GByteArray  *offsets;   /* UTF8: int32 start of each row, then the end */
+    GByteArray  *valid;     /* one byte per row, 0 = NULL */
+    size_t       nulls;
+} extract_col_t;
+
+/* Where a Parquet column chunk went */
+typedef struct pq_chunk {
+    int64_t offset;
+    int64_t uncompressed;
+    int64_t compressed;
+} pq_chunk_t;
+
+/* An Arrow record batch, for the footer */
+typedef struct arrow_block {
+    int64_t offset;
+    int32_t meta_len;
+    int64_t body_len;
+} arrow_block_t;
+
+struct argus_extract_writer {
+    int              format;
+    int              compression;
+    size_t           group_rows;
+    int              num_cols;
+    extract_col_t   *cols;
+    size_t           rows;          /* in the open row group */
+    uint64_t         total_rows;
+
+    GFile           *file;
+    GFileOutputStream *file_out;
+    bool             existed;       /* path was there before: keep it */
+    GOutputStream   *out;           /* what the writer writes to */
+    uint64_t         offset;        /* bytes written through `out` */
+    uint64_t         bytes;         /* file size once finished */
+
+    GArray          *blocks;        /* Arrow: arrow_block_t */
+    GArray          *chunks;        /* Parquet: pq_chunk_t per column */
+    GArray          *group_sizes;   /* Parquet: rows per row group */
+    GConverter      *deflater;      /* Parquet GZIP pages */
+    GByteArray      *scratch;
+
+    bool             failed;
+    char             error[256];
+};
+
+static void writer_error(argus_extract_writer_t *w, const char *what,
+                         const GError *err)
+{
+    if (w->failed) return;
+    w->failed = true;
+    snprintf(w->error, sizeof(w->error), "%s%s%s", what,
+             err ? ": " : "", err ? err->message : "");
+    ARGUS_LOG_ERROR("Extract: %s", w->error);
+}
+
+/* ── Output ──────────────────────────────────────────────────── */
+
+static bool out_write(argus_extract_writer_t *w, const void *p, size_t n)
+{
+    if (w->failed) return false;
+    if (n == 0) return true;
+    GError *err = NULL;
+    if (!g_output_stream_write_all(w->out, p, n, NULL, NULL, &err)) {
+        writer_error(w, "Cannot write the extract file", err);
+        g_error_free(err);
+        return false;
+    }
+    w->offset += n;
+    return true;
+}
+
+static const guint8 zeros[8];
+
+/* Pad the file to a multiple of 8 bytes */
+static bool out_align8(argus_extract_writer_t *w)
+{
+    return out_write(w, zeros, (8 - w->offset % 8) % 8);
+}
+
+static void put_u16(GByteArray *b, guint16 v)
+{
+    v = GUINT16_TO_LE(v);
+    g_byte_array_append(b, (const guint8 *)&v, 2);
+}
+
+static void put_u32(GByteArray *b, guint32 v)
+{
+    v = GUINT32_TO_LE(v);
+    g_byte_array_append(b, (const guint8 *)&v, 4);
+}
+
+static void put_u64(GByteArray *b, guint64 v)
+{
+    v = GUINT64_TO_LE(v);
+    g_byte_array_append(b, (const guint8 *)&v, 8);
+}
+
+static void set_u32(GByteArray *b, size_t at, guint32 v)
+{
+    v = GUINT32_TO_LE(v);
+    memcpy(b->data + at, &v, 4);
+}
+
+/* ── Flatbuffers, built front to back ────────────────────────── */
+
+/* A scalar field of a table, or (size 4, linked afterwards) an offset */
+typedef struct fb_field {
+    int      id;
+    int      size;
+    uint64_t value;
+} fb_field_t;
+
+/* Pad so that len + extra is a multiple of align; returns the new length */
+static size_t fb_align(GByteArray *b, size_t align, size_t extra)
+{
+    while ((b->len + extra) % align)
+        g_byte_array_append(b, zeros, 1);
+    return b->len;
+}
+
+/* Point the offset at `slot` to `target`, which lies after it */
+static void fb_link(GByteArray *b, size_t slot, size_t target)
+{
+    set_u32(b, slot, (guint32)(target - slot));
+}
+
+/* Write a vtable and its table; slots[i] receives where field i went. The
+ * table starts 8-aligned and lays its fields out largest first, so each
+ * field is aligned to its size. Returns the table's position. */
+static size_t fb_table(GByteArray *b, const fb_field_t *f, int n,
+                       size_t *slots)
+{
+    size_t pos[16];
+    int nids = 0;
+    size_t size = 4;                        /* the vtable soffset */
+    for (int width = 8; width >= 1; width /= 2) {
+        for (int i = 0; i < n; i++) {
+            if (f[i].size != width) continue;
+            size = (size + (size_t)width - 1) / (size_t)width * (size_t)width;
+            pos[i] = size;
+            size += (size_t)width;
+        }
+    }
+    for (int i = 0; i < n; i++)
+        if (f[i].id + 1 > nids) nids = f[i].id + 1;
+
+    size_t vtable = fb_align(b, 2, 0);
+    put_u16(b, (guint16)(4 + 2 * nids));
+    put_u16(b, (guint16)size);
+    for (int id = 0; id < nids; id++) {
+        guint16 at = 0;
+        for (int i = 0; i < n; i++)
+            if (f[i].id == id) at = (guint16)pos[i];
+        put_u16(b, at);
+    }
+
+    size_t table = fb_align(b, 8, 0);
+    g_byte_array_set_size(b, (guint)(table + size));
+    memset(b->data + table, 0, size);
+    set_u32(b, table, (guint32)(table - vtable));
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < f[i].size; k++)
+            b->data[table + pos[i] + (size_t)k] = (guint8)(f[i].value >> (8 * k));
+        if (slots) slots[i] = table + pos[i];
+    }
+    return table;
+}
+
+/* A vector of n elements whose data starts `align`-aligned; elements are
+ * zero when `elems` is NULL (offsets linked afterwards). Returns the
+ * position of its length word. */
+static size_t fb_vector(GByteArray *b, const void *elems, size_t n,
+                        size_t elem_size, size_t align)
+{
+    size_t at = fb_align(b, align < 4 ? 4 : align, 4);
+    put_u32(b, (guint32)n);
+    size_t data = b->len;
+    g_byte_array_set_size(b, (guint)(data + n * elem_size));
+    if (elems)
+        memcpy(b->data + data, elems, n * elem_size);
+    else
+        memset(b->data + data, 0, n * elem_size);
+    return at;
+}
+
+static size_t fb_string(GByteArray *b, const char *s)
+{
+    size_t at = fb_align(b, 4, 0);
+    size_t len = strlen(s);
+    put_u32(b, (guint32)len);
+    g_byte_array_append(b, (const guint8 *)s, (guint)len + 1);
+    return at;
+}
+
+/* ── Arrow IPC ───────────────────────────────────────────────── */
+
+/* Schema table: one nullable field per column, no children */
+static size_t arrow_schema(GByteArray *b, const argus_extract_writer_t *w)
+{
+    size_t slot;
+    size_t schema = fb_table(b, (fb_field_t[]){ { 1, 4, 0 } }, 1, &slot);
+    size_t fields = fb_vector(b, NULL, (size_t)w->num_cols, 4, 4);
+    fb_link(b, slot, fields);
+
+    for (int c = 0; c < w->num_cols; c++) {
+        const extract_col_t *col = &w->cols[c];
+        guint8 type = col->type == ARGUS_EXTRACT_INT64 ? ARROW_TYPE_INT
+                    : col->type == ARGUS_EXTRACT_DOUBLE ? ARROW_TYPE_FLOAT
+                    : ARROW_TYPE_UTF8;
+        /* name, nullable, type_type, type, children */
+        fb_field_t ff[] = {
+            { 0, 4, 0 }, { 1, 1, 1 }, { 2, 1, type }, { 3, 4, 0 }, { 5, 4, 0 },
+        };
+        size_t s[5];
+        size_t field = fb_table(b, ff, 5, s);
+        fb_link(b, fields + 4 + 4 * (size_t)c, field);
+        fb_link(b, s[0], fb_string(b, col->name));
+
+        size_t t;
+        if (type == ARROW_TYPE_INT)
+            t = fb_table(b, (fb_field_t[]){ { 0, 4, 64 }, { 1, 1, 1 } }, 2,
+                         NULL);
+        else if (type == ARROW_TYPE_FLOAT)
+            t = fb_table(b, (fb_field_t[]){ { 0, 2, ARROW_PRECISION_DOUBLE } },
+                         1, NULL);
+        else
+            t = fb_table(b, NULL, 0, NULL);
+        fb_link(b, s[3], t);
+        fb_link(b, s[4], fb_vector(b, NULL, 0, 4, 4));
+    }
+    return schema;
+}
+
+/* Message flatbuffer with its header table; returns the header's slot */
+static size_t arrow_message(GByteArray *b, int header_type, int64_t body_len)
+{
+    put_u32(b, 0);                          /* root offset */
+    fb_field_t mf[] = {
+        { 0, 2, ARROW_METADATA_V5 }, { 1, 1, (uint64_t)header_type },
+        { 2, 4, 0 }, { 3, 8, (uint64_t)body_len },
+    };
+    size_t s[4];
+    fb_link(b, 0, fb_table(b, mf, 4, s));
+    return s[2];
+}
+
+/* Encapsulated message: continuation marker, metadata length, the
+ * flatbuffer padded to 8 bytes. The body follows. */
+static bool arrow_write_message(argus_extract_writer_t *w, GByteArray *b,
+                                int32_t *meta_len)
+{
+    fb_align(b, 8, 0);
+    guint8 prefix[8];
+    guint32 cont = GUINT32_TO_LE(0xFFFFFFFFU);
+    guint32 len = GUINT32_TO_LE(b->len);
+    memcpy(prefix, &cont, 4);
+    memcpy(prefix + 4, &len, 4);
+    if (meta_len) *meta_len = (int32_t)(8 + b->len);
+    return out_write(w, prefix, 8) && out_write(w, b->data, b->len);
+}
+
+static bool arrow_begin(argus_extract_writer_t *w)
+{
+    static const char magic[8] = "ARROW1\0";
+    if (!out_write(w, magic, 8)) return false;
+
+    GByteArray *b = w->scratch;
+    g_byte_array_set_size(b, 0);
+    size_t header = arrow_message(b, ARROW_MSG_SCHEMA, 0);
+    fb_link(b, header, arrow_schema(b, w));
+    return arrow_write_message(w, b, NULL);
+}
+
+/* Validity bitmap, LSB first, as Arrow and the Parquet levels want it */
+static void pack_validity(const extract_col_t *col, size_t rows,
+                          GByteArray *bits)
+{
+    g_byte_array_set_size(bits, (guint)((rows + 7) / 8));
+    memset(bits->data, 0, bits->len);
+    for (size_t r = 0; r < rows; r++)
+        if (col->valid->data[r]) bits->data[r / 8] |= (guint8)(1u << (r % 8));
+}
+
+static int64_t pad8(int64_t n)
+{
+    return (n + 7) & ~(int64_t)7;
+}
+
+static bool arrow_group(argus_extract_writer_t *w)
+{
+    size_t rows = w->rows;
+    int nbuf = 0;
+    for (int c = 0; c < w->num_cols; c++)
+        nbuf += w->cols[c].type == ARGUS_EXTRACT_UTF8 ? 3 : 2;
+
+    /* Body layout: per column the validity bitmap (empty without NULLs),
+     * the offsets for text, then the values, each padded to 8 bytes */
+    GByteArray *nodes = g_byte_array_new();
+    GByteArray *bufs = g_byte_array_new();
+    GByteArray *bits = g_byte_array_new();
+    int64_t body = 0;
+    for (int c = 0; c < w->num_cols; c++) {
+        const extract_col_t *col = &w->cols[c];
+        put_u64(nodes, rows);
+        put_u64(nodes, col->nulls);
+        int64_t vlen = col->nulls ? (int64_t)((rows + 7) / 8) : 0;
+        put_u64(bufs, (guint64)body);
+        put_u64(bufs, (guint64)vlen);
+        body += pad8(vlen);
+        if (col->type == ARGUS_EXTRACT_UTF8) {
+            put_u64(bufs, (guint64)body);
+            put_u64(bufs, col->offsets->len);
+            body += pad8(col->offsets->len);
+        }
+        put_u64(bufs, (guint64)body);
+        put_u64(bufs, col->values->len);
+        body += pad8(col->values->len);
+    }
+
+    GByteArray *b = w->scratch;
+    g_byte_array_set_size(b, 0);
+    size_t header = arrow_message(b, ARROW_MSG_RECORD_BATCH, body);
+    /* length, nodes, buffers */
+    fb_field_t rf[] = { { 0, 8, rows }, { 1, 4, 0 }, { 2, 4, 0 } };
+    size_t s[3];
+    fb_link(b, header, fb_table(b, rf, 3, s));
+    fb_link(b, s[1], fb_vector(b, nodes->data, (size_t)w->num_cols, 16, 8));
+    fb_link(b, s[2], fb_vector(b, bufs->data, (size_t)nbuf, 16, 8));
+
+    arrow_block_t block = { .offset = (int64_t)w->offset, .body_len = body };
+    bool ok = arrow_write_message(w, b, &block.meta_len);
+    for (int c = 0; ok && c < w->num_cols; c++) {
+        const extract_col_t *col = &w->cols[c];
+        if (col->nulls) {
+            pack_validity(col, rows, bits);
+            ok = out_write(w, bits->data, bits->len) && out_align8(w);
+        }
+        if (ok && col->type == ARGUS_EXTRACT_UTF8)
+            ok = out_write(w, col->offsets->data, col->offsets->len) &&
+                 out_align8(w);
+        if (ok)
+            ok = out_write(w, col->values->data, col->values->len) &&
+                 out_align8(w);
+    }
+    if (ok) g_array_append_val(w->blocks, block);
+
+    g_byte_array_unref(nodes);
+    g_byte_array_unref(bufs);
+    g_byte_array_unref(bits);
+    return ok;
+}
+
+static bool arrow_finish(argus_extract_writer_t *w)
+{
+    static const guint8 eos[8] = { 0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0 };
+    if (!out_write(w, eos, 8)) return false;
+
+    GByteArray *blocks = g_byte_array_new();
+    for (guint i = 0; i < w->blocks->len; i++) {
+        const arrow_block_t *k = &g_array_index(w->blocks, arrow_block_t, i);
+        put_u64(blocks, (guint64)k->offset);
+        put_u32(blocks, (guint32)k->meta_len);
+        put_u32(blocks, 0);
+        put_u64(blocks, (guint64)k->body_len);
+    }
+
+    /* Footer: version, schema, dictionaries, recordBatches */
+    GByteArray *b = w->scratch;
+    g_byte_array_set_size(b, 0);
+    put_u32(b, 0);
+    fb_field_t ff[] = {
+        { 0, 2, ARROW_METADATA_V5 }, { 1, 4, 0 }, { 2, 4, 0 }, { 3, 4, 0 },
+    };
+    size_t s[4];
+    fb_link(b, 0, fb_table(b, ff, 4, s));
+    fb_link(b, s[1], arrow_schema(b, w));
+    fb_link(b, s[2], fb_vector(b, NULL, 0, 24, 8));
+    fb_link(b, s[3], fb_vector(b, blocks->data, w->blocks->len, 24, 8));
+    g_byte_array_unref(blocks);
+
+    guint8 tail[10];
+    guint32 len = GUINT32_TO_LE(b->len);
+    memcpy(tail, &len, 4);
+    memcpy(tail + 4, "ARROW1", 6);
+    return out_write(w, b->data, b->len) && out_write(w, tail, 10);
+}
+
+/* ── Parquet ─────────────────────────────────────────────────── */
+
+/* Thrift compact protocol writer */
+typedef struct tc {
+    GByteArray *b;
+    int16_t     last[8];    /* last field id, per nesting level */
+    int         depth;
+} tc_t;
+
+static void tc_varint(GByteArray *b, uint64_t v)
+{
+    while (v >= 0x80) {
+        guint8 byte = (guint8)(v | 0x80);
+        g_byte_array_append(b, &byte, 1);
+        v >>= 7;
+    }
+    guint8 byte = (guint8)v;
+    g_byte_array_append(b, &byte, 1);
+}
+
+static uint64_t zigzag(int64_t v)
+{
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static void tc_field(tc_t *t, int16_t id, guint8 type)
+{
+    int delta = id - t->last[t->depth];
+    if (delta > 0 && delta <= 15) {
+        guint8 byte = (guint8)((delta << 4) | type);
+        g_byte_array_append(t->b, &byte, 1);
+    } else {
+        g_byte_array_append(t->b, &type, 1);
+        tc_varint(t->b, zigzag(id));
+    }
+    t->last[t->depth] = id;
+}
+
+static void tc_i32(tc_t *t, int16_t id, int32_t v)
+{
+    tc_field(t, id, TC_I32);
+    tc_varint(t->b, zigzag(v));
+}
+
+static void tc_i64(tc_t *t, int16_t id, int64_t v)
+{
+    tc_field(t, id, TC_I64);
+    tc_varint(t->b, zigzag(v));
+}
+
+static void tc_binary(GByteArray *b, const char *s)
+{
+    size_t len = strlen(s);
+    tc_varint(b, len);
+    g_byte_array_append(b, (const guint8 *)s, (guint)len);
+}
+
+static void tc_string(tc_t *t, int16_t id, const char *s)
+{
+    tc_field(t, id, TC_BINARY);
+    tc_binary(t->b, s);
+}
+
+static void tc_list(tc_t *t, int16_t id, guint8 elem_type, size_t n)
+{
+    tc_field(t, id, TC_LIST);
+    if (n < 15) {
+        guint8 byte = (guint8)((n << 4) | elem_type);
+        g_byte_array_append(t->b, &byte, 1);
+    } else {
+        guint8 byte = (guint8)(0xF0 | elem_type);
+        g_byte_array_append(t->b, &byte, 1);
+        tc_varint(t->b, n);
+    }
+}
+
+/* A struct: as field `id`, or as a list element when id is 0 */
+static void tc_begin(tc_t *t, int16_t id)
+{
+    if (id) tc_field(t, id, TC_STRUCT);
+    t->last[++t->depth] = 0;
+}
+
+static void tc_end(tc_t *t)
+{
+    guint8 stop = 0;
+    g_byte_array_append(t->b, &stop, 1);
+    t->depth--;
+}
+
+static guint8 pq_type(const extract_col_t *col)
+{
+    return col->type == ARGUS_EXTRACT_INT64 ? PQ_TYPE_INT64
+         : col->type == ARGUS_EXTRACT_DOUBLE ? PQ_TYPE_DOUBLE
+         : PQ_TYPE_BYTE_ARRAY;
+}
+
+static bool pq_begin(argus_extract_writer_t *w)
+{
+    return out_write(w, "PAR1", 4);
+}
+
+/* GZIP a page into w->scratch */
+static bool pq_deflate(argus_extract_writer_t *w, const GByteArray *in)
+{
+    if (!w->deflater)
+        w->deflater = G_CONVERTER(g_zlib_compressor_new(
+            G_ZLIB_COMPRESSOR_FORMAT_GZIP, -1));
+    g_converter_reset(w->deflater);
+
+    /* Room for incompressible data plus the gzip framing */
+    GByteArray *out = w->scratch;
+    g_byte_array_set_size(out, in->len + in->len / 8 + 64);
+    size_t in_done = 0, out_done = 0;
+    for (;;) {
+        gsize r = 0, n = 0;
+        GError *err = NULL;
+        GConverterResult res = g_converter_convert(
+            w->deflater, in->data + in_done, in->len - in_done,
+            out->data + out_done, out->len - out_done,
+            G_CONVERTER_INPUT_AT_END, &r, &n, &err);
+        if (res == G_CONVERTER_ERROR) {
+            writer_error(w, "Cannot compress a Parquet page", err);
+            g_error_free(err);
+            return false;
+        }
+        in_done += r;
+        out_done += n;
+        if (res == G_CONVERTER_FINISHED) break;
+        if (r == 0 && n == 0) {
+            writer_error(w, "Cannot compress a Parquet page", NULL);
+            return false;
+        }
+    }
+    g_byte_array_set_size(out, (guint)out_done);
+    return true;
+}
+
+/* One column chunk: a single data page holding the definition levels (one
+ * bit-packed run of the validity bits) and the PLAIN non-NULL values */
+static bool pq_column(argus_extract_writer_t *w, const extract_col_t *col,
+                      GByteArray *page, GByteArray *bits)
+{
+    size_t rows = w->rows;
+    g_byte_array_set_size(page, 0);
+
+    GByteArray *levels = g_byte_array_new();
+    pack_validity(col, rows, bits);
+    tc_varint(levels, (((rows + 7) / 8) << 1) | 1);
+    g_byte_array_append(levels, bits->data, bits->len);
+    put_u32(page, levels->len);
+    g_byte_array_append(page, levels->data, levels->len);
+    g_byte_array_unref(levels);
+
+    const guint32 *offs = (const guint32 *)col->offsets->data;
+    for (size_t r = 0; r < rows; r++) {
+        if (!col->valid->data[r]) continue;
+        if (col->type == ARGUS_EXTRACT_UTF8) {
+            guint32 start = GUINT32_FROM_LE(offs[r]);
+            guint32 end = GUINT32_FROM_LE(offs[r + 1]);
+            put_u32(page, end - start);
+            g_byte_array_append(page, col->values->data + start, end - start);
+        } else {
+            g_byte_array_append(page, col->values->data + r * 8, 8);
+        }
+    }
+
+    const GByteArray *data = page;
+    if (w->compression == ARGUS_EXTRACT_COMPRESS_GZIP) {
+        if (!pq_deflate(w, page)) return false;
+        data = w->scratch;
+    }
+
+    /* PageHeader { type, uncompressed_page_size, compressed_page_size,
+     *              data_page_header { num_values, encoding,
+     *                                 definition_level_encoding,
+     *                                 repetition_level_encoding } } */
+    GByteArray *hdr = g_byte_array_new();
+    tc_t t = { .b = hdr };
+    tc_i32(&t, 1, PQ_PAGE_DATA);
+    tc_i32(&t, 2, (int32_t)page->len);
+    tc_i32(&t, 3, (int32_t)data->len);
+    tc_begin(&t, 5);
+    tc_i32(&t, 1, (int32_t)rows);
+    tc_i32(&t, 2, PQ_ENC_PLAIN);
+    tc_i32(&t, 3, PQ_ENC_RLE);
+    tc_i32(&t, 4, PQ_ENC_RLE);
+    tc_end(&t);
+    g_byte_array_append(hdr, zeros, 1);     /* end of PageHeader */
+
+    pq_chunk_t chunk = {
+        .offset = (int64_t)w->offset,
+        .uncompressed = (int64_t)(hdr->len + page->len),
+        .compressed = (int64_t)(hdr->len + data->len),
+    };
+    bool ok = out_write(w, hdr->data, hdr->len) &&
+              out_write(w, data->data, data->len);
+    g_byte_array_unref(hdr);
+    if (ok) g_array_append_val(w->chunks, chunk);
+    return ok;
+}
+
+static bool pq_group(argus_extract_writer_t *w)
+{
+    GByteArray *page = g_byte_array_new();
+    GByteArray *bits = g_byte_array_new();
+    bool ok = true;
+    for (int c = 0; ok && c < w->num_cols; c++)
+        ok = pq_column(w, &w->cols[c], page, bits);
+    g_byte_array_unref(page);
+    g_byte_array_unref(bits);
+    if (ok) {
+        int64_t rows = (int64_t)w->rows;
+        g_array_append_val(w->group_sizes, rows);
+    }
+    return ok;
+}
+
+static bool pq_finish(argus_extract_writer_t *w)
+{
+    GByteArray *b = w->scratch;
+    g_byte_array_set_size(b, 0);
+    tc_t t = { .b = b };
+
+    /* FileMetaData { version, schema, num_rows, row_groups, created_by } */
+    tc_i32(&t, 1, 1);
+    tc_list(&t, 2, TC_STRUCT, (size_t)w->num_cols + 1);
+    tc_begin(&t, 0);
+    tc_string(&t, 4, "schema");
+    tc_i32(&t, 5, w->num_cols);
+    tc_end(&t);
+    for (int c = 0; c < w->num_cols; c++) {
+        const extract_col_t *col = &w->cols[c];
+        tc_begin(&t, 0);
+        tc_i32(&t, 1, pq_type(col));
+        tc_i32(&t, 3, PQ_OPTIONAL);
+        tc_string(&t, 4, col->name);
+        if (col->type == ARGUS_EXTRACT_UTF8) {
+            tc_i32(&t, 6, PQ_CONVERTED_UTF8);
+            tc_begin(&t, 10);               /* logicalType: STRING */
+            tc_begin(&t, 1);
+            tc_end(&t);
+            tc_end(&t);
+        }
+        tc_end(&t);
+    }
+    tc_i64(&t, 3, (int64_t)w->total_rows);
+
+    tc_list(&t, 4, TC_STRUCT, w->group_sizes->len);
+    for (guint g = 0; g < w->group_sizes->len; g++) {
+        int64_t rows = g_array_index(w->group_sizes, int64_t, g);
+        int64_t group_bytes = 0, group_compressed = 0;
+        tc_begin(&t, 0);
+        tc_list(&t, 1, TC_STRUCT, (size_t)w->num_cols);
+        for (int c = 0; c < w->num_cols; c++) {
+            const extract_col_t *col = &w->cols[c];
+            const pq_chunk_t *k = &g_array_index(
+                w->chunks, pq_chunk_t, g * (guint)w->num_cols + (guint)c);
+            group_bytes += k->uncompressed;
+            group_compressed += k->compressed;
+            /* ColumnChunk { file_offset, meta_data { type, encodings,
+             *   path_in_schema, codec, num_values, total_uncompressed_size,
+             *   total_compressed_size, data_page_offset } } */
+            tc_begin(&t, 0);
+            tc_i64(&t, 2, k->offset);
+            tc_begin(&t, 3);
+            tc_i32(&t, 1, pq_type(col));
+            tc_list(&t, 2, TC_I32, 2);
+            tc_varint(b, zigzag(PQ_ENC_PLAIN));
+            tc_varint(b, zigzag(PQ_ENC_RLE));
+            tc_list(&t, 3, TC_BINARY, 1);
+            tc_binary(b, col->name);
+            tc_i32(&t, 4, w->compression == ARGUS_EXTRACT_COMPRESS_GZIP
+                          ? PQ_CODEC_GZIP : PQ_CODEC_NONE);
+            tc_i64(&t, 5, rows);
+            tc_i64(&t, 6, k->uncompressed);
+            tc_i64(&t, 7, k->compressed);
+            tc_i64(&t, 9, k->offset);
+            tc_end(&t);
+            tc_end(&t);
+        }
+        tc_i64(&t, 2, group_bytes);
+        tc_i64(&t, 3, rows);
+        tc_i64(&t, 6, group_compressed);
+        tc_end(&t);
+    }
+    tc_string(&t, 6, "Argus ODBC driver");
+    g_byte_array_append(b, zeros, 1);       /* end of FileMetaData */
+
+    guint8 tail[8];
+    guint32 len = GUINT32_TO_LE(b->len);
+    memcpy(tail, &len, 4);
+    memcpy(tail + 4, "PAR1", 4);
+    return out_write(w, b->data, b->len) && out_write(w, tail, 8);
+}
+
+/* ── CSV ─────────────────────────────────────────────────────── */
+
+static void csv_field(GByteArray *line, const char *s, size_t len)
+{
+    bool quote = len == 0;
+    for (size_t i = 0; i < len && !quote; i++)
+        quote = s[i] == ',' || s[i] == '"' || s[i] == '\r' || s[i] == '\n';
+    if (!quote) {
+        g_byte_array_append(line, (const guint8 *)s, (guint)len);
+        return;
+    }
+    g_byte_array_append(line, (const guint8 *)"\"", 1);
+    for (size_t i = 0; i < len; i++) {
+        if (s[i] == '"') g_byte_array_append(line, (const guint8 *)"\"", 1);
+        g_byte_array_append(line, (const guint8 *)&s[i], 1);
+    }
+    g_byte_array_append(line, (const guint8 *)"\"", 1);
+}
+
+static bool csv_begin(argus_extract_writer_t *w)
+{
+    GByteArray *line = w->scratch;
+    g_byte_array_set_size(line, 0);
+    for (int c = 0; c < w->num_cols; c++) {
+        if (c) g_byte_array_append(line, (const guint8 *)",", 1);
+        csv_field(line, w->cols[c].name, strlen(w->cols[c].name));
+    }
+    g_byte_array_append(line, (const guint8 *)"\r\n", 2);
+    return out_write(w, line->data, line->len);
+}
+
+static bool csv_group(argus_extract_writer_t *w)
+{
+    GByteArray *out = w->scratch;
+    g_byte_array_set_size(out, 0);
+    for (size_t r = 0; r < w->rows; r++) {
+        for (int c = 0; c < w->num_cols; c++) {
+            const extract_col_t *col = &w->cols[c];
+            if (c) g_byte_array_append(out, (const guint8 *)",", 1);
+            if (!col->valid->data[r]) continue;
+
+            char num[G_ASCII_DTOSTR_BUF_SIZE];
+            if (col->type == ARGUS_EXTRACT_INT64) {
+                gint64 v;
+                memcpy(&v, col->values->data + r * 8, 8);
+                int n = snprintf(num, sizeof(num), "%" G_GINT64_FORMAT,
+                                 (gint64)GINT64_FROM_LE(v));
+                g_byte_array_append(out, (const guint8 *)num, (guint)n);
+            } else if (col->type == ARGUS_EXTRACT_DOUBLE) {
+                guint64 bits;
+                double v;
+                memcpy(&bits, col->values->data + r * 8, 8);
+                bits = GUINT64_FROM_LE(bits);
+                memcpy(&v, &bits, 8);
+                g_ascii_dtostr(num, sizeof(num), v);
+                g_byte_array_append(out, (const guint8 *)num,
+                                    (guint)strlen(num));
+            } else {
+                const guint32 *offs = (const guint32 *)col->offsets->data;
+                guint32 start = GUINT32_FROM_LE(offs[r]);
+                guint32 end = GUINT32_FROM_LE(offs[r + 1]);
+                csv_field(out, (const char *)col->values->data + start,
+                          end - start);
+            }
+        }
+        g_byte_array_append(out, (const guint8 *)"\r\n", 2);
+    }
+    return out_write(w, out->data, out->len);
+}
+
+/* ── Row groups ──────────────────────────────────────────────── */
+
+static void cols_reset(argus_extract_writer_t *w)
+{
+    for (int c = 0; c < w->num_cols; c++) {
+        extract_col_t *col = &w->cols[c];
+        g_byte_array_set_size(col->values, 0);
+        g_byte_array_set_size(col->valid, 0);
+        g_byte_array_set_size(col->offsets, 0);
+        if (col->type == ARGUS_EXTRACT_UTF8) put_u32(col->offsets, 0);
+        col->nulls = 0;
+    }
+    w->rows = 0;
+}
+
+static bool write_group(argus_extract_writer_t *w)
+{
+    if (w->rows == 0) return true;
+    bool ok;
+    switch (w->format) {
+    case ARGUS_EXTRACT_FORMAT_PARQUET: ok = pq_group(w); break;
+    case ARGUS_EXTRACT_FORMAT_CSV:     ok = csv_group(w); break;
+    default:                           ok = arrow_group(w); break;
+    }
+    cols_reset(w);
+    return ok;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+int argus_extract_format_for(const char *path)
+{
+    if (!path) return ARGUS_EXTRACT_FORMAT_ARROW;
+    const char *ext = strrchr(path, '.');
+    if (ext && g_ascii_strcasecmp(ext, ".gz") == 0) {
+        size_t stem = (size_t)(ext - path);
+        if (stem >= 4 && g_ascii_strncasecmp(ext - 4, ".csv", 4) == 0)
+            return ARGUS_EXTRACT_FORMAT_CSV;
+    }
+    if (ext && g_ascii_strcasecmp(ext, ".parquet") == 0)
+        return ARGUS_EXTRACT_FORMAT_PARQUET;
+    if (ext && g_ascii_strcasecmp(ext, ".csv") == 0)
+        return ARGUS_EXTRACT_FORMAT_CSV;
+    return ARGUS_EXTRACT_FORMAT_ARROW;
+}
+
+argus_extract_writer_t *argus_extract_writer_open(
+    const char *path, int format, int compression, size_t row_group_rows,
+    int num_cols, const char *const *names, const argus_extract_type_t *types,
+    char *err, size_t err_len)
+{
+    if (format == ARGUS_EXTRACT_FORMAT_AUTO)
+        format = argus_extract_format_for(path);
+
+    argus_extract_writer_t *w = calloc(1, sizeof(*w));
+    if (!w) {
+        snprintf(err, err_len, "Memory allocation failed");
+        return NULL;
+    }
+    w->format = format;
+    w->compression = compression;
+    w->group_rows = row_group_rows > 0 ? row_group_rows : 1;
+    w->num_cols = num_cols;
+    w->cols = calloc((size_t)(num_cols > 0 ? num_cols : 1), sizeof(*w->cols));
+    w->blocks = g_array_new(FALSE, FALSE, sizeof(arrow_block_t));
+    w->chunks = g_array_new(FALSE, FALSE, sizeof(pq_chunk_t));
+    w->group_sizes = g_array_new(FALSE, FALSE, sizeof(int64_t));
+    w->scratch = g_byte_array_new();
+    if (!w->cols) {
+        snprintf(err, err_len, "Memory allocation failed");
+        argus_extract_writer_free(w);
+        return NULL;
+    }
+    for (int c = 0; c < num_cols; c++) {
+        extract_col_t *col = &w->cols[c];
+        col->type = types[c];
+        col->name = g_strdup(names[c] ? names[c] : "");
+        col->values = g_byte_array_new();
+        col->offsets = g_byte_array_new();
+        col->valid = g_byte_array_new();
+    }
+    cols_reset(w);
+
+    GError *gerr = NULL;
+    w->file = g_file_new_for_path(path);
+    w->existed = g_file_query_exists(w->file, NULL);
+    w->file_out = g_file_replace(w->file, NULL, FALSE,
+                                 G_FILE_CREATE_REPLACE_DESTINATION, NULL,
+                                 &gerr);
+    if (!w->file_out) {
+        snprintf(err, err_len, "Cannot create %s: %s", path, gerr->message);
+        g_error_free(gerr);
+        argus_extract_writer_free(w);
+        return NULL;
+    }
+    w->out = g_buffered_output_stream_new_sized(
+        G_OUTPUT_STREAM(w->file_out), EXTRACT_OUT_BUFFER);
+    if (format == ARGUS_EXTRACT_FORMAT_CSV &&
+        compression == ARGUS_EXTRACT_COMPRESS_GZIP) {
+        GZlibCompressor *gz = g_zlib_compressor_new(
+            G_ZLIB_COMPRESSOR_FORMAT_GZIP, -1);
+        GOutputStream *zout = g_converter_output_stream_new(
+            w->out, G_CONVERTER(gz));
+        g_object_unref(gz);
+        g_object_unref(w->out);
+        w->out = zout;
+    }
+
+    bool ok;
+    switch (format) {
+    case ARGUS_EXTRACT_FORMAT_PARQUET: ok = pq_begin(w); break;
+    case ARGUS_EXTRACT_FORMAT_CSV:     ok = csv_begin(w); break;
+    default:                           ok = arrow_begin(w); break;
+    }
+    if (!ok) {
+        snprintf(err, err_len, "%s", w->error);
+        argus_extract_writer_discard(w);
+        argus_extract_writer_free(w);
+        return NULL;
+    }
+    return w;
+}
+
+static void cell_valid(extract_col_t *col, bool valid)
+{
+    guint8 v = valid ? 1 : 0;
+    g_byte_array_append(col->valid, &v, 1);
+    if (!valid) col->nulls++;
+}
+
+void argus_extract_writer_null(argus_extract_writer_t *w, int col)
+{
+    extract_col_t *c = &w->cols[col];
+    cell_valid(c, false);
+    if (c->type == ARGUS_EXTRACT_UTF8)
+        put_u32(c->offsets, c->values->len);
+    else
+        g_byte_array_append(c->values, zeros, 8);
+}
+
+void argus_extract_writer_i64(argus_extract_writer_t *w, int col, int64_t v)
+{
+    extract_col_t *c = &w->cols[col];
+    if (c->type == ARGUS_EXTRACT_DOUBLE) {
+        argus_extract_writer_f64(w, col, (double)v);
+        return;
+    }
+    if (c->type == ARGUS_EXTRACT_UTF8) {
+        char num[24];
+        int n = snprintf(num, sizeof(num), "%" G_GINT64_FORMAT, (gint64)v);
+        argus_extract_writer_text(w, col, num, (size_t)n);
+        return;
+    }
+    cell_valid(c, true);
+    put_u64(c->values, (guint64)v);
+}
+
+void argus_extract_writer_f64(argus_extract_writer_t *w, int col, double v)
+{
+    extract_col_t *c = &w->cols[col];
+    if (c->type == ARGUS_EXTRACT_UTF8) {
+        char num[G_ASCII_DTOSTR_BUF_SIZE];
+        g_ascii_dtostr(num, sizeof(num), v);
+        argus_extract_writer_text(w, col, num, strlen(num));
+        return;
+    }
+    if (c->type == ARGUS_EXTRACT_INT64) {
+        argus_extract_writer_i64(w, col, (int64_t)v);
+        return;
+    }
+    guint64 bits;
+    memcpy(&bits, &v, 8);
+    cell_valid(c, true);
+    put_u64(c->values, bits);
+}
+
+void argus_extract_writer_text(argus_extract_writer_t *w, int col,
+                               const char *s, size_t len)
+{
+    extract_col_t *c = &w->cols[col];
+    cell_valid(c, true);
+    g_byte_array_append(c->values, (const guint8 *)s, (guint)len);
+    put_u32(c->offsets, c->values->len);
+}
+
+int argus_extract_writer_end_row(argus_extract_writer_t *w)
+{
+    if (w->failed) return -1;
+    w->rows++;
+    w->total_rows++;
+    bool full = w->rows >= w->group_rows;
+    for (int c = 0; c < w->num_cols && !full; c++)
+        full = w->cols[c].values->len >= EXTRACT_MAX_GROUP_BYTES;
+    if (full && !write_group(w)) return -1;
+    return 0;
+}
+
+int argus_extract_writer_finish(argus_extract_writer_t *w)
+{
+    bool ok = !w->failed && write_group(w);
+    if (ok) {
+        switch (w->format) {
+        case ARGUS_EXTRACT_FORMAT_PARQUET: ok = pq_finish(w); break;
+        case ARGUS_EXTRACT_FORMAT_CSV:     ok = true; break;
+        default:                           ok = arrow_finish(w); break;
+        }
+    }
+    if (!ok) {
+        argus_extract_writer_discard(w);
+        return -1;
+    }
+
+    /* Closing the outer stream flushes the compressor and buffer and closes
+     * the file, renaming it into place when it replaced one */
+    GError *err = NULL;
+    if (!g_output_stream_close(w->out, NULL, &err)) {
+        writer_error(w, "Cannot write the extract file", err);
+        g_error_free(err);
+        argus_extract_writer_discard(w);
+        return -1;
+    }
+    GFileInfo *info = g_file_query_info(w->file, G_FILE_ATTRIBUTE_STANDARD_SIZE,
+                                        G_FILE_QUERY_INFO_NONE, NULL, NULL);
+    w->bytes = info ? (uint64_t)g_file_info_get_size(info) : w->offset;
+    if (info) g_object_unref(info);
+    return 0;
+}
+
+void argus_extract_writer_discard(argus_extract_writer_t *w)
+{
+    if (!w->out) return;
+    /* A cancelled close leaves a file being replaced as it was; a new one
+     * is removed */
+    GCancellable *cancel = g_cancellable_new();
+    g_cancellable_cancel(cancel);
+    g_output_stream_close(w->out, cancel, NULL);
+    g_object_unref(cancel);
+    if (!w->existed)
+        g_file_delete(w->file, NULL, NULL);
+    g_object_unref(w->out);
+    w->out = NULL;
+}
+
+uint64_t argus_extract_writer_rows(const argus_extract_writer_t *w)
+{
+    return w->total_rows;
+}
+
+uint64_t argus_extract_writer_bytes(const argus_extract_writer_t *w)
+{
+    return w->bytes ? w->bytes : w->offset;
+}
+
+const char *argus_extract_writer_error(const argus_extract_writer_t *w)
+{
+    return w->error;
+}
+
+void argus_extract_writer_free(argus_extract_writer_t *w)
+{
+    if (!w) return;
+    if (w->out) g_object_unref(w->out);
+    if (w->file_out) g_object_unref(w->file_out);
+    if (w->file) g_object_unref(w->file);
+    for (int c = 0; w->cols && c < w->num_cols; c++) {
+        g_free(w->cols[c].name);
+        if (w->cols[c].values) g_byte_array_unref(w->cols[c].values);
+        if (w->cols[c].offsets) g_byte_array_unref(w->cols[c].offsets);
+        if (w->cols[c].valid) g_byte_array_unref(w->cols[c].valid);
+    }
+    free(w->cols);
+    g_array_unref(w->blocks);
+    g_array_unref(w->chunks);
+    g_array_unref(w->group_sizes);
+    g_byte_array_unref(w->scratch);
+    if (w->deflater) g_object_unref(w->deflater);
+    free(w);
+}
@@ -31,7 +31,7 @@ static void free_row(argus_row_t *row, int num_cols)
 
 void argus_row_cache_free(argus_row_cache_t *cache)
 {
-    if (cache->rows) {
+    if (cache->rows && !cache->borrowed) {
         for (size_t i = 0; i < cache->num_rows; i++) {
             free_row(&cache->rows[i], cache->num_cols);
         }
@@ -42,7 +42,12 @@ void argus_row_cache_free(argus_row_cache_t *cache)
 
 void argus_row_cache_clear(argus_row_cache_t *cache)
 {
-    if (cache->rows) {
+    if (cache->borrowed) {
+        /* The rows belong to a shared cache entry: just let go of them */
+        cache->rows     = NULL;
+        cache->capacity = 0;
+        cache->borrowed = false;
+    } else if (cache->rows) {
         for (size_t i = 0; i < cache->num_rows; i++) {
             free_row(&cache->rows[i], cache->num_cols);
         }
@@ -52,9 +57,130 @@ void argus_row_cache_clear(argus_row_cache_t *cache)
     /* Keep allocated capacity, num_cols, and exhausted flag */
 }
 
+int argus_row_copy(argus_row_t *dst, const argus_row_t *src, int num_cols)
+{
+    dst->cells = NULL;
+    if (!src->cells) return 0;
+
+    argus_cell_t *cells = malloc((size_t)num_cols * sizeof(argus_cell_t));
+    if (!cells) return -1;
+    memcpy(cells, src->cells, (size_t)num_cols * sizeof(argus_cell_t));
+    for (int c = 0; c < num_cols; c++) {
+        const argus_cell_t *cell = &src->cells[c];
+        if (!cell->data) continue;
+        cells[c].data = malloc(cell->data_len + 1);
+        if (!cells[c].data) {
+            for (int k = 0; k < c; k++) free(cells[k].data);
+            free(cells);
+            return -1;
+        }
+        memcpy(cells[c].data, cell->data, cell->data_len);
+        cells[c].data[cell->data_len] = '\0';
+    }
+    dst->cells = cells;
+    return 0;
+}
+
+/* ── Adaptive batch sizing ────────────────────────────────────── */
+
+/*
+ * No fixed batch size suits every result: wide rows make FETCHBUFFERSIZE rows
+ * hold hundreds of megabytes, narrow rows spend the fetch on round trips.
+ * Each result starts at FETCHBUFFERSIZE (or the application's preset) and,
+ * after every batch, sizes the next request to the smaller of
+ * FETCHTARGETBYTES worth of rows and FETCHTARGETMS worth of rows at the
+ * rates seen so far. A request at most doubles from one batch to the next,
+ * since the time per row of a small batch still carries the round trip's
+ * fixed cost; it shrinks at once. The bounds are widened to include the
+ * starting size.
+ */
+
+#define FETCH_SIZER_SAMPLE 32       /* rows measured per batch */
+
+void argus_fetch_sizer_init(argus_fetch_sizer_t *fs, const argus_dbc_t *dbc)
+{
+    memset(fs, 0, sizeof(*fs));
+    fs->rows = dbc->fetch_buffer_size > 0 ? dbc->fetch_buffer_size
+                                          : ARGUS_DEFAULT_BATCH_SIZE;
+    fs->min_rows = dbc->fetch_min_rows > 0 ? dbc->fetch_min_rows : 1;
+    fs->max_rows = dbc->fetch_max_rows > 0 ? dbc->fetch_max_rows
+                                           : ARGUS_DEFAULT_FETCH_MAX_ROWS;
+    if (fs->min_rows > fs->rows) fs->min_rows = fs->rows;
+    if (fs->max_rows < fs->rows) fs->max_rows = fs->rows;
+}
+
+static double sizer_smooth(double avg, double sample)
+{
+    return avg > 0 ? (avg + sample) / 2.0 : sample;
+}
+
+void argus_fetch_sizer_observe(argus_fetch_sizer_t *fs, const argus_dbc_t *dbc,
+                               size_t rows, size_t bytes, int64_t elapsed_us)
+{
+    if (!dbc->adaptive_fetch || rows == 0) return;
+    fs->row_bytes = sizer_smooth(fs->row_bytes, (double)bytes / (double)rows);
+    if (elapsed_us > 0)
+        fs->row_us = sizer_smooth(fs->row_us,
+                                  (double)elapsed_us / (double)rows);
+
+    double want = 2.0 * fs->rows;
+    if (dbc->fetch_target_bytes > 0 && fs->row_bytes > 0)
+        want = fmin(want, (double)dbc->fetch_target_bytes / fs->row_bytes);
+    if (dbc->fetch_target_ms > 0 && fs->row_us > 0)
+        want = fmin(want, dbc->fetch_target_ms * 1000.0 / fs->row_us);
+    if (want < fs->min_rows) want = fs->min_rows;
+    if (want > fs->max_rows) want = fs->max_rows;
+    fs->rows = (int)want;
+}
+
+/* Decoded size of a batch, estimated from up to FETCH_SIZER_SAMPLE rows */
+static size_t batch_bytes(const argus_row_cache_t *rc, int num_cols)
+{
+    size_t n = rc->num_rows;
+    if (n == 0) return 0;
+    if (rc->num_cols > 0) num_cols = rc->num_cols;
+    size_t step = n > FETCH_SIZER_SAMPLE ? n / FETCH_SIZER_SAMPLE : 1;
+    size_t sampled = 0, bytes = 0;
+    for (size_t r = 0; r < n; r += step, sampled++) {
+        const argus_row_t *row = &rc->rows[r];
+        bytes += sizeof(argus_row_t);
+        if (!row->cells) continue;
+        bytes += (size_t)num_cols * sizeof(argus_cell_t);
+        for (int c = 0; c < num_cols; c++) {
+            if (row->cells[c].data) bytes += row->cells[c].data_len + 1;
+        }
+    }
+    return (size_t)((double)bytes / (double)sampled * (double)n);
+}
+
 /* ── Internal: fetch a batch from backend ─────────────────────── */
 
-static SQLRETURN fetch_batch(argus_stmt_t *stmt)
+/* One fetch_results call, which SQLCancel and SQL_ATTR_QUERY_TIMEOUT can
+ * interrupt (see argus/cancel.h). A cancelled call fails with HY008/HYT00
+ * already set and the query cancelled on the server. */
+static int backend_fetch(argus_stmt_t *stmt, int batch_size, int *num_cols)
+{
+    argus_dbc_t *dbc = stmt->dbc;
+    /* Inside an execute (an extract) the execute's arming covers it */
+    bool nested = argus_cancel_armed(&stmt->cancel);
+    if (!nested)
+        argus_cancel_begin(&stmt->cancel, (long)stmt->query_timeout);
+    argus_cancel_t *prev = argus_cancel_enter(&stmt->cancel);
+    int rc = dbc->backend->fetch_results(
+        dbc->backend_conn, stmt->op,
+        batch_size,
+        &stmt->row_cache,
+        stmt->columns, num_cols);
+    argus_cancel_leave(prev);
+    /* Stop the rest of the result being produced for nobody */
+    if (rc != 0 && argus_stmt_cancelled(stmt) && dbc->backend->cancel)
+        dbc->backend->cancel(dbc->backend_conn, stmt->op);
+    if (!nested)
+        argus_cancel_end(&stmt->cancel);
+    return rc;
+}
+
+SQLRETURN argus_fetch_batch(argus_stmt_t *stmt)
 {
     argus_dbc_t *dbc = stmt->dbc;
     if (!dbc || !dbc->backend || !dbc->backend_conn) {
@@ -64,26 +190,55 @@ static SQLRETURN fetch_batch(argus_stmt_t *stmt)
 
     argus_row_cache_clear(&stmt->row_cache);
 
-    /* Use fetch_buffer_size if set, otherwise use default */
-    int batch_size = (dbc->fetch_buffer_size > 0)
-                     ? dbc->fetch_buffer_size
-                     : ARGUS_DEFAULT_BATCH_SIZE;
+    /* A new result starts over from the configured batch size */
+    argus_stmt_timing_t *t = &stmt->timing;
+    argus_fetch_sizer_t *fs = &stmt->fetch_sizer;
+    if (t->batches == 0 || fs->rows <= 0)
+        argus_fetch_sizer_init(fs, dbc);
+    int batch_size = fs->rows;
+
+    double network_before = t->network_ms;
+    argus_span_t *span = argus_trace_child(dbc->tracer, &stmt->trace_ctx,
+                                           "fetch");
+    argus_span_t *prev_span = argus_trace_enter(span);
 
     int num_cols = 0;
-    int rc = dbc->backend->fetch_results(
-        dbc->backend_conn, stmt->op,
-        batch_size,
-        &stmt->row_cache,
-        stmt->columns, &num_cols);
+    gint64 fetch_start = g_get_monotonic_time();
+    int rc = backend_fetch(stmt, batch_size, &num_cols);
+    gint64 fetch_end = g_get_monotonic_time();
+
+    argus_trace_leave(prev_span);
+    t->fetch_ms += (double)(fetch_end - fetch_start) / 1000.0;
+    t->batches++;
+    argus_stmt_timing_progress(stmt);
 
     if (rc != 0) {
         if (stmt->diag.count == 0) {
             argus_set_error(&stmt->diag, "HY000",
                             "[Argus] Failed to fetch results", 0);
         }
+        argus_trace_end(span, argus_diag_sqlstate(&stmt->diag));
         return SQL_ERROR;
     }
 
+    if (span) {
+        /* Decode is the batch less its wait on the server, as in the
+         * DECODE phase of the metrics; unknown when the backend does not
+         * track the wait */
+        argus_trace_attr_int(span, "argus.rows", stmt->row_cache.num_rows);
+        argus_trace_attr_int(span, "argus.requested_rows", batch_size);
+        if (t->network_ms >= 0) {
+            gint64 wait_us = (gint64)((t->network_ms -
+                                       (network_before > 0 ? network_before
+                                                           : 0.0)) * 1000.0);
+            gint64 decode_us = (fetch_end - fetch_start) - wait_us;
+            argus_trace_attr_int(span, "argus.network_us", wait_us);
+            argus_trace_attr_int(span, "argus.decode_us",
+                                 decode_us > 0 ? decode_us : 0);
+        }
+        argus_trace_end(span, NULL);
+    }
+
     if (num_cols > 0 && !stmt->metadata_fetched) {
         if (argus_stmt_ensure_columns(stmt, num_cols) != 0)
             return SQL_ERROR;
@@ -91,16 +246,32 @@ static SQLRETURN fetch_batch(argus_stmt_t *stmt)
         stmt->metadata_fetched = true;
     }
 
+    /* Size the next request. The first batch's time includes the query
+     * still running, so only its bytes count. */
+    if (dbc->adaptive_fetch && stmt->row_cache.num_rows > 0) {
+        argus_fetch_sizer_observe(fs, dbc, stmt->row_cache.num_rows,
+                                  batch_bytes(&stmt->row_cache,
+                                              stmt->num_cols),
+                                  t->batches > 1 ? fetch_end - fetch_start
+                                                 : -1);
+    }
+
     if (stmt->row_cache.num_rows == 0) {
         stmt->row_cache.exhausted = true;
+    } else {
+        t->cells += (unsigned long)stmt->row_cache.num_rows *
+                    (unsigned long)stmt->num_cols;
+        if (t->first_row_ms < 0 && t->start_us > 0)
+            t->first_row_ms = (double)(fetch_end - t->start_us) / 1000.0;
     }
 
+    argus_result_cache_capture(stmt);
     return SQL_SUCCESS;
 }
 
-/* ── Internal: convert cell to target type ────────────────────── */
+/* ── Convert cell to target type ──────────────────────────────── */
 
-static SQLRETURN convert_cell_to_target(
+SQLRETURN argus_convert_cell(
     const argus_cell_t *cell,
     SQLSMALLINT target_type,
     SQLPOINTER target_value,
@@ -177,8 +348,8 @@ static SQLRETURN convert_cell_to_target(
             tc.data_len = (n > 0) ? (size_t)n : 0;
             tc.is_null = false;
             tc.native_kind = ARGUS_NATIVE_NONE;
-            return convert_cell_to_target(&tc, target_type, target_value,
-                                          buffer_length, str_len_or_ind, diag);
+            return argus_convert_cell(&tc, target_type, target_value,
+                                      buffer_length, str_len_or_ind, diag);
         }
     }
 
@@ -792,129 +963,83 @@ static SQLRETURN convert_cell_to_target(
     }
 }
 
-/* ── Internal: build full scroll cache for static cursors ─────── */
+/* ── Internal: read a static cursor's result into its store ──── */
 
-static SQLRETURN build_scroll_cache(argus_stmt_t *stmt)
+/*
+ * Read batches into the scroll store until it holds `upto` rows or the whole
+ * result (SIZE_MAX). Rows are moved out of the row cache one batch at a time,
+ * so a result replayed from the result or metadata cache — complete in the
+ * row cache already — goes through the same path.
+ *
+ * A static cursor buffers what it has read, so the store is bounded: past
+ * MaxScrollBytes (or the optional MaxScrollRows) fail cleanly with an
+ * actionable diagnostic rather than fill the disk. Rows of a batch that did
+ * not fit stay in the row cache, so the next call fails the same way.
+ */
+static SQLRETURN scroll_fill(argus_stmt_t *stmt, size_t upto)
 {
-    if (stmt->scroll_cached) return SQL_SUCCESS;
-
     argus_dbc_t *dbc = stmt->dbc;
-    if (!dbc || !dbc->backend || !dbc->backend_conn) {
-        return argus_set_error(&stmt->diag, "HY000",
-                               "[Argus] No backend connection", 0);
-    }
+    argus_row_cache_t *cache = &stmt->row_cache;
 
-    /* Start with reasonable capacity */
-    size_t capacity = 1024;
-    argus_row_t *all_rows = calloc(capacity, sizeof(argus_row_t));
-    if (!all_rows) {
-        return argus_set_error(&stmt->diag, "HY001",
-                               "[Argus] Memory allocation failed", 0);
-    }
-    size_t total = 0;
-
-    int batch_size = (dbc->fetch_buffer_size > 0)
-                     ? dbc->fetch_buffer_size
-                     : ARGUS_DEFAULT_BATCH_SIZE;
-
-    /* Bound the materialisation: a static cursor buffers the whole result, so
-     * an unbounded SELECT would exhaust memory. Past the cap, fail cleanly with
-     * an actionable diagnostic rather than OOM the process. */
-    size_t max_rows = (dbc->max_scroll_rows > 0)
-                      ? (size_t)dbc->max_scroll_rows
-                      : (size_t)ARGUS_DEFAULT_MAX_SCROLL_ROWS;
-
-    while (1) {
-        argus_row_cache_clear(&stmt->row_cache);
-        int num_cols = 0;
-        int rc = dbc->backend->fetch_results(
-            dbc->backend_conn, stmt->op,
-            batch_size,
-            &stmt->row_cache,
-            stmt->columns, &num_cols);
-
-        if (rc != 0) {
-            /* Free partially built cache */
-            for (size_t i = 0; i < total; i++) {
-                if (all_rows[i].cells) {
-                    for (int c = 0; c < stmt->num_cols; c++)
-                        free(all_rows[i].cells[c].data);
-                    free(all_rows[i].cells);
-                }
+    while (!stmt->scroll_complete &&
+           argus_scroll_store_rows(stmt->scroll_store) < upto) {
+        if (cache->current_row >= cache->num_rows) {
+            if (cache->exhausted && stmt->fetch_started) {
+                stmt->scroll_complete = true;
+                break;
             }
-            free(all_rows);
-            if (stmt->diag.count == 0)
-                argus_set_error(&stmt->diag, "HY000",
-                                "[Argus] Failed to fetch results", 0);
-            return SQL_ERROR;
+            SQLRETURN rc = argus_fetch_batch(stmt);
+            if (rc != SQL_SUCCESS) return rc;
+            stmt->fetch_started = true;
+            cache->current_row = 0;
+            continue;
         }
 
-        if (num_cols > 0 && !stmt->metadata_fetched) {
-            if (argus_stmt_ensure_columns(stmt, num_cols) != 0) {
-                free(all_rows);
-                return SQL_ERROR;
-            }
-            stmt->num_cols = num_cols;
-            stmt->metadata_fetched = true;
+        if (!stmt->scroll_store) {
+            stmt->scroll_store = argus_scroll_store_new(
+                stmt->num_cols > 0 ? stmt->num_cols : cache->num_cols,
+                dbc->scroll_memory_bytes,
+                dbc->scroll_compress);
+            if (!stmt->scroll_store)
+                return argus_set_error(&stmt->diag, "HY001",
+                                       "[Argus] Memory allocation failed", 0);
         }
 
-        if (stmt->row_cache.num_rows == 0) break;
-
-        /* Enforce the materialisation cap before growing further. */
-        if (total + stmt->row_cache.num_rows > max_rows) {
-            for (size_t i = 0; i < total; i++) {
-                if (all_rows[i].cells) {
-                    for (int c = 0; c < stmt->num_cols; c++)
-                        free(all_rows[i].cells[c].data);
-                    free(all_rows[i].cells);
-                }
-            }
-            free(all_rows);
+        size_t stored = argus_scroll_store_rows(stmt->scroll_store);
+        size_t pending = cache->num_rows - cache->current_row;
+        if (dbc->max_scroll_rows > 0 &&
+            stored + pending > (size_t)dbc->max_scroll_rows) {
             char msg[192];
             snprintf(msg, sizeof(msg),
-                     "[Argus] Result set exceeds the static-cursor limit of %zu "
+                     "[Argus] Result set exceeds the static-cursor limit of %ld "
                      "rows (MaxScrollRows); use a forward-only cursor for this "
-                     "query", max_rows);
+                     "query", dbc->max_scroll_rows);
             return argus_set_error(&stmt->diag, "HY001", msg, 0);
         }
-
-        /* Copy rows into scroll cache */
-        if (total + stmt->row_cache.num_rows > capacity) {
-            while (total + stmt->row_cache.num_rows > capacity)
-                capacity *= 2;
-            argus_row_t *new_rows = realloc(all_rows,
-                                             capacity * sizeof(argus_row_t));
-            if (!new_rows) {
-                for (size_t i = 0; i < total; i++) {
-                    if (all_rows[i].cells) {
-                        for (int c = 0; c < stmt->num_cols; c++)
-                            free(all_rows[i].cells[c].data);
-                        free(all_rows[i].cells);
-                    }
-                }
-                free(all_rows);
-                return argus_set_error(&stmt->diag, "HY001",
-                                       "[Argus] Memory allocation failed", 0);
-            }
-            all_rows = new_rows;
+        if (argus_scroll_store_bytes(stmt->scroll_store) >
+            dbc->max_scroll_bytes) {
+            char msg[192];
+            snprintf(msg, sizeof(msg),
+                     "[Argus] Result set exceeds the static-cursor limit of "
+                     "%llu bytes (MaxScrollBytes); use a forward-only cursor "
+                     "for this query",
+                     (unsigned long long)dbc->max_scroll_bytes);
+            return argus_set_error(&stmt->diag, "HY001", msg, 0);
         }
 
-        for (size_t i = 0; i < stmt->row_cache.num_rows; i++) {
-            /* Move rows (transfer ownership of cells) */
-            all_rows[total + i] = stmt->row_cache.rows[i];
-            stmt->row_cache.rows[i].cells = NULL;
+        while (cache->current_row < cache->num_rows) {
+            if (argus_scroll_store_append(stmt->scroll_store,
+                                          &cache->rows[cache->current_row])
+                != 0) {
+                char msg[320];
+                snprintf(msg, sizeof(msg),
+                         "[Argus] Cannot keep the static cursor's rows: %s",
+                         argus_scroll_store_error(stmt->scroll_store));
+                return argus_set_error(&stmt->diag, "HY001", msg, 0);
+            }
+            cache->current_row++;
         }
-        total += stmt->row_cache.num_rows;
-        stmt->row_cache.num_rows = 0;
     }
-
-    /* Store the scroll cache */
-    stmt->scroll_rows = all_rows;
-    stmt->scroll_row_count = total;
-    stmt->scroll_position = 0;
-    stmt->scroll_cached = true;
-    stmt->fetch_started = true;
-
     return SQL_SUCCESS;
 }
 
@@ -932,13 +1057,14 @@ static SQLRETURN build_scroll_cache(argus_stmt_t *stmt)
  *
  * Using the column-wise arithmetic on a row-wise binding writes inside the
  * application's buffer but at the wrong offset: no crash, no diagnostic, just
- * wrong data. Hence one helper, used by every fetch path.
+ * wrong data. Hence one helper, used by every fetch path and by SQL_ADD,
+ * which reads the rowset back out of the same buffers.
  */
-static void resolve_bind_target(const argus_stmt_t *stmt,
-                                const argus_col_binding_t *bind,
-                                SQLULEN rowset_idx,
-                                SQLPOINTER *out_target,
-                                SQLLEN **out_ind)
+void argus_bind_target(const argus_stmt_t *stmt,
+                       const argus_col_binding_t *bind,
+                       SQLULEN rowset_idx,
+                       SQLPOINTER *out_target,
+                       SQLLEN **out_ind)
 {
     SQLPOINTER target = bind->target_value;
     SQLLEN    *ind    = bind->str_len_or_ind;
@@ -961,12 +1087,29 @@ static void resolve_bind_target(const argus_stmt_t *stmt,
     *out_ind    = ind;
 }
 
+/* Row `row_idx` of the scroll store, or NULL with the error set */
+static const argus_row_t *scroll_row(argus_stmt_t *stmt, size_t row_idx)
+{
+    const argus_row_t *row = argus_scroll_store_get(stmt->scroll_store,
+                                                    row_idx);
+    if (!row) {
+        char msg[320];
+        snprintf(msg, sizeof(msg),
+                 "[Argus] Cannot read the static cursor's rows: %s",
+                 argus_scroll_store_error(stmt->scroll_store));
+        argus_set_error(&stmt->diag, "HY000", msg, 0);
+    }
+    return row;
+}
+
 static SQLRETURN deliver_scroll_row(argus_stmt_t *stmt, size_t row_idx,
                                      SQLULEN rowset_idx)
 {
-    if (row_idx >= stmt->scroll_row_count) return SQL_NO_DATA;
+    if (row_idx >= argus_scroll_store_rows(stmt->scroll_store))
+        return SQL_NO_DATA;
 
-    argus_row_t *row = &stmt->scroll_rows[row_idx];
+    const argus_row_t *row = scroll_row(stmt, row_idx);
+    if (!row) return SQL_ERROR;
     SQLRETURN final_ret = SQL_SUCCESS;
 
     for (int col = 0; col < stmt->num_cols && col < stmt->bindings_capacity; col++) {
@@ -977,9 +1120,9 @@ static SQLRETURN deliver_scroll_row(argus_stmt_t *stmt, size_t row_idx,
 
         SQLPOINTER target = NULL;
         SQLLEN *ind_ptr = NULL;
-        resolve_bind_target(stmt, bind, rowset_idx, &target, &ind_ptr);
+        argus_bind_target(stmt, bind, rowset_idx, &target, &ind_ptr);
 
-        SQLRETURN ret = convert_cell_to_target(
+        SQLRETURN ret = argus_convert_cell(
             cell, bind->target_type,
             target, bind->buffer_length,
             ind_ptr, &stmt->diag);
@@ -1013,7 +1156,7 @@ static SQLRETURN fetch_single_row(argus_stmt_t *stmt, SQLULEN rowset_idx)
             return SQL_NO_DATA;
         }
 
-        SQLRETURN rc = fetch_batch(stmt);
+        SQLRETURN rc = argus_fetch_batch(stmt);
         if (rc != SQL_SUCCESS) return rc;
 
         stmt->fetch_started = true;
@@ -1042,9 +1185,9 @@ static SQLRETURN fetch_single_row(argus_stmt_t *stmt, SQLULEN rowset_idx)
          * rowset; the layout decides the arithmetic. */
         SQLPOINTER target = NULL;
         SQLLEN *ind_ptr = NULL;
-        resolve_bind_target(stmt, bind, rowset_idx, &target, &ind_ptr);
+        argus_bind_target(stmt, bind, rowset_idx, &target, &ind_ptr);
 
-        SQLRETURN ret = convert_cell_to_target(
+        SQLRETURN ret = argus_convert_cell(
             cell, bind->target_type,
             target, bind->buffer_length,
             ind_ptr, &stmt->diag);
@@ -1085,6 +1228,13 @@ SQLRETURN SQL_API SQLFetch(SQLHSTMT StatementHandle)
     SQLULEN rows_fetched = 0;
     SQLRETURN final_ret = SQL_SUCCESS;
 
+    /* Time conversion on one call in ARGUS_METRICS_CONVERT_SAMPLE: the
+     * call's duration less the batch fetches it triggered */
+    argus_stmt_timing_t *t = &stmt->timing;
+    bool sample = (t->fetch_calls++ % ARGUS_METRICS_CONVERT_SAMPLE) == 0;
+    gint64 sample_start = sample ? g_get_monotonic_time() : 0;
+    double fetch_before = t->fetch_ms;
+
     for (SQLULEN i = 0; i < array_size; i++) {
         SQLRETURN ret = fetch_single_row(stmt, i);
 
@@ -1121,6 +1271,13 @@ SQLRETURN SQL_API SQLFetch(SQLHSTMT StatementHandle)
     if (stmt->rows_fetched_ptr)
         *(stmt->rows_fetched_ptr) = rows_fetched;
 
+    if (sample) {
+        double ms = (double)(g_get_monotonic_time() - sample_start) / 1000.0
+                    - (t->fetch_ms - fetch_before);
+        t->convert_sampled_ms += ms > 0 ? ms : 0.0;
+        t->convert_samples++;
+    }
+
     ARGUS_STMT_UNLOCK(stmt);
 
     if (rows_fetched == 0)
@@ -1150,7 +1307,8 @@ SQLRETURN SQL_API SQLFetchScroll(
         return SQLFetch(StatementHandle);
     }
 
-    /* Static cursor: build full scroll cache on first call */
+    /* Static cursor: the result is read into the scroll store as far as
+     * the application scrolls */
     ARGUS_STMT_LOCK(stmt);
     argus_diag_clear(&stmt->diag);
 
@@ -1162,16 +1320,16 @@ SQLRETURN SQL_API SQLFetchScroll(
     }
 
     if (!stmt->scroll_cached) {
-        SQLRETURN rc = build_scroll_cache(stmt);
-        if (rc != SQL_SUCCESS) {
-            ARGUS_STMT_UNLOCK(stmt);
-            return rc;
-        }
+        stmt->scroll_cached = true;
+        stmt->scroll_position = 0;
     }
 
-    /* Compute new position based on orientation */
+    SQLULEN array_size = stmt->row_array_size > 0 ? stmt->row_array_size : 1;
+
+    /* Compute new position based on orientation. Only positions counted
+     * from the end need the whole result. */
     long long new_pos;
-    size_t total = stmt->scroll_row_count;
+    bool from_end = false;
 
     switch (FetchOrientation) {
     case SQL_FETCH_NEXT:
@@ -1184,15 +1342,13 @@ SQLRETURN SQL_API SQLFetchScroll(
         new_pos = 0;
         break;
     case SQL_FETCH_LAST:
-        new_pos = (long long)total - 1;
+        from_end = true;
+        new_pos = -1;
         break;
     case SQL_FETCH_ABSOLUTE:
-        if (FetchOffset > 0)
-            new_pos = FetchOffset - 1;
-        else if (FetchOffset < 0)
-            new_pos = (long long)total + FetchOffset;
-        else
-            new_pos = -1; /* before start */
+        from_end = FetchOffset < 0;
+        new_pos = FetchOffset > 0 ? FetchOffset - 1
+                                  : -1; /* 0: before start */
         break;
     case SQL_FETCH_RELATIVE:
         new_pos = (long long)stmt->scroll_position - 1 + FetchOffset;
@@ -1207,9 +1363,26 @@ SQLRETURN SQL_API SQLFetchScroll(
                                "[Argus] Fetch type out of range", 0);
     }
 
+    if (from_end || new_pos >= 0) {
+        size_t upto = from_end ? SIZE_MAX : (size_t)new_pos + array_size;
+        SQLRETURN rc = scroll_fill(stmt, upto);
+        if (rc != SQL_SUCCESS) {
+            ARGUS_STMT_UNLOCK(stmt);
+            return rc;
+        }
+    }
+
+    /* Short of `upto` only when the whole result has been read */
+    size_t total = argus_scroll_store_rows(stmt->scroll_store);
+    if (FetchOrientation == SQL_FETCH_LAST)
+        new_pos = (long long)total - 1;
+    else if (from_end)
+        new_pos = (long long)total + FetchOffset;
+
     /* Bounds check */
     if (new_pos < 0 || (total == 0) || (size_t)new_pos >= total) {
         stmt->scroll_position = (new_pos < 0) ? 0 : total;
+        stmt->scroll_row = 0;
         if (stmt->rows_fetched_ptr) *stmt->rows_fetched_ptr = 0;
         if (stmt->row_status_ptr) stmt->row_status_ptr[0] = SQL_ROW_NOROW;
         ARGUS_STMT_UNLOCK(stmt);
@@ -1221,7 +1394,6 @@ SQLRETURN SQL_API SQLFetchScroll(
     stmt->getdata_offset = 0;
 
     /* Fetch rows for the rowset */
-    SQLULEN array_size = stmt->row_array_size > 0 ? stmt->row_array_size : 1;
     SQLULEN rows_fetched = 0;
     SQLRETURN final_ret = SQL_SUCCESS;
 
@@ -1261,11 +1433,8 @@ SQLRETURN SQL_API SQLFetchScroll(
     /* Update position to after the fetched rows */
     stmt->scroll_position = (size_t)new_pos + rows_fetched;
 
-    /* Also update row_cache.current_row for GetData compatibility */
-    if (rows_fetched > 0 && (size_t)new_pos < total) {
-        /* Point row_cache at the last fetched scroll row for GetData */
-        stmt->row_cache.current_row = (size_t)new_pos + rows_fetched;
-    }
+    /* SQLGetData reads the first row of the rowset */
+    stmt->scroll_row = rows_fetched > 0 ? (size_t)new_pos + 1 : 0;
 
     if (stmt->rows_fetched_ptr)
         *stmt->rows_fetched_ptr = rows_fetched;
@@ -1297,16 +1466,28 @@ SQLRETURN SQL_API SQLGetData(
         return err;
     }
 
-    /* Current row is one behind current_row pointer */
-    size_t row_idx = stmt->row_cache.current_row - 1;
-    if (row_idx >= stmt->row_cache.num_rows) {
+    /* A static cursor reads the row it is positioned on from the scroll
+     * store; otherwise the current row is one behind current_row */
+    const argus_row_t *row = NULL;
+    if (stmt->scroll_cached) {
+        if (stmt->scroll_row > 0 &&
+            stmt->scroll_row <= argus_scroll_store_rows(stmt->scroll_store)) {
+            row = scroll_row(stmt, stmt->scroll_row - 1);
+            if (!row) {
+                ARGUS_STMT_UNLOCK(stmt);
+                return SQL_ERROR;
+            }
+        }
+    } else if (stmt->row_cache.current_row - 1 < stmt->row_cache.num_rows) {
+        row = &stmt->row_cache.rows[stmt->row_cache.current_row - 1];
+    }
+    if (!row) {
         SQLRETURN err = argus_set_error(&stmt->diag, "24000",
                                "[Argus] Invalid cursor state", 0);
         ARGUS_STMT_UNLOCK(stmt);
         return err;
     }
 
-    argus_row_t *row = &stmt->row_cache.rows[row_idx];
     argus_cell_t *cell = &row->cells[ColumnNumber - 1];
 
     /* If column changed, reset offset */
@@ -1380,9 +1561,9 @@ SQLRETURN SQL_API SQLGetData(
     }
 
     /* First call — use standard conversion */
-    SQLRETURN ret = convert_cell_to_target(cell, TargetType, TargetValue,
-                                            BufferLength, StrLen_or_Ind,
-                                            &stmt->diag);
+    SQLRETURN ret = argus_convert_cell(cell, TargetType, TargetValue,
+                                        BufferLength, StrLen_or_Ind,
+                                        &stmt->diag);
 
     /* Track offset for multi-call if data was truncated */
     if (ret == SQL_SUCCESS_WITH_INFO &&
@@ -1795,12 +1976,12 @@ SQLRETURN SQL_API SQLSetPos(
         if (stmt->scroll_cached && RowNumber > 0) {
             size_t target = stmt->scroll_rowset_start + (size_t)(RowNumber - 1);
             if (target >= stmt->scroll_position ||
-                target >= stmt->scroll_row_count) {
+                target >= argus_scroll_store_rows(stmt->scroll_store)) {
                 return argus_set_error(&stmt->diag, "HY107",
                                        "[Argus] Row value out of range", 0);
             }
             /* Point GetData at the chosen row. */
-            stmt->row_cache.current_row = target;
+            stmt->scroll_row = target + 1;
             return SQL_SUCCESS;
         }
         return SQL_SUCCESS;
@@ -1816,7 +1997,8 @@ SQLRETURN SQL_API SQLSetPos(
 
         size_t start = stmt->scroll_rowset_start;
         size_t end   = stmt->scroll_position;   /* exclusive */
-        if (end > stmt->scroll_row_count) end = stmt->scroll_row_count;
+        size_t stored = argus_scroll_store_rows(stmt->scroll_store);
+        if (end > stored) end = stored;
 
         /* SQL_REFRESH must not advance the fetch counters. */
         unsigned long saved_total = stmt->rows_fetched_total;
@@ -1848,38 +2030,6 @@ SQLRETURN SQL_API SQLSetPos(
                            "[Argus] SQLSetPos operation not supported", 0);
 }
 
-/* ── SQLBulkOperations ───────────────────────────────────────────
- * Bulk/positioned writes (SQL_ADD, *_BY_BOOKMARK) require a positioned-update
- * context (target table + row bookmarks) that a query-oriented driver over
- * read-mostly analytic engines does not maintain. Writes are issued as direct
- * INSERT/UPDATE/DELETE statements instead. We validate the operation code and
- * return the conformant "optional feature not implemented" (HYC00). */
-SQLRETURN SQL_API SQLBulkOperations(
-    SQLHSTMT    StatementHandle,
-    SQLSMALLINT Operation)
-{
-    argus_stmt_t *stmt = (argus_stmt_t *)StatementHandle;
-    if (!argus_valid_stmt(stmt)) return SQL_INVALID_HANDLE;
-    argus_diag_clear(&stmt->diag);
-
-    const char *what;
-    switch (Operation) {
-    case SQL_ADD:                what = "SQL_ADD"; break;
-    case SQL_UPDATE_BY_BOOKMARK: what = "SQL_UPDATE_BY_BOOKMARK"; break;
-    case SQL_DELETE_BY_BOOKMARK: what = "SQL_DELETE_BY_BOOKMARK"; break;
-    case SQL_FETCH_BY_BOOKMARK:  what = "SQL_FETCH_BY_BOOKMARK"; break;
-    default:
-        return argus_set_error(&stmt->diag, "HY092",
-                               "[Argus] Invalid SQLBulkOperations operation", 0);
-    }
-
-    char msg[256];
-    snprintf(msg, sizeof(msg),
-             "[Argus] SQLBulkOperations(%s) not supported; issue a direct "
-             "INSERT/UPDATE/DELETE statement instead", what);
-    return argus_set_error(&stmt->diag, "HYC00", msg, 0);
-}
-
 /* ── ODBC 2.x: SQLSetScrollOptions (stub) ────────────────────── */
 
 SQLRETURN SQL_API SQLSetScrollOptions(
@@ -33,6 +33,7 @@ SQLRETURN argus_alloc_dbc(argus_env_t *env, argus_dbc_t **out)
     dbc->signature          = ARGUS_DBC_SIGNATURE;
     dbc->env                = env;
     g_mutex_init(&dbc->mutex);
+    argus_async_init(&dbc->async_dbc);
     dbc->connected          = false;
     dbc->login_timeout      = 0;
     dbc->connection_timeout = 0;
@@ -46,13 +47,40 @@ SQLRETURN argus_alloc_dbc(argus_env_t *env, argus_dbc_t **out)
 
     /* Initialize additional connection parameters */
     dbc->fetch_buffer_size  = 0;     /* 0 means use backend default */
+    dbc->adaptive_fetch     = true;
+    dbc->fetch_target_bytes = ARGUS_DEFAULT_FETCH_TARGET_BYTES;
+    dbc->fetch_target_ms    = ARGUS_DEFAULT_FETCH_TARGET_MS;
+    dbc->fetch_min_rows     = ARGUS_DEFAULT_FETCH_MIN_ROWS;
+    dbc->fetch_max_rows     = ARGUS_DEFAULT_FETCH_MAX_ROWS;
+    dbc->bulk_insert_rows   = ARGUS_DEFAULT_BULK_INSERT_ROWS;
+    dbc->bulk_insert_bytes  = ARGUS_DEFAULT_BULK_INSERT_BYTES;
     dbc->retry_count        = 0;     /* No retries by default */
     dbc->retry_delay_sec    = 2;     /* 2 second delay between retries */
+    dbc->connect_race_delay_ms = ARGUS_DEFAULT_CONNECT_RACE_DELAY_MS;
+    dbc->host_cooldown_sec     = ARGUS_DEFAULT_HOST_COOLDOWN_SEC;
     dbc->socket_timeout_sec = 0;     /* 0 means no timeout */
     dbc->connect_timeout_sec = 0;
     dbc->query_timeout_sec  = 0;
     dbc->log_level          = -1;    /* -1 means not set (use global) */
+    dbc->log_format         = -1;
+    dbc->trace_sample       = 1.0;   /* with TRACEFILE: every operation */
     dbc->telemetry_enabled  = false; /* opt-in; off unless TELEMETRY=1 */
+    dbc->arrow_results      = true;  /* servers without Arrow ignore the flag */
+    dbc->cloud_fetch        = true;
+    dbc->prefetch           = true;
+    dbc->result_cache       = false; /* opt-in; RESULTCACHE=1 */
+    dbc->result_cache_ttl_sec   = ARGUS_DEFAULT_RESULT_CACHE_TTL_SEC;
+    dbc->result_cache_max_bytes = ARGUS_DEFAULT_RESULT_CACHE_BYTES;
+    dbc->sql_cache_max_bytes    = ARGUS_DEFAULT_SQL_CACHE_BYTES;
+    dbc->max_scroll_bytes    = ARGUS_DEFAULT_MAX_SCROLL_BYTES;
+    dbc->scroll_memory_bytes = ARGUS_DEFAULT_SCROLL_MEMORY_BYTES;
+    dbc->metadata_cache_ttl_sec = ARGUS_DEFAULT_METADATA_CACHE_TTL_SEC;
+    dbc->tables_cache_ttl_sec   = -1;    /* -1 means use metadata_cache_ttl_sec */
+    dbc->columns_cache_ttl_sec  = -1;
+    dbc->metadata_cache_stale_sec = 0;
+    dbc->catalog_snapshot   = false; /* opt-in; CATALOGSNAPSHOT=1 */
+    dbc->http_compression   = true;
+    dbc->http2              = false;
 
     *out = dbc;
     return SQL_SUCCESS;
@@ -73,6 +101,8 @@ SQLRETURN argus_alloc_stmt(argus_dbc_t *dbc, argus_stmt_t **out)
     stmt->signature       = ARGUS_STMT_SIGNATURE;
     stmt->dbc             = dbc;
     g_mutex_init(&stmt->mutex);
+    argus_async_init(&stmt->async);
+    argus_cancel_init(&stmt->cancel);
     stmt->row_count       = -1;
     stmt->row_array_size  = 1;
     stmt->row_bind_type   = SQL_BIND_BY_COLUMN;
@@ -174,25 +204,18 @@ int argus_stmt_ensure_bindings(argus_stmt_t *stmt, int ncols)
 SQLRETURN argus_free_env(argus_env_t *env)
 {
     if (!argus_valid_env(env)) return SQL_INVALID_HANDLE;
+    /* Background metadata refreshes hold pooled connections: finish first */
+    argus_metadata_cache_cleanup();
     argus_pool_cleanup();
+    argus_result_cache_clear();
     env->signature = 0;
     free(env);
     return SQL_SUCCESS;
 }
 
-SQLRETURN argus_free_dbc(argus_dbc_t *dbc)
+/* Free the strings and objects a connection owns. */
+static void dbc_free_fields(argus_dbc_t *dbc)
 {
-    if (!argus_valid_dbc(dbc)) return SQL_INVALID_HANDLE;
-
-    if (dbc->connected) {
-        argus_set_error(&dbc->diag, "HY010",
-                        "[Argus] Connection still open; call SQLDisconnect first",
-                        0);
-        return SQL_ERROR;
-    }
-
-    g_mutex_clear(&dbc->mutex);
-    dbc->signature = 0;
     free(dbc->host);
     free(dbc->username);
     argus_secure_free(dbc->password);
@@ -216,6 +239,7 @@ SQLRETURN argus_free_dbc(argus_dbc_t *dbc)
     free(dbc->app_name);
     free(dbc->http_path);
     free(dbc->log_file);
+    free(dbc->trace_file);
     free(dbc->oauth_token_url);
     free(dbc->oauth_client_id);
     free(dbc->oauth_client_secret);
@@ -235,15 +259,109 @@ SQLRETURN argus_free_dbc(argus_dbc_t *dbc)
     /* Free browse buffer */
     free(dbc->browse_buf);
 
-    /* Free metadata cache */
-    argus_metadata_cache_free(dbc);
+    free(dbc->metadata_cache_file);
+    free(dbc->capture_file);
+    free(dbc->replay_file);
+    free(dbc->synthetic_spec);
+
+    free(dbc->result_cache_pattern);
+    if (dbc->result_cache_regex)
+        g_regex_unref((GRegex *)dbc->result_cache_regex);
+}
+
+SQLRETURN argus_free_dbc(argus_dbc_t *dbc)
+{
+    if (!argus_valid_dbc(dbc)) return SQL_INVALID_HANDLE;
+
+    /* An asynchronous connect or disconnect still writes to the handle */
+    if (dbc->async_dbc_busy)
+        argus_async_wait(&dbc->async_dbc);
+
+    if (dbc->connected) {
+        argus_set_error(&dbc->diag, "HY010",
+                        "[Argus] Connection still open; call SQLDisconnect first",
+                        0);
+        return SQL_ERROR;
+    }
+
+    argus_tracer_close(dbc->tracer);
+    argus_async_clear(&dbc->async_dbc);
+    g_mutex_clear(&dbc->mutex);
+    dbc->signature = 0;
+    dbc_free_fields(dbc);
 
     free(dbc);
     return SQL_SUCCESS;
 }
 
+/*
+ * A detached copy of dbc's settings for a connect attempt that may outlive
+ * the handle (the losers of a failover race). It owns copies of every
+ * string and has no environment, diagnostics or backend connection.
+ */
+argus_dbc_t *argus_dbc_clone_config(const argus_dbc_t *dbc)
+{
+    argus_dbc_t *copy = malloc(sizeof(*copy));
+    if (!copy) return NULL;
+    memcpy(copy, dbc, sizeof(*copy));
+    argus_diag_clear(&copy->diag);
+    copy->env = NULL;
+    copy->backend_conn = NULL;
+    copy->connected = false;
+    copy->browse_buf = NULL;
+    copy->result_cache_regex = NULL;
+    copy->tracer = NULL;
+
+    char **fields[] = {
+        &copy->host, &copy->username, &copy->password, &copy->database,
+        &copy->auth_mechanism, &copy->krb_service_name, &copy->krb_host_fqdn,
+        &copy->krb_realm, &copy->backend_name, &copy->current_catalog,
+        &copy->obs_connstr, &copy->connected_host, &copy->license,
+        &copy->ssl_cert_file, &copy->ssl_key_file, &copy->ssl_ca_file,
+        &copy->app_name, &copy->http_path, &copy->log_file,
+        &copy->trace_file,
+        &copy->oauth_token_url, &copy->oauth_client_id,
+        &copy->oauth_client_secret, &copy->oauth_scope,
+        &copy->oauth_device_url, &copy->oauth_auth_url, &copy->oauth_issuer,
+        &copy->bq_project, &copy->bq_location, &copy->bq_endpoint,
+        &copy->bq_token_url, &copy->bq_audience, &copy->bq_scope,
+        &copy->bq_key_file, &copy->bq_access_token,
+        &copy->metadata_cache_file, &copy->result_cache_pattern,
+        &copy->capture_file, &copy->replay_file, &copy->synthetic_spec,
+    };
+    bool ok = true;
+    for (size_t i = 0; i < G_N_ELEMENTS(fields); i++) {
+        if (*fields[i] && !(*fields[i] = strdup(*fields[i])))
+            ok = false;
+    }
+    if (!ok) {
+        argus_dbc_free_config(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+void argus_dbc_free_config(argus_dbc_t *copy)
+{
+    if (!copy) return;
+    dbc_free_fields(copy);
+    free(copy);
+}
+
 void argus_stmt_reset(argus_stmt_t *stmt)
 {
+    /* An asynchronous execute may still be running and owns async_query and
+     * the execution fields, so it must complete before anything here is torn
+     * down. Its result is about to be discarded: cancel it rather than wait
+     * for the server to finish. */
+    if (stmt->async_state == ARGUS_ASYNC_SUBMITTED ||
+        stmt->async_state == ARGUS_ASYNC_RUNNING) {
+        argus_cancel_request(&stmt->cancel);
+        argus_async_wait(&stmt->async);
+    }
+
+    argus_stmt_timing_finish(stmt);
+
     /* Close backend operation if active */
     if (stmt->op && stmt->dbc && stmt->dbc->backend) {
         stmt->dbc->backend->close_operation(
@@ -251,11 +369,10 @@ void argus_stmt_reset(argus_stmt_t *stmt)
         stmt->op = NULL;
     }
 
-    /* Save num_cols before clearing for scroll cache cleanup */
-    int saved_num_cols = stmt->num_cols;
-
     free(stmt->query);
     stmt->query           = NULL;
+    argus_sql_text_unref(stmt->query_text);
+    stmt->query_text      = NULL;
     stmt->prepared        = false;
     stmt->executed        = false;
     stmt->num_cols        = 0;
@@ -264,38 +381,23 @@ void argus_stmt_reset(argus_stmt_t *stmt)
     stmt->row_count       = -1;
     stmt->getdata_col     = 0;
     stmt->getdata_offset  = 0;
+    stmt->trace_ctx.sampled = false;
 
     argus_row_cache_free(&stmt->row_cache);
     argus_row_cache_init(&stmt->row_cache);
+    argus_result_cache_release(stmt);
+    argus_metadata_cache_release(stmt);
 
     /* Free scroll cache */
-    if (stmt->scroll_rows) {
-        int nc = saved_num_cols > 0 ? saved_num_cols
-                                     : stmt->row_cache.num_cols;
-        for (size_t i = 0; i < stmt->scroll_row_count; i++) {
-            argus_row_t *row = &stmt->scroll_rows[i];
-            if (row->cells) {
-                for (int c = 0; c < nc; c++)
-                    free(row->cells[c].data);
-                free(row->cells);
-            }
-        }
-        free(stmt->scroll_rows);
-        stmt->scroll_rows = NULL;
-    }
-    stmt->scroll_row_count = 0;
+    argus_scroll_store_free(stmt->scroll_store);
+    stmt->scroll_store     = NULL;
+    stmt->scroll_row       = 0;
     stmt->scroll_position  = 0;
     stmt->scroll_cached    = false;
+    stmt->scroll_complete  = false;
 
-    /* Reset async state. A worker thread may still be running an execute and
-     * owns async_query and the execution fields, so it must be joined before
-     * anything here is torn down. */
-    if (stmt->async_thread) {
-        g_thread_join(stmt->async_thread);
-        stmt->async_thread = NULL;
-    }
+    /* Reset async state */
     stmt->async_state = ARGUS_ASYNC_IDLE;
-    g_atomic_int_set(&stmt->async_done, 0);
     free(stmt->async_query);
     stmt->async_query = NULL;
 
@@ -322,12 +424,23 @@ SQLRETURN argus_free_stmt(argus_stmt_t *stmt)
 {
     if (!argus_valid_stmt(stmt)) return SQL_INVALID_HANDLE;
 
+    /* Stop an asynchronous execute and let it unwind before reading what
+     * it wrote */
+    if (stmt->async_state == ARGUS_ASYNC_SUBMITTED ||
+        stmt->async_state == ARGUS_ASYNC_RUNNING) {
+        argus_cancel_request(&stmt->cancel);
+        argus_async_wait(&stmt->async);
+    }
+
     /* Log metrics at INFO level before cleanup */
     if (stmt->rows_fetched_total > 0 || stmt->execute_time_ms > 0) {
         ARGUS_LOG_INFO("Statement metrics: execute=%.1f ms, "
-                       "rows_fetched=%lu, errors=%lu",
+                       "first_row=%.1f ms, rows_fetched=%lu, bytes=%lu, "
+                       "errors=%lu",
                        stmt->execute_time_ms,
+                       stmt->timing.first_row_ms,
                        stmt->rows_fetched_total,
+                       stmt->timing.bytes,
                        stmt->errors_total);
         /* Observability tap: one aggregate event per statement handle.
          * Only the SQLSTATE is reported for errors, never the message text. */
@@ -338,7 +451,7 @@ SQLRETURN argus_free_stmt(argus_stmt_t *stmt)
             stmt->query,
             stmt->execute_time_ms,
             stmt->rows_fetched_total,
-            0,
+            stmt->timing.bytes,
             stmt->errors_total > 0 && stmt->diag.count > 0
                 ? (const char *)stmt->diag.records[0].sqlstate
                 : "00000");
@@ -347,8 +460,11 @@ SQLRETURN argus_free_stmt(argus_stmt_t *stmt)
     }
 
     argus_stmt_reset(stmt);
+    argus_async_clear(&stmt->async);
+    argus_cancel_clear(&stmt->cancel);
     g_mutex_clear(&stmt->mutex);
     free(stmt->cursor_name);
+    free(stmt->extract_path);
     free(stmt->columns);
     /* Free the statement's own array, not stmt->bindings, which may currently
      * point at an explicitly-associated descriptor the application still owns
@@ -0,0 +1,171 @@
+/*
+ * Argus ODBC Driver — Per-host connect health
+ *
+ * Process-wide record of how connecting to each host of a HOST=h1,h2,h3
+ * failover list went: an exponentially weighted moving average (EWMA) of
+ * the connect latency and of the failure rate, plus a circuit breaker.
+ * do_connect() orders the list by it, so a slow or dead coordinator stops
+ * being tried first, and a host that failed ARGUS_HOST_BREAKER_FAILURES
+ * times in a row is tried last until HOSTCOOLDOWN seconds have passed.
+ */
+
+#include "argus/handle.h"
+#include "argus/log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#define ARGUS_HOST_EWMA_ALPHA       0.3   /* weight of the newest sample */
+#define ARGUS_HOST_BREAKER_FAILURES 3     /* consecutive failures to open */
+#define ARGUS_HOST_MAX_TRACKED      1024
+
+typedef struct {
+    double  latency_ms;     /* EWMA of successful connect times */
+    double  failure_rate;   /* EWMA of failures (0..1) */
+    bool    has_latency;
+    int     consecutive_failures;
+    gint64  open_until;     /* monotonic; breaker open before this */
+} host_health_t;
+
+static GMutex      hh_lock;
+static GHashTable *hh_table;    /* "host:port" -> host_health_t* */
+
+static char *host_key(const char *host, int port)
+{
+    return g_strdup_printf("%s:%d", host ? host : "", port);
+}
+
+/* Record the outcome of one connect attempt to host:port. */
+void argus_host_health_record(const char *host, int port, bool ok,
+                              double connect_ms, int cooldown_sec)
+{
+    char *key = host_key(host, port);
+
+    g_mutex_lock(&hh_lock);
+    if (!hh_table)
+        hh_table = g_hash_table_new_full(g_str_hash, g_str_equal,
+                                         g_free, free);
+    host_health_t *h = g_hash_table_lookup(hh_table, key);
+    if (!h) {
+        /* Plenty for any sane set of failover lists; start over if not */
+        if (g_hash_table_size(hh_table) >= ARGUS_HOST_MAX_TRACKED)
+            g_hash_table_remove_all(hh_table);
+        h = calloc(1, sizeof(*h));
+        if (!h) {
+            g_mutex_unlock(&hh_lock);
+            g_free(key);
+            return;
+        }
+        g_hash_table_insert(hh_table, key, h);
+        key = NULL;
+    }
+
+    h->failure_rate += ARGUS_HOST_EWMA_ALPHA *
+                       ((ok ? 0.0 : 1.0) - h->failure_rate);
+    if (ok) {
+        h->latency_ms = h->has_latency
+            ? h->latency_ms + ARGUS_HOST_EWMA_ALPHA *
+                              (connect_ms - h->latency_ms)
+            : connect_ms;
+        h->has_latency = true;
+        h->consecutive_failures = 0;
+        h->open_until = 0;
+    } else if (++h->consecutive_failures >= ARGUS_HOST_BREAKER_FAILURES &&
+               cooldown_sec > 0) {
+        /* Also re-opens a half-open breaker whose trial attempt failed */
+        h->open_until = g_get_monotonic_time() +
+                        (gint64)cooldown_sec * G_USEC_PER_SEC;
+        ARGUS_LOG_WARN("Host %s:%d failed %d times in a row; trying it last "
+                       "for %d s", host ? host : "", port,
+                       h->consecutive_failures, cooldown_sec);
+    }
+    g_mutex_unlock(&hh_lock);
+    g_free(key);
+}
+
+/* True while host:port's circuit breaker is open. */
+bool argus_host_health_is_open(const char *host, int port)
+{
+    char *key = host_key(host, port);
+    bool open = false;
+
+    g_mutex_lock(&hh_lock);
+    host_health_t *h = hh_table ? g_hash_table_lookup(hh_table, key) : NULL;
+    if (h && h->open_until > g_get_monotonic_time())
+        open = true;
+    g_mutex_unlock(&hh_lock);
+    g_free(key);
+    return open;
+}
+
+typedef struct {
+    int    pos;       /* position in the HOST list */
+    bool   open;
+    double score;     /* lower is better */
+} host_rank_t;
+
+static int host_rank_cmp(const void *a, const void *b)
+{
+    const host_rank_t *ra = (const host_rank_t *)a;
+    const host_rank_t *rb = (const host_rank_t *)b;
+    if (ra->open != rb->open) return ra->open ? 1 : -1;
+    if (ra->score < rb->score) return -1;
+    if (ra->score > rb->score) return 1;
+    return ra->pos - rb->pos;
+}
+
+/*
+ * Fill order[0..n) with the positions of hosts[] in the order to try them:
+ * closed breakers first, by latency inflated by the failure rate, then open
+ * ones. A host without history scores like the best known one, so the list
+ * order decides until there is a reason to deviate from it.
+ */
+void argus_host_health_order(const char *const *hosts, const int *ports,
+                             int n, int *order)
+{
+    host_rank_t ranks[ARGUS_MAX_HOSTS];
+    bool known[ARGUS_MAX_HOSTS];
+    double best = -1.0;
+    gint64 now = g_get_monotonic_time();
+
+    if (n > ARGUS_MAX_HOSTS) n = ARGUS_MAX_HOSTS;
+
+    g_mutex_lock(&hh_lock);
+    for (int i = 0; i < n; i++) {
+        char *key = host_key(hosts[i], ports[i]);
+        host_health_t *h = hh_table ? g_hash_table_lookup(hh_table, key)
+                                    : NULL;
+        g_free(key);
+
+        ranks[i].pos = i;
+        ranks[i].open = h && h->open_until > now;
+        known[i] = h && h->has_latency;
+        /* A host that never connected is as bad as its failure rate */
+        ranks[i].score = known[i]
+            ? h->latency_ms * (1.0 + 4.0 * h->failure_rate)
+            : (h ? 1e9 * h->failure_rate : 0.0);
+        if (known[i] && !ranks[i].open && (best < 0 || ranks[i].score < best))
+            best = ranks[i].score;
+    }
+    g_mutex_unlock(&hh_lock);
+
+    for (int i = 0; i < n; i++) {
+        if (!known[i] && ranks[i].score == 0.0 && best > 0)
+            ranks[i].score = best;
+    }
+    qsort(ranks, (size_t)n, sizeof(ranks[0]), host_rank_cmp);
+    for (int i = 0; i < n; i++)
+        order[i] = ranks[i].pos;
+}
+
+/* Forget every host (tests). */
+void argus_host_health_clear(void)
+{
+    g_mutex_lock(&hh_lock);
+    if (hh_table) {
+        g_hash_table_destroy(hh_table);
+        hh_table = NULL;
+    }
+    g_mutex_unlock(&hh_lock);
+}
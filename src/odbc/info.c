@@ -29,6 +29,16 @@
 #ifndef SQL_IS_INSERT_LITERALS
 #define SQL_IS_INSERT_LITERALS  0x00000001L
 #endif
+#ifndef SQL_ASYNC_DBC_FUNCTIONS
+#define SQL_ASYNC_DBC_FUNCTIONS         10023
+#define SQL_ASYNC_DBC_NOT_CAPABLE       0x00000000L
+#define SQL_ASYNC_DBC_CAPABLE           0x00000001L
+#endif
+#ifndef SQL_ASYNC_NOTIFICATION
+#define SQL_ASYNC_NOTIFICATION          10025
+#define SQL_ASYNC_NOTIFICATION_NOT_CAPABLE 0x00000000L
+#define SQL_ASYNC_NOTIFICATION_CAPABLE  0x00000001L
+#endif
 #ifndef SQL_IS_SELECT_INTO
 #define SQL_IS_SELECT_INTO      0x00000004L
 #endif
@@ -245,8 +255,11 @@ SQLRETURN SQL_API SQLGetInfo(
     case SQL_SCROLL_OPTIONS:
         return set_uinteger_info(SQL_SO_FORWARD_ONLY | SQL_SO_STATIC,
                                  InfoValue, StringLength);
+    /* SQL_CA1_BULK_ADD: SQLBulkOperations(SQL_ADD) inserts the bound rowset
+     * into the table the result set reads (bulk.c), with either cursor. */
     case SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1:
-        return set_uinteger_info(SQL_CA1_NEXT, InfoValue, StringLength);
+        return set_uinteger_info(SQL_CA1_NEXT | SQL_CA1_BULK_ADD,
+                                 InfoValue, StringLength);
     case SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES2:
         return set_uinteger_info(SQL_CA2_READ_ONLY_CONCURRENCY,
                                  InfoValue, StringLength);
@@ -256,7 +269,8 @@ SQLRETURN SQL_API SQLGetInfo(
     case SQL_STATIC_CURSOR_ATTRIBUTES1:
         return set_uinteger_info(
             SQL_CA1_NEXT | SQL_CA1_ABSOLUTE | SQL_CA1_RELATIVE |
-            SQL_CA1_POS_POSITION | SQL_CA1_POS_REFRESH | SQL_CA1_LOCK_NO_CHANGE,
+            SQL_CA1_POS_POSITION | SQL_CA1_POS_REFRESH | SQL_CA1_LOCK_NO_CHANGE |
+            SQL_CA1_BULK_ADD,
             InfoValue, StringLength);
     case SQL_STATIC_CURSOR_ATTRIBUTES2:
         return set_uinteger_info(SQL_CA2_READ_ONLY_CONCURRENCY,
@@ -443,14 +457,25 @@ SQLRETURN SQL_API SQLGetInfo(
         return set_uinteger_info(SQL_PAS_NO_SELECT, InfoValue, StringLength);
 
     /* Statement-level async is real: SQLExecDirect/SQLExecute with
-     * SQL_ATTR_ASYNC_ENABLE_ON run the backend execute on a worker thread
-     * (execute.c async_worker) and return SQL_STILL_EXECUTING immediately; the
-     * application polls by re-calling the function, and SQLCompleteAsync blocks
-     * for the result. Backend-agnostic — it does not depend on a per-backend
-     * get_operation_status advancing the query — so this is advertised honestly. */
+     * SQL_ATTR_ASYNC_ENABLE_ON hand the backend execute to the shared
+     * executor (executor.c) and return SQL_STILL_EXECUTING immediately; the
+     * application polls by re-calling the function, or asks to be notified,
+     * and SQLCompleteAsync blocks for the result. Backend-agnostic — backends
+     * with submit/poll just hold no thread while the server runs the query —
+     * so this is advertised honestly. */
     case SQL_ASYNC_MODE:
         return set_uinteger_info(SQL_AM_STATEMENT, InfoValue, StringLength);
 
+    /* SQLConnect, SQLDriverConnect and SQLDisconnect run asynchronously
+     * (connect.c); other connection functions complete synchronously,
+     * which the specification allows */
+    case SQL_ASYNC_DBC_FUNCTIONS:
+        return set_uinteger_info(SQL_ASYNC_DBC_CAPABLE, InfoValue, StringLength);
+
+    case SQL_ASYNC_NOTIFICATION:
+        return set_uinteger_info(SQL_ASYNC_NOTIFICATION_CAPABLE,
+                                 InfoValue, StringLength);
+
     case SQL_INFO_SCHEMA_VIEWS:
         return set_uinteger_info(0, InfoValue, StringLength);
 
@@ -710,10 +735,10 @@ SQLRETURN SQL_API SQLGetFunctions(
         SET_FUNC(SQL_API_SQLSETDESCREC);
         SET_FUNC(SQL_API_SQLDESCRIBEPARAM);
         /* SQLSetPos is here because SQL_POSITION and SQL_REFRESH work;
-         * SQL_POS_OPERATIONS says which. SQLBulkOperations is deliberately
-         * absent — it is a pure HYC00 stub, and claiming it made applications
-         * call it and fail. */
+         * SQL_POS_OPERATIONS says which. Likewise SQLBulkOperations does
+         * SQL_ADD only, which SQL_CA1_BULK_ADD advertises. */
         SET_FUNC(SQL_API_SQLSETPOS);
+        SET_FUNC(SQL_API_SQLBULKOPERATIONS);
 
         #undef SET_FUNC
         return SQL_SUCCESS;
@@ -829,11 +854,10 @@ SQLRETURN SQL_API SQLGetFunctions(
     case SQL_API_SQLSETDESCREC:
     case SQL_API_SQLDESCRIBEPARAM:
     case SQL_API_SQLSETPOS:
+    case SQL_API_SQLBULKOPERATIONS:
         *Supported = SQL_TRUE;
         break;
     default:
-        /* Includes SQL_API_SQLBULKOPERATIONS: a pure HYC00 stub, so SQL_FALSE
-         * is the honest answer and keeps applications from calling it. */
         *Supported = SQL_FALSE;
         break;
     }
@@ -1,30 +1,83 @@
 /*
  * log.c - Thread-safe logging system for Argus ODBC driver
+ *
+ * A log call formats its line on the calling thread and appends it to that
+ * thread's ring buffer; it takes no lock. A writer thread drains every ring
+ * about every ARGUS_LOG_DRAIN_MS (sooner when a ring is half full) and hands
+ * each drain to the output in one write. When a ring is full the line is
+ * dropped and counted, and the writer reports the count in the log, so a
+ * DEBUG log never stalls the fetch path behind a slow disk.
+ *
+ * ARGUS_LOG_ASYNC=0 writes each line synchronously instead (one write per
+ * line under the log mutex). FATAL lines, argus_log_flush() and
+ * argus_log_cleanup() drain the rings on the calling thread.
+ *
+ * There is no thread-exit hook: the driver can be unloaded while application
+ * threads live on, and a destructor left in their TLS would run unmapped
+ * code. Per-thread states stay on a list until argus_log_cleanup() frees
+ * them; the writer frees a ring that has been empty for ARGUS_LOG_RETIRE_MS,
+ * so a thread that exited keeps only its small header.
  */
 
 #include "argus/log.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <time.h>
+#include <glib.h>
 
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <pthread.h>
-#endif
+#define ARGUS_LOG_RING_SIZE  65536   /* bytes per thread, power of two */
+#define ARGUS_LOG_LINE_MAX   4096    /* longer lines are truncated */
+#define ARGUS_LOG_DRAIN_MS   50
+#define ARGUS_LOG_BATCH_SIZE 65536
+#define ARGUS_LOG_RETIRE_MS  10000
+
+/* Per-thread state: timestamp cache and, in async mode, the ring */
+typedef struct log_thread {
+    guint32            id;
+    gint64             ts_sec;       /* second ts_text was formatted for */
+    char               ts_text[24];  /* "YYYY-MM-DD HH:MM:SS" */
+    unsigned char     *ring;         /* NULL until the first async line */
+    volatile gint      head;         /* bytes written (producer) */
+    volatile gint      tail;         /* bytes consumed (drainer) */
+    volatile gint      dropped;      /* lines that did not fit */
+    gint               dropped_seen; /* drainer's share of dropped */
+    volatile gint      busy;         /* 1 owner pushing, -1 ring retired */
+    gint64             idle_since;   /* drainer: when the ring went empty */
+    struct log_thread *next;
+    struct log_thread *prev;
+} log_thread_t;
 
 /* Global log state */
 argus_log_level_t g_argus_log_level = ARGUS_LOG_OFF;
 static FILE *g_argus_log_file = NULL;
 static char *g_argus_log_file_path = NULL;
+static int g_argus_log_format = ARGUS_LOG_FORMAT_TEXT;
 
-#ifdef _WIN32
-static CRITICAL_SECTION g_argus_log_mutex;
-static bool g_argus_log_mutex_initialized = false;
-#else
-static pthread_mutex_t g_argus_log_mutex = PTHREAD_MUTEX_INITIALIZER;
-#endif
+/* g_log_mutex guards the output, the thread lists and the draining. The
+ * drainer walks g_log_threads only; a retired ring's state waits on
+ * g_log_retired until its thread logs again. */
+static GMutex        g_log_mutex;
+static log_thread_t *g_log_threads;
+static log_thread_t *g_log_retired;
+static guint32       g_log_next_id = 1;
+static gulong        g_log_dropped_total;
+static bool          g_log_async = true;
+
+/* Writer thread */
+static GMutex   g_log_wake_lock;
+static GCond    g_log_wake;
+static GThread *g_log_writer;
+static bool     g_log_stopping;
+static volatile gint g_log_writer_state;  /* 0 none, 1 running, -1 off */
+static volatile gint g_log_kicked;
+
+/* The calling thread's state, valid while its generation is current:
+ * argus_log_cleanup() frees every state and starts a new generation */
+static GPrivate g_log_thread_key = G_PRIVATE_INIT(NULL);
+static GPrivate g_log_thread_gen = G_PRIVATE_INIT(NULL);
+static volatile gint g_log_generation = 1;
 
 /* Level names for output */
 static const char *level_names[] = {
@@ -37,16 +90,380 @@ static const char *level_names[] = {
     "TRACE"
 };
 
-void argus_log_init(void)
+static void log_drain_locked(void);
+
+/* ── Per-thread state ────────────────────────────────────────── */
+
+static void log_thread_link(log_thread_t **list, log_thread_t *t)
 {
-#ifdef _WIN32
-    if (!g_argus_log_mutex_initialized) {
-        InitializeCriticalSection(&g_argus_log_mutex);
-        g_argus_log_mutex_initialized = true;
+    t->prev = NULL;
+    t->next = *list;
+    if (*list) (*list)->prev = t;
+    *list = t;
+}
+
+static void log_thread_unlink(log_thread_t **list, log_thread_t *t)
+{
+    if (t->prev) t->prev->next = t->next;
+    else *list = t->next;
+    if (t->next) t->next->prev = t->prev;
+    t->next = NULL;
+    t->prev = NULL;
+}
+
+static log_thread_t *log_thread_get(void)
+{
+    gint gen = g_atomic_int_get(&g_log_generation);
+    if (GPOINTER_TO_INT(g_private_get(&g_log_thread_gen)) == gen)
+        return g_private_get(&g_log_thread_key);
+
+    log_thread_t *t = calloc(1, sizeof(*t));
+    if (!t) return NULL;
+    t->ts_sec = -1;
+    g_mutex_lock(&g_log_mutex);
+    t->id = g_log_next_id++;
+    log_thread_link(&g_log_threads, t);
+    g_mutex_unlock(&g_log_mutex);
+    g_private_set(&g_log_thread_key, t);
+    g_private_set(&g_log_thread_gen, GINT_TO_POINTER(gen));
+    return t;
+}
+
+/* Owner side: claim the ring before pushing. A retired ring is gone; the
+ * mutex orders the claim after the drainer's free, and puts the state back
+ * on the drain walk. */
+static void log_thread_claim(log_thread_t *t)
+{
+    if (g_atomic_int_compare_and_exchange(&t->busy, 0, 1)) return;
+    g_mutex_lock(&g_log_mutex);
+    if (g_atomic_int_get(&t->busy) < 0) {
+        log_thread_unlink(&g_log_retired, t);
+        log_thread_link(&g_log_threads, t);
+    }
+    g_atomic_int_set(&t->busy, 1);
+    g_mutex_unlock(&g_log_mutex);
+}
+
+/* Drainer side, with g_log_mutex held and t's ring empty: free a ring its
+ * thread has not used for ARGUS_LOG_RETIRE_MS, unless the owner is pushing,
+ * and take t off the drain walk, so threads that have exited cost nothing */
+static void log_thread_retire_locked(log_thread_t *t, bool wrote)
+{
+    gint64 now = g_get_monotonic_time();
+    if (wrote || t->idle_since == 0) {
+        t->idle_since = now;
+        return;
+    }
+    if (now - t->idle_since < (gint64)ARGUS_LOG_RETIRE_MS * 1000 ||
+        !g_atomic_int_compare_and_exchange(&t->busy, 0, -1))
+        return;
+    /* The owner may have pushed since the drain */
+    if (g_atomic_int_get(&t->head) != t->tail) {
+        g_atomic_int_set(&t->busy, 0);
+        return;
     }
+    free(t->ring);
+    t->ring = NULL;
+    t->head = 0;
+    t->tail = 0;
+    t->idle_since = 0;
+    log_thread_unlink(&g_log_threads, t);
+    log_thread_link(&g_log_retired, t);
+}
+
+/* "YYYY-MM-DD HH:MM:SS.mmm", reformatting the date part once a second */
+static void log_timestamp(log_thread_t *t, gint64 now_us, char *out,
+                          size_t len)
+{
+    gint64 sec = now_us / G_USEC_PER_SEC;
+    int ms = (int)((now_us % G_USEC_PER_SEC) / 1000);
+    char local[24];
+    const char *date = local;
+
+    if (t && t->ts_sec == sec) {
+        date = t->ts_text;
+    } else {
+        time_t tt = (time_t)sec;
+        struct tm tm_info;
+#ifdef _WIN32
+        localtime_s(&tm_info, &tt);
+#else
+        localtime_r(&tt, &tm_info);
 #endif
+        strftime(local, sizeof(local), "%Y-%m-%d %H:%M:%S", &tm_info);
+        if (t) {
+            memcpy(t->ts_text, local, sizeof(local));
+            t->ts_sec = sec;
+        }
+    }
+    snprintf(out, len, "%s.%03d", date, ms);
+}
+
+/* ── Record formatting ───────────────────────────────────────── */
+
+/* Append s to buf as the body of a JSON string; returns the new length */
+static size_t json_escape(char *buf, size_t pos, size_t cap, const char *s)
+{
+    for (; *s && pos + 7 < cap; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            buf[pos++] = '\\';
+            buf[pos++] = (char)c;
+        } else if (c == '\n') {
+            buf[pos++] = '\\';
+            buf[pos++] = 'n';
+        } else if (c == '\r') {
+            buf[pos++] = '\\';
+            buf[pos++] = 'r';
+        } else if (c == '\t') {
+            buf[pos++] = '\\';
+            buf[pos++] = 't';
+        } else if (c < 0x20) {
+            pos += (size_t)snprintf(buf + pos, cap - pos, "\\u%04x", c);
+        } else {
+            buf[pos++] = (char)c;
+        }
+    }
+    return pos;
+}
+
+/* Format one record into buf (ARGUS_LOG_LINE_MAX bytes); returns its size.
+ * t, when given, is the calling thread's own state (timestamp cache). */
+static size_t log_format(char *buf, log_thread_t *t, guint32 tid,
+                         argus_log_level_t level, const char *filename,
+                         int line, const char *func, const char *msg)
+{
+    const size_t cap = ARGUS_LOG_LINE_MAX;
+    gint64 now = g_get_real_time();
+    size_t pos;
+
+    if (g_argus_log_format == ARGUS_LOG_FORMAT_BINARY) {
+        argus_log_record_t rec = {
+            .thread = tid, .time_us = now, .level = (uint8_t)level,
+            .line = (uint16_t)(line > 0xFFFF ? 0xFFFF : line),
+        };
+        pos = sizeof(rec);
+        const char *parts[3] = { filename, func, msg };
+        for (int i = 0; i < 3; i++) {
+            size_t n = strlen(parts[i]);
+            if (pos + n + 1 > cap) n = cap - pos - 1;
+            memcpy(buf + pos, parts[i], n);
+            pos += n;
+            buf[pos++] = '\0';
+            if (pos >= cap) break;
+        }
+        rec.size = (uint32_t)pos;
+        memcpy(buf, &rec, sizeof(rec));
+        return pos;
+    }
+
+    char ts[32];
+    log_timestamp(t, now, ts, sizeof(ts));
+
+    if (g_argus_log_format == ARGUS_LOG_FORMAT_JSON) {
+        pos = (size_t)snprintf(buf, cap,
+                               "{\"ts\":\"%s\",\"level\":\"%s\","
+                               "\"thread\":%u,\"src\":\"",
+                               ts, level_names[level], (unsigned)tid);
+        pos = json_escape(buf, pos, cap - 16, filename);
+        pos += (size_t)snprintf(buf + pos, cap - pos, ":%d\",\"func\":\"",
+                                line);
+        pos = json_escape(buf, pos, cap - 16, func);
+        pos += (size_t)snprintf(buf + pos, cap - pos, "\",\"msg\":\"");
+        pos = json_escape(buf, pos, cap - 3, msg);
+        buf[pos++] = '"';
+        buf[pos++] = '}';
+        buf[pos++] = '\n';
+        return pos;
+    }
+
+    int n = snprintf(buf, cap, "[%s] [%-5s] [t%u] [%s:%d %s] %s", ts,
+                     level_names[level], (unsigned)tid, filename, line,
+                     func, msg);
+    pos = (n < 0) ? 0 : ((size_t)n >= cap - 1 ? cap - 2 : (size_t)n);
+    buf[pos++] = '\n';
+    return pos;
+}
+
+/* ── Output ──────────────────────────────────────────────────── */
+
+static void log_output(const char *data, size_t len)
+{
+    FILE *out = g_argus_log_file ? g_argus_log_file : stderr;
+    fwrite(data, 1, len, out);
+}
+
+static char   g_log_batch[ARGUS_LOG_BATCH_SIZE];
+static size_t g_log_batch_len;
+
+static void log_batch_flush(void)
+{
+    if (g_log_batch_len > 0) {
+        log_output(g_log_batch, g_log_batch_len);
+        g_log_batch_len = 0;
+    }
+}
+
+static void log_batch_add(const unsigned char *data, size_t len)
+{
+    if (g_log_batch_len + len > sizeof(g_log_batch))
+        log_batch_flush();
+    memcpy(g_log_batch + g_log_batch_len, data, len);
+    g_log_batch_len += len;
+}
+
+/* ── Ring buffers ────────────────────────────────────────────── */
+
+static void ring_copy_in(log_thread_t *t, guint pos, const void *src,
+                         size_t len)
+{
+    size_t off = pos & (ARGUS_LOG_RING_SIZE - 1);
+    size_t first = ARGUS_LOG_RING_SIZE - off;
+    if (first > len) first = len;
+    memcpy(t->ring + off, src, first);
+    memcpy(t->ring, (const unsigned char *)src + first, len - first);
+}
+
+static void ring_copy_out(const log_thread_t *t, guint pos, void *dst,
+                          size_t len)
+{
+    size_t off = pos & (ARGUS_LOG_RING_SIZE - 1);
+    size_t first = ARGUS_LOG_RING_SIZE - off;
+    if (first > len) first = len;
+    memcpy(dst, t->ring + off, first);
+    memcpy((unsigned char *)dst + first, t->ring, len - first);
+}
+
+/* Producer side: append [uint32 size][record]; false if it does not fit */
+static bool ring_push(log_thread_t *t, const char *rec, size_t len)
+{
+    guint head = (guint)t->head;           /* only this thread writes it */
+    guint tail = (guint)g_atomic_int_get(&t->tail);
+    guint32 size = (guint32)len;
+    guint need = (guint)(sizeof(size) + len);
+
+    if (ARGUS_LOG_RING_SIZE - (head - tail) < need)
+        return false;
+    ring_copy_in(t, head, &size, sizeof(size));
+    ring_copy_in(t, head + (guint)sizeof(size), rec, len);
+    g_atomic_int_set(&t->head, (gint)(head + need));
+
+    /* Half full: wake the writer instead of waiting for its tick */
+    if (head + need - tail > ARGUS_LOG_RING_SIZE / 2 &&
+        g_atomic_int_compare_and_exchange(&g_log_kicked, 0, 1)) {
+        g_mutex_lock(&g_log_wake_lock);
+        g_cond_signal(&g_log_wake);
+        g_mutex_unlock(&g_log_wake_lock);
+    }
+    return true;
+}
+
+/* Report lines a thread dropped since the last drain */
+static void log_report_dropped(log_thread_t *t)
+{
+    gint dropped = g_atomic_int_get(&t->dropped);
+    if (dropped == t->dropped_seen) return;
+
+    unsigned n = (unsigned)(dropped - t->dropped_seen);
+    t->dropped_seen = dropped;
+    g_log_dropped_total += n;
+
+    char msg[96], rec[ARGUS_LOG_LINE_MAX];
+    snprintf(msg, sizeof(msg),
+             "%u log line(s) dropped: the log writer fell behind", n);
+    /* Not t's thread: leave its timestamp cache alone */
+    size_t len = log_format(rec, NULL, t->id, ARGUS_LOG_WARN, "log.c",
+                            __LINE__, "argus_log_write", msg);
+    log_batch_add((const unsigned char *)rec, len);
+}
+
+/* Consumer side: move every ring's records to the output. Called with
+ * g_log_mutex held. */
+static void log_drain_locked(void)
+{
+    log_thread_t *next;
+    for (log_thread_t *t = g_log_threads; t; t = next) {
+        next = t->next;     /* retiring t moves it to g_log_retired */
+        if (t->ring) {
+            guint tail = (guint)t->tail;   /* only the drainer writes it */
+            guint head = (guint)g_atomic_int_get(&t->head);
+            bool wrote = tail != head;
+            unsigned char rec[ARGUS_LOG_LINE_MAX];
+            while (tail != head) {
+                guint32 size;
+                ring_copy_out(t, tail, &size, sizeof(size));
+                ring_copy_out(t, tail + (guint)sizeof(size), rec, size);
+                log_batch_add(rec, size);
+                tail += (guint)sizeof(size) + size;
+            }
+            g_atomic_int_set(&t->tail, (gint)tail);
+            log_thread_retire_locked(t, wrote);
+        }
+        log_report_dropped(t);
+    }
+    log_batch_flush();
+    FILE *out = g_argus_log_file ? g_argus_log_file : stderr;
+    fflush(out);
+}
+
+static gpointer log_writer_run(gpointer data)
+{
+    (void)data;
+    g_mutex_lock(&g_log_wake_lock);
+    while (!g_log_stopping) {
+        gint64 deadline = g_get_monotonic_time() + ARGUS_LOG_DRAIN_MS * 1000;
+        while (!g_log_stopping && !g_atomic_int_get(&g_log_kicked) &&
+               g_cond_wait_until(&g_log_wake, &g_log_wake_lock, deadline))
+            ;
+        g_atomic_int_set(&g_log_kicked, 0);
+        g_mutex_unlock(&g_log_wake_lock);
+
+        g_mutex_lock(&g_log_mutex);
+        log_drain_locked();
+        g_mutex_unlock(&g_log_mutex);
+
+        g_mutex_lock(&g_log_wake_lock);
+    }
+    g_mutex_unlock(&g_log_wake_lock);
+    return NULL;
+}
+
+/* Start the writer on first use; false means write synchronously */
+static bool log_writer_ready(void)
+{
+    gint state = g_atomic_int_get(&g_log_writer_state);
+    if (state != 0) return state > 0;
 
+    g_mutex_lock(&g_log_mutex);
+    if (g_atomic_int_get(&g_log_writer_state) == 0) {
+        g_mutex_lock(&g_log_wake_lock);
+        g_log_stopping = false;
+        g_mutex_unlock(&g_log_wake_lock);
+        g_log_writer = g_log_async
+            ? g_thread_try_new("argus-log", log_writer_run, NULL, NULL)
+            : NULL;
+        g_atomic_int_set(&g_log_writer_state, g_log_writer ? 1 : -1);
+    }
+    g_mutex_unlock(&g_log_mutex);
+    return g_atomic_int_get(&g_log_writer_state) > 0;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void argus_log_init(void)
+{
     /* Check environment variables for defaults */
+    const char *env_async = getenv("ARGUS_LOG_ASYNC");
+    if (env_async && strcmp(env_async, "0") == 0)
+        g_log_async = false;
+
+    const char *env_format = getenv("ARGUS_LOG_FORMAT");
+    if (env_format) {
+        int format = argus_log_format_from_string(env_format);
+        if (format >= 0)
+            g_argus_log_format = format;
+    }
+
     const char *env_level = getenv("ARGUS_LOG_LEVEL");
     if (env_level) {
         int level = atoi(env_level);
@@ -63,13 +480,32 @@ void argus_log_init(void)
 
 void argus_log_cleanup(void)
 {
-#ifdef _WIN32
-    if (g_argus_log_mutex_initialized) {
-        EnterCriticalSection(&g_argus_log_mutex);
+    /* Stop the writer, then write out what it left behind */
+    g_mutex_lock(&g_log_wake_lock);
+    g_log_stopping = true;
+    g_cond_signal(&g_log_wake);
+    g_mutex_unlock(&g_log_wake_lock);
+    if (g_log_writer) {
+        g_thread_join(g_log_writer);
+        g_log_writer = NULL;
+    }
+
+    g_mutex_lock(&g_log_mutex);
+    log_drain_locked();
+    /* Later lines (other unload hooks) are written synchronously */
+    g_atomic_int_set(&g_log_writer_state, -1);
+
+    /* Forget every thread's state; a thread that logs again starts anew */
+    g_atomic_int_inc(&g_log_generation);
+    log_thread_t **lists[] = { &g_log_threads, &g_log_retired };
+    for (size_t i = 0; i < G_N_ELEMENTS(lists); i++) {
+        while (*lists[i]) {
+            log_thread_t *t = *lists[i];
+            *lists[i] = t->next;
+            free(t->ring);
+            free(t);
+        }
     }
-#else
-    pthread_mutex_lock(&g_argus_log_mutex);
-#endif
 
     if (g_argus_log_file && g_argus_log_file != stderr) {
         fclose(g_argus_log_file);
@@ -80,16 +516,7 @@ void argus_log_cleanup(void)
         free(g_argus_log_file_path);
         g_argus_log_file_path = NULL;
     }
-
-#ifdef _WIN32
-    if (g_argus_log_mutex_initialized) {
-        LeaveCriticalSection(&g_argus_log_mutex);
-        DeleteCriticalSection(&g_argus_log_mutex);
-        g_argus_log_mutex_initialized = false;
-    }
-#else
-    pthread_mutex_unlock(&g_argus_log_mutex);
-#endif
+    g_mutex_unlock(&g_log_mutex);
 }
 
 void argus_log_set_level(int level)
@@ -104,15 +531,38 @@ int argus_log_get_level(void)
     return g_argus_log_level;
 }
 
+void argus_log_set_format(int format)
+{
+    if (format < ARGUS_LOG_FORMAT_TEXT || format > ARGUS_LOG_FORMAT_BINARY)
+        return;
+    g_mutex_lock(&g_log_mutex);
+    /* Queued records keep the format they were written in */
+    log_drain_locked();
+    g_argus_log_format = format;
+    g_mutex_unlock(&g_log_mutex);
+}
+
+int argus_log_get_format(void)
+{
+    return g_argus_log_format;
+}
+
+int argus_log_format_from_string(const char *name)
+{
+    if (!name) return -1;
+    if (g_ascii_strcasecmp(name, "text") == 0) return ARGUS_LOG_FORMAT_TEXT;
+    if (g_ascii_strcasecmp(name, "json") == 0) return ARGUS_LOG_FORMAT_JSON;
+    if (g_ascii_strcasecmp(name, "binary") == 0)
+        return ARGUS_LOG_FORMAT_BINARY;
+    return -1;
+}
+
 void argus_log_set_file(const char *path)
 {
-#ifdef _WIN32
-    if (g_argus_log_mutex_initialized) {
-        EnterCriticalSection(&g_argus_log_mutex);
-    }
-#else
-    pthread_mutex_lock(&g_argus_log_mutex);
-#endif
+    g_mutex_lock(&g_log_mutex);
+
+    /* Lines queued so far belong to the old file */
+    log_drain_locked();
 
     /* Close old file if not stderr */
     if (g_argus_log_file && g_argus_log_file != stderr) {
@@ -126,13 +576,15 @@ void argus_log_set_file(const char *path)
         g_argus_log_file_path = NULL;
     }
 
-    /* Open new file or use stderr */
+    /* Open new file or use stderr. Binary mode: BINARY records must not
+     * get newline translation on Windows. */
     if (path && path[0]) {
-        FILE *fp = fopen(path, "a");
+        FILE *fp = fopen(path, "ab");
         if (fp) {
             g_argus_log_file = fp;
             g_argus_log_file_path = strdup(path);
-            /* Disable buffering for immediate flush */
+            /* Each line (sync) or drain (async) is one fwrite: no stdio
+             * buffer needed on top */
             setvbuf(fp, NULL, _IONBF, 0);
         } else {
             /* Fallback to stderr on error */
@@ -142,13 +594,22 @@ void argus_log_set_file(const char *path)
         g_argus_log_file = stderr;
     }
 
-#ifdef _WIN32
-    if (g_argus_log_mutex_initialized) {
-        LeaveCriticalSection(&g_argus_log_mutex);
-    }
-#else
-    pthread_mutex_unlock(&g_argus_log_mutex);
-#endif
+    g_mutex_unlock(&g_log_mutex);
+}
+
+void argus_log_flush(void)
+{
+    g_mutex_lock(&g_log_mutex);
+    log_drain_locked();
+    g_mutex_unlock(&g_log_mutex);
+}
+
+unsigned long argus_log_dropped(void)
+{
+    g_mutex_lock(&g_log_mutex);
+    unsigned long total = g_log_dropped_total;
+    g_mutex_unlock(&g_log_mutex);
+    return total;
 }
 
 void argus_log_write(argus_log_level_t level, const char *file, int line,
@@ -158,22 +619,6 @@ void argus_log_write(argus_log_level_t level, const char *file, int line,
         return;
     }
 
-#ifdef _WIN32
-    if (g_argus_log_mutex_initialized) {
-        EnterCriticalSection(&g_argus_log_mutex);
-    }
-#else
-    pthread_mutex_lock(&g_argus_log_mutex);
-#endif
-
-    FILE *out = g_argus_log_file ? g_argus_log_file : stderr;
-
-    /* Timestamp */
-    time_t now = time(NULL);
-    struct tm *tm_info = localtime(&now);
-    char timestamp[32];
-    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", tm_info);
-
     /* Extract just the filename (not full path) */
     const char *filename = strrchr(file, '/');
     if (!filename) {
@@ -181,27 +626,38 @@ void argus_log_write(argus_log_level_t level, const char *file, int line,
     }
     filename = filename ? filename + 1 : file;
 
-    /* Print log prefix */
-    fprintf(out, "[%s] [%-5s] [%s:%d %s] ",
-            timestamp,
-            level_names[level],
-            filename,
-            line,
-            func);
-
-    /* Print message */
+    char msg[ARGUS_LOG_LINE_MAX];
     va_list args;
     va_start(args, fmt);
-    vfprintf(out, fmt, args);
+    vsnprintf(msg, sizeof(msg), fmt, args);
     va_end(args);
 
-    fprintf(out, "\n");
+    log_thread_t *t = log_thread_get();
+    char rec[ARGUS_LOG_LINE_MAX];
+    size_t len = log_format(rec, t, t ? t->id : 0, level, filename, line,
+                            func, msg);
 
-#ifdef _WIN32
-    if (g_argus_log_mutex_initialized) {
-        LeaveCriticalSection(&g_argus_log_mutex);
+    if (t && log_writer_ready()) {
+        log_thread_claim(t);
+        if (!t->ring) {
+            unsigned char *ring = malloc(ARGUS_LOG_RING_SIZE);
+            /* The drainer reads t->ring under the mutex */
+            g_mutex_lock(&g_log_mutex);
+            t->ring = ring;
+            g_mutex_unlock(&g_log_mutex);
+        }
+        bool queued = t->ring != NULL;
+        if (queued && !ring_push(t, rec, len))
+            g_atomic_int_inc(&t->dropped);
+        g_atomic_int_set(&t->busy, 0);
+        if (queued) {
+            if (level == ARGUS_LOG_FATAL)
+                argus_log_flush();
+            return;
+        }
     }
-#else
-    pthread_mutex_unlock(&g_argus_log_mutex);
-#endif
+
+    g_mutex_lock(&g_log_mutex);
+    log_output(rec, len);
+    g_mutex_unlock(&g_log_mutex);
 }
@@ -2,222 +2,1210 @@
  * Metadata cache for SQLTables/SQLColumns results.
  *
  * BI tools (Tableau, Power BI) call SQLTables and SQLColumns repeatedly
- * during connection setup. Each call triggers a full SQL query to the backend.
- * This cache stores the results of these calls with a TTL, avoiding redundant
- * round-trips.
+ * during connection setup, and open many connections. Each call triggers a
+ * full SQL query to the backend. This cache stores the results of these
+ * calls process-wide, so every connection with the same backend, host,
+ * port, user and database shares them.
  *
- * Cache key: concatenation of function name + arguments.
- * Cache value: deep copy of the row_cache + column metadata.
- * TTL: 60 seconds (configurable via ARGUS_METADATA_CACHE_TTL_SEC).
+ * Cache key: connection identity + function name + arguments.
+ * Cache value: immutable, reference-counted row set + column metadata. A hit
+ * lends the rows to the statement's row cache (`borrowed`) instead of
+ * copying them; the statement holds a reference until it is reset.
+ * TTL: METADATACACHETTL (default 60 s, 0 disables the cache), overridable per
+ * function with TABLESCACHETTL / COLUMNSCACHETTL. For METADATACACHESTALE
+ * seconds past the TTL an entry is still served while a background thread
+ * refreshes it on an idle pooled connection of the same identity; without
+ * one, the entry simply expires.
+ * DDL executed through the driver drops the entries of its identity.
+ * With METADATACACHEFILE, the cache is loaded from that file on first use
+ * and written back when the environment is freed.
+ *
+ * CATALOGSNAPSHOT answers SQLTables/SQLColumns from one bulk entry per
+ * catalog and schema scope instead of one entry per argument combination:
+ * the entry is filtered locally through an index sorted by schema and table
+ * name, built the first time the entry is searched.
  */
 #include "argus/handle.h"
 #include "argus/log.h"
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <glib.h>
 
-#define ARGUS_METADATA_CACHE_TTL_SEC 60
+#define ARGUS_METADATA_CACHE_MAX_ENTRIES 4096
+#define ARGUS_METADATA_CACHE_FETCH_ROWS  10000
+#define ARGUS_METADATA_CACHE_MAX_ROWS    1000000   /* per entry */
+
+#define MDC_FILE_MAGIC   "ARGUSMDC"
+#define MDC_FILE_VERSION 1u
 
 /* ── Cache entry ─────────────────────────────────────────────── */
 
+/* Snapshot index slot; the names point into the entry's rows */
 typedef struct {
-    argus_row_cache_t    row_cache;
+    const char *schema;
+    const char *table;
+    guint32     row;
+} snapshot_key_t;
+
+typedef struct {
+    char                *key;
+    char                *func;
+    char                *args[4];
+    /* Identity, for refreshing on a pooled connection */
+    char                *backend_name;
+    char                *host;
+    char                *user;
+    int                  port;
+
+    argus_row_cache_t    row_cache;    /* immutable once published */
     argus_column_desc_t *columns;
     int                  num_cols;
-    gint64               created_at;   /* monotonic microseconds */
+    gint64               created_at;   /* real time, microseconds */
+    gint                 refcount;
+    gint                 refreshing;   /* a refresh thread is running */
+    snapshot_key_t      *index;        /* snapshot search order, lazy */
 } cache_entry_t;
 
-static void cache_entry_free(gpointer data)
+static GMutex      mdc_lock;
+static GHashTable *mdc_table;          /* key -> cache_entry_t* */
+static GCond       mdc_refresh_done;
+static int         mdc_refreshes;      /* refresh threads in flight */
+static char       *mdc_file;           /* persistence path, or NULL */
+static bool        mdc_file_loaded;
+
+static void entry_unref(cache_entry_t *entry)
 {
-    cache_entry_t *entry = (cache_entry_t *)data;
-    if (!entry) return;
+    if (!entry || !g_atomic_int_dec_and_test(&entry->refcount)) return;
 
     argus_row_cache_free(&entry->row_cache);
     free(entry->columns);
+    free(entry->index);
+    free(entry->key);
+    free(entry->func);
+    for (int i = 0; i < 4; i++) free(entry->args[i]);
+    free(entry->backend_name);
+    free(entry->host);
+    free(entry->user);
     free(entry);
 }
 
-/* ── Deep-copy a row cache ───────────────────────────────────── */
+static void table_ensure_locked(void)
+{
+    if (!mdc_table)
+        mdc_table = g_hash_table_new_full(g_str_hash, g_str_equal, NULL,
+                                          (GDestroyNotify)entry_unref);
+}
+
+static char *dup_or_null(const char *s)
+{
+    return s ? strdup(s) : NULL;
+}
+
+/* ── Keys ────────────────────────────────────────────────────── */
+
+static const char *identity_host(const argus_dbc_t *dbc)
+{
+    const char *host = dbc->connected_host ? dbc->connected_host : dbc->host;
+    return host ? host : "";
+}
+
+static int identity_port(const argus_dbc_t *dbc)
+{
+    return dbc->connected_host ? dbc->connected_port : dbc->port;
+}
 
-static bool row_cache_deep_copy(argus_row_cache_t *dst,
-                                 const argus_row_cache_t *src)
+static char *identity_prefix(const argus_dbc_t *dbc)
 {
-    memset(dst, 0, sizeof(*dst));
-    if (src->num_rows == 0) {
-        dst->exhausted = src->exhausted;
-        dst->num_cols = src->num_cols;
-        return true;
+    return g_strdup_printf("%s|%s:%d|%s|%s\n",
+                           dbc->backend_name ? dbc->backend_name : "",
+                           identity_host(dbc), identity_port(dbc),
+                           dbc->username ? dbc->username : "",
+                           dbc->database ? dbc->database : "");
+}
+
+static char *build_cache_key(const argus_dbc_t *dbc, const char *func,
+                              const char *a1, const char *a2,
+                              const char *a3, const char *a4)
+{
+    char *prefix = identity_prefix(dbc);
+    char *key = g_strdup_printf("%s%s|%s|%s|%s|%s", prefix, func,
+                                a1 ? a1 : "", a2 ? a2 : "",
+                                a3 ? a3 : "", a4 ? a4 : "");
+    g_free(prefix);
+    /* Entries free keys with free() */
+    char *out = strdup(key);
+    g_free(key);
+    return out;
+}
+
+static int ttl_for(const argus_dbc_t *dbc, const char *func)
+{
+    int ttl = -1;
+    if (strcmp(func, "SQLTables") == 0)
+        ttl = dbc->tables_cache_ttl_sec;
+    else if (strcmp(func, "SQLColumns") == 0)
+        ttl = dbc->columns_cache_ttl_sec;
+    return ttl >= 0 ? ttl : dbc->metadata_cache_ttl_sec;
+}
+
+/* Insert or replace an entry; the table takes the caller's reference.
+ * Caller holds mdc_lock. */
+static void publish_locked(cache_entry_t *entry)
+{
+    table_ensure_locked();
+
+    if (!g_hash_table_contains(mdc_table, entry->key) &&
+        g_hash_table_size(mdc_table) >= ARGUS_METADATA_CACHE_MAX_ENTRIES) {
+        /* Make room by dropping the oldest entry */
+        GHashTableIter iter;
+        gpointer k, v;
+        cache_entry_t *oldest = NULL;
+        g_hash_table_iter_init(&iter, mdc_table);
+        while (g_hash_table_iter_next(&iter, &k, &v)) {
+            cache_entry_t *e = (cache_entry_t *)v;
+            if (!oldest || e->created_at < oldest->created_at) oldest = e;
+        }
+        if (oldest) g_hash_table_remove(mdc_table, oldest->key);
     }
+    g_hash_table_replace(mdc_table, entry->key, entry);
+}
 
-    dst->rows = calloc(src->num_rows, sizeof(argus_row_t));
-    if (!dst->rows) return false;
+/* Lend an entry's rows to stmt. Takes over the caller's reference. */
+static void attach_entry(argus_stmt_t *stmt, cache_entry_t *entry)
+{
+    argus_metadata_cache_release(stmt);
+    argus_row_cache_free(&stmt->row_cache);
+    stmt->row_cache = entry->row_cache;
+    stmt->row_cache.borrowed = true;
+    stmt->row_cache.exhausted = true;
+    stmt->row_cache.current_row = 0;
+    stmt->metadata_ref = entry;
 
-    dst->num_rows = src->num_rows;
-    dst->capacity = src->num_rows;
-    dst->num_cols = src->num_cols;
-    dst->exhausted = src->exhausted;
-    dst->current_row = 0;
+    memcpy(stmt->columns, entry->columns,
+           (size_t)entry->num_cols * sizeof(argus_column_desc_t));
+    stmt->num_cols = entry->num_cols;
+    stmt->metadata_fetched = true;
+    stmt->executed = true;
+    /* Rows are already in the cache (and exhausted); mark the fetch as started
+     * so SQLFetch iterates the cache instead of re-fetching from the backend
+     * (there is no backend op on a cache hit — that would clear the cache and
+     * fetch with a NULL op). */
+    stmt->fetch_started = true;
+}
+
+/*
+ * Fetch every remaining row of op into out. Backends reuse the row array of
+ * the cache they fill, so each batch is moved out of a scratch cache.
+ * Fails past ARGUS_METADATA_CACHE_MAX_ROWS.
+ */
+static int fetch_all(const argus_backend_t *backend, argus_backend_conn_t conn,
+                     argus_backend_op_t op, argus_column_desc_t *cols,
+                     int ncols, argus_row_cache_t *out)
+{
+    argus_row_cache_t batch;
+    argus_row_cache_init(&batch);
+    argus_row_cache_init(out);
+    out->num_cols = ncols;
+
+    int rc = 0;
+    while (rc == 0 && !batch.exhausted) {
+        int fetched_cols = 0;
+        argus_row_cache_clear(&batch);
+        rc = backend->fetch_results(conn, op, ARGUS_METADATA_CACHE_FETCH_ROWS,
+                                    &batch, cols, &fetched_cols);
+        if (rc != 0 || batch.num_rows == 0) break;
+
+        size_t need = out->num_rows + batch.num_rows;
+        if (need > ARGUS_METADATA_CACHE_MAX_ROWS) {
+            rc = -1;
+            break;
+        }
+        if (need > out->capacity) {
+            size_t cap = out->capacity ? out->capacity * 2 : batch.num_rows;
+            while (cap < need) cap *= 2;
+            argus_row_t *rows = realloc(out->rows, cap * sizeof(argus_row_t));
+            if (!rows) {
+                rc = -1;
+                break;
+            }
+            out->rows = rows;
+            out->capacity = cap;
+        }
+        for (size_t i = 0; i < batch.num_rows; i++) {
+            out->rows[out->num_rows++] = batch.rows[i];
+            batch.rows[i].cells = NULL;
+        }
+    }
+    batch.num_cols = ncols;
+    argus_row_cache_free(&batch);
+    out->exhausted = true;
+    if (rc != 0)
+        argus_row_cache_free(out);
+    return rc;
+}
+
+/* ── Background refresh ──────────────────────────────────────── */
+
+typedef struct {
+    cache_entry_t          *stale;
+    const argus_backend_t  *backend;
+    argus_backend_conn_t    conn;
+} refresh_job_t;
+
+static gpointer refresh_worker(gpointer data)
+{
+    refresh_job_t *job = (refresh_job_t *)data;
+    cache_entry_t *stale = job->stale;
+    const argus_backend_t *backend = job->backend;
+    argus_backend_op_t op = NULL;
+
+    int rc;
+    if (strcmp(stale->func, "SQLTables") == 0)
+        rc = backend->get_tables(job->conn, stale->args[0], stale->args[1],
+                                 stale->args[2], stale->args[3], &op);
+    else
+        rc = backend->get_columns(job->conn, stale->args[0], stale->args[1],
+                                  stale->args[2], stale->args[3], &op);
 
-    for (size_t r = 0; r < src->num_rows; r++) {
-        const argus_row_t *src_row = &src->rows[r];
-        argus_row_t *dst_row = &dst->rows[r];
+    cache_entry_t *fresh = calloc(1, sizeof(*fresh));
+    argus_column_desc_t cols[64];
+    int ncols = 0;
+    if (rc == 0 && fresh && backend->get_result_metadata)
+        rc = backend->get_result_metadata(job->conn, op, cols, &ncols);
+    if (rc == 0 && fresh && ncols > 0 && ncols <= 64) {
+        rc = fetch_all(backend, job->conn, op, cols, ncols,
+                       &fresh->row_cache);
+    } else {
+        rc = -1;
+    }
+    if (op) backend->close_operation(job->conn, op);
+    argus_pool_release(stale->host, stale->port, stale->backend_name,
+                       stale->user, backend, job->conn);
 
-        if (!src_row->cells) continue;
+    if (rc == 0) {
+        fresh->columns = malloc((size_t)ncols * sizeof(argus_column_desc_t));
+        fresh->key = strdup(stale->key);
+        fresh->func = strdup(stale->func);
+        for (int i = 0; i < 4; i++) fresh->args[i] = dup_or_null(stale->args[i]);
+        fresh->backend_name = strdup(stale->backend_name);
+        fresh->host = strdup(stale->host);
+        fresh->user = strdup(stale->user);
+        if (!fresh->columns || !fresh->key || !fresh->func ||
+            !fresh->backend_name || !fresh->host || !fresh->user)
+            rc = -1;
+    }
+    if (rc == 0) {
+        memcpy(fresh->columns, cols, (size_t)ncols * sizeof(argus_column_desc_t));
+        fresh->num_cols = ncols;
+        fresh->row_cache.num_cols = ncols;
+        fresh->row_cache.exhausted = true;
+        fresh->port = stale->port;
+        fresh->created_at = g_get_real_time();
+        fresh->refcount = 1;
 
-        dst_row->cells = calloc((size_t)src->num_cols, sizeof(argus_cell_t));
-        if (!dst_row->cells) goto fail;
+        g_mutex_lock(&mdc_lock);
+        /* Only replace what we refreshed: DDL may have dropped it meanwhile */
+        if (mdc_table && g_hash_table_lookup(mdc_table, stale->key) == stale) {
+            publish_locked(fresh);
+            fresh = NULL;
+        }
+        g_mutex_unlock(&mdc_lock);
+        ARGUS_LOG_DEBUG("Metadata cache refreshed %s in the background",
+                        stale->func);
+    } else {
+        ARGUS_LOG_DEBUG("Metadata cache: background refresh of %s failed",
+                        stale->func);
+    }
+    if (fresh) {
+        fresh->refcount = 1;
+        entry_unref(fresh);
+    }
 
-        for (int c = 0; c < src->num_cols; c++) {
-            dst_row->cells[c].is_null = src_row->cells[c].is_null;
-            dst_row->cells[c].data_len = src_row->cells[c].data_len;
-            if (src_row->cells[c].data) {
-                dst_row->cells[c].data = malloc(src_row->cells[c].data_len + 1);
-                if (!dst_row->cells[c].data) goto fail;
-                memcpy(dst_row->cells[c].data, src_row->cells[c].data,
-                       src_row->cells[c].data_len + 1);
+    g_atomic_int_set(&stale->refreshing, 0);
+    entry_unref(stale);
+    free(job);
+
+    g_mutex_lock(&mdc_lock);
+    mdc_refreshes--;
+    g_cond_broadcast(&mdc_refresh_done);
+    g_mutex_unlock(&mdc_lock);
+    return NULL;
+}
+
+/*
+ * Start refreshing a stale entry on an idle pooled connection. Returns false
+ * (and leaves the entry alone) when there is none to borrow.
+ */
+static bool start_refresh(cache_entry_t *entry)
+{
+    if (!g_atomic_int_compare_and_exchange(&entry->refreshing, 0, 1))
+        return true;    /* already being refreshed */
+
+    const argus_backend_t *backend = NULL;
+    argus_backend_conn_t conn = argus_pool_acquire(
+        entry->host, entry->port, entry->backend_name, entry->user, &backend);
+    if (!conn || !backend || !backend->get_tables || !backend->get_columns ||
+        !backend->fetch_results) {
+        if (conn)
+            argus_pool_release(entry->host, entry->port, entry->backend_name,
+                               entry->user, backend, conn);
+        g_atomic_int_set(&entry->refreshing, 0);
+        return false;
+    }
+
+    refresh_job_t *job = calloc(1, sizeof(*job));
+    if (job) {
+        job->stale = entry;
+        job->backend = backend;
+        job->conn = conn;
+        g_atomic_int_inc(&entry->refcount);
+
+        g_mutex_lock(&mdc_lock);
+        mdc_refreshes++;
+        g_mutex_unlock(&mdc_lock);
+
+        GError *error = NULL;
+        GThread *thread = g_thread_try_new("argus-mdc-refresh",
+                                           refresh_worker, job, &error);
+        if (thread) {
+            g_thread_unref(thread);
+            return true;
+        }
+        if (error) g_error_free(error);
+        g_mutex_lock(&mdc_lock);
+        mdc_refreshes--;
+        g_mutex_unlock(&mdc_lock);
+        g_atomic_int_dec_and_test(&entry->refcount); /* table still holds one */
+        free(job);
+    }
+    argus_pool_release(entry->host, entry->port, entry->backend_name,
+                       entry->user, backend, conn);
+    g_atomic_int_set(&entry->refreshing, 0);
+    return false;
+}
+
+/* ── Persistence ─────────────────────────────────────────────── */
+
+static void put_u32(GByteArray *b, uint32_t v)
+{
+    g_byte_array_append(b, (const guint8 *)&v, sizeof(v));
+}
+
+static void put_u64(GByteArray *b, uint64_t v)
+{
+    g_byte_array_append(b, (const guint8 *)&v, sizeof(v));
+}
+
+static void put_str(GByteArray *b, const char *s)
+{
+    if (!s) {
+        put_u32(b, UINT32_MAX);
+        return;
+    }
+    uint32_t n = (uint32_t)strlen(s);
+    put_u32(b, n);
+    g_byte_array_append(b, (const guint8 *)s, n);
+}
+
+static void put_entry(GByteArray *b, const cache_entry_t *e)
+{
+    put_str(b, e->key);
+    put_str(b, e->func);
+    for (int i = 0; i < 4; i++) put_str(b, e->args[i]);
+    put_str(b, e->backend_name);
+    put_str(b, e->host);
+    put_str(b, e->user);
+    put_u32(b, (uint32_t)e->port);
+    put_u64(b, (uint64_t)e->created_at);
+    put_u32(b, (uint32_t)e->num_cols);
+    g_byte_array_append(b, (const guint8 *)e->columns,
+                        (guint)((size_t)e->num_cols * sizeof(argus_column_desc_t)));
+    put_u64(b, (uint64_t)e->row_cache.num_rows);
+    for (size_t r = 0; r < e->row_cache.num_rows; r++) {
+        const argus_cell_t *cells = e->row_cache.rows[r].cells;
+        guint8 has = cells ? 1 : 0;
+        g_byte_array_append(b, &has, 1);
+        if (!cells) continue;
+        for (int c = 0; c < e->num_cols; c++) {
+            guint8 flags[2] = { cells[c].is_null ? 1 : 0, cells[c].native_kind };
+            g_byte_array_append(b, flags, 2);
+            g_byte_array_append(b, (const guint8 *)&cells[c].native,
+                                sizeof(cells[c].native));
+            if (cells[c].data) {
+                put_u64(b, (uint64_t)cells[c].data_len);
+                g_byte_array_append(b, (const guint8 *)cells[c].data,
+                                    (guint)cells[c].data_len);
+            } else {
+                put_u64(b, UINT64_MAX);
             }
         }
     }
+}
+
+typedef struct {
+    const guint8 *p;
+    size_t        left;
+    bool          bad;
+} reader_t;
+
+static bool get_bytes(reader_t *r, void *out, size_t n)
+{
+    if (r->bad || r->left < n) {
+        r->bad = true;
+        return false;
+    }
+    memcpy(out, r->p, n);
+    r->p += n;
+    r->left -= n;
     return true;
+}
 
-fail:
-    argus_row_cache_free(dst);
-    return false;
+static uint32_t get_u32(reader_t *r)
+{
+    uint32_t v = 0;
+    get_bytes(r, &v, sizeof(v));
+    return v;
 }
 
-/* ── Build cache key ─────────────────────────────────────────── */
+static uint64_t get_u64(reader_t *r)
+{
+    uint64_t v = 0;
+    get_bytes(r, &v, sizeof(v));
+    return v;
+}
 
-static char *build_cache_key(const char *func,
-                              const char *a1, const char *a2,
-                              const char *a3, const char *a4)
+static char *get_str(reader_t *r)
 {
-    char key[2048];
-    snprintf(key, sizeof(key), "%s|%s|%s|%s|%s",
-             func,
-             a1 ? a1 : "",
-             a2 ? a2 : "",
-             a3 ? a3 : "",
-             a4 ? a4 : "");
-    return strdup(key);
+    uint32_t n = get_u32(r);
+    if (r->bad || n == UINT32_MAX) return NULL;
+    if (n > r->left) {
+        r->bad = true;
+        return NULL;
+    }
+    char *s = malloc((size_t)n + 1);
+    if (!s) {
+        r->bad = true;
+        return NULL;
+    }
+    get_bytes(r, s, n);
+    s[n] = '\0';
+    return s;
 }
 
-/* ── Public API ──────────────────────────────────────────────── */
+static cache_entry_t *get_entry(reader_t *r)
+{
+    cache_entry_t *e = calloc(1, sizeof(*e));
+    if (!e) return NULL;
+    e->refcount = 1;
+    e->key = get_str(r);
+    e->func = get_str(r);
+    for (int i = 0; i < 4; i++) e->args[i] = get_str(r);
+    e->backend_name = get_str(r);
+    e->host = get_str(r);
+    e->user = get_str(r);
+    e->port = (int)get_u32(r);
+    e->created_at = (gint64)get_u64(r);
+    uint32_t ncols = get_u32(r);
+    if (r->bad || !e->key || !e->func || !e->backend_name || !e->host ||
+        !e->user || ncols == 0 || ncols > ARGUS_MAX_COLUMNS)
+        goto fail;
+    e->num_cols = (int)ncols;
+    e->columns = malloc(ncols * sizeof(argus_column_desc_t));
+    if (!e->columns ||
+        !get_bytes(r, e->columns, ncols * sizeof(argus_column_desc_t)))
+        goto fail;
 
-void argus_metadata_cache_init(argus_dbc_t *dbc)
+    uint64_t nrows = get_u64(r);
+    if (r->bad || nrows > r->left) goto fail;   /* >= 1 byte per row */
+    e->row_cache.num_cols = e->num_cols;
+    e->row_cache.exhausted = true;
+    if (nrows > 0) {
+        e->row_cache.rows = calloc((size_t)nrows, sizeof(argus_row_t));
+        if (!e->row_cache.rows) goto fail;
+        e->row_cache.capacity = (size_t)nrows;
+    }
+    for (uint64_t i = 0; i < nrows; i++) {
+        guint8 has = 0;
+        if (!get_bytes(r, &has, 1)) goto fail;
+        e->row_cache.num_rows++;
+        if (!has) continue;
+        argus_cell_t *cells = calloc(ncols, sizeof(argus_cell_t));
+        if (!cells) goto fail;
+        e->row_cache.rows[i].cells = cells;
+        for (uint32_t c = 0; c < ncols; c++) {
+            guint8 flags[2];
+            if (!get_bytes(r, flags, 2) ||
+                !get_bytes(r, &cells[c].native, sizeof(cells[c].native)))
+                goto fail;
+            cells[c].is_null = flags[0] != 0;
+            cells[c].native_kind = flags[1];
+            uint64_t len = get_u64(r);
+            if (r->bad) goto fail;
+            if (len == UINT64_MAX) continue;
+            if (len > r->left) goto fail;
+            cells[c].data = malloc((size_t)len + 1);
+            if (!cells[c].data) goto fail;
+            get_bytes(r, cells[c].data, (size_t)len);
+            cells[c].data[len] = '\0';
+            cells[c].data_len = (size_t)len;
+        }
+    }
+    return e;
+
+fail:
+    r->bad = true;
+    entry_unref(e);
+    return NULL;
+}
+
+static void load_file_locked(const char *path)
 {
-    if (dbc->metadata_cache) return;
-    dbc->metadata_cache = g_hash_table_new_full(
-        g_str_hash, g_str_equal, g_free, cache_entry_free);
+    gchar *data = NULL;
+    gsize len = 0;
+    if (!g_file_get_contents(path, &data, &len, NULL)) return;
+
+    reader_t r = { (const guint8 *)data, len, false };
+    char magic[8];
+    uint32_t version = 0, col_size = 0;
+    if (get_bytes(&r, magic, sizeof(magic)) &&
+        memcmp(magic, MDC_FILE_MAGIC, sizeof(magic)) == 0) {
+        version = get_u32(&r);
+        col_size = get_u32(&r);
+    }
+    if (r.bad || version != MDC_FILE_VERSION ||
+        col_size != (uint32_t)sizeof(argus_column_desc_t)) {
+        ARGUS_LOG_WARN("Metadata cache: ignoring incompatible file %s", path);
+        g_free(data);
+        return;
+    }
+
+    table_ensure_locked();
+    int loaded = 0;
+    while (r.left > 0 && !r.bad) {
+        cache_entry_t *e = get_entry(&r);
+        if (!e) break;
+        if (g_hash_table_contains(mdc_table, e->key)) {
+            entry_unref(e);
+            continue;
+        }
+        publish_locked(e);
+        loaded++;
+    }
+    if (r.bad)
+        ARGUS_LOG_WARN("Metadata cache: %s is truncated or corrupt", path);
+    ARGUS_LOG_DEBUG("Metadata cache: loaded %d entries from %s", loaded, path);
+    g_free(data);
 }
 
-void argus_metadata_cache_free(argus_dbc_t *dbc)
+static void save_file_locked(const char *path)
 {
-    if (dbc->metadata_cache) {
-        g_hash_table_destroy((GHashTable *)dbc->metadata_cache);
-        dbc->metadata_cache = NULL;
+    GByteArray *b = g_byte_array_new();
+    g_byte_array_append(b, (const guint8 *)MDC_FILE_MAGIC, 8);
+    put_u32(b, MDC_FILE_VERSION);
+    put_u32(b, (uint32_t)sizeof(argus_column_desc_t));
+
+    if (mdc_table) {
+        GHashTableIter iter;
+        gpointer k, v;
+        g_hash_table_iter_init(&iter, mdc_table);
+        while (g_hash_table_iter_next(&iter, &k, &v))
+            put_entry(b, (const cache_entry_t *)v);
+    }
+
+    GError *error = NULL;
+    gboolean ok;
+#if GLIB_CHECK_VERSION(2, 66, 0)
+    /* Table and column names are not for other users of the machine */
+    ok = g_file_set_contents_full(path, (const gchar *)b->data, b->len,
+                                  G_FILE_SET_CONTENTS_CONSISTENT, 0600,
+                                  &error);
+#else
+    ok = g_file_set_contents(path, (const gchar *)b->data, b->len, &error);
+#endif
+    if (!ok) {
+        ARGUS_LOG_WARN("Metadata cache: could not write %s: %s", path,
+                       error ? error->message : "?");
+        if (error) g_error_free(error);
     }
+    g_byte_array_free(b, TRUE);
 }
 
-void argus_metadata_cache_clear(argus_dbc_t *dbc)
+/* ── Entries ─────────────────────────────────────────────────── */
+
+/*
+ * A new, unpublished entry for dbc's identity with no rows yet.
+ * Holds one reference.
+ */
+static cache_entry_t *entry_new(const argus_dbc_t *dbc, const char *func,
+                                const char *a1, const char *a2,
+                                const char *a3, const char *a4,
+                                const argus_column_desc_t *columns,
+                                int num_cols)
 {
-    if (dbc->metadata_cache) {
-        g_hash_table_remove_all((GHashTable *)dbc->metadata_cache);
+    cache_entry_t *entry = calloc(1, sizeof(cache_entry_t));
+    if (!entry) return NULL;
+    entry->refcount = 1;
+    entry->key = build_cache_key(dbc, func, a1, a2, a3, a4);
+    entry->func = strdup(func);
+    entry->args[0] = dup_or_null(a1);
+    entry->args[1] = dup_or_null(a2);
+    entry->args[2] = dup_or_null(a3);
+    entry->args[3] = dup_or_null(a4);
+    entry->backend_name = strdup(dbc->backend_name ? dbc->backend_name : "");
+    entry->host = strdup(identity_host(dbc));
+    entry->user = strdup(dbc->username ? dbc->username : "");
+    entry->port = identity_port(dbc);
+    entry->num_cols = num_cols;
+    entry->columns = calloc((size_t)num_cols, sizeof(argus_column_desc_t));
+    if (!entry->key || !entry->func || !entry->backend_name ||
+        !entry->host || !entry->user || !entry->columns) {
+        entry_unref(entry);
+        return NULL;
     }
+    memcpy(entry->columns, columns,
+           (size_t)num_cols * sizeof(argus_column_desc_t));
+    entry->created_at = g_get_real_time();
+    return entry;
 }
 
 /*
- * Look up a cached result for a catalog function.
- * If found and not expired, copies the cached result into stmt.
- * Returns true if a valid cache hit was found.
+ * The servable entry under key, with a reference for the caller, or NULL.
+ * Drops it once past TTL + METADATACACHESTALE; in between, it is only
+ * returned while it is being refreshed.
  */
-bool argus_metadata_cache_lookup(argus_dbc_t *dbc, argus_stmt_t *stmt,
-                                  const char *func,
-                                  const char *a1, const char *a2,
-                                  const char *a3, const char *a4)
+static cache_entry_t *acquire_entry(const argus_dbc_t *dbc, const char *func,
+                                    const char *key, int ttl)
 {
-    if (!dbc->metadata_cache) return false;
+    g_mutex_lock(&mdc_lock);
+    cache_entry_t *entry = mdc_table
+        ? (cache_entry_t *)g_hash_table_lookup(mdc_table, key) : NULL;
+    gint64 age_sec = 0;
+    bool stale = false;
+    if (entry) {
+        age_sec = (g_get_real_time() - entry->created_at) / G_USEC_PER_SEC;
+        stale = age_sec > ttl;
+        if (age_sec > (gint64)ttl + dbc->metadata_cache_stale_sec) {
+            g_hash_table_remove(mdc_table, key);
+            entry = NULL;
+            ARGUS_LOG_DEBUG("Metadata cache expired for %s", func);
+        } else {
+            g_atomic_int_inc(&entry->refcount);
+        }
+    }
+    g_mutex_unlock(&mdc_lock);
+
+    if (!entry) return NULL;
+
+    /* Past the TTL: serve it only while it is being refreshed */
+    if (stale && !start_refresh(entry)) {
+        entry_unref(entry);
+        return NULL;
+    }
+
+    ARGUS_LOG_DEBUG("Metadata cache hit for %s (age=%llds%s)",
+                    func, (long long)age_sec, stale ? ", refreshing" : "");
+    return entry;
+}
+
+/* ── Catalog snapshots ───────────────────────────────────────── */
+
+/*
+ * Run the bulk catalog call on dbc's connection and publish the result.
+ * Returns the entry with a reference for the caller, or NULL.
+ */
+static cache_entry_t *snapshot_load(argus_dbc_t *dbc, const char *func,
+                                    const char *catalog, const char *scope,
+                                    const char *last)
+{
+    const argus_backend_t *backend = dbc->backend;
+    argus_backend_op_t op = NULL;
+    bool tables = strcmp(func, "SQLTables") == 0;
+    int rc = -1;
 
-    GHashTable *ht = (GHashTable *)dbc->metadata_cache;
+    if (!backend->get_result_metadata || !backend->fetch_results)
+        return NULL;
+    if (tables && backend->get_tables)
+        rc = backend->get_tables(dbc->backend_conn, catalog, scope, "%",
+                                 last, &op);
+    else if (!tables && backend->get_columns)
+        rc = backend->get_columns(dbc->backend_conn, catalog, scope, "%",
+                                  last, &op);
 
-    char *key = build_cache_key(func, a1, a2, a3, a4);
-    cache_entry_t *entry = (cache_entry_t *)g_hash_table_lookup(ht, key);
+    argus_column_desc_t cols[64];
+    int ncols = 0;
+    argus_row_cache_t rows;
+    argus_row_cache_init(&rows);
+    if (rc == 0)
+        rc = backend->get_result_metadata(dbc->backend_conn, op, cols, &ncols);
+    if (rc == 0 && ncols > 0 && ncols <= 64)
+        rc = fetch_all(backend, dbc->backend_conn, op, cols, ncols, &rows);
+    else
+        rc = -1;
+    if (op) backend->close_operation(dbc->backend_conn, op);
+    if (rc != 0) {
+        ARGUS_LOG_DEBUG("Metadata cache: %s snapshot of %s.%s not loaded",
+                        func, catalog ? catalog : "", scope);
+        return NULL;
+    }
 
+    cache_entry_t *entry = entry_new(dbc, func, catalog, scope, "%", last,
+                                     cols, ncols);
     if (!entry) {
-        free(key);
-        return false;
+        argus_row_cache_free(&rows);
+        return NULL;
     }
+    entry->row_cache = rows;
 
-    /* Check TTL */
-    gint64 now = g_get_monotonic_time();
-    gint64 age_sec = (now - entry->created_at) / G_USEC_PER_SEC;
-    if (age_sec > ARGUS_METADATA_CACHE_TTL_SEC) {
-        g_hash_table_remove(ht, key);
-        free(key);
-        ARGUS_LOG_DEBUG("Metadata cache expired for %s", func);
-        return false;
+    /* One reference for the table, one for the caller */
+    entry->refcount = 2;
+    g_mutex_lock(&mdc_lock);
+    publish_locked(entry);
+    g_mutex_unlock(&mdc_lock);
+
+    ARGUS_LOG_DEBUG("Metadata cache: loaded %s snapshot of %s.%s (%zu rows)",
+                    func, catalog ? catalog : "", scope,
+                    entry->row_cache.num_rows);
+    return entry;
+}
+
+static const char *cell_text(const argus_row_t *row, int col)
+{
+    if (!row->cells) return "";
+    const argus_cell_t *cell = &row->cells[col];
+    return (!cell->is_null && cell->data) ? cell->data : "";
+}
+
+static int snapshot_key_cmp(const void *a, const void *b)
+{
+    const snapshot_key_t *ka = (const snapshot_key_t *)a;
+    const snapshot_key_t *kb = (const snapshot_key_t *)b;
+    int c = strcasecmp(ka->schema, kb->schema);
+    if (c == 0) c = strcasecmp(ka->table, kb->table);
+    /* Keep the backend's order (ordinal position) within a table */
+    if (c == 0) c = ka->row < kb->row ? -1 : ka->row > kb->row;
+    return c;
+}
+
+/* The entry's rows sorted by TABLE_SCHEM, TABLE_NAME, ignoring case as the
+ * backends do when they match names; built on first use. */
+static const snapshot_key_t *snapshot_index(cache_entry_t *entry)
+{
+    snapshot_key_t *index = g_atomic_pointer_get(&entry->index);
+    size_t n = entry->row_cache.num_rows;
+    if (index || n == 0) return index;
+
+    index = malloc(n * sizeof(*index));
+    if (!index) return NULL;
+    for (size_t i = 0; i < n; i++) {
+        index[i].schema = cell_text(&entry->row_cache.rows[i], 1);
+        index[i].table = cell_text(&entry->row_cache.rows[i], 2);
+        index[i].row = (guint32)i;
     }
+    qsort(index, n, sizeof(*index), snapshot_key_cmp);
 
-    free(key);
+    /* Another statement may have built it meanwhile */
+    if (!g_atomic_pointer_compare_and_exchange(&entry->index, NULL, index)) {
+        free(index);
+        index = g_atomic_pointer_get(&entry->index);
+    }
+    return index;
+}
 
-    /* Deep-copy cached data into stmt */
-    if (!row_cache_deep_copy(&stmt->row_cache, &entry->row_cache))
-        return false;
+/* First slot at or after (schema, table) */
+static size_t snapshot_lower_bound(const snapshot_key_t *index, size_t n,
+                                   const char *schema, const char *table)
+{
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int c = strcasecmp(index[mid].schema, schema);
+        if (c == 0) c = strcasecmp(index[mid].table, table);
+        if (c < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
 
-    if (argus_stmt_ensure_columns(stmt, entry->num_cols) != 0)
-        return false;
+/*
+ * The literal text a search pattern starts with, unescaped. *literal is
+ * set when that is the whole pattern. A pattern that is already known to
+ * be literal (*literal set on entry) is copied as is.
+ */
+static char *pattern_prefix(const char *pattern, bool *literal)
+{
+    size_t len = strlen(pattern);
+    char *out = malloc(len + 1);
+    if (!out) return NULL;
+    if (*literal) {
+        memcpy(out, pattern, len + 1);
+        return out;
+    }
+
+    size_t n = 0;
+    const char *p = pattern;
+    while (*p && *p != '%' && *p != '_') {
+        if (*p == '\\' && p[1]) p++;
+        out[n++] = *p++;
+    }
+    out[n] = '\0';
+    *literal = (*p == '\0');
+    return out;
+}
+
+/* ODBC search pattern: % any run, _ any character, \ escapes. Letters
+ * match either case. */
+static bool like_match(const char *p, const char *s)
+{
+    const char *star_p = NULL, *star_s = NULL;
+    while (*s) {
+        if (*p == '%') {
+            star_p = ++p;
+            star_s = s;
+            continue;
+        }
+        if (*p == '\\' && p[1]) {
+            if (g_ascii_tolower(p[1]) == g_ascii_tolower(*s)) {
+                p += 2;
+                s++;
+                continue;
+            }
+        } else if (*p && (*p == '_' ||
+                          g_ascii_tolower(*p) == g_ascii_tolower(*s))) {
+            p++;
+            s++;
+            continue;
+        }
+        if (!star_p) return false;
+        p = star_p;
+        s = ++star_s;
+    }
+    while (*p == '%') p++;
+    return *p == '\0';
+}
+
+static bool name_matches(const char *pattern, const char *name,
+                         bool identifiers)
+{
+    if (!pattern) return true;
+    return identifiers ? strcasecmp(pattern, name) == 0
+                       : like_match(pattern, name);
+}
+
+/* SQLTables TableType list: "TABLE,VIEW" or "'TABLE','VIEW'" */
+static bool type_matches(const char *types, const char *type)
+{
+    if (!types) return true;
+    size_t type_len = strlen(type);
+    const char *p = types;
+    while (*p) {
+        while (*p == ' ' || *p == ',' || *p == '\'') p++;
+        const char *start = p;
+        while (*p && *p != ',') p++;
+        const char *end = p;
+        while (end > start && (end[-1] == ' ' || end[-1] == '\'')) end--;
+        if ((size_t)(end - start) == type_len &&
+            strncasecmp(start, type, type_len) == 0)
+            return true;
+    }
+    return false;
+}
+
+/* Copy the rows of a snapshot that match the call's arguments into stmt. */
+static int snapshot_filter(argus_stmt_t *stmt, cache_entry_t *entry,
+                           bool tables, const char *schema, const char *name,
+                           const char *last, bool identifiers)
+{
+    size_t n = entry->row_cache.num_rows;
+    if (entry->num_cols < 4) return -1;
+    const snapshot_key_t *index = snapshot_index(entry);
+    if (!index && n > 0) return -1;
+
+    /* Narrow the scan to the slots sharing the literal prefixes */
+    bool schema_literal = identifiers;
+    bool name_literal = identifiers;
+    char *schema_prefix = pattern_prefix(schema ? schema : "",
+                                         &schema_literal);
+    char *name_prefix = pattern_prefix(schema_literal && name ? name : "",
+                                       &name_literal);
+    if (!schema_prefix || !name_prefix) {
+        free(schema_prefix);
+        free(name_prefix);
+        return -1;
+    }
+    if (!schema) schema_literal = false;
+    size_t schema_len = strlen(schema_prefix);
+    size_t name_len = strlen(name_prefix);
+
+    argus_metadata_cache_release(stmt);
+    argus_row_cache_free(&stmt->row_cache);
+    argus_row_cache_t *out = &stmt->row_cache;
+    out->num_cols = entry->num_cols;
+
+    int rc = 0;
+    for (size_t i = snapshot_lower_bound(index, n, schema_prefix, name_prefix);
+         i < n; i++) {
+        const snapshot_key_t *k = &index[i];
+        if (schema_literal) {
+            if (strcasecmp(k->schema, schema_prefix) != 0 ||
+                strncasecmp(k->table, name_prefix, name_len) != 0)
+                break;
+        } else if (strncasecmp(k->schema, schema_prefix, schema_len) != 0) {
+            break;
+        }
+        if (!name_matches(schema, k->schema, identifiers) ||
+            !name_matches(name, k->table, identifiers))
+            continue;
+        const argus_row_t *row = &entry->row_cache.rows[k->row];
+        if (tables ? !type_matches(last, cell_text(row, 3))
+                   : !name_matches(last, cell_text(row, 3), identifiers))
+            continue;
+
+        if (out->num_rows == out->capacity) {
+            size_t cap = out->capacity ? out->capacity * 2 : 64;
+            argus_row_t *rows = realloc(out->rows, cap * sizeof(argus_row_t));
+            if (!rows) {
+                rc = -1;
+                break;
+            }
+            out->rows = rows;
+            out->capacity = cap;
+        }
+        if (argus_row_copy(&out->rows[out->num_rows], row,
+                           entry->num_cols) != 0) {
+            rc = -1;
+            break;
+        }
+        out->num_rows++;
+    }
+    free(schema_prefix);
+    free(name_prefix);
+    if (rc != 0) {
+        argus_row_cache_free(out);
+        return -1;
+    }
+
+    out->exhausted = true;
     memcpy(stmt->columns, entry->columns,
            (size_t)entry->num_cols * sizeof(argus_column_desc_t));
     stmt->num_cols = entry->num_cols;
     stmt->metadata_fetched = true;
     stmt->executed = true;
-    /* Rows are already in the cache (and exhausted); mark the fetch as started
-     * so SQLFetch iterates the cache instead of re-fetching from the backend
-     * (there is no backend op on a cache hit — that would clear the cache and
-     * fetch with a NULL op). */
+    /* As for a lent entry: iterate the rows, there is no backend op */
     stmt->fetch_started = true;
-    stmt->row_cache.current_row = 0;
+    return 0;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+/*
+ * Use `path` to persist the cache. The file is read on the first call (for
+ * any path) and written by argus_metadata_cache_cleanup.
+ */
+void argus_metadata_cache_set_file(const char *path)
+{
+    if (!path || !*path) return;
+
+    g_mutex_lock(&mdc_lock);
+    free(mdc_file);
+    mdc_file = strdup(path);
+    if (!mdc_file_loaded && mdc_file) {
+        mdc_file_loaded = true;
+        load_file_locked(mdc_file);
+    }
+    g_mutex_unlock(&mdc_lock);
+}
+
+/* Drop every entry (waiting for background refreshes to finish). */
+void argus_metadata_cache_clear(void)
+{
+    g_mutex_lock(&mdc_lock);
+    while (mdc_refreshes > 0)
+        g_cond_wait(&mdc_refresh_done, &mdc_lock);
+    if (mdc_table)
+        g_hash_table_remove_all(mdc_table);
+    g_mutex_unlock(&mdc_lock);
+}
+
+/* Write the cache to its file, if one is set, then drop it. */
+void argus_metadata_cache_cleanup(void)
+{
+    g_mutex_lock(&mdc_lock);
+    while (mdc_refreshes > 0)
+        g_cond_wait(&mdc_refresh_done, &mdc_lock);
+    if (mdc_file) {
+        save_file_locked(mdc_file);
+        free(mdc_file);
+        mdc_file = NULL;
+    }
+    mdc_file_loaded = false;
+    if (mdc_table) {
+        g_hash_table_destroy(mdc_table);
+        mdc_table = NULL;
+    }
+    g_mutex_unlock(&mdc_lock);
+}
+
+/* Drop the reference a statement holds on the entry its rows borrow. */
+void argus_metadata_cache_release(argus_stmt_t *stmt)
+{
+    cache_entry_t *entry = (cache_entry_t *)stmt->metadata_ref;
+    if (!entry) return;
+    if (stmt->row_cache.borrowed &&
+        stmt->row_cache.rows == entry->row_cache.rows)
+        argus_row_cache_clear(&stmt->row_cache);
+    stmt->metadata_ref = NULL;
+    entry_unref(entry);
+}
+
+/* Drop every entry cached under dbc's connection identity. */
+void argus_metadata_cache_invalidate(argus_dbc_t *dbc)
+{
+    char *prefix = identity_prefix(dbc);
+    size_t plen = strlen(prefix);
+
+    g_mutex_lock(&mdc_lock);
+    if (mdc_table) {
+        GHashTableIter iter;
+        gpointer k, v;
+        g_hash_table_iter_init(&iter, mdc_table);
+        while (g_hash_table_iter_next(&iter, &k, &v)) {
+            if (strncmp((const char *)k, prefix, plen) == 0)
+                g_hash_table_iter_remove(&iter);
+        }
+    }
+    g_mutex_unlock(&mdc_lock);
+
+    g_free(prefix);
+    ARGUS_LOG_DEBUG("Metadata cache invalidated for this connection");
+}
+
+/* True for statements that can change what SQLTables/SQLColumns return. */
+bool argus_metadata_cache_is_ddl(const char *query)
+{
+    static const char *const ddl[] = {
+        "CREATE", "DROP", "ALTER", "RENAME", "COMMENT", "MSCK",
+        "REFRESH", "INVALIDATE", "IMPORT", "REPLACE",
+    };
+    if (!query) return false;
+    const char *p = argus_sql_skip_leading(query);
+    for (size_t i = 0; i < G_N_ELEMENTS(ddl); i++) {
+        if (argus_sql_keyword_at(p, ddl[i])) return true;
+    }
+    return false;
+}
+
+/*
+ * Look up a cached result for a catalog function.
+ * If found and still servable, lends the cached rows to stmt (no copy).
+ * Returns true if a valid cache hit was found.
+ */
+bool argus_metadata_cache_lookup(argus_dbc_t *dbc, argus_stmt_t *stmt,
+                                  const char *func,
+                                  const char *a1, const char *a2,
+                                  const char *a3, const char *a4)
+{
+    int ttl = ttl_for(dbc, func);
+    if (ttl <= 0) return false;
 
-    ARGUS_LOG_DEBUG("Metadata cache hit for %s (age=%llds)",
-                    func, (long long)age_sec);
+    char *key = build_cache_key(dbc, func, a1, a2, a3, a4);
+    if (!key) return false;
+    cache_entry_t *entry = acquire_entry(dbc, func, key, ttl);
+    free(key);
+    if (!entry) return false;
+
+    if (argus_stmt_ensure_columns(stmt, entry->num_cols) != 0) {
+        entry_unref(entry);
+        return false;
+    }
+    attach_entry(stmt, entry);
     return true;
 }
 
 /*
  * Store a catalog function result in the cache.
- * Deep-copies the stmt's row_cache and column metadata.
+ * The entry takes over the stmt's rows, which the stmt then borrows back.
  */
 void argus_metadata_cache_store(argus_dbc_t *dbc, argus_stmt_t *stmt,
                                  const char *func,
                                  const char *a1, const char *a2,
                                  const char *a3, const char *a4)
 {
-    if (!dbc->metadata_cache)
-        argus_metadata_cache_init(dbc);
-
-    GHashTable *ht = (GHashTable *)dbc->metadata_cache;
+    if (ttl_for(dbc, func) <= 0 || stmt->row_cache.borrowed ||
+        stmt->num_cols <= 0)
+        return;
 
-    cache_entry_t *entry = calloc(1, sizeof(cache_entry_t));
+    cache_entry_t *entry = entry_new(dbc, func, a1, a2, a3, a4,
+                                     stmt->columns, stmt->num_cols);
     if (!entry) return;
 
-    if (!row_cache_deep_copy(&entry->row_cache, &stmt->row_cache)) {
-        free(entry);
-        return;
-    }
+    /* Move the rows into the entry */
+    entry->row_cache = stmt->row_cache;
+    entry->row_cache.num_cols = stmt->num_cols;
+    entry->row_cache.current_row = 0;
+    entry->row_cache.exhausted = true;
+    memset(&stmt->row_cache, 0, sizeof(stmt->row_cache));
 
-    entry->num_cols = stmt->num_cols;
-    entry->columns = calloc((size_t)stmt->num_cols, sizeof(argus_column_desc_t));
-    if (!entry->columns) {
-        argus_row_cache_free(&entry->row_cache);
-        free(entry);
-        return;
-    }
-    memcpy(entry->columns, stmt->columns,
-           (size_t)stmt->num_cols * sizeof(argus_column_desc_t));
+    /* One reference for the table, one for the stmt borrowing the rows */
+    entry->refcount = 2;
+    g_mutex_lock(&mdc_lock);
+    publish_locked(entry);
+    g_mutex_unlock(&mdc_lock);
+
+    attach_entry(stmt, entry);
+    ARGUS_LOG_DEBUG("Metadata cache stored for %s", func);
+}
+
+/*
+ * Answer SQLTables (name = table, last = table types) or SQLColumns
+ * (name = table, last = column) from a catalog snapshot, loading it on
+ * dbc's connection if it is not cached. `identifiers` is SQL_ATTR_METADATA_ID:
+ * the arguments are then names rather than patterns. Copies the matching
+ * rows into stmt. Returns false when the call should go to the backend: the
+ * cache is off, an argument is an empty string (the catalog / schema / table
+ * type enumerations), or the load failed.
+ */
+bool argus_metadata_cache_snapshot(argus_dbc_t *dbc, argus_stmt_t *stmt,
+                                    const char *func, const char *catalog,
+                                    const char *schema, const char *name,
+                                    const char *last, bool identifiers)
+{
+    int ttl = ttl_for(dbc, func);
+    if (ttl <= 0 || !dbc->catalog_snapshot) return false;
+    if ((catalog && !*catalog) || (schema && !*schema) ||
+        (name && !*name) || (last && !*last))
+        return false;
 
-    entry->created_at = g_get_monotonic_time();
+    bool tables = strcmp(func, "SQLTables") == 0;
+    if (!tables && strcmp(func, "SQLColumns") != 0) return false;
 
-    char *key = build_cache_key(func, a1, a2, a3, a4);
-    g_hash_table_replace(ht, key, entry);
+    /* One snapshot per named schema; a schema pattern loads all of them */
+    char *scope = NULL;
+    if (schema) {
+        bool literal = identifiers;
+        char *prefix = pattern_prefix(schema, &literal);
+        if (literal) scope = prefix;
+        else free(prefix);
+    }
+    const char *scope_arg = scope ? scope : "%";
+    const char *last_arg = tables ? NULL : "%";
 
-    ARGUS_LOG_DEBUG("Metadata cache stored for %s", func);
+    char *key = build_cache_key(dbc, func, catalog, scope_arg, "%", last_arg);
+    cache_entry_t *entry = key ? acquire_entry(dbc, func, key, ttl) : NULL;
+    free(key);
+    if (!entry)
+        entry = snapshot_load(dbc, func, catalog, scope_arg, last_arg);
+    free(scope);
+    if (!entry) return false;
+
+    if (argus_stmt_ensure_columns(stmt, entry->num_cols) != 0) {
+        entry_unref(entry);
+        return false;
+    }
+    int rc = snapshot_filter(stmt, entry, tables, schema, name, last,
+                             identifiers);
+    entry_unref(entry);
+    return rc == 0;
 }
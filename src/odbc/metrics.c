@@ -0,0 +1,352 @@
+/*
+ * Argus ODBC Driver — Statement phase timing and latency histograms
+ *
+ * Each statement handle accumulates how long its execution spent in each
+ * phase (argus_stmt_timing_t): submitting the query, waiting for the server
+ * to queue and plan it, reaching the first row, fetching batches (split into
+ * waiting on the network and decoding responses where the backend reports
+ * its wait time) and converting cells into the application's buffers. The
+ * fetch path only adds to the handle, once per batch; the phases go into the
+ * process-wide histograms here once per execution, when the result closes.
+ *
+ * The histograms are HDR-style log-linear: every power of two of
+ * microseconds is split into ARGUS_METRICS_SUB_BUCKETS linear buckets, so a
+ * recorded value is known to within 1/16 at any magnitude, in a fixed array
+ * per phase. Conversion time is measured on every ARGUS_METRICS_CONVERT_SAMPLE
+ * th SQLFetch call and scaled, so row-at-a-time fetching pays no clock read
+ * per row.
+ */
+
+#include "argus/handle.h"
+#include "argus/log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#define ARGUS_METRICS_SUB_BITS      4
+#define ARGUS_METRICS_SUB_BUCKETS   (1 << ARGUS_METRICS_SUB_BITS)
+#define ARGUS_METRICS_MAX_BIT       47      /* 2^47 us is over four years */
+#define ARGUS_METRICS_BUCKETS \
+    ((ARGUS_METRICS_MAX_BIT - ARGUS_METRICS_SUB_BITS + 2) * \
+     ARGUS_METRICS_SUB_BUCKETS)
+#define ARGUS_METRICS_MAX_BACKENDS  16
+
+typedef struct {
+    guint64 counts[ARGUS_METRICS_BUCKETS];
+    guint64 total;
+    guint64 min_us;
+    guint64 max_us;
+    double  sum_us;
+} metrics_hist_t;
+
+typedef struct {
+    char          name[32];
+    unsigned long statements;
+    unsigned long rows;
+    unsigned long bytes;
+    unsigned long cells;
+} metrics_backend_t;
+
+static GMutex            m_lock;
+static metrics_hist_t    m_hist[ARGUS_PHASE_COUNT];
+static metrics_backend_t m_backends[ARGUS_METRICS_MAX_BACKENDS];
+static int               m_backend_count;
+
+static const char *const phase_names[ARGUS_PHASE_COUNT] = {
+    "submit", "queue", "first_row", "fetch", "network", "decode", "convert"
+};
+
+const char *argus_metrics_phase_name(argus_phase_t phase)
+{
+    return (phase >= 0 && phase < ARGUS_PHASE_COUNT)
+        ? phase_names[phase] : "unknown";
+}
+
+/* ── Histogram buckets ───────────────────────────────────────── */
+
+/* Values below 2 * SUB_BUCKETS have a bucket each; above, the top
+ * SUB_BITS + 1 bits of the value pick one. */
+static int bucket_index(guint64 us)
+{
+    if (us < 2 * ARGUS_METRICS_SUB_BUCKETS)
+        return (int)us;
+    if (us >> (ARGUS_METRICS_MAX_BIT + 1))
+        us = ((guint64)1 << (ARGUS_METRICS_MAX_BIT + 1)) - 1;
+    int msb = 63 - __builtin_clzll(us);
+    int shift = msb - ARGUS_METRICS_SUB_BITS;
+    return (shift + 1) * ARGUS_METRICS_SUB_BUCKETS +
+           (int)((us >> shift) - ARGUS_METRICS_SUB_BUCKETS);
+}
+
+/* Smallest value that lands in bucket i, and the bucket's width */
+static guint64 bucket_low(int i, guint64 *width)
+{
+    if (i < 2 * ARGUS_METRICS_SUB_BUCKETS) {
+        *width = 1;
+        return (guint64)i;
+    }
+    int shift = i / ARGUS_METRICS_SUB_BUCKETS - 1;
+    guint64 sub = (guint64)(i % ARGUS_METRICS_SUB_BUCKETS);
+    *width = (guint64)1 << shift;
+    return (ARGUS_METRICS_SUB_BUCKETS + sub) << shift;
+}
+
+static void hist_record(metrics_hist_t *h, double ms)
+{
+    if (ms < 0) return;
+    guint64 us = (guint64)(ms * 1000.0 + 0.5);
+    h->counts[bucket_index(us)]++;
+    if (h->total == 0 || us < h->min_us) h->min_us = us;
+    if (us > h->max_us) h->max_us = us;
+    h->total++;
+    h->sum_us += (double)us;
+}
+
+/* Value at percentile pct: the middle of the bucket holding that rank,
+ * clamped to the exact extremes. */
+static double hist_percentile(const metrics_hist_t *h, double pct)
+{
+    if (h->total == 0) return 0.0;
+    guint64 rank = (guint64)(pct / 100.0 * (double)h->total + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > h->total) rank = h->total;
+
+    guint64 seen = 0;
+    for (int i = 0; i < ARGUS_METRICS_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen < rank) continue;
+        guint64 width;
+        guint64 low = bucket_low(i, &width);
+        double us = (double)low + (double)(width - 1) / 2.0;
+        if (us < (double)h->min_us) us = (double)h->min_us;
+        if (us > (double)h->max_us) us = (double)h->max_us;
+        return us / 1000.0;
+    }
+    return (double)h->max_us / 1000.0;
+}
+
+static void hist_summary(const metrics_hist_t *h, argus_phase_summary_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->count = (unsigned long)h->total;
+    if (h->total == 0) return;
+    out->min_ms  = (double)h->min_us / 1000.0;
+    out->max_ms  = (double)h->max_us / 1000.0;
+    out->mean_ms = h->sum_us / (double)h->total / 1000.0;
+    out->p50_ms  = hist_percentile(h, 50.0);
+    out->p90_ms  = hist_percentile(h, 90.0);
+    out->p99_ms  = hist_percentile(h, 99.0);
+}
+
+/* ── Recording ───────────────────────────────────────────────── */
+
+void argus_metrics_record(argus_phase_t phase, double ms)
+{
+    if (phase < 0 || phase >= ARGUS_PHASE_COUNT) return;
+    g_mutex_lock(&m_lock);
+    hist_record(&m_hist[phase], ms);
+    g_mutex_unlock(&m_lock);
+}
+
+static metrics_backend_t *backend_slot(const char *name)
+{
+    if (!name) name = "unknown";
+    for (int i = 0; i < m_backend_count; i++) {
+        if (strcmp(m_backends[i].name, name) == 0)
+            return &m_backends[i];
+    }
+    if (m_backend_count >= ARGUS_METRICS_MAX_BACKENDS)
+        return NULL;
+    metrics_backend_t *b = &m_backends[m_backend_count++];
+    snprintf(b->name, sizeof(b->name), "%s", name);
+    return b;
+}
+
+/* ── Per-statement timing ────────────────────────────────────── */
+
+/* Phase time of the statement's current execution, or -1 when unknown. */
+double argus_stmt_phase_ms(const argus_stmt_t *stmt, argus_phase_t phase)
+{
+    const argus_stmt_timing_t *t = &stmt->timing;
+    if (t->start_us == 0) return -1.0;
+
+    switch (phase) {
+    case ARGUS_PHASE_SUBMIT:    return t->submit_ms;
+    case ARGUS_PHASE_QUEUE:     return t->queue_ms;
+    case ARGUS_PHASE_FIRST_ROW: return t->first_row_ms;
+    case ARGUS_PHASE_FETCH:     return t->batches > 0 ? t->fetch_ms : -1.0;
+    case ARGUS_PHASE_NETWORK:
+        return t->batches > 0 ? t->network_ms : -1.0;
+    case ARGUS_PHASE_DECODE:
+        if (t->batches == 0 || t->network_ms < 0) return -1.0;
+        return t->fetch_ms > t->network_ms ? t->fetch_ms - t->network_ms
+                                           : 0.0;
+    case ARGUS_PHASE_CONVERT:
+        if (t->convert_samples == 0) return -1.0;
+        return t->convert_sampled_ms * (double)t->fetch_calls /
+               (double)t->convert_samples;
+    default:
+        return -1.0;
+    }
+}
+
+/* Record the statement's previous execution, if any, and start timing a
+ * new one. */
+void argus_stmt_timing_begin(argus_stmt_t *stmt)
+{
+    argus_stmt_timing_finish(stmt);
+    memset(&stmt->timing, 0, sizeof(stmt->timing));
+    stmt->timing.start_us = g_get_monotonic_time();
+    stmt->timing.submit_ms = -1.0;
+    stmt->timing.queue_ms = -1.0;
+    stmt->timing.first_row_ms = -1.0;
+    stmt->timing.network_ms = -1.0;
+    stmt->timing.pending = true;
+}
+
+/* Refresh the wire counters from the backend's progress. Once per batch. */
+void argus_stmt_timing_progress(argus_stmt_t *stmt)
+{
+    argus_dbc_t *dbc = stmt->dbc;
+    if (!stmt->op || !dbc || !dbc->backend || !dbc->backend->get_progress)
+        return;
+    argus_progress_t prog = { .percent = -1.0, .wait_us = -1 };
+    if (!dbc->backend->get_progress(dbc->backend_conn, stmt->op, &prog))
+        return;
+    if (prog.bytes_received > 0)
+        stmt->timing.bytes = (unsigned long)prog.bytes_received;
+    if (prog.wait_us >= 0) {
+        /* The wait covers every request of the operation; the part spent
+         * before the first batch belongs to submit and queue. */
+        if (stmt->timing.batches == 0)
+            stmt->timing.wait_base_us = prog.wait_us;
+        else
+            stmt->timing.network_ms =
+                (double)(prog.wait_us - stmt->timing.wait_base_us) / 1000.0;
+    }
+}
+
+/* Put the statement's execution into the process-wide histograms. */
+void argus_stmt_timing_finish(argus_stmt_t *stmt)
+{
+    argus_stmt_timing_t *t = &stmt->timing;
+    if (!t->pending) return;
+    t->pending = false;
+
+    double ms[ARGUS_PHASE_COUNT];
+    for (int p = 0; p < ARGUS_PHASE_COUNT; p++)
+        ms[p] = argus_stmt_phase_ms(stmt, (argus_phase_t)p);
+
+    const argus_dbc_t *dbc = stmt->dbc;
+    const char *backend = dbc ? (dbc->backend ? dbc->backend->name
+                                              : dbc->backend_name)
+                              : NULL;
+
+    g_mutex_lock(&m_lock);
+    for (int p = 0; p < ARGUS_PHASE_COUNT; p++)
+        hist_record(&m_hist[p], ms[p]);
+    metrics_backend_t *b = backend_slot(backend);
+    if (b) {
+        b->statements++;
+        b->rows  += stmt->rows_fetched_total;
+        b->bytes += t->bytes;
+        b->cells += t->cells;
+    }
+    g_mutex_unlock(&m_lock);
+}
+
+/* ── Reading ─────────────────────────────────────────────────── */
+
+void argus_metrics_summary(argus_phase_t phase, argus_phase_summary_t *out)
+{
+    if (phase < 0 || phase >= ARGUS_PHASE_COUNT) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    g_mutex_lock(&m_lock);
+    hist_summary(&m_hist[phase], out);
+    g_mutex_unlock(&m_lock);
+}
+
+/* JSON snapshot: per-phase summaries in milliseconds and per-backend
+ * counters. With buckets, each phase also lists its non-empty buckets as
+ * [lowest microsecond value, count] pairs, enough to merge dumps from
+ * several processes offline. Caller frees with g_free(). */
+static char *metrics_json(bool buckets)
+{
+    GString *s = g_string_new("{\"phases\":{");
+
+    g_mutex_lock(&m_lock);
+    for (int p = 0; p < ARGUS_PHASE_COUNT; p++) {
+        const metrics_hist_t *h = &m_hist[p];
+        argus_phase_summary_t sum;
+        hist_summary(h, &sum);
+        g_string_append_printf(s,
+            "%s\"%s\":{\"count\":%lu,\"min\":%.3f,\"p50\":%.3f,"
+            "\"p90\":%.3f,\"p99\":%.3f,\"max\":%.3f,\"mean\":%.3f",
+            p ? "," : "", phase_names[p], sum.count, sum.min_ms,
+            sum.p50_ms, sum.p90_ms, sum.p99_ms, sum.max_ms, sum.mean_ms);
+        if (buckets) {
+            g_string_append(s, ",\"buckets\":[");
+            bool first = true;
+            for (int i = 0; i < ARGUS_METRICS_BUCKETS; i++) {
+                if (!h->counts[i]) continue;
+                guint64 width;
+                g_string_append_printf(s, "%s[%" G_GUINT64_FORMAT ",%"
+                                       G_GUINT64_FORMAT "]",
+                                       first ? "" : ",",
+                                       bucket_low(i, &width), h->counts[i]);
+                first = false;
+            }
+            g_string_append_c(s, ']');
+        }
+        g_string_append_c(s, '}');
+    }
+    g_string_append(s, "},\"backends\":{");
+    for (int i = 0; i < m_backend_count; i++) {
+        const metrics_backend_t *b = &m_backends[i];
+        g_string_append_printf(s,
+            "%s\"%s\":{\"statements\":%lu,\"rows\":%lu,\"bytes\":%lu,"
+            "\"cells\":%lu}",
+            i ? "," : "", b->name, b->statements, b->rows, b->bytes,
+            b->cells);
+    }
+    g_mutex_unlock(&m_lock);
+
+    g_string_append(s, "}}");
+    return g_string_free(s, FALSE);
+}
+
+char *argus_metrics_json(void)
+{
+    return metrics_json(false);
+}
+
+/* Write the histograms, buckets included, to path. 0 on success. */
+int argus_metrics_dump(const char *path)
+{
+    if (!path || !*path) return -1;
+    char *json = metrics_json(true);
+    GError *err = NULL;
+    gboolean ok = g_file_set_contents(path, json, -1, &err);
+    g_free(json);
+    if (!ok) {
+        ARGUS_LOG_WARN("Could not write metrics to %s: %s", path,
+                       err ? err->message : "unknown error");
+        if (err) g_error_free(err);
+        return -1;
+    }
+    ARGUS_LOG_INFO("Statement metrics written to %s", path);
+    return 0;
+}
+
+/* Forget everything recorded so far. */
+void argus_metrics_reset(void)
+{
+    g_mutex_lock(&m_lock);
+    memset(m_hist, 0, sizeof(m_hist));
+    memset(m_backends, 0, sizeof(m_backends));
+    m_backend_count = 0;
+    g_mutex_unlock(&m_lock);
+}
@@ -3,6 +3,13 @@
  *
  * Pool connections by (host, port, backend, credentials) to avoid
  * expensive reconnection overhead. Thread-safe via GLib GMutex.
+ *
+ * A connection made with POOLMINIDLE=N registers its key for pre-warming:
+ * a maintainer thread (started on the first such key) keeps N idle
+ * connections open for it, connecting with a copy of the settings, checks
+ * idle ones with is_alive() every ARGUS_POOL_VALIDATE_INTERVAL seconds and
+ * replaces them shortly before ARGUS_POOL_TTL, so a checkout does not pay
+ * the handshake (Kerberos/SASL, OpenSession, OAuth token fetch).
  */
 
 #include "argus/handle.h"
@@ -17,6 +24,8 @@
 #define ARGUS_POOL_DEFAULT_IDLE_TIMEOUT 300
 #define ARGUS_POOL_DEFAULT_TTL          3600
 #define ARGUS_POOL_HARD_MAX_TOTAL       256
+#define ARGUS_POOL_DEFAULT_MAINTAIN_INTERVAL 5   /* maintainer tick, s */
+#define ARGUS_POOL_DEFAULT_VALIDATE_INTERVAL 30  /* idle is_alive() check, s */
 
 /* Pool entry: a cached backend connection */
 typedef struct argus_pool_entry {
@@ -29,8 +38,20 @@ typedef struct argus_pool_entry {
     bool                    in_use;
     gint64                  last_used;  /* monotonic time */
     gint64                  created;    /* monotonic time of creation */
+    gint64                  validated;  /* monotonic time of last check */
 } argus_pool_entry_t;
 
+/* Pre-warmed key: the maintainer keeps min_idle idle connections for it */
+typedef struct argus_pool_warm {
+    char                   *host;
+    int                     port;
+    char                   *backend_name;
+    char                   *username;
+    const argus_backend_t  *backend;
+    argus_dbc_t            *cfg;        /* settings copy to connect with */
+    int                     min_idle;
+} argus_pool_warm_t;
+
 /* Global connection pool */
 static struct {
     argus_pool_entry_t *entries;
@@ -40,6 +61,16 @@ static struct {
     int                max_total;
     int                idle_timeout_sec;
     int                ttl_sec;
+    int                maintain_interval_sec;
+    int                validate_interval_sec;
+    argus_pool_warm_t *warm;
+    int                warm_count;
+    argus_pool_stats_t stats;
+    GThread           *maintainer;
+    GCond              cond;        /* wakes the maintainer */
+    bool               wake;
+    bool               stopping;
+    GMutex             maintain_lock;   /* one maintenance pass at a time */
     GMutex             mutex;
     gsize              init_once;
 } g_pool;
@@ -60,6 +91,8 @@ static void pool_ensure_init(void)
 {
     if (g_once_init_enter(&g_pool.init_once)) {
         g_mutex_init(&g_pool.mutex);
+        g_mutex_init(&g_pool.maintain_lock);
+        g_cond_init(&g_pool.cond);
         g_pool.count = 0;
         g_pool.max_per_key    = env_int("ARGUS_POOL_MAX_PER_KEY",
                                          ARGUS_POOL_DEFAULT_MAX_PER_KEY);
@@ -69,6 +102,12 @@ static void pool_ensure_init(void)
                                            ARGUS_POOL_DEFAULT_IDLE_TIMEOUT);
         g_pool.ttl_sec        = env_int("ARGUS_POOL_TTL",
                                          ARGUS_POOL_DEFAULT_TTL);
+        g_pool.maintain_interval_sec =
+            env_int("ARGUS_POOL_MAINTAIN_INTERVAL",
+                    ARGUS_POOL_DEFAULT_MAINTAIN_INTERVAL);
+        g_pool.validate_interval_sec =
+            env_int("ARGUS_POOL_VALIDATE_INTERVAL",
+                    ARGUS_POOL_DEFAULT_VALIDATE_INTERVAL);
         if (g_pool.max_total > ARGUS_POOL_HARD_MAX_TOTAL)
             g_pool.max_total = ARGUS_POOL_HARD_MAX_TOTAL;
         g_pool.capacity = g_pool.max_total;
@@ -92,6 +131,54 @@ static bool pool_entry_matches(const argus_pool_entry_t *entry,
     return true;
 }
 
+/* ── Internal: entry bookkeeping (pool mutex held) ───────────── */
+
+static void pool_remove_at(int i)
+{
+    argus_pool_entry_t *e = &g_pool.entries[i];
+    free(e->host);
+    free(e->backend_name);
+    free(e->username);
+    g_pool.count--;
+    if (i < g_pool.count) {
+        memmove(&g_pool.entries[i], &g_pool.entries[i + 1],
+                (size_t)(g_pool.count - i) * sizeof(argus_pool_entry_t));
+    }
+    memset(&g_pool.entries[g_pool.count], 0, sizeof(argus_pool_entry_t));
+}
+
+/* Append an idle entry; NULL if the array is full or strdup fails. */
+static argus_pool_entry_t *pool_add_entry(const char *host, int port,
+                                          const char *backend_name,
+                                          const char *username,
+                                          const argus_backend_t *backend,
+                                          argus_backend_conn_t conn)
+{
+    if (!g_pool.entries || g_pool.count >= g_pool.capacity)
+        return NULL;
+
+    argus_pool_entry_t *e = &g_pool.entries[g_pool.count];
+    e->host = strdup(host);
+    e->backend_name = strdup(backend_name);
+    e->username = strdup(username ? username : "");
+    if (!e->host || !e->backend_name || !e->username) {
+        free(e->host);
+        free(e->backend_name);
+        free(e->username);
+        memset(e, 0, sizeof(*e));
+        return NULL;
+    }
+    e->port = port;
+    e->backend = backend;
+    e->conn = conn;
+    e->in_use = false;
+    e->last_used = g_get_monotonic_time();
+    e->created = e->last_used;
+    e->validated = e->last_used;
+    g_pool.count++;
+    return e;
+}
+
 /* ── Public: try to acquire a pooled connection ──────────────── */
 
 argus_backend_conn_t argus_pool_acquire(
@@ -114,11 +201,16 @@ argus_backend_conn_t argus_pool_acquire(
 
     gint64 now = g_get_monotonic_time();
     gint64 ttl_us = (gint64)g_pool.ttl_sec * G_USEC_PER_SEC;
+    bool busy = false;  /* the key has connections, all checked out */
 
     for (int i = 0; i < g_pool.count; i++) {
         argus_pool_entry_t *e = &g_pool.entries[i];
-        if (!e->in_use &&
-            pool_entry_matches(e, host, port, backend_name, username)) {
+        if (e->in_use) {
+            if (pool_entry_matches(e, host, port, backend_name, username))
+                busy = true;
+            continue;
+        }
+        if (pool_entry_matches(e, host, port, backend_name, username)) {
 
             /* TTL check: evict if connection is too old */
             bool ttl_expired = (g_pool.ttl_sec > 0 && e->created > 0 &&
@@ -136,21 +228,15 @@ argus_backend_conn_t argus_pool_acquire(
                     stale_list[stale_count].c = e->conn;
                     stale_count++;
                 }
-                free(e->host);
-                free(e->backend_name);
-                free(e->username);
-                g_pool.count--;
-                if (i < g_pool.count) {
-                    memmove(&g_pool.entries[i],
-                            &g_pool.entries[i + 1],
-                            (size_t)(g_pool.count - i) * sizeof(argus_pool_entry_t));
-                }
+                pool_remove_at(i);
+                g_pool.stats.evicted++;
                 i--;
                 continue;
             }
 
             e->in_use = true;
             e->last_used = now;
+            g_pool.stats.hits++;
             if (out_backend) *out_backend = e->backend;
             ARGUS_LOG_DEBUG("Pool: reusing connection to %s:%d (backend=%s)",
                             host, port, backend_name);
@@ -165,6 +251,9 @@ argus_backend_conn_t argus_pool_acquire(
         }
     }
 
+    g_pool.stats.misses++;
+    if (busy)
+        g_pool.stats.busy++;
     g_mutex_unlock(&g_pool.mutex);
 
     /* Disconnect stale connections outside the mutex */
@@ -212,28 +301,14 @@ void argus_pool_release(
         }
 
         if (key_count < g_pool.max_per_key) {
-            argus_pool_entry_t *e = &g_pool.entries[g_pool.count];
-            e->host = strdup(host);
-            e->backend_name = strdup(backend_name);
-            e->username = strdup(username ? username : "");
-            if (!e->host || !e->backend_name || !e->username) {
-                free(e->host);
-                free(e->backend_name);
-                free(e->username);
-                memset(e, 0, sizeof(*e));
+            if (!pool_add_entry(host, port, backend_name, username,
+                                backend, conn)) {
                 ARGUS_LOG_ERROR("Pool: strdup failed, disconnecting");
                 g_mutex_unlock(&g_pool.mutex);
                 if (backend && backend->disconnect && conn)
                     backend->disconnect(conn);
                 return;
             }
-            e->port = port;
-            e->backend = backend;
-            e->conn = conn;
-            e->in_use = false;
-            e->last_used = g_get_monotonic_time();
-            e->created = e->last_used;
-            g_pool.count++;
             ARGUS_LOG_DEBUG("Pool: cached connection to %s:%d (total=%d)",
                             host, port, g_pool.count);
             g_mutex_unlock(&g_pool.mutex);
@@ -298,11 +373,35 @@ void argus_pool_get_config(int *max_per_key, int *max_total,
 
 /* ── Public: cleanup all pooled connections ──────────────────── */
 
+static void pool_warm_free(argus_pool_warm_t *w)
+{
+    free(w->host);
+    free(w->backend_name);
+    free(w->username);
+    argus_dbc_free_config(w->cfg);
+}
+
 void argus_pool_cleanup(void)
 {
     if (!g_pool.init_once) return;
 
+    /* Stop the maintainer first: it may be connecting for a warm key */
     g_mutex_lock(&g_pool.mutex);
+    GThread *maintainer = g_pool.maintainer;
+    g_pool.maintainer = NULL;
+    g_pool.stopping = true;
+    g_cond_broadcast(&g_pool.cond);
+    g_mutex_unlock(&g_pool.mutex);
+    if (maintainer)
+        g_thread_join(maintainer);
+
+    g_mutex_lock(&g_pool.mutex);
+    g_pool.stopping = false;
+    for (int i = 0; i < g_pool.warm_count; i++)
+        pool_warm_free(&g_pool.warm[i]);
+    free(g_pool.warm);
+    g_pool.warm = NULL;
+    g_pool.warm_count = 0;
 
     if (!g_pool.entries) {
         g_mutex_unlock(&g_pool.mutex);
@@ -362,6 +461,7 @@ void argus_pool_evict_idle(int max_idle_sec)
             free(e->host);
             free(e->backend_name);
             free(e->username);
+            g_pool.stats.evicted++;
 
             /* Shift remaining entries down */
             g_pool.count--;
@@ -377,3 +477,415 @@ void argus_pool_evict_idle(int max_idle_sec)
 
     g_mutex_unlock(&g_pool.mutex);
 }
+
+/* ── Pre-warming ─────────────────────────────────────────────── */
+
+typedef struct {
+    const argus_backend_t *b;
+    argus_backend_conn_t   c;
+} pool_conn_t;
+
+static void pool_disconnect_all(const pool_conn_t *list, int n)
+{
+    for (int i = 0; i < n; i++) {
+        if (list[i].b && list[i].b->disconnect && list[i].c)
+            list[i].b->disconnect(list[i].c);
+    }
+}
+
+static int pool_warm_find(const char *host, int port,
+                          const char *backend_name, const char *username)
+{
+    for (int i = 0; i < g_pool.warm_count; i++) {
+        const argus_pool_warm_t *w = &g_pool.warm[i];
+        if (w->port == port && strcmp(w->host, host) == 0 &&
+            strcmp(w->backend_name, backend_name) == 0 &&
+            strcmp(w->username, username ? username : "") == 0)
+            return i;
+    }
+    return -1;
+}
+
+static int pool_find_conn(argus_backend_conn_t conn)
+{
+    for (int i = 0; i < g_pool.count; i++) {
+        if (g_pool.entries[i].conn == conn)
+            return i;
+    }
+    return -1;
+}
+
+/* Refresh-ahead: an idle connection this close to the TTL gets replaced */
+static bool pool_entry_expiring(const argus_pool_entry_t *e, gint64 now)
+{
+    if (g_pool.ttl_sec <= 0) return false;
+    int ahead = 2 * g_pool.maintain_interval_sec;
+    if (ahead > g_pool.ttl_sec / 2)
+        ahead = g_pool.ttl_sec / 2;
+    return now - e->created >
+           (gint64)(g_pool.ttl_sec - ahead) * G_USEC_PER_SEC;
+}
+
+/* Idle connections of warm key w that are not about to be replaced; with
+ * active, every connection of the key except those. */
+static int pool_warm_fresh(const argus_pool_warm_t *w, gint64 now,
+                           int *active)
+{
+    int fresh = 0, n = 0;
+    for (int i = 0; i < g_pool.count; i++) {
+        const argus_pool_entry_t *e = &g_pool.entries[i];
+        if (!pool_entry_matches(e, w->host, w->port, w->backend_name,
+                                w->username))
+            continue;
+        if (e->in_use) {
+            n++;
+        } else if (!pool_entry_expiring(e, now)) {
+            n++;
+            fresh++;
+        }
+    }
+    if (active) *active = n;
+    return fresh;
+}
+
+/* True if e's key keeps its warm minimum of idle connections without e */
+static bool pool_entry_spare(const argus_pool_entry_t *e)
+{
+    int w = pool_warm_find(e->host, e->port, e->backend_name, e->username);
+    if (w < 0) return true;
+    int idle = 0;
+    for (int i = 0; i < g_pool.count; i++) {
+        const argus_pool_entry_t *o = &g_pool.entries[i];
+        if (!o->in_use && pool_entry_matches(o, e->host, e->port,
+                                             e->backend_name, e->username))
+            idle++;
+    }
+    return idle > g_pool.warm[w].min_idle;
+}
+
+static gpointer pool_maintainer_run(gpointer data)
+{
+    (void)data;
+    g_mutex_lock(&g_pool.mutex);
+    while (!g_pool.stopping) {
+        g_pool.wake = false;
+        g_mutex_unlock(&g_pool.mutex);
+        argus_pool_maintain();
+        g_mutex_lock(&g_pool.mutex);
+
+        gint64 deadline = g_get_monotonic_time() +
+            (gint64)g_pool.maintain_interval_sec * G_USEC_PER_SEC;
+        while (!g_pool.stopping && !g_pool.wake &&
+               g_cond_wait_until(&g_pool.cond, &g_pool.mutex, deadline))
+            ;
+    }
+    g_mutex_unlock(&g_pool.mutex);
+    return NULL;
+}
+
+/*
+ * Keep min_idle idle connections open for this pool key, opened with a
+ * copy of dbc's settings (registering again replaces them, so a rotated
+ * password or token is picked up). min_idle <= 0 stops pre-warming it.
+ */
+void argus_pool_warm(const argus_dbc_t *dbc, const char *host, int port,
+                     const char *backend_name, const char *username,
+                     const argus_backend_t *backend, int min_idle)
+{
+    pool_ensure_init();
+
+    argus_dbc_t *cfg = NULL;
+    if (min_idle > 0) {
+        cfg = argus_dbc_clone_config(dbc);
+        if (!cfg) return;
+    }
+
+    g_mutex_lock(&g_pool.mutex);
+    int i = pool_warm_find(host, port, backend_name, username);
+    if (i >= 0) {
+        argus_pool_warm_t *w = &g_pool.warm[i];
+        argus_dbc_free_config(w->cfg);
+        if (min_idle > 0) {
+            w->cfg = cfg;
+            w->backend = backend;
+            w->min_idle = min_idle;
+        } else {
+            free(w->host);
+            free(w->backend_name);
+            free(w->username);
+            g_pool.warm[i] = g_pool.warm[--g_pool.warm_count];
+        }
+    } else if (min_idle > 0) {
+        argus_pool_warm_t *grown = realloc(
+            g_pool.warm, (size_t)(g_pool.warm_count + 1) * sizeof(*grown));
+        char *h = strdup(host);
+        char *b = strdup(backend_name);
+        char *u = strdup(username ? username : "");
+        if (!grown || !h || !b || !u) {
+            if (grown) g_pool.warm = grown;
+            free(h);
+            free(b);
+            free(u);
+            argus_dbc_free_config(cfg);
+            g_mutex_unlock(&g_pool.mutex);
+            return;
+        }
+        g_pool.warm = grown;
+        g_pool.warm[g_pool.warm_count++] = (argus_pool_warm_t){
+            .host = h, .port = port, .backend_name = b, .username = u,
+            .backend = backend, .cfg = cfg, .min_idle = min_idle,
+        };
+        ARGUS_LOG_DEBUG("Pool: keeping %d connection(s) to %s:%d warm",
+                        min_idle, host, port);
+    }
+
+    if (g_pool.warm_count > 0 && !g_pool.maintainer && !g_pool.stopping) {
+        g_pool.maintainer = g_thread_try_new("argus-pool",
+                                             pool_maintainer_run, NULL, NULL);
+        if (!g_pool.maintainer)
+            ARGUS_LOG_WARN("Pool: cannot start the maintainer thread");
+    }
+    g_pool.wake = true;
+    g_cond_broadcast(&g_pool.cond);
+    g_mutex_unlock(&g_pool.mutex);
+}
+
+/* Open one connection for a warm key and pool it as idle. */
+static bool pool_create(argus_dbc_t *cfg, const argus_backend_t *backend,
+                        const char *host, int port,
+                        const char *backend_name, const char *username)
+{
+    argus_backend_conn_t conn = NULL;
+    gint64 start = g_get_monotonic_time();
+    int rc = backend->connect(cfg, host, port, username,
+                              cfg->password ? cfg->password : "",
+                              cfg->database ? cfg->database : "default",
+                              cfg->auth_mechanism ? cfg->auth_mechanism
+                                                  : "NOSASL",
+                              &conn);
+    double ms = (double)(g_get_monotonic_time() - start) / 1000.0;
+    argus_host_health_record(host, port, rc == 0, ms, cfg->host_cooldown_sec);
+
+    g_mutex_lock(&g_pool.mutex);
+    if (rc != 0) {
+        g_pool.stats.create_failures++;
+        g_mutex_unlock(&g_pool.mutex);
+        ARGUS_LOG_WARN("Pool: pre-warming %s:%d failed: %s", host, port,
+                       cfg->diag.count > 0
+                           ? (const char *)cfg->diag.records[0].message
+                           : "unknown error");
+        return false;
+    }
+    g_pool.stats.creates++;
+    g_pool.stats.create_ms_total += ms;
+    if (ms > g_pool.stats.create_ms_max)
+        g_pool.stats.create_ms_max = ms;
+    argus_pool_entry_t *e = g_pool.stopping ? NULL
+        : pool_add_entry(host, port, backend_name, username, backend, conn);
+    g_mutex_unlock(&g_pool.mutex);
+
+    if (!e) {
+        backend->disconnect(conn);
+        return false;
+    }
+    ARGUS_LOG_DEBUG("Pool: pre-warmed connection to %s:%d (%.1f ms)",
+                    host, port, ms);
+    return true;
+}
+
+/* Connect until warm key k has min_idle fresh idle connections, within the
+ * pool limits. Stops at the first failure; the next pass retries. */
+static void pool_refill(int k)
+{
+    for (;;) {
+        g_mutex_lock(&g_pool.mutex);
+        if (k >= g_pool.warm_count || g_pool.stopping) break;
+
+        const argus_pool_warm_t *w = &g_pool.warm[k];
+        int active = 0;
+        int fresh = pool_warm_fresh(w, g_get_monotonic_time(), &active);
+        if (fresh >= w->min_idle || active >= g_pool.max_per_key ||
+            g_pool.count >= g_pool.max_total ||
+            g_pool.count >= g_pool.capacity)
+            break;
+
+        /* The key may be re-registered while we connect: use copies */
+        argus_dbc_t *cfg = argus_dbc_clone_config(w->cfg);
+        const argus_backend_t *backend = w->backend;
+        char *host = strdup(w->host);
+        char *bname = strdup(w->backend_name);
+        char *user = strdup(w->username);
+        int port = w->port;
+        g_mutex_unlock(&g_pool.mutex);
+
+        bool ok = cfg && host && bname && user &&
+                  pool_create(cfg, backend, host, port, bname, user);
+        argus_dbc_free_config(cfg);
+        free(host);
+        free(bname);
+        free(user);
+        if (!ok) return;
+    }
+    g_mutex_unlock(&g_pool.mutex);
+}
+
+/* Close the idle connections of warm keys that are about to reach the
+ * TTL, once fresh ones stand in for them. */
+static void pool_retire(void)
+{
+    g_mutex_lock(&g_pool.mutex);
+    pool_conn_t *drop = calloc((size_t)(g_pool.count > 0 ? g_pool.count : 1),
+                               sizeof(*drop));
+    if (!drop) {
+        g_mutex_unlock(&g_pool.mutex);
+        return;
+    }
+    int ndrop = 0;
+    gint64 now = g_get_monotonic_time();
+
+    for (int k = 0; k < g_pool.warm_count; k++) {
+        const argus_pool_warm_t *w = &g_pool.warm[k];
+        if (pool_warm_fresh(w, now, NULL) < w->min_idle)
+            continue;
+        int i = 0;
+        while (i < g_pool.count) {
+            argus_pool_entry_t *e = &g_pool.entries[i];
+            if (!e->in_use && pool_entry_expiring(e, now) &&
+                pool_entry_matches(e, w->host, w->port, w->backend_name,
+                                   w->username)) {
+                drop[ndrop].b = e->backend;
+                drop[ndrop].c = e->conn;
+                ndrop++;
+                pool_remove_at(i);
+                g_pool.stats.replaced++;
+                continue;
+            }
+            i++;
+        }
+    }
+    g_mutex_unlock(&g_pool.mutex);
+
+    pool_disconnect_all(drop, ndrop);
+    free(drop);
+}
+
+/*
+ * One maintenance pass (the maintainer thread runs it every
+ * ARGUS_POOL_MAINTAIN_INTERVAL seconds): close idle connections past the
+ * idle timeout, leaving warm keys their minimum; check the ones not
+ * validated for ARGUS_POOL_VALIDATE_INTERVAL seconds with is_alive();
+ * top warm keys up, then retire what the new connections replace.
+ */
+void argus_pool_maintain(void)
+{
+    if (!g_pool.init_once) return;
+
+    g_mutex_lock(&g_pool.maintain_lock);
+    g_mutex_lock(&g_pool.mutex);
+    if (!g_pool.entries) {
+        g_mutex_unlock(&g_pool.mutex);
+        g_mutex_unlock(&g_pool.maintain_lock);
+        return;
+    }
+    size_t n = (size_t)(g_pool.count > 0 ? g_pool.count : 1);
+    pool_conn_t *drop = calloc(n, sizeof(*drop));
+    pool_conn_t *check = calloc(n, sizeof(*check));
+    bool *alive = calloc(n, sizeof(*alive));
+    if (!drop || !check || !alive) {
+        g_mutex_unlock(&g_pool.mutex);
+        g_mutex_unlock(&g_pool.maintain_lock);
+        free(drop);
+        free(check);
+        free(alive);
+        return;
+    }
+
+    gint64 now = g_get_monotonic_time();
+    gint64 idle_us = (gint64)g_pool.idle_timeout_sec * G_USEC_PER_SEC;
+    gint64 validate_us = (gint64)g_pool.validate_interval_sec *
+                         G_USEC_PER_SEC;
+    int ndrop = 0, ncheck = 0;
+    int i = 0;
+    while (i < g_pool.count) {
+        argus_pool_entry_t *e = &g_pool.entries[i];
+        if (e->in_use) {
+            i++;
+            continue;
+        }
+        if (g_pool.idle_timeout_sec > 0 && now - e->last_used > idle_us &&
+            pool_entry_spare(e)) {
+            ARGUS_LOG_DEBUG("Pool: evicting idle connection to %s:%d",
+                            e->host, e->port);
+            drop[ndrop].b = e->backend;
+            drop[ndrop].c = e->conn;
+            ndrop++;
+            pool_remove_at(i);
+            g_pool.stats.evicted++;
+            continue;
+        }
+        if (e->backend && e->backend->is_alive &&
+            now - e->validated > validate_us) {
+            /* Checked out while the check talks to the server */
+            e->in_use = true;
+            check[ncheck].b = e->backend;
+            check[ncheck].c = e->conn;
+            ncheck++;
+        }
+        i++;
+    }
+    g_mutex_unlock(&g_pool.mutex);
+    pool_disconnect_all(drop, ndrop);
+
+    for (i = 0; i < ncheck; i++)
+        alive[i] = check[i].b->is_alive(check[i].c);
+
+    g_mutex_lock(&g_pool.mutex);
+    now = g_get_monotonic_time();
+    ndrop = 0;
+    for (i = 0; i < ncheck; i++) {
+        int at = pool_find_conn(check[i].c);
+        if (at < 0) continue;
+        argus_pool_entry_t *e = &g_pool.entries[at];
+        if (alive[i]) {
+            e->in_use = false;
+            e->validated = now;
+            continue;
+        }
+        ARGUS_LOG_DEBUG("Pool: idle connection to %s:%d is dead, dropping",
+                        e->host, e->port);
+        drop[ndrop++] = check[i];
+        pool_remove_at(at);
+        g_pool.stats.validation_failures++;
+    }
+    int warm_count = g_pool.warm_count;
+    g_mutex_unlock(&g_pool.mutex);
+    pool_disconnect_all(drop, ndrop);
+
+    for (int k = 0; k < warm_count; k++)
+        pool_refill(k);
+    pool_retire();
+
+    g_mutex_unlock(&g_pool.maintain_lock);
+    free(drop);
+    free(check);
+    free(alive);
+}
+
+/* ── Public: pool statistics ─────────────────────────────────── */
+
+void argus_pool_get_stats(argus_pool_stats_t *out)
+{
+    pool_ensure_init();
+    g_mutex_lock(&g_pool.mutex);
+    *out = g_pool.stats;
+    out->idle = 0;
+    out->in_use = 0;
+    for (int i = 0; i < g_pool.count; i++) {
+        if (g_pool.entries[i].in_use)
+            out->in_use++;
+        else
+            out->idle++;
+    }
+    out->warm_keys = g_pool.warm_count;
+    g_mutex_unlock(&g_pool.mutex);
+}
@@ -0,0 +1,498 @@
+/*
+ * Client-side query result cache (opt-in, RESULTCACHE=1).
+ *
+ * Dashboards re-issue byte-identical SELECTs on every refresh and for every
+ * tile. With the cache on, do_execute() first looks the statement up here;
+ * on a hit the stored result is replayed into the statement's row cache and
+ * the backend is never contacted. On a miss the statement runs normally and
+ * the batches the application fetches are captured as they go by; once the
+ * result has been read to the end it becomes a cache entry.
+ *
+ * Cache key: connection identity (backend, host, port, user, database,
+ * catalog) + the escape-translated, parameter-substituted SQL with
+ * whitespace collapsed outside quoted text.
+ * Only SELECT / WITH queries free of volatile functions (now(),
+ * current_timestamp, rand(), ...) are cacheable; RESULTCACHEPATTERN narrows
+ * this further to the statements matching a regular expression.
+ * Entries live for RESULTCACHETTL seconds. The cache is process-wide and
+ * bounded by RESULTCACHEMAXBYTES: least recently used entries are evicted
+ * first, and a single result may use at most a quarter of the budget.
+ * A write statement (INSERT, CREATE, DROP, ...) executed through a
+ * connection drops every entry with the same connection identity.
+ */
+#include "argus/handle.h"
+#include "argus/log.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+/* ── Cache entry ─────────────────────────────────────────────── */
+
+typedef struct {
+    char                *key;
+    argus_row_cache_t    rows;         /* immutable once published */
+    argus_column_desc_t *columns;
+    int                  num_cols;
+    size_t               bytes;
+    gint64               created_at;   /* monotonic microseconds */
+    GList               *lru_link;     /* node in rc_lru while cached */
+    gint                 refcount;
+} result_entry_t;
+
+/* Per-statement capture of a result that may become an entry */
+typedef struct {
+    char              *key;
+    argus_row_cache_t  rows;
+    size_t             bytes;
+    bool               active;         /* execute succeeded; capturing */
+} result_capture_t;
+
+static GMutex      rc_lock;
+static GHashTable *rc_table;           /* key -> result_entry_t* */
+static GQueue      rc_lru = G_QUEUE_INIT;  /* head = most recently used */
+static size_t      rc_bytes;
+static size_t      rc_max_bytes = ARGUS_DEFAULT_RESULT_CACHE_BYTES;
+
+static void entry_unref(result_entry_t *entry)
+{
+    if (!entry || !g_atomic_int_dec_and_test(&entry->refcount)) return;
+    argus_row_cache_free(&entry->rows);
+    free(entry->columns);
+    free(entry->key);
+    free(entry);
+}
+
+/* Unlink an entry from the table and LRU list. Caller holds rc_lock. */
+static void entry_remove_locked(result_entry_t *entry)
+{
+    g_hash_table_remove(rc_table, entry->key);
+    g_queue_delete_link(&rc_lru, entry->lru_link);
+    entry->lru_link = NULL;
+    rc_bytes -= entry->bytes;
+    entry_unref(entry);
+}
+
+static void evict_to_locked(size_t limit)
+{
+    while (rc_bytes > limit && rc_lru.tail) {
+        result_entry_t *victim = (result_entry_t *)rc_lru.tail->data;
+        ARGUS_LOG_DEBUG("Result cache: evicting %zu bytes", victim->bytes);
+        entry_remove_locked(victim);
+    }
+}
+
+/* ── Row copies ──────────────────────────────────────────────── */
+
+static size_t row_bytes(const argus_row_t *row, int num_cols)
+{
+    size_t n = sizeof(argus_row_t);
+    if (!row->cells) return n;
+    n += (size_t)num_cols * sizeof(argus_cell_t);
+    for (int c = 0; c < num_cols; c++) {
+        if (row->cells[c].data) n += row->cells[c].data_len + 1;
+    }
+    return n;
+}
+
+/* Append copies of src's rows (native values included) to dst. */
+static bool rows_append(argus_row_cache_t *dst, const argus_row_t *src,
+                        size_t count, int num_cols)
+{
+    if (dst->num_rows + count > dst->capacity) {
+        size_t cap = dst->capacity ? dst->capacity : 64;
+        while (cap < dst->num_rows + count) cap *= 2;
+        argus_row_t *grown = realloc(dst->rows, cap * sizeof(argus_row_t));
+        if (!grown) return false;
+        dst->rows = grown;
+        dst->capacity = cap;
+    }
+    dst->num_cols = num_cols;
+
+    for (size_t r = 0; r < count; r++) {
+        if (argus_row_copy(&dst->rows[dst->num_rows], &src[r], num_cols) != 0)
+            return false;
+        dst->num_rows++;
+    }
+    return true;
+}
+
+/* ── Statement classification ────────────────────────────────── */
+
+static bool is_ident_char(char c)
+{
+    return isalnum((unsigned char)c) || c == '_';
+}
+
+/* True if `word` occurs in lowercase `sql` as a whole word (followed by an
+ * opening parenthesis when `call` is set). */
+static bool contains_word(const char *sql, const char *word, bool call)
+{
+    size_t n = strlen(word);
+    for (const char *p = strstr(sql, word); p; p = strstr(p + 1, word)) {
+        if (p > sql && is_ident_char(p[-1])) continue;
+        const char *q = p + n;
+        if (is_ident_char(*q)) continue;
+        if (!call) return true;
+        while (*q == ' ') q++;
+        if (*q == '(') return true;
+    }
+    return false;
+}
+
+char *argus_result_cache_normalize(const char *query)
+{
+    if (!query) return NULL;
+    size_t len = strlen(query);
+    char *out = malloc(len + 1);
+    if (!out) return NULL;
+
+    size_t o = 0;
+    char quote = 0;
+    bool pending_space = false;
+    for (const char *p = query; *p; p++) {
+        char c = *p;
+        if (quote) {
+            out[o++] = c;
+            if (c == quote) quote = 0;
+            continue;
+        }
+        if (isspace((unsigned char)c)) {
+            pending_space = (o > 0);
+            continue;
+        }
+        if (pending_space) {
+            out[o++] = ' ';
+            pending_space = false;
+        }
+        if (c == '\'' || c == '"' || c == '`') quote = c;
+        out[o++] = c;
+    }
+    /* A trailing statement terminator does not change the result */
+    while (o > 0 && !quote && (out[o - 1] == ';' || out[o - 1] == ' '))
+        o--;
+    out[o] = '\0';
+    return out;
+}
+
+bool argus_result_cache_is_cacheable(const char *query)
+{
+    static const struct { const char *word; bool call; } volatile_fns[] = {
+        { "now", true },           { "current_timestamp", false },
+        { "current_date", false }, { "current_time", false },
+        { "localtimestamp", false }, { "localtime", false },
+        { "sysdate", false },      { "getdate", true },
+        { "unix_timestamp", true }, { "rand", true },
+        { "random", true },        { "uuid", true },
+        { "nextval", true },
+    };
+
+    if (!query) return false;
+    const char *p = argus_sql_skip_leading(query);
+    bool with = argus_sql_keyword_at(p, "WITH");
+    if (!argus_sql_keyword_at(p, "SELECT") && !with) return false;
+
+    char *lower = g_ascii_strdown(p, -1);
+    bool ok = true;
+    for (size_t i = 0; ok && i < G_N_ELEMENTS(volatile_fns); i++) {
+        if (contains_word(lower, volatile_fns[i].word, volatile_fns[i].call))
+            ok = false;
+    }
+    /* SELECT ... INTO and data-modifying CTEs write */
+    if (ok && (contains_word(lower, "into", false) ||
+               (with && (contains_word(lower, "insert", false) ||
+                         contains_word(lower, "update", false) ||
+                         contains_word(lower, "delete", false) ||
+                         contains_word(lower, "merge", false)))))
+        ok = false;
+    g_free(lower);
+    return ok;
+}
+
+static bool is_write_statement(const char *query)
+{
+    static const char *const writes[] = {
+        "INSERT", "UPDATE", "DELETE", "MERGE", "UPSERT", "REPLACE",
+        "CREATE", "DROP", "ALTER", "TRUNCATE", "LOAD", "RENAME",
+        "REFRESH", "INVALIDATE", "MSCK", "COMPUTE", "OPTIMIZE",
+    };
+    const char *p = argus_sql_skip_leading(query);
+    for (size_t i = 0; i < G_N_ELEMENTS(writes); i++) {
+        if (argus_sql_keyword_at(p, writes[i])) return true;
+    }
+    return false;
+}
+
+/* ── Keys ────────────────────────────────────────────────────── */
+
+static char *identity_prefix(const argus_dbc_t *dbc)
+{
+    const char *host = dbc->connected_host ? dbc->connected_host : dbc->host;
+    int port = dbc->connected_host ? dbc->connected_port : dbc->port;
+    return g_strdup_printf("%s|%s:%d|%s|%s|%s\n",
+                           dbc->backend_name ? dbc->backend_name : "",
+                           host ? host : "", port,
+                           dbc->username ? dbc->username : "",
+                           dbc->database ? dbc->database : "",
+                           dbc->current_catalog ? dbc->current_catalog : "");
+}
+
+static bool matches_pattern(argus_dbc_t *dbc, const char *sql)
+{
+    if (!dbc->result_cache_pattern || !*dbc->result_cache_pattern)
+        return true;
+    if (!dbc->result_cache_regex) {
+        GError *error = NULL;
+        dbc->result_cache_regex = g_regex_new(dbc->result_cache_pattern,
+                                              G_REGEX_CASELESS, 0, &error);
+        if (!dbc->result_cache_regex) {
+            ARGUS_LOG_WARN("Result cache: invalid RESULTCACHEPATTERN: %s",
+                           error ? error->message : "?");
+            if (error) g_error_free(error);
+            /* Cache nothing rather than everything */
+            free(dbc->result_cache_pattern);
+            dbc->result_cache_pattern = NULL;
+            dbc->result_cache = false;
+            return false;
+        }
+    }
+    return g_regex_match((GRegex *)dbc->result_cache_regex, sql, 0, NULL);
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void argus_result_cache_configure(size_t max_bytes)
+{
+    g_mutex_lock(&rc_lock);
+    rc_max_bytes = max_bytes;
+    evict_to_locked(rc_max_bytes);
+    g_mutex_unlock(&rc_lock);
+}
+
+size_t argus_result_cache_bytes(void)
+{
+    g_mutex_lock(&rc_lock);
+    size_t n = rc_bytes;
+    g_mutex_unlock(&rc_lock);
+    return n;
+}
+
+void argus_result_cache_clear(void)
+{
+    g_mutex_lock(&rc_lock);
+    evict_to_locked(0);
+    g_mutex_unlock(&rc_lock);
+}
+
+void argus_result_cache_release(argus_stmt_t *stmt)
+{
+    result_capture_t *cap = (result_capture_t *)stmt->result_capture;
+    if (!cap) return;
+    argus_row_cache_free(&cap->rows);
+    free(cap->key);
+    free(cap);
+    stmt->result_capture = NULL;
+}
+
+/*
+ * Look up a query before it is sent to the backend. On a hit the cached
+ * result is copied into stmt (already exhausted, so SQLFetch never calls the
+ * backend) and true is returned. On a miss of a cacheable query the key is
+ * remembered so argus_result_cache_begin can start capturing.
+ */
+bool argus_result_cache_lookup(argus_stmt_t *stmt, const char *query)
+{
+    argus_dbc_t *dbc = stmt->dbc;
+    argus_result_cache_release(stmt);
+    if (!dbc->result_cache) return false;
+
+    char *sql = argus_result_cache_normalize(query);
+    if (!sql) return false;
+    if (!argus_result_cache_is_cacheable(sql) || !matches_pattern(dbc, sql)) {
+        free(sql);
+        return false;
+    }
+
+    char *prefix = identity_prefix(dbc);
+    char *key = g_strconcat(prefix, sql, NULL);
+    g_free(prefix);
+    free(sql);
+
+    g_mutex_lock(&rc_lock);
+    result_entry_t *entry = rc_table
+        ? (result_entry_t *)g_hash_table_lookup(rc_table, key) : NULL;
+    if (entry) {
+        gint64 age_us = g_get_monotonic_time() - entry->created_at;
+        if (age_us > (gint64)dbc->result_cache_ttl_sec * G_USEC_PER_SEC) {
+            entry_remove_locked(entry);
+            entry = NULL;
+        } else {
+            g_queue_unlink(&rc_lru, entry->lru_link);
+            g_queue_push_head_link(&rc_lru, entry->lru_link);
+            g_atomic_int_inc(&entry->refcount);
+        }
+    }
+    g_mutex_unlock(&rc_lock);
+
+    if (entry) {
+        /* The entry is immutable and pinned by our reference, so the copy
+         * runs without holding the cache lock. */
+        bool ok = argus_stmt_ensure_columns(stmt, entry->num_cols) == 0 &&
+                  rows_append(&stmt->row_cache, entry->rows.rows,
+                              entry->rows.num_rows, entry->num_cols);
+        if (ok) {
+            memcpy(stmt->columns, entry->columns,
+                   (size_t)entry->num_cols * sizeof(argus_column_desc_t));
+            stmt->num_cols = entry->num_cols;
+            stmt->metadata_fetched = true;
+            stmt->executed = true;
+            stmt->row_cache.exhausted = true;
+            stmt->row_cache.current_row = 0;
+            /* As for metadata cache hits: there is no backend op, so SQLFetch
+             * must iterate the cache rather than fetch another batch. */
+            stmt->fetch_started = true;
+            dbc->result_cache_hits++;
+            ARGUS_LOG_DEBUG("Result cache hit (%zu rows)",
+                            entry->rows.num_rows);
+        } else {
+            argus_row_cache_clear(&stmt->row_cache);
+        }
+        entry_unref(entry);
+        if (ok) {
+            g_free(key);
+            return true;
+        }
+    }
+
+    dbc->result_cache_misses++;
+    result_capture_t *cap = calloc(1, sizeof(*cap));
+    if (cap) {
+        cap->key = strdup(key);
+        if (cap->key) stmt->result_capture = cap;
+        else free(cap);
+    }
+    g_free(key);
+    return false;
+}
+
+/*
+ * Called once the statement has executed on the backend. Starts capturing a
+ * cacheable result; a write statement instead invalidates the entries of
+ * this connection's identity.
+ */
+void argus_result_cache_begin(argus_stmt_t *stmt, const char *query)
+{
+    argus_dbc_t *dbc = stmt->dbc;
+    if (!dbc->result_cache) return;
+
+    result_capture_t *cap = (result_capture_t *)stmt->result_capture;
+    if (cap) {
+        cap->active = true;
+        return;
+    }
+    if (is_write_statement(query))
+        argus_result_cache_invalidate(dbc);
+}
+
+/*
+ * Record the batch just fetched into stmt->row_cache. An empty batch ends the
+ * result, which is then published. Results over the per-entry limit are
+ * dropped and no longer captured.
+ */
+void argus_result_cache_capture(argus_stmt_t *stmt)
+{
+    result_capture_t *cap = (result_capture_t *)stmt->result_capture;
+    if (!cap || !cap->active) return;
+
+    const argus_row_cache_t *batch = &stmt->row_cache;
+    if (batch->num_rows > 0) {
+        g_mutex_lock(&rc_lock);
+        size_t limit = rc_max_bytes / 4;
+        g_mutex_unlock(&rc_lock);
+
+        size_t add = 0;
+        for (size_t r = 0; r < batch->num_rows; r++)
+            add += row_bytes(&batch->rows[r], stmt->num_cols);
+        if (cap->bytes + add > limit ||
+            !rows_append(&cap->rows, batch->rows, batch->num_rows,
+                         stmt->num_cols)) {
+            ARGUS_LOG_DEBUG("Result cache: result too large to cache");
+            argus_result_cache_release(stmt);
+            return;
+        }
+        cap->bytes += add;
+        return;
+    }
+
+    /* End of the result: publish it */
+    result_entry_t *entry = calloc(1, sizeof(*entry));
+    if (!entry) {
+        argus_result_cache_release(stmt);
+        return;
+    }
+    entry->num_cols = stmt->num_cols;
+    if (entry->num_cols > 0) {
+        entry->columns = malloc((size_t)entry->num_cols *
+                                sizeof(argus_column_desc_t));
+        if (!entry->columns) {
+            free(entry);
+            argus_result_cache_release(stmt);
+            return;
+        }
+        memcpy(entry->columns, stmt->columns,
+               (size_t)entry->num_cols * sizeof(argus_column_desc_t));
+    }
+    entry->key = cap->key;
+    entry->rows = cap->rows;
+    entry->rows.num_cols = entry->num_cols;
+    entry->rows.exhausted = true;
+    entry->bytes = cap->bytes + strlen(cap->key) + 1 + sizeof(*entry) +
+                   (size_t)entry->num_cols * sizeof(argus_column_desc_t);
+    entry->created_at = g_get_monotonic_time();
+    entry->refcount = 1;
+    free(cap);
+    stmt->result_capture = NULL;
+
+    g_mutex_lock(&rc_lock);
+    if (!rc_table)
+        rc_table = g_hash_table_new(g_str_hash, g_str_equal);
+    if (entry->bytes > rc_max_bytes / 4) {
+        g_mutex_unlock(&rc_lock);
+        entry_unref(entry);
+        return;
+    }
+    result_entry_t *old =
+        (result_entry_t *)g_hash_table_lookup(rc_table, entry->key);
+    if (old) entry_remove_locked(old);
+    evict_to_locked(rc_max_bytes - entry->bytes);
+    g_hash_table_insert(rc_table, entry->key, entry);
+    g_queue_push_head(&rc_lru, entry);
+    entry->lru_link = rc_lru.head;
+    rc_bytes += entry->bytes;
+    size_t total = rc_bytes;
+    g_mutex_unlock(&rc_lock);
+
+    ARGUS_LOG_DEBUG("Result cache stored %zu rows (%zu bytes, %zu total)",
+                    entry->rows.num_rows, entry->bytes, total);
+}
+
+/* Drop every entry cached under dbc's connection identity. */
+void argus_result_cache_invalidate(argus_dbc_t *dbc)
+{
+    char *prefix = identity_prefix(dbc);
+    size_t plen = strlen(prefix);
+
+    g_mutex_lock(&rc_lock);
+    GList *link = rc_lru.head;
+    while (link) {
+        GList *next = link->next;
+        result_entry_t *entry = (result_entry_t *)link->data;
+        if (strncmp(entry->key, prefix, plen) == 0)
+            entry_remove_locked(entry);
+        link = next;
+    }
+    g_mutex_unlock(&rc_lock);
+
+    g_free(prefix);
+    ARGUS_LOG_DEBUG("Result cache invalidated for this connection");
+}
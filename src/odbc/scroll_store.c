@@ -0,0 +1,520 @@
+/*
+ * scroll_store.c - Row store behind static (scrollable) cursors.
+ *
+ * A static cursor has to keep every row it has read so SQLFetchScroll can go
+ * back to it. Holding them as argus_row_t costs two allocations and a cell
+ * struct per value, which is several times the data itself on the narrow
+ * columns reports are made of. The store packs rows into pages instead:
+ *
+ *   - a page holds SCROLL_PAGE_ROWS rows, column by column: per column an
+ *     offset array, a flags array (NULL, has text, native kind) and the cell
+ *     records back to back (the 8-byte native value if any, then the text and
+ *     its NUL). Every page but the last is full, so row n lives on page
+ *     n / SCROLL_PAGE_ROWS and any row is found in constant time;
+ *   - a page is optionally deflated (GIO's zlib converter) when it fills, and
+ *     kept that way only when that saves at least an eighth;
+ *   - complete pages are resident up to the memory budget; past it the least
+ *     recently read ones move to an anonymous temporary file and are read
+ *     back on demand into a one-page slot.
+ *
+ * The row argus_scroll_store_get returns points into the page it was read
+ * from and stays valid until the next get or append.
+ */
+
+#include "argus/handle.h"
+#include "argus/log.h"
+#include <gio/gio.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCROLL_PAGE_ROWS    1024
+
+/* Pages smaller than this are not worth a deflate pass */
+#define SCROLL_COMPRESS_MIN 4096
+
+/* Cell flags; bits 2-3 carry the argus_native_kind_t */
+#define CELL_NULL           0x01
+#define CELL_TEXT           0x02
+#define CELL_KIND_SHIFT     2
+
+/* Size of one column section of a full page, before its cell records */
+#define SECTION_HEAD  (sizeof(guint32) * (SCROLL_PAGE_ROWS + 1) + SCROLL_PAGE_ROWS)
+
+typedef struct scroll_page {
+    unsigned char *buf;         /* resident bytes; NULL once spilled */
+    size_t         len;         /* stored length (compressed or raw) */
+    size_t         raw_len;
+    bool           compressed;
+    goffset        file_off;    /* where the page was spilled */
+    GList          lru;         /* link in the resident queue; data = page */
+} scroll_page_t;
+
+/* The page being filled, one growing record buffer per column */
+typedef struct col_builder {
+    GByteArray *records;
+    guint32     off[SCROLL_PAGE_ROWS + 1];
+    guint8      flags[SCROLL_PAGE_ROWS];
+} col_builder_t;
+
+struct argus_scroll_store {
+    int             num_cols;
+    size_t          memory_budget;
+    bool            compress;
+
+    scroll_page_t **pages;          /* complete pages */
+    size_t          num_pages;
+    size_t          pages_cap;
+    col_builder_t  *open;           /* num_cols builders */
+    size_t          open_rows;
+    size_t          open_bytes;
+
+    GQueue          resident;       /* least recently read first */
+    uint64_t        resident_bytes;
+    uint64_t        spilled_bytes;
+
+    /* Spill file */
+    GFile          *file;
+    GFileIOStream  *io;
+    goffset         file_end;
+
+    /* Last page read back from disk or inflated */
+    unsigned char  *slot;
+    size_t          slot_cap;
+    size_t          slot_page;      /* SIZE_MAX = empty */
+    unsigned char  *io_buf;         /* compressed bytes read from disk */
+    size_t          io_cap;
+
+    GConverter     *deflater;
+    GConverter     *inflater;
+
+    argus_row_t     row;            /* what get returns */
+    char            error[256];
+};
+
+static void store_error(argus_scroll_store_t *s, const char *what,
+                        const GError *err)
+{
+    snprintf(s->error, sizeof(s->error), "%s%s%s", what,
+             err ? ": " : "", err ? err->message : "");
+    ARGUS_LOG_ERROR("Scroll store: %s", s->error);
+}
+
+static bool ensure_buf(unsigned char **buf, size_t *cap, size_t need)
+{
+    if (*cap >= need) return true;
+    unsigned char *grown = realloc(*buf, need);
+    if (!grown) return false;
+    *buf = grown;
+    *cap = need;
+    return true;
+}
+
+/* ── Compression ─────────────────────────────────────────────── */
+
+/* Run `conv` over all of `in`. Fails when the output does not fit. */
+static bool convert(GConverter *conv, const unsigned char *in, size_t in_len,
+                    unsigned char *out, size_t out_cap, size_t *out_len)
+{
+    size_t in_done = 0, out_done = 0;
+    g_converter_reset(conv);
+    for (;;) {
+        gsize r = 0, w = 0;
+        GError *err = NULL;
+        GConverterResult res = g_converter_convert(
+            conv, in + in_done, in_len - in_done,
+            out + out_done, out_cap - out_done,
+            G_CONVERTER_INPUT_AT_END, &r, &w, &err);
+        if (res == G_CONVERTER_ERROR) {
+            g_error_free(err);
+            return false;
+        }
+        in_done += r;
+        out_done += w;
+        if (res == G_CONVERTER_FINISHED) break;
+        if (r == 0 && w == 0) return false;
+    }
+    *out_len = out_done;
+    return true;
+}
+
+/* Deflate a sealed page in place when that pays */
+static void compress_page(argus_scroll_store_t *s, scroll_page_t *p)
+{
+    if (p->raw_len < SCROLL_COMPRESS_MIN) return;
+    if (!s->deflater)
+        s->deflater = G_CONVERTER(g_zlib_compressor_new(
+            G_ZLIB_COMPRESSOR_FORMAT_RAW, 1));
+
+    size_t cap = p->raw_len - p->raw_len / 8;
+    unsigned char *out = malloc(cap);
+    size_t out_len = 0;
+    if (!out) return;
+    if (!convert(s->deflater, p->buf, p->raw_len, out, cap, &out_len)) {
+        free(out);
+        return;
+    }
+    unsigned char *fit = realloc(out, out_len);
+    free(p->buf);
+    p->buf = fit ? fit : out;
+    p->len = out_len;
+    p->compressed = true;
+}
+
+/* ── Spilling ────────────────────────────────────────────────── */
+
+static bool spill_open(argus_scroll_store_t *s)
+{
+    GError *err = NULL;
+    s->file = g_file_new_tmp("argus-scroll-XXXXXX", &s->io, &err);
+    if (!s->file) {
+        store_error(s, "cannot create the spill file", err);
+        if (err) g_error_free(err);
+        return false;
+    }
+    ARGUS_LOG_DEBUG("Scroll store: spilling to %s",
+                    g_file_peek_path(s->file));
+#ifndef _WIN32
+    /* Unlinked while open: nothing is left behind, even after a crash */
+    g_file_delete(s->file, NULL, NULL);
+    g_clear_object(&s->file);
+#endif
+    return true;
+}
+
+static bool spill_page(argus_scroll_store_t *s, scroll_page_t *p)
+{
+    if (!s->io && !spill_open(s)) return false;
+
+    GError *err = NULL;
+    gsize written = 0;
+    GOutputStream *out = g_io_stream_get_output_stream(G_IO_STREAM(s->io));
+    if (!g_seekable_seek(G_SEEKABLE(s->io), s->file_end, G_SEEK_SET,
+                         NULL, &err) ||
+        !g_output_stream_write_all(out, p->buf, p->len, &written,
+                                   NULL, &err)) {
+        store_error(s, "cannot write the spill file", err);
+        if (err) g_error_free(err);
+        return false;
+    }
+
+    p->file_off = s->file_end;
+    s->file_end += (goffset)p->len;
+    free(p->buf);
+    p->buf = NULL;
+    s->resident_bytes -= p->len;
+    s->spilled_bytes += p->len;
+    return true;
+}
+
+/* Spill the least recently read pages until the budget holds */
+static bool enforce_budget(argus_scroll_store_t *s)
+{
+    while (s->resident_bytes + s->open_bytes > s->memory_budget &&
+           !g_queue_is_empty(&s->resident)) {
+        GList *link = g_queue_pop_head_link(&s->resident);
+        if (!spill_page(s, link->data)) {
+            g_queue_push_head_link(&s->resident, link);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* ── Building pages ──────────────────────────────────────────── */
+
+static void open_reset(argus_scroll_store_t *s)
+{
+    for (int c = 0; c < s->num_cols; c++) {
+        g_byte_array_set_size(s->open[c].records, 0);
+        s->open[c].off[0] = 0;
+    }
+    s->open_rows = 0;
+    s->open_bytes = 0;
+}
+
+static bool seal_page(argus_scroll_store_t *s)
+{
+    size_t raw_len = sizeof(guint64) * (size_t)s->num_cols;
+    for (int c = 0; c < s->num_cols; c++)
+        raw_len += SECTION_HEAD + s->open[c].records->len;
+
+    if (s->num_pages == s->pages_cap) {
+        size_t cap = s->pages_cap ? s->pages_cap * 2 : 64;
+        scroll_page_t **grown = realloc(s->pages, cap * sizeof(*grown));
+        if (!grown) return false;
+        s->pages = grown;
+        s->pages_cap = cap;
+    }
+    scroll_page_t *p = calloc(1, sizeof(*p));
+    unsigned char *buf = malloc(raw_len);
+    if (!p || !buf) {
+        free(p);
+        free(buf);
+        return false;
+    }
+
+    /* Column directory, then each column's offsets, flags and records. A
+     * column stays under 4 GB (append checks), the page as a whole may not:
+     * the directory holds 64-bit offsets. */
+    size_t pos = sizeof(guint64) * (size_t)s->num_cols;
+    for (int c = 0; c < s->num_cols; c++) {
+        col_builder_t *b = &s->open[c];
+        guint64 base = (guint64)pos;
+        memcpy(buf + sizeof(guint64) * (size_t)c, &base, sizeof(base));
+        memcpy(buf + pos, b->off, sizeof(b->off));
+        pos += sizeof(b->off);
+        memcpy(buf + pos, b->flags, sizeof(b->flags));
+        pos += sizeof(b->flags);
+        if (b->records->len)
+            memcpy(buf + pos, b->records->data, b->records->len);
+        pos += b->records->len;
+    }
+
+    p->buf = buf;
+    p->len = p->raw_len = raw_len;
+    p->lru.data = p;
+    if (s->compress) compress_page(s, p);
+
+    s->pages[s->num_pages++] = p;
+    g_queue_push_tail_link(&s->resident, &p->lru);
+    s->resident_bytes += p->len;
+    open_reset(s);
+    return true;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+argus_scroll_store_t *argus_scroll_store_new(int num_cols,
+                                             size_t memory_budget,
+                                             bool compress)
+{
+    if (num_cols <= 0) return NULL;
+    argus_scroll_store_t *s = calloc(1, sizeof(*s));
+    if (!s) return NULL;
+    s->num_cols = num_cols;
+    s->memory_budget = memory_budget;
+    s->compress = compress;
+    s->slot_page = SIZE_MAX;
+    g_queue_init(&s->resident);
+
+    s->open = calloc((size_t)num_cols, sizeof(col_builder_t));
+    s->row.cells = calloc((size_t)num_cols, sizeof(argus_cell_t));
+    if (!s->open || !s->row.cells) {
+        free(s->open);
+        free(s->row.cells);
+        free(s);
+        return NULL;
+    }
+    for (int c = 0; c < num_cols; c++)
+        s->open[c].records = g_byte_array_new();
+    return s;
+}
+
+void argus_scroll_store_free(argus_scroll_store_t *s)
+{
+    if (!s) return;
+    for (size_t i = 0; i < s->num_pages; i++) {
+        free(s->pages[i]->buf);
+        free(s->pages[i]);
+    }
+    free(s->pages);
+    for (int c = 0; c < s->num_cols; c++)
+        g_byte_array_unref(s->open[c].records);
+    free(s->open);
+    if (s->io) g_object_unref(s->io);
+    if (s->file) {
+        g_file_delete(s->file, NULL, NULL);
+        g_object_unref(s->file);
+    }
+    if (s->deflater) g_object_unref(s->deflater);
+    if (s->inflater) g_object_unref(s->inflater);
+    free(s->slot);
+    free(s->io_buf);
+    free(s->row.cells);
+    free(s);
+}
+
+int argus_scroll_store_append(argus_scroll_store_t *s, const argus_row_t *row)
+{
+    size_t r = s->open_rows;
+    size_t added = 0;
+
+    for (int c = 0; c < s->num_cols; c++) {
+        col_builder_t *b = &s->open[c];
+        const argus_cell_t *cell = row->cells ? &row->cells[c] : NULL;
+        guint8 flags = 0;
+
+        if (!cell || cell->is_null) {
+            flags = CELL_NULL;
+        } else {
+            flags = (guint8)(cell->native_kind << CELL_KIND_SHIFT);
+            size_t rec = (cell->native_kind ? sizeof(cell->native) : 0) +
+                         (cell->data ? cell->data_len + 1 : 0);
+            if ((size_t)b->records->len + rec > G_MAXUINT32) {
+                /* Roll the partial row back out of the columns before */
+                for (int k = 0; k < c; k++)
+                    g_byte_array_set_size(s->open[k].records,
+                                          s->open[k].off[r]);
+                snprintf(s->error, sizeof(s->error),
+                         "column %d holds more than 4 GB in %d rows",
+                         c + 1, SCROLL_PAGE_ROWS);
+                return -1;
+            }
+            if (cell->native_kind)
+                g_byte_array_append(b->records,
+                                    (const guint8 *)&cell->native,
+                                    sizeof(cell->native));
+            if (cell->data) {
+                flags |= CELL_TEXT;
+                g_byte_array_append(b->records, (const guint8 *)cell->data,
+                                    (guint)cell->data_len);
+                g_byte_array_append(b->records, (const guint8 *)"", 1);
+            }
+            added += rec;
+        }
+        b->flags[r] = flags;
+        b->off[r + 1] = b->records->len;
+    }
+
+    s->open_rows++;
+    s->open_bytes += added;
+    if (s->open_rows == SCROLL_PAGE_ROWS && !seal_page(s)) {
+        for (int c = 0; c < s->num_cols; c++)
+            g_byte_array_set_size(s->open[c].records, s->open[c].off[r]);
+        s->open_rows--;
+        s->open_bytes -= added;
+        snprintf(s->error, sizeof(s->error), "out of memory");
+        return -1;
+    }
+    return enforce_budget(s) ? 0 : -1;
+}
+
+/* The raw bytes of complete page `pi`, reading or inflating it if needed */
+static const unsigned char *page_bytes(argus_scroll_store_t *s, size_t pi)
+{
+    scroll_page_t *p = s->pages[pi];
+
+    if (p->buf) {
+        g_queue_unlink(&s->resident, &p->lru);
+        g_queue_push_tail_link(&s->resident, &p->lru);
+        if (!p->compressed) return p->buf;
+    }
+    if (s->slot_page == pi) return s->slot;
+
+    if (!ensure_buf(&s->slot, &s->slot_cap, p->raw_len)) {
+        snprintf(s->error, sizeof(s->error), "out of memory");
+        return NULL;
+    }
+
+    const unsigned char *stored = p->buf;
+    if (!stored) {
+        unsigned char **dst = p->compressed ? &s->io_buf : &s->slot;
+        size_t *cap = p->compressed ? &s->io_cap : &s->slot_cap;
+        if (!ensure_buf(dst, cap, p->len)) {
+            snprintf(s->error, sizeof(s->error), "out of memory");
+            return NULL;
+        }
+        GError *err = NULL;
+        gsize got = 0;
+        GInputStream *in = g_io_stream_get_input_stream(G_IO_STREAM(s->io));
+        if (!g_seekable_seek(G_SEEKABLE(s->io), p->file_off, G_SEEK_SET,
+                             NULL, &err) ||
+            !g_input_stream_read_all(in, *dst, p->len, &got, NULL, &err) ||
+            got != p->len) {
+            store_error(s, "cannot read the spill file", err);
+            if (err) g_error_free(err);
+            s->slot_page = SIZE_MAX;
+            return NULL;
+        }
+        stored = *dst;
+    }
+
+    if (p->compressed) {
+        if (!s->inflater)
+            s->inflater = G_CONVERTER(g_zlib_decompressor_new(
+                G_ZLIB_COMPRESSOR_FORMAT_RAW));
+        size_t out_len = 0;
+        if (!convert(s->inflater, stored, p->len, s->slot, p->raw_len,
+                     &out_len) || out_len != p->raw_len) {
+            snprintf(s->error, sizeof(s->error), "corrupt page %zu", pi);
+            s->slot_page = SIZE_MAX;
+            return NULL;
+        }
+    }
+    s->slot_page = pi;
+    return s->slot;
+}
+
+static void decode_cell(argus_cell_t *cell, guint8 flags,
+                        const unsigned char *rec, size_t rec_len)
+{
+    memset(cell, 0, sizeof(*cell));
+    if (flags & CELL_NULL) {
+        cell->is_null = true;
+        return;
+    }
+    cell->native_kind = (uint8_t)(flags >> CELL_KIND_SHIFT);
+    if (cell->native_kind) {
+        memcpy(&cell->native, rec, sizeof(cell->native));
+        rec += sizeof(cell->native);
+        rec_len -= sizeof(cell->native);
+    }
+    if (flags & CELL_TEXT) {
+        cell->data = (char *)rec;
+        cell->data_len = rec_len - 1;
+    }
+}
+
+const argus_row_t *argus_scroll_store_get(argus_scroll_store_t *s, size_t idx)
+{
+    if (idx >= argus_scroll_store_rows(s)) return NULL;
+    size_t pi = idx / SCROLL_PAGE_ROWS;
+    size_t r = idx % SCROLL_PAGE_ROWS;
+
+    if (pi == s->num_pages) {
+        for (int c = 0; c < s->num_cols; c++) {
+            col_builder_t *b = &s->open[c];
+            decode_cell(&s->row.cells[c], b->flags[r],
+                        b->records->data + b->off[r],
+                        b->off[r + 1] - b->off[r]);
+        }
+        return &s->row;
+    }
+
+    const unsigned char *page = page_bytes(s, pi);
+    if (!page) return NULL;
+    for (int c = 0; c < s->num_cols; c++) {
+        guint64 base;
+        guint32 start, end;
+        memcpy(&base, page + sizeof(guint64) * (size_t)c, sizeof(base));
+        const unsigned char *sec = page + base;
+        memcpy(&start, sec + sizeof(guint32) * r, sizeof(start));
+        memcpy(&end, sec + sizeof(guint32) * (r + 1), sizeof(end));
+        guint8 flags = sec[sizeof(guint32) * (SCROLL_PAGE_ROWS + 1) + r];
+        decode_cell(&s->row.cells[c], flags, sec + SECTION_HEAD + start,
+                    end - start);
+    }
+    return &s->row;
+}
+
+size_t argus_scroll_store_rows(const argus_scroll_store_t *s)
+{
+    return s ? s->num_pages * SCROLL_PAGE_ROWS + s->open_rows : 0;
+}
+
+uint64_t argus_scroll_store_bytes(const argus_scroll_store_t *s)
+{
+    return s ? s->resident_bytes + s->spilled_bytes + s->open_bytes : 0;
+}
+
+uint64_t argus_scroll_store_spilled(const argus_scroll_store_t *s)
+{
+    return s ? s->spilled_bytes : 0;
+}
+
+const char *argus_scroll_store_error(const argus_scroll_store_t *s)
+{
+    return s && s->error[0] ? s->error : "unknown error";
+}
@@ -0,0 +1,225 @@
+/*
+ * Cache of preprocessed statement text.
+ *
+ * BI tools send the same large generated SQL over and over, often with only
+ * the bound values changing. Preprocessing it — translating the ODBC escape
+ * sequences, then locating the ? markers outside quoted text — walks the
+ * whole statement on every SQLExecDirect, and substituting parameters walked
+ * it again on every SQLExecute. Here the result is kept, keyed by the dialect
+ * and the SQL exactly as the application sent it: a repeated statement costs
+ * one hash lookup, and substitution only copies the segments between the
+ * known marker offsets with the rendered literals spliced in.
+ *
+ * The cache is process-wide and bounded by SQLCACHEMAXBYTES (0 disables it):
+ * least recently used entries are evicted first, and a statement larger than
+ * a quarter of the budget is preprocessed without being kept. Entries are
+ * immutable and refcounted, so a statement holds on to its text while it is
+ * evicted. Hits and misses are counted per connection.
+ */
+#include "argus/handle.h"
+#include "argus/dialect.h"
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+static GMutex      sc_lock;
+static GHashTable *sc_table;           /* set of argus_sql_text_t */
+static GQueue      sc_lru = G_QUEUE_INIT;  /* head = most recently used */
+static size_t      sc_bytes;
+static size_t      sc_max_bytes = ARGUS_DEFAULT_SQL_CACHE_BYTES;
+
+/* ── Entries ─────────────────────────────────────────────────── */
+
+static guint key_hash(const void *dialect, const char *raw)
+{
+    return g_str_hash(raw) ^ (GPOINTER_TO_UINT(dialect) >> 4);
+}
+
+static guint text_hash(gconstpointer p)
+{
+    return ((const argus_sql_text_t *)p)->hash;
+}
+
+static gboolean text_equal(gconstpointer a, gconstpointer b)
+{
+    const argus_sql_text_t *x = a, *y = b;
+    return x->hash == y->hash && x->dialect == y->dialect &&
+           strcmp(x->raw, y->raw) == 0;
+}
+
+void argus_sql_text_unref(argus_sql_text_t *t)
+{
+    if (!t || !g_atomic_int_dec_and_test(&t->refcount)) return;
+    if (t->sql != t->raw) g_free(t->sql);     /* escape.c allocates with GLib */
+    free(t->raw);
+    free(t->markers);
+    free(t);
+}
+
+/* The ? markers outside quoted text, as SQLNumParams counts them: counted
+ * when `out` is NULL, recorded otherwise */
+static int scan_markers(const char *sql, size_t len, size_t *out)
+{
+    bool in_single_quote = false;
+    bool in_double_quote = false;
+    int count = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        if (sql[i] == '\'' && !in_double_quote) {
+            in_single_quote = !in_single_quote;
+        } else if (sql[i] == '"' && !in_single_quote) {
+            in_double_quote = !in_double_quote;
+        } else if (sql[i] == '?' && !in_single_quote && !in_double_quote) {
+            if (out) out[count] = i;
+            count++;
+        }
+    }
+    return count;
+}
+
+/* Preprocess `raw`; NULL with stmt->diag set on a bad escape or no memory */
+static argus_sql_text_t *text_build(argus_stmt_t *stmt, const void *dialect,
+                                    const char *raw, guint hash)
+{
+    argus_sql_text_t *t = calloc(1, sizeof(*t));
+    if (!t) goto nomem;
+    t->refcount = 1;
+    t->dialect = dialect;
+    t->hash = hash;
+    t->raw = strdup(raw);
+    if (!t->raw) goto nomem;
+    t->sql = t->raw;
+
+    if (dialect) {
+        char *translated = NULL;
+        switch (argus_escape_translate((const argus_dialect_t *)dialect,
+                                       raw, &translated, &stmt->diag)) {
+        case ARGUS_ESCAPE_NONE:
+            break;
+        case ARGUS_ESCAPE_OK:
+            t->sql = translated;
+            break;
+        case ARGUS_ESCAPE_ERROR:
+        default:
+            argus_sql_text_unref(t);
+            return NULL;
+        }
+    }
+    t->len = strlen(t->sql);
+    t->num_markers = scan_markers(t->sql, t->len, NULL);
+    if (t->num_markers > 0) {
+        t->markers = malloc((size_t)t->num_markers * sizeof(size_t));
+        if (!t->markers) goto nomem;
+        scan_markers(t->sql, t->len, t->markers);
+    }
+
+    t->bytes = sizeof(*t) + strlen(t->raw) + 1 +
+               (t->sql != t->raw ? t->len + 1 : 0) +
+               (size_t)t->num_markers * sizeof(size_t);
+    return t;
+
+nomem:
+    argus_sql_text_unref(t);
+    argus_set_error(&stmt->diag, "HY001",
+                    "[Argus] Memory allocation failed", 0);
+    return NULL;
+}
+
+/* ── LRU ─────────────────────────────────────────────────────── */
+
+/* Drop an entry from the cache; statements holding it keep it alive.
+ * Caller holds sc_lock. */
+static void entry_remove_locked(argus_sql_text_t *t)
+{
+    g_hash_table_remove(sc_table, t);
+    g_queue_delete_link(&sc_lru, t->lru_link);
+    t->lru_link = NULL;
+    sc_bytes -= t->bytes;
+    argus_sql_text_unref(t);
+}
+
+static void evict_to_locked(size_t limit)
+{
+    while (sc_bytes > limit && sc_lru.tail)
+        entry_remove_locked((argus_sql_text_t *)sc_lru.tail->data);
+}
+
+/* Keep a freshly built entry, unless it is too large or another thread
+ * published the same statement first. Caller holds sc_lock. */
+static void publish_locked(argus_sql_text_t *t)
+{
+    if (sc_max_bytes == 0 || t->bytes > sc_max_bytes / 4) return;
+    if (!sc_table)
+        sc_table = g_hash_table_new(text_hash, text_equal);
+    if (g_hash_table_contains(sc_table, t)) return;
+
+    g_atomic_int_inc(&t->refcount);
+    g_hash_table_add(sc_table, t);
+    g_queue_push_head(&sc_lru, t);
+    t->lru_link = sc_lru.head;
+    sc_bytes += t->bytes;
+    evict_to_locked(sc_max_bytes);
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+argus_sql_text_t *argus_sql_text_get(argus_stmt_t *stmt, const char *raw)
+{
+    argus_dbc_t *dbc = stmt->dbc;
+    /* SQL_NOSCAN_ON: the application vouches for native SQL */
+    const void *dialect = stmt->noscan == SQL_NOSCAN_ON
+                          ? NULL : (const void *)argus_dialect_for(dbc);
+
+    argus_sql_text_t probe;
+    memset(&probe, 0, sizeof(probe));
+    probe.dialect = dialect;
+    probe.raw = (char *)raw;
+    probe.hash = key_hash(dialect, raw);
+
+    g_mutex_lock(&sc_lock);
+    argus_sql_text_t *t = sc_table ? g_hash_table_lookup(sc_table, &probe)
+                                   : NULL;
+    if (t) {
+        g_atomic_int_inc(&t->refcount);
+        g_queue_unlink(&sc_lru, t->lru_link);
+        g_queue_push_head_link(&sc_lru, t->lru_link);
+    }
+    g_mutex_unlock(&sc_lock);
+
+    if (t) {
+        if (dbc) dbc->sql_cache_hits++;
+        return t;
+    }
+    if (dbc) dbc->sql_cache_misses++;
+
+    t = text_build(stmt, dialect, raw, probe.hash);
+    if (!t) return NULL;
+
+    g_mutex_lock(&sc_lock);
+    publish_locked(t);
+    g_mutex_unlock(&sc_lock);
+    return t;
+}
+
+void argus_sql_cache_configure(size_t max_bytes)
+{
+    g_mutex_lock(&sc_lock);
+    sc_max_bytes = max_bytes;
+    evict_to_locked(sc_max_bytes);
+    g_mutex_unlock(&sc_lock);
+}
+
+size_t argus_sql_cache_bytes(void)
+{
+    g_mutex_lock(&sc_lock);
+    size_t n = sc_bytes;
+    g_mutex_unlock(&sc_lock);
+    return n;
+}
+
+void argus_sql_cache_clear(void)
+{
+    g_mutex_lock(&sc_lock);
+    evict_to_locked(0);
+    g_mutex_unlock(&sc_lock);
+}
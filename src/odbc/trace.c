@@ -0,0 +1,367 @@
+/*
+ * Span tracing of driver operations (see argus/trace.h).
+ *
+ * A span is a small heap block the caller owns from argus_trace_root/child
+ * until argus_trace_end, which exports and frees it. Nothing is allocated
+ * for an operation that was not sampled: the NULL span flows through every
+ * call as a no-op.
+ *
+ * The default exporter appends each span to its connection's TRACEFILE as
+ * one OTLP/JSON line. Connections naming the same file share one stream;
+ * lines are written whole under a lock, and the stream is flushed when a
+ * root span ends, so a trace is on disk once its operation has returned.
+ */
+#include "argus/trace.h"
+#include "argus/log.h"
+
+#include <glib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ARGUS_VERSION_MAJOR
+#define ARGUS_VERSION_MAJOR 0
+#define ARGUS_VERSION_MINOR 0
+#define ARGUS_VERSION_PATCH 0
+#endif
+
+/* One output file, shared by the connections that name it */
+typedef struct trace_file {
+    char   *path;
+    FILE   *fp;
+    int     refs;
+} trace_file_t;
+
+struct argus_tracer {
+    double        sample;
+    trace_file_t *file;         /* NULL when only a sink was available */
+};
+
+static GMutex             tr_lock;
+static GHashTable        *tr_files;        /* path -> trace_file_t */
+static argus_trace_sink_t tr_sink;
+static bool               tr_sink_set;
+static GPrivate           tr_current = G_PRIVATE_INIT(NULL);
+
+/* ── Files ───────────────────────────────────────────────────── */
+
+/* Caller holds tr_lock */
+static trace_file_t *file_ref_locked(const char *path)
+{
+    if (!tr_files)
+        tr_files = g_hash_table_new(g_str_hash, g_str_equal);
+    trace_file_t *f = g_hash_table_lookup(tr_files, path);
+    if (f) {
+        f->refs++;
+        return f;
+    }
+
+    FILE *fp = fopen(path, "a");
+    if (!fp) {
+        ARGUS_LOG_WARN("Cannot open trace file %s; tracing disabled", path);
+        return NULL;
+    }
+    f = calloc(1, sizeof(*f));
+    if (!f || !(f->path = strdup(path))) {
+        free(f);
+        fclose(fp);
+        return NULL;
+    }
+    f->fp = fp;
+    f->refs = 1;
+    g_hash_table_insert(tr_files, f->path, f);
+    return f;
+}
+
+/* Caller holds tr_lock */
+static void file_unref_locked(trace_file_t *f)
+{
+    if (!f || --f->refs > 0) return;
+    g_hash_table_remove(tr_files, f->path);
+    fclose(f->fp);
+    free(f->path);
+    free(f);
+}
+
+/* ── OTLP/JSON ───────────────────────────────────────────────── */
+
+static void append_hex(GString *s, const uint8_t *b, size_t n)
+{
+    static const char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < n; i++) {
+        g_string_append_c(s, digits[b[i] >> 4]);
+        g_string_append_c(s, digits[b[i] & 0xf]);
+    }
+}
+
+static void append_json_string(GString *s, const char *val)
+{
+    g_string_append_c(s, '"');
+    for (const char *p = val; *p; p++) {
+        unsigned char c = (unsigned char)*p;
+        switch (c) {
+        case '"':  g_string_append(s, "\\\""); break;
+        case '\\': g_string_append(s, "\\\\"); break;
+        case '\n': g_string_append(s, "\\n");  break;
+        case '\r': g_string_append(s, "\\r");  break;
+        case '\t': g_string_append(s, "\\t");  break;
+        default:
+            if (c < 0x20)
+                g_string_append_printf(s, "\\u%04x", c);
+            else
+                g_string_append_c(s, (char)c);
+        }
+    }
+    g_string_append_c(s, '"');
+}
+
+static bool is_root(const argus_span_t *span)
+{
+    static const uint8_t zero[8];
+    return memcmp(span->parent_id, zero, sizeof(zero)) == 0;
+}
+
+/* One ExportTraceServiceRequest holding `span`, newline-terminated */
+static void span_to_otlp(GString *s, const argus_span_t *span)
+{
+    g_string_append(s, "{\"resourceSpans\":[{\"resource\":{\"attributes\":["
+                       "{\"key\":\"service.name\",\"value\":"
+                       "{\"stringValue\":\"argus-odbc\"}}]},"
+                       "\"scopeSpans\":[{\"scope\":{\"name\":\"argus\","
+                       "\"version\":");
+    g_string_append_printf(s, "\"%d.%d.%d\"},\"spans\":[{\"traceId\":\"",
+                           ARGUS_VERSION_MAJOR, ARGUS_VERSION_MINOR,
+                           ARGUS_VERSION_PATCH);
+    append_hex(s, span->ctx.trace_id, sizeof(span->ctx.trace_id));
+    g_string_append(s, "\",\"spanId\":\"");
+    append_hex(s, span->ctx.span_id, sizeof(span->ctx.span_id));
+    g_string_append_c(s, '"');
+    if (!is_root(span)) {
+        g_string_append(s, ",\"parentSpanId\":\"");
+        append_hex(s, span->parent_id, sizeof(span->parent_id));
+        g_string_append_c(s, '"');
+    }
+    g_string_append(s, ",\"name\":");
+    append_json_string(s, span->name);
+    /* Round trips to the server are CLIENT spans, the rest INTERNAL */
+    g_string_append_printf(
+        s, ",\"kind\":%d,\"startTimeUnixNano\":\"%" G_GINT64_FORMAT "000\","
+           "\"endTimeUnixNano\":\"%" G_GINT64_FORMAT "000\",\"attributes\":[",
+        strncmp(span->name, "backend.", 8) == 0 ? 3 : 1,
+        (gint64)span->start_unix_us, (gint64)span->end_unix_us);
+
+    for (int i = 0; i < span->num_attrs; i++) {
+        const argus_span_attr_t *a = &span->attrs[i];
+        if (i > 0) g_string_append_c(s, ',');
+        g_string_append(s, "{\"key\":");
+        append_json_string(s, a->key);
+        if (a->str) {
+            g_string_append(s, ",\"value\":{\"stringValue\":");
+            append_json_string(s, a->str);
+            g_string_append(s, "}}");
+        } else {
+            g_string_append_printf(s, ",\"value\":{\"intValue\":\"%"
+                                   G_GINT64_FORMAT "\"}}", (gint64)a->num);
+        }
+    }
+    g_string_append(s, "],\"status\":{");
+    if (span->status[0]) {
+        g_string_append(s, "\"code\":2,\"message\":");
+        append_json_string(s, span->status);
+    }
+    g_string_append(s, "}}]}]}]}\n");
+}
+
+static void export_span(const argus_span_t *span)
+{
+    g_mutex_lock(&tr_lock);
+    bool use_sink = tr_sink_set;
+    argus_trace_sink_t sink = tr_sink;
+    g_mutex_unlock(&tr_lock);
+
+    if (use_sink) {
+        sink.export_span(sink.user_data, span);
+        return;
+    }
+    trace_file_t *f = span->tracer->file;
+    if (!f) return;
+
+    GString *line = g_string_sized_new(768);
+    span_to_otlp(line, span);
+    g_mutex_lock(&tr_lock);
+    fwrite(line->str, 1, line->len, f->fp);
+    if (is_root(span))
+        fflush(f->fp);
+    g_mutex_unlock(&tr_lock);
+    g_string_free(line, TRUE);
+}
+
+/* ── Sink and tracers ────────────────────────────────────────── */
+
+void argus_trace_set_sink(const argus_trace_sink_t *sink)
+{
+    g_mutex_lock(&tr_lock);
+    tr_sink_set = sink && sink->export_span;
+    if (tr_sink_set)
+        tr_sink = *sink;
+    else
+        memset(&tr_sink, 0, sizeof(tr_sink));
+    g_mutex_unlock(&tr_lock);
+}
+
+argus_tracer_t *argus_tracer_open(const char *file, double sample)
+{
+    if (sample <= 0.0) return NULL;
+
+    g_mutex_lock(&tr_lock);
+    trace_file_t *f = file && *file ? file_ref_locked(file) : NULL;
+    bool sink = tr_sink_set;
+    g_mutex_unlock(&tr_lock);
+    if (!f && !sink) return NULL;
+
+    argus_tracer_t *t = calloc(1, sizeof(*t));
+    if (!t) {
+        g_mutex_lock(&tr_lock);
+        file_unref_locked(f);
+        g_mutex_unlock(&tr_lock);
+        return NULL;
+    }
+    t->sample = sample > 1.0 ? 1.0 : sample;
+    t->file = f;
+    return t;
+}
+
+void argus_tracer_flush(argus_tracer_t *t)
+{
+    if (!t) return;
+    g_mutex_lock(&tr_lock);
+    bool use_sink = tr_sink_set;
+    argus_trace_sink_t sink = tr_sink;
+    if (!use_sink && t->file)
+        fflush(t->file->fp);
+    g_mutex_unlock(&tr_lock);
+    if (use_sink && sink.flush)
+        sink.flush(sink.user_data);
+}
+
+void argus_tracer_close(argus_tracer_t *t)
+{
+    if (!t) return;
+    argus_tracer_flush(t);
+    g_mutex_lock(&tr_lock);
+    file_unref_locked(t->file);
+    g_mutex_unlock(&tr_lock);
+    free(t);
+}
+
+/* ── Spans ───────────────────────────────────────────────────── */
+
+static void random_id(uint8_t *id, size_t n)
+{
+    for (size_t i = 0; i < n; i += 4) {
+        guint32 r = g_random_int();
+        memcpy(id + i, &r, n - i < 4 ? n - i : 4);
+    }
+    id[n - 1] |= 1;                 /* all-zero ids are invalid */
+}
+
+static argus_span_t *span_new(argus_tracer_t *t, const char *name)
+{
+    argus_span_t *span = calloc(1, sizeof(*span));
+    if (!span) return NULL;
+    span->tracer = t;
+    span->name = name;
+    span->ctx.sampled = true;
+    span->start_unix_us = g_get_real_time();
+    span->mono_start_us = g_get_monotonic_time();
+    random_id(span->ctx.span_id, sizeof(span->ctx.span_id));
+    return span;
+}
+
+argus_span_t *argus_trace_root(argus_tracer_t *t, const char *name)
+{
+    if (!t) return NULL;
+    if (t->sample < 1.0 && g_random_double() >= t->sample) return NULL;
+
+    argus_span_t *span = span_new(t, name);
+    if (span)
+        random_id(span->ctx.trace_id, sizeof(span->ctx.trace_id));
+    return span;
+}
+
+argus_span_t *argus_trace_child(argus_tracer_t *t,
+                                const argus_trace_ctx_t *parent,
+                                const char *name)
+{
+    if (!t || !parent || !parent->sampled) return NULL;
+
+    argus_span_t *span = span_new(t, name);
+    if (span) {
+        memcpy(span->ctx.trace_id, parent->trace_id,
+               sizeof(span->ctx.trace_id));
+        memcpy(span->parent_id, parent->span_id, sizeof(span->parent_id));
+    }
+    return span;
+}
+
+void argus_trace_attr_str(argus_span_t *span, const char *key,
+                          const char *value)
+{
+    if (!span || !value || span->num_attrs >= ARGUS_TRACE_MAX_ATTRS) return;
+    argus_span_attr_t *a = &span->attrs[span->num_attrs++];
+    a->key = key;
+    a->str = g_strdup(value);
+}
+
+void argus_trace_attr_int(argus_span_t *span, const char *key, int64_t value)
+{
+    if (!span || span->num_attrs >= ARGUS_TRACE_MAX_ATTRS) return;
+    argus_span_attr_t *a = &span->attrs[span->num_attrs++];
+    a->key = key;
+    a->num = value;
+}
+
+void argus_trace_end(argus_span_t *span, const char *sqlstate)
+{
+    if (!span) return;
+    span->end_unix_us = span->start_unix_us +
+                        (g_get_monotonic_time() - span->mono_start_us);
+    if (sqlstate && *sqlstate)
+        g_strlcpy(span->status, sqlstate, sizeof(span->status));
+
+    export_span(span);
+
+    for (int i = 0; i < span->num_attrs; i++)
+        g_free(span->attrs[i].str);
+    free(span);
+}
+
+/* ── Thread binding and propagation ──────────────────────────── */
+
+argus_span_t *argus_trace_enter(argus_span_t *span)
+{
+    argus_span_t *prev = g_private_get(&tr_current);
+    g_private_set(&tr_current, span);
+    return prev;
+}
+
+void argus_trace_leave(argus_span_t *prev)
+{
+    g_private_set(&tr_current, prev);
+}
+
+bool argus_trace_traceparent(char out[ARGUS_TRACEPARENT_LEN])
+{
+    const argus_span_t *span = g_private_get(&tr_current);
+    if (!span) return false;
+
+    GString *s = g_string_sized_new(ARGUS_TRACEPARENT_LEN);
+    g_string_append(s, "00-");
+    append_hex(s, span->ctx.trace_id, sizeof(span->ctx.trace_id));
+    g_string_append_c(s, '-');
+    append_hex(s, span->ctx.span_id, sizeof(span->ctx.span_id));
+    g_string_append(s, "-01");
+    g_strlcpy(out, s->str, ARGUS_TRACEPARENT_LEN);
+    g_string_free(s, TRUE);
+    return true;
+}
@@ -695,7 +695,8 @@ ARGUS_EXPORT SQLRETURN SQL_API SQLSetConnectAttrW(
     SQLINTEGER StringLength)
 {
     /* String attributes need conversion */
-    if (Attribute == SQL_ATTR_CURRENT_CATALOG && Value &&
+    if ((Attribute == SQL_ATTR_CURRENT_CATALOG ||
+         Attribute == ARGUS_ATTR_METRICS_DUMP) && Value &&
         (StringLength > 0 || StringLength == SQL_NTS)) {
         SQLSMALLINT wlen;
         if (StringLength == SQL_NTS)
@@ -721,13 +722,18 @@ ARGUS_EXPORT SQLRETURN SQL_API SQLGetConnectAttrW(
     SQLINTEGER BufferLength,
     SQLINTEGER *StringLength)
 {
-    if (Attribute == SQL_ATTR_CURRENT_CATALOG) {
-        SQLCHAR ansi_buf[512];
+    if (Attribute == SQL_ATTR_CURRENT_CATALOG ||
+        Attribute == ARGUS_ATTR_METRICS_JSON) {
+        /* The metrics document outgrows a catalog name by far */
+        SQLINTEGER ansi_cap = Attribute == SQL_ATTR_CURRENT_CATALOG
+                              ? 512 : 32767;
+        SQLCHAR *ansi_buf = g_malloc(ansi_cap);
         SQLINTEGER ansi_len = 0;
 
         SQLRETURN ret = SQLGetConnectAttr(
             ConnectionHandle, Attribute,
-            ansi_buf, sizeof(ansi_buf), &ansi_len);
+            ansi_buf, ansi_cap, &ansi_len);
+        if (ansi_len >= ansi_cap) ansi_len = ansi_cap - 1;
 
         if ((ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO) &&
             Value && BufferLength > 0) {
@@ -739,6 +745,7 @@ ARGUS_EXPORT SQLRETURN SQL_API SQLGetConnectAttrW(
         } else if (StringLength) {
             *StringLength = (SQLINTEGER)(ansi_len * (SQLINTEGER)sizeof(SQLWCHAR));
         }
+        g_free(ansi_buf);
         return ret;
     }
     return SQLGetConnectAttr(ConnectionHandle, Attribute,
@@ -982,7 +989,21 @@ ARGUS_EXPORT SQLRETURN SQL_API SQLSetStmtAttrW(
     SQLPOINTER Value,
     SQLINTEGER StringLength)
 {
-    /* Statement attributes are all numeric — pass through */
+    /* The extract path is the one string attribute */
+    if (Attribute == ARGUS_ATTR_EXTRACT_PATH && Value &&
+        (StringLength > 0 || StringLength == SQL_NTS)) {
+        SQLSMALLINT wlen;
+        if (StringLength == SQL_NTS)
+            wlen = SQL_NTS;
+        else
+            wlen = (SQLSMALLINT)(StringLength / (SQLINTEGER)sizeof(SQLWCHAR));
+        char *utf8 = wchar_to_utf8((SQLWCHAR *)Value, wlen);
+        SQLRETURN ret = SQLSetStmtAttr(
+            StatementHandle, Attribute,
+            (SQLPOINTER)utf8, utf8 ? SQL_NTS : 0);
+        g_free(utf8);
+        return ret;
+    }
     return SQLSetStmtAttr(StatementHandle, Attribute, Value, StringLength);
 }
 
@@ -995,7 +1016,26 @@ ARGUS_EXPORT SQLRETURN SQL_API SQLGetStmtAttrW(
     SQLINTEGER BufferLength,
     SQLINTEGER *StringLength)
 {
-    /* Statement attributes are all numeric — pass through */
+    if (Attribute == ARGUS_ATTR_EXTRACT_PATH) {
+        SQLCHAR ansi_buf[4096];
+        SQLINTEGER ansi_len = 0;
+        SQLRETURN ret = SQLGetStmtAttr(StatementHandle, Attribute,
+                                       ansi_buf, sizeof(ansi_buf), &ansi_len);
+        if (ansi_len >= (SQLINTEGER)sizeof(ansi_buf))
+            ansi_len = (SQLINTEGER)sizeof(ansi_buf) - 1;
+
+        if ((ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO) &&
+            Value && BufferLength > 0) {
+            SQLSMALLINT wlen = utf8_to_wchar(
+                ansi_buf, (SQLSMALLINT)ansi_len,
+                (SQLWCHAR *)Value, (SQLSMALLINT)BufferLength);
+            if (StringLength)
+                *StringLength = (SQLINTEGER)(wlen * (SQLINTEGER)sizeof(SQLWCHAR));
+        } else if (StringLength) {
+            *StringLength = (SQLINTEGER)(ansi_len * (SQLINTEGER)sizeof(SQLWCHAR));
+        }
+        return ret;
+    }
     return SQLGetStmtAttr(StatementHandle, Attribute, Value,
                           BufferLength, StringLength);
 }
@@ -234,3 +234,30 @@ char *argus_str_dup_short(const SQLCHAR *str, SQLSMALLINT len)
     dup[actual_len] = '\0';
     return dup;
 }
+
+/* ── SQL text helpers ─────────────────────────────────────────── */
+
+const char *argus_sql_skip_leading(const char *p)
+{
+    for (;;) {
+        while (*p && (isspace((unsigned char)*p) || *p == '(')) p++;
+        if (p[0] == '-' && p[1] == '-') {
+            while (*p && *p != '\n') p++;
+        } else if (p[0] == '/' && p[1] == '*') {
+            const char *end = strstr(p + 2, "*/");
+            p = end ? end + 2 : p + strlen(p);
+        } else {
+            return p;
+        }
+    }
+}
+
+bool argus_sql_keyword_at(const char *p, const char *kw)
+{
+    size_t n = strlen(kw);
+    for (size_t i = 0; i < n; i++) {
+        if (toupper((unsigned char)p[i]) != toupper((unsigned char)kw[i]))
+            return false;
+    }
+    return !isalnum((unsigned char)p[n]) && p[n] != '_';
+}
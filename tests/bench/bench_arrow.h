@@ -0,0 +1,31 @@
+/*
+ * Arrow side of argus_bench_kernels (bench_kernels_arrow.cpp).
+ *
+ * The harness is C; flightsql_append_batch takes a C++ RecordBatch, so the
+ * batch is built and driven from this small C-callable shim.
+ */
+#ifndef ARGUS_BENCH_ARROW_H
+#define ARGUS_BENCH_ARROW_H
+
+#include "argus/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Build a RecordBatch holding the rows of a text cache with the fixture's
+ * schema (bigint, integer, double, decimal(12,2), date, 3 x varchar,
+ * boolean). Returns an opaque handle, or NULL when the cache does not have
+ * that shape. *bytes receives the batch's buffer footprint. */
+void *bench_arrow_prepare(const argus_row_cache_t *text, size_t *bytes);
+
+/* Append the batch to cache (flightsql_append_batch). 0 on success. */
+int bench_arrow_run(void *batch, argus_row_cache_t *cache);
+
+void bench_arrow_release(void *batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARGUS_BENCH_ARROW_H */
@@ -0,0 +1,701 @@
+/*
+ * Argus decode / conversion kernel benchmark.
+ *
+ * Runs recorded payloads (tests/bench/fixtures) through the driver's hot
+ * kernels directly, with no server: Trino JSON pages (the DOM-free scanner
+ * and the json-glib path), Thrift TFetchResultsResp payloads (protocol read
+ * and TColumn decode), Arrow batches (Flight SQL append) and row caches
+ * through the cell converter for every C target type.
+ *
+ * For each kernel it reports the median ns/cell over N iterations, allocator
+ * calls per cell and bytes per row: the row cache footprint for decode
+ * kernels, the bytes written to the application buffer for conversions.
+ * --json prints the same numbers as one document that compare_kernels.py
+ * diffs against a baseline.
+ *
+ * Usage:
+ *   argus_bench_kernels [--json] [--iterations N] [--fixtures DIR]
+ *                       [--filter SUBSTRING]
+ */
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <glib.h>
+
+#include "argus/handle.h"
+
+#ifdef ARGUS_HAS_TRINO
+#include <json-glib/json-glib.h>
+#include "trino_internal.h"
+#endif
+#ifdef ARGUS_HAS_THRIFT_BACKENDS
+#include <thrift/c_glib/transport/thrift_memory_buffer.h>
+#include "hive_internal.h"
+#endif
+#ifdef ARGUS_HAS_FLIGHTSQL
+#include "bench_arrow.h"
+#endif
+
+#ifndef ARGUS_BENCH_FIXTURES
+#define ARGUS_BENCH_FIXTURES "fixtures"
+#endif
+
+#define FIXTURE_COLS  9
+#define MAX_KERNELS   64
+
+#if defined(ARGUS_HAS_TRINO) || defined(ARGUS_HAS_THRIFT_BACKENDS) || \
+    defined(ARGUS_HAS_FLIGHTSQL)
+#define BENCH_HAS_DECODERS 1
+#endif
+
+/* ── Allocation counting ─────────────────────────────────────── */
+
+/*
+ * glibc exports its allocator under __libc_* names, so the executable can
+ * interpose malloc/calloc/realloc and count calls while still allocating from
+ * the real heap. Sanitizers bring their own allocator; there (and off glibc)
+ * allocations are reported as -1.
+ */
+#if defined(__SANITIZE_ADDRESS__)
+#define BENCH_NO_ALLOC_COUNT 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+#define BENCH_NO_ALLOC_COUNT 1
+#endif
+#endif
+
+#if defined(__GLIBC__) && !defined(BENCH_NO_ALLOC_COUNT)
+#define BENCH_COUNT_ALLOCS 1
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static unsigned long g_allocs;
+
+void *malloc(size_t size)
+{
+    __atomic_fetch_add(&g_allocs, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size)
+{
+    __atomic_fetch_add(&g_allocs, 1, __ATOMIC_RELAXED);
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    __atomic_fetch_add(&g_allocs, 1, __ATOMIC_RELAXED);
+    return __libc_realloc(ptr, size);
+}
+
+static unsigned long alloc_count(void)
+{
+    return __atomic_load_n(&g_allocs, __ATOMIC_RELAXED);
+}
+#else
+static unsigned long alloc_count(void)
+{
+    return 0;
+}
+#endif
+
+/* ── Kernels ─────────────────────────────────────────────────── */
+
+/*
+ * A kernel is one timed call (run) plus an untimed step that returns its
+ * state to where the next run starts (reset). rows/cells/bytes describe a
+ * single run and are filled in by the kernel's setup.
+ */
+typedef struct kernel {
+    char    name[48];
+    int   (*run)(struct kernel *k);
+    void  (*reset)(struct kernel *k);
+    void   *ctx;
+    int     target_type;        /* conversions: SQL_C_* */
+    int     column;             /* conversions: source column, -1 = all */
+    argus_row_cache_t  *src;    /* conversions: cells to convert */
+    argus_row_cache_t   out;    /* decoders: destination cache */
+    size_t  rows;
+    size_t  cells;
+    size_t  bytes;              /* per run; reported per row */
+} kernel_t;
+
+static kernel_t g_kernels[MAX_KERNELS];
+static int      g_nkernels;
+
+static kernel_t *add_kernel(const char *name,
+                            int (*run)(kernel_t *), void (*reset)(kernel_t *))
+{
+    if (g_nkernels >= MAX_KERNELS) return NULL;
+    kernel_t *k = &g_kernels[g_nkernels++];
+    memset(k, 0, sizeof(*k));
+    snprintf(k->name, sizeof(k->name), "%s", name);
+    k->run = run;
+    k->reset = reset;
+    k->column = -1;
+    argus_row_cache_init(&k->out);
+    return k;
+}
+
+#ifdef BENCH_HAS_DECODERS
+static void free_cache(kernel_t *k)
+{
+    argus_row_cache_free(&k->out);
+}
+
+static void clear_cache(kernel_t *k)
+{
+    argus_row_cache_clear(&k->out);
+}
+
+/* Resident size of a decoded cache: row array, cell arrays and text. */
+static size_t cache_bytes(const argus_row_cache_t *cache)
+{
+    size_t total = cache->num_rows * sizeof(argus_row_t);
+    for (size_t r = 0; r < cache->num_rows; r++) {
+        const argus_row_t *row = &cache->rows[r];
+        if (!row->cells) continue;
+        total += (size_t)cache->num_cols * sizeof(argus_cell_t);
+        for (int c = 0; c < cache->num_cols; c++)
+            if (row->cells[c].data)
+                total += row->cells[c].data_len + 1;
+    }
+    return total;
+}
+
+/* Fill in rows/cells/bytes from one run of a decoder. */
+static int measure_decoder(kernel_t *k)
+{
+    if (k->run(k) != 0) return -1;
+    k->rows = k->out.num_rows;
+    k->cells = k->out.num_rows * (size_t)k->out.num_cols;
+    k->bytes = cache_bytes(&k->out);
+    k->reset(k);
+    return k->rows > 0 ? 0 : -1;
+}
+#endif
+
+/* ── Trino JSON pages ────────────────────────────────────────── */
+
+#ifdef ARGUS_HAS_TRINO
+typedef struct trino_page {
+    gchar      *text;
+    gsize       len;
+    const char *ds, *de;        /* the `data` member */
+} trino_page_t;
+
+static int run_trino_scan(kernel_t *k)
+{
+    trino_page_t *page = k->ctx;
+    return sj_scan_data(page->ds, page->de, &k->out, FIXTURE_COLS);
+}
+
+static int run_trino_dom(kernel_t *k)
+{
+    trino_page_t *page = k->ctx;
+    JsonParser *parser = json_parser_new();
+    int rc = -1;
+    if (json_parser_load_from_data(parser, page->text, (gssize)page->len,
+                                   NULL)) {
+        JsonObject *root = json_node_get_object(json_parser_get_root(parser));
+        JsonNode *data = root ? json_object_get_member(root, "data") : NULL;
+        rc = trino_parse_data(data, &k->out, FIXTURE_COLS);
+    }
+    g_object_unref(parser);
+    return rc;
+}
+
+static int setup_trino(const char *dir, argus_row_cache_t *decoded)
+{
+    static trino_page_t page;
+    gchar *path = g_build_filename(dir, "trino_page.json", NULL);
+    gboolean ok = g_file_get_contents(path, &page.text, &page.len, NULL);
+    g_free(path);
+    if (!ok || sj_find_member(page.text, page.len, "data",
+                              &page.ds, &page.de) != 0) {
+        fprintf(stderr, "trino_page.json: missing or malformed\n");
+        return -1;
+    }
+
+    kernel_t *k = add_kernel("trino_scan", run_trino_scan, free_cache);
+    k->ctx = &page;
+    if (measure_decoder(k) != 0) return -1;
+
+    k = add_kernel("trino_dom", run_trino_dom, free_cache);
+    k->ctx = &page;
+    if (measure_decoder(k) != 0) return -1;
+
+    return decoded ? sj_scan_data(page.ds, page.de, decoded, FIXTURE_COLS) : 0;
+}
+#endif
+
+/* ── Thrift TFetchResultsResp ────────────────────────────────── */
+
+#ifdef ARGUS_HAS_THRIFT_BACKENDS
+typedef struct thrift_payload {
+    gchar              *data;
+    gsize               len;
+    ThriftTransport    *transport;
+    ThriftProtocol     *protocol;
+    TFetchResultsResp  *resp;
+} thrift_payload_t;
+
+/* A fresh memory transport holding the payload, ready to be read. */
+static int thrift_load(thrift_payload_t *p)
+{
+    if (p->protocol) g_object_unref(p->protocol);
+    if (p->transport) g_object_unref(p->transport);
+    p->transport = g_object_new(THRIFT_TYPE_MEMORY_BUFFER,
+                                "buf_size", (guint32)p->len, NULL);
+    p->protocol = g_object_new(THRIFT_TYPE_BINARY_PROTOCOL,
+                               "transport", p->transport, NULL);
+    return thrift_transport_write(p->transport, p->data, (guint32)p->len,
+                                  NULL) ? 0 : -1;
+}
+
+static int run_thrift_read(kernel_t *k)
+{
+    thrift_payload_t *p = k->ctx;
+    p->resp = g_object_new(TYPE_T_FETCH_RESULTS_RESP, NULL);
+    return thrift_struct_read(THRIFT_STRUCT(p->resp), p->protocol, NULL) > 0
+           ? 0 : -1;
+}
+
+static void reset_thrift_read(kernel_t *k)
+{
+    thrift_payload_t *p = k->ctx;
+    g_clear_object(&p->resp);
+    thrift_load(p);
+}
+
+static int run_hive_columns(kernel_t *k)
+{
+    TFetchResultsResp *resp = k->ctx;
+    return hive_parse_row_set(resp->results, &k->out);
+}
+
+static int setup_thrift(const char *dir, argus_row_cache_t *decoded)
+{
+    static thrift_payload_t payload;
+    gchar *path = g_build_filename(dir, "hive_fetch_results.bin", NULL);
+    gboolean ok = g_file_get_contents(path, &payload.data, &payload.len, NULL);
+    g_free(path);
+    if (!ok || thrift_load(&payload) != 0) {
+        fprintf(stderr, "hive_fetch_results.bin: missing or unreadable\n");
+        return -1;
+    }
+
+    kernel_t *k = add_kernel("thrift_read", run_thrift_read,
+                             reset_thrift_read);
+    k->ctx = &payload;
+    if (k->run(k) != 0 || !payload.resp->results) {
+        fprintf(stderr, "hive_fetch_results.bin: not a TFetchResultsResp\n");
+        return -1;
+    }
+
+    /* Keep the first decoded response for the column decode */
+    TFetchResultsResp *resp = payload.resp;
+    payload.resp = NULL;
+    thrift_load(&payload);
+
+    kernel_t *cols = add_kernel("hive_columns", run_hive_columns, clear_cache);
+    cols->ctx = resp;
+    if (measure_decoder(cols) != 0) return -1;
+
+    k->rows = cols->rows;
+    k->cells = cols->cells;
+    k->bytes = payload.len;
+
+    return decoded ? hive_parse_row_set(resp->results, decoded) : 0;
+}
+#endif
+
+/* ── Arrow record batches ────────────────────────────────────── */
+
+#ifdef ARGUS_HAS_FLIGHTSQL
+static int run_arrow(kernel_t *k)
+{
+    return bench_arrow_run(k->ctx, &k->out);
+}
+
+static int setup_arrow(const argus_row_cache_t *text)
+{
+    size_t bytes = 0;
+    void *batch = bench_arrow_prepare(text, &bytes);
+    if (!batch) {
+        fprintf(stderr, "arrow: cannot build a batch from the fixture\n");
+        return -1;
+    }
+    kernel_t *k = add_kernel("arrow_append", run_arrow, clear_cache);
+    k->ctx = batch;
+    return measure_decoder(k);
+}
+#endif
+
+/* ── Cell conversion ─────────────────────────────────────────── */
+
+static argus_diag_t g_diag;
+
+static int run_convert(kernel_t *k)
+{
+    /* Large enough for every target: char/wchar text, structs */
+    static SQLWCHAR buf[512];
+    const argus_row_cache_t *src = k->src;
+    int first = k->column < 0 ? 0 : k->column;
+    int last = k->column < 0 ? src->num_cols - 1 : k->column;
+    size_t written = 0;
+
+    for (size_t r = 0; r < src->num_rows; r++) {
+        const argus_cell_t *cells = src->rows[r].cells;
+        for (int c = first; c <= last; c++) {
+            SQLLEN ind = 0;
+            SQLRETURN rc = argus_convert_cell(&cells[c],
+                                              (SQLSMALLINT)k->target_type,
+                                              buf, (SQLLEN)sizeof(buf), &ind,
+                                              &g_diag);
+            if (!SQL_SUCCEEDED(rc)) {
+                argus_diag_clear(&g_diag);
+                continue;
+            }
+            if (ind > 0) written += (size_t)ind;
+        }
+    }
+    k->bytes = written;
+    return 0;
+}
+
+static void reset_convert(kernel_t *k)
+{
+    (void)k;
+    argus_diag_clear(&g_diag);
+}
+
+/* Give every native-only cell its text form and drop the native value, so
+ * the cache looks like what a text protocol hands the converter. */
+static void strip_native(argus_row_cache_t *cache)
+{
+    for (size_t r = 0; r < cache->num_rows; r++) {
+        for (int c = 0; c < cache->num_cols; c++) {
+            argus_cell_t *cell = &cache->rows[r].cells[c];
+            if (cell->native_kind == ARGUS_NATIVE_NONE) continue;
+            if (!cell->data && !cell->is_null) {
+                cell->data = cell->native_kind == ARGUS_NATIVE_I64
+                    ? g_strdup_printf("%lld", (long long)cell->native.i64)
+                    : g_strdup_printf("%.17g", cell->native.f64);
+                cell->data_len = strlen(cell->data);
+            }
+            cell->native_kind = ARGUS_NATIVE_NONE;
+        }
+    }
+}
+
+/* Text forms for the types the fixture does not carry */
+enum {
+    SYN_TIME, SYN_TIMESTAMP, SYN_GUID, SYN_INTERVAL
+};
+
+static const struct {
+    SQLSMALLINT type;
+    const char *name;
+    const char *fmt;            /* printf of (a, b, c, d) */
+} k_intervals[] = {
+    { SQL_C_INTERVAL_YEAR,             "INTERVAL_YEAR",   "%u" },
+    { SQL_C_INTERVAL_MONTH,            "INTERVAL_MONTH",  "%u" },
+    { SQL_C_INTERVAL_DAY,              "INTERVAL_DAY",    "%u" },
+    { SQL_C_INTERVAL_HOUR,             "INTERVAL_HOUR",   "%u" },
+    { SQL_C_INTERVAL_MINUTE,           "INTERVAL_MINUTE", "%u" },
+    { SQL_C_INTERVAL_SECOND,           "INTERVAL_SECOND", "%u.%06u" },
+    { SQL_C_INTERVAL_YEAR_TO_MONTH,    "INTERVAL_YEAR_TO_MONTH", "%u-%u" },
+    { SQL_C_INTERVAL_DAY_TO_HOUR,      "INTERVAL_DAY_TO_HOUR", "%u %02u" },
+    { SQL_C_INTERVAL_DAY_TO_MINUTE,    "INTERVAL_DAY_TO_MINUTE",
+      "%u %02u:%02u" },
+    { SQL_C_INTERVAL_DAY_TO_SECOND,    "INTERVAL_DAY_TO_SECOND",
+      "%u %02u:%02u:%02u.%06u" },
+    { SQL_C_INTERVAL_HOUR_TO_MINUTE,   "INTERVAL_HOUR_TO_MINUTE", "%u:%02u" },
+    { SQL_C_INTERVAL_HOUR_TO_SECOND,   "INTERVAL_HOUR_TO_SECOND",
+      "%u:%02u:%02u.%06u" },
+    { SQL_C_INTERVAL_MINUTE_TO_SECOND, "INTERVAL_MINUTE_TO_SECOND",
+      "%u:%02u.%06u" },
+};
+#define N_INTERVALS (sizeof(k_intervals) / sizeof(k_intervals[0]))
+
+static void set_text(argus_cell_t *cell, gchar *text)
+{
+    cell->data = text;
+    cell->data_len = strlen(text);
+}
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#endif
+static int build_synthetic(argus_row_cache_t *cache, size_t nrows)
+{
+    int ncols = SYN_INTERVAL + (int)N_INTERVALS;
+    cache->rows = calloc(nrows, sizeof(argus_row_t));
+    if (!cache->rows) return -1;
+    cache->capacity = nrows;
+    cache->num_cols = ncols;
+    for (size_t r = 0; r < nrows; r++) {
+        argus_cell_t *cells = calloc((size_t)ncols, sizeof(argus_cell_t));
+        if (!cells) return -1;
+        cache->rows[r].cells = cells;
+        cache->num_rows = r + 1;
+
+        unsigned s = (unsigned)(r * 7919u % 86400u);
+        unsigned h = s / 3600, m = s / 60 % 60, sec = s % 60;
+        unsigned frac = (unsigned)(r * 104729u % 1000000u);
+        set_text(&cells[SYN_TIME],
+                 g_strdup_printf("%02u:%02u:%02u", h, m, sec));
+        set_text(&cells[SYN_TIMESTAMP],
+                 g_strdup_printf("2026-03-%02u %02u:%02u:%02u.%06u",
+                                 1 + (unsigned)(r % 28), h, m, sec, frac));
+        set_text(&cells[SYN_GUID],
+                 g_strdup_printf("%08x-%04x-4%03x-8%03x-%012llx",
+                                 (unsigned)(r * 2654435761u),
+                                 (unsigned)(r & 0xffff),
+                                 (unsigned)(r & 0xfff),
+                                 (unsigned)((r >> 12) & 0xfff),
+                                 (unsigned long long)r * 0x9e3779b97f4aULL
+                                     & 0xffffffffffffULL));
+        for (size_t i = 0; i < N_INTERVALS; i++) {
+            unsigned a = (unsigned)(r % 400), b = h, c = m;
+            if (k_intervals[i].type == SQL_C_INTERVAL_YEAR_TO_MONTH)
+                b = (unsigned)(r % 12);
+            set_text(&cells[SYN_INTERVAL + (int)i],
+                     g_strdup_printf(k_intervals[i].fmt, a, b, c, sec, frac));
+        }
+    }
+    return 0;
+}
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+static void add_convert(const char *name, SQLSMALLINT type,
+                        argus_row_cache_t *src, int column)
+{
+    char full[48];
+    snprintf(full, sizeof(full), "convert_%s", name);
+    kernel_t *k = add_kernel(full, run_convert, reset_convert);
+    if (!k) return;
+    k->target_type = type;
+    k->src = src;
+    k->column = column;
+    k->rows = src->num_rows;
+    k->cells = src->num_rows * (size_t)(column < 0 ? src->num_cols : 1);
+    run_convert(k);
+    reset_convert(k);
+}
+
+/*
+ * Conversions read the fixture's text cells (the column whose type suits the
+ * target), native cells for the numeric fast path, and synthetic columns for
+ * the types the fixture lacks.
+ */
+static void setup_convert(argus_row_cache_t *text, argus_row_cache_t *native,
+                          argus_row_cache_t *synthetic)
+{
+    enum { ORDERKEY, LINENUMBER, QUANTITY, PRICE, SHIPDATE,
+           RETURNFLAG, SHIPMODE, COMMENT, IS_LATE };
+
+    if (text->num_rows > 0) {
+        add_convert("CHAR", SQL_C_CHAR, text, -1);
+        add_convert("WCHAR", SQL_C_WCHAR, text, -1);
+        add_convert("BINARY", SQL_C_BINARY, text, -1);
+        add_convert("SLONG", SQL_C_SLONG, text, LINENUMBER);
+        add_convert("SSHORT", SQL_C_SSHORT, text, LINENUMBER);
+        add_convert("STINYINT", SQL_C_STINYINT, text, LINENUMBER);
+        add_convert("SBIGINT", SQL_C_SBIGINT, text, ORDERKEY);
+        add_convert("ULONG", SQL_C_ULONG, text, LINENUMBER);
+        add_convert("USHORT", SQL_C_USHORT, text, LINENUMBER);
+        add_convert("UTINYINT", SQL_C_UTINYINT, text, LINENUMBER);
+        add_convert("UBIGINT", SQL_C_UBIGINT, text, ORDERKEY);
+        add_convert("FLOAT", SQL_C_FLOAT, text, QUANTITY);
+        add_convert("DOUBLE", SQL_C_DOUBLE, text, QUANTITY);
+        add_convert("BIT", SQL_C_BIT, text, IS_LATE);
+        add_convert("NUMERIC", SQL_C_NUMERIC, text, PRICE);
+        add_convert("TYPE_DATE", SQL_C_TYPE_DATE, text, SHIPDATE);
+    }
+    if (native->num_rows > 0) {
+        add_convert("SLONG_native", SQL_C_SLONG, native, LINENUMBER);
+        add_convert("SBIGINT_native", SQL_C_SBIGINT, native, ORDERKEY);
+        add_convert("DOUBLE_native", SQL_C_DOUBLE, native, QUANTITY);
+        add_convert("CHAR_native", SQL_C_CHAR, native, ORDERKEY);
+    }
+    add_convert("TYPE_TIME", SQL_C_TYPE_TIME, synthetic, SYN_TIME);
+    add_convert("TYPE_TIMESTAMP", SQL_C_TYPE_TIMESTAMP, synthetic,
+                SYN_TIMESTAMP);
+    add_convert("GUID", SQL_C_GUID, synthetic, SYN_GUID);
+    for (size_t i = 0; i < N_INTERVALS; i++)
+        add_convert(k_intervals[i].name, k_intervals[i].type, synthetic,
+                    SYN_INTERVAL + (int)i);
+}
+
+/* ── Measurement ─────────────────────────────────────────────── */
+
+typedef struct result {
+    double ns_per_cell;
+    double allocs_per_cell;     /* -1 when not counted */
+    double bytes_per_row;
+} result_t;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static int measure(kernel_t *k, int iterations, result_t *out)
+{
+    double *times = calloc((size_t)iterations, sizeof(double));
+    if (!times) return -1;
+    unsigned long allocs = (unsigned long)-1;
+
+    /* Warm-up (not timed): caches, lazy type registration */
+    if (k->run(k) != 0) { free(times); return -1; }
+    k->reset(k);
+
+    for (int i = 0; i < iterations; i++) {
+        unsigned long a0 = alloc_count();
+        double t0 = now_ns();
+        int rc = k->run(k);
+        double t1 = now_ns();
+        unsigned long a1 = alloc_count();
+        k->reset(k);
+        if (rc != 0) { free(times); return -1; }
+        times[i] = t1 - t0;
+        if (a1 - a0 < allocs) allocs = a1 - a0;
+    }
+    qsort(times, (size_t)iterations, sizeof(double), cmp_double);
+    double median = (iterations % 2)
+        ? times[iterations / 2]
+        : (times[iterations / 2 - 1] + times[iterations / 2]) / 2.0;
+    free(times);
+
+    double cells = k->cells ? (double)k->cells : 1.0;
+    out->ns_per_cell = median / cells;
+#ifdef BENCH_COUNT_ALLOCS
+    out->allocs_per_cell = (double)allocs / cells;
+#else
+    (void)allocs;
+    out->allocs_per_cell = -1.0;
+#endif
+    out->bytes_per_row = k->rows ? (double)k->bytes / (double)k->rows : 0.0;
+    return 0;
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [--json] [--iterations N] [--fixtures DIR] "
+            "[--filter SUBSTRING]\n", argv0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *fixtures = ARGUS_BENCH_FIXTURES;
+    const char *filter = NULL;
+    int iterations = 15;
+    int json = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = 1;
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--fixtures") == 0 && i + 1 < argc) {
+            fixtures = argv[++i];
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (iterations < 1) iterations = 1;
+    (void)fixtures;     /* unused when no decoder backend is built */
+
+    /* Decoders; each also hands back its cache for the conversions */
+    argus_row_cache_t text, native, synthetic;
+    argus_row_cache_init(&text);
+    argus_row_cache_init(&native);
+    argus_row_cache_init(&synthetic);
+
+#ifdef ARGUS_HAS_TRINO
+    if (setup_trino(fixtures, &native) != 0) return 1;
+#endif
+#ifdef ARGUS_HAS_THRIFT_BACKENDS
+    if (setup_thrift(fixtures, &text) != 0) return 1;
+#endif
+    /* Without the Thrift backend, the text cells come from the JSON page */
+    if (text.num_rows == 0 && native.num_rows > 0) {
+#ifdef ARGUS_HAS_TRINO
+        gchar *path = g_build_filename(fixtures, "trino_page.json", NULL);
+        gchar *page = NULL;
+        gsize len = 0;
+        const char *ds, *de;
+        if (g_file_get_contents(path, &page, &len, NULL) &&
+            sj_find_member(page, len, "data", &ds, &de) == 0)
+            sj_scan_data(ds, de, &text, FIXTURE_COLS);
+        g_free(page);
+        g_free(path);
+#endif
+        strip_native(&text);
+    }
+#ifdef ARGUS_HAS_FLIGHTSQL
+    if (text.num_rows > 0 && setup_arrow(&text) != 0) return 1;
+#endif
+    size_t nrows = text.num_rows ? text.num_rows : 2048;
+    if (build_synthetic(&synthetic, nrows) != 0) return 1;
+    setup_convert(&text, &native, &synthetic);
+
+    if (json)
+        printf("{\"iterations\":%d,\"kernels\":[", iterations);
+    else
+        printf("%-32s %10s %8s %12s %14s\n",
+               "kernel", "cells", "ns/cell", "allocs/cell", "bytes/row");
+
+    int printed = 0, failed = 0;
+    for (int i = 0; i < g_nkernels; i++) {
+        kernel_t *k = &g_kernels[i];
+        if (filter && !strstr(k->name, filter)) continue;
+        result_t res;
+        if (measure(k, iterations, &res) != 0) {
+            fprintf(stderr, "%s: kernel failed\n", k->name);
+            failed = 1;
+            continue;
+        }
+        if (json)
+            printf("%s{\"name\":\"%s\",\"rows\":%zu,\"cells\":%zu,"
+                   "\"ns_per_cell\":%.2f,\"allocs_per_cell\":%.4f,"
+                   "\"bytes_per_row\":%.2f}",
+                   printed ? "," : "", k->name, k->rows, k->cells,
+                   res.ns_per_cell, res.allocs_per_cell, res.bytes_per_row);
+        else
+            printf("%-32s %10zu %8.2f %12.4f %14.2f\n",
+                   k->name, k->cells, res.ns_per_cell, res.allocs_per_cell,
+                   res.bytes_per_row);
+        printed++;
+    }
+    if (json)
+        printf("]}\n");
+
+    argus_row_cache_free(&text);
+    argus_row_cache_free(&native);
+    argus_row_cache_free(&synthetic);
+    return failed;
+}
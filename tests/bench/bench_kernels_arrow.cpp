@@ -0,0 +1,132 @@
+/*
+ * Arrow batches for argus_bench_kernels: the fixture rows as the RecordBatch
+ * a Flight SQL server would stream, fed to flightsql_append_batch.
+ */
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <arrow/api.h>
+#include <arrow/util/decimal.h>
+
+#include "flightsql_convert.h"
+#include "bench_arrow.h"
+
+namespace {
+
+constexpr int kFixtureCols = 9;
+
+struct BenchBatch {
+    std::shared_ptr<arrow::RecordBatch> batch;
+};
+
+const argus_cell_t *cell_at(const argus_row_cache_t *text, size_t r, int c)
+{
+    return &text->rows[r].cells[c];
+}
+
+/* Days since the epoch of a YYYY-MM-DD date (civil-from-days inverse). */
+int32_t days_from_civil(int y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+template <typename Builder, typename Fn>
+std::shared_ptr<arrow::Array> build_column(Builder &b,
+                                           const argus_row_cache_t *text,
+                                           int c, Fn append)
+{
+    for (size_t r = 0; r < text->num_rows; r++) {
+        const argus_cell_t *cell = cell_at(text, r, c);
+        if (cell->is_null || !cell->data)
+            (void)b.AppendNull();
+        else
+            (void)append(b, cell->data);
+    }
+    std::shared_ptr<arrow::Array> out;
+    if (!b.Finish(&out).ok()) return nullptr;
+    return out;
+}
+
+} // namespace
+
+extern "C" void *bench_arrow_prepare(const argus_row_cache_t *text,
+                                     size_t *bytes)
+{
+    if (!text || text->num_cols != kFixtureCols || text->num_rows == 0)
+        return nullptr;
+
+    auto dec_type = arrow::decimal128(12, 2);
+    arrow::Int64Builder orderkey;
+    arrow::Int32Builder linenumber;
+    arrow::DoubleBuilder quantity;
+    arrow::Decimal128Builder price(dec_type);
+    arrow::Date32Builder shipdate;
+    arrow::StringBuilder returnflag, shipmode, comment;
+    arrow::BooleanBuilder is_late;
+
+    arrow::ArrayVector cols = {
+        build_column(orderkey, text, 0, [](auto &b, const char *s) {
+            return b.Append(std::strtoll(s, nullptr, 10)); }),
+        build_column(linenumber, text, 1, [](auto &b, const char *s) {
+            return b.Append(static_cast<int32_t>(std::strtol(s, nullptr, 10))); }),
+        build_column(quantity, text, 2, [](auto &b, const char *s) {
+            return b.Append(std::strtod(s, nullptr)); }),
+        build_column(price, text, 3, [](auto &b, const char *s) {
+            auto v = arrow::Decimal128::FromString(s);
+            return v.ok() ? b.Append(*v) : b.AppendNull(); }),
+        build_column(shipdate, text, 4, [](auto &b, const char *s) {
+            int y = 0; unsigned m = 1, d = 1;
+            std::sscanf(s, "%d-%u-%u", &y, &m, &d);
+            return b.Append(days_from_civil(y, m, d)); }),
+        build_column(returnflag, text, 5, [](auto &b, const char *s) {
+            return b.Append(s); }),
+        build_column(shipmode, text, 6, [](auto &b, const char *s) {
+            return b.Append(s); }),
+        build_column(comment, text, 7, [](auto &b, const char *s) {
+            return b.Append(s); }),
+        build_column(is_late, text, 8, [](auto &b, const char *s) {
+            return b.Append(std::strcmp(s, "true") == 0); }),
+    };
+    for (const auto &col : cols)
+        if (!col) return nullptr;
+
+    auto schema = arrow::schema({
+        arrow::field("orderkey", arrow::int64(), false),
+        arrow::field("linenumber", arrow::int32()),
+        arrow::field("quantity", arrow::float64()),
+        arrow::field("extendedprice", dec_type),
+        arrow::field("shipdate", arrow::date32()),
+        arrow::field("returnflag", arrow::utf8()),
+        arrow::field("shipmode", arrow::utf8()),
+        arrow::field("comment", arrow::utf8()),
+        arrow::field("is_late", arrow::boolean()),
+    });
+
+    auto *bb = new BenchBatch;
+    bb->batch = arrow::RecordBatch::Make(
+        schema, static_cast<int64_t>(text->num_rows), cols);
+    if (bytes) {
+        size_t total = 0;
+        for (const auto &col : cols)
+            for (const auto &buf : col->data()->buffers)
+                if (buf) total += static_cast<size_t>(buf->size());
+        *bytes = total;
+    }
+    return bb;
+}
+
+extern "C" int bench_arrow_run(void *batch, argus_row_cache_t *cache)
+{
+    auto *bb = static_cast<BenchBatch *>(batch);
+    return flightsql_append_batch(bb->batch, cache);
+}
+
+extern "C" void bench_arrow_release(void *batch)
+{
+    delete static_cast<BenchBatch *>(batch);
+}
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""Compare two argus_bench_kernels --json runs.
+
+  compare_kernels.py BASELINE.json CURRENT.json [--tolerance 0.25]
+
+Time is noisy, so ns/cell may grow by up to the tolerance (a fraction of the
+baseline) before it counts as a regression. Allocations per cell and bytes per
+row are deterministic for a given fixture and must match exactly; a run that
+could not count allocations (-1) skips that check. Kernels missing from the
+current run are regressions; new ones are listed.
+
+Exits 1 on any regression, 0 otherwise.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        doc = json.load(f)
+    return {k["name"]: k for k in doc.get("kernels", [])}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("baseline")
+    ap.add_argument("current")
+    ap.add_argument("--tolerance", type=float, default=0.25,
+                    help="allowed ns/cell growth as a fraction (default 0.25)")
+    args = ap.parse_args()
+
+    base = load(args.baseline)
+    cur = load(args.current)
+    failures = []
+
+    print("%-32s %10s %10s %8s" % ("kernel", "base ns", "now ns", "change"))
+    for name, b in sorted(base.items()):
+        c = cur.get(name)
+        if c is None:
+            failures.append("%s: missing from the current run" % name)
+            continue
+        change = ((c["ns_per_cell"] - b["ns_per_cell"]) / b["ns_per_cell"]
+                  if b["ns_per_cell"] > 0 else 0.0)
+        print("%-32s %10.2f %10.2f %+7.1f%%" %
+              (name, b["ns_per_cell"], c["ns_per_cell"], change * 100))
+        if change > args.tolerance:
+            failures.append("%s: ns/cell %.2f -> %.2f (%+.1f%%)" %
+                            (name, b["ns_per_cell"], c["ns_per_cell"],
+                             change * 100))
+        if (b["allocs_per_cell"] >= 0 and c["allocs_per_cell"] >= 0 and
+                abs(c["allocs_per_cell"] - b["allocs_per_cell"]) > 1e-9):
+            failures.append("%s: allocs/cell %.4f -> %.4f" %
+                            (name, b["allocs_per_cell"],
+                             c["allocs_per_cell"]))
+        if abs(c["bytes_per_row"] - b["bytes_per_row"]) > 1e-9:
+            failures.append("%s: bytes/row %.2f -> %.2f" %
+                            (name, b["bytes_per_row"], c["bytes_per_row"]))
+
+    for name in sorted(set(cur) - set(base)):
+        print("%-32s %10s %10.2f %8s" %
+              (name, "-", cur[name]["ns_per_cell"], "new"))
+
+    if failures:
+        print("\n%d regression(s):" % len(failures))
+        for f in failures:
+            print("  " + f)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""Regenerate the recorded payloads argus_bench_kernels decodes.
+
+Both files carry the same 2048 rows of a lineitem-like table, as the servers
+send them:
+
+  trino_page.json         one Trino /v1/statement page (columns + data)
+  hive_fetch_results.bin  one TFetchResultsResp, Thrift binary protocol
+
+The rows come from a fixed-seed generator, so rerunning this script yields
+byte-identical files. Standard library only.
+"""
+
+import json
+import os
+import struct
+import sys
+
+ROWS = 2048
+COLUMNS = [
+    # name, Trino type, Thrift TColumn field
+    ("orderkey", "bigint", "i64"),
+    ("linenumber", "integer", "i32"),
+    ("quantity", "double", "double"),
+    ("extendedprice", "decimal(12,2)", "string"),
+    ("shipdate", "date", "string"),
+    ("returnflag", "varchar(1)", "string"),
+    ("shipmode", "varchar(10)", "string"),
+    ("comment", "varchar(44)", "string"),
+    ("is_late", "boolean", "bool"),
+]
+NULL_PERMILLE = 30          # every column but the key
+MODES = ["AIR", "FOB", "MAIL", "RAIL", "REG AIR", "SHIP", "TRUCK"]
+WORDS = ["carefully", "final", "deposits", "sleep", "furiously", "quick",
+         "requests", "ironic", "packages", "haggle", "\"bold\"", "accounts",
+         "blithely", "regular", "pinto", "beans"]
+
+
+class Lcg:
+    def __init__(self, seed):
+        self.state = seed
+
+    def next(self, bound):
+        self.state = (self.state * 6364136223846793005 +
+                      1442695040888963407) & 0xFFFFFFFFFFFFFFFF
+        return (self.state >> 33) % bound
+
+
+def make_rows():
+    rng = Lcg(20260301)
+    rows = []
+    for r in range(ROWS):
+        key = 1 + r // 4
+        comment_words = []
+        while len(" ".join(comment_words)) < 10 + rng.next(30):
+            comment_words.append(WORDS[rng.next(len(WORDS))])
+        row = [
+            key,
+            1 + r % 4,
+            float(1 + rng.next(50)),
+            "%d.%02d" % (900 + rng.next(100000), rng.next(100)),
+            "199%d-%02d-%02d" % (2 + rng.next(7), 1 + rng.next(12),
+                                 1 + rng.next(28)),
+            "ANR"[rng.next(3)],
+            MODES[rng.next(len(MODES))],
+            " ".join(comment_words)[:44],
+            rng.next(2) == 1,
+        ]
+        for c in range(1, len(row)):
+            if rng.next(1000) < NULL_PERMILLE:
+                row[c] = None
+        rows.append(row)
+    return rows
+
+
+def trino_page(rows):
+    qid = "20260301_120000_00042_bench"
+    base = "http://localhost:8080/v1/statement/executing/%s/y0ab3c" % qid
+    page = {
+        "id": qid,
+        "infoUri": "http://localhost:8080/ui/query.html?%s" % qid,
+        "nextUri": base + "/2",
+        "columns": [{
+            "name": name,
+            "type": ttype,
+            "typeSignature": {"rawType": ttype.split("(")[0], "arguments": []},
+        } for name, ttype, _ in COLUMNS],
+        "data": rows,
+        "stats": {
+            "state": "RUNNING", "queued": False, "scheduled": True,
+            "progressPercentage": 41.5, "nodes": 3, "totalSplits": 96,
+            "queuedSplits": 0, "runningSplits": 12, "completedSplits": 40,
+            "cpuTimeMillis": 5821, "wallTimeMillis": 14230,
+            "elapsedTimeMillis": 2310, "processedRows": 1812000,
+            "processedBytes": 94830211, "peakMemoryBytes": 41943040,
+        },
+        "warnings": [],
+    }
+    return json.dumps(page, separators=(",", ":")).encode("utf-8")
+
+
+# ── Thrift binary protocol ─────────────────────────────────────
+
+T_BOOL, T_BYTE, T_DOUBLE, T_I32, T_I64, T_STRING, T_STRUCT, T_LIST = \
+    2, 3, 4, 8, 10, 11, 12, 15
+
+
+def field(ftype, fid):
+    return struct.pack(">bh", ftype, fid)
+
+
+def stop():
+    return b"\x00"
+
+
+def tstring(b):
+    return struct.pack(">i", len(b)) + b
+
+
+def nulls_bitmap(values):
+    bits = bytearray((len(values) + 7) // 8)
+    for i, v in enumerate(values):
+        if v is None:
+            bits[i // 8] |= 1 << (i % 8)
+    return bytes(bits)
+
+
+def tcolumn(kind, values):
+    """A TColumn union holding one typed column (values, nulls)."""
+    fid, etype, enc = {
+        "bool":   (1, T_BOOL, lambda v: struct.pack(">b", 1 if v else 0)),
+        "i32":    (4, T_I32, lambda v: struct.pack(">i", v or 0)),
+        "i64":    (5, T_I64, lambda v: struct.pack(">q", v or 0)),
+        "double": (6, T_DOUBLE, lambda v: struct.pack(">d", v or 0.0)),
+        "string": (7, T_STRING,
+                   lambda v: tstring((v or "").encode("utf-8"))),
+    }[kind]
+    col = field(T_LIST, 1) + struct.pack(">bi", etype, len(values))
+    col += b"".join(enc(v) for v in values)
+    col += field(T_STRING, 2) + tstring(nulls_bitmap(values))
+    col += stop()
+    return field(T_STRUCT, fid) + col + stop()
+
+
+def hive_fetch_results(rows):
+    status = field(T_I32, 1) + struct.pack(">i", 0) + stop()   # SUCCESS
+    columns = b""
+    for c, (_, _, kind) in enumerate(COLUMNS):
+        values = [row[c] for row in rows]
+        if kind == "string":
+            values = [None if v is None else str(v) for v in values]
+        columns += tcolumn(kind, values)
+    row_set = (field(T_I64, 1) + struct.pack(">q", 0) +
+               field(T_LIST, 2) + struct.pack(">bi", T_STRUCT, 0) +
+               field(T_LIST, 3) + struct.pack(">bi", T_STRUCT, len(COLUMNS)) +
+               columns + stop())
+    return (field(T_STRUCT, 1) + status +
+            field(T_BOOL, 2) + b"\x01" +
+            field(T_STRUCT, 3) + row_set + stop())
+
+
+def main():
+    out = os.path.dirname(os.path.abspath(__file__))
+    if len(sys.argv) > 1:
+        out = sys.argv[1]
+    rows = make_rows()
+    with open(os.path.join(out, "trino_page.json"), "wb") as f:
+        f.write(trino_page(rows))
+    with open(os.path.join(out, "hive_fetch_results.bin"), "wb") as f:
+        f.write(hive_fetch_results(rows))
+
+
+if __name__ == "__main__":
+    main()
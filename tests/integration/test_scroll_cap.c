@@ -1,10 +1,10 @@
 /*
- * Integration test: the static-cursor materialisation cap (MAXSCROLLROWS).
+ * Integration test: the static-cursor row cap (MAXSCROLLROWS).
  *
- * A static (scrollable) cursor buffers the whole result set in memory; an
- * unbounded SELECT would OOM the process. Past the cap the driver must fail
- * cleanly with SQLSTATE HY001 and an actionable message — never crash or
- * truncate silently. Under the cap, scrolling works and sees every row.
+ * A static (scrollable) cursor buffers every row it reads. Past the cap the
+ * driver must fail cleanly with SQLSTATE HY001 and an actionable message —
+ * never crash or truncate silently. Under the cap, scrolling works and sees
+ * every row.
  *
  * Requires a live Trino (docker compose -f tests/integration/docker-compose.yml).
  */
@@ -62,7 +62,7 @@ static SQLHSTMT static_cursor_exec(SQLHDBC dbc, const char *sql)
     return stmt;
 }
 
-/* 10 rows > cap of 5: the first scroll materialises and must refuse. */
+/* 10 rows > cap of 5: scrolling to the end reads them all and must refuse. */
 static void test_cap_exceeded_fails_cleanly(void **state)
 {
     (void)state;
@@ -71,7 +71,7 @@ static void test_cap_exceeded_fails_cleanly(void **state)
     SQLHSTMT stmt = static_cursor_exec(
         dbc, "SELECT * FROM UNNEST(SEQUENCE(1, 10)) AS t(n)");
 
-    SQLRETURN ret = SQLFetchScroll(stmt, SQL_FETCH_FIRST, 0);
+    SQLRETURN ret = SQLFetchScroll(stmt, SQL_FETCH_LAST, 0);
     assert_int_equal(ret, SQL_ERROR);
 
     SQLCHAR sqlstate[6] = {0}, msg[256] = {0};
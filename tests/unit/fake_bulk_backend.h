@@ -0,0 +1,215 @@
+#ifndef ARGUS_TEST_FAKE_BULK_BACKEND_H
+#define ARGUS_TEST_FAKE_BULK_BACKEND_H
+
+/*
+ * Fake backends shared by the unit tests of bulk inserts (SQL_ADD, INSERT
+ * parameter arrays, ADBC ingestion): "fakebulk" records the INSERT
+ * statements it runs, "fakeload" also has a native bulk path that records
+ * the rows it is handed. Include after <cmocka.h>.
+ */
+
+#include <sql.h>
+#include <sqlext.h>
+#include <stdint.h>
+#include <string.h>
+#include <glib.h>
+#include "argus/handle.h"
+
+/* ── Fake backend: SELECTs describe (id, label) and return no rows;
+ *    INSERTs are recorded and fail if they carry the value 'boom' ─ */
+
+#define SELECT_OP ((argus_backend_op_t)(uintptr_t)0x5E1)
+#define INSERT_OP ((argus_backend_op_t)(uintptr_t)0x1A5)
+
+static GPtrArray *inserts;      /* INSERT statements executed */
+static char fake_error[128];
+
+static int fake_connect(argus_dbc_t *dbc, const char *host, int port,
+                        const char *username, const char *password,
+                        const char *database, const char *auth_mechanism,
+                        argus_backend_conn_t *out_conn)
+{
+    (void)dbc; (void)host; (void)port; (void)username; (void)password;
+    (void)database; (void)auth_mechanism;
+    *out_conn = (argus_backend_conn_t)(uintptr_t)0xCAFE;
+    return 0;
+}
+
+static void fake_disconnect(argus_backend_conn_t conn)
+{
+    (void)conn;
+}
+
+static int fake_execute(argus_backend_conn_t conn, const char *query,
+                        argus_backend_op_t *out_op)
+{
+    (void)conn;
+    fake_error[0] = '\0';
+    if (strncmp(query, "INSERT ", 7) == 0) {
+        g_ptr_array_add(inserts, g_strdup(query));
+        if (strstr(query, "'boom'")) {
+            g_strlcpy(fake_error, "constraint violated", sizeof(fake_error));
+            return -1;
+        }
+        *out_op = INSERT_OP;
+        return 0;
+    }
+    *out_op = SELECT_OP;
+    return 0;
+}
+
+static int fake_get_operation_status(argus_backend_conn_t conn,
+                                     argus_backend_op_t op, bool *finished)
+{
+    (void)conn; (void)op;
+    *finished = true;
+    return 0;
+}
+
+static void fake_close_operation(argus_backend_conn_t conn,
+                                 argus_backend_op_t op)
+{
+    (void)conn; (void)op;
+}
+
+static int fake_get_result_metadata(argus_backend_conn_t conn,
+                                    argus_backend_op_t op,
+                                    argus_column_desc_t *columns,
+                                    int *num_cols)
+{
+    (void)conn;
+    if (op != SELECT_OP) {
+        *num_cols = 0;
+        return 0;
+    }
+    memset(columns, 0, 2 * sizeof(columns[0]));
+    strcpy((char *)columns[0].name, "id");
+    columns[0].sql_type = SQL_BIGINT;
+    columns[0].column_size = 19;
+    strcpy((char *)columns[1].name, "label");
+    columns[1].sql_type = SQL_VARCHAR;
+    columns[1].column_size = 16;
+    columns[1].nullable = SQL_NULLABLE;
+    *num_cols = 2;
+    return 0;
+}
+
+static int fake_fetch_results(argus_backend_conn_t conn,
+                              argus_backend_op_t op, int max_rows,
+                              argus_row_cache_t *cache,
+                              argus_column_desc_t *columns, int *num_cols)
+{
+    (void)max_rows;
+    fake_get_result_metadata(conn, op, columns, num_cols);
+    cache->num_rows = 0;
+    cache->exhausted = true;
+    return 0;
+}
+
+static bool fake_get_last_error(argus_backend_conn_t conn, char *buf,
+                                size_t buflen)
+{
+    (void)conn;
+    if (!fake_error[0]) return false;
+    g_strlcpy(buf, fake_error, buflen);
+    return true;
+}
+
+/* The same with a native bulk path, which records each row as
+ * "cell|cell", rejects rows carrying 'boom' and skips those carrying 'skip'
+ * without saying which, as LOAD DATA does; it takes rows only while
+ * load_enabled is set, as MySQL-wire only with BulkLoad=1 */
+static bool load_enabled;
+static GPtrArray *loaded;       /* rows the bulk path received */
+static char load_table[64];
+static char load_cols[64];      /* column names, comma-separated */
+
+static int fake_bulk_insert(argus_backend_conn_t conn, const char *table,
+                            const argus_column_desc_t *columns, int ncols,
+                            const argus_bulk_rows_t *rows, bool *row_ok,
+                            size_t *added)
+{
+    (void)conn;
+    if (!load_enabled) return 1;
+    if (!rows) return 0;
+    fake_error[0] = '\0';
+
+    g_strlcpy(load_table, table, sizeof(load_table));
+    GString *cols = g_string_new(NULL);
+    for (int c = 0; c < ncols; c++)
+        g_string_append_printf(cols, "%s%s", c ? "," : "",
+                               (const char *)columns[c].name);
+    g_strlcpy(load_cols, cols->str, sizeof(load_cols));
+    g_string_free(cols, TRUE);
+
+    int rc = 0;
+    *added = 0;
+    for (size_t r = 0; r < rows->nrows; r++) {
+        const argus_cell_t *cells = rows->get(rows->ctx, r);
+        row_ok[r] = false;
+        if (!cells) continue;
+        GString *row = g_string_new(NULL);
+        for (int c = 0; c < ncols; c++) {
+            const argus_cell_t *cell = &cells[c];
+            g_string_append_printf(row, "%s%s", c ? "|" : "",
+                                   cell->is_null ? "\\N" : cell->data);
+        }
+        row_ok[r] = !strstr(row->str, "boom");
+        if (!row_ok[r]) rc = -1;
+        else if (strstr(row->str, "skip")) rc = -1;
+        else (*added)++;
+        g_ptr_array_add(loaded, g_string_free(row, FALSE));
+    }
+    if (rc != 0)
+        g_strlcpy(fake_error, "row rejected", sizeof(fake_error));
+    return rc;
+}
+
+static const argus_backend_t fake_backend = {
+    .name                 = "fakebulk",
+    .connect              = fake_connect,
+    .disconnect           = fake_disconnect,
+    .execute              = fake_execute,
+    .get_operation_status = fake_get_operation_status,
+    .close_operation      = fake_close_operation,
+    .fetch_results        = fake_fetch_results,
+    .get_result_metadata  = fake_get_result_metadata,
+    .get_last_error       = fake_get_last_error,
+};
+
+static const argus_backend_t fake_load_backend = {
+    .name                 = "fakeload",
+    .connect              = fake_connect,
+    .disconnect           = fake_disconnect,
+    .execute              = fake_execute,
+    .get_operation_status = fake_get_operation_status,
+    .close_operation      = fake_close_operation,
+    .fetch_results        = fake_fetch_results,
+    .get_result_metadata  = fake_get_result_metadata,
+    .get_last_error       = fake_get_last_error,
+    .bulk_insert          = fake_bulk_insert,
+};
+
+/* Register both backends (after argus_backends_init) */
+static void fake_bulk_register(void)
+{
+    argus_backend_register(&fake_backend);
+    argus_backend_register(&fake_load_backend);
+    inserts = g_ptr_array_new_with_free_func(g_free);
+    loaded = g_ptr_array_new_with_free_func(g_free);
+}
+
+static void fake_bulk_unregister(void)
+{
+    g_ptr_array_free(inserts, TRUE);
+    g_ptr_array_free(loaded, TRUE);
+}
+
+/* Forget the statements and rows recorded so far */
+static void fake_bulk_reset(void)
+{
+    g_ptr_array_set_size(inserts, 0);
+    g_ptr_array_set_size(loaded, 0);
+}
+
+#endif /* ARGUS_TEST_FAKE_BULK_BACKEND_H */
@@ -0,0 +1,66 @@
+#ifndef ARGUS_TEST_SYNTHETIC_DBC_H
+#define ARGUS_TEST_SYNTHETIC_DBC_H
+
+/*
+ * Connection helpers shared by the unit tests that run statements end to
+ * end against BACKEND=synthetic, or against a fake backend of their own.
+ * Include after <cmocka.h>. Inline so a test may use only some of them.
+ */
+
+#include <sql.h>
+#include <sqlext.h>
+#include <glib.h>
+#include "argus/handle.h"
+#include "argus/odbc_api.h"
+
+/* Group setup: register the backends */
+static inline int setup(void **state)
+{
+    (void)state;
+    extern void argus_backends_init(void);
+    argus_backends_init();
+    return 0;
+}
+
+/* An ODBC 3 connection handle, not connected yet; free_dbc frees it */
+static inline argus_dbc_t *alloc_dbc(void)
+{
+    argus_env_t *env = NULL;
+    argus_alloc_env(&env);
+    env->odbc_version = SQL_OV_ODBC3;
+    argus_dbc_t *dbc = NULL;
+    argus_alloc_dbc(env, &dbc);
+    return dbc;
+}
+
+/* Connect with the whole connection string, leaving the result in *ret */
+static inline argus_dbc_t *connect_with(const char *connstr, SQLRETURN *ret)
+{
+    argus_dbc_t *dbc = alloc_dbc();
+    *ret = SQLDriverConnect((SQLHDBC)dbc, NULL, (SQLCHAR *)connstr, SQL_NTS,
+                            NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+    return dbc;
+}
+
+/* Connect to the synthetic backend; extra holds more keys, or NULL */
+static inline argus_dbc_t *connect_dbc(const char *extra)
+{
+    char *connstr = g_strdup_printf("BACKEND=synthetic;HOST=localhost;%s",
+                                    extra ? extra : "");
+    SQLRETURN ret;
+    argus_dbc_t *dbc = connect_with(connstr, &ret);
+    assert_int_equal(ret, SQL_SUCCESS);
+    g_free(connstr);
+    return dbc;
+}
+
+/* Disconnect and free the connection and its environment */
+static inline void free_dbc(argus_dbc_t *dbc)
+{
+    argus_env_t *env = dbc->env;
+    if (dbc->connected) SQLDisconnect((SQLHDBC)dbc);
+    argus_free_dbc(dbc);
+    argus_free_env(env);
+}
+
+#endif /* ARGUS_TEST_SYNTHETIC_DBC_H */
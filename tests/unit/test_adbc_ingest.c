@@ -0,0 +1,436 @@
+/*
+ * Unit tests for ADBC bulk ingestion (src/adbc/argus_adbc.c): Arrow batches
+ * bound with AdbcStatementBind or AdbcStatementBindStream, inserted into a
+ * fake backend that records the INSERT statements or bulk rows it gets.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include "argus/adbc.h"
+#include "fake_bulk_backend.h"
+#include "synthetic_dbc.h"
+
+/* ── Arrow batches over caller-owned buffers ─────────────────── */
+
+#define MAX_FIELDS 8
+
+typedef struct {
+    struct ArrowSchema  schema;
+    struct ArrowSchema  fields[MAX_FIELDS];
+    struct ArrowSchema *field_ptrs[MAX_FIELDS];
+    struct ArrowArray   array;
+    struct ArrowArray   columns[MAX_FIELDS];
+    struct ArrowArray  *column_ptrs[MAX_FIELDS];
+    const void         *struct_buffers[1];
+    const void         *buffers[MAX_FIELDS][3];
+} batch_t;
+
+/* Nothing is owned: releasing only marks the structs released */
+static void release_array(struct ArrowArray *a)
+{
+    for (int64_t i = 0; i < a->n_children; i++)
+        if (a->children[i]->release) a->children[i]->release(a->children[i]);
+    a->release = NULL;
+}
+
+static void release_schema(struct ArrowSchema *s)
+{
+    for (int64_t i = 0; i < s->n_children; i++)
+        if (s->children[i]->release) s->children[i]->release(s->children[i]);
+    s->release = NULL;
+}
+
+static void batch_init(batch_t *b, int64_t length)
+{
+    memset(b, 0, sizeof(*b));
+    b->schema.format = "+s";
+    b->schema.name = "";
+    b->schema.children = b->field_ptrs;
+    b->schema.release = release_schema;
+    b->array.length = length;
+    b->array.n_buffers = 1;
+    b->array.buffers = b->struct_buffers;
+    b->array.children = b->column_ptrs;
+    b->array.release = release_array;
+}
+
+/* Add a column: validity bitmap (NULL: all valid), the values, and for
+ * strings the character data after the offsets */
+static void batch_add(batch_t *b, const char *format, const char *name,
+                      const uint8_t *validity, int64_t null_count,
+                      const void *values, const void *chars)
+{
+    int i = (int)b->schema.n_children;
+    assert_true(i < MAX_FIELDS);
+    struct ArrowSchema *f = &b->fields[i];
+    f->format = format;
+    f->name = name;
+    f->flags = ARROW_FLAG_NULLABLE;
+    f->release = release_schema;
+    b->field_ptrs[i] = f;
+
+    struct ArrowArray *c = &b->columns[i];
+    b->buffers[i][0] = validity;
+    b->buffers[i][1] = values;
+    b->buffers[i][2] = chars;
+    c->length = b->array.length;
+    c->null_count = null_count;
+    c->n_buffers = chars ? 3 : 2;
+    c->buffers = b->buffers[i];
+    c->release = release_array;
+    b->column_ptrs[i] = c;
+
+    b->schema.n_children = i + 1;
+    b->array.n_children = i + 1;
+}
+
+/* A stream over a list of batches */
+typedef struct {
+    batch_t **batches;
+    int       n, next;
+} stream_state_t;
+
+static int stream_get_schema(struct ArrowArrayStream *s,
+                             struct ArrowSchema *out)
+{
+    stream_state_t *st = s->private_data;
+    *out = st->batches[0]->schema;
+    return 0;
+}
+
+static int stream_get_next(struct ArrowArrayStream *s, struct ArrowArray *out)
+{
+    stream_state_t *st = s->private_data;
+    if (st->next == st->n) {
+        memset(out, 0, sizeof(*out));
+        return 0;
+    }
+    batch_t *b = st->batches[st->next++];
+    for (int64_t i = 0; i < b->array.n_children; i++)
+        b->columns[i].release = release_array;
+    *out = b->array;
+    out->release = release_array;
+    return 0;
+}
+
+static const char *stream_get_last_error(struct ArrowArrayStream *s)
+{
+    (void)s;
+    return NULL;
+}
+
+static void stream_release(struct ArrowArrayStream *s)
+{
+    s->release = NULL;
+}
+
+/* ── ADBC handles ────────────────────────────────────────────── */
+
+typedef struct {
+    struct AdbcDatabase  db;
+    struct AdbcConnection conn;
+    struct AdbcStatement stmt;
+    struct AdbcError     error;
+} adbc_t;
+
+static int setup_fakes(void **state)
+{
+    setup(state);
+    fake_bulk_register();
+    return 0;
+}
+
+static int teardown(void **state)
+{
+    (void)state;
+    fake_bulk_unregister();
+    return 0;
+}
+
+/* A statement ingesting into "t" over BACKEND=fakeload */
+static void adbc_open(adbc_t *a)
+{
+    memset(a, 0, sizeof(*a));
+    assert_int_equal(AdbcDatabaseNew(&a->db, &a->error), ADBC_STATUS_OK);
+    assert_int_equal(AdbcDatabaseSetOption(&a->db, "uri",
+                                           "BACKEND=fakeload;HOST=localhost",
+                                           &a->error),
+                     ADBC_STATUS_OK);
+    assert_int_equal(AdbcDatabaseInit(&a->db, &a->error), ADBC_STATUS_OK);
+    assert_int_equal(AdbcConnectionNew(&a->conn, &a->error), ADBC_STATUS_OK);
+    assert_int_equal(AdbcConnectionInit(&a->conn, &a->db, &a->error),
+                     ADBC_STATUS_OK);
+    assert_int_equal(AdbcStatementNew(&a->conn, &a->stmt, &a->error),
+                     ADBC_STATUS_OK);
+    assert_int_equal(AdbcStatementSetOption(&a->stmt,
+                                            ADBC_INGEST_OPTION_TARGET_TABLE,
+                                            "t", &a->error),
+                     ADBC_STATUS_OK);
+    fake_bulk_reset();
+}
+
+static void adbc_close(adbc_t *a)
+{
+    AdbcStatementRelease(&a->stmt, &a->error);
+    AdbcConnectionRelease(&a->conn, &a->error);
+    AdbcDatabaseRelease(&a->db, &a->error);
+    free(a->error.message);
+}
+
+/* Bind b and ingest it; returns the status, *rows the rows reported */
+static AdbcStatusCode ingest_batch(adbc_t *a, batch_t *b, int64_t *rows)
+{
+    assert_int_equal(AdbcStatementBind(&a->stmt, &b->array, &b->schema,
+                                       &a->error),
+                     ADBC_STATUS_OK);
+    free(a->error.message);
+    a->error.message = NULL;
+    return AdbcStatementExecuteQuery(&a->stmt, NULL, rows, &a->error);
+}
+
+/* ── Test: each Arrow type's parameter mapping ───────────────── */
+
+static void test_ingest_types(void **state)
+{
+    (void)state;
+    adbc_t a;
+    adbc_open(&a);
+    load_enabled = true;
+
+    int64_t i64[3] = { 1, -2, 3 };
+    int32_t i32[3] = { 10, 20, 30 };
+    uint8_t i32_valid = 0x5;                    /* row 1 null */
+    double f64[3] = { 0.5, 1.5, -2.25 };
+    uint8_t flags = 0x3;                        /* true, true, false */
+    int32_t name_off[4] = { 0, 1, 7, 7 };
+    uint8_t name_valid = 0x3;                   /* row 2 null */
+    int32_t days[3] = { 0, -1, 19000 };
+    int64_t micros[3] = { 0, 1500000, -1 };
+
+    batch_t b;
+    batch_init(&b, 3);
+    batch_add(&b, "l", "i64", NULL, 0, i64, NULL);
+    batch_add(&b, "i", "i32", &i32_valid, 1, i32, NULL);
+    batch_add(&b, "g", "f64", NULL, 0, f64, NULL);
+    batch_add(&b, "b", "flag", NULL, 0, &flags, NULL);
+    batch_add(&b, "u", "name", &name_valid, 1, name_off, "ait's\tx");
+    batch_add(&b, "tdD", "day", NULL, 0, days, NULL);
+    batch_add(&b, "tsu:UTC", "at", NULL, 0, micros, NULL);
+
+    int64_t rows = 0;
+    assert_int_equal(ingest_batch(&a, &b, &rows), ADBC_STATUS_OK);
+    assert_int_equal(rows, 3);
+    assert_int_equal(inserts->len, 0);
+    assert_string_equal(load_table, "\"t\"");
+    assert_string_equal(load_cols, "i64,i32,f64,flag,name,day,at");
+    assert_int_equal(loaded->len, 3);
+    assert_string_equal(g_ptr_array_index(loaded, 0),
+                        "1|10|0.5|1|a|1970-01-01|1970-01-01 00:00:00");
+    assert_string_equal(g_ptr_array_index(loaded, 1),
+                        "-2|\\N|1.5|1|it's\tx|1969-12-31|"
+                        "1970-01-01 00:00:01.5");
+    assert_string_equal(g_ptr_array_index(loaded, 2),
+                        "3|30|-2.25|0|\\N|2022-01-08|"
+                        "1969-12-31 23:59:59.999999");
+
+    /* A type with no parameter mapping */
+    uint8_t bytes[2] = { 0, 1 };
+    int32_t bytes_off[4] = { 0, 1, 2, 2 };
+    batch_init(&b, 3);
+    batch_add(&b, "z", "blob", NULL, 0, bytes_off, bytes);
+    assert_int_equal(ingest_batch(&a, &b, &rows), ADBC_STATUS_NOT_IMPLEMENTED);
+    assert_non_null(strstr(a.error.message, "'blob'"));
+
+    load_enabled = false;
+    adbc_close(&a);
+}
+
+/* ── Test: dates across the proleptic calendar ───────────────── */
+
+static void test_ingest_dates(void **state)
+{
+    (void)state;
+    adbc_t a;
+    adbc_open(&a);
+    load_enabled = true;
+
+    /* 0001-01-01, 1900-03-01 (1900 is no leap year), 2000-02-29 and
+     * 9999-12-31 as days since the epoch */
+    int32_t days[4] = { -719162, -25508, 11016, 2932896 };
+    batch_t b;
+    batch_init(&b, 4);
+    batch_add(&b, "tdD", "day", NULL, 0, days, NULL);
+
+    int64_t rows = 0;
+    assert_int_equal(ingest_batch(&a, &b, &rows), ADBC_STATUS_OK);
+    assert_int_equal(loaded->len, 4);
+    assert_string_equal(g_ptr_array_index(loaded, 0), "0001-01-01");
+    assert_string_equal(g_ptr_array_index(loaded, 1), "1900-03-01");
+    assert_string_equal(g_ptr_array_index(loaded, 2), "2000-02-29");
+    assert_string_equal(g_ptr_array_index(loaded, 3), "9999-12-31");
+
+    load_enabled = false;
+    adbc_close(&a);
+}
+
+/* ── Test: strings of very different lengths, and sliced arrays ─ */
+
+static void test_ingest_strings(void **state)
+{
+    (void)state;
+    adbc_t a;
+    adbc_open(&a);
+    load_enabled = true;
+
+    enum { LONG_LEN = 5000 };
+    char *chars = malloc(LONG_LEN + 3);
+    chars[0] = 'x';
+    memset(chars + 1, 'y', LONG_LEN);
+    chars[LONG_LEN + 1] = 'z';
+    int32_t off[4] = { 0, 1, LONG_LEN + 1, LONG_LEN + 2 };
+    int64_t ids[3] = { 1, 2, 3 };
+
+    batch_t b;
+    batch_init(&b, 3);
+    batch_add(&b, "l", "id", NULL, 0, ids, NULL);
+    batch_add(&b, "u", "s", NULL, 0, off, chars);
+
+    int64_t rows = 0;
+    assert_int_equal(ingest_batch(&a, &b, &rows), ADBC_STATUS_OK);
+    assert_int_equal(loaded->len, 3);
+    assert_string_equal(g_ptr_array_index(loaded, 0), "1|x");
+    const char *row = g_ptr_array_index(loaded, 1);
+    assert_int_equal(strlen(row), LONG_LEN + 2);
+    assert_int_equal(strspn(row + 2, "y"), LONG_LEN);
+    assert_string_equal(g_ptr_array_index(loaded, 2), "3|z");
+
+    /* Rows 1 and 2 only: the batch's offset applies to every column */
+    fake_bulk_reset();
+    batch_init(&b, 2);
+    b.array.offset = 1;
+    batch_add(&b, "l", "id", NULL, 0, ids, NULL);
+    batch_add(&b, "u", "s", NULL, 0, off, chars);
+    assert_int_equal(ingest_batch(&a, &b, &rows), ADBC_STATUS_OK);
+    assert_int_equal(rows, 2);
+    assert_int_equal(loaded->len, 2);
+    assert_string_equal(g_ptr_array_index(loaded, 1), "3|z");
+
+    free(chars);
+    load_enabled = false;
+    adbc_close(&a);
+}
+
+/* ── Test: a bound stream goes in batch by batch ─────────────── */
+
+static void test_ingest_stream(void **state)
+{
+    (void)state;
+    adbc_t a;
+    adbc_open(&a);
+    load_enabled = true;
+
+    int64_t ids[3] = { 1, 2, 3 };
+    int32_t off[4] = { 0, 1, 2, 3 };
+    batch_t first, second;
+    batch_init(&first, 2);
+    batch_add(&first, "l", "id", NULL, 0, ids, NULL);
+    batch_add(&first, "u", "s", NULL, 0, off, "abc");
+    batch_init(&second, 1);
+    second.array.offset = 2;
+    batch_add(&second, "l", "id", NULL, 0, ids, NULL);
+    batch_add(&second, "u", "s", NULL, 0, off, "abc");
+
+    batch_t *list[2] = { &first, &second };
+    stream_state_t st = { list, 2, 0 };
+    struct ArrowArrayStream stream = {
+        .get_schema     = stream_get_schema,
+        .get_next       = stream_get_next,
+        .get_last_error = stream_get_last_error,
+        .release        = stream_release,
+        .private_data   = &st,
+    };
+    assert_int_equal(AdbcStatementBindStream(&a.stmt, &stream, &a.error),
+                     ADBC_STATUS_OK);
+    int64_t rows = 0;
+    assert_int_equal(AdbcStatementExecuteQuery(&a.stmt, NULL, &rows,
+                                               &a.error),
+                     ADBC_STATUS_OK);
+    assert_int_equal(rows, 3);
+    assert_int_equal(loaded->len, 3);
+    assert_string_equal(g_ptr_array_index(loaded, 0), "1|a");
+    assert_string_equal(g_ptr_array_index(loaded, 2), "3|c");
+
+    /* Execute consumed the stream: nothing is left to ingest */
+    assert_int_equal(AdbcStatementExecuteQuery(&a.stmt, NULL, &rows,
+                                               &a.error),
+                     ADBC_STATUS_INVALID_STATE);
+
+    load_enabled = false;
+    adbc_close(&a);
+}
+
+/* ── Test: rows the server rejects or skips ──────────────────── */
+
+static void test_ingest_failures(void **state)
+{
+    (void)state;
+    adbc_t a;
+    adbc_open(&a);
+
+    int64_t ids[3] = { 1, 2, 3 };
+    int32_t off[4] = { 0, 1, 5, 9 };
+    batch_t b;
+    batch_init(&b, 3);
+    batch_add(&b, "l", "id", NULL, 0, ids, NULL);
+    batch_add(&b, "u", "label", NULL, 0, off, "aboomit's");
+
+    /* One INSERT per row without a bulk path: the failed one is counted */
+    int64_t rows = 0;
+    assert_int_equal(ingest_batch(&a, &b, &rows), ADBC_STATUS_IO);
+    assert_int_equal(rows, 2);
+    assert_int_equal(inserts->len, 3);
+    assert_string_equal(g_ptr_array_index(inserts, 0),
+                        "INSERT INTO \"t\" (\"id\", \"label\") VALUES "
+                        "(1, 'a')");
+    assert_string_equal(g_ptr_array_index(inserts, 2),
+                        "INSERT INTO \"t\" (\"id\", \"label\") VALUES "
+                        "(3, 'it''s')");
+    assert_non_null(strstr(a.error.message, "1 of 3 rows not inserted"));
+
+    /* Rejected by the bulk path */
+    load_enabled = true;
+    fake_bulk_reset();
+    assert_int_equal(ingest_batch(&a, &b, &rows), ADBC_STATUS_IO);
+    assert_int_equal(rows, 2);
+    assert_int_equal(loaded->len, 3);
+
+    /* Skipped without saying which: only the count is known */
+    int32_t skip_off[4] = { 0, 1, 5, 6 };
+    batch_init(&b, 3);
+    batch_add(&b, "l", "id", NULL, 0, ids, NULL);
+    batch_add(&b, "u", "label", NULL, 0, skip_off, "askipc");
+    assert_int_equal(ingest_batch(&a, &b, &rows), ADBC_STATUS_IO);
+    assert_int_equal(rows, 2);
+    assert_non_null(strstr(a.error.message, "not known which"));
+
+    load_enabled = false;
+    adbc_close(&a);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_ingest_types),
+        cmocka_unit_test(test_ingest_dates),
+        cmocka_unit_test(test_ingest_strings),
+        cmocka_unit_test(test_ingest_stream),
+        cmocka_unit_test(test_ingest_failures),
+    };
+    return cmocka_run_group_tests(tests, setup_fakes, teardown);
+}
@@ -0,0 +1,228 @@
+/*
+ * Unit tests for asynchronous execution on the shared executor
+ * (src/odbc/executor.c), driven through BACKEND=synthetic.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include "argus/handle.h"
+#include "argus/odbc_api.h"
+#include "synthetic_dbc.h"
+
+#ifndef SQL_ATTR_ASYNC_STMT_PCALLBACK
+#define SQL_ATTR_ASYNC_STMT_PCALLBACK       10012
+#define SQL_ATTR_ASYNC_STMT_PCONTEXT        10013
+#endif
+#ifndef SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE
+#define SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE 117
+#define SQL_ASYNC_DBC_ENABLE_ON             1UL
+#endif
+
+#define THREADS "ASYNCTHREADS=2"
+#define CONNSTR "BACKEND=synthetic;HOST=localhost;" THREADS
+
+/* ── Helpers ─────────────────────────────────────────────────── */
+
+static SQLHSTMT async_stmt(argus_dbc_t *dbc)
+{
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    SQLSetStmtAttr(stmt, SQL_ATTR_ASYNC_ENABLE,
+                   (SQLPOINTER)(uintptr_t)SQL_ASYNC_ENABLE_ON, 0);
+    return stmt;
+}
+
+static long count_rows(SQLHSTMT stmt)
+{
+    long rows = 0;
+    while (SQLFetch(stmt) == SQL_SUCCESS) rows++;
+    return rows;
+}
+
+/* Completion callback: counts calls and wakes the test */
+typedef struct notified {
+    GMutex lock;
+    GCond  cond;
+    int    calls;
+} notified_t;
+
+static SQLRETURN SQL_API on_complete(SQLPOINTER context, int last)
+{
+    notified_t *n = (notified_t *)context;
+    (void)last;
+    g_mutex_lock(&n->lock);
+    n->calls++;
+    g_cond_signal(&n->cond);
+    g_mutex_unlock(&n->lock);
+    return SQL_SUCCESS;
+}
+
+/* ── Test: polling returns SQL_STILL_EXECUTING, then the result ── */
+
+static void test_async_poll(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(THREADS);
+
+    SQLHSTMT stmt = async_stmt(dbc);
+    const char *sql = "SYNTHETIC rows=25 cols=2 execlatency=100";
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)sql, SQL_NTS),
+                     SQL_STILL_EXECUTING);
+
+    SQLRETURN ret;
+    int polls = 0;
+    while ((ret = SQLExecDirect(stmt, (SQLCHAR *)sql, SQL_NTS)) ==
+           SQL_STILL_EXECUTING) {
+        polls++;
+        g_usleep(5000);
+    }
+    assert_int_equal(ret, SQL_SUCCESS);
+    assert_true(polls > 0);
+    assert_int_equal(count_rows(stmt), 25);
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: the completion callback fires once ────────────────── */
+
+static void test_async_callback(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(THREADS);
+
+    notified_t n;
+    g_mutex_init(&n.lock);
+    g_cond_init(&n.cond);
+    n.calls = 0;
+
+    SQLHSTMT stmt = async_stmt(dbc);
+    SQLSetStmtAttr(stmt, SQL_ATTR_ASYNC_STMT_PCALLBACK,
+                   (SQLPOINTER)on_complete, 0);
+    SQLSetStmtAttr(stmt, SQL_ATTR_ASYNC_STMT_PCONTEXT, &n, 0);
+
+    SQLPOINTER got = NULL;
+    SQLGetStmtAttr(stmt, SQL_ATTR_ASYNC_STMT_PCONTEXT, &got, 0, NULL);
+    assert_ptr_equal(got, &n);
+
+    assert_int_equal(SQLExecDirect(stmt,
+                                   (SQLCHAR *)"SYNTHETIC rows=3 execlatency=50",
+                                   SQL_NTS),
+                     SQL_STILL_EXECUTING);
+
+    gint64 deadline = g_get_monotonic_time() + 5 * G_USEC_PER_SEC;
+    g_mutex_lock(&n.lock);
+    while (n.calls == 0 &&
+           g_cond_wait_until(&n.cond, &n.lock, deadline))
+        ;
+    g_mutex_unlock(&n.lock);
+    assert_int_equal(n.calls, 1);
+
+    RETCODE rc = SQL_ERROR;
+    assert_int_equal(SQLCompleteAsync(SQL_HANDLE_STMT, stmt, &rc),
+                     SQL_SUCCESS);
+    assert_int_equal(rc, SQL_SUCCESS);
+    assert_int_equal(count_rows(stmt), 3);
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+    g_cond_clear(&n.cond);
+    g_mutex_clear(&n.lock);
+}
+
+/* ── Test: many statements in flight on a two-thread pool ────── */
+
+#define IN_FLIGHT 32
+
+static void test_async_many_statements(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(THREADS);
+
+    SQLHSTMT stmts[IN_FLIGHT];
+    for (int i = 0; i < IN_FLIGHT; i++) {
+        char sql[96];
+        snprintf(sql, sizeof(sql),
+                 "SYNTHETIC rows=%d cols=1 execlatency=10", i + 1);
+        stmts[i] = async_stmt(dbc);
+        assert_int_equal(SQLExecDirect(stmts[i], (SQLCHAR *)sql, SQL_NTS),
+                         SQL_STILL_EXECUTING);
+    }
+
+    for (int i = 0; i < IN_FLIGHT; i++) {
+        RETCODE rc = SQL_ERROR;
+        assert_int_equal(SQLCompleteAsync(SQL_HANDLE_STMT, stmts[i], &rc),
+                         SQL_SUCCESS);
+        assert_int_equal(rc, SQL_SUCCESS);
+        assert_int_equal(count_rows(stmts[i]), i + 1);
+        SQLFreeHandle(SQL_HANDLE_STMT, stmts[i]);
+    }
+    free_dbc(dbc);
+}
+
+/* ── Test: a statement freed while it runs waits for it ──────── */
+
+static void test_async_free_in_flight(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(THREADS);
+
+    SQLHSTMT stmt = async_stmt(dbc);
+    assert_int_equal(SQLExecDirect(stmt,
+                                   (SQLCHAR *)"SYNTHETIC rows=5 execlatency=50",
+                                   SQL_NTS),
+                     SQL_STILL_EXECUTING);
+    assert_int_equal(SQLFreeHandle(SQL_HANDLE_STMT, stmt), SQL_SUCCESS);
+    free_dbc(dbc);
+}
+
+/* ── Test: connection-level async connect and disconnect ─────── */
+
+static void test_async_dbc_functions(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = alloc_dbc();
+    assert_int_equal(SQLSetConnectAttr((SQLHDBC)dbc,
+                                       SQL_ATTR_ASYNC_DBC_FUNCTIONS_ENABLE,
+                                       (SQLPOINTER)(uintptr_t)SQL_ASYNC_DBC_ENABLE_ON,
+                                       0),
+                     SQL_SUCCESS);
+
+    SQLRETURN ret;
+    while ((ret = SQLDriverConnect((SQLHDBC)dbc, NULL, (SQLCHAR *)CONNSTR,
+                                   SQL_NTS, NULL, 0, NULL,
+                                   SQL_DRIVER_NOPROMPT)) ==
+           SQL_STILL_EXECUTING)
+        g_usleep(1000);
+    assert_int_equal(ret, SQL_SUCCESS);
+    assert_true(dbc->connected);
+
+    assert_int_equal(SQLDisconnect((SQLHDBC)dbc), SQL_STILL_EXECUTING);
+    RETCODE rc = SQL_ERROR;
+    assert_int_equal(SQLCompleteAsync(SQL_HANDLE_DBC, (SQLHANDLE)dbc, &rc),
+                     SQL_SUCCESS);
+    assert_int_equal(rc, SQL_SUCCESS);
+    assert_false(dbc->connected);
+
+    free_dbc(dbc);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_async_poll),
+        cmocka_unit_test(test_async_callback),
+        cmocka_unit_test(test_async_many_statements),
+        cmocka_unit_test(test_async_free_in_flight),
+        cmocka_unit_test(test_async_dbc_functions),
+    };
+    return cmocka_run_group_tests(tests, setup, NULL);
+}
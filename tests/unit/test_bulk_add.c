@@ -0,0 +1,358 @@
+/*
+ * Unit tests for SQLBulkOperations(SQL_ADD) and INSERT parameter arrays
+ * (src/odbc/bulk.c), against fake backends that record the statements and
+ * bulk loads they are sent.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include "argus/handle.h"
+#include "fake_bulk_backend.h"
+#include "synthetic_dbc.h"
+
+/* ── Helpers ─────────────────────────────────────────────────── */
+
+static int setup_fakes(void **state)
+{
+    setup(state);
+    fake_bulk_register();
+    return 0;
+}
+
+static int teardown(void **state)
+{
+    (void)state;
+    fake_bulk_unregister();
+    return 0;
+}
+
+/* Connect to one of the fake backends, with nothing recorded yet */
+static argus_dbc_t *connect_fake(const char *connstr)
+{
+    SQLRETURN ret;
+    argus_dbc_t *dbc = connect_with(connstr, &ret);
+    assert_int_equal(ret, SQL_SUCCESS);
+    fake_bulk_reset();
+    return dbc;
+}
+
+static SQLHSTMT open_cursor(argus_dbc_t *dbc, const char *sql)
+{
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)sql, SQL_NTS),
+                     SQL_SUCCESS);
+    return stmt;
+}
+
+static const char *diag_state(SQLHSTMT stmt, SQLSMALLINT rec)
+{
+    static SQLCHAR state[6];
+    SQLINTEGER native = 0;
+    SQLCHAR msg[512];
+    SQLSMALLINT len = 0;
+    if (!SQL_SUCCEEDED(SQLGetDiagRec(SQL_HANDLE_STMT, stmt, rec, state,
+                                     &native, msg, sizeof(msg), &len)))
+        return "";
+    return (const char *)state;
+}
+
+/* ── Test: a column-wise rowset in one multi-row INSERT ──────── */
+
+static void test_bulk_add_column_wise(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_fake("BACKEND=fakebulk;HOST=localhost");
+    SQLHSTMT stmt = open_cursor(dbc, "SELECT id, label FROM t WHERE 1=0");
+
+    SQLBIGINT ids[3] = { 1, 2, 3 };
+    SQLLEN id_ind[3] = { 0, 0, 0 };
+    char labels[3][16] = { "a", "", "it's" };
+    SQLLEN label_ind[3] = { SQL_NTS, SQL_NULL_DATA, SQL_NTS };
+    SQLUSMALLINT status[3] = { 0, 0, 0 };
+
+    SQLSetStmtAttr(stmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)3, 0);
+    SQLSetStmtAttr(stmt, SQL_ATTR_ROW_STATUS_PTR, status, 0);
+    SQLBindCol(stmt, 1, SQL_C_SBIGINT, ids, sizeof(ids[0]), id_ind);
+    SQLBindCol(stmt, 2, SQL_C_CHAR, labels, sizeof(labels[0]), label_ind);
+
+    assert_int_equal(SQLBulkOperations(stmt, SQL_ADD), SQL_SUCCESS);
+    assert_int_equal(inserts->len, 1);
+    assert_string_equal(g_ptr_array_index(inserts, 0),
+                        "INSERT INTO t (\"id\", \"label\") VALUES "
+                        "(1, 'a'), (2, NULL), (3, 'it''s')");
+    for (int i = 0; i < 3; i++)
+        assert_int_equal(status[i], SQL_ROW_ADDED);
+
+    SQLLEN count = 0;
+    assert_int_equal(SQLRowCount(stmt, &count), SQL_SUCCESS);
+    assert_int_equal(count, 3);
+
+    /* A column ignored in every row is left out */
+    for (int i = 0; i < 3; i++) label_ind[i] = SQL_COLUMN_IGNORE;
+    g_ptr_array_set_size(inserts, 0);
+    assert_int_equal(SQLBulkOperations(stmt, SQL_ADD), SQL_SUCCESS);
+    assert_string_equal(g_ptr_array_index(inserts, 0),
+                        "INSERT INTO t (\"id\") VALUES (1), (2), (3)");
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: row-wise binding, chunking and per-row status ─────── */
+
+typedef struct {
+    SQLBIGINT id;
+    SQLLEN    id_ind;
+    char      label[16];
+    SQLLEN    label_ind;
+} bulk_row_t;
+
+static void test_bulk_add_row_wise(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_fake("BACKEND=fakebulk;HOST=localhost;"
+                                    "BULKINSERTROWS=2");
+    SQLHSTMT stmt = open_cursor(dbc, "SELECT id, label FROM db.t AS x");
+
+    bulk_row_t rows[3] = {
+        { 10, 0, "x", SQL_NTS },
+        { 11, 0, "y", SQL_NTS },
+        { 12, 0, "boom", SQL_NTS },
+    };
+    SQLUSMALLINT status[3] = { 0, 0, 0 };
+
+    SQLSetStmtAttr(stmt, SQL_ATTR_ROW_BIND_TYPE,
+                   (SQLPOINTER)sizeof(bulk_row_t), 0);
+    SQLSetStmtAttr(stmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)3, 0);
+    SQLSetStmtAttr(stmt, SQL_ATTR_ROW_STATUS_PTR, status, 0);
+    SQLBindCol(stmt, 1, SQL_C_SBIGINT, &rows[0].id, 0, &rows[0].id_ind);
+    SQLBindCol(stmt, 2, SQL_C_CHAR, rows[0].label, sizeof(rows[0].label),
+               &rows[0].label_ind);
+
+    /* Two rows, then one: the second statement fails on its own */
+    assert_int_equal(SQLBulkOperations(stmt, SQL_ADD),
+                     SQL_SUCCESS_WITH_INFO);
+    assert_int_equal(inserts->len, 2);
+    assert_string_equal(g_ptr_array_index(inserts, 0),
+                        "INSERT INTO db.t (\"id\", \"label\") VALUES "
+                        "(10, 'x'), (11, 'y')");
+    assert_int_equal(status[0], SQL_ROW_ADDED);
+    assert_int_equal(status[1], SQL_ROW_ADDED);
+    assert_int_equal(status[2], SQL_ROW_ERROR);
+    assert_string_equal(diag_state(stmt, 1), "HY000");
+
+    SQLLEN count = 0;
+    SQLRowCount(stmt, &count);
+    assert_int_equal(count, 2);
+
+    /* Nothing added at all is an error */
+    rows[0].id_ind = SQL_DATA_AT_EXEC;
+    rows[1].id_ind = SQL_DATA_AT_EXEC;
+    assert_int_equal(SQLBulkOperations(stmt, SQL_ADD), SQL_ERROR);
+    assert_int_equal(status[0], SQL_ROW_ERROR);
+    assert_string_equal(diag_state(stmt, 1), "HYC00");
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: SQL_ADD needs a single-table result set ───────────── */
+
+static void test_bulk_add_target(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_fake("BACKEND=fakebulk;HOST=localhost");
+    SQLBIGINT id = 1;
+
+    /* No result set yet */
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    SQLBindCol(stmt, 1, SQL_C_SBIGINT, &id, 0, NULL);
+    assert_int_equal(SQLBulkOperations(stmt, SQL_ADD), SQL_ERROR);
+    assert_string_equal(diag_state(stmt, 1), "24000");
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+
+    /* A join names no one table */
+    stmt = open_cursor(dbc, "SELECT a.id, b.label FROM t a JOIN u b "
+                            "ON a.id = b.id");
+    SQLBindCol(stmt, 1, SQL_C_SBIGINT, &id, 0, NULL);
+    assert_int_equal(SQLBulkOperations(stmt, SQL_ADD), SQL_ERROR);
+    assert_string_equal(diag_state(stmt, 1), "HY000");
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+
+    /* Nothing bound */
+    stmt = open_cursor(dbc, "SELECT id, label FROM t");
+    assert_int_equal(SQLBulkOperations(stmt, SQL_ADD), SQL_ERROR);
+    assert_string_equal(diag_state(stmt, 1), "HY010");
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+
+    assert_int_equal(inserts->len, 0);
+    free_dbc(dbc);
+}
+
+/* ── Test: SQL_ADD through the backend's bulk path ───────────── */
+
+static void test_bulk_add_native(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_fake("BACKEND=fakeload;HOST=localhost");
+    SQLHSTMT stmt = open_cursor(dbc, "SELECT id, label FROM t WHERE 1=0");
+
+    SQLBIGINT ids[2] = { 1, 2 };
+    char labels[2][16] = { "a", "" };
+    SQLLEN label_ind[2] = { SQL_NTS, SQL_NULL_DATA };
+    SQLUSMALLINT status[2] = { 0, 0 };
+    SQLSetStmtAttr(stmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)2, 0);
+    SQLSetStmtAttr(stmt, SQL_ATTR_ROW_STATUS_PTR, status, 0);
+    SQLBindCol(stmt, 1, SQL_C_SBIGINT, ids, sizeof(ids[0]), NULL);
+    SQLBindCol(stmt, 2, SQL_C_CHAR, labels, sizeof(labels[0]), label_ind);
+
+    load_enabled = true;
+    assert_int_equal(SQLBulkOperations(stmt, SQL_ADD), SQL_SUCCESS);
+    assert_int_equal(inserts->len, 0);
+    assert_int_equal(loaded->len, 2);
+    assert_string_equal(load_table, "t");
+    assert_string_equal(load_cols, "id,label");
+    assert_string_equal(g_ptr_array_index(loaded, 0), "1|a");
+    assert_string_equal(g_ptr_array_index(loaded, 1), "2|\\N");
+    assert_int_equal(status[1], SQL_ROW_ADDED);
+
+    /* Skipped without saying which: both rows are unknown, the count is
+     * the server's */
+    strcpy(labels[0], "skip");
+    assert_int_equal(SQLBulkOperations(stmt, SQL_ADD), SQL_SUCCESS_WITH_INFO);
+    assert_int_equal(status[0], SQL_ROW_SUCCESS_WITH_INFO);
+    assert_int_equal(status[1], SQL_ROW_SUCCESS_WITH_INFO);
+    assert_string_equal(diag_state(stmt, 1), "01000");
+    SQLLEN count = 0;
+    SQLRowCount(stmt, &count);
+    assert_int_equal(count, 1);
+    strcpy(labels[0], "a");
+    g_ptr_array_set_size(loaded, 2);
+
+    /* Declined: INSERT statements instead */
+    load_enabled = false;
+    assert_int_equal(SQLBulkOperations(stmt, SQL_ADD), SQL_SUCCESS);
+    assert_int_equal(loaded->len, 2);
+    assert_int_equal(inserts->len, 1);
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: an INSERT parameter array in one bulk call ────────── */
+
+static void test_bulk_insert_params(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_fake("BACKEND=fakeload;HOST=localhost");
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    assert_int_equal(SQLPrepare(stmt, (SQLCHAR *)"INSERT INTO db.t (id, "
+                                "\"label\") VALUES (?, ?)", SQL_NTS),
+                     SQL_SUCCESS);
+
+    SQLBIGINT ids[3] = { 1, 2, 3 };
+    char labels[3][16] = { "a", "", "boom" };
+    SQLLEN label_ind[3] = { SQL_NTS, SQL_NULL_DATA, SQL_NTS };
+    SQLUSMALLINT status[3] = { 0, 0, 0 };
+    SQLULEN processed = 0;
+    SQLSetStmtAttr(stmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)3, 0);
+    SQLSetStmtAttr(stmt, SQL_ATTR_PARAM_STATUS_PTR, status, 0);
+    SQLSetStmtAttr(stmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0);
+    SQLBindParameter(stmt, 1, SQL_PARAM_INPUT, SQL_C_SBIGINT, SQL_BIGINT,
+                     19, 0, ids, 0, NULL);
+    SQLBindParameter(stmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                     16, 0, labels, sizeof(labels[0]), label_ind);
+
+    load_enabled = true;
+    assert_int_equal(SQLExecute(stmt), SQL_SUCCESS_WITH_INFO);
+    assert_int_equal(inserts->len, 0);
+    assert_int_equal(loaded->len, 3);
+    assert_string_equal(load_table, "db.t");
+    assert_string_equal(load_cols, "id,label");
+    assert_string_equal(g_ptr_array_index(loaded, 0), "1|a");
+    assert_string_equal(g_ptr_array_index(loaded, 1), "2|\\N");
+    assert_int_equal(status[0], SQL_PARAM_SUCCESS);
+    assert_int_equal(status[1], SQL_PARAM_SUCCESS);
+    assert_int_equal(status[2], SQL_PARAM_ERROR);
+    assert_int_equal(processed, 3);
+    SQLLEN count = 0;
+    SQLRowCount(stmt, &count);
+    assert_int_equal(count, 2);
+
+    /* Some skipped: no row is known to be in */
+    strcpy(labels[2], "skip");
+    g_ptr_array_set_size(loaded, 0);
+    assert_int_equal(SQLExecute(stmt), SQL_SUCCESS_WITH_INFO);
+    for (int i = 0; i < 3; i++)
+        assert_int_equal(status[i], SQL_PARAM_DIAG_UNAVAILABLE);
+    SQLRowCount(stmt, &count);
+    assert_int_equal(count, 2);
+
+    /* All skipped: all failed */
+    strcpy(labels[0], "skip");
+    label_ind[1] = SQL_NTS;
+    strcpy(labels[1], "skip");
+    assert_int_equal(SQLExecute(stmt), SQL_ERROR);
+    for (int i = 0; i < 3; i++)
+        assert_int_equal(status[i], SQL_PARAM_ERROR);
+    SQLRowCount(stmt, &count);
+    assert_int_equal(count, 0);
+    strcpy(labels[0], "a");
+    label_ind[1] = SQL_NULL_DATA;
+    strcpy(labels[2], "boom");
+
+    /* Declined: one statement per row, as without a bulk path */
+    load_enabled = false;
+    g_ptr_array_set_size(loaded, 0);
+    assert_int_equal(SQLExecute(stmt), SQL_SUCCESS_WITH_INFO);
+    assert_int_equal(loaded->len, 0);
+    assert_int_equal(inserts->len, 3);
+    assert_int_equal(status[2], SQL_PARAM_ERROR);
+
+    /* Anything but plain markers in VALUES is not a bulk insert */
+    load_enabled = true;
+    g_ptr_array_set_size(inserts, 0);
+    assert_int_equal(SQLPrepare(stmt, (SQLCHAR *)"INSERT INTO t VALUES "
+                                "(?, UPPER(?))", SQL_NTS),
+                     SQL_SUCCESS);
+    SQLExecute(stmt);
+    assert_int_equal(loaded->len, 0);
+    assert_int_equal(inserts->len, 3);
+
+    /* Without a column list the rows go in the table's column order */
+    label_ind[2] = SQL_NTS;
+    strcpy(labels[2], "c");
+    assert_int_equal(SQLPrepare(stmt, (SQLCHAR *)"INSERT INTO t VALUES "
+                                "(?, ?)", SQL_NTS),
+                     SQL_SUCCESS);
+    assert_int_equal(SQLExecute(stmt), SQL_SUCCESS);
+    assert_int_equal(loaded->len, 3);
+    assert_string_equal(load_cols, ",");
+
+    load_enabled = false;
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_bulk_add_column_wise),
+        cmocka_unit_test(test_bulk_add_row_wise),
+        cmocka_unit_test(test_bulk_add_target),
+        cmocka_unit_test(test_bulk_add_native),
+        cmocka_unit_test(test_bulk_insert_params),
+    };
+    return cmocka_run_group_tests(tests, setup_fakes, teardown);
+}
@@ -0,0 +1,286 @@
+/*
+ * Unit tests for cooperative cancellation (src/odbc/cancel.c): the token
+ * itself, and SQLCancel / SQL_ATTR_QUERY_TIMEOUT interrupting statements
+ * that BACKEND=synthetic keeps busy with execlatency / latency.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include "argus/cancel.h"
+#include "argus/handle.h"
+#include "argus/odbc_api.h"
+#include "synthetic_dbc.h"
+
+/* Long enough that a test only passes if the wait was cut short */
+#define BUSY_SQL    "SYNTHETIC rows=10 execlatency=30000"
+
+/* ── Helpers ─────────────────────────────────────────────────── */
+
+static void assert_sqlstate(SQLHSTMT stmt, const char *expected)
+{
+    SQLCHAR state_buf[6] = "", msg[256];
+    SQLINTEGER native = 0;
+    SQLGetDiagRec(SQL_HANDLE_STMT, stmt, 1, state_buf, &native, msg,
+                  sizeof(msg), NULL);
+    assert_string_equal((char *)state_buf, expected);
+}
+
+static double elapsed_ms(gint64 since)
+{
+    return (double)(g_get_monotonic_time() - since) / 1000.0;
+}
+
+/* ── Test: the token ─────────────────────────────────────────── */
+
+static void on_abort(void *data)
+{
+    g_atomic_int_inc((gint *)data);
+}
+
+static void test_token(void **state)
+{
+    (void)state;
+    argus_cancel_t c;
+    argus_cancel_init(&c);
+
+    /* Nothing in progress: a request is a no-op */
+    assert_false(argus_cancel_request(&c));
+    assert_false(argus_cancel_requested(&c));
+    assert_int_equal(argus_cancel_remaining_ms(&c), -1);
+
+    /* A request runs the registered abort action once */
+    gint aborted = 0;
+    argus_cancel_begin(&c, 0);
+    assert_true(argus_cancel_push(&c, on_abort, &aborted));
+    assert_true(argus_cancel_request(&c));
+    assert_true(argus_cancel_requested(&c));
+    assert_false(argus_cancel_timed_out(&c));
+    assert_int_equal(aborted, 1);
+    argus_cancel_pop(&c);
+
+    /* Once requested, no new blocking call is started */
+    assert_false(argus_cancel_push(&c, on_abort, &aborted));
+    argus_cancel_end(&c);
+    assert_false(argus_cancel_requested(&c));
+
+    /* A passed deadline counts as a request */
+    argus_cancel_begin(&c, 1);
+    assert_true(argus_cancel_remaining_ms(&c) > 0);
+    g_usleep(1100 * 1000);
+    assert_true(argus_cancel_requested(&c));
+    assert_true(argus_cancel_timed_out(&c));
+    assert_int_equal(argus_cancel_remaining_ms(&c), 0);
+    argus_cancel_end(&c);
+
+    /* The binding is per thread, and NULL shields a call */
+    assert_null(argus_cancel_current());
+    argus_cancel_t *prev = argus_cancel_enter(&c);
+    assert_ptr_equal(argus_cancel_current(), &c);
+    argus_cancel_t *outer = argus_cancel_enter(NULL);
+    assert_null(argus_cancel_current());
+    argus_cancel_leave(outer);
+    argus_cancel_leave(prev);
+    assert_null(argus_cancel_current());
+    assert_false(argus_cancel_requested(NULL));
+
+    argus_cancel_clear(&c);
+}
+
+/* ── Test: the deadline runs the abort action by itself ──────── */
+
+static void test_token_deadline(void **state)
+{
+    (void)state;
+    argus_cancel_t c;
+    argus_cancel_init(&c);
+
+    /* Nobody calls argus_cancel_request: the executor timer does, so a
+     * call blocked where it cannot poll is interrupted on timeout too */
+    gint aborted = 0;
+    argus_cancel_begin(&c, 1);
+    assert_true(argus_cancel_push(&c, on_abort, &aborted));
+    gint64 start = g_get_monotonic_time();
+    while (!g_atomic_int_get(&aborted) && elapsed_ms(start) < 5000)
+        g_usleep(10 * 1000);
+    assert_int_equal(g_atomic_int_get(&aborted), 1);
+    assert_true(elapsed_ms(start) >= 900);
+    assert_true(argus_cancel_timed_out(&c));
+    argus_cancel_pop(&c);
+    argus_cancel_end(&c);
+
+    /* Disarmed in time: the timer finds nothing to cancel, even once the
+     * token itself is gone */
+    aborted = 0;
+    argus_cancel_begin(&c, 1);
+    assert_true(argus_cancel_push(&c, on_abort, &aborted));
+    argus_cancel_pop(&c);
+    argus_cancel_end(&c);
+    argus_cancel_clear(&c);
+    g_usleep(1300 * 1000);
+    assert_int_equal(g_atomic_int_get(&aborted), 0);
+}
+
+/* ── Test: a slow abort action holds up only argus_cancel_pop ── */
+
+typedef struct {
+    argus_cancel_t *c;
+    volatile gint   started;
+    volatile gint   finished;
+} slow_abort_t;
+
+static void on_slow_abort(void *data)
+{
+    slow_abort_t *sa = (slow_abort_t *)data;
+    g_atomic_int_set(&sa->started, 1);
+    g_usleep(300 * 1000);
+    g_atomic_int_set(&sa->finished, 1);
+}
+
+static gpointer request_cancel(gpointer data)
+{
+    argus_cancel_request(((slow_abort_t *)data)->c);
+    return NULL;
+}
+
+static void test_token_slow_abort(void **state)
+{
+    (void)state;
+    argus_cancel_t c;
+    argus_cancel_init(&c);
+    slow_abort_t sa = { .c = &c };
+
+    argus_cancel_begin(&c, 60);
+    assert_true(argus_cancel_push(&c, on_slow_abort, &sa));
+    GThread *t = g_thread_new("cancel-test", request_cancel, &sa);
+    while (!g_atomic_int_get(&sa.started))
+        g_usleep(1000);
+
+    /* The checks a curl progress callback makes do not wait for it */
+    gint64 start = g_get_monotonic_time();
+    assert_true(argus_cancel_requested(&c));
+    assert_false(argus_cancel_timed_out(&c));
+    assert_true(argus_cancel_remaining_ms(&c) > 0);
+    assert_true(elapsed_ms(start) < 100);
+    assert_false(g_atomic_int_get(&sa.finished));
+
+    /* pop does, so sa may go out of scope after it */
+    argus_cancel_pop(&c);
+    assert_true(g_atomic_int_get(&sa.finished));
+    g_thread_join(t);
+    argus_cancel_end(&c);
+    argus_cancel_clear(&c);
+}
+
+/* ── Test: SQLCancel from another thread stops a synchronous execute ── */
+
+static gpointer cancel_later(gpointer data)
+{
+    g_usleep(200 * 1000);
+    SQLCancel((SQLHSTMT)data);
+    return NULL;
+}
+
+static void test_cancel_sync_execute(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(NULL);
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+
+    GThread *canceller = g_thread_new("test-cancel", cancel_later, stmt);
+    gint64 start = g_get_monotonic_time();
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)BUSY_SQL, SQL_NTS),
+                     SQL_ERROR);
+    assert_true(elapsed_ms(start) < 5000);
+    g_thread_join(canceller);
+    assert_sqlstate(stmt, "HY008");
+
+    /* The statement is usable again */
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)"SYNTHETIC rows=3",
+                                   SQL_NTS),
+                     SQL_SUCCESS);
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: SQLCancel frees an asynchronous execute's worker ──── */
+
+static void test_cancel_async_execute(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(NULL);
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    SQLSetStmtAttr(stmt, SQL_ATTR_ASYNC_ENABLE,
+                   (SQLPOINTER)(uintptr_t)SQL_ASYNC_ENABLE_ON, 0);
+
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)BUSY_SQL, SQL_NTS),
+                     SQL_STILL_EXECUTING);
+    g_usleep(50 * 1000);
+
+    gint64 start = g_get_monotonic_time();
+    assert_int_equal(SQLCancel(stmt), SQL_SUCCESS);
+    assert_true(elapsed_ms(start) < 5000);
+
+    /* Freeing a statement whose execute is in flight cancels it too */
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)BUSY_SQL, SQL_NTS),
+                     SQL_STILL_EXECUTING);
+    start = g_get_monotonic_time();
+    assert_int_equal(SQLFreeHandle(SQL_HANDLE_STMT, stmt), SQL_SUCCESS);
+    assert_true(elapsed_ms(start) < 5000);
+
+    free_dbc(dbc);
+}
+
+/* ── Test: SQL_ATTR_QUERY_TIMEOUT ends execute and fetch ─────── */
+
+static void test_query_timeout(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(NULL);
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    SQLSetStmtAttr(stmt, SQL_ATTR_QUERY_TIMEOUT, (SQLPOINTER)(uintptr_t)1, 0);
+
+    gint64 start = g_get_monotonic_time();
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)BUSY_SQL, SQL_NTS),
+                     SQL_ERROR);
+    double ms = elapsed_ms(start);
+    assert_true(ms >= 900 && ms < 5000);
+    assert_sqlstate(stmt, "HYT00");
+
+    /* Each fetch gets the timeout too */
+    assert_int_equal(SQLExecDirect(stmt,
+                                   (SQLCHAR *)"SYNTHETIC rows=10 latency=30000",
+                                   SQL_NTS),
+                     SQL_SUCCESS);
+    start = g_get_monotonic_time();
+    assert_int_equal(SQLFetch(stmt), SQL_ERROR);
+    assert_true(elapsed_ms(start) < 5000);
+    assert_sqlstate(stmt, "HYT00");
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_token),
+        cmocka_unit_test(test_token_deadline),
+        cmocka_unit_test(test_token_slow_abort),
+        cmocka_unit_test(test_cancel_sync_execute),
+        cmocka_unit_test(test_cancel_async_execute),
+        cmocka_unit_test(test_query_timeout),
+    };
+    return cmocka_run_group_tests(tests, setup, NULL);
+}
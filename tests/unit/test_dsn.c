@@ -41,6 +41,8 @@ static const char *INI_CONTENT =
     "ConnectTimeout = 7\n"
     "QueryTimeout = 33\n"
     "FetchBufferSize = 1234\n"
+    "AdaptiveFetch = no\n"
+    "FetchMaxRows = 5000\n"
     "MaxScrollRows = 777\n"
     "LogLevel = 4\n"
     "Project = my-gcp\n"
@@ -101,6 +103,8 @@ static void test_resolve_known_dsn(void **state)
     assert_int_equal(d->connect_timeout_sec, 7);
     assert_int_equal(d->query_timeout_sec, 33);
     assert_int_equal(d->fetch_buffer_size, 1234);
+    assert_false(d->adaptive_fetch);
+    assert_int_equal(d->fetch_max_rows, 5000);
     assert_int_equal(d->max_scroll_rows, 777);
     assert_int_equal(d->log_level, 4);
     assert_string_equal(d->bq_project, "my-gcp");
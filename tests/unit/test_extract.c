@@ -0,0 +1,622 @@
+/*
+ * Unit tests for the direct-to-file extract (src/odbc/extract.c and
+ * extract_writer.c), driven through BACKEND=synthetic. The Arrow and Parquet
+ * files are read back by the small decoders below (flatbuffer tables, thrift
+ * compact structs) and compared with the same query fetched through ODBC.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib.h>
+#include "argus/handle.h"
+#include "argus/odbc_api.h"
+#include "synthetic_dbc.h"
+
+#define ROWS        5000
+#define QUERY       "SYNTHETIC rows=5000 cols=varchar,bigint,double " \
+                    "strlen=4-40 nulls=5%"
+
+/* ── Helpers ─────────────────────────────────────────────────── */
+
+static char *temp_path(const char *ext)
+{
+    return g_strdup_printf("%s/argus-extract-%d.%s", g_get_tmp_dir(),
+                           (int)getpid(), ext);
+}
+
+static SQLHSTMT extract_stmt(argus_dbc_t *dbc, const char *path,
+                             SQLULEN compression)
+{
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    assert_int_equal(SQLSetStmtAttr(stmt, ARGUS_ATTR_EXTRACT_PATH,
+                                    (SQLPOINTER)path, SQL_NTS),
+                     SQL_SUCCESS);
+    /* Several row groups / record batches */
+    SQLSetStmtAttr(stmt, ARGUS_ATTR_EXTRACT_ROW_GROUP, (SQLPOINTER)1500, 0);
+    SQLSetStmtAttr(stmt, ARGUS_ATTR_EXTRACT_COMPRESSION,
+                   (SQLPOINTER)(uintptr_t)compression, 0);
+    return stmt;
+}
+
+/* Run the extract and check what it reports against the file */
+static gchar *run_extract(argus_dbc_t *dbc, const char *path,
+                          SQLULEN compression, SQLLEN expect_rows,
+                          gsize *len)
+{
+    SQLHSTMT stmt = extract_stmt(dbc, path, compression);
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)QUERY, SQL_NTS),
+                     SQL_SUCCESS);
+
+    SQLLEN rows = 0;
+    assert_int_equal(SQLRowCount(stmt, &rows), SQL_SUCCESS);
+    assert_int_equal(rows, expect_rows);
+    SQLULEN written = 0, bytes = 0;
+    SQLGetStmtAttr(stmt, ARGUS_ATTR_EXTRACT_ROWS, &written, 0, NULL);
+    SQLGetStmtAttr(stmt, ARGUS_ATTR_EXTRACT_BYTES, &bytes, 0, NULL);
+    assert_int_equal(written, (SQLULEN)expect_rows);
+    double rate = 0;
+    SQLGetStmtAttr(stmt, ARGUS_ATTR_EXTRACT_ROWS_PER_SEC, &rate, 0, NULL);
+    assert_true(rate > 0);
+
+    /* The result went to the file */
+    assert_int_equal(SQLFetch(stmt), SQL_NO_DATA);
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+
+    gchar *data = NULL;
+    assert_true(g_file_get_contents(path, &data, len, NULL));
+    assert_int_equal(*len, bytes);
+    return data;
+}
+
+/* ── The query as ODBC returns it ────────────────────────────── */
+
+/* c1 varchar, c2 bigint, c3 double */
+typedef struct {
+    char   *str[ROWS];
+    gint64  i64[ROWS];
+    double  f64[ROWS];
+    bool    null[3][ROWS];
+} expected_t;
+
+static expected_t *fetch_expected(argus_dbc_t *dbc)
+{
+    expected_t *e = g_new0(expected_t, 1);
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)QUERY, SQL_NTS),
+                     SQL_SUCCESS);
+    for (int r = 0; r < ROWS; r++) {
+        assert_int_equal(SQLFetch(stmt), SQL_SUCCESS);
+        char buf[64];
+        SQLLEN ind = 0;
+        SQLGetData(stmt, 1, SQL_C_CHAR, buf, sizeof(buf), &ind);
+        e->null[0][r] = ind == SQL_NULL_DATA;
+        e->str[r] = g_strdup(e->null[0][r] ? "" : buf);
+        SQLGetData(stmt, 2, SQL_C_SBIGINT, &e->i64[r], 0, &ind);
+        e->null[1][r] = ind == SQL_NULL_DATA;
+        SQLGetData(stmt, 3, SQL_C_DOUBLE, &e->f64[r], 0, &ind);
+        e->null[2][r] = ind == SQL_NULL_DATA;
+    }
+    assert_int_equal(SQLFetch(stmt), SQL_NO_DATA);
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    return e;
+}
+
+static void free_expected(expected_t *e)
+{
+    for (int r = 0; r < ROWS; r++)
+        g_free(e->str[r]);
+    g_free(e);
+}
+
+/* Check cell (row, col) of a decoded file against the fetched value */
+static void check_cell(const expected_t *e, int row, int col, bool valid,
+                       const void *value, size_t len)
+{
+    assert_true(row < ROWS);
+    assert_int_equal(!valid, e->null[col][row]);
+    if (!valid) return;
+    if (col == 0) {
+        assert_int_equal(len, strlen(e->str[row]));
+        assert_memory_equal(value, e->str[row], len);
+    } else if (col == 1) {
+        gint64 v;
+        memcpy(&v, value, 8);
+        assert_int_equal(GINT64_FROM_LE(v), e->i64[row]);
+    } else {
+        guint64 bits;
+        memcpy(&bits, value, 8);
+        bits = GUINT64_FROM_LE(bits);
+        double v;
+        memcpy(&v, &bits, 8);
+        assert_true(v == e->f64[row]);
+    }
+}
+
+static guint32 rd_u32(const guint8 *p)
+{
+    guint32 v;
+    memcpy(&v, p, 4);
+    return GUINT32_FROM_LE(v);
+}
+
+static gint64 rd_i64(const guint8 *p)
+{
+    gint64 v;
+    memcpy(&v, p, 8);
+    return GINT64_FROM_LE(v);
+}
+
+/* ── Flatbuffers ─────────────────────────────────────────────── */
+
+/* Field `id` of a table, or NULL when absent */
+static const guint8 *fb_field(const guint8 *table, int id)
+{
+    const guint8 *vt = table - (gint32)rd_u32(table);
+    guint16 vt_size, off;
+    memcpy(&vt_size, vt, 2);
+    vt_size = GUINT16_FROM_LE(vt_size);
+    if (4 + 2 * id >= vt_size) return NULL;
+    memcpy(&off, vt + 4 + 2 * id, 2);
+    off = GUINT16_FROM_LE(off);
+    return off ? table + off : NULL;
+}
+
+/* Follow the offset stored in field `id` (table, vector or string) */
+static const guint8 *fb_ref(const guint8 *table, int id)
+{
+    const guint8 *f = fb_field(table, id);
+    assert_non_null(f);
+    return f + rd_u32(f);
+}
+
+static int fb_byte(const guint8 *table, int id)
+{
+    const guint8 *f = fb_field(table, id);
+    return f ? *f : 0;
+}
+
+/* ── Thrift compact protocol ─────────────────────────────────── */
+
+typedef struct {
+    const guint8 *p;
+    const guint8 *end;
+} tcr_t;
+
+static guint64 tcr_varint(tcr_t *r)
+{
+    guint64 v = 0;
+    for (int shift = 0; r->p < r->end; shift += 7) {
+        guint8 b = *r->p++;
+        v |= (guint64)(b & 0x7F) << shift;
+        if (!(b & 0x80)) break;
+    }
+    return v;
+}
+
+static gint64 tcr_int(tcr_t *r)
+{
+    guint64 v = tcr_varint(r);
+    return (gint64)(v >> 1) ^ -(gint64)(v & 1);
+}
+
+/* Next field of the struct being read; false at its end */
+static bool tcr_field(tcr_t *r, int *last, int *id, int *type)
+{
+    assert_true(r->p < r->end);
+    guint8 b = *r->p++;
+    if (b == 0) return false;
+    *type = b & 0x0F;
+    *id = (b >> 4) ? *last + (b >> 4) : (int)tcr_int(r);
+    *last = *id;
+    return true;
+}
+
+static size_t tcr_list(tcr_t *r, int *elem_type)
+{
+    guint8 b = *r->p++;
+    if (elem_type) *elem_type = b & 0x0F;
+    return (b >> 4) == 15 ? (size_t)tcr_varint(r) : (size_t)(b >> 4);
+}
+
+static void tcr_skip(tcr_t *r, int type)
+{
+    int last = 0, id, t;
+    switch (type) {
+    case 1: case 2:                         /* bool in the field header */
+        break;
+    case 3:
+        r->p++;
+        break;
+    case 4: case 5: case 6:
+        tcr_varint(r);
+        break;
+    case 7:
+        r->p += 8;
+        break;
+    case 8:
+        r->p += tcr_varint(r);
+        break;
+    case 9: case 10: {
+        size_t n = tcr_list(r, &t);
+        for (size_t i = 0; i < n; i++)
+            tcr_skip(r, t == 1 || t == 2 ? 3 : t);
+        break;
+    }
+    case 12:
+        while (tcr_field(r, &last, &id, &t))
+            tcr_skip(r, t);
+        break;
+    default:
+        fail_msg("thrift type %d", type);
+    }
+}
+
+/* ── Arrow: the footer and the record batches ──────────────── */
+
+/* Decode the footer schema and every record batch */
+static void check_arrow(const guint8 *file, gsize len, const expected_t *e)
+{
+    /* Footer schema: c1 utf8, c2 int64, c3 double, all nullable */
+    guint32 footer_len = rd_u32(file + len - 10);
+    const guint8 *footer = file + len - 10 - footer_len;
+    footer += rd_u32(footer);
+    const guint8 *fields = fb_ref(fb_ref(footer, 1), 1);
+    assert_int_equal(rd_u32(fields), 3);
+    static const int types[3] = { 5, 2, 3 };   /* Utf8, Int, FloatingPoint */
+    for (int c = 0; c < 3; c++) {
+        const guint8 *f = fields + 4 + 4 * c;
+        f += rd_u32(f);
+        const guint8 *name = fb_ref(f, 0);
+        char expect[4];
+        snprintf(expect, sizeof(expect), "c%d", c + 1);
+        assert_int_equal(rd_u32(name), strlen(expect));
+        assert_memory_equal(name + 4, expect, strlen(expect));
+        assert_int_equal(fb_byte(f, 1), 1);
+        assert_int_equal(fb_byte(f, 2), types[c]);
+        if (c == 1) {
+            const guint8 *type = fb_ref(f, 3);
+            assert_int_equal(rd_u32(fb_field(type, 0)), 64);  /* bitWidth */
+            assert_int_equal(fb_byte(type, 1), 1);            /* is_signed */
+        }
+    }
+
+    /* Record batches: 1500-row groups, every value as ODBC fetched it */
+    const guint8 *blocks = fb_ref(footer, 3);
+    size_t nblocks = rd_u32(blocks);
+    assert_int_equal(nblocks, (ROWS + 1499) / 1500);
+    const guint8 *block_data = blocks + 4;
+    int row = 0;
+    for (size_t i = 0; i < nblocks; i++) {
+        const guint8 *k = block_data + 24 * i;
+        gint64 offset = rd_i64(k);
+        guint32 meta_len = rd_u32(k + 8);
+        const guint8 *msg = file + offset;
+        assert_int_equal(rd_u32(msg), 0xFFFFFFFFU);
+        const guint8 *root = msg + 8 + rd_u32(msg + 8);
+        assert_int_equal(fb_byte(root, 1), 3);          /* RecordBatch */
+        const guint8 *batch = fb_ref(root, 2);
+        gint64 rows = rd_i64(fb_field(batch, 0));
+        assert_int_equal(rows, i + 1 < nblocks ? 1500 : ROWS % 1500);
+        const guint8 *nodes = fb_ref(batch, 1);
+        const guint8 *bufs = fb_ref(batch, 2);
+        assert_int_equal(rd_u32(nodes), 3);
+        assert_int_equal(rd_u32(bufs), 7);
+        nodes += 4;
+        bufs += 4;
+
+        const guint8 *body = msg + meta_len;
+        int b = 0;
+        for (int c = 0; c < 3; c++) {
+            assert_int_equal(rd_i64(nodes + 16 * c), rows);
+            const guint8 *valid = rd_i64(bufs + 16 * b + 8)
+                ? body + rd_i64(bufs + 16 * b) : NULL;
+            b++;
+            const guint8 *offs = NULL;
+            if (c == 0) offs = body + rd_i64(bufs + 16 * b++);
+            const guint8 *values = body + rd_i64(bufs + 16 * b++);
+            gint64 nulls = 0;
+            for (gint64 r = 0; r < rows; r++) {
+                bool ok = !valid || (valid[r / 8] >> (r % 8)) & 1;
+                nulls += !ok;
+                if (offs) {
+                    guint32 start = rd_u32(offs + 4 * r);
+                    check_cell(e, row + (int)r, c, ok, values + start,
+                               rd_u32(offs + 4 * (r + 1)) - start);
+                } else {
+                    check_cell(e, row + (int)r, c, ok, values + 8 * r, 8);
+                }
+            }
+            assert_int_equal(rd_i64(nodes + 16 * c + 8), nulls);
+        }
+        row += (int)rows;
+    }
+    assert_int_equal(row, ROWS);
+}
+
+/* ── Parquet: FileMetaData and the data pages ────────────────── */
+
+/* One uncompressed column chunk: a PLAIN data page after RLE/bit-packed
+ * definition levels */
+static void check_parquet_chunk(const guint8 *chunk, const guint8 *end,
+                                const expected_t *e, int first_row,
+                                gint64 rows, int col)
+{
+    tcr_t r = { chunk, end };
+    int last = 0, id, type;
+    gint64 num_values = -1, page_len = -1;
+    while (tcr_field(&r, &last, &id, &type)) {
+        if (id == 1) {
+            assert_int_equal(tcr_int(&r), 0);           /* DATA_PAGE */
+        } else if (id == 3) {
+            page_len = tcr_int(&r);
+        } else if (id == 5) {
+            int inner = 0;
+            while (tcr_field(&r, &inner, &id, &type)) {
+                if (id == 1) num_values = tcr_int(&r);
+                else tcr_skip(&r, type);
+            }
+        } else {
+            tcr_skip(&r, type);
+        }
+    }
+    assert_int_equal(num_values, rows);
+    const guint8 *page = r.p;
+    const guint8 *page_end = page + page_len;
+    assert_true(page_end <= end);
+
+    /* One bit-packed run of (rows + 7) / 8 groups */
+    guint32 levels_len = rd_u32(page);
+    tcr_t lv = { page + 4, page + 4 + levels_len };
+    assert_int_equal(tcr_varint(&lv), (guint64)(((rows + 7) / 8) << 1 | 1));
+    const guint8 *bits = lv.p;
+    const guint8 *v = page + 4 + levels_len;
+    for (gint64 i = 0; i < rows; i++) {
+        bool ok = (bits[i / 8] >> (i % 8)) & 1;
+        if (!ok) {
+            check_cell(e, first_row + (int)i, col, false, NULL, 0);
+        } else if (col == 0) {
+            guint32 n = rd_u32(v);
+            check_cell(e, first_row + (int)i, col, true, v + 4, n);
+            v += 4 + n;
+        } else {
+            check_cell(e, first_row + (int)i, col, true, v, 8);
+            v += 8;
+        }
+    }
+    assert_ptr_equal(v, page_end);
+}
+
+/* Decode FileMetaData; with the file uncompressed, also every page */
+static void check_parquet(const guint8 *file, gsize len, bool gzip,
+                          const expected_t *e)
+{
+    guint32 meta_len = rd_u32(file + len - 8);
+    tcr_t r = { file + len - 8 - meta_len, file + len - 8 };
+    static const int types[3] = { 6, 2, 5 };   /* BYTE_ARRAY, INT64, DOUBLE */
+    int last = 0, id, type, elem;
+    gint64 num_rows = -1;
+    size_t ngroups = 0;
+    int row = 0;
+
+    while (tcr_field(&r, &last, &id, &type)) {
+        if (id == 2) {
+            /* schema: the root, then one OPTIONAL leaf per column */
+            assert_int_equal(tcr_list(&r, &elem), 4);
+            for (int c = -1; c < 3; c++) {
+                int l = 0, ftype = -1, rep_type = -1;
+                char name[16] = "";
+                while (tcr_field(&r, &l, &id, &type)) {
+                    if (id == 1) ftype = (int)tcr_int(&r);
+                    else if (id == 3) rep_type = (int)tcr_int(&r);
+                    else if (id == 4) {
+                        size_t n = (size_t)tcr_varint(&r);
+                        assert_true(n < sizeof(name));
+                        memcpy(name, r.p, n);
+                        name[n] = '\0';
+                        r.p += n;
+                    } else tcr_skip(&r, type);
+                }
+                if (c < 0) continue;
+                char expect[4];
+                snprintf(expect, sizeof(expect), "c%d", c + 1);
+                assert_string_equal(name, expect);
+                assert_int_equal(ftype, types[c]);
+                assert_int_equal(rep_type, 1);          /* OPTIONAL */
+            }
+        } else if (id == 3) {
+            num_rows = tcr_int(&r);
+        } else if (id == 4) {
+            ngroups = tcr_list(&r, &elem);
+            for (size_t g = 0; g < ngroups; g++) {
+                int lg = 0;
+                gint64 group_rows = -1;
+                gint64 offsets[3] = { -1, -1, -1 };
+                while (tcr_field(&r, &lg, &id, &type)) {
+                    if (id == 3) {
+                        group_rows = tcr_int(&r);
+                    } else if (id == 1) {
+                        assert_int_equal(tcr_list(&r, &elem), 3);
+                        for (int c = 0; c < 3; c++) {
+                            int lc = 0;
+                            while (tcr_field(&r, &lc, &id, &type)) {
+                                if (id != 3) {
+                                    tcr_skip(&r, type);
+                                    continue;
+                                }
+                                /* ColumnMetaData */
+                                int lm = 0;
+                                while (tcr_field(&r, &lm, &id, &type)) {
+                                    if (id == 1)
+                                        assert_int_equal(tcr_int(&r),
+                                                         types[c]);
+                                    else if (id == 4)
+                                        assert_int_equal(tcr_int(&r),
+                                                         gzip ? 2 : 0);
+                                    else if (id == 9)
+                                        offsets[c] = tcr_int(&r);
+                                    else
+                                        tcr_skip(&r, type);
+                                }
+                            }
+                        }
+                    } else {
+                        tcr_skip(&r, type);
+                    }
+                }
+                assert_int_equal(group_rows,
+                                 g + 1 < ngroups ? 1500 : ROWS % 1500);
+                for (int c = 0; c < 3; c++) {
+                    assert_true(offsets[c] >= 4);
+                    if (!gzip)
+                        check_parquet_chunk(file + offsets[c], file + len, e,
+                                            row, group_rows, c);
+                }
+                row += (int)group_rows;
+            }
+        } else {
+            tcr_skip(&r, type);
+        }
+    }
+    assert_int_equal(num_rows, ROWS);
+    assert_int_equal(ngroups, (ROWS + 1499) / 1500);
+    assert_int_equal(row, ROWS);
+}
+
+/* ── Test: each format is written whole ──────────────────────── */
+
+static void test_extract_arrow(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(NULL);
+    char *path = temp_path("arrow");
+    gsize len = 0;
+    gchar *data = run_extract(dbc, path, ARGUS_EXTRACT_COMPRESS_NONE,
+                              ROWS, &len);
+
+    /* File format: magic at both ends */
+    assert_true(len > 12);
+    assert_memory_equal(data, "ARROW1", 6);
+    assert_memory_equal(data + len - 6, "ARROW1", 6);
+
+    expected_t *e = fetch_expected(dbc);
+    check_arrow((const guint8 *)data, len, e);
+    free_expected(e);
+
+    g_free(data);
+    remove(path);
+    g_free(path);
+    free_dbc(dbc);
+}
+
+static void test_extract_parquet(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(NULL);
+    char *path = temp_path("parquet");
+    expected_t *e = fetch_expected(dbc);
+    for (int gzip = 0; gzip <= 1; gzip++) {
+        gsize len = 0;
+        gchar *data = run_extract(dbc, path,
+                                  gzip ? ARGUS_EXTRACT_COMPRESS_GZIP
+                                       : ARGUS_EXTRACT_COMPRESS_NONE,
+                                  ROWS, &len);
+        assert_true(len > 8);
+        assert_memory_equal(data, "PAR1", 4);
+        assert_memory_equal(data + len - 4, "PAR1", 4);
+        check_parquet((const guint8 *)data, len, gzip, e);
+        g_free(data);
+    }
+    free_expected(e);
+    remove(path);
+    g_free(path);
+    free_dbc(dbc);
+}
+
+static void test_extract_csv(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(NULL);
+    char *path = temp_path("csv");
+
+    /* SQL_ATTR_MAX_ROWS bounds the extract */
+    SQLHSTMT stmt = extract_stmt(dbc, path, ARGUS_EXTRACT_COMPRESS_NONE);
+    SQLSetStmtAttr(stmt, SQL_ATTR_MAX_ROWS, (SQLPOINTER)100, 0);
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)QUERY, SQL_NTS),
+                     SQL_SUCCESS);
+    SQLLEN rows = 0;
+    SQLRowCount(stmt, &rows);
+    assert_int_equal(rows, 100);
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+
+    gchar *data = NULL;
+    gsize len = 0;
+    assert_true(g_file_get_contents(path, &data, &len, NULL));
+    size_t lines = 0;
+    for (gsize i = 0; i < len; i++)
+        if (data[i] == '\n') lines++;
+    assert_int_equal(lines, 101);       /* header + rows */
+    g_free(data);
+
+    remove(path);
+    g_free(path);
+    free_dbc(dbc);
+}
+
+/* ── Test: what cannot be written fails before the query ends ── */
+
+static void test_extract_errors(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(NULL);
+    char *path = temp_path("arrow");
+
+    /* Arrow IPC has no GZIP codec */
+    SQLHSTMT stmt = extract_stmt(dbc, path, ARGUS_EXTRACT_COMPRESS_GZIP);
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)QUERY, SQL_NTS),
+                     SQL_ERROR);
+    SQLCHAR sqlstate[6] = "", msg[256] = "";
+    SQLINTEGER native = 0;
+    SQLGetDiagRec(SQL_HANDLE_STMT, stmt, 1, sqlstate, &native, msg,
+                  sizeof(msg), NULL);
+    assert_string_equal((char *)sqlstate, "HYC00");
+    assert_false(g_file_test(path, G_FILE_TEST_EXISTS));
+
+    assert_int_equal(SQLSetStmtAttr(stmt, ARGUS_ATTR_EXTRACT_FORMAT,
+                                    (SQLPOINTER)99, 0),
+                     SQL_ERROR);
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+
+    /* A directory that does not exist */
+    stmt = extract_stmt(dbc, "/nonexistent-argus-dir/out.parquet",
+                        ARGUS_EXTRACT_COMPRESS_NONE);
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)QUERY, SQL_NTS),
+                     SQL_ERROR);
+    SQLGetDiagRec(SQL_HANDLE_STMT, stmt, 1, sqlstate, &native, msg,
+                  sizeof(msg), NULL);
+    assert_string_equal((char *)sqlstate, "HY000");
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+
+    g_free(path);
+    free_dbc(dbc);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_extract_arrow),
+        cmocka_unit_test(test_extract_parquet),
+        cmocka_unit_test(test_extract_csv),
+        cmocka_unit_test(test_extract_errors),
+    };
+    return cmocka_run_group_tests(tests, setup, NULL);
+}
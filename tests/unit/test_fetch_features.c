@@ -1,6 +1,7 @@
 /*
  * Unit tests for fetch-related features: max_rows, row_status_ptr,
- * stubs (SQLSetPos, SQLBulkOperations, SQLSetScrollOptions, SQLDescribeParam).
+ * stubs (SQLSetPos, SQLSetScrollOptions, SQLDescribeParam) and the
+ * SQLBulkOperations argument checks (SQL_ADD itself is in test_bulk_add.c).
  */
 #include <stdarg.h>
 #include <stddef.h>
@@ -71,15 +72,16 @@ static void test_setpos_refresh(void **state)
 
     /* Build a 3-row static scroll cache. */
     const char *vals[3] = { "alpha", "beta", "gamma" };
-    stmt->scroll_rows = calloc(3, sizeof(argus_row_t));
+    stmt->scroll_store = argus_scroll_store_new(1, 1024 * 1024, false);
     for (int i = 0; i < 3; i++) {
-        stmt->scroll_rows[i].cells = calloc(1, sizeof(argus_cell_t));
-        stmt->scroll_rows[i].cells[0].data = strdup(vals[i]);
-        stmt->scroll_rows[i].cells[0].data_len = strlen(vals[i]);
-        stmt->scroll_rows[i].cells[0].is_null = false;
+        argus_cell_t cell = { .data = (char *)vals[i],
+                              .data_len = strlen(vals[i]) };
+        argus_row_t row = { .cells = &cell };
+        assert_int_equal(argus_scroll_store_append(stmt->scroll_store, &row),
+                         0);
     }
-    stmt->scroll_row_count = 3;
     stmt->scroll_cached = true;
+    stmt->scroll_complete = true;
     stmt->scroll_rowset_start = 0;
     stmt->scroll_position = 3;     /* a rowset covering all three rows */
     stmt->row_array_size = 3;
@@ -118,7 +120,7 @@ static void test_setpos_refresh(void **state)
     argus_free_env(env);
 }
 
-/* ── Test: SQLBulkOperations returns HYC00 ──────────────────── */
+/* ── Test: SQLBulkOperations rejects what it cannot do ───────── */
 
 static void test_bulkops_stub(void **state)
 {
@@ -129,9 +131,22 @@ static void test_bulkops_stub(void **state)
     argus_stmt_t *stmt = NULL;
     argus_alloc_stmt(dbc, &stmt);
 
+    /* SQL_ADD needs a backend and a result set */
     SQLRETURN ret = SQLBulkOperations((SQLHSTMT)stmt, SQL_ADD);
     assert_int_equal(ret, SQL_ERROR);
 
+    /* No bookmarks, so no bookmark operations */
+    ret = SQLBulkOperations((SQLHSTMT)stmt, SQL_UPDATE_BY_BOOKMARK);
+    assert_int_equal(ret, SQL_ERROR);
+    assert_string_equal(argus_diag_sqlstate(&stmt->diag), "HYC00");
+    ret = SQLBulkOperations((SQLHSTMT)stmt, SQL_FETCH_BY_BOOKMARK);
+    assert_int_equal(ret, SQL_ERROR);
+    assert_string_equal(argus_diag_sqlstate(&stmt->diag), "HYC00");
+
+    ret = SQLBulkOperations((SQLHSTMT)stmt, 99);
+    assert_int_equal(ret, SQL_ERROR);
+    assert_string_equal(argus_diag_sqlstate(&stmt->diag), "HY092");
+
     argus_free_stmt(stmt);
     argus_env_t *env = dbc->env;
     dbc->connected = false;
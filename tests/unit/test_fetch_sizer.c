@@ -0,0 +1,144 @@
+/*
+ * Unit tests for adaptive fetch batch sizing (src/odbc/fetch.c)
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include "argus/handle.h"
+#include "synthetic_dbc.h"
+
+/* ── Helpers ─────────────────────────────────────────────────── */
+
+/* Read the whole result; returns the rows and the backend batches used,
+ * and leaves the statement's last requested batch size in *last_rows */
+static long run(argus_dbc_t *dbc, const char *sql, unsigned long *batches,
+                int *last_rows)
+{
+    SQLHSTMT hstmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &hstmt);
+    assert_int_equal(SQLExecDirect(hstmt, (SQLCHAR *)sql, SQL_NTS),
+                     SQL_SUCCESS);
+    long rows = 0;
+    while (SQLFetch(hstmt) == SQL_SUCCESS)
+        rows++;
+    argus_stmt_t *stmt = (argus_stmt_t *)hstmt;
+    if (batches) *batches = stmt->timing.batches;
+    if (last_rows) *last_rows = stmt->fetch_sizer.rows;
+    SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+    return rows;
+}
+
+/* ── Test: narrow rows grow to the byte budget ───────────────── */
+
+static void test_sizer_grows(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(NULL);
+    dbc->fetch_buffer_size = 100;
+
+    argus_fetch_sizer_t fs;
+    argus_fetch_sizer_init(&fs, dbc);
+    assert_int_equal(fs.rows, 100);
+
+    /* 100 bytes and 1us per row: at most doubling per batch */
+    argus_fetch_sizer_observe(&fs, dbc, 100, 100 * 100, -1);
+    assert_int_equal(fs.rows, 200);
+    argus_fetch_sizer_observe(&fs, dbc, 200, 200 * 100, 200);
+    assert_int_equal(fs.rows, 400);
+
+    for (int i = 0; i < 20; i++)
+        argus_fetch_sizer_observe(&fs, dbc, (size_t)fs.rows,
+                                  (size_t)fs.rows * 100, fs.rows);
+    assert_int_equal(fs.rows,
+                     (int)(ARGUS_DEFAULT_FETCH_TARGET_BYTES / 100));
+
+    free_dbc(dbc);
+}
+
+/* ── Test: wide rows and slow servers shrink the request ─────── */
+
+static void test_sizer_shrinks(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc(NULL);
+
+    argus_fetch_sizer_t fs;
+    argus_fetch_sizer_init(&fs, dbc);
+    assert_int_equal(fs.rows, ARGUS_DEFAULT_BATCH_SIZE);
+
+    /* 1MB rows: a thousand of them is a gigabyte, over budget at once */
+    argus_fetch_sizer_observe(&fs, dbc, 1000, (size_t)1000 << 20, -1);
+    assert_int_equal(fs.rows, ARGUS_DEFAULT_FETCH_MIN_ROWS);
+
+    /* 1ms per narrow row: FETCHTARGETMS worth of rows */
+    argus_fetch_sizer_init(&fs, dbc);
+    argus_fetch_sizer_observe(&fs, dbc, 1000, 1000 * 50, 1000 * 1000);
+    assert_int_equal(fs.rows, ARGUS_DEFAULT_FETCH_TARGET_MS);
+
+    /* FETCHMAXROWS and FETCHMINROWS widen to include the start */
+    dbc->fetch_max_rows = 300;
+    argus_fetch_sizer_init(&fs, dbc);
+    argus_fetch_sizer_observe(&fs, dbc, 1000, 1000 * 10, 1000);
+    assert_int_equal(fs.rows, 1000);
+    dbc->fetch_buffer_size = 10;
+    argus_fetch_sizer_init(&fs, dbc);
+    assert_int_equal(fs.min_rows, 10);
+    argus_fetch_sizer_observe(&fs, dbc, 10, (size_t)10 << 20, -1);
+    assert_int_equal(fs.rows, 10);
+
+    /* ADAPTIVEFETCH=0: the configured size throughout */
+    dbc->adaptive_fetch = false;
+    argus_fetch_sizer_init(&fs, dbc);
+    argus_fetch_sizer_observe(&fs, dbc, 10, (size_t)10 << 20, 1000000);
+    assert_int_equal(fs.rows, 10);
+
+    free_dbc(dbc);
+}
+
+/* ── Test: a synthetic extract takes few round trips ─────────── */
+
+static void test_sizer_synthetic(void **state)
+{
+    (void)state;
+    const char *narrow = "SYNTHETIC rows=200000 cols=bigint";
+    unsigned long batches = 0;
+
+    argus_dbc_t *dbc = connect_dbc("FETCHBUFFERSIZE=100;ADAPTIVEFETCH=0");
+    assert_int_equal(run(dbc, narrow, &batches, NULL), 200000);
+    assert_true(batches >= 2000);
+    free_dbc(dbc);
+
+    dbc = connect_dbc("FETCHBUFFERSIZE=100");
+    assert_int_equal(run(dbc, narrow, &batches, NULL), 200000);
+    assert_true(batches < 40);
+    free_dbc(dbc);
+
+    /* 4KB rows against a 64KB budget: down to the minimum after the first
+     * batch */
+    int last = 0;
+    dbc = connect_dbc("FETCHTARGETBYTES=65536");
+    assert_int_equal(run(dbc, "SYNTHETIC rows=3000 cols=varchar strlen=4000",
+                         &batches, &last), 3000);
+    assert_int_equal(last, ARGUS_DEFAULT_FETCH_MIN_ROWS);
+    /* 1000, then 100 at a time */
+    assert_true(batches >= 21 && batches <= 22);
+    free_dbc(dbc);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_sizer_grows),
+        cmocka_unit_test(test_sizer_shrinks),
+        cmocka_unit_test(test_sizer_synthetic),
+    };
+    return cmocka_run_group_tests(tests, setup, NULL);
+}
@@ -0,0 +1,291 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hive_arrow.h"
+
+/*
+ * One Arrow IPC stream (Schema + one RecordBatch of 3 rows), written by
+ * pyarrow's RecordBatchStreamWriter:
+ *
+ *   id int32      [1, NULL, -3]
+ *   big int64     [2^40, 5, NULL]
+ *   amount double [1.5, NULL, -2.25]
+ *   name utf8     ["hello", NULL, "wörld"]
+ *   flag bool     [true, false, NULL]
+ *   price decimal128(10,2) [123.45, -0.05, NULL]
+ *   day date32    [2024-02-29, 1969-12-31, NULL]
+ *   ts timestamp[us] [2024-01-02 03:04:05.123, 1960-06-01 00:00:00, NULL]
+ *   raw binary    [01ab, "", NULL]
+ */
+static const uint8_t k_stream[] = {
+    0xff, 0xff, 0xff, 0xff, 0xf8, 0x01, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x0a, 0x00, 0x0c, 0x00, 0x06, 0x00, 0x05, 0x00, 0x08, 0x00,
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x01, 0x04, 0x00, 0x0c, 0x00, 0x00, 0x00,
+    0x08, 0x00, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x94, 0x01, 0x00, 0x00,
+    0x54, 0x01, 0x00, 0x00, 0x1c, 0x01, 0x00, 0x00, 0xec, 0x00, 0x00, 0x00,
+    0xc0, 0x00, 0x00, 0x00, 0x84, 0x00, 0x00, 0x00, 0x58, 0x00, 0x00, 0x00,
+    0x2c, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0xa0, 0xfe, 0xff, 0xff,
+    0x00, 0x00, 0x01, 0x04, 0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x72, 0x61, 0x77, 0x00, 0x28, 0xff, 0xff, 0xff, 0xc4, 0xfe, 0xff, 0xff,
+    0x00, 0x00, 0x01, 0x0a, 0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x74, 0x73, 0x00, 0x00, 0x1e, 0xff, 0xff, 0xff, 0x00, 0x00, 0x02, 0x00,
+    0xec, 0xfe, 0xff, 0xff, 0x00, 0x00, 0x01, 0x08, 0x10, 0x00, 0x00, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x64, 0x61, 0x79, 0x00, 0x46, 0xff, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x14, 0xff, 0xff, 0xff, 0x00, 0x00, 0x01, 0x07,
+    0x10, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x70, 0x72, 0x69, 0x63,
+    0x65, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x04, 0x00, 0x08, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x4c, 0xff, 0xff, 0xff, 0x00, 0x00, 0x01, 0x06, 0x10, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x66, 0x6c, 0x61, 0x67, 0x00, 0x00, 0x00, 0x00,
+    0xd8, 0xff, 0xff, 0xff, 0x74, 0xff, 0xff, 0xff, 0x00, 0x00, 0x01, 0x05,
+    0x10, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x6e, 0x61, 0x6d, 0x65,
+    0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0xa0, 0xff, 0xff, 0xff, 0x00, 0x00, 0x01, 0x03, 0x10, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x61, 0x6d, 0x6f, 0x75, 0x6e, 0x74, 0x00, 0x00,
+    0x00, 0x00, 0x06, 0x00, 0x08, 0x00, 0x06, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x02, 0x00, 0xd4, 0xff, 0xff, 0xff, 0x00, 0x00, 0x01, 0x02,
+    0x10, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x62, 0x69, 0x67, 0x00,
+    0xc4, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x01, 0x40, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x14, 0x00, 0x08, 0x00, 0x06, 0x00, 0x07, 0x00, 0x0c, 0x00,
+    0x00, 0x00, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02,
+    0x10, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x69, 0x64, 0x00, 0x00,
+    0x08, 0x00, 0x0c, 0x00, 0x08, 0x00, 0x07, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x20, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+    0x28, 0x02, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0c, 0x00, 0x16, 0x00, 0x06, 0x00, 0x05, 0x00, 0x08, 0x00, 0x0c, 0x00,
+    0x0c, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x20, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x00,
+    0x18, 0x00, 0x0c, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0a, 0x00, 0x00, 0x00,
+    0x5c, 0x01, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x58, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x98, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xc8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd0, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xe8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x08, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x18, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfd, 0xff, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xf8, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xc0, 0x05, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x68, 0x65, 0x6c, 0x6c,
+    0x6f, 0x77, 0xc3, 0xb6, 0x72, 0x6c, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x39, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x4d, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb8, 0xb3, 0x4f, 0xc0,
+    0xed, 0x0d, 0x06, 0x00, 0x00, 0x20, 0x94, 0xe5, 0xe3, 0xec, 0xfe, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0xab, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const char *text(const argus_row_cache_t *c, size_t r, int col)
+{
+    return c->rows[r].cells[col].data;
+}
+
+/* ── Schema ──────────────────────────────────────────────────── */
+
+static void test_parse_schema(void **state)
+{
+    (void)state;
+    hive_arrow_schema_t schema;
+    char err[256] = "";
+
+    assert_int_equal(hive_arrow_parse_schema(k_stream, sizeof(k_stream),
+                                             &schema, err, sizeof(err)), 0);
+    assert_int_equal(schema.num_fields, 9);
+    assert_int_equal(schema.fields[0].type, HIVE_ARROW_INT);
+    assert_int_equal(schema.fields[0].bit_width, 32);
+    assert_true(schema.fields[0].is_signed);
+    assert_int_equal(schema.fields[3].type, HIVE_ARROW_UTF8);
+    assert_int_equal(schema.fields[3].num_buffers, 3);
+    assert_int_equal(schema.fields[5].type, HIVE_ARROW_DECIMAL);
+    assert_int_equal(schema.fields[5].scale, 2);
+    assert_int_equal(schema.fields[5].bit_width, 128);
+    hive_arrow_schema_free(&schema);
+}
+
+/* ── RecordBatch decoding ────────────────────────────────────── */
+
+static void test_decode_batch(void **state)
+{
+    (void)state;
+    hive_arrow_schema_t schema = {0};
+    argus_row_cache_t cache;
+    char err[256] = "";
+    argus_row_cache_init(&cache);
+
+    /* The stream carries its own schema (cloud-fetch files do). */
+    assert_int_equal(hive_arrow_append_stream(&schema, k_stream,
+                                              sizeof(k_stream), &cache,
+                                              err, sizeof(err)), 0);
+    assert_int_equal(cache.num_rows, 3);
+    assert_int_equal(cache.num_cols, 9);
+
+    /* Integers and doubles are native, no text */
+    const argus_cell_t *id0 = &cache.rows[0].cells[0];
+    assert_int_equal(id0->native_kind, ARGUS_NATIVE_I64);
+    assert_int_equal(id0->native.i64, 1);
+    assert_null(id0->data);
+    assert_true(cache.rows[1].cells[0].is_null);
+    assert_int_equal(cache.rows[2].cells[0].native.i64, -3);
+    assert_int_equal(cache.rows[0].cells[1].native.i64, 1099511627776LL);
+    assert_int_equal(cache.rows[0].cells[2].native_kind, ARGUS_NATIVE_F64);
+    assert_true(cache.rows[2].cells[2].native.f64 == -2.25);
+
+    assert_string_equal(text(&cache, 0, 3), "hello");
+    assert_true(cache.rows[1].cells[3].is_null);
+    assert_string_equal(text(&cache, 2, 3), "w\xc3\xb6rld");
+
+    assert_string_equal(text(&cache, 0, 4), "true");
+    assert_string_equal(text(&cache, 1, 4), "false");
+    assert_true(cache.rows[2].cells[4].is_null);
+
+    assert_string_equal(text(&cache, 0, 5), "123.45");
+    assert_string_equal(text(&cache, 1, 5), "-0.05");
+
+    assert_string_equal(text(&cache, 0, 6), "2024-02-29");
+    assert_string_equal(text(&cache, 1, 6), "1969-12-31");
+
+    assert_string_equal(text(&cache, 0, 7), "2024-01-02 03:04:05.123");
+    assert_string_equal(text(&cache, 1, 7), "1960-06-01 00:00:00");
+
+    /* Binary is hex-encoded like the TColumn path */
+    assert_string_equal(text(&cache, 0, 8), "01ab");
+    assert_int_equal(cache.rows[1].cells[8].data_len, 0);
+    assert_true(cache.rows[2].cells[8].is_null);
+
+    argus_row_cache_free(&cache);
+    hive_arrow_schema_free(&schema);
+}
+
+/* Batches append to rows already in the cache. */
+static void test_decode_appends(void **state)
+{
+    (void)state;
+    hive_arrow_schema_t schema;
+    argus_row_cache_t cache;
+    char err[256] = "";
+    argus_row_cache_init(&cache);
+
+    assert_int_equal(hive_arrow_parse_schema(k_stream, sizeof(k_stream),
+                                             &schema, err, sizeof(err)), 0);
+    assert_int_equal(hive_arrow_append_stream(&schema, k_stream,
+                                              sizeof(k_stream), &cache,
+                                              err, sizeof(err)), 0);
+    assert_int_equal(hive_arrow_append_stream(&schema, k_stream,
+                                              sizeof(k_stream), &cache,
+                                              err, sizeof(err)), 0);
+    assert_int_equal(cache.num_rows, 6);
+    assert_string_equal(text(&cache, 3, 3), "hello");
+
+    argus_row_cache_free(&cache);
+    hive_arrow_schema_free(&schema);
+}
+
+/* ── Malformed input ─────────────────────────────────────────── */
+
+static void test_truncated_stream(void **state)
+{
+    (void)state;
+    hive_arrow_schema_t schema = {0};
+    argus_row_cache_t cache;
+    char err[256] = "";
+    argus_row_cache_init(&cache);
+
+    assert_int_equal(hive_arrow_append_stream(&schema, k_stream,
+                                              sizeof(k_stream) - 64, &cache,
+                                              err, sizeof(err)), -1);
+    assert_true(err[0] != '\0');
+
+    argus_row_cache_free(&cache);
+    hive_arrow_schema_free(&schema);
+}
+
+static void test_empty_stream(void **state)
+{
+    (void)state;
+    hive_arrow_schema_t schema = {0};
+    char err[256] = "";
+
+    assert_int_equal(hive_arrow_parse_schema((const uint8_t *)"\xff\xff\xff\xff"
+                                             "\x00\x00\x00\x00", 8,
+                                             &schema, err, sizeof(err)), -1);
+    assert_int_equal(schema.num_fields, 0);
+}
+
+/* ── Main ─────────────────────────────────────────────────────── */
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_parse_schema),
+        cmocka_unit_test(test_decode_batch),
+        cmocka_unit_test(test_decode_appends),
+        cmocka_unit_test(test_truncated_stream),
+        cmocka_unit_test(test_empty_stream),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
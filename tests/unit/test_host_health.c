@@ -0,0 +1,143 @@
+/*
+ * Unit tests for per-host connect health (host_health.c) and the settings
+ * copy failover race attempts connect with (argus_dbc_clone_config)
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdlib.h>
+#include <string.h>
+#include "argus/handle.h"
+
+static const char *const hosts[] = { "h1", "h2", "h3" };
+static const int ports[] = { 8080, 8080, 8080 };
+
+/* ── Test: without history the list order stands ─────────────── */
+
+static void test_host_health_list_order(void **state)
+{
+    (void)state;
+    argus_host_health_clear();
+
+    int order[3];
+    argus_host_health_order(hosts, ports, 3, order);
+    assert_int_equal(order[0], 0);
+    assert_int_equal(order[1], 1);
+    assert_int_equal(order[2], 2);
+
+    /* A known-good first host keeps its place ahead of unknown ones */
+    argus_host_health_record("h1", 8080, true, 40.0, 30);
+    argus_host_health_order(hosts, ports, 3, order);
+    assert_int_equal(order[0], 0);
+    assert_int_equal(order[1], 1);
+}
+
+/* ── Test: latency and failures reorder the list ─────────────── */
+
+static void test_host_health_latency_bias(void **state)
+{
+    (void)state;
+    argus_host_health_clear();
+
+    argus_host_health_record("h1", 8080, true, 900.0, 30);
+    argus_host_health_record("h2", 8080, true, 50.0, 30);
+    argus_host_health_record("h3", 8080, true, 100.0, 30);
+
+    int order[3];
+    argus_host_health_order(hosts, ports, 3, order);
+    assert_int_equal(order[0], 1);
+    assert_int_equal(order[1], 2);
+    assert_int_equal(order[2], 0);
+
+    /* One failure inflates h2's score past h3's */
+    argus_host_health_record("h2", 8080, false, 0.0, 30);
+    argus_host_health_record("h2", 8080, true, 120.0, 30);
+    argus_host_health_order(hosts, ports, 3, order);
+    assert_int_equal(order[0], 2);
+
+    /* The port is part of the key */
+    assert_false(argus_host_health_is_open("h2", 8443));
+}
+
+/* ── Test: consecutive failures open the breaker ─────────────── */
+
+static void test_host_health_circuit_breaker(void **state)
+{
+    (void)state;
+    argus_host_health_clear();
+
+    argus_host_health_record("h1", 8080, false, 0.0, 30);
+    argus_host_health_record("h1", 8080, false, 0.0, 30);
+    assert_false(argus_host_health_is_open("h1", 8080));
+    argus_host_health_record("h1", 8080, false, 0.0, 30);
+    assert_true(argus_host_health_is_open("h1", 8080));
+
+    /* Open hosts go last, even behind ones that never connected */
+    int order[3];
+    argus_host_health_order(hosts, ports, 3, order);
+    assert_int_equal(order[0], 1);
+    assert_int_equal(order[1], 2);
+    assert_int_equal(order[2], 0);
+
+    /* A success closes it again */
+    argus_host_health_record("h1", 8080, true, 10.0, 30);
+    assert_false(argus_host_health_is_open("h1", 8080));
+
+    /* HOSTCOOLDOWN=0 never opens it */
+    argus_host_health_clear();
+    for (int i = 0; i < 5; i++)
+        argus_host_health_record("h2", 8080, false, 0.0, 0);
+    assert_false(argus_host_health_is_open("h2", 8080));
+    argus_host_health_clear();
+}
+
+/* ── Test: a settings copy owns its strings ──────────────────── */
+
+static void test_dbc_clone_config(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = calloc(1, sizeof(argus_dbc_t));
+    dbc->host = strdup("h1,h2");
+    dbc->username = strdup("alice");
+    dbc->password = strdup("secret");
+    dbc->ssl_ca_file = strdup("/etc/ca.pem");
+    dbc->port = 8443;
+    dbc->ssl_enabled = true;
+    dbc->backend_conn = (argus_backend_conn_t)dbc;
+    argus_diag_push(&dbc->diag, "08001", "earlier failure", 0);
+
+    argus_dbc_t *copy = argus_dbc_clone_config(dbc);
+    assert_non_null(copy);
+    assert_string_equal(copy->username, "alice");
+    assert_ptr_not_equal(copy->username, dbc->username);
+    assert_string_equal(copy->ssl_ca_file, "/etc/ca.pem");
+    assert_null(copy->database);
+    assert_int_equal(copy->port, 8443);
+    assert_true(copy->ssl_enabled);
+    assert_null(copy->backend_conn);
+    assert_int_equal(copy->diag.count, 0);
+
+    /* The copy survives the original */
+    free(dbc->host);
+    free(dbc->username);
+    free(dbc->password);
+    free(dbc->ssl_ca_file);
+    free(dbc);
+    assert_string_equal(copy->password, "secret");
+    argus_dbc_free_config(copy);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_host_health_list_order),
+        cmocka_unit_test(test_host_health_latency_bias),
+        cmocka_unit_test(test_host_health_circuit_breaker),
+        cmocka_unit_test(test_dbc_clone_config),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
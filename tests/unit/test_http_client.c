@@ -0,0 +1,141 @@
+/*
+ * Unit tests for the shared HTTP client layer (http_client.c)
+ *
+ * Requests go to file:// URLs so the handle reuse logic is exercised
+ * without a server.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "http_client.h"
+
+typedef struct {
+    char   data[256];
+    size_t size;
+} sink_t;
+
+static size_t sink_cb(void *ptr, size_t size, size_t nmemb, void *userp)
+{
+    sink_t *sink = (sink_t *)userp;
+    size_t n = size * nmemb;
+    if (sink->size + n >= sizeof(sink->data)) return 0;
+    memcpy(sink->data + sink->size, ptr, n);
+    sink->size += n;
+    sink->data[sink->size] = '\0';
+    return n;
+}
+
+static char g_url[512];
+static char g_path[] = "/tmp/argus_http_XXXXXX";
+
+static int setup(void **state)
+{
+    (void)state;
+    int fd = mkstemp(g_path);
+    if (fd < 0) return -1;
+    if (write(fd, "hello", 5) != 5) {
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    snprintf(g_url, sizeof(g_url), "file://%s", g_path);
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    argus_http_global_init();
+    return 0;
+}
+
+static int teardown(void **state)
+{
+    (void)state;
+    unlink(g_path);
+    argus_http_global_cleanup();
+    curl_global_cleanup();
+    return 0;
+}
+
+/* ── Test: one handle serves consecutive requests ────────────── */
+
+static void test_http_handle_reuse(void **state)
+{
+    (void)state;
+    argus_http_opts_t opts = { .connect_timeout_sec = 5, .timeout_sec = 5 };
+    CURL *curl = argus_http_handle_new(&opts);
+    assert_non_null(curl);
+
+    for (int i = 0; i < 3; i++) {
+        sink_t sink = {0};
+        argus_http_prepare(curl, "GET", g_url, NULL, NULL, sink_cb, &sink);
+        assert_int_equal(curl_easy_perform(curl), CURLE_OK);
+        assert_string_equal(sink.data, "hello");
+    }
+    curl_easy_cleanup(curl);
+}
+
+/* ── Test: per-request options do not leak into the next one ── */
+
+static void test_http_prepare_resets_method(void **state)
+{
+    (void)state;
+    CURL *curl = argus_http_handle_new(NULL);
+    assert_non_null(curl);
+
+    sink_t sink = {0};
+    argus_http_prepare(curl, "HEAD", g_url, NULL, NULL, sink_cb, &sink);
+    assert_int_equal(curl_easy_perform(curl), CURLE_OK);
+    assert_null(strstr(sink.data, "hello"));
+
+    /* A GET after the HEAD gets the body again */
+    memset(&sink, 0, sizeof(sink));
+    argus_http_prepare(curl, "GET", g_url, NULL, NULL, sink_cb, &sink);
+    assert_int_equal(curl_easy_perform(curl), CURLE_OK);
+    assert_string_equal(sink.data, "hello");
+
+    /* No write callback: the body is discarded, not printed */
+    argus_http_prepare(curl, "GET", g_url, NULL, NULL, NULL, NULL);
+    assert_int_equal(curl_easy_perform(curl), CURLE_OK);
+
+    curl_easy_cleanup(curl);
+}
+
+/* ── Test: the share survives handles and can be torn down ───── */
+
+static void test_http_share_lifecycle(void **state)
+{
+    (void)state;
+    /* Idempotent */
+    argus_http_global_init();
+
+    CURL *a = argus_http_easy_init();
+    CURL *b = argus_http_easy_init();
+    assert_non_null(a);
+    assert_non_null(b);
+    sink_t sink = {0};
+    argus_http_prepare(a, "GET", g_url, NULL, NULL, sink_cb, &sink);
+    assert_int_equal(curl_easy_perform(a), CURLE_OK);
+    curl_easy_cleanup(a);
+    curl_easy_cleanup(b);
+
+    argus_http_global_cleanup();
+    /* Handles still work, unshared, without the share */
+    CURL *c = argus_http_easy_init();
+    assert_non_null(c);
+    curl_easy_cleanup(c);
+    argus_http_global_init();
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_http_handle_reuse),
+        cmocka_unit_test(test_http_prepare_resets_method),
+        cmocka_unit_test(test_http_share_lifecycle),
+    };
+    return cmocka_run_group_tests(tests, setup, teardown);
+}
@@ -0,0 +1,220 @@
+/*
+ * Unit tests for the logging system (log.c): formats, the per-thread
+ * queues, the dropped-line accounting and cleanup of the thread states
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib.h>
+#include "argus/log.h"
+
+static char g_path[64];
+
+/* Point the log at a fresh file */
+static void log_to_new_file(void)
+{
+    if (g_path[0]) unlink(g_path);
+    snprintf(g_path, sizeof(g_path), "/tmp/argus_log_XXXXXX");
+    int fd = mkstemp(g_path);
+    assert_true(fd >= 0);
+    close(fd);
+    argus_log_set_file(g_path);
+}
+
+static char *read_log(size_t *len)
+{
+    argus_log_flush();
+    gchar *data = NULL;
+    gsize n = 0;
+    assert_true(g_file_get_contents(g_path, &data, &n, NULL));
+    if (len) *len = n;
+    return data;
+}
+
+static int count_lines(const char *data, const char *needle)
+{
+    int n = 0;
+    for (const char *p = data; (p = strstr(p, needle)) != NULL; p++)
+        n++;
+    return n;
+}
+
+static int setup(void **state)
+{
+    (void)state;
+    argus_log_set_level(ARGUS_LOG_DEBUG);
+    return 0;
+}
+
+static int teardown(void **state)
+{
+    (void)state;
+    argus_log_set_level(ARGUS_LOG_OFF);
+    argus_log_set_format(ARGUS_LOG_FORMAT_TEXT);
+    argus_log_set_file(NULL);
+    unlink(g_path);
+    return 0;
+}
+
+/* ── Test: text lines ────────────────────────────────────────── */
+
+static void test_log_text(void **state)
+{
+    (void)state;
+    log_to_new_file();
+    argus_log_set_format(ARGUS_LOG_FORMAT_TEXT);
+
+    ARGUS_LOG_INFO("hello %d", 42);
+    ARGUS_LOG_DEBUG("second");
+    ARGUS_LOG_TRACE("not logged at DEBUG");
+
+    char *data = read_log(NULL);
+    assert_non_null(strstr(data, "[INFO ] [t"));
+    assert_non_null(strstr(data, "test_log.c:"));
+    assert_non_null(strstr(data, "hello 42\n"));
+    assert_non_null(strstr(data, "second\n"));
+    assert_null(strstr(data, "not logged"));
+    g_free(data);
+}
+
+/* ── Test: JSON lines are escaped ────────────────────────────── */
+
+static void test_log_json(void **state)
+{
+    (void)state;
+    log_to_new_file();
+    assert_int_equal(argus_log_format_from_string("JSON"),
+                     ARGUS_LOG_FORMAT_JSON);
+    assert_int_equal(argus_log_format_from_string("xml"), -1);
+    argus_log_set_format(ARGUS_LOG_FORMAT_JSON);
+
+    ARGUS_LOG_WARN("say \"hi\"\nbye\\");
+
+    char *data = read_log(NULL);
+    assert_non_null(strstr(data, "{\"ts\":\""));
+    assert_non_null(strstr(data, "\"level\":\"WARN\""));
+    assert_non_null(strstr(data, "\"func\":\"test_log_json\""));
+    assert_non_null(strstr(data, "\"msg\":\"say \\\"hi\\\"\\nbye\\\\\"}\n"));
+    g_free(data);
+}
+
+/* ── Test: binary records ────────────────────────────────────── */
+
+static void test_log_binary(void **state)
+{
+    (void)state;
+    log_to_new_file();
+    argus_log_set_format(ARGUS_LOG_FORMAT_BINARY);
+
+    ARGUS_LOG_ERROR("boom %s", "now");
+    ARGUS_LOG_INFO("next");
+
+    size_t len = 0;
+    char *data = read_log(&len);
+    argus_log_record_t rec;
+    assert_true(len > sizeof(rec));
+    memcpy(&rec, data, sizeof(rec));
+    assert_int_equal(rec.level, ARGUS_LOG_ERROR);
+    assert_true(rec.line > 0);
+    assert_true(rec.time_us > 0);
+
+    const char *file = data + sizeof(rec);
+    const char *func = file + strlen(file) + 1;
+    const char *msg = func + strlen(func) + 1;
+    assert_string_equal(file, "test_log.c");
+    assert_string_equal(func, "test_log_binary");
+    assert_string_equal(msg, "boom now");
+    assert_int_equal(rec.size, (msg + strlen(msg) + 1) - data);
+
+    /* size leads to the next record */
+    assert_true(len > rec.size + sizeof(rec));
+    memcpy(&rec, data + rec.size, sizeof(rec));
+    assert_int_equal(rec.level, ARGUS_LOG_INFO);
+    g_free(data);
+}
+
+/* ── Test: every line is either written or counted dropped ──── */
+
+#define LOG_THREADS 4
+#define LOG_LINES   5000
+
+static gpointer log_worker(gpointer data)
+{
+    (void)data;
+    for (int i = 0; i < LOG_LINES; i++)
+        ARGUS_LOG_DEBUG("worker line %d of the threaded test", i);
+    return NULL;
+}
+
+static void test_log_threads(void **state)
+{
+    (void)state;
+    log_to_new_file();
+    argus_log_set_format(ARGUS_LOG_FORMAT_TEXT);
+    unsigned long dropped_before = argus_log_dropped();
+
+    GThread *threads[LOG_THREADS];
+    for (int i = 0; i < LOG_THREADS; i++)
+        threads[i] = g_thread_new("log-test", log_worker, NULL);
+    for (int i = 0; i < LOG_THREADS; i++)
+        g_thread_join(threads[i]);
+
+    char *data = read_log(NULL);
+    int written = count_lines(data, "threaded test\n");
+    unsigned long dropped = argus_log_dropped() - dropped_before;
+    assert_int_equal((unsigned long)written + dropped,
+                     LOG_THREADS * LOG_LINES);
+    if (dropped > 0)
+        assert_non_null(strstr(data, "log line(s) dropped"));
+    g_free(data);
+}
+
+/* ── Test: states outlive their threads until cleanup ────────── */
+
+static void test_log_cleanup(void **state)
+{
+    (void)state;
+    log_to_new_file();
+    argus_log_set_format(ARGUS_LOG_FORMAT_TEXT);
+
+    /* No thread-exit hook: the drain after the joins still sees the rings */
+    GThread *threads[LOG_THREADS];
+    for (int i = 0; i < LOG_THREADS; i++)
+        threads[i] = g_thread_new("log-test", log_worker, NULL);
+    for (int i = 0; i < LOG_THREADS; i++)
+        g_thread_join(threads[i]);
+    ARGUS_LOG_INFO("before cleanup");
+
+    /* Cleanup frees every state, this thread's included; logging after it
+     * is synchronous and starts a fresh state */
+    argus_log_cleanup();
+    log_to_new_file();
+    ARGUS_LOG_INFO("after cleanup");
+    ARGUS_LOG_INFO("still after cleanup");
+
+    char *data = read_log(NULL);
+    assert_non_null(strstr(data, "after cleanup\n"));
+    assert_non_null(strstr(data, "still after cleanup\n"));
+    assert_null(strstr(data, "threaded test"));
+    g_free(data);
+    argus_log_cleanup();
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_log_text),
+        cmocka_unit_test(test_log_json),
+        cmocka_unit_test(test_log_binary),
+        cmocka_unit_test(test_log_threads),
+        /* Last: leaves the log synchronous */
+        cmocka_unit_test(test_log_cleanup),
+    };
+    return cmocka_run_group_tests(tests, setup, teardown);
+}
@@ -0,0 +1,459 @@
+/*
+ * Unit tests for the process-wide metadata cache (metadata_cache.c)
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include "argus/handle.h"
+
+/* ── Helpers ─────────────────────────────────────────────────── */
+
+static argus_dbc_t *create_dbc(const char *user)
+{
+    argus_dbc_t *dbc = calloc(1, sizeof(argus_dbc_t));
+    dbc->host = strdup("mdhost");
+    dbc->port = 10000;
+    dbc->username = strdup(user);
+    dbc->backend_name = strdup("fake");
+    dbc->metadata_cache_ttl_sec = ARGUS_DEFAULT_METADATA_CACHE_TTL_SEC;
+    dbc->tables_cache_ttl_sec = -1;
+    dbc->columns_cache_ttl_sec = -1;
+    return dbc;
+}
+
+static void free_dbc(argus_dbc_t *dbc)
+{
+    free(dbc->host);
+    free(dbc->username);
+    free(dbc->backend_name);
+    free(dbc);
+}
+
+static argus_stmt_t *create_stmt(argus_dbc_t *dbc)
+{
+    argus_stmt_t *stmt = calloc(1, sizeof(argus_stmt_t));
+    stmt->signature = ARGUS_STMT_SIGNATURE;
+    stmt->dbc = dbc;
+    stmt->row_count = -1;
+    argus_row_cache_init(&stmt->row_cache);
+    argus_stmt_ensure_columns(stmt, 2);
+    return stmt;
+}
+
+static void destroy_stmt(argus_stmt_t *stmt)
+{
+    argus_metadata_cache_release(stmt);
+    argus_row_cache_free(&stmt->row_cache);
+    free(stmt->columns);
+    free(stmt);
+}
+
+/* Fill stmt as a catalog call would: two columns, `n` rows. */
+static void fill_result(argus_stmt_t *stmt, int n)
+{
+    stmt->num_cols = 2;
+    strcpy((char *)stmt->columns[0].name, "TABLE_NAME");
+    strcpy((char *)stmt->columns[1].name, "REMARKS");
+    stmt->row_cache.rows = calloc((size_t)n, sizeof(argus_row_t));
+    stmt->row_cache.capacity = (size_t)n;
+    stmt->row_cache.num_cols = 2;
+    for (int r = 0; r < n; r++) {
+        argus_cell_t *cells = calloc(2, sizeof(argus_cell_t));
+        char buf[16];
+        cells[0].data_len = (size_t)snprintf(buf, sizeof(buf), "t%d", r);
+        cells[0].data = strdup(buf);
+        cells[1].is_null = true;
+        stmt->row_cache.rows[r].cells = cells;
+    }
+    stmt->row_cache.num_rows = (size_t)n;
+    stmt->row_cache.exhausted = true;
+}
+
+/* ── Test: a hit is shared across connections without copying ─ */
+
+static void test_metadata_cache_shared_hit(void **state)
+{
+    (void)state;
+    argus_metadata_cache_clear();
+
+    argus_dbc_t *dbc1 = create_dbc("alice");
+    argus_dbc_t *dbc2 = create_dbc("alice");
+    argus_stmt_t *s1 = create_stmt(dbc1);
+    argus_stmt_t *s2 = create_stmt(dbc2);
+
+    assert_false(argus_metadata_cache_lookup(dbc1, s1, "SQLTables",
+                                             NULL, "db", "%", NULL));
+    fill_result(s1, 3);
+    argus_metadata_cache_store(dbc1, s1, "SQLTables", NULL, "db", "%", NULL);
+    /* The storing statement keeps reading its rows from the entry */
+    assert_true(s1->row_cache.borrowed);
+    assert_int_equal(s1->row_cache.num_rows, 3);
+
+    /* Another connection with the same identity gets the same rows */
+    assert_true(argus_metadata_cache_lookup(dbc2, s2, "SQLTables",
+                                            NULL, "db", "%", NULL));
+    assert_ptr_equal(s2->row_cache.rows, s1->row_cache.rows);
+    assert_int_equal(s2->num_cols, 2);
+    assert_string_equal((char *)s2->columns[0].name, "TABLE_NAME");
+    assert_string_equal(s2->row_cache.rows[2].cells[0].data, "t2");
+    assert_true(s2->fetch_started);
+
+    /* A different user does not */
+    argus_dbc_t *dbc3 = create_dbc("bob");
+    argus_stmt_t *s3 = create_stmt(dbc3);
+    assert_false(argus_metadata_cache_lookup(dbc3, s3, "SQLTables",
+                                             NULL, "db", "%", NULL));
+
+    /* Clearing the cache leaves borrowed rows readable until release */
+    argus_metadata_cache_clear();
+    assert_string_equal(s2->row_cache.rows[0].cells[0].data, "t0");
+
+    destroy_stmt(s1);
+    destroy_stmt(s2);
+    destroy_stmt(s3);
+    free_dbc(dbc1);
+    free_dbc(dbc2);
+    free_dbc(dbc3);
+}
+
+/* ── Test: per-function TTLs ─────────────────────────────────── */
+
+static void test_metadata_cache_ttl(void **state)
+{
+    (void)state;
+    argus_metadata_cache_clear();
+
+    argus_dbc_t *dbc = create_dbc("alice");
+    dbc->columns_cache_ttl_sec = 0;     /* SQLColumns not cached */
+    argus_stmt_t *stmt = create_stmt(dbc);
+
+    fill_result(stmt, 1);
+    argus_metadata_cache_store(dbc, stmt, "SQLColumns", NULL, "db", "t", "%");
+    assert_false(stmt->row_cache.borrowed);
+    argus_row_cache_free(&stmt->row_cache);
+    assert_false(argus_metadata_cache_lookup(dbc, stmt, "SQLColumns",
+                                             NULL, "db", "t", "%"));
+
+    fill_result(stmt, 1);
+    argus_metadata_cache_store(dbc, stmt, "SQLTables", NULL, "db", "%", NULL);
+    argus_metadata_cache_release(stmt);
+    assert_true(argus_metadata_cache_lookup(dbc, stmt, "SQLTables",
+                                            NULL, "db", "%", NULL));
+    argus_metadata_cache_release(stmt);
+
+    /* METADATACACHETTL=0 turns the whole cache off */
+    dbc->metadata_cache_ttl_sec = 0;
+    assert_false(argus_metadata_cache_lookup(dbc, stmt, "SQLTables",
+                                             NULL, "db", "%", NULL));
+
+    destroy_stmt(stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: DDL drops the entries of its connection identity ──── */
+
+static void test_metadata_cache_ddl_invalidation(void **state)
+{
+    (void)state;
+    argus_metadata_cache_clear();
+
+    assert_true(argus_metadata_cache_is_ddl("CREATE TABLE t (a INT)"));
+    assert_true(argus_metadata_cache_is_ddl("  /* x */ drop view v"));
+    assert_true(argus_metadata_cache_is_ddl("ALTER TABLE t ADD COLUMNS (b INT)"));
+    assert_true(argus_metadata_cache_is_ddl("MSCK REPAIR TABLE t"));
+    assert_true(argus_metadata_cache_is_ddl("INVALIDATE METADATA t"));
+    assert_false(argus_metadata_cache_is_ddl("SELECT created FROM t"));
+    assert_false(argus_metadata_cache_is_ddl("INSERT INTO t VALUES (1)"));
+    assert_false(argus_metadata_cache_is_ddl("CREATED"));
+
+    argus_dbc_t *alice = create_dbc("alice");
+    argus_dbc_t *bob = create_dbc("bob");
+    argus_stmt_t *stmt = create_stmt(alice);
+
+    fill_result(stmt, 2);
+    argus_metadata_cache_store(alice, stmt, "SQLTables", NULL, "db", "%", NULL);
+    argus_metadata_cache_release(stmt);
+    stmt->dbc = bob;
+    fill_result(stmt, 2);
+    argus_metadata_cache_store(bob, stmt, "SQLTables", NULL, "db", "%", NULL);
+    argus_metadata_cache_release(stmt);
+
+    argus_metadata_cache_invalidate(alice);
+    assert_false(argus_metadata_cache_lookup(alice, stmt, "SQLTables",
+                                             NULL, "db", "%", NULL));
+    assert_true(argus_metadata_cache_lookup(bob, stmt, "SQLTables",
+                                            NULL, "db", "%", NULL));
+
+    destroy_stmt(stmt);
+    free_dbc(alice);
+    free_dbc(bob);
+}
+
+/* ── Test: the cache survives a restart through its file ─────── */
+
+static void test_metadata_cache_persistence(void **state)
+{
+    (void)state;
+    argus_metadata_cache_cleanup();
+
+    char path[] = "/tmp/argus_mdc_XXXXXX";
+    int fd = mkstemp(path);
+    assert_true(fd >= 0);
+    close(fd);
+    unlink(path);
+
+    argus_dbc_t *dbc = create_dbc("alice");
+    argus_stmt_t *stmt = create_stmt(dbc);
+
+    argus_metadata_cache_set_file(path);
+    fill_result(stmt, 4);
+    argus_metadata_cache_store(dbc, stmt, "SQLTables", "c", "db", "%", "TABLE");
+    argus_metadata_cache_release(stmt);
+    argus_metadata_cache_cleanup();     /* writes the file */
+
+    assert_false(argus_metadata_cache_lookup(dbc, stmt, "SQLTables",
+                                             "c", "db", "%", "TABLE"));
+    argus_metadata_cache_set_file(path);
+    assert_true(argus_metadata_cache_lookup(dbc, stmt, "SQLTables",
+                                            "c", "db", "%", "TABLE"));
+    assert_int_equal(stmt->row_cache.num_rows, 4);
+    assert_int_equal(stmt->num_cols, 2);
+    assert_string_equal(stmt->row_cache.rows[3].cells[0].data, "t3");
+    assert_true(stmt->row_cache.rows[3].cells[1].is_null);
+    assert_null(stmt->row_cache.rows[3].cells[1].data);
+
+    destroy_stmt(stmt);
+    argus_metadata_cache_cleanup();
+    unlink(path);
+    free_dbc(dbc);
+}
+
+/* ── Catalog snapshots: a fake backend listing a few tables ──── */
+
+static const char *const fake_tables[][3] = {
+    /* schema, table, type; deliberately not sorted */
+    { "sales",         "orders",      "TABLE" },
+    { "hr",            "people",      "TABLE" },
+    { "sales",         "customers",   "VIEW"  },
+    { "sales_archive", "orders",      "TABLE" },
+    { "sales",         "order_items", "TABLE" },
+};
+#define FAKE_TABLES (sizeof(fake_tables) / sizeof(fake_tables[0]))
+
+typedef struct {
+    char   schema[32];      /* "%" = every schema */
+    size_t pos;
+} fake_op_t;
+
+static int fake_get_tables_calls;
+
+static int fake_get_tables(argus_backend_conn_t conn, const char *catalog,
+                           const char *schema, const char *table_name,
+                           const char *table_types, argus_backend_op_t *out)
+{
+    (void)conn;
+    (void)catalog;
+    (void)table_types;
+    assert_string_equal(table_name, "%");
+    fake_op_t *op = calloc(1, sizeof(*op));
+    snprintf(op->schema, sizeof(op->schema), "%s", schema ? schema : "%");
+    fake_get_tables_calls++;
+    *out = op;
+    return 0;
+}
+
+static int fake_get_result_metadata(argus_backend_conn_t conn,
+                                    argus_backend_op_t op,
+                                    argus_column_desc_t *columns,
+                                    int *num_cols)
+{
+    (void)conn;
+    (void)op;
+    static const char *const names[] = {
+        "TABLE_CAT", "TABLE_SCHEM", "TABLE_NAME", "TABLE_TYPE", "REMARKS",
+    };
+    memset(columns, 0, 5 * sizeof(argus_column_desc_t));
+    for (int i = 0; i < 5; i++)
+        strcpy((char *)columns[i].name, names[i]);
+    *num_cols = 5;
+    return 0;
+}
+
+static char *fake_cell(argus_cell_t *cell, const char *text)
+{
+    cell->data = strdup(text);
+    cell->data_len = strlen(text);
+    return cell->data;
+}
+
+/* Two rows per batch, reusing the cache's row array like real backends */
+static int fake_fetch_results(argus_backend_conn_t conn,
+                              argus_backend_op_t op_in, int max_rows,
+                              argus_row_cache_t *cache,
+                              argus_column_desc_t *columns, int *num_cols)
+{
+    (void)conn;
+    (void)max_rows;
+    (void)columns;
+    fake_op_t *op = (fake_op_t *)op_in;
+    if (cache->capacity < 2) {
+        cache->rows = realloc(cache->rows, 2 * sizeof(argus_row_t));
+        cache->capacity = 2;
+    }
+    cache->num_rows = 0;
+    cache->num_cols = 5;
+    while (op->pos < FAKE_TABLES && cache->num_rows < 2) {
+        const char *const *t = fake_tables[op->pos++];
+        if (strcmp(op->schema, "%") != 0 &&
+            strcasecmp(op->schema, t[0]) != 0)
+            continue;
+        argus_cell_t *cells = calloc(5, sizeof(argus_cell_t));
+        fake_cell(&cells[0], "hive");
+        fake_cell(&cells[1], t[0]);
+        fake_cell(&cells[2], t[1]);
+        fake_cell(&cells[3], t[2]);
+        cells[4].is_null = true;
+        cache->rows[cache->num_rows++].cells = cells;
+    }
+    cache->exhausted = op->pos >= FAKE_TABLES;
+    *num_cols = 5;
+    return 0;
+}
+
+static void fake_close_operation(argus_backend_conn_t conn,
+                                 argus_backend_op_t op)
+{
+    (void)conn;
+    free(op);
+}
+
+static const argus_backend_t fake_backend = {
+    .name = "fake",
+    .get_tables = fake_get_tables,
+    .get_result_metadata = fake_get_result_metadata,
+    .fetch_results = fake_fetch_results,
+    .close_operation = fake_close_operation,
+};
+
+static const char *row_table(argus_stmt_t *stmt, size_t r)
+{
+    return stmt->row_cache.rows[r].cells[2].data;
+}
+
+/* ── Test: SQLTables answered from per-schema snapshots ──────── */
+
+static void test_metadata_cache_snapshot_tables(void **state)
+{
+    (void)state;
+    argus_metadata_cache_clear();
+    fake_get_tables_calls = 0;
+
+    argus_dbc_t *dbc = create_dbc("alice");
+    int conn_token = 0;
+    dbc->backend = &fake_backend;
+    dbc->backend_conn = &conn_token;
+    argus_stmt_t *stmt = create_stmt(dbc);
+
+    /* Off unless CATALOGSNAPSHOT is set */
+    assert_false(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                               "sales", "%", NULL, false));
+    dbc->catalog_snapshot = true;
+
+    /* A named schema loads just that schema, across several batches */
+    assert_true(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                              "sales", "order%", NULL, false));
+    assert_int_equal(fake_get_tables_calls, 1);
+    assert_int_equal(stmt->num_cols, 5);
+    assert_false(stmt->row_cache.borrowed);
+    assert_true(stmt->fetch_started);
+    assert_int_equal(stmt->row_cache.num_rows, 2);
+    assert_string_equal(row_table(stmt, 0), "order_items");
+    assert_string_equal(row_table(stmt, 1), "orders");
+
+    /* Later calls on the schema are local, including type filters */
+    assert_true(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                              "sales", "%", "'VIEW'", false));
+    assert_int_equal(stmt->row_cache.num_rows, 1);
+    assert_string_equal(row_table(stmt, 0), "customers");
+    assert_true(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                              "sales", "_rders", NULL, false));
+    assert_int_equal(stmt->row_cache.num_rows, 1);
+    assert_string_equal(row_table(stmt, 0), "orders");
+    assert_int_equal(fake_get_tables_calls, 1);
+
+    /* With SQL_ATTR_METADATA_ID the arguments are names, not patterns */
+    assert_true(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                              "sales", "order%", NULL, true));
+    assert_int_equal(stmt->row_cache.num_rows, 0);
+
+    /* A schema pattern loads every schema once */
+    assert_true(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                              "sales%", "orders", NULL, false));
+    assert_int_equal(fake_get_tables_calls, 2);
+    assert_int_equal(stmt->row_cache.num_rows, 2);
+    assert_string_equal(stmt->row_cache.rows[0].cells[1].data, "sales");
+    assert_string_equal(stmt->row_cache.rows[1].cells[1].data,
+                        "sales_archive");
+    assert_true(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                              NULL, "people", NULL, false));
+    assert_int_equal(stmt->row_cache.num_rows, 1);
+    assert_int_equal(fake_get_tables_calls, 2);
+
+    /* Names match in any case, as they do on the servers */
+    assert_true(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                              "SALES%", "Orders", NULL, false));
+    assert_int_equal(stmt->row_cache.num_rows, 2);
+    assert_true(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                              "Sales%", "ORDER\\_%", NULL,
+                                              false));
+    assert_int_equal(stmt->row_cache.num_rows, 1);
+    assert_string_equal(row_table(stmt, 0), "order_items");
+    assert_int_equal(fake_get_tables_calls, 2);
+
+    /* An escaped underscore names one schema */
+    assert_true(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                              "sales\\_archive", "%", NULL,
+                                              false));
+    assert_int_equal(fake_get_tables_calls, 3);
+    assert_int_equal(stmt->row_cache.num_rows, 1);
+    assert_true(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                              "HR", "PEOPLE", NULL, true));
+    assert_int_equal(fake_get_tables_calls, 4);
+    assert_int_equal(stmt->row_cache.num_rows, 1);
+
+    /* The catalog / schema / table type enumerations go to the backend */
+    assert_false(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "",
+                                               "%", "", "", false));
+
+    /* DDL drops the snapshots with the rest of the identity's entries */
+    argus_metadata_cache_invalidate(dbc);
+    assert_true(argus_metadata_cache_snapshot(dbc, stmt, "SQLTables", "hive",
+                                              "sales", "%", NULL, false));
+    assert_int_equal(fake_get_tables_calls, 5);
+    assert_int_equal(stmt->row_cache.num_rows, 3);
+
+    destroy_stmt(stmt);
+    argus_metadata_cache_clear();
+    free_dbc(dbc);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_metadata_cache_shared_hit),
+        cmocka_unit_test(test_metadata_cache_ttl),
+        cmocka_unit_test(test_metadata_cache_ddl_invalidation),
+        cmocka_unit_test(test_metadata_cache_persistence),
+        cmocka_unit_test(test_metadata_cache_snapshot_tables),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,150 @@
+/*
+ * Unit tests for statement phase timing and the latency histograms
+ * (metrics.c)
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "argus/handle.h"
+
+static int setup(void **state)
+{
+    (void)state;
+    argus_metrics_reset();
+    return 0;
+}
+
+/* ── Test: percentiles stay within a bucket's width ──────────── */
+
+static void test_metrics_percentiles(void **state)
+{
+    (void)state;
+    argus_metrics_reset();
+
+    /* 1..1000 ms, uniformly */
+    for (int i = 1; i <= 1000; i++)
+        argus_metrics_record(ARGUS_PHASE_FETCH, (double)i);
+
+    argus_phase_summary_t s;
+    argus_metrics_summary(ARGUS_PHASE_FETCH, &s);
+    assert_int_equal(s.count, 1000);
+    assert_true(s.min_ms == 1.0);
+    assert_true(s.max_ms == 1000.0);
+    assert_true(s.mean_ms > 500.0 && s.mean_ms < 501.0);
+    /* Log-linear buckets: within 1/16 of the true value */
+    assert_true(s.p50_ms > 500.0 * 15 / 16 && s.p50_ms < 500.0 * 17 / 16);
+    assert_true(s.p90_ms > 900.0 * 15 / 16 && s.p90_ms < 900.0 * 17 / 16);
+    assert_true(s.p99_ms > 990.0 * 15 / 16 && s.p99_ms <= 1000.0);
+
+    /* Sub-millisecond values keep microsecond resolution */
+    argus_metrics_record(ARGUS_PHASE_CONVERT, 0.004);
+    argus_metrics_summary(ARGUS_PHASE_CONVERT, &s);
+    assert_int_equal(s.count, 1);
+    assert_true(s.p50_ms == 0.004);
+
+    /* Negative means unknown and is not recorded */
+    argus_metrics_record(ARGUS_PHASE_NETWORK, -1.0);
+    argus_metrics_summary(ARGUS_PHASE_NETWORK, &s);
+    assert_int_equal(s.count, 0);
+}
+
+/* ── Test: a statement's phases are derived and recorded once ── */
+
+static void test_metrics_stmt_timing(void **state)
+{
+    (void)state;
+    argus_metrics_reset();
+
+    argus_stmt_t *stmt = calloc(1, sizeof(argus_stmt_t));
+    argus_stmt_timing_begin(stmt);
+    assert_true(argus_stmt_phase_ms(stmt, ARGUS_PHASE_SUBMIT) < 0);
+    assert_true(argus_stmt_phase_ms(stmt, ARGUS_PHASE_FIRST_ROW) < 0);
+    assert_true(argus_stmt_phase_ms(stmt, ARGUS_PHASE_FETCH) < 0);
+
+    argus_stmt_timing_t *t = &stmt->timing;
+    t->submit_ms = 2.0;
+    t->queue_ms = 30.0;
+    t->first_row_ms = 40.0;
+    t->batches = 2;
+    t->fetch_ms = 10.0;
+    t->network_ms = 6.0;
+    t->fetch_calls = 128;
+    t->convert_samples = 2;
+    t->convert_sampled_ms = 0.5;
+    t->bytes = 4096;
+    t->cells = 300;
+    stmt->rows_fetched_total = 100;
+
+    assert_true(argus_stmt_phase_ms(stmt, ARGUS_PHASE_DECODE) == 4.0);
+    /* Two sampled calls out of 128 */
+    assert_true(argus_stmt_phase_ms(stmt, ARGUS_PHASE_CONVERT) == 32.0);
+
+    /* Re-executing records the previous execution */
+    argus_stmt_timing_begin(stmt);
+    argus_phase_summary_t s;
+    argus_metrics_summary(ARGUS_PHASE_QUEUE, &s);
+    assert_int_equal(s.count, 1);
+    argus_metrics_summary(ARGUS_PHASE_DECODE, &s);
+    assert_int_equal(s.count, 1);
+    /* The new execution failed at submit: nothing else is known */
+    stmt->rows_fetched_total = 0;
+    stmt->timing.submit_ms = 1.0;
+    argus_stmt_timing_finish(stmt);
+    argus_stmt_timing_finish(stmt);
+    argus_metrics_summary(ARGUS_PHASE_SUBMIT, &s);
+    assert_int_equal(s.count, 2);
+    argus_metrics_summary(ARGUS_PHASE_QUEUE, &s);
+    assert_int_equal(s.count, 1);
+
+    char *json = argus_metrics_json();
+    assert_non_null(strstr(json, "\"queue\":{\"count\":1,"));
+    assert_non_null(strstr(json, "\"unknown\":{\"statements\":2,\"rows\":100,"
+                                 "\"bytes\":4096,\"cells\":300}"));
+    assert_null(strstr(json, "\"buckets\""));
+    g_free(json);
+    free(stmt);
+}
+
+/* ── Test: dumping writes the buckets ────────────────────────── */
+
+static void test_metrics_dump(void **state)
+{
+    (void)state;
+    argus_metrics_reset();
+    argus_metrics_record(ARGUS_PHASE_SUBMIT, 0.010);
+    argus_metrics_record(ARGUS_PHASE_SUBMIT, 0.010);
+    argus_metrics_record(ARGUS_PHASE_SUBMIT, 100.0);
+
+    char path[] = "/tmp/argus_metrics_XXXXXX";
+    int fd = mkstemp(path);
+    assert_true(fd >= 0);
+    close(fd);
+    assert_int_equal(argus_metrics_dump(path), 0);
+
+    gchar *data = NULL;
+    assert_true(g_file_get_contents(path, &data, NULL, NULL));
+    /* 10 us has a bucket of its own; 100 ms shares one from 98304 us */
+    assert_non_null(strstr(data, "\"buckets\":[[10,2],[98304,1]]"));
+    g_free(data);
+    unlink(path);
+
+    assert_int_equal(argus_metrics_dump("/nonexistent/dir/metrics.json"), -1);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_metrics_percentiles),
+        cmocka_unit_test(test_metrics_stmt_timing),
+        cmocka_unit_test(test_metrics_dump),
+    };
+    return cmocka_run_group_tests(tests, setup, NULL);
+}
@@ -0,0 +1,273 @@
+/*
+ * Unit tests for the MySQL-wire LOAD DATA LOCAL INFILE stream
+ * (src/backend/mysql/mywire_bulk.c): the text format, the statement, and the
+ * LOCAL INFILE handler driven the way the client library drives it, with no
+ * server.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "mywire_internal.h"
+
+/* ── Helpers ─────────────────────────────────────────────────── */
+
+/* Rows (r, "row-r"), every `skip`th one (when set) unconvertible */
+typedef struct {
+    size_t       nrows;
+    size_t       skip;
+    size_t       asked;     /* rows the producer has asked for */
+    argus_cell_t cells[2];
+    char         id[24];
+    char         label[32];
+} rows_src_t;
+
+static const argus_cell_t *src_get(void *ctx, size_t row)
+{
+    rows_src_t *src = (rows_src_t *)ctx;
+    src->asked++;
+    if (src->skip && row % src->skip == src->skip - 1) return NULL;
+
+    memset(src->cells, 0, sizeof(src->cells));
+    snprintf(src->id, sizeof(src->id), "%lu", (unsigned long)row);
+    snprintf(src->label, sizeof(src->label), "row-%lu", (unsigned long)row);
+    src->cells[0].data = src->id;
+    src->cells[0].data_len = strlen(src->id);
+    src->cells[1].data = src->label;
+    src->cells[1].data_len = strlen(src->label);
+    return src->cells;
+}
+
+static char *field_text(const argus_cell_t *cell, size_t *len)
+{
+    GByteArray *out = g_byte_array_new();
+    mywire_load_field(out, cell);
+    *len = out->len;
+    g_byte_array_append(out, (const guint8 *)"", 1);
+    return (char *)g_byte_array_free(out, FALSE);
+}
+
+static argus_cell_t text_cell(const char *s, size_t len)
+{
+    argus_cell_t cell = { .data = (char *)s, .data_len = len };
+    return cell;
+}
+
+/* ── Text format ─────────────────────────────────────────────── */
+
+static void test_load_field(void **state)
+{
+    (void)state;
+    size_t len;
+    char *s;
+
+    argus_cell_t plain = text_cell("plain", 5);
+    s = field_text(&plain, &len);
+    assert_string_equal(s, "plain");
+    g_free(s);
+
+    argus_cell_t seps = text_cell("a\tb\nc\rd\\e", 9);
+    s = field_text(&seps, &len);
+    assert_string_equal(s, "a\\tb\\nc\\rd\\\\e");
+    g_free(s);
+
+    /* NUL inside the value, and at the ends */
+    argus_cell_t nul = text_cell("\0x\0y\0", 5);
+    s = field_text(&nul, &len);
+    assert_int_equal(len, 8);
+    assert_memory_equal(s, "\\0x\\0y\\0", 8);
+    g_free(s);
+
+    /* NULL is \N; the text "\N" must not read back as NULL */
+    argus_cell_t null_cell = { .is_null = true };
+    s = field_text(&null_cell, &len);
+    assert_string_equal(s, "\\N");
+    g_free(s);
+    argus_cell_t not_null = text_cell("\\N", 2);
+    s = field_text(&not_null, &len);
+    assert_string_equal(s, "\\\\N");
+    g_free(s);
+
+    argus_cell_t empty = text_cell(NULL, 0);
+    s = field_text(&empty, &len);
+    assert_int_equal(len, 0);
+    g_free(s);
+
+    argus_cell_t i64 = { .native_kind = ARGUS_NATIVE_I64, .native.i64 = -42 };
+    s = field_text(&i64, &len);
+    assert_string_equal(s, "-42");
+    g_free(s);
+    argus_cell_t f64 = { .native_kind = ARGUS_NATIVE_F64, .native.f64 = 0.5 };
+    s = field_text(&f64, &len);
+    assert_string_equal(s, "0.5");
+    g_free(s);
+}
+
+/* ── Statement ───────────────────────────────────────────────── */
+
+static void test_load_statement(void **state)
+{
+    (void)state;
+    argus_column_desc_t cols[2];
+    memset(cols, 0, sizeof(cols));
+    strcpy((char *)cols[0].name, "id");
+    strcpy((char *)cols[1].name, "we`ird");
+
+    char *sql = mywire_load_statement("`db`.`t`", cols, 2, true);
+    assert_string_equal(sql,
+        "LOAD DATA LOCAL INFILE 'argus-bulk' INTO TABLE `db`.`t` "
+        "CHARACTER SET utf8mb4 COLUMNS TERMINATED BY '\\t' "
+        "LINES TERMINATED BY '\\n' (`id`, `we``ird`)");
+    g_free(sql);
+
+    sql = mywire_load_statement("`t`", cols, 1, false);
+    assert_string_equal(sql,
+        "LOAD DATA LOCAL INFILE 'argus-bulk' INTO TABLE `t` "
+        "COLUMNS TERMINATED BY '\\t' LINES TERMINATED BY '\\n' (`id`)");
+    g_free(sql);
+
+    /* Unnamed columns: the table's column order, no list */
+    memset(cols, 0, sizeof(cols));
+    sql = mywire_load_statement("`t`", cols, 2, true);
+    assert_null(strchr(sql, '('));
+    g_free(sql);
+}
+
+/* ── Handler ─────────────────────────────────────────────────── */
+
+static void test_load_stream(void **state)
+{
+    (void)state;
+    rows_src_t src = { .nrows = 5, .skip = 3 };
+    argus_bulk_rows_t rows = { .nrows = src.nrows, .get = src_get,
+                               .ctx = &src };
+    bool row_ok[5] = { true, true, true, true, true };
+    mywire_load_t load = { .rows = &rows, .ncols = 2, .row_ok = row_ok };
+    mywire_conn_t conn;
+    memset(&conn, 0, sizeof(conn));
+
+    mywire_load_begin(&load);
+    conn.load = &load;
+    void *ptr = NULL;
+    assert_int_equal(mywire_load_init(&ptr, MYWIRE_LOAD_FILE, &conn), 0);
+    assert_ptr_equal(ptr, &load);
+
+    /* Served once only */
+    void *again = &again;
+    assert_int_equal(mywire_load_init(&again, MYWIRE_LOAD_FILE, &conn), 1);
+    assert_null(again);
+
+    /* A small buffer, so reads split rows and chunks */
+    GString *text = g_string_new(NULL);
+    char buf[5];
+    int n;
+    while ((n = mywire_load_read(ptr, buf, sizeof(buf))) > 0)
+        g_string_append_len(text, buf, n);
+    assert_int_equal(n, 0);
+    assert_int_equal(mywire_load_read(ptr, buf, sizeof(buf)), 0);
+    mywire_load_end(ptr);
+    conn.load = NULL;
+    assert_true(mywire_load_finish(&load));
+
+    assert_string_equal(text->str,
+                        "0\trow-0\n1\trow-1\n3\trow-3\n4\trow-4\n");
+    assert_int_equal(src.asked, 5);
+    assert_true(row_ok[0] && row_ok[1] && row_ok[3] && row_ok[4]);
+    assert_false(row_ok[2]);
+    g_string_free(text, TRUE);
+}
+
+static void test_load_refused(void **state)
+{
+    (void)state;
+    rows_src_t src = { .nrows = 1 };
+    argus_bulk_rows_t rows = { .nrows = src.nrows, .get = src_get,
+                               .ctx = &src };
+    bool row_ok[1] = { true };
+    mywire_load_t load = { .rows = &rows, .ncols = 2, .row_ok = row_ok };
+    mywire_conn_t conn;
+    memset(&conn, 0, sizeof(conn));
+    void *ptr = &ptr;
+    char buf[128];
+
+    /* No load in progress: nothing is served, whatever the name */
+    assert_int_equal(mywire_load_init(&ptr, MYWIRE_LOAD_FILE, &conn), 1);
+    assert_null(ptr);
+    assert_int_equal(mywire_load_init(&ptr, MYWIRE_LOAD_FILE, NULL), 1);
+    assert_null(ptr);
+
+    /* A load in progress: only its own stream */
+    mywire_load_begin(&load);
+    conn.load = &load;
+    ptr = &ptr;
+    assert_int_equal(mywire_load_init(&ptr, "/etc/passwd", &conn), 1);
+    assert_null(ptr);
+    assert_int_equal(mywire_load_init(&ptr, "argus-bulk.csv", &conn), 1);
+    assert_null(ptr);
+    assert_null(load.producer);
+
+    /* What the client library does after a refused init */
+    assert_int_equal(mywire_load_read(ptr, buf, sizeof(buf)), -1);
+    assert_int_not_equal(mywire_load_error(ptr, buf, sizeof(buf)), 0);
+    assert_non_null(strstr(buf, "refused"));
+    mywire_load_end(ptr);
+
+    conn.load = NULL;
+    assert_false(mywire_load_finish(&load));
+    assert_int_equal(src.asked, 0);
+}
+
+/* The server stops reading part way: the producer must not wait for a
+ * reader that is gone, nor format the rest of the rows */
+static void test_load_abandoned(void **state)
+{
+    (void)state;
+    rows_src_t src = { .nrows = 1000000 };
+    argus_bulk_rows_t rows = { .nrows = src.nrows, .get = src_get,
+                               .ctx = &src };
+    bool *row_ok = calloc(src.nrows, sizeof(bool));
+    mywire_load_t load = { .rows = &rows, .ncols = 2, .row_ok = row_ok };
+    mywire_conn_t conn;
+    memset(&conn, 0, sizeof(conn));
+
+    mywire_load_begin(&load);
+    conn.load = &load;
+    void *ptr = NULL;
+    assert_int_equal(mywire_load_init(&ptr, MYWIRE_LOAD_FILE, &conn), 0);
+
+    char buf[4096];
+    assert_int_equal(mywire_load_read(ptr, buf, sizeof(buf)), sizeof(buf));
+    assert_memory_equal(buf, "0\trow-0\n", 8);
+
+    g_mutex_lock(&load.lock);
+    assert_true(g_queue_get_length(&load.chunks) <= MYWIRE_LOAD_QUEUE_DEPTH);
+    g_mutex_unlock(&load.lock);
+
+    mywire_load_end(ptr);
+    conn.load = NULL;
+    assert_true(mywire_load_finish(&load));
+
+    /* Bounded by the queue: a few chunks' worth, not the million rows */
+    assert_true(src.asked < src.nrows / 10);
+    free(row_ok);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_load_field),
+        cmocka_unit_test(test_load_statement),
+        cmocka_unit_test(test_load_stream),
+        cmocka_unit_test(test_load_refused),
+        cmocka_unit_test(test_load_abandoned),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
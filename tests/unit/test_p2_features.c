@@ -39,19 +39,7 @@ static void free_test_stmt(argus_stmt_t *stmt)
     free(stmt->async_query);
     if (stmt->dae_buffer)
         g_byte_array_free(stmt->dae_buffer, TRUE);
-    if (stmt->scroll_rows) {
-        int nc = stmt->num_cols > 0 ? stmt->num_cols
-                                     : stmt->row_cache.num_cols;
-        for (size_t i = 0; i < stmt->scroll_row_count; i++) {
-            argus_row_t *row = &stmt->scroll_rows[i];
-            if (row->cells) {
-                for (int c = 0; c < nc; c++)
-                    free(row->cells[c].data);
-                free(row->cells);
-            }
-        }
-        free(stmt->scroll_rows);
-    }
+    argus_scroll_store_free(stmt->scroll_store);
     argus_row_cache_free(&stmt->row_cache);
     free(stmt->columns);
     free(stmt->bindings);
@@ -397,19 +385,19 @@ static void test_scroll_cache_navigation(void **state)
 
     /* Build a mock scroll cache with 5 rows, 1 column */
     stmt->num_cols = 1;
-    stmt->scroll_row_count = 5;
-    stmt->scroll_rows = calloc(5, sizeof(argus_row_t));
-    assert_non_null(stmt->scroll_rows);
+    stmt->scroll_store = argus_scroll_store_new(1, 1024 * 1024, false);
+    assert_non_null(stmt->scroll_store);
 
     for (size_t i = 0; i < 5; i++) {
-        stmt->scroll_rows[i].cells = calloc(1, sizeof(argus_cell_t));
         char buf[16];
         snprintf(buf, sizeof(buf), "row%zu", i);
-        stmt->scroll_rows[i].cells[0].data = strdup(buf);
-        stmt->scroll_rows[i].cells[0].data_len = strlen(buf);
-        stmt->scroll_rows[i].cells[0].is_null = false;
+        argus_cell_t cell = { .data = buf, .data_len = strlen(buf) };
+        argus_row_t row = { .cells = &cell };
+        assert_int_equal(argus_scroll_store_append(stmt->scroll_store, &row),
+                         0);
     }
     stmt->scroll_cached = true;
+    stmt->scroll_complete = true;
     stmt->scroll_position = 0;
 
     /* Set up column binding */
@@ -8,6 +8,7 @@
 #include <cmocka.h>
 #include <sql.h>
 #include <sqlext.h>
+#include <stdlib.h>
 #include <string.h>
 #include "argus/handle.h"
 
@@ -111,15 +112,151 @@ static void test_pool_in_use(void **state)
     assert_null(got);
 }
 
+/* ── Test: hits, misses and busy misses are counted ─────────── */
+
+static void test_pool_stats(void **state)
+{
+    (void)state;
+
+    static const argus_backend_t fake_backend = { .name = "hive" };
+    argus_backend_conn_t fake_conn = (argus_backend_conn_t)(uintptr_t)0xF00D;
+    const argus_backend_t *out = NULL;
+    argus_pool_stats_t before, after;
+
+    argus_pool_get_stats(&before);
+    assert_null(argus_pool_acquire("statshost", 10000, "hive", "u", &out));
+    argus_pool_release("statshost", 10000, "hive", "u",
+                       &fake_backend, fake_conn);
+    assert_ptr_equal(argus_pool_acquire("statshost", 10000, "hive", "u",
+                                        &out), fake_conn);
+    /* The key's only connection is checked out */
+    assert_null(argus_pool_acquire("statshost", 10000, "hive", "u", &out));
+    argus_pool_get_stats(&after);
+
+    assert_int_equal(after.hits - before.hits, 1);
+    assert_int_equal(after.misses - before.misses, 2);
+    assert_int_equal(after.busy - before.busy, 1);
+    assert_int_equal(after.in_use - before.in_use, 1);
+}
+
+/* ── Test: pre-warming, validation and refresh-ahead ─────────── */
+
+typedef struct {
+    bool open;
+    bool alive;
+} warm_conn_t;
+
+static warm_conn_t warm_conns[8];
+static int warm_connects;
+static int warm_disconnects;
+
+static int warm_connect(argus_dbc_t *dbc, const char *host, int port,
+                        const char *username, const char *password,
+                        const char *database, const char *auth_mechanism,
+                        argus_backend_conn_t *out_conn)
+{
+    (void)dbc; (void)host; (void)port; (void)password;
+    (void)database; (void)auth_mechanism;
+    assert_string_equal(username, "bob");
+    for (int i = 0; i < 8; i++) {
+        if (!warm_conns[i].open) {
+            warm_conns[i] = (warm_conn_t){ true, true };
+            g_atomic_int_inc(&warm_connects);
+            *out_conn = (argus_backend_conn_t)&warm_conns[i];
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void warm_disconnect(argus_backend_conn_t conn)
+{
+    ((warm_conn_t *)conn)->open = false;
+    warm_disconnects++;
+}
+
+static bool warm_is_alive(argus_backend_conn_t conn)
+{
+    return ((warm_conn_t *)conn)->alive;
+}
+
+static void test_pool_warm(void **state)
+{
+    (void)state;
+
+    static const argus_backend_t warm_backend = {
+        .name = "warm",
+        .connect = warm_connect,
+        .disconnect = warm_disconnect,
+        .is_alive = warm_is_alive,
+    };
+    argus_dbc_t *dbc = calloc(1, sizeof(argus_dbc_t));
+    dbc->username = strdup("bob");
+    argus_pool_stats_t before, after;
+    argus_pool_get_stats(&before);
+
+    /* Idle connections past 1 s are replaced (TTL 2 s, see main) */
+    argus_pool_configure(-1, -1, -1, 2);
+    argus_pool_warm(dbc, "warmhost", 7000, "warm", "bob", &warm_backend, 2);
+
+    /* The maintainer thread warms the key right away, then sleeps 5 s */
+    for (int i = 0; i < 500 && g_atomic_int_get(&warm_connects) < 2; i++)
+        g_usleep(10 * 1000);
+    g_usleep(50 * 1000);
+    argus_pool_maintain();
+    assert_int_equal(g_atomic_int_get(&warm_connects), 2);
+
+    const argus_backend_t *out = NULL;
+    argus_backend_conn_t a = argus_pool_acquire("warmhost", 7000, "warm",
+                                                "bob", &out);
+    argus_backend_conn_t b = argus_pool_acquire("warmhost", 7000, "warm",
+                                                "bob", &out);
+    assert_non_null(a);
+    assert_non_null(b);
+    assert_ptr_not_equal(a, b);
+    assert_ptr_equal(out, &warm_backend);
+    argus_pool_release("warmhost", 7000, "warm", "bob", out, a);
+    argus_pool_release("warmhost", 7000, "warm", "bob", out, b);
+
+    /* One dies while idle; both near the TTL once validation is due */
+    ((warm_conn_t *)a)->alive = false;
+    g_usleep(1100 * 1000);
+    argus_pool_maintain();
+
+    argus_pool_get_stats(&after);
+    assert_int_equal(after.validation_failures - before.validation_failures,
+                     1);
+    assert_int_equal(after.replaced - before.replaced, 1);
+    assert_int_equal(after.creates - before.creates, 4);
+    assert_int_equal(after.warm_keys, 1);
+    assert_int_equal(g_atomic_int_get(&warm_connects), 4);
+    assert_int_equal(warm_disconnects, 2);
+    assert_true(after.create_ms_max >= 0.0);
+
+    /* Unregistering stops pre-warming; pooled connections stay */
+    argus_pool_warm(dbc, "warmhost", 7000, "warm", "bob", &warm_backend, 0);
+    argus_pool_get_stats(&after);
+    assert_int_equal(after.warm_keys, 0);
+    argus_pool_configure(-1, -1, -1, 3600);
+
+    free(dbc->username);
+    free(dbc);
+}
+
 /* ── Main ─────────────────────────────────────────────────────── */
 
 int main(void)
 {
+    /* Read when the pool is first used */
+    setenv("ARGUS_POOL_VALIDATE_INTERVAL", "1", 1);
+
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_pool_acquire_empty),
         cmocka_unit_test(test_pool_release_acquire),
         cmocka_unit_test(test_pool_different_key),
         cmocka_unit_test(test_pool_in_use),
+        cmocka_unit_test(test_pool_stats),
+        cmocka_unit_test(test_pool_warm),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
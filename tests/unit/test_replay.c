@@ -0,0 +1,344 @@
+/*
+ * Unit tests for capture mode and BACKEND=replay (src/backend/replay)
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib.h>
+#include "argus/handle.h"
+#include "synthetic_dbc.h"
+
+/* ── Fake backend: "SELECT n" returns rows 0..n-1, two per batch ─ */
+
+static int fake_rows;       /* rows of the current op */
+static int fake_fetched;
+static int fake_executes;
+
+static int fake_connect(argus_dbc_t *dbc, const char *host, int port,
+                        const char *username, const char *password,
+                        const char *database, const char *auth_mechanism,
+                        argus_backend_conn_t *out_conn)
+{
+    (void)dbc; (void)host; (void)port; (void)username; (void)password;
+    (void)database; (void)auth_mechanism;
+    *out_conn = (argus_backend_conn_t)(uintptr_t)0xCAFE;
+    return 0;
+}
+
+static void fake_disconnect(argus_backend_conn_t conn)
+{
+    (void)conn;
+}
+
+static int fake_execute(argus_backend_conn_t conn, const char *query,
+                        argus_backend_op_t *out_op)
+{
+    (void)conn;
+    fake_executes++;
+    if (strncmp(query, "SELECT ", 7) != 0) return -1;
+    fake_rows = atoi(query + 7);
+    fake_fetched = 0;
+    *out_op = (argus_backend_op_t)(uintptr_t)0xBEEF;
+    return 0;
+}
+
+static int fake_get_operation_status(argus_backend_conn_t conn,
+                                     argus_backend_op_t op, bool *finished)
+{
+    (void)conn; (void)op;
+    *finished = true;
+    return 0;
+}
+
+static void fake_close_operation(argus_backend_conn_t conn,
+                                 argus_backend_op_t op)
+{
+    (void)conn; (void)op;
+}
+
+static int fake_cancel(argus_backend_conn_t conn, argus_backend_op_t op)
+{
+    (void)conn; (void)op;
+    return 0;
+}
+
+static int fake_get_result_metadata(argus_backend_conn_t conn,
+                                    argus_backend_op_t op,
+                                    argus_column_desc_t *columns,
+                                    int *num_cols)
+{
+    (void)conn; (void)op;
+    memset(columns, 0, 2 * sizeof(columns[0]));
+    strcpy((char *)columns[0].name, "id");
+    columns[0].sql_type = SQL_BIGINT;
+    columns[0].column_size = 19;
+    strcpy((char *)columns[1].name, "label");
+    columns[1].sql_type = SQL_VARCHAR;
+    columns[1].column_size = 16;
+    columns[1].nullable = SQL_NULLABLE;
+    *num_cols = 2;
+    return 0;
+}
+
+/* Row 3's label is NULL; ids carry native values */
+static int fake_fetch_results(argus_backend_conn_t conn,
+                              argus_backend_op_t op, int max_rows,
+                              argus_row_cache_t *cache,
+                              argus_column_desc_t *columns, int *num_cols)
+{
+    (void)max_rows; (void)columns; (void)num_cols;
+    fake_get_result_metadata(conn, op, columns, num_cols);
+    int n = fake_rows - fake_fetched;
+    if (n > 2) n = 2;
+    if (n <= 0) return 0;
+
+    if (cache->capacity < (size_t)n) {
+        cache->rows = realloc(cache->rows, (size_t)n * sizeof(argus_row_t));
+        cache->capacity = (size_t)n;
+    }
+    cache->num_cols = 2;
+    for (int r = 0; r < n; r++) {
+        argus_cell_t *cells = calloc(2, sizeof(argus_cell_t));
+        int id = fake_fetched++;
+        char buf[16];
+        cells[0].data_len = (size_t)snprintf(buf, sizeof(buf), "%d", id);
+        cells[0].data = strdup(buf);
+        cells[0].native_kind = ARGUS_NATIVE_I64;
+        cells[0].native.i64 = id;
+        if (id == 3) {
+            cells[1].is_null = true;
+        } else {
+            cells[1].data_len = (size_t)snprintf(buf, sizeof(buf), "row%d", id);
+            cells[1].data = strdup(buf);
+        }
+        cache->rows[r].cells = cells;
+    }
+    cache->num_rows = (size_t)n;
+    return 0;
+}
+
+static bool fake_get_server_version(argus_backend_conn_t conn, char *buf,
+                                    size_t buflen)
+{
+    (void)conn;
+    g_strlcpy(buf, "9.9.1", buflen);
+    return true;
+}
+
+static const argus_backend_t fake_backend = {
+    .name                 = "fakecap",
+    .connect              = fake_connect,
+    .disconnect           = fake_disconnect,
+    .execute              = fake_execute,
+    .get_operation_status = fake_get_operation_status,
+    .close_operation      = fake_close_operation,
+    .cancel               = fake_cancel,
+    .fetch_results        = fake_fetch_results,
+    .get_result_metadata  = fake_get_result_metadata,
+    .get_server_version   = fake_get_server_version,
+};
+
+/* ── Helpers ─────────────────────────────────────────────────── */
+
+static char capture_path[256];
+
+static int setup_replay(void **state)
+{
+    setup(state);
+    argus_backend_register(&fake_backend);
+    snprintf(capture_path, sizeof(capture_path),
+             "/tmp/argus_test_replay_%ld.cap", (long)getpid());
+    unlink(capture_path);
+    return 0;
+}
+
+static int teardown(void **state)
+{
+    (void)state;
+    unlink(capture_path);
+    return 0;
+}
+
+/* Connect with `fmt`'s %s filled in with the capture file */
+static argus_dbc_t *connect_capture(const char *fmt, SQLRETURN *ret)
+{
+    char connstr[512];
+    snprintf(connstr, sizeof(connstr), fmt, capture_path);
+    return connect_with(connstr, ret);
+}
+
+/* Run sql and render its result as "id:label,..." (NULL as "-") */
+static SQLRETURN run(argus_dbc_t *dbc, const char *sql, GString *out)
+{
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    SQLRETURN ret = SQLExecDirect(stmt, (SQLCHAR *)sql, SQL_NTS);
+    if (SQL_SUCCEEDED(ret)) {
+        SQLSMALLINT ncols = 0;
+        SQLNumResultCols(stmt, &ncols);
+        g_string_append_printf(out, "[%d]", ncols);
+        while (SQLFetch(stmt) == SQL_SUCCESS) {
+            SQLBIGINT id = 0;
+            char label[32];
+            SQLLEN ind = 0;
+            SQLGetData(stmt, 1, SQL_C_SBIGINT, &id, sizeof(id), NULL);
+            SQLGetData(stmt, 2, SQL_C_CHAR, label, sizeof(label), &ind);
+            g_string_append_printf(out, "%lld:%s,", (long long)id,
+                                   ind == SQL_NULL_DATA ? "-" : label);
+        }
+    }
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    return ret;
+}
+
+static void record(void)
+{
+    SQLRETURN ret;
+    argus_dbc_t *dbc = connect_capture(
+        "BACKEND=fakecap;HOST=h;CAPTUREFILE=%s", &ret);
+    assert_int_equal(ret, SQL_SUCCESS);
+    /* The wrapper keeps the recorded backend's name */
+    assert_string_equal(dbc->backend->name, "fakecap");
+    assert_ptr_not_equal(dbc->backend, &fake_backend);
+
+    GString *out = g_string_new(NULL);
+    assert_int_equal(run(dbc, "SELECT 5", out), SQL_SUCCESS);
+    assert_string_equal(out->str, "[2]0:row0,1:row1,2:row2,3:-,4:row4,");
+    g_string_truncate(out, 0);
+    assert_int_equal(run(dbc, "SELECT 1", out), SQL_SUCCESS);
+    assert_int_equal(run(dbc, "DROP everything", out), SQL_ERROR);
+    g_string_free(out, TRUE);
+    free_dbc(dbc);
+}
+
+/* ── Test: replay serves the recorded rows without the backend ── */
+
+static void test_replay_roundtrip(void **state)
+{
+    (void)state;
+    record();
+    int executes = fake_executes;
+
+    SQLRETURN ret;
+    argus_dbc_t *dbc = connect_capture("BACKEND=replay;REPLAYFILE=%s", &ret);
+    assert_int_equal(ret, SQL_SUCCESS);
+    /* Replay presents the recorded backend */
+    assert_string_equal(dbc->backend->name, "fakecap");
+
+    SQLCHAR ver[32];
+    ret = SQLGetInfo((SQLHDBC)dbc, SQL_DBMS_VER, ver, sizeof(ver), NULL);
+    assert_int_equal(ret, SQL_SUCCESS);
+    assert_non_null(strstr((char *)ver, "9"));
+
+    GString *out = g_string_new(NULL);
+    for (int pass = 0; pass < 2; pass++) {
+        g_string_truncate(out, 0);
+        assert_int_equal(run(dbc, "SELECT 5", out), SQL_SUCCESS);
+        assert_string_equal(out->str, "[2]0:row0,1:row1,2:row2,3:-,4:row4,");
+    }
+    g_string_truncate(out, 0);
+    assert_int_equal(run(dbc, "SELECT 1", out), SQL_SUCCESS);
+    assert_string_equal(out->str, "[2]0:row0,");
+
+    /* A recorded failure fails again */
+    assert_int_equal(run(dbc, "DROP everything", out), SQL_ERROR);
+    assert_int_equal(fake_executes, executes);
+
+    g_string_free(out, TRUE);
+    free_dbc(dbc);
+}
+
+/* ── Test: a query that was never captured is an error ─────────── */
+
+static void test_replay_unknown_query(void **state)
+{
+    (void)state;
+    record();
+
+    SQLRETURN ret;
+    argus_dbc_t *dbc = connect_capture("BACKEND=replay;REPLAYFILE=%s", &ret);
+    assert_int_equal(ret, SQL_SUCCESS);
+
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    ret = SQLExecDirect(stmt, (SQLCHAR *)"SELECT 42", SQL_NTS);
+    assert_int_equal(ret, SQL_ERROR);
+    SQLCHAR state_buf[6], msg[512];
+    SQLINTEGER native = 0;
+    SQLGetDiagRec(SQL_HANDLE_STMT, stmt, 1, state_buf, &native, msg,
+                  sizeof(msg), NULL);
+    assert_non_null(strstr((char *)msg, "not in capture file"));
+
+    /* The connection still serves what was captured */
+    SQLFreeStmt(stmt, SQL_CLOSE);
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)"SELECT 1", SQL_NTS),
+                     SQL_SUCCESS);
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: REPLAYLATENCY is paid per round trip ───────────────── */
+
+static void test_replay_latency(void **state)
+{
+    (void)state;
+    record();
+
+    SQLRETURN ret;
+    argus_dbc_t *dbc = connect_capture(
+        "BACKEND=replay;REPLAYFILE=%s;REPLAYLATENCY=20", &ret);
+    assert_int_equal(ret, SQL_SUCCESS);
+
+    GString *out = g_string_new(NULL);
+    gint64 start = g_get_monotonic_time();
+    assert_int_equal(run(dbc, "SELECT 5", out), SQL_SUCCESS);
+    gint64 elapsed_us = g_get_monotonic_time() - start;
+    /* execute + at least one fetch */
+    assert_true(elapsed_us >= 2 * 20000);
+
+    g_string_free(out, TRUE);
+    free_dbc(dbc);
+}
+
+/* ── Test: bad replay files fail the connect ──────────────────── */
+
+static void test_replay_bad_file(void **state)
+{
+    (void)state;
+    SQLRETURN ret;
+    unlink(capture_path);
+    argus_dbc_t *dbc = connect_capture("BACKEND=replay;REPLAYFILE=%s", &ret);
+    assert_int_equal(ret, SQL_ERROR);
+    free_dbc(dbc);
+
+    FILE *f = fopen(capture_path, "wb");
+    fputs("not a capture", f);
+    fclose(f);
+    dbc = connect_capture("BACKEND=replay;REPLAYFILE=%s", &ret);
+    assert_int_equal(ret, SQL_ERROR);
+    free_dbc(dbc);
+    unlink(capture_path);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_replay_roundtrip, setup_replay,
+                                        teardown),
+        cmocka_unit_test_setup_teardown(test_replay_unknown_query,
+                                        setup_replay, teardown),
+        cmocka_unit_test_setup_teardown(test_replay_latency, setup_replay,
+                                        teardown),
+        cmocka_unit_test_setup_teardown(test_replay_bad_file, setup_replay,
+                                        teardown),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
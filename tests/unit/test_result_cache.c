@@ -0,0 +1,345 @@
+/*
+ * Unit tests for the client-side result cache (result_cache.c)
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "argus/handle.h"
+
+/* ── Fake backend: every query returns the rows "r0".."r4" ───── */
+
+static int fake_executes;
+static int fake_fetched;   /* rows handed out for the current op */
+
+static int fake_execute(argus_backend_conn_t conn, const char *query,
+                        argus_backend_op_t *out_op)
+{
+    (void)conn; (void)query;
+    fake_executes++;
+    fake_fetched = 0;
+    *out_op = (argus_backend_op_t)(uintptr_t)0xBEEF;
+    return 0;
+}
+
+static void fake_close_operation(argus_backend_conn_t conn,
+                                 argus_backend_op_t op)
+{
+    (void)conn; (void)op;
+}
+
+static int fake_get_result_metadata(argus_backend_conn_t conn,
+                                    argus_backend_op_t op,
+                                    argus_column_desc_t *columns,
+                                    int *num_cols)
+{
+    (void)conn; (void)op;
+    memset(&columns[0], 0, sizeof(columns[0]));
+    strcpy((char *)columns[0].name, "v");
+    columns[0].sql_type = SQL_VARCHAR;
+    columns[0].column_size = 16;
+    *num_cols = 1;
+    return 0;
+}
+
+/* Two rows per batch so the capture has to stitch batches together */
+static int fake_fetch_results(argus_backend_conn_t conn,
+                              argus_backend_op_t op, int max_rows,
+                              argus_row_cache_t *cache,
+                              argus_column_desc_t *columns, int *num_cols)
+{
+    (void)conn; (void)op; (void)max_rows; (void)columns;
+    int n = 5 - fake_fetched;
+    if (n > 2) n = 2;
+    *num_cols = 1;
+    if (n <= 0) return 0;
+
+    if (cache->capacity < (size_t)n) {
+        cache->rows = realloc(cache->rows, (size_t)n * sizeof(argus_row_t));
+        cache->capacity = (size_t)n;
+    }
+    cache->num_cols = 1;
+    for (int r = 0; r < n; r++) {
+        argus_cell_t *cell = calloc(1, sizeof(argus_cell_t));
+        char buf[16];
+        int len = snprintf(buf, sizeof(buf), "r%d", fake_fetched++);
+        cell->data = strdup(buf);
+        cell->data_len = (size_t)len;
+        cell->native_kind = ARGUS_NATIVE_I64;
+        cell->native.i64 = fake_fetched - 1;
+        cache->rows[r].cells = cell;
+    }
+    cache->num_rows = (size_t)n;
+    return 0;
+}
+
+static const argus_backend_t fake_backend = {
+    .name                = "fake",
+    .execute             = fake_execute,
+    .close_operation     = fake_close_operation,
+    .fetch_results       = fake_fetch_results,
+    .get_result_metadata = fake_get_result_metadata,
+};
+
+static argus_dbc_t *create_dbc(void)
+{
+    argus_env_t *env = NULL;
+    argus_alloc_env(&env);
+    env->odbc_version = SQL_OV_ODBC3;
+
+    argus_dbc_t *dbc = NULL;
+    argus_alloc_dbc(env, &dbc);
+    dbc->host = strdup("cachehost");
+    dbc->port = 10000;
+    dbc->username = strdup("alice");
+    dbc->backend_name = strdup("fake");
+    dbc->backend = &fake_backend;
+    dbc->backend_conn = (argus_backend_conn_t)(uintptr_t)0xCAFE;
+    dbc->connected = true;
+    dbc->result_cache = true;
+    return dbc;
+}
+
+static void free_dbc(argus_dbc_t *dbc)
+{
+    argus_env_t *env = dbc->env;
+    dbc->connected = false;
+    argus_free_dbc(dbc);
+    argus_free_env(env);
+}
+
+/* Execute and read the whole result; returns the number of rows. */
+static int run_query(argus_stmt_t *stmt, const char *sql)
+{
+    SQLRETURN ret = SQLExecDirect((SQLHSTMT)stmt, (SQLCHAR *)sql, SQL_NTS);
+    assert_int_equal(ret, SQL_SUCCESS);
+
+    int rows = 0;
+    while (SQLFetch((SQLHSTMT)stmt) == SQL_SUCCESS) {
+        char buf[16], expect[16];
+        SQLLEN ind = 0;
+        ret = SQLGetData((SQLHSTMT)stmt, 1, SQL_C_CHAR, buf, sizeof(buf), &ind);
+        assert_int_equal(ret, SQL_SUCCESS);
+        snprintf(expect, sizeof(expect), "r%d", rows++);
+        assert_string_equal(buf, expect);
+    }
+    SQLFreeStmt((SQLHSTMT)stmt, SQL_CLOSE);
+    return rows;
+}
+
+static SQLULEN conn_attr(argus_dbc_t *dbc, SQLINTEGER attr)
+{
+    SQLULEN v = 0;
+    SQLGetConnectAttr((SQLHDBC)dbc, attr, &v, sizeof(v), NULL);
+    return v;
+}
+
+/* ── Test: a repeated SELECT is served without the backend ───── */
+
+static void test_result_cache_hit(void **state)
+{
+    (void)state;
+    argus_result_cache_clear();
+    fake_executes = 0;
+
+    argus_dbc_t *dbc = create_dbc();
+    argus_stmt_t *stmt = NULL;
+    argus_alloc_stmt(dbc, &stmt);
+
+    int rows = run_query(stmt, "SELECT v FROM t");
+    assert_int_equal(rows, 5);
+    assert_int_equal(fake_executes, 1);
+
+    /* Whitespace differences do not defeat the cache */
+    rows = run_query(stmt, "  SELECT   v\n FROM t ;");
+    assert_int_equal(rows, 5);
+    assert_int_equal(fake_executes, 1);
+
+    SQLULEN hits = conn_attr(dbc, ARGUS_ATTR_RESULT_CACHE_HITS);
+    SQLULEN misses = conn_attr(dbc, ARGUS_ATTR_RESULT_CACHE_MISSES);
+    SQLULEN bytes = conn_attr(dbc, ARGUS_ATTR_RESULT_CACHE_BYTES);
+    assert_int_equal(hits, 1);
+    assert_int_equal(misses, 1);
+    assert_true(bytes > 0);
+
+    argus_free_stmt(stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: a partially read result is not cached ─────────────── */
+
+static void test_result_cache_partial_read(void **state)
+{
+    (void)state;
+    argus_result_cache_clear();
+    fake_executes = 0;
+
+    argus_dbc_t *dbc = create_dbc();
+    argus_stmt_t *stmt = NULL;
+    argus_alloc_stmt(dbc, &stmt);
+
+    SQLRETURN ret = SQLExecDirect((SQLHSTMT)stmt,
+                                  (SQLCHAR *)"SELECT v FROM p", SQL_NTS);
+    assert_int_equal(ret, SQL_SUCCESS);
+    assert_int_equal(SQLFetch((SQLHSTMT)stmt), SQL_SUCCESS);
+    SQLFreeStmt((SQLHSTMT)stmt, SQL_CLOSE);
+
+    int rows = run_query(stmt, "SELECT v FROM p");
+    assert_int_equal(rows, 5);
+    assert_int_equal(fake_executes, 2);
+
+    argus_free_stmt(stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: writes invalidate, volatile queries bypass ────────── */
+
+static void test_result_cache_invalidation(void **state)
+{
+    (void)state;
+    argus_result_cache_clear();
+    fake_executes = 0;
+
+    argus_dbc_t *dbc = create_dbc();
+    argus_stmt_t *stmt = NULL;
+    argus_alloc_stmt(dbc, &stmt);
+
+    run_query(stmt, "SELECT v FROM t");
+    run_query(stmt, "SELECT v FROM t");
+    assert_int_equal(fake_executes, 1);
+
+    SQLRETURN ret = SQLExecDirect((SQLHSTMT)stmt,
+                                  (SQLCHAR *)"INSERT INTO t VALUES ('x')",
+                                  SQL_NTS);
+    assert_int_equal(ret, SQL_SUCCESS);
+    SQLFreeStmt((SQLHSTMT)stmt, SQL_CLOSE);
+    size_t cached = argus_result_cache_bytes();
+    assert_int_equal(cached, 0);
+
+    run_query(stmt, "SELECT v FROM t");
+    assert_int_equal(fake_executes, 3);
+
+    run_query(stmt, "SELECT v, now() FROM t");
+    run_query(stmt, "SELECT v, now() FROM t");
+    assert_int_equal(fake_executes, 5);
+
+    argus_free_stmt(stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: RESULTCACHEPATTERN restricts what is cached ───────── */
+
+static void test_result_cache_pattern(void **state)
+{
+    (void)state;
+    argus_result_cache_clear();
+    fake_executes = 0;
+
+    argus_dbc_t *dbc = create_dbc();
+    dbc->result_cache_pattern = strdup("from dashboard_");
+    argus_stmt_t *stmt = NULL;
+    argus_alloc_stmt(dbc, &stmt);
+
+    run_query(stmt, "SELECT v FROM t");
+    run_query(stmt, "SELECT v FROM t");
+    assert_int_equal(fake_executes, 2);
+
+    run_query(stmt, "SELECT v FROM DASHBOARD_sales");
+    run_query(stmt, "SELECT v FROM DASHBOARD_sales");
+    assert_int_equal(fake_executes, 3);
+
+    argus_free_stmt(stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: LRU eviction keeps the cache within its budget ────── */
+
+static void test_result_cache_eviction(void **state)
+{
+    (void)state;
+    argus_result_cache_clear();
+    fake_executes = 0;
+
+    argus_dbc_t *dbc = create_dbc();
+    argus_stmt_t *stmt = NULL;
+    argus_alloc_stmt(dbc, &stmt);
+
+    run_query(stmt, "SELECT v FROM a");
+    size_t one = argus_result_cache_bytes();
+    assert_true(one > 0);
+
+    /* Room for four results (each may take a quarter of the budget) */
+    argus_result_cache_configure(one * 4 + one / 2);
+    run_query(stmt, "SELECT v FROM b");
+    run_query(stmt, "SELECT v FROM c");
+    run_query(stmt, "SELECT v FROM d");
+    run_query(stmt, "SELECT v FROM a");     /* hit: a becomes most recent */
+    assert_int_equal(fake_executes, 4);
+    run_query(stmt, "SELECT v FROM e");     /* evicts b, the oldest */
+    assert_int_equal(fake_executes, 5);
+    size_t total = argus_result_cache_bytes();
+    assert_true(total <= one * 4 + one / 2);
+
+    run_query(stmt, "SELECT v FROM a");
+    assert_int_equal(fake_executes, 5);
+    run_query(stmt, "SELECT v FROM b");
+    assert_int_equal(fake_executes, 6);
+
+    argus_result_cache_configure(ARGUS_DEFAULT_RESULT_CACHE_BYTES);
+    argus_free_stmt(stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: normalization and classification ──────────────────── */
+
+static void test_result_cache_normalize(void **state)
+{
+    (void)state;
+    char *n = argus_result_cache_normalize(
+        "\n  SELECT  a,\tb FROM t WHERE s = 'x   y' ;  ");
+    assert_string_equal(n, "SELECT a, b FROM t WHERE s = 'x   y'");
+    free(n);
+}
+
+static void test_result_cache_cacheable(void **state)
+{
+    (void)state;
+    assert_true(argus_result_cache_is_cacheable("SELECT 1"));
+    assert_true(argus_result_cache_is_cacheable(
+        "  (select a from t) union (select b from u)"));
+    assert_true(argus_result_cache_is_cacheable(
+        "WITH x AS (SELECT 1) SELECT * FROM x"));
+    assert_true(argus_result_cache_is_cacheable(
+        "SELECT known, nowhere FROM t"));
+
+    assert_false(argus_result_cache_is_cacheable("INSERT INTO t VALUES (1)"));
+    assert_false(argus_result_cache_is_cacheable("SHOW TABLES"));
+    assert_false(argus_result_cache_is_cacheable("SELECT NOW () FROM t"));
+    assert_false(argus_result_cache_is_cacheable(
+        "SELECT * FROM t WHERE d > CURRENT_TIMESTAMP"));
+    assert_false(argus_result_cache_is_cacheable("SELECT rand() FROM t"));
+    assert_false(argus_result_cache_is_cacheable(
+        "WITH x AS (DELETE FROM t RETURNING *) SELECT * FROM x"));
+    assert_false(argus_result_cache_is_cacheable(
+        "SELECT * INTO backup FROM t"));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_result_cache_hit),
+        cmocka_unit_test(test_result_cache_partial_read),
+        cmocka_unit_test(test_result_cache_invalidation),
+        cmocka_unit_test(test_result_cache_pattern),
+        cmocka_unit_test(test_result_cache_eviction),
+        cmocka_unit_test(test_result_cache_normalize),
+        cmocka_unit_test(test_result_cache_cacheable),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
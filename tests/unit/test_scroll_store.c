@@ -0,0 +1,190 @@
+/*
+ * Unit tests for the static-cursor row store (src/odbc/scroll_store.c) and
+ * the static cursors built on it, driven through BACKEND=synthetic.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include "argus/handle.h"
+#include "argus/odbc_api.h"
+#include "synthetic_dbc.h"
+
+#define ROWS        5000
+#define QUERY       "SYNTHETIC rows=5000 cols=varchar,bigint strlen=4-40"
+
+/* ── Helpers ─────────────────────────────────────────────────── */
+
+static SQLHSTMT exec_query(argus_dbc_t *dbc, SQLULEN cursor_type)
+{
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    SQLSetStmtAttr(stmt, SQL_ATTR_CURSOR_TYPE,
+                   (SQLPOINTER)(uintptr_t)cursor_type, 0);
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)QUERY, SQL_NTS),
+                     SQL_SUCCESS);
+    return stmt;
+}
+
+/* Column 1 of every row, read forward-only */
+static char **expected_rows(argus_dbc_t *dbc)
+{
+    SQLHSTMT stmt = exec_query(dbc, SQL_CURSOR_FORWARD_ONLY);
+    char **rows = calloc(ROWS, sizeof(char *));
+    char buf[64];
+    SQLLEN ind;
+    SQLBindCol(stmt, 1, SQL_C_CHAR, buf, sizeof(buf), &ind);
+    size_t n = 0;
+    while (SQLFetch(stmt) == SQL_SUCCESS && n < ROWS)
+        rows[n++] = strdup(buf);
+    assert_int_equal(n, ROWS);
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    return rows;
+}
+
+static void free_rows(char **rows)
+{
+    for (size_t i = 0; i < ROWS; i++) free(rows[i]);
+    free(rows);
+}
+
+/* ── Test: rows come back as they went in ────────────────────── */
+
+static void check_round_trip(bool compress)
+{
+    /* A zero budget spills every complete page */
+    argus_scroll_store_t *s = argus_scroll_store_new(3, 0, compress);
+    assert_non_null(s);
+
+    for (int i = 0; i < ROWS; i++) {
+        char text[32];
+        argus_cell_t cells[3];
+        memset(cells, 0, sizeof(cells));
+        snprintf(text, sizeof(text), "value-%d", i);
+        cells[0].data = text;
+        cells[0].data_len = strlen(text);
+        cells[1].is_null = (i % 7 == 0);
+        cells[2].native_kind = ARGUS_NATIVE_I64;
+        cells[2].native.i64 = (int64_t)i * 1000;
+        argus_row_t row = { .cells = cells };
+        assert_int_equal(argus_scroll_store_append(s, &row), 0);
+    }
+    assert_int_equal(argus_scroll_store_rows(s), ROWS);
+    assert_true(argus_scroll_store_spilled(s) > 0);
+
+    /* Out of order, across pages, on disk and in the open page */
+    const int probes[] = { 0, 4999, 1023, 1024, 2500, 1, 4096, 3999, 17 };
+    for (size_t k = 0; k < sizeof(probes) / sizeof(probes[0]); k++) {
+        int i = probes[k];
+        const argus_row_t *row = argus_scroll_store_get(s, (size_t)i);
+        assert_non_null(row);
+        char text[32];
+        snprintf(text, sizeof(text), "value-%d", i);
+        assert_string_equal(row->cells[0].data, text);
+        assert_int_equal(row->cells[0].data_len, strlen(text));
+        assert_int_equal(row->cells[0].native_kind, ARGUS_NATIVE_NONE);
+        assert_int_equal(row->cells[1].is_null, i % 7 == 0);
+        assert_null(row->cells[2].data);
+        assert_int_equal(row->cells[2].native_kind, ARGUS_NATIVE_I64);
+        assert_int_equal(row->cells[2].native.i64, (int64_t)i * 1000);
+    }
+    assert_null(argus_scroll_store_get(s, ROWS));
+
+    argus_scroll_store_free(s);
+}
+
+static void test_store_round_trip(void **state)
+{
+    (void)state;
+    check_round_trip(false);
+    check_round_trip(true);
+}
+
+/* ── Test: a static cursor reads only as far as it scrolls ───── */
+
+static void test_static_cursor_lazy(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc("SCROLLMEMORY=0;SCROLLCOMPRESS=1");
+    char **expected = expected_rows(dbc);
+
+    SQLHSTMT hstmt = exec_query(dbc, SQL_CURSOR_STATIC);
+    argus_stmt_t *stmt = (argus_stmt_t *)hstmt;
+    char buf[64];
+    SQLLEN ind;
+    SQLBindCol(hstmt, 1, SQL_C_CHAR, buf, sizeof(buf), &ind);
+
+    assert_int_equal(SQLFetchScroll(hstmt, SQL_FETCH_ABSOLUTE, 1500),
+                     SQL_SUCCESS);
+    assert_string_equal(buf, expected[1499]);
+    assert_true(argus_scroll_store_rows(stmt->scroll_store) < ROWS);
+    assert_false(stmt->scroll_complete);
+
+    assert_int_equal(SQLFetchScroll(hstmt, SQL_FETCH_LAST, 0), SQL_SUCCESS);
+    assert_string_equal(buf, expected[ROWS - 1]);
+    assert_int_equal(argus_scroll_store_rows(stmt->scroll_store), ROWS);
+    assert_true(argus_scroll_store_spilled(stmt->scroll_store) > 0);
+
+    assert_int_equal(SQLFetchScroll(hstmt, SQL_FETCH_ABSOLUTE, 2),
+                     SQL_SUCCESS);
+    assert_string_equal(buf, expected[1]);
+    assert_int_equal(SQLFetchScroll(hstmt, SQL_FETCH_PRIOR, 0), SQL_SUCCESS);
+    assert_string_equal(buf, expected[0]);
+    assert_int_equal(SQLFetchScroll(hstmt, SQL_FETCH_ABSOLUTE, ROWS + 1),
+                     SQL_NO_DATA);
+
+    /* SQLGetData reads the row the cursor is on */
+    assert_int_equal(SQLFetchScroll(hstmt, SQL_FETCH_ABSOLUTE, -10),
+                     SQL_SUCCESS);
+    char got[64];
+    assert_int_equal(SQLGetData(hstmt, 1, SQL_C_CHAR, got, sizeof(got), &ind),
+                     SQL_SUCCESS);
+    assert_string_equal(got, expected[ROWS - 10]);
+
+    SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+    free_rows(expected);
+    free_dbc(dbc);
+}
+
+/* ── Test: MaxScrollBytes bounds what a static cursor keeps ──── */
+
+static void test_static_cursor_byte_cap(void **state)
+{
+    (void)state;
+    argus_dbc_t *dbc = connect_dbc("MAXSCROLLBYTES=10000");
+    SQLHSTMT stmt = exec_query(dbc, SQL_CURSOR_STATIC);
+
+    /* The first rows fit */
+    assert_int_equal(SQLFetchScroll(stmt, SQL_FETCH_FIRST, 0), SQL_SUCCESS);
+
+    assert_int_equal(SQLFetchScroll(stmt, SQL_FETCH_LAST, 0), SQL_ERROR);
+    SQLCHAR sqlstate[6] = "", msg[256] = "";
+    SQLINTEGER native = 0;
+    SQLGetDiagRec(SQL_HANDLE_STMT, stmt, 1, sqlstate, &native, msg,
+                  sizeof(msg), NULL);
+    assert_string_equal((char *)sqlstate, "HY001");
+    assert_non_null(strstr((char *)msg, "MaxScrollBytes"));
+
+    /* It keeps failing rather than skip the rows that did not fit */
+    assert_int_equal(SQLFetchScroll(stmt, SQL_FETCH_LAST, 0), SQL_ERROR);
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_store_round_trip),
+        cmocka_unit_test(test_static_cursor_lazy),
+        cmocka_unit_test(test_static_cursor_byte_cap),
+    };
+    return cmocka_run_group_tests(tests, setup, NULL);
+}
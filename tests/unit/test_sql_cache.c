@@ -0,0 +1,250 @@
+/*
+ * Unit tests for the SQL preprocessing cache (sql_cache.c)
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "argus/handle.h"
+
+/* ── Fake backend: records the SQL it is sent, returns no rows ── */
+
+static char fake_sent[512];
+
+static int fake_execute(argus_backend_conn_t conn, const char *query,
+                        argus_backend_op_t *out_op)
+{
+    (void)conn;
+    snprintf(fake_sent, sizeof(fake_sent), "%s", query);
+    *out_op = (argus_backend_op_t)(uintptr_t)0xBEEF;
+    return 0;
+}
+
+static void fake_close_operation(argus_backend_conn_t conn,
+                                 argus_backend_op_t op)
+{
+    (void)conn; (void)op;
+}
+
+static int fake_get_result_metadata(argus_backend_conn_t conn,
+                                    argus_backend_op_t op,
+                                    argus_column_desc_t *columns,
+                                    int *num_cols)
+{
+    (void)conn; (void)op;
+    memset(&columns[0], 0, sizeof(columns[0]));
+    strcpy((char *)columns[0].name, "v");
+    columns[0].sql_type = SQL_VARCHAR;
+    columns[0].column_size = 16;
+    *num_cols = 1;
+    return 0;
+}
+
+static int fake_fetch_results(argus_backend_conn_t conn,
+                              argus_backend_op_t op, int max_rows,
+                              argus_row_cache_t *cache,
+                              argus_column_desc_t *columns, int *num_cols)
+{
+    (void)conn; (void)op; (void)max_rows; (void)columns;
+    *num_cols = 1;
+    cache->num_rows = 0;
+    return 0;
+}
+
+static const argus_backend_t fake_backend = {
+    .name                = "fake",
+    .execute             = fake_execute,
+    .close_operation     = fake_close_operation,
+    .fetch_results       = fake_fetch_results,
+    .get_result_metadata = fake_get_result_metadata,
+};
+
+static argus_dbc_t *create_dbc(void)
+{
+    argus_env_t *env = NULL;
+    argus_alloc_env(&env);
+    env->odbc_version = SQL_OV_ODBC3;
+
+    argus_dbc_t *dbc = NULL;
+    argus_alloc_dbc(env, &dbc);
+    dbc->host = strdup("cachehost");
+    dbc->backend_name = strdup("fake");
+    dbc->backend = &fake_backend;
+    dbc->backend_conn = (argus_backend_conn_t)(uintptr_t)0xCAFE;
+    dbc->connected = true;
+    return dbc;
+}
+
+static void free_dbc(argus_dbc_t *dbc)
+{
+    argus_env_t *env = dbc->env;
+    dbc->connected = false;
+    argus_free_dbc(dbc);
+    argus_free_env(env);
+}
+
+static SQLULEN conn_attr(argus_dbc_t *dbc, SQLINTEGER attr)
+{
+    SQLULEN v = 0;
+    SQLGetConnectAttr((SQLHDBC)dbc, attr, &v, sizeof(v), NULL);
+    return v;
+}
+
+static void exec_direct(argus_stmt_t *stmt, const char *sql)
+{
+    assert_int_equal(SQLExecDirect((SQLHSTMT)stmt, (SQLCHAR *)sql, SQL_NTS),
+                     SQL_SUCCESS);
+    SQLFreeStmt((SQLHSTMT)stmt, SQL_CLOSE);
+}
+
+#define ESCAPED "SELECT {fn UCASE(v)} FROM t WHERE d = {d '2024-01-31'}"
+
+/* ── Test: a repeated statement is translated once ───────────── */
+
+static void test_sql_cache_hit(void **state)
+{
+    (void)state;
+    argus_sql_cache_clear();
+    argus_dbc_t *dbc = create_dbc();
+    argus_stmt_t *stmt = NULL;
+    argus_alloc_stmt(dbc, &stmt);
+
+    char native[512];
+    SQLINTEGER native_len = 0;
+    assert_int_equal(SQLNativeSql((SQLHDBC)dbc, (SQLCHAR *)ESCAPED, SQL_NTS,
+                                  (SQLCHAR *)native, sizeof(native),
+                                  &native_len),
+                     SQL_SUCCESS);
+
+    exec_direct(stmt, ESCAPED);
+    assert_string_equal(fake_sent, native);
+    fake_sent[0] = '\0';
+    exec_direct(stmt, ESCAPED);
+    assert_string_equal(fake_sent, native);
+
+    /* The explicit-length form of the same text shares the entry */
+    assert_int_equal(SQLExecDirect((SQLHSTMT)stmt, (SQLCHAR *)ESCAPED,
+                                   (SQLINTEGER)strlen(ESCAPED)),
+                     SQL_SUCCESS);
+    SQLFreeStmt((SQLHSTMT)stmt, SQL_CLOSE);
+
+    assert_int_equal(conn_attr(dbc, ARGUS_ATTR_SQL_CACHE_HITS), 2);
+    assert_int_equal(conn_attr(dbc, ARGUS_ATTR_SQL_CACHE_MISSES), 1);
+    assert_true(conn_attr(dbc, ARGUS_ATTR_SQL_CACHE_BYTES) > 0);
+
+    /* SQL_NOSCAN_ON is a different entry: the text goes out as sent */
+    SQLSetStmtAttr((SQLHSTMT)stmt, SQL_ATTR_NOSCAN,
+                   (SQLPOINTER)SQL_NOSCAN_ON, 0);
+    exec_direct(stmt, ESCAPED);
+    assert_string_equal(fake_sent, ESCAPED);
+    assert_int_equal(conn_attr(dbc, ARGUS_ATTR_SQL_CACHE_MISSES), 2);
+
+    argus_free_stmt(stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: parameters are spliced in at the cached markers ───── */
+
+static void test_sql_cache_params(void **state)
+{
+    (void)state;
+    argus_sql_cache_clear();
+    argus_dbc_t *dbc = create_dbc();
+    argus_stmt_t *stmt = NULL;
+    argus_alloc_stmt(dbc, &stmt);
+
+    const char *sql = "SELECT v FROM t WHERE a = ? AND b = '?' AND c = ?";
+    assert_int_equal(SQLPrepare((SQLHSTMT)stmt, (SQLCHAR *)sql, SQL_NTS),
+                     SQL_SUCCESS);
+    SQLSMALLINT nparams = 0;
+    SQLNumParams((SQLHSTMT)stmt, &nparams);
+    assert_int_equal(nparams, 2);
+
+    SQLINTEGER a = 7;
+    char c[16] = "o'k";
+    SQLLEN c_len = SQL_NTS;
+    SQLBindParameter((SQLHSTMT)stmt, 1, SQL_PARAM_INPUT, SQL_C_LONG,
+                     SQL_INTEGER, 0, 0, &a, 0, NULL);
+    SQLBindParameter((SQLHSTMT)stmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR,
+                     SQL_VARCHAR, 16, 0, c, sizeof(c), &c_len);
+
+    assert_int_equal(SQLExecute((SQLHSTMT)stmt), SQL_SUCCESS);
+    assert_string_equal(fake_sent,
+                        "SELECT v FROM t WHERE a = 7 AND b = '?' AND c = 'o''k'");
+
+    a = 12345;
+    strcpy(c, "");
+    assert_int_equal(SQLExecute((SQLHSTMT)stmt), SQL_SUCCESS);
+    assert_string_equal(fake_sent,
+                        "SELECT v FROM t WHERE a = 12345 AND b = '?' AND c = ''");
+
+    /* Too few parameters for the markers */
+    SQLFreeStmt((SQLHSTMT)stmt, SQL_RESET_PARAMS);
+    SQLBindParameter((SQLHSTMT)stmt, 1, SQL_PARAM_INPUT, SQL_C_LONG,
+                     SQL_INTEGER, 0, 0, &a, 0, NULL);
+    assert_int_equal(SQLExecute((SQLHSTMT)stmt), SQL_ERROR);
+
+    argus_free_stmt(stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: failures are not cached, and the budget is enforced ─ */
+
+static void test_sql_cache_errors_and_budget(void **state)
+{
+    (void)state;
+    argus_sql_cache_clear();
+    argus_dbc_t *dbc = create_dbc();
+    argus_stmt_t *stmt = NULL;
+    argus_alloc_stmt(dbc, &stmt);
+
+    const char *bad = "SELECT {nosuchescape 1}";
+    assert_int_equal(SQLExecDirect((SQLHSTMT)stmt, (SQLCHAR *)bad, SQL_NTS),
+                     SQL_ERROR);
+    assert_int_equal(SQLExecDirect((SQLHSTMT)stmt, (SQLCHAR *)bad, SQL_NTS),
+                     SQL_ERROR);
+    assert_int_equal(conn_attr(dbc, ARGUS_ATTR_SQL_CACHE_HITS), 0);
+    assert_int_equal(conn_attr(dbc, ARGUS_ATTR_SQL_CACHE_MISSES), 2);
+    assert_int_equal(argus_sql_cache_bytes(), 0);
+
+    /* A small budget keeps only the most recent statements */
+    argus_sql_cache_configure(4096);
+    char sql[128];
+    for (int i = 0; i < 100; i++) {
+        snprintf(sql, sizeof(sql), "SELECT v FROM t WHERE id = %d", i);
+        exec_direct(stmt, sql);
+        assert_true(argus_sql_cache_bytes() <= 4096);
+    }
+    SQLULEN hits = conn_attr(dbc, ARGUS_ATTR_SQL_CACHE_HITS);
+    exec_direct(stmt, "SELECT v FROM t WHERE id = 99");
+    assert_int_equal(conn_attr(dbc, ARGUS_ATTR_SQL_CACHE_HITS), hits + 1);
+    exec_direct(stmt, "SELECT v FROM t WHERE id = 0");
+    assert_int_equal(conn_attr(dbc, ARGUS_ATTR_SQL_CACHE_HITS), hits + 1);
+
+    /* 0 turns it off */
+    argus_sql_cache_configure(0);
+    assert_int_equal(argus_sql_cache_bytes(), 0);
+    exec_direct(stmt, "SELECT v FROM t WHERE id = 99");
+    assert_int_equal(conn_attr(dbc, ARGUS_ATTR_SQL_CACHE_HITS), hits + 1);
+    assert_string_equal(fake_sent, "SELECT v FROM t WHERE id = 99");
+
+    argus_sql_cache_configure(ARGUS_DEFAULT_SQL_CACHE_BYTES);
+    argus_free_stmt(stmt);
+    free_dbc(dbc);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_sql_cache_hit),
+        cmocka_unit_test(test_sql_cache_params),
+        cmocka_unit_test(test_sql_cache_errors_and_budget),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,183 @@
+/*
+ * Unit tests for BACKEND=synthetic (src/backend/synthetic)
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include "argus/handle.h"
+#include "synthetic_internal.h"
+#include "synthetic_dbc.h"
+
+/* ── Helpers ─────────────────────────────────────────────────── */
+
+/* Run sql, checksum every cell as the application reads it; returns the
+ * number of rows, or -1 if the execute failed. */
+static long run(argus_dbc_t *dbc, const char *sql, uint64_t *sum,
+                int *nulls)
+{
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    if (!SQL_SUCCEEDED(SQLExecDirect(stmt, (SQLCHAR *)sql, SQL_NTS))) {
+        SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+        return -1;
+    }
+    SQLSMALLINT ncols = 0;
+    SQLNumResultCols(stmt, &ncols);
+
+    uint64_t h = SYNTHETIC_CHECKSUM_INIT;
+    long rows = 0;
+    while (SQLFetch(stmt) == SQL_SUCCESS) {
+        for (SQLUSMALLINT c = 1; c <= ncols; c++) {
+            char buf[SYNTHETIC_MAX_STRLEN + 1];
+            SQLLEN ind = 0;
+            SQLGetData(stmt, c, SQL_C_CHAR, buf, sizeof(buf), &ind);
+            if (ind == SQL_NULL_DATA) {
+                if (nulls) (*nulls)++;
+                h = synthetic_checksum_cell(h, NULL, 0, true);
+            } else {
+                h = synthetic_checksum_cell(h, buf, (size_t)ind, false);
+            }
+        }
+        rows++;
+    }
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    if (sum) *sum = h;
+    return rows;
+}
+
+/* ── Test: spec grammar ───────────────────────────────────────── */
+
+static void test_synthetic_spec_parse(void **state)
+{
+    (void)state;
+    synthetic_spec_t spec;
+    char err[160];
+
+    synthetic_spec_default(&spec);
+    assert_int_equal(synthetic_spec_parse(&spec,
+        "SYNTHETIC CHECKSUM rows=2k cols=int,varchar(4-8)*3;nulls=5% "
+        "strlen=1-100:skewed seed=9 latency=3", err, sizeof(err)), 0);
+    assert_true(spec.checksum);
+    assert_int_equal(spec.rows, 2000);
+    assert_int_equal(spec.num_cols, 4);
+    assert_int_equal(spec.cols[0].type, SYN_INT);
+    assert_int_equal(spec.cols[3].type, SYN_VARCHAR);
+    assert_int_equal(spec.cols[3].min_len, 4);
+    assert_int_equal(spec.cols[3].max_len, 8);
+    assert_true(spec.null_ratio > 0.049 && spec.null_ratio < 0.051);
+    assert_int_equal(spec.str_dist, SYN_DIST_SKEWED);
+    assert_int_equal(spec.seed, 9);
+    assert_int_equal(spec.latency_ms, 3);
+
+    const char *bad[] = { "rows=abc", "cols=blob", "nulls=2", "foo=1",
+                          "strlen=9-3", "cols=int(4)", "cols=int*100" };
+    for (size_t i = 0; i < G_N_ELEMENTS(bad); i++) {
+        synthetic_spec_default(&spec);
+        err[0] = '\0';
+        assert_int_equal(synthetic_spec_parse(&spec, bad[i], err,
+                                              sizeof(err)), -1);
+        assert_true(err[0] != '\0');
+    }
+}
+
+/* ── Test: the checksum row matches what the application read ── */
+
+static void test_synthetic_checksum(void **state)
+{
+    (void)state;
+    SQLRETURN ret;
+    argus_dbc_t *dbc = connect_with(
+        "BACKEND=synthetic;FETCHBUFFERSIZE=77;"
+        "SYNTHETICSPEC={rows=3000 nulls=10% seed=42 "
+        "cols=int,bigint,double,decimal,varchar,bool,date,timestamp}", &ret);
+    assert_int_equal(ret, SQL_SUCCESS);
+
+    uint64_t fetched = 0;
+    int nulls = 0;
+    assert_int_equal(run(dbc, "SELECT anything", &fetched, &nulls), 3000);
+    /* 10% of 24000 cells, give or take */
+    assert_true(nulls > 2000 && nulls < 2800);
+
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)"SYNTHETIC CHECKSUM",
+                                   SQL_NTS), SQL_SUCCESS);
+    assert_int_equal(SQLFetch(stmt), SQL_SUCCESS);
+    SQLBIGINT rows = 0;
+    char hex[32];
+    SQLGetData(stmt, 1, SQL_C_SBIGINT, &rows, sizeof(rows), NULL);
+    SQLGetData(stmt, 2, SQL_C_CHAR, hex, sizeof(hex), NULL);
+    assert_int_equal(rows, 3000);
+    assert_int_equal(strtoull(hex, NULL, 16), fetched);
+    assert_int_equal(SQLFetch(stmt), SQL_NO_DATA);
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+}
+
+/* ── Test: results depend on the seed, not on batching ─────────── */
+
+static void test_synthetic_deterministic(void **state)
+{
+    (void)state;
+    const char *sql = "SYNTHETIC rows=500 cols=bigint,varchar*2 "
+                      "strlen=0-64:skewed nulls=0.2";
+    uint64_t a = 0, b = 0, c = 0;
+    SQLRETURN ret;
+
+    argus_dbc_t *dbc = connect_with(
+        "BACKEND=synthetic;FETCHBUFFERSIZE=1", &ret);
+    assert_int_equal(ret, SQL_SUCCESS);
+    assert_int_equal(run(dbc, sql, &a, NULL), 500);
+    free_dbc(dbc);
+
+    dbc = connect_with("BACKEND=synthetic;FETCHBUFFERSIZE=1000", &ret);
+    assert_int_equal(ret, SQL_SUCCESS);
+    assert_int_equal(run(dbc, sql, &b, NULL), 500);
+
+    char reseeded[256];
+    snprintf(reseeded, sizeof(reseeded), "%s seed=2", sql);
+    assert_int_equal(run(dbc, reseeded, &c, NULL), 500);
+    free_dbc(dbc);
+
+    assert_true(a == b);
+    assert_true(a != c);
+}
+
+/* ── Test: bad specs are connect or statement errors ──────────── */
+
+static void test_synthetic_bad_spec(void **state)
+{
+    (void)state;
+    SQLRETURN ret;
+    argus_dbc_t *dbc = connect_with(
+        "BACKEND=synthetic;SYNTHETICSPEC={rows=lots}", &ret);
+    assert_int_equal(ret, SQL_ERROR);
+    free_dbc(dbc);
+
+    dbc = connect_with("BACKEND=synthetic", &ret);
+    assert_int_equal(ret, SQL_SUCCESS);
+    assert_int_equal(run(dbc, "SYNTHETIC cols=blob", NULL, NULL), -1);
+    /* The default spec */
+    assert_int_equal(run(dbc, "SELECT 1", NULL, NULL),
+                     SYNTHETIC_DEFAULT_ROWS);
+    free_dbc(dbc);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_synthetic_spec_parse),
+        cmocka_unit_test_setup(test_synthetic_checksum, setup),
+        cmocka_unit_test_setup(test_synthetic_deterministic, setup),
+        cmocka_unit_test_setup(test_synthetic_bad_spec, setup),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,171 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "thrift_poll.h"
+
+/* A fake operation: RUNNING for `running_polls` status calls, then
+ * `final`. Status calls from `fail_at` on fail. */
+typedef struct fake_op {
+    int                calls;
+    int                running_polls;
+    argus_poll_state_t final;
+    int                fail_at;
+    gint               cancelled;
+} fake_op_t;
+
+static int fake_status(void *conn, void *raw_op, argus_poll_state_t *state,
+                       argus_progress_t *progress)
+{
+    (void)conn;
+    fake_op_t *op = (fake_op_t *)raw_op;
+    op->calls++;
+    if (op->fail_at > 0 && op->calls >= op->fail_at) return -1;
+
+    if (g_atomic_int_get(&op->cancelled)) {
+        *state = ARGUS_POLL_CANCELLED;
+    } else if (op->running_polls < 0 || op->calls <= op->running_polls) {
+        *state = ARGUS_POLL_RUNNING;
+        progress->percent = 10.0 * op->calls;
+    } else {
+        *state = op->final;
+        progress->percent = 100.0;
+    }
+    g_strlcpy(progress->state, *state == ARGUS_POLL_RUNNING ? "RUNNING"
+                                                            : "DONE",
+              sizeof(progress->state));
+    return 0;
+}
+
+/* ── Test: the wait starts short and backs off to the cap ─────── */
+
+static void test_poll_interval_backoff(void **state)
+{
+    (void)state;
+    int ms = argus_poll_next_interval(0, 0);
+    assert_int_equal(ms, ARGUS_POLL_MIN_MS);
+    int prev = ms;
+    for (int i = 0; i < 30; i++) {
+        ms = argus_poll_next_interval(prev, 0);
+        assert_true(ms >= prev);
+        assert_true(ms <= ARGUS_POLL_MAX_MS);
+        prev = ms;
+    }
+    assert_int_equal(prev, ARGUS_POLL_MAX_MS);
+
+    /* A query that has run for 5 s is polled at least every 500 ms, one
+     * that has run for an hour no more often than the cap allows */
+    assert_int_equal(argus_poll_next_interval(ARGUS_POLL_MIN_MS, 5000), 500);
+    assert_int_equal(argus_poll_next_interval(ARGUS_POLL_MIN_MS, 3600000),
+                     ARGUS_POLL_MAX_MS);
+}
+
+/* ── Test: a short query is noticed within a few ms ───────────── */
+
+static void test_poll_short_query(void **state)
+{
+    (void)state;
+    fake_op_t op = { .running_polls = 3, .final = ARGUS_POLL_FINISHED };
+    argus_poll_t p;
+    argus_poll_init(&p);
+
+    argus_progress_t prog;
+    assert_false(argus_poll_progress(&p, &prog));
+
+    gint64 start = g_get_monotonic_time();
+    argus_poll_state_t st = ARGUS_POLL_RUNNING;
+    assert_int_equal(argus_poll_run(&p, fake_status, NULL, &op, 0, &st), 0);
+    gint64 elapsed_ms = (g_get_monotonic_time() - start) / 1000;
+
+    assert_int_equal(st, ARGUS_POLL_FINISHED);
+    assert_int_equal(op.calls, 4);
+    /* 2 + 3 + 4 ms of waits, with generous slack for a loaded machine */
+    assert_true(elapsed_ms < 200);
+
+    assert_true(argus_poll_progress(&p, &prog));
+    assert_true(prog.percent == 100.0);
+    assert_string_equal(prog.state, "DONE");
+    argus_poll_clear(&p);
+}
+
+/* ── Test: failures, errors and timeouts are reported ─────────── */
+
+static void test_poll_outcomes(void **state)
+{
+    (void)state;
+    argus_poll_t p;
+    argus_poll_init(&p);
+    argus_poll_state_t st;
+
+    fake_op_t failed = { .running_polls = 1, .final = ARGUS_POLL_FAILED };
+    assert_int_equal(argus_poll_run(&p, fake_status, NULL, &failed, 0, &st),
+                     0);
+    assert_int_equal(st, ARGUS_POLL_FAILED);
+
+    fake_op_t lost = { .running_polls = -1, .fail_at = 3 };
+    assert_int_equal(argus_poll_run(&p, fake_status, NULL, &lost, 0, &st),
+                     -1);
+    assert_int_equal(lost.calls, 3);
+
+    fake_op_t slow = { .running_polls = -1 };
+    gint64 start = g_get_monotonic_time();
+    assert_int_equal(argus_poll_run(&p, fake_status, NULL, &slow, 1, &st), 1);
+    gint64 elapsed_ms = (g_get_monotonic_time() - start) / 1000;
+    assert_int_equal(st, ARGUS_POLL_RUNNING);
+    assert_true(elapsed_ms >= 1000 && elapsed_ms < 1500);
+    argus_poll_clear(&p);
+}
+
+/* ── Test: a cancel cuts the backed-off wait short ────────────── */
+
+typedef struct canceller {
+    argus_poll_t *poll;
+    fake_op_t    *op;
+} canceller_t;
+
+static gpointer cancel_later(gpointer data)
+{
+    canceller_t *c = (canceller_t *)data;
+    g_usleep(1500000);
+    g_atomic_int_set(&c->op->cancelled, 1);
+    argus_poll_wake(c->poll);
+    return NULL;
+}
+
+static void test_poll_wake_on_cancel(void **state)
+{
+    (void)state;
+    argus_poll_t p;
+    argus_poll_init(&p);
+    fake_op_t op = { .running_polls = -1 };
+    canceller_t c = { &p, &op };
+
+    gint64 start = g_get_monotonic_time();
+    GThread *t = g_thread_new("cancel", cancel_later, &c);
+    argus_poll_state_t st;
+    assert_int_equal(argus_poll_run(&p, fake_status, NULL, &op, 0, &st), 0);
+    gint64 elapsed_ms = (g_get_monotonic_time() - start) / 1000;
+    g_thread_join(t);
+
+    assert_int_equal(st, ARGUS_POLL_CANCELLED);
+    /* Without the wake the next poll would be a few hundred ms away */
+    assert_true(elapsed_ms < 1500 + 100);
+    argus_poll_clear(&p);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_poll_interval_backoff),
+        cmocka_unit_test(test_poll_short_query),
+        cmocka_unit_test(test_poll_outcomes),
+        cmocka_unit_test(test_poll_wake_on_cancel),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,276 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "argus/cancel.h"
+#include "thrift_prefetch.h"
+
+/* A fake backend: each call returns the next `max_rows` integers as text, up
+ * to `total`, then an empty batch. Fetching from `fail_at` on fails. */
+typedef struct fake_op {
+    int next;
+    int total;
+    int calls;
+    int fail_at;
+} fake_op_t;
+
+static int fake_fetch(void *conn, void *raw_op, int max_rows,
+                      argus_row_cache_t *cache)
+{
+    (void)conn;
+    fake_op_t *op = (fake_op_t *)raw_op;
+    op->calls++;
+    if (op->fail_at > 0 && op->next >= op->fail_at) return -1;
+
+    int n = op->total - op->next;
+    if (n > max_rows) n = max_rows;
+    if (n <= 0) return 0;
+
+    if (cache->capacity < (size_t)n) {
+        argus_row_t *grown = realloc(cache->rows, (size_t)n * sizeof(argus_row_t));
+        if (!grown) return -1;
+        cache->rows = grown;
+        cache->capacity = (size_t)n;
+    }
+    cache->num_cols = 1;
+    for (int r = 0; r < n; r++) {
+        argus_cell_t *cell = calloc(1, sizeof(argus_cell_t));
+        char buf[16];
+        int len = snprintf(buf, sizeof(buf), "%d", op->next++);
+        cell->data = strdup(buf);
+        cell->data_len = (size_t)len;
+        cache->rows[r].cells = cell;
+    }
+    cache->num_rows = (size_t)n;
+    return 0;
+}
+
+/* Drive the fetch loop the way hive_fetch_results does. */
+static int fetch_next(argus_prefetch_t *pf, fake_op_t *op,
+                      argus_row_cache_t *cache)
+{
+    argus_row_cache_clear(cache);
+    int rc = argus_prefetch_pending(pf)
+             ? argus_prefetch_take(pf, cache)
+             : fake_fetch(NULL, op, 4, cache);
+    if (rc == 0 && cache->num_rows > 0)
+        argus_prefetch_start(pf, NULL, fake_fetch, NULL, op, 4);
+    return rc;
+}
+
+static void test_prefetch_preserves_order(void **state)
+{
+    (void)state;
+    argus_prefetch_t pf;
+    memset(&pf, 0, sizeof(pf));
+    fake_op_t op = { .next = 0, .total = 10 };
+    argus_row_cache_t cache;
+    argus_row_cache_init(&cache);
+
+    int expect = 0;
+    for (;;) {
+        int rc = fetch_next(&pf, &op, &cache);
+        assert_int_equal(rc, 0);
+        if (cache.num_rows == 0) break;
+        assert_int_equal(cache.num_cols, 1);
+        for (size_t r = 0; r < cache.num_rows; r++) {
+            char buf[16];
+            snprintf(buf, sizeof(buf), "%d", expect++);
+            assert_string_equal(cache.rows[r].cells[0].data, buf);
+        }
+    }
+    assert_int_equal(expect, 10);
+    /* 4 + 4 + 2 rows, then the empty batch that ends the set */
+    assert_int_equal(op.calls, 4);
+    assert_false(argus_prefetch_pending(&pf));
+
+    argus_prefetch_discard(&pf);
+    argus_row_cache_free(&cache);
+}
+
+static void test_prefetch_error_surfaces_on_take(void **state)
+{
+    (void)state;
+    argus_prefetch_t pf;
+    memset(&pf, 0, sizeof(pf));
+    fake_op_t op = { .next = 0, .total = 100, .fail_at = 8 };
+    argus_row_cache_t cache;
+    argus_row_cache_init(&cache);
+
+    int rc = fetch_next(&pf, &op, &cache);
+    assert_int_equal(rc, 0);
+    assert_true(argus_prefetch_pending(&pf));
+
+    /* Rows 4..7 were prefetched fine; the fetch started after them fails,
+     * and the failure is reported by the call that takes it. */
+    rc = fetch_next(&pf, &op, &cache);
+    assert_int_equal(rc, 0);
+    assert_int_equal(cache.num_rows, 4);
+    rc = fetch_next(&pf, &op, &cache);
+    assert_int_equal(rc, -1);
+    assert_false(argus_prefetch_pending(&pf));
+
+    argus_prefetch_discard(&pf);
+    argus_row_cache_free(&cache);
+}
+
+static void test_prefetch_discard_pending(void **state)
+{
+    (void)state;
+    argus_prefetch_t pf;
+    memset(&pf, 0, sizeof(pf));
+    fake_op_t op = { .next = 0, .total = 100 };
+
+    int rc = argus_prefetch_start(&pf, NULL, fake_fetch, NULL, &op, 8);
+    assert_int_equal(rc, 0);
+    /* Only one fetch may be in flight */
+    rc = argus_prefetch_start(&pf, NULL, fake_fetch, NULL, &op, 8);
+    assert_int_equal(rc, -1);
+
+    /* Closing the operation drops the fetched rows without leaking them,
+     * or the fetch itself if no worker has picked it up yet */
+    argus_prefetch_discard(&pf);
+    assert_false(argus_prefetch_pending(&pf));
+    assert_null(pf.cache.rows);
+    assert_true(op.calls <= 1);
+}
+
+/* A fetch that blocks until the gate opens or its cancel is requested */
+typedef struct gate {
+    GMutex lock;
+    bool   open;
+    gint   started;
+    gint   closed;
+} gate_t;
+
+static int gated_fetch(void *conn, void *raw_op, int max_rows,
+                       argus_row_cache_t *cache)
+{
+    (void)conn; (void)max_rows; (void)cache;
+    gate_t *g = (gate_t *)raw_op;
+    g_atomic_int_set(&g->started, 1);
+    for (;;) {
+        g_mutex_lock(&g->lock);
+        bool open = g->open;
+        g_mutex_unlock(&g->lock);
+        if (open) return 0;
+        if (argus_cancel_requested(argus_cancel_current())) return -1;
+        g_usleep(5000);
+    }
+}
+
+static void gate_open(gate_t *g)
+{
+    g_mutex_lock(&g->lock);
+    g->open = true;
+    g_mutex_unlock(&g->lock);
+}
+
+static void wait_started(gate_t *g)
+{
+    for (int i = 0; i < 1000 && !g_atomic_int_get(&g->started); i++)
+        g_usleep(5000);
+    assert_true(g_atomic_int_get(&g->started));
+}
+
+static void on_close(void *conn, void *op)
+{
+    (void)conn;
+    g_atomic_int_inc(&((gate_t *)op)->closed);
+}
+
+/* Closing while the fetch is on the wire neither waits for it nor cuts it
+ * short: the close runs on the worker once it returns */
+static void test_prefetch_close_deferred(void **state)
+{
+    (void)state;
+    argus_prefetch_group_t group;
+    argus_prefetch_group_init(&group);
+    argus_prefetch_t pf;
+    memset(&pf, 0, sizeof(pf));
+    gate_t g;
+    memset(&g, 0, sizeof(g));
+    g_mutex_init(&g.lock);
+
+    assert_int_equal(argus_prefetch_start(&pf, &group, gated_fetch, NULL,
+                                          &g, 8), 0);
+    wait_started(&g);
+
+    argus_prefetch_close(&pf, false, on_close, NULL, &g);
+    assert_false(argus_prefetch_pending(&pf));
+    assert_int_equal(g_atomic_int_get(&g.closed), 0);
+
+    gate_open(&g);
+    argus_prefetch_group_drain(&group, false);
+    assert_int_equal(g_atomic_int_get(&g.closed), 1);
+
+    /* Nothing on the wire: the close runs at once */
+    argus_prefetch_close(&pf, false, on_close, NULL, &g);
+    assert_int_equal(g_atomic_int_get(&g.closed), 2);
+
+    argus_prefetch_group_clear(&group);
+    g_mutex_clear(&g.lock);
+}
+
+/* The query timeout of the waiting statement reaches the fetch */
+static void test_prefetch_take_interrupted(void **state)
+{
+    (void)state;
+    argus_prefetch_t pf;
+    memset(&pf, 0, sizeof(pf));
+    gate_t g;
+    memset(&g, 0, sizeof(g));
+    g_mutex_init(&g.lock);
+    argus_row_cache_t cache;
+    argus_row_cache_init(&cache);
+
+    assert_int_equal(argus_prefetch_start(&pf, NULL, gated_fetch, NULL,
+                                          &g, 8), 0);
+    wait_started(&g);
+
+    argus_cancel_t c;
+    argus_cancel_init(&c);
+    argus_cancel_begin(&c, 1);
+    argus_cancel_t *prev = argus_cancel_enter(&c);
+    assert_int_equal(argus_prefetch_take(&pf, &cache), -1);
+    argus_cancel_leave(prev);
+    assert_true(argus_cancel_timed_out(&c));
+    argus_cancel_end(&c);
+    argus_cancel_clear(&c);
+
+    argus_prefetch_discard(&pf);
+    argus_row_cache_free(&cache);
+    g_mutex_clear(&g.lock);
+}
+
+static void test_prefetch_take_without_start(void **state)
+{
+    (void)state;
+    argus_prefetch_t pf;
+    memset(&pf, 0, sizeof(pf));
+    argus_row_cache_t cache;
+    argus_row_cache_init(&cache);
+    int rc = argus_prefetch_take(&pf, &cache);
+    assert_int_equal(rc, -1);
+    argus_prefetch_discard(&pf);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_prefetch_preserves_order),
+        cmocka_unit_test(test_prefetch_error_surfaces_on_take),
+        cmocka_unit_test(test_prefetch_discard_pending),
+        cmocka_unit_test(test_prefetch_take_without_start),
+        cmocka_unit_test(test_prefetch_close_deferred),
+        cmocka_unit_test(test_prefetch_take_interrupted),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
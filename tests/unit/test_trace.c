@@ -0,0 +1,233 @@
+/*
+ * Unit tests for span tracing (src/odbc/trace.c), driven through
+ * BACKEND=synthetic.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib.h>
+#include "argus/handle.h"
+#include "argus/odbc_api.h"
+#include "argus/trace.h"
+#include "synthetic_dbc.h"
+
+#define QUERY "SYNTHETIC rows=2500 cols=bigint,varchar strlen=8"
+
+/* ── Capturing sink ──────────────────────────────────────────── */
+
+typedef struct {
+    const char *name;
+    uint8_t     trace_id[16];
+    uint8_t     span_id[8];
+    uint8_t     parent_id[8];
+    int64_t     rows;           /* argus.rows, -1 when absent */
+    char        status[6];
+} captured_t;
+
+static captured_t spans[256];
+static int        num_spans;
+
+static void capture_span(void *user_data, const argus_span_t *span)
+{
+    (void)user_data;
+    if (num_spans >= (int)G_N_ELEMENTS(spans)) return;
+    captured_t *c = &spans[num_spans++];
+    c->name = span->name;
+    memcpy(c->trace_id, span->ctx.trace_id, sizeof(c->trace_id));
+    memcpy(c->span_id, span->ctx.span_id, sizeof(c->span_id));
+    memcpy(c->parent_id, span->parent_id, sizeof(c->parent_id));
+    c->rows = -1;
+    for (int i = 0; i < span->num_attrs; i++)
+        if (strcmp(span->attrs[i].key, "argus.rows") == 0)
+            c->rows = span->attrs[i].num;
+    memcpy(c->status, span->status, sizeof(c->status));
+}
+
+static const argus_trace_sink_t capture_sink = {
+    .export_span = capture_span,
+};
+
+static const captured_t *find_span(const char *name)
+{
+    for (int i = 0; i < num_spans; i++)
+        if (strcmp(spans[i].name, name) == 0) return &spans[i];
+    return NULL;
+}
+
+static int count_spans(const char *name)
+{
+    int n = 0;
+    for (int i = 0; i < num_spans; i++)
+        if (strcmp(spans[i].name, name) == 0) n++;
+    return n;
+}
+
+/* ── Helpers ─────────────────────────────────────────────────── */
+
+/* Execute QUERY and read the whole result */
+static void run_query(argus_dbc_t *dbc)
+{
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)QUERY, SQL_NTS),
+                     SQL_SUCCESS);
+    while (SQLFetch(stmt) == SQL_SUCCESS)
+        ;
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+}
+
+/* ── Test: spans cover connect, execute and each fetch batch ─── */
+
+static void test_trace_spans(void **state)
+{
+    (void)state;
+    num_spans = 0;
+    argus_trace_set_sink(&capture_sink);
+    argus_dbc_t *dbc = connect_dbc("FETCHBUFFERSIZE=1000;ADAPTIVEFETCH=0");
+
+    const captured_t *conn = find_span("connect");
+    assert_non_null(conn);
+    const captured_t *attempt = find_span("backend.connect");
+    assert_non_null(attempt);
+    assert_memory_equal(attempt->trace_id, conn->trace_id, 16);
+    assert_memory_equal(attempt->parent_id, conn->span_id, 8);
+
+    run_query(dbc);
+
+    /* The execute is a new trace; its round trips and fetches hang off it */
+    const captured_t *exec = find_span("execute");
+    assert_non_null(exec);
+    assert_string_equal(exec->status, "");
+    assert_memory_not_equal(exec->trace_id, conn->trace_id, 16);
+    const captured_t *rt = find_span("backend.execute");
+    assert_non_null(rt);
+    assert_memory_equal(rt->parent_id, exec->span_id, 8);
+
+    int64_t rows = 0;
+    for (int i = 0; i < num_spans; i++) {
+        if (strcmp(spans[i].name, "fetch") != 0) continue;
+        assert_memory_equal(spans[i].trace_id, exec->trace_id, 16);
+        assert_memory_equal(spans[i].parent_id, exec->span_id, 8);
+        rows += spans[i].rows;
+    }
+    assert_true(count_spans("fetch") >= 3);
+    assert_int_equal(rows, 2500);
+
+    free_dbc(dbc);
+    argus_trace_set_sink(NULL);
+}
+
+/* ── Test: TRACESAMPLE=0 records nothing; failures are marked ── */
+
+static void test_trace_sampling(void **state)
+{
+    (void)state;
+    num_spans = 0;
+    argus_trace_set_sink(&capture_sink);
+    argus_dbc_t *dbc = connect_dbc("TRACESAMPLE=0");
+    run_query(dbc);
+    assert_int_equal(num_spans, 0);
+    free_dbc(dbc);
+
+    /* A failed execute carries its SQLSTATE */
+    dbc = connect_dbc("TRACESAMPLE=1");
+    SQLHSTMT stmt = NULL;
+    SQLAllocHandle(SQL_HANDLE_STMT, (SQLHDBC)dbc, &stmt);
+    num_spans = 0;
+    assert_int_equal(SQLExecDirect(stmt, (SQLCHAR *)"SYNTHETIC bogus=1",
+                                   SQL_NTS),
+                     SQL_ERROR);
+    const captured_t *exec = find_span("execute");
+    assert_non_null(exec);
+    assert_true(exec->status[0] != '\0');
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    free_dbc(dbc);
+    argus_trace_set_sink(NULL);
+}
+
+/* ── Test: the default exporter writes OTLP/JSON lines ───────── */
+
+static void test_trace_file(void **state)
+{
+    (void)state;
+    char *path = g_strdup_printf("%s/argus-trace-%d.json", g_get_tmp_dir(),
+                                 (int)getpid());
+    remove(path);
+    char *connstr = g_strdup_printf("FETCHBUFFERSIZE=1000;TRACEFILE=%s",
+                                    path);
+    argus_dbc_t *dbc = connect_dbc(connstr);
+    run_query(dbc);
+    free_dbc(dbc);
+
+    gchar *data = NULL;
+    gsize len = 0;
+    assert_true(g_file_get_contents(path, &data, &len, NULL));
+    gchar **lines = g_strsplit(data, "\n", -1);
+    int n = 0, executes = 0;
+    for (int i = 0; lines[i] && *lines[i]; i++, n++) {
+        assert_true(g_str_has_prefix(lines[i], "{\"resourceSpans\":[{"));
+        assert_non_null(strstr(lines[i], "\"traceId\":\""));
+        assert_non_null(strstr(lines[i], "\"startTimeUnixNano\":\""));
+        if (strstr(lines[i], "\"name\":\"execute\""))
+            executes++;
+    }
+    assert_true(n >= 4);
+    assert_int_equal(executes, 1);
+    g_strfreev(lines);
+    g_free(data);
+
+    remove(path);
+    g_free(connstr);
+    g_free(path);
+}
+
+/* ── Test: the bound span's W3C traceparent ──────────────────── */
+
+static void test_trace_traceparent(void **state)
+{
+    (void)state;
+    char tp[ARGUS_TRACEPARENT_LEN];
+    assert_false(argus_trace_traceparent(tp));
+
+    argus_trace_set_sink(&capture_sink);
+    argus_tracer_t *t = argus_tracer_open(NULL, 1.0);
+    assert_non_null(t);
+    argus_span_t *span = argus_trace_root(t, "execute");
+    argus_span_t *prev = argus_trace_enter(span);
+    assert_true(argus_trace_traceparent(tp));
+    assert_int_equal(strlen(tp), 55);
+    assert_true(g_str_has_prefix(tp, "00-"));
+    assert_true(g_str_has_suffix(tp, "-01"));
+    assert_int_equal(tp[35], '-');
+    argus_trace_leave(prev);
+    assert_false(argus_trace_traceparent(tp));
+
+    /* Children of an unsampled parent are not recorded either */
+    argus_trace_ctx_t unsampled = { .sampled = false };
+    assert_null(argus_trace_child(t, &unsampled, "fetch"));
+    argus_trace_end(span, NULL);
+    argus_tracer_close(t);
+
+    /* No destination at all: tracing is off */
+    argus_trace_set_sink(NULL);
+    assert_null(argus_tracer_open(NULL, 1.0));
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_trace_spans),
+        cmocka_unit_test(test_trace_sampling),
+        cmocka_unit_test(test_trace_file),
+        cmocka_unit_test(test_trace_traceparent),
+    };
+    return cmocka_run_group_tests(tests, setup, NULL);
+}
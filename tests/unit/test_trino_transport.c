@@ -0,0 +1,187 @@
+/*
+ * Unit tests for the Trino per-connection event loop (trino_transport.c)
+ *
+ * Transfers go to file:// URLs, so several statements' requests can be
+ * driven through one connection without a server.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "trino_internal.h"
+#include "http_client.h"
+
+#define NUM_FILES 3
+
+static char g_path[NUM_FILES][64];
+static char g_url[NUM_FILES][128];
+
+static int setup(void **state)
+{
+    (void)state;
+    for (int i = 0; i < NUM_FILES; i++) {
+        snprintf(g_path[i], sizeof(g_path[i]), "/tmp/argus_trino_XXXXXX");
+        int fd = mkstemp(g_path[i]);
+        if (fd < 0) return -1;
+        char body[32];
+        int n = snprintf(body, sizeof(body), "segment-%d", i);
+        if (write(fd, body, (size_t)n) != n) {
+            close(fd);
+            return -1;
+        }
+        close(fd);
+        snprintf(g_url[i], sizeof(g_url[i]), "file://%s", g_path[i]);
+    }
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    argus_http_global_init();
+    return 0;
+}
+
+static int teardown(void **state)
+{
+    (void)state;
+    for (int i = 0; i < NUM_FILES; i++)
+        unlink(g_path[i]);
+    argus_http_global_cleanup();
+    curl_global_cleanup();
+    return 0;
+}
+
+static trino_conn_t *create_conn(void)
+{
+    trino_conn_t *conn = calloc(1, sizeof(trino_conn_t));
+    conn->curl = argus_http_handle_new(NULL);
+    assert_non_null(conn->curl);
+    assert_int_equal(trino_transport_init(conn), 0);
+    return conn;
+}
+
+static void free_conn(trino_conn_t *conn)
+{
+    trino_transport_cleanup(conn);
+    curl_easy_cleanup(conn->curl);
+    free(conn);
+}
+
+/* ── Test: blocking request with byte progress ───────────────── */
+
+static void test_transport_request(void **state)
+{
+    (void)state;
+    trino_conn_t *conn = create_conn();
+    argus_progress_t progress = { .percent = -1.0 };
+
+    for (int i = 0; i < 2; i++) {
+        trino_response_t resp = {0};
+        assert_int_equal(trino_http_request(conn, "GET", g_url[0], NULL,
+                                            &resp, &progress), 0);
+        assert_string_equal(resp.data, "segment-0");
+        free(resp.data);
+    }
+    assert_int_equal(progress.bytes_received, 18);
+
+    /* Finished handles are kept for the next transfer */
+    assert_int_equal(g_queue_get_length(&conn->loop_idle), 1);
+    free_conn(conn);
+}
+
+/* ── Test: transfers started together complete independently ── */
+
+static void test_transport_concurrent_transfers(void **state)
+{
+    (void)state;
+    trino_conn_t *conn = create_conn();
+    trino_response_t resp[NUM_FILES] = {{0}};
+    trino_xfer_t *xfer[NUM_FILES];
+
+    for (int i = 0; i < NUM_FILES; i++) {
+        xfer[i] = trino_http_start(conn, "GET", g_url[i], NULL, &resp[i],
+                                   NULL);
+        assert_non_null(xfer[i]);
+    }
+    /* Wait out of order: the loop runs all of them regardless */
+    for (int i = NUM_FILES - 1; i >= 0; i--) {
+        long code = -1;
+        assert_int_equal(trino_http_wait(conn, xfer[i], &code), 0);
+        char expect[32];
+        snprintf(expect, sizeof(expect), "segment-%d", i);
+        assert_string_equal(resp[i].data, expect);
+        free(resp[i].data);
+    }
+    assert_int_equal(g_queue_get_length(&conn->loop_idle), NUM_FILES);
+
+    /* A failing transfer does not disturb the others */
+    trino_response_t ok = {0}, bad = {0};
+    trino_xfer_t *a = trino_http_start(conn, "GET", "file:///nonexistent/x",
+                                       NULL, &bad, NULL);
+    trino_xfer_t *b = trino_http_start(conn, "GET", g_url[1], NULL, &ok,
+                                       NULL);
+    assert_int_equal(trino_http_wait(conn, a, NULL), -1);
+    assert_int_equal(trino_http_wait(conn, b, NULL), 0);
+    assert_string_equal(ok.data, "segment-1");
+    free(ok.data);
+    free(bad.data);
+
+    free_conn(conn);
+}
+
+/* ── Test: statements on several threads share the loop ─────── */
+
+typedef struct {
+    trino_conn_t *conn;
+    int           index;
+    int           failures;
+} worker_t;
+
+static gpointer worker_run(gpointer data)
+{
+    worker_t *w = (worker_t *)data;
+    char expect[32];
+    snprintf(expect, sizeof(expect), "segment-%d", w->index);
+
+    for (int i = 0; i < 50; i++) {
+        trino_response_t resp = {0};
+        if (trino_http_get(w->conn, g_url[w->index], &resp) != 0 ||
+            !resp.data || strcmp(resp.data, expect) != 0)
+            w->failures++;
+        free(resp.data);
+    }
+    return NULL;
+}
+
+static void test_transport_threads(void **state)
+{
+    (void)state;
+    trino_conn_t *conn = create_conn();
+    worker_t workers[NUM_FILES];
+    GThread *threads[NUM_FILES];
+
+    for (int i = 0; i < NUM_FILES; i++) {
+        workers[i] = (worker_t){ conn, i, 0 };
+        threads[i] = g_thread_new("trino-test", worker_run, &workers[i]);
+    }
+    for (int i = 0; i < NUM_FILES; i++) {
+        g_thread_join(threads[i]);
+        assert_int_equal(workers[i].failures, 0);
+    }
+    assert_false(conn->loop_driving);
+    assert_int_equal(g_queue_get_length(&conn->loop_pending), 0);
+
+    free_conn(conn);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_transport_request),
+        cmocka_unit_test(test_transport_concurrent_transfers),
+        cmocka_unit_test(test_transport_threads),
+    };
+    return cmocka_run_group_tests(tests, setup, teardown);
+}
@@ -408,6 +408,34 @@ union TColumn {
   8: TBinaryColumn binaryVal    // BINARY
 }
 
+// Spark / Databricks extensions (field ids in the 0x5xx range). Servers that
+// do not know them skip the fields, so a client can always set the request
+// flags and fall back to the columnar TRowSet when no Arrow data comes back.
+
+// Wire format of the result set, reported in TGetResultSetMetadataResp.
+enum TSparkRowSetType {
+  ARROW_BASED_SET = 0,
+  COLUMN_BASED_SET = 1,
+  ROW_BASED_SET = 2,
+  URL_BASED_SET = 3
+}
+
+// One Arrow IPC record batch delivered inline in a TRowSet
+struct TSparkArrowBatch {
+  1: required binary batch
+  2: required i64 rowCount
+}
+
+// A presigned link to an Arrow IPC stream held in cloud storage ("cloud fetch")
+struct TSparkArrowResultLink {
+  1: required string fileLink
+  2: required i64 expiryTime
+  3: required i64 startRowOffset
+  4: required i64 rowCount
+  5: required i64 bytesNum
+  6: optional map<string, string> httpHeaders
+}
+
 // Represents a rowset
 struct TRowSet {
   // The starting row offset of this rowset.
@@ -416,6 +444,8 @@ struct TRowSet {
   3: optional list<TColumn> columns
   4: optional binary binaryColumns
   5: optional i32 columnCount
+  0x501: optional list<TSparkArrowBatch> arrowBatches
+  0x502: optional list<TSparkArrowResultLink> resultLinks
 }
 
 // The return status code contained in each response.
@@ -726,6 +756,13 @@ struct TExecuteStatementReq {
 
   // The number of seconds after which the query will timeout on the server
   5: optional i64 queryTimeout = 0
+
+  // Spark / Databricks: the client can decode Arrow record batches
+  0x502: optional bool canReadArrowResult
+  // Spark / Databricks: the client can follow TSparkArrowResultLink URLs
+  0x503: optional bool canDownloadResult
+  // Spark / Databricks: the client can decompress LZ4-framed Arrow batches
+  0x504: optional bool canDecompressLZ4Result
 }
 
 struct TExecuteStatementResp {
@@ -1177,6 +1214,10 @@ struct TGetResultSetMetadataReq {
 struct TGetResultSetMetadataResp {
   1: required TStatus status
   2: optional TTableSchema schema
+  // Spark / Databricks extensions
+  0x501: optional TSparkRowSetType resultFormat
+  0x502: optional bool lz4Compressed
+  0x503: optional binary arrowSchema
 }
 
 